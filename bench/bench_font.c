@@ -0,0 +1,21 @@
+/*
+ * 仓库中没有 test/chinese_ziku.c 时的替代字库（仅用于无屏幕性能测试）
+ *
+ * 使用同为 20 号的思源黑体（只有中文字形），
+ * 数字和英文字母回退到 LV_FONT_DEFAULT，避免画面缺字、日志刷屏。
+ */
+#define lv_font_source_han_sans_bold_20 bench_han_sans_bold_20
+#include "../test/lv_font_source_han_sans_bold_20.c"
+#undef lv_font_source_han_sans_bold_20
+
+const lv_font_t chinese_ziku = {
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,
+    .line_height = 20,
+    .base_line = 2,
+    .subpx = LV_FONT_SUBPX_NONE,
+    .underline_position = -2,
+    .underline_thickness = 1,
+    .dsc = &font_dsc,           /*与上面包含的字库在同一个编译单元*/
+    .fallback = LV_FONT_DEFAULT,
+};
@@ -0,0 +1,374 @@
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl/lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+/*
+ * 布局性能测试
+ *
+ * 在大的 flex / grid 容器中每次只修改一个子对象（宽度或标签文字），
+ * 测量随后 lv_obj_update_layout() 的耗时，即每次修改的布局时间。
+ * 同时测量整个容器从头重新布局的时间作为对比。
+ * 只需要 lvgl 和内存显示驱动，不运行渲染。
+ *
+ * 用法: ./layout_bench [-n 修改次数] [-s 场景名] [-o 输出文件]
+ */
+
+/* ---------- 配置 ---------- */
+#define HOR_RES         800
+#define VER_RES         480
+#define DISP_BUF_SIZE   (HOR_RES * 40)
+#define DEF_CHANGES     2000            // 每个场景的默认修改次数
+#define FULL_CNT        50              // 整体重新布局的次数
+#define ITEM_CNT        1000            // 简单子对象的个数
+#define CARD_CNT        300             // 卡片的个数
+#define GRID_COLS       20
+
+typedef struct {
+    const char *name;
+    void (*create)(lv_obj_t *cont);     // 创建容器的内容
+    void (*change)(uint32_t i);         // 每次修改一个子对象
+} scenario_t;
+
+typedef struct {
+    uint32_t objs;
+    uint32_t changes;
+    uint64_t *change_ns;
+    uint64_t full_ns;                   // 整体重新布局的平均时间
+} scenario_result_t;
+
+/* ---------- 静态变量 ---------- */
+static lv_color_t disp_buf1[DISP_BUF_SIZE];
+static lv_obj_t *cont;
+static lv_obj_t *items[ITEM_CNT];
+static uint32_t item_cnt;
+
+static const char *texts[] = {"23.5", "1024", "湿度 45%", "OK"};
+static const char *long_texts[] = {"23.5 °C\n较高", "1024 lux\n光照充足"};
+
+/* ---------- 工具函数 ---------- */
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t va = *(const uint64_t *)a;
+    uint64_t vb = *(const uint64_t *)b;
+    return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+/* 修改的子对象: 用固定步长遍历，使修改分布在所有行/列中 */
+static lv_obj_t *pick(uint32_t i)
+{
+    return items[(i * 37) % item_cnt];
+}
+
+static uint32_t count_objs(lv_obj_t *obj)
+{
+    uint32_t cnt = 1;
+    uint32_t i;
+    for (i = 0; i < lv_obj_get_child_cnt(obj); i++) cnt += count_objs(lv_obj_get_child(obj, i));
+    return cnt;
+}
+
+/* ---------- 内存显示驱动 ---------- */
+static void mem_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_disp_flush_ready(drv);
+}
+
+static void hal_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, disp_buf1, NULL, DISP_BUF_SIZE);
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = mem_flush_cb;
+    disp_drv.hor_res  = HOR_RES;
+    disp_drv.ver_res  = VER_RES;
+    lv_disp_drv_register(&disp_drv);
+}
+
+/* ---------- 场景 ---------- */
+static lv_obj_t *card_create(lv_obj_t *parent, uint32_t i)
+{
+    lv_obj_t *card = lv_obj_create(parent);
+    lv_obj_set_flex_flow(card, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_all(card, 6, 0);
+    lv_obj_set_style_pad_row(card, 2, 0);
+
+    lv_obj_t *title = lv_label_create(card);
+    lv_label_set_text_fmt(title, "传感器 %u", (unsigned)i);
+
+    lv_obj_t *value = lv_label_create(card);
+    lv_label_set_text(value, texts[i % 4]);
+    return value;
+}
+
+/* 1000 个不同宽度的方块，按行换行 */
+static void flex_items_create(lv_obj_t *c)
+{
+    uint32_t i;
+    lv_obj_set_flex_flow(c, LV_FLEX_FLOW_ROW_WRAP);
+    for (i = 0; i < ITEM_CNT; i++) {
+        lv_obj_t *item = lv_obj_create(c);
+        lv_obj_remove_style_all(item);
+        lv_obj_set_size(item, 20 + (i * 7) % 30, 16);
+        items[item_cnt++] = item;
+    }
+}
+
+/* 宽度变化 1 像素，一般不会使后面的对象换到其它行 */
+static void item_width_change(uint32_t i)
+{
+    lv_obj_t *item = pick(i);
+    lv_obj_set_width(item, lv_obj_get_width(item) + ((i / item_cnt) % 2 ? -1 : 1));
+}
+
+/* 固定大小的卡片，与 nongye_ui_create() 的卡片网格相同 */
+static void flex_cards_create(lv_obj_t *c)
+{
+    uint32_t i;
+    lv_obj_set_flex_flow(c, LV_FLEX_FLOW_ROW_WRAP);
+    for (i = 0; i < CARD_CNT; i++) {
+        items[item_cnt] = card_create(c, i);
+        lv_obj_set_size(lv_obj_get_parent(items[item_cnt]), 120, 70);
+        item_cnt++;
+    }
+}
+
+/* 每一轮换成与上次不同的文字 */
+static void label_text_change(uint32_t i)
+{
+    lv_label_set_text(pick(i), texts[(i + i / item_cnt + 1) % 4]);
+}
+
+/* 高度随内容变化的卡片: 文字变成两行时卡片变高，所在的行也变高 */
+static void flex_content_cards_create(lv_obj_t *c)
+{
+    uint32_t i;
+    lv_obj_set_flex_flow(c, LV_FLEX_FLOW_ROW_WRAP);
+    for (i = 0; i < CARD_CNT; i++) {
+        items[item_cnt] = card_create(c, i);
+        lv_obj_set_size(lv_obj_get_parent(items[item_cnt]), 120, LV_SIZE_CONTENT);
+        item_cnt++;
+    }
+}
+
+static void label_lines_change(uint32_t i)
+{
+    lv_obj_t *label = pick(i);
+    const char *txt = lv_label_get_text(label);
+    if (strchr(txt, '\n')) lv_label_set_text(label, texts[i % 4]);
+    else lv_label_set_text(label, long_texts[i % 2]);
+}
+
+/* 20 列 × 50 行的固定大小网格 */
+static void grid_items_create(lv_obj_t *c)
+{
+    static lv_coord_t col_dsc[GRID_COLS + 1];
+    static lv_coord_t row_dsc[ITEM_CNT / GRID_COLS + 1];
+    uint32_t i;
+    for (i = 0; i < GRID_COLS; i++) col_dsc[i] = 36;
+    col_dsc[GRID_COLS] = LV_GRID_TEMPLATE_LAST;
+    for (i = 0; i < ITEM_CNT / GRID_COLS; i++) row_dsc[i] = 20;
+    row_dsc[ITEM_CNT / GRID_COLS] = LV_GRID_TEMPLATE_LAST;
+    lv_obj_set_grid_dsc_array(c, col_dsc, row_dsc);
+
+    for (i = 0; i < ITEM_CNT; i++) {
+        lv_obj_t *item = lv_obj_create(c);
+        lv_obj_remove_style_all(item);
+        lv_obj_set_size(item, 20 + (i * 7) % 12, 16);
+        lv_obj_set_grid_cell(item, LV_GRID_ALIGN_CENTER, i % GRID_COLS, 1, LV_GRID_ALIGN_CENTER, i / GRID_COLS, 1);
+        items[item_cnt++] = item;
+    }
+}
+
+/* 列宽由内容决定的表格: 每个单元格是一个标签 */
+static void grid_labels_create(lv_obj_t *c)
+{
+    static lv_coord_t col_dsc[] = {LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_CONTENT,
+                                   LV_GRID_CONTENT, LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
+    static lv_coord_t row_dsc[CARD_CNT / 6 + 1];
+    uint32_t i;
+    for (i = 0; i < CARD_CNT / 6; i++) row_dsc[i] = LV_GRID_CONTENT;
+    row_dsc[CARD_CNT / 6] = LV_GRID_TEMPLATE_LAST;
+    lv_obj_set_grid_dsc_array(c, col_dsc, row_dsc);
+
+    for (i = 0; i < CARD_CNT; i++) {
+        lv_obj_t *label = lv_label_create(c);
+        lv_label_set_text(label, texts[i % 4]);
+        lv_obj_set_grid_cell(label, LV_GRID_ALIGN_START, i % 6, 1, LV_GRID_ALIGN_CENTER, i / 6, 1);
+        items[item_cnt++] = label;
+    }
+}
+
+static const scenario_t scenarios[] = {
+    {"flex_item_width",     flex_items_create,          item_width_change},
+    {"flex_card_label",     flex_cards_create,          label_text_change},
+    {"flex_content_card",   flex_content_cards_create,  label_lines_change},
+    {"grid_item_width",     grid_items_create,          item_width_change},
+    {"grid_label",          grid_labels_create,         label_text_change},
+};
+#define SCENARIO_CNT (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+static void run_scenario(const scenario_t *sc, uint32_t changes, scenario_result_t *res)
+{
+    uint32_t i;
+
+    cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, HOR_RES, VER_RES);
+    item_cnt = 0;
+    sc->create(cont);
+    lv_obj_update_layout(cont);
+
+    res->objs = count_objs(cont);
+    res->changes = changes;
+    for (i = 0; i < changes; i++) {
+        sc->change(i);
+        uint64_t t0 = now_ns();
+        lv_obj_update_layout(cont);
+        res->change_ns[i] = now_ns() - t0;
+    }
+
+    /* 对比: 丢弃缓存，整个容器重新布局 */
+    uint64_t sum = 0;
+    for (i = 0; i < FULL_CNT; i++) {
+#if LV_USE_LAYOUT_CACHE
+        _lv_obj_layout_cache_invalidate(cont);
+#endif
+        lv_obj_mark_layout_as_dirty(cont);
+        uint64_t t0 = now_ns();
+        lv_obj_update_layout(cont);
+        sum += now_ns() - t0;
+    }
+    res->full_ns = sum / FULL_CNT;
+
+    lv_obj_del(cont);
+}
+
+/* ---------- 输出 ---------- */
+static double ns_to_us(uint64_t ns)
+{
+    return (double)ns / 1000.0;
+}
+
+static uint64_t percentile(const uint64_t *sorted, uint32_t cnt, uint32_t p)
+{
+    uint32_t idx = (cnt * p + 99) / 100;    // nearest-rank
+    if (idx > 0) idx--;
+    if (idx >= cnt) idx = cnt - 1;
+    return sorted[idx];
+}
+
+static void print_result(FILE *fp, const char *name, scenario_result_t *res, bool last)
+{
+    uint32_t i;
+    uint64_t sum = 0;
+
+    qsort(res->change_ns, res->changes, sizeof(uint64_t), cmp_u64);
+    for (i = 0; i < res->changes; i++) sum += res->change_ns[i];
+
+    fprintf(fp, "    {\n");
+    fprintf(fp, "      \"name\": \"%s\",\n", name);
+    fprintf(fp, "      \"objs\": %u,\n", res->objs);
+    fprintf(fp, "      \"changes\": %u,\n", res->changes);
+    fprintf(fp, "      \"layout_time_us\": {\"min\": %.2f, \"avg\": %.2f, \"p50\": %.2f, \"p90\": %.2f, "
+                "\"p99\": %.2f, \"max\": %.2f},\n",
+            ns_to_us(res->change_ns[0]), ns_to_us(sum / res->changes),
+            ns_to_us(percentile(res->change_ns, res->changes, 50)),
+            ns_to_us(percentile(res->change_ns, res->changes, 90)),
+            ns_to_us(percentile(res->change_ns, res->changes, 99)),
+            ns_to_us(res->change_ns[res->changes - 1]));
+    fprintf(fp, "      \"full_layout_time_us\": %.2f\n", ns_to_us(res->full_ns));
+    fprintf(fp, "    }%s\n", last ? "" : ",");
+}
+
+static void usage(const char *prog)
+{
+    int i;
+    fprintf(stderr, "用法: %s [-n 修改次数] [-s 场景] [-o 输出文件]\n", prog);
+    fprintf(stderr, "  -n  每个场景的修改次数 (默认 %d)\n", DEF_CHANGES);
+    fprintf(stderr, "  -s  只运行一个场景:");
+    for (i = 0; i < SCENARIO_CNT; i++) fprintf(stderr, " %s", scenarios[i].name);
+    fprintf(stderr, "\n  -o  JSON 结果文件 (默认 stdout)\n");
+}
+
+int main(int argc, char **argv)
+{
+    int changes = DEF_CHANGES;
+    const char *only = NULL;
+    const char *out_path = NULL;
+    int opt, i;
+
+    while ((opt = getopt(argc, argv, "n:s:o:h")) != -1) {
+        switch (opt) {
+            case 'n': changes = atoi(optarg); break;
+            case 's': only = optarg; break;
+            case 'o': out_path = optarg; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (changes <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (only) {
+        for (i = 0; i < SCENARIO_CNT; i++) if (strcmp(only, scenarios[i].name) == 0) break;
+        if (i == SCENARIO_CNT) {
+            fprintf(stderr, "未知场景: %s\n", only);
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    lv_init();
+    hal_init();
+
+    scenario_result_t res;
+    res.change_ns = malloc(changes * sizeof(uint64_t));
+    if (!res.change_ns) {
+        perror("malloc");
+        return 1;
+    }
+
+    FILE *fp = stdout;
+    if (out_path) {
+        fp = fopen(out_path, "w");
+        if (!fp) {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"layout\",\n");
+    fprintf(fp, "  \"layout_cache\": %d,\n", LV_USE_LAYOUT_CACHE);
+    fprintf(fp, "  \"scenarios\": [\n");
+
+    for (i = 0; i < SCENARIO_CNT; i++) {
+        if (only && strcmp(only, scenarios[i].name) != 0) continue;
+        run_scenario(&scenarios[i], changes, &res);
+        print_result(fp, scenarios[i].name, &res, only || i == SCENARIO_CNT - 1);
+    }
+
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+
+    if (fp != stdout) fclose(fp);
+    free(res.change_ns);
+    return 0;
+}
@@ -0,0 +1,478 @@
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl/lvgl.h"
+#include "lvgl/src/libs/png/lodepng.h"
+#include "test/nongye.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <getopt.h>
+#include <sys/stat.h>
+
+/*
+ * 无屏幕渲染性能测试
+ *
+ * 使用内存显示驱动、脚本化的传感器数据和触摸输入驱动智慧大棚界面，
+ * 不需要 /dev/fb0、触摸屏、/dev/Led 和 TCP 服务器。
+ * 每个场景运行固定帧数，输出 JSON 格式的帧时间百分位、渲染像素数和 flush 字节数。
+ *
+ * 用法: ./nongye_bench [-n 帧数] [-s 场景名] [-o 输出文件] [-p PNG目录]
+ */
+
+/* ---------- 配置 ---------- */
+#define HOR_RES         800
+#define VER_RES         480
+#define DISP_BUF_SIZE   (480 * 1024)    // 与 main.c 相同
+#define DEF_FRAMES      300             // 每个场景的默认帧数
+#define SETTLE_FRAMES   30              // 场景开始前不计时的帧数（等待动画结束）
+#define CAROUSEL_W      230
+#define CAROUSEL_H      160
+#define CAROUSEL_CNT    3
+#define CAROUSEL_EVERY  10              // 轮播场景: 每 10 帧切换一张图片
+#define TOUCH_EVERY     8               // 触摸场景: 每 8 帧点击一次开关
+
+typedef struct {
+    const char *name;
+    void (*step)(int frame);            // 每帧渲染前调用，模拟数据源/输入
+} scenario_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t rendered_frames;
+    uint32_t flush_calls;
+    uint64_t pixels;
+    uint64_t flush_bytes;
+    uint64_t *frame_ns;
+} scenario_result_t;
+
+/* ---------- 静态变量 ---------- */
+static lv_color_t disp_buf1[DISP_BUF_SIZE];
+static lv_color_t shadow_fb[HOR_RES * VER_RES];     // flush 的目标，相当于 /dev/fb0
+static lv_disp_t *disp;
+
+static struct {
+    uint32_t flush_calls;
+    uint64_t pixels;
+} flush_stat;
+
+static struct {
+    lv_point_t point;
+    bool pressed;
+} touch;
+
+static lv_obj_t *switches[2];
+static int switch_cnt = 0;
+
+static lv_obj_t *cards[8];
+static int card_cnt = 0;
+
+static lv_color_t carousel_buf[CAROUSEL_CNT][CAROUSEL_W * CAROUSEL_H];
+static lv_img_dsc_t carousel_dsc[CAROUSEL_CNT];
+static const void *carousel_srcs[CAROUSEL_CNT];
+
+static uint32_t rand_state = 1;
+
+/* ---------- 工具函数 ---------- */
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* 固定种子的伪随机数，保证每次运行的数据相同 */
+static uint32_t bench_rand(void)
+{
+    rand_state = rand_state * 1103515245U + 12345U;
+    return (rand_state >> 16) & 0x7fff;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t va = *(const uint64_t *)a;
+    uint64_t vb = *(const uint64_t *)b;
+    return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+/* ---------- 内存显示驱动 ---------- */
+static void mem_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for (y = area->y1; y <= area->y2; y++) {
+        memcpy(&shadow_fb[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    flush_stat.flush_calls++;
+    flush_stat.pixels += lv_area_get_size(area);
+
+    lv_disp_flush_ready(drv);
+}
+
+/* ---------- 脚本化触摸输入 ---------- */
+static void script_touch_read_cb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+    data->point = touch.point;
+    data->state = touch.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static void hal_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, disp_buf1, NULL, DISP_BUF_SIZE);
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = mem_flush_cb;
+    disp_drv.hor_res  = HOR_RES;
+    disp_drv.ver_res  = VER_RES;
+    disp = lv_disp_drv_register(&disp_drv);
+
+    static lv_indev_drv_t indev_drv;
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type    = LV_INDEV_TYPE_POINTER;
+    indev_drv.read_cb = script_touch_read_cb;
+    lv_indev_drv_register(&indev_drv);
+}
+
+/* 代替 S:/root/tmp/ 下 jpg 图片的内存图片（渐变），避免依赖文件系统和解码器 */
+static void carousel_imgs_init(void)
+{
+    int i, x, y;
+    for (i = 0; i < CAROUSEL_CNT; i++) {
+        for (y = 0; y < CAROUSEL_H; y++) {
+            for (x = 0; x < CAROUSEL_W; x++) {
+                uint8_t a = (uint8_t)(x * 255 / CAROUSEL_W);
+                uint8_t b = (uint8_t)(y * 255 / CAROUSEL_H);
+                lv_color_t c;
+                if (i == 0) c = lv_color_make(a, b, 0x40);
+                else if (i == 1) c = lv_color_make(0x40, a, b);
+                else c = lv_color_make(b, 0x40, a);
+                carousel_buf[i][y * CAROUSEL_W + x] = c;
+            }
+        }
+        carousel_dsc[i].header.cf = LV_IMG_CF_TRUE_COLOR;
+        carousel_dsc[i].header.always_zero = 0;
+        carousel_dsc[i].header.w = CAROUSEL_W;
+        carousel_dsc[i].header.h = CAROUSEL_H;
+        carousel_dsc[i].data_size = sizeof(carousel_buf[i]);
+        carousel_dsc[i].data = (const uint8_t *)carousel_buf[i];
+        carousel_srcs[i] = &carousel_dsc[i];
+    }
+}
+
+static void find_switches(lv_obj_t *obj)
+{
+    uint32_t i;
+    for (i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        lv_obj_t *child = lv_obj_get_child(obj, i);
+        if (lv_obj_check_type(child, &lv_switch_class) && switch_cnt < 2) {
+            switches[switch_cnt++] = child;
+        }
+        find_switches(child);
+    }
+}
+
+/* 卡片: 放在开关所在卡片的父对象 (flex 网格) 中的对象 */
+static void find_cards(void)
+{
+    if (switch_cnt == 0) return;
+
+    lv_obj_t *grid = lv_obj_get_parent(lv_obj_get_parent(switches[0]));
+    uint32_t i;
+    for (i = 0; i < lv_obj_get_child_cnt(grid) && card_cnt < 8; i++) {
+        cards[card_cnt++] = lv_obj_get_child(grid, i);
+    }
+}
+
+/* ---------- 帧循环 ---------- */
+static bool run_frame(uint64_t *elapsed_ns)
+{
+    /* 虚拟时钟: 每帧前进一个刷新周期，保证每帧都会执行刷新和输入读取 */
+    lv_tick_inc(disp->refr_timer->period);
+
+    uint32_t flush_calls = flush_stat.flush_calls;
+    uint64_t t0 = now_ns();
+    nongye_ui_refresh();
+    lv_timer_handler();
+    *elapsed_ns = now_ns() - t0;
+
+    return flush_stat.flush_calls != flush_calls;
+}
+
+static void settle(void)
+{
+    int i;
+    uint64_t dummy;
+    touch.pressed = false;
+    for (i = 0; i < SETTLE_FRAMES; i++) run_frame(&dummy);
+}
+
+/* ---------- 场景 ---------- */
+/* 稳定状态: 数据不变，只有主循环的周期刷新 */
+static void step_steady(int frame)
+{
+    LV_UNUSED(frame);
+}
+
+/* 数据变化: 每帧写入新的传感器数据 */
+static void step_churn(int frame)
+{
+    LV_UNUSED(frame);
+    nongye_feed_sensor(20.0f + (bench_rand() % 100) / 10.0f,
+                       60   + (bench_rand() % 20),
+                       400  + (bench_rand() % 1600),
+                       5000 + (bench_rand() % 5000));
+}
+
+/* 图片轮播切换 */
+static void step_carousel(int frame)
+{
+    if (frame % CAROUSEL_EVERY == 0) nongye_carousel_next();
+}
+
+/* 触摸开关: 交替点击灯光和报警开关 */
+static void step_touch(int frame)
+{
+    if (switch_cnt == 0) return;
+
+    int phase = frame % TOUCH_EVERY;
+    if (phase == 0) {
+        lv_obj_t *sw = switches[(frame / TOUCH_EVERY) % switch_cnt];
+        lv_area_t coords;
+        lv_obj_get_coords(sw, &coords);
+        touch.point.x = (coords.x1 + coords.x2) / 2;
+        touch.point.y = (coords.y1 + coords.y2) / 2;
+        touch.pressed = true;
+    } else if (phase == 2) {
+        touch.pressed = false;
+    }
+}
+
+/* 全屏重绘 */
+static void step_full_redraw(int frame)
+{
+    LV_UNUSED(frame);
+    lv_obj_invalidate(lv_scr_act());
+}
+
+/* 卡片重绘: 每帧改变所有卡片的背景颜色，圆角背景、边框和子对象全部重新渲染 */
+static void step_cards(int frame)
+{
+    int i;
+    for (i = 0; i < card_cnt; i++) {
+        lv_obj_set_style_bg_color(cards[i], lv_color_hex(0x3399cc + ((frame + i) % 16) * 0x010101), 0);
+    }
+}
+
+static const scenario_t scenarios[] = {
+    {"steady",      step_steady},
+    {"churn",       step_churn},
+    {"carousel",    step_carousel},
+    {"touch",       step_touch},
+    {"full_redraw", step_full_redraw},
+    {"cards",       step_cards},
+};
+
+#define SCENARIO_CNT (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+static void run_scenario(const scenario_t *sc, int frames, scenario_result_t *res)
+{
+    int i;
+
+    settle();
+
+    memset(&flush_stat, 0, sizeof(flush_stat));
+    res->frames = frames;
+    res->rendered_frames = 0;
+    for (i = 0; i < frames; i++) {
+        sc->step(i);
+        if (run_frame(&res->frame_ns[i])) res->rendered_frames++;
+    }
+    res->flush_calls = flush_stat.flush_calls;
+    res->pixels = flush_stat.pixels;
+    res->flush_bytes = flush_stat.pixels * sizeof(lv_color_t);
+}
+
+/* ---------- 输出 ---------- */
+static double ns_to_ms(uint64_t ns)
+{
+    return (double)ns / 1000000.0;
+}
+
+static uint64_t percentile(const uint64_t *sorted, uint32_t cnt, uint32_t p)
+{
+    uint32_t idx = (cnt * p + 99) / 100;    // nearest-rank
+    if (idx > 0) idx--;
+    if (idx >= cnt) idx = cnt - 1;
+    return sorted[idx];
+}
+
+static void print_result(FILE *fp, const char *name, scenario_result_t *res, bool last)
+{
+    uint32_t i;
+    uint64_t sum = 0;
+
+    qsort(res->frame_ns, res->frames, sizeof(uint64_t), cmp_u64);
+    for (i = 0; i < res->frames; i++) sum += res->frame_ns[i];
+
+    fprintf(fp, "    {\n");
+    fprintf(fp, "      \"name\": \"%s\",\n", name);
+    fprintf(fp, "      \"frames\": %u,\n", res->frames);
+    fprintf(fp, "      \"rendered_frames\": %u,\n", res->rendered_frames);
+    fprintf(fp, "      \"frame_time_ms\": {\"min\": %.3f, \"avg\": %.3f, \"p50\": %.3f, \"p90\": %.3f, "
+                "\"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n",
+            ns_to_ms(res->frame_ns[0]), ns_to_ms(sum / res->frames),
+            ns_to_ms(percentile(res->frame_ns, res->frames, 50)),
+            ns_to_ms(percentile(res->frame_ns, res->frames, 90)),
+            ns_to_ms(percentile(res->frame_ns, res->frames, 95)),
+            ns_to_ms(percentile(res->frame_ns, res->frames, 99)),
+            ns_to_ms(res->frame_ns[res->frames - 1]));
+    fprintf(fp, "      \"pixels\": %llu,\n", (unsigned long long)res->pixels);
+    fprintf(fp, "      \"flush_calls\": %u,\n", res->flush_calls);
+    fprintf(fp, "      \"flush_bytes\": %llu\n", (unsigned long long)res->flush_bytes);
+    fprintf(fp, "    }%s\n", last ? "" : ",");
+}
+
+static int dump_png(const char *dir, const char *name)
+{
+    char path[512];
+    unsigned char *rgba = malloc(HOR_RES * VER_RES * 4);
+    if (!rgba) return -1;
+
+    int i;
+    for (i = 0; i < HOR_RES * VER_RES; i++) {
+        uint32_t c = lv_color_to32(shadow_fb[i]);
+        rgba[i * 4 + 0] = (c >> 16) & 0xff;
+        rgba[i * 4 + 1] = (c >> 8) & 0xff;
+        rgba[i * 4 + 2] = c & 0xff;
+        rgba[i * 4 + 3] = 0xff;
+    }
+
+    /* lodepng 的文件接口走 lv_fs，这里编码到内存后直接用 stdio 写入 */
+    unsigned char *png = NULL;
+    size_t png_size = 0;
+    unsigned err = lodepng_encode32(&png, &png_size, rgba, HOR_RES, VER_RES);
+    free(rgba);
+    if (err) {
+        fprintf(stderr, "PNG 编码失败: %s\n", lodepng_error_text(err));
+        return -1;
+    }
+
+    snprintf(path, sizeof(path), "%s/%s.png", dir, name);
+    FILE *fp = fopen(path, "wb");
+    size_t written = fp ? fwrite(png, 1, png_size, fp) : 0;
+    if (fp) fclose(fp);
+    lv_free(png);
+    if (written != png_size) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    int i;
+    fprintf(stderr, "用法: %s [-n 帧数] [-s 场景] [-o 输出文件] [-p PNG目录]\n", prog);
+    fprintf(stderr, "  -n  每个场景的帧数 (默认 %d)\n", DEF_FRAMES);
+    fprintf(stderr, "  -s  只运行一个场景:");
+    for (i = 0; i < SCENARIO_CNT; i++) fprintf(stderr, " %s", scenarios[i].name);
+    fprintf(stderr, "\n  -o  JSON 结果文件 (默认 stdout)\n");
+    fprintf(stderr, "  -p  每个场景结束后把画面保存为 <目录>/<场景>.png\n");
+}
+
+int main(int argc, char **argv)
+{
+    int frames = DEF_FRAMES;
+    const char *only = NULL;
+    const char *out_path = NULL;
+    const char *png_dir = NULL;
+    int opt, i;
+
+    while ((opt = getopt(argc, argv, "n:s:o:p:h")) != -1) {
+        switch (opt) {
+            case 'n': frames = atoi(optarg); break;
+            case 's': only = optarg; break;
+            case 'o': out_path = optarg; break;
+            case 'p': png_dir = optarg; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (frames <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (only) {
+        for (i = 0; i < SCENARIO_CNT; i++) if (strcmp(only, scenarios[i].name) == 0) break;
+        if (i == SCENARIO_CNT) {
+            fprintf(stderr, "未知场景: %s\n", only);
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (png_dir && mkdir(png_dir, 0755) < 0 && errno != EEXIST) {
+        perror(png_dir);
+        return 1;
+    }
+
+    lv_init();
+    hal_init();
+
+    carousel_imgs_init();
+    nongye_set_scripted_feed(true);
+    uint64_t t_create = now_ns();
+    nongye_ui_create();
+    lv_obj_update_layout(lv_scr_act());     // 包括第一次布局的时间
+    t_create = now_ns() - t_create;
+    nongye_set_carousel_srcs(carousel_srcs, CAROUSEL_CNT);
+    find_switches(lv_scr_act());
+    find_cards();
+
+    scenario_result_t res;
+    res.frame_ns = malloc(frames * sizeof(uint64_t));
+    if (!res.frame_ns) {
+        perror("malloc");
+        return 1;
+    }
+
+    FILE *fp = stdout;
+    if (out_path) {
+        fp = fopen(out_path, "w");
+        if (!fp) {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"nongye\",\n");
+    fprintf(fp, "  \"hor_res\": %d,\n", HOR_RES);
+    fprintf(fp, "  \"ver_res\": %d,\n", VER_RES);
+    fprintf(fp, "  \"color_depth\": %d,\n", LV_COLOR_DEPTH);
+    fprintf(fp, "  \"refr_period_ms\": %u,\n", disp->refr_timer->period);
+    fprintf(fp, "  \"create_us\": %.1f,\n", t_create / 1000.0);
+    fprintf(fp, "  \"scenarios\": [\n");
+
+    int ret = 0;
+    for (i = 0; i < SCENARIO_CNT; i++) {
+        if (only && strcmp(only, scenarios[i].name) != 0) continue;
+        run_scenario(&scenarios[i], frames, &res);
+        print_result(fp, scenarios[i].name, &res, only || i == SCENARIO_CNT - 1);
+        if (png_dir && dump_png(png_dir, scenarios[i].name) < 0) ret = 1;
+    }
+
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+
+    if (fp != stdout) fclose(fp);
+    free(res.frame_ns);
+    return ret;
+}
@@ -0,0 +1,367 @@
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl/lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+/*
+ * 报警/事件记录表格滚动性能测试
+ *
+ * 用表格显示大量记录，每帧向下滚动一页并渲染，测量每帧的时间。
+ * 对比: 普通表格（保存所有单元格文字）、列表（每行一个按钮对象）、
+ * 虚拟表格（单元格文字由回调按需提供，只处理可见的行）。
+ * 同时输出创建时间和占用的 LVGL 内存。
+ *
+ * 用法: ./table_bench [-n 帧数] [-s 场景名] [-o 输出文件]
+ */
+
+/* ---------- 配置 ---------- */
+#define HOR_RES         800
+#define VER_RES         480
+#define DISP_BUF_SIZE   (HOR_RES * 40)
+#define MIN_FRAMES      200             // 行数少时从头再滚动，至少测量这么多帧
+#define SMALL_ROW_CNT   200             // 普通表格和列表的行数（16 位坐标下内容高度有限）
+#define VIRTUAL_ROW_CNT 100000
+#define COL_CNT         4
+
+typedef struct {
+    const char *name;
+    uint32_t rows;
+    lv_obj_t *(*create)(lv_obj_t *parent, uint32_t rows);
+} scenario_t;
+
+typedef struct {
+    uint32_t rows;
+    uint32_t frames;
+    uint64_t *frame_ns;
+    uint64_t create_ns;
+    uint32_t mem_used;                  // 创建后占用的 LVGL 内存 (字节)
+    uint32_t rows_scrolled;             // 滚动经过的行数
+    double cells_per_frame;             // 每帧虚拟表格回调的次数
+} scenario_result_t;
+
+/* ---------- 静态变量 ---------- */
+static lv_color_t disp_buf1[DISP_BUF_SIZE];
+static uint64_t cell_cnt;               // 虚拟表格回调次数
+
+static const char *sensors[] = {"Temp", "Humidity", "CO2", "Light", "Soil"};
+static const char *events[] = {"High", "Low", "Sensor lost", "Recovered"};
+
+/* ---------- 工具函数 ---------- */
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t va = *(const uint64_t *)a;
+    uint64_t vb = *(const uint64_t *)b;
+    return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+static uint32_t mem_used(void)
+{
+#if LV_USE_BUILTIN_MALLOC
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+#else
+    return 0;
+#endif
+}
+
+/* 第 row 条记录的第 col 列 */
+static const char *record_txt(uint32_t row, uint32_t col, char *buf, uint32_t buf_size)
+{
+    uint32_t t = row * 7;
+    switch (col) {
+        case 0:
+            lv_snprintf(buf, buf_size, "#%u %02u:%02u:%02u", (unsigned)row,
+                        (unsigned)(t / 3600 % 24), (unsigned)(t / 60 % 60), (unsigned)(t % 60));
+            return buf;
+        case 1:
+            return sensors[row % 5];
+        case 2:
+            return events[row % 4];
+        default:
+            lv_snprintf(buf, buf_size, "%u.%u", (unsigned)(row % 97), (unsigned)(row % 10));
+            return buf;
+    }
+}
+
+/* ---------- 内存显示驱动 ---------- */
+static void mem_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_disp_flush_ready(drv);
+}
+
+static void hal_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, disp_buf1, NULL, DISP_BUF_SIZE);
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = mem_flush_cb;
+    disp_drv.hor_res  = HOR_RES;
+    disp_drv.ver_res  = VER_RES;
+    lv_disp_drv_register(&disp_drv);
+}
+
+/* ---------- 场景 ---------- */
+static lv_obj_t *table_base_create(lv_obj_t *parent)
+{
+    lv_obj_t *table = lv_table_create(parent);
+    lv_obj_set_size(table, HOR_RES, VER_RES);
+    lv_table_set_col_cnt(table, COL_CNT);
+    uint32_t i;
+    for (i = 0; i < COL_CNT; i++) lv_table_set_col_width(table, i, HOR_RES / COL_CNT - 10);
+    return table;
+}
+
+/* 普通表格: 所有单元格文字都保存在表格中 */
+static lv_obj_t *table_create(lv_obj_t *parent, uint32_t rows)
+{
+    lv_obj_t *table = table_base_create(parent);
+    lv_table_set_row_cnt(table, rows);
+
+    char buf[32];
+    uint32_t row, col;
+    for (row = 0; row < rows; row++) {
+        for (col = 0; col < COL_CNT; col++) {
+            lv_table_add_cell_ctrl(table, row, col, LV_TABLE_CELL_CTRL_TEXT_CROP);
+            lv_table_set_cell_value(table, row, col, record_txt(row, col, buf, sizeof(buf)));
+        }
+    }
+    return table;
+}
+
+/* 列表: 每行一个按钮 (图标 + 标签) */
+static lv_obj_t *list_create(lv_obj_t *parent, uint32_t rows)
+{
+    lv_obj_t *list = lv_list_create(parent);
+    lv_obj_set_size(list, HOR_RES, VER_RES);
+
+    char buf[32];
+    char txt[96];
+    uint32_t row;
+    for (row = 0; row < rows; row++) {
+        lv_snprintf(txt, sizeof(txt), "%s  %s  %s", record_txt(row, 0, buf, sizeof(buf)),
+                    record_txt(row, 1, NULL, 0), record_txt(row, 2, NULL, 0));
+        lv_list_add_btn(list, LV_SYMBOL_WARNING, txt);
+    }
+    return list;
+}
+
+#if LV_TABLE_VIRTUAL
+static const char *virtual_cb(lv_obj_t *obj, uint32_t row, uint16_t col, char *buf, uint32_t buf_size)
+{
+    cell_cnt++;
+    return record_txt(row, col, buf, buf_size);
+}
+
+/* 虚拟表格: 只保存行数，绘制时通过回调取可见行的文字 */
+static lv_obj_t *virtual_table_create(lv_obj_t *parent, uint32_t rows)
+{
+    lv_obj_t *table = table_base_create(parent);
+    lv_table_set_virtual(table, rows, virtual_cb);
+    return table;
+}
+#endif
+
+static const scenario_t scenarios[] = {
+    {"table",           SMALL_ROW_CNT,      table_create},
+    {"list",            SMALL_ROW_CNT,      list_create},
+#if LV_TABLE_VIRTUAL
+    {"virtual_table",   VIRTUAL_ROW_CNT,    virtual_table_create},
+#endif
+};
+#define SCENARIO_CNT (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+/* 每帧向下滚动一页, 到底后回到顶部 */
+static void scroll_page(lv_obj_t *obj)
+{
+    if (lv_obj_get_scroll_bottom(obj) <= 0) {
+#if LV_TABLE_VIRTUAL
+        if (lv_obj_check_type(obj, &lv_table_class)) {
+            lv_table_scroll_to_row(obj, 0, LV_ANIM_OFF);
+            return;
+        }
+#endif
+        lv_obj_scroll_to_y(obj, 0, LV_ANIM_OFF);
+        return;
+    }
+    lv_obj_scroll_by_bounded(obj, 0, -lv_obj_get_content_height(obj), LV_ANIM_OFF);
+}
+
+/* 估计一页的行数: 用第一帧后的内容高度和行数 */
+static uint32_t page_row_cnt(lv_obj_t *obj, uint32_t rows)
+{
+    lv_coord_t content_h = lv_obj_get_scroll_top(obj) + lv_obj_get_height(obj) + lv_obj_get_scroll_bottom(obj);
+#if LV_TABLE_VIRTUAL
+    if (lv_obj_check_type(obj, &lv_table_class) && lv_table_get_virtual_row_cnt(obj)) {
+        lv_table_t *table = (lv_table_t *)obj;
+        return lv_obj_get_content_height(obj) / table->virt->row_h;
+    }
+#endif
+    if (content_h <= 0) return rows;
+    return (uint32_t)((uint64_t)rows * lv_obj_get_content_height(obj) / content_h);
+}
+
+static void run_scenario(const scenario_t *sc, uint32_t frames, scenario_result_t *res)
+{
+    uint32_t i;
+    uint32_t mem0 = mem_used();
+
+    uint64_t t0 = now_ns();
+    lv_obj_t *obj = sc->create(lv_scr_act(), sc->rows);
+    lv_obj_update_layout(obj);
+    res->create_ns = now_ns() - t0;
+    res->mem_used = mem_used() - mem0;
+    lv_refr_now(NULL);
+    cell_cnt = 0;
+
+    /* 默认滚动经过所有的行 */
+    uint32_t page_rows = LV_MAX(page_row_cnt(obj, sc->rows), 1);
+    if (frames == 0) frames = LV_MAX(sc->rows / page_rows, MIN_FRAMES);
+
+    res->rows = sc->rows;
+    res->frames = frames;
+    res->rows_scrolled = frames * page_rows;
+    for (i = 0; i < frames; i++) {
+        t0 = now_ns();
+        scroll_page(obj);
+        lv_refr_now(NULL);
+        res->frame_ns[i] = now_ns() - t0;
+    }
+    res->cells_per_frame = (double)cell_cnt / frames;
+
+    lv_obj_del(obj);
+}
+
+/* ---------- 输出 ---------- */
+static double ns_to_us(uint64_t ns)
+{
+    return (double)ns / 1000.0;
+}
+
+static uint64_t percentile(const uint64_t *sorted, uint32_t cnt, uint32_t p)
+{
+    uint32_t idx = (cnt * p + 99) / 100;    // nearest-rank
+    if (idx > 0) idx--;
+    if (idx >= cnt) idx = cnt - 1;
+    return sorted[idx];
+}
+
+static void print_result(FILE *fp, const char *name, scenario_result_t *res, bool last)
+{
+    uint32_t i;
+    uint64_t sum = 0;
+
+    qsort(res->frame_ns, res->frames, sizeof(uint64_t), cmp_u64);
+    for (i = 0; i < res->frames; i++) sum += res->frame_ns[i];
+
+    fprintf(fp, "    {\n");
+    fprintf(fp, "      \"name\": \"%s\",\n", name);
+    fprintf(fp, "      \"rows\": %u,\n", res->rows);
+    fprintf(fp, "      \"create_time_us\": %.2f,\n", ns_to_us(res->create_ns));
+    fprintf(fp, "      \"mem_used\": %u,\n", res->mem_used);
+    fprintf(fp, "      \"frames\": %u,\n", res->frames);
+    fprintf(fp, "      \"rows_scrolled\": %u,\n", res->rows_scrolled);
+    fprintf(fp, "      \"cell_cb_per_frame\": %.1f,\n", res->cells_per_frame);
+    fprintf(fp, "      \"frame_time_us\": {\"min\": %.2f, \"avg\": %.2f, \"p50\": %.2f, \"p90\": %.2f, "
+                "\"p99\": %.2f, \"max\": %.2f}\n",
+            ns_to_us(res->frame_ns[0]), ns_to_us(sum / res->frames),
+            ns_to_us(percentile(res->frame_ns, res->frames, 50)),
+            ns_to_us(percentile(res->frame_ns, res->frames, 90)),
+            ns_to_us(percentile(res->frame_ns, res->frames, 99)),
+            ns_to_us(res->frame_ns[res->frames - 1]));
+    fprintf(fp, "    }%s\n", last ? "" : ",");
+}
+
+static void usage(const char *prog)
+{
+    int i;
+    fprintf(stderr, "用法: %s [-n 帧数] [-s 场景] [-o 输出文件]\n", prog);
+    fprintf(stderr, "  -n  每个场景的帧数 (默认滚动经过所有的行, 至少 %d 帧)\n", MIN_FRAMES);
+    fprintf(stderr, "  -s  只运行一个场景:");
+    for (i = 0; i < SCENARIO_CNT; i++) fprintf(stderr, " %s", scenarios[i].name);
+    fprintf(stderr, "\n  -o  JSON 结果文件 (默认 stdout)\n");
+}
+
+int main(int argc, char **argv)
+{
+    int frames = 0;
+    const char *only = NULL;
+    const char *out_path = NULL;
+    int opt, i;
+
+    while ((opt = getopt(argc, argv, "n:s:o:h")) != -1) {
+        switch (opt) {
+            case 'n': frames = atoi(optarg); break;
+            case 's': only = optarg; break;
+            case 'o': out_path = optarg; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (frames < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (only) {
+        for (i = 0; i < SCENARIO_CNT; i++) if (strcmp(only, scenarios[i].name) == 0) break;
+        if (i == SCENARIO_CNT) {
+            fprintf(stderr, "未知场景: %s\n", only);
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    lv_init();
+    hal_init();
+
+    FILE *fp = stdout;
+    if (out_path) {
+        fp = fopen(out_path, "w");
+        if (!fp) {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"benchmark\": \"table_scroll\",\n");
+    fprintf(fp, "  \"scenarios\": [\n");
+
+    for (i = 0; i < SCENARIO_CNT; i++) {
+        if (only && strcmp(only, scenarios[i].name) != 0) continue;
+
+        scenario_result_t res;
+        uint32_t max_frames = frames ? (uint32_t)frames : LV_MAX(scenarios[i].rows, MIN_FRAMES);
+        res.frame_ns = malloc(max_frames * sizeof(uint64_t));
+        if (!res.frame_ns) {
+            perror("malloc");
+            return 1;
+        }
+
+        run_scenario(&scenarios[i], frames, &res);
+        print_result(fp, scenarios[i].name, &res, only || i == SCENARIO_CNT - 1);
+        free(res.frame_ns);
+    }
+
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+
+    if (fp != stdout) fclose(fp);
+    return 0;
+}
@@ -21,6 +21,7 @@
 #include <unistd.h>
 #include <errno.h>
 #include <sys/mman.h>
+#include <poll.h>
 #include <inttypes.h>
 
 #include <xf86drm.h>
@@ -31,6 +32,11 @@
 
 #define DIV_ROUND_UP(n, d) (((n) + (d) - 1) / (d))
 
+/* Number of past frames whose damage is remembered. A buffer older than this is copied entirely. */
+#define DRM_DAMAGE_HISTORY 4
+/* Number of damaged rectangles stored per frame. More are merged into their bounding box. */
+#define DRM_DAMAGE_RECTS   16
+
 #define print(msg, ...)	fprintf(stderr, msg, ##__VA_ARGS__);
 #define err(msg, ...)  print("error: " msg "\n", ##__VA_ARGS__)
 #define info(msg, ...) print(msg "\n", ##__VA_ARGS__)
@@ -43,6 +49,12 @@ struct drm_buffer {
 	unsigned long int size;
 	void * map;
 	uint32_t fb_handle;
+	uint32_t frame; /* The frame last rendered into this buffer, 0 if never */
+};
+
+struct drm_damage {
+	lv_area_t rects[DRM_DAMAGE_RECTS];
+	uint32_t count;
 };
 
 struct drm_dev {
@@ -67,6 +79,10 @@ struct drm_dev {
 	drmModePropertyPtr conn_props[128];
 	struct drm_buffer drm_bufs[2]; /* DUMB buffers */
 	struct drm_buffer *cur_bufs[2]; /* double buffering handling */
+	uint32_t frame; /* Number of the frame being rendered, starts from 1 */
+	struct drm_damage damage[DRM_DAMAGE_HISTORY]; /* Damage of the last frames indexed by frame % DRM_DAMAGE_HISTORY */
+	bool frame_started; /* The back buffer already received areas of the current frame */
+	bool flip_pending; /* A page flip was committed but not completed yet */
 } drm_dev;
 
 static uint32_t get_plane_property_id(const char *name)
@@ -118,6 +134,7 @@ static void page_flip_handler(int fd, unsigned int sequence, unsigned int tv_sec
 			      unsigned int tv_usec, void *user_data)
 {
 	dbg("flip");
+	drm_dev.flip_pending = false;
 }
 
 static int drm_get_plane_props(void)
@@ -240,11 +257,12 @@ static int drm_add_conn_property(const char *name, uint64_t value)
 	return 0;
 }
 
-static int drm_dmabuf_set_plane(struct drm_buffer *buf)
+static int drm_dmabuf_set_plane(struct drm_buffer *buf, const struct drm_damage *damage)
 {
 	int ret;
 	static int first = 1;
-	uint32_t flags = DRM_MODE_PAGE_FLIP_EVENT;
+	uint32_t flags = DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_ATOMIC_NONBLOCK;
+	uint32_t damage_blob = 0;
 
 	drm_dev.req = drmModeAtomicAlloc();
 
@@ -271,14 +289,40 @@ static int drm_dmabuf_set_plane(struct drm_buffer *buf)
 	drm_add_plane_property("CRTC_W", drm_dev.width);
 	drm_add_plane_property("CRTC_H", drm_dev.height);
 
+	/* Tell the driver which parts changed compared to the previous frame (e.g. for display
+	 * controllers with their own memory or remote displays). Not all drivers support it. */
+	if (damage && damage->count && get_plane_property_id("FB_DAMAGE_CLIPS")) {
+		struct drm_mode_rect clips[DRM_DAMAGE_RECTS];
+		uint32_t i;
+
+		for (i = 0; i < damage->count; i++) {
+			clips[i].x1 = damage->rects[i].x1;
+			clips[i].y1 = damage->rects[i].y1;
+			clips[i].x2 = damage->rects[i].x2 + 1;
+			clips[i].y2 = damage->rects[i].y2 + 1;
+		}
+
+		if (drmModeCreatePropertyBlob(drm_dev.fd, clips, sizeof(clips[0]) * damage->count, &damage_blob))
+			damage_blob = 0;
+		else
+			drm_add_plane_property("FB_DAMAGE_CLIPS", damage_blob);
+	}
+
 	ret = drmModeAtomicCommit(drm_dev.fd, drm_dev.req, flags, NULL);
 	if (ret) {
 		err("drmModeAtomicCommit failed: %s", strerror(errno));
-		drmModeAtomicFree(drm_dev.req);
-		return ret;
+	} else {
+		drm_dev.flip_pending = true;
 	}
 
-	return 0;
+	/* The commit holds its own reference to the blob */
+	if (damage_blob)
+		drmModeDestroyPropertyBlob(drm_dev.fd, damage_blob);
+
+	drmModeAtomicFree(drm_dev.req);
+	drm_dev.req = NULL;
+
+	return ret;
 }
 
 static int find_plane(unsigned int fourcc, uint32_t *plane_id, uint32_t crtc_id, uint32_t crtc_idx)
@@ -681,47 +725,160 @@ static int drm_setup_buffers(void)
 	/* Set buffering handling */
 	drm_dev.cur_bufs[0] = NULL;
 	drm_dev.cur_bufs[1] = &drm_dev.drm_bufs[0];
+	drm_dev.frame = 1;
 
 	return 0;
 }
 
-void drm_wait_vsync(lv_disp_drv_t *disp_drv)
+static void drm_damage_add(struct drm_damage *damage, const lv_area_t *area)
 {
-	int ret;
-	fd_set fds;
-	FD_ZERO(&fds);
-	FD_SET(drm_dev.fd, &fds);
+	uint32_t i;
 
-	do {
-		ret = select(drm_dev.fd + 1, &fds, NULL, NULL, NULL);
-	} while (ret == -1 && errno == EINTR);
+	/* Merge with an overlapping rectangle to avoid copying the same pixels twice */
+	for (i = 0; i < damage->count; i++) {
+		if (_lv_area_is_on(&damage->rects[i], area)) {
+			_lv_area_join(&damage->rects[i], &damage->rects[i], area);
+			return;
+		}
+	}
 
-	if (ret < 0) {
-		err("select failed: %s", strerror(errno));
-		drmModeAtomicFree(drm_dev.req);
-		drm_dev.req = NULL;
+	if (damage->count < DRM_DAMAGE_RECTS) {
+		lv_area_copy(&damage->rects[damage->count], area);
+		damage->count++;
+		return;
+	}
+
+	/* Out of space: keep only the bounding box */
+	for (i = 1; i < damage->count; i++)
+		_lv_area_join(&damage->rects[0], &damage->rects[0], &damage->rects[i]);
+
+	_lv_area_join(&damage->rects[0], &damage->rects[0], area);
+	damage->count = 1;
+}
+
+static void drm_copy_area(struct drm_buffer *dst, const struct drm_buffer *src, const lv_area_t *area)
+{
+	uint32_t offset = area->x1 * (LV_COLOR_SIZE / 8) + area->y1 * dst->pitch;
+	uint32_t len = lv_area_get_width(area) * (LV_COLOR_SIZE / 8);
+	lv_coord_t y;
+
+	for (y = area->y1; y <= area->y2; y++) {
+		memcpy((uint8_t *)dst->map + offset, (uint8_t *)src->map + offset, len);
+		offset += dst->pitch;
+	}
+}
+
+/* Check whether the current frame redraws the whole area anyway */
+static bool drm_area_is_redrawn(const lv_area_t *area)
+{
+	lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+	uint16_t i;
+
+	if (!disp)
+		return false;
+
+	for (i = 0; i < disp->inv_p; i++) {
+		if (disp->inv_area_joined[i])
+			continue;
+
+		if (_lv_area_is_in(area, &disp->inv_areas[i], 0))
+			return true;
+	}
+
+	return false;
+}
+
+/* Bring the back buffer up to date with the front buffer by copying only the areas
+ * which changed since the back buffer was last rendered (buffer age). */
+static void drm_repair_back_buffer(struct drm_buffer *back, const struct drm_buffer *front)
+{
+	uint32_t age = back->frame ? drm_dev.frame - back->frame : 0;
+	uint32_t f, i;
+
+	if (age == 1)
+		return; /* Nothing changed since */
+
+	if (age == 0 || age > DRM_DAMAGE_HISTORY) {
+		lv_area_t full;
+
+		lv_area_set(&full, 0, 0, drm_dev.width - 1, drm_dev.height - 1);
+		if (!drm_area_is_redrawn(&full))
+			memcpy(back->map, front->map, back->size);
 		return;
 	}
 
-	if (FD_ISSET(drm_dev.fd, &fds))
+	for (f = back->frame + 1; f < drm_dev.frame; f++) {
+		const struct drm_damage *damage = &drm_dev.damage[f % DRM_DAMAGE_HISTORY];
+
+		for (i = 0; i < damage->count; i++) {
+			if (!drm_area_is_redrawn(&damage->rects[i]))
+				drm_copy_area(back, front, &damage->rects[i]);
+		}
+	}
+}
+
+int drm_get_fd(void)
+{
+	return drm_dev.fd;
+}
+
+void drm_handle_events(void)
+{
+	struct pollfd pfd = {
+		.fd = drm_dev.fd,
+		.events = POLLIN,
+	};
+
+	if (!drm_dev.flip_pending)
+		return;
+
+	if (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN))
 		drmHandleEvent(drm_dev.fd, &drm_dev.drm_event_ctx);
+}
 
-	drmModeAtomicFree(drm_dev.req);
-	drm_dev.req = NULL;
+void drm_wait_vsync(lv_disp_drv_t *disp_drv)
+{
+	int ret;
+	fd_set fds;
+
+	while (drm_dev.flip_pending) {
+		FD_ZERO(&fds);
+		FD_SET(drm_dev.fd, &fds);
+
+		do {
+			ret = select(drm_dev.fd + 1, &fds, NULL, NULL, NULL);
+		} while (ret == -1 && errno == EINTR);
+
+		if (ret < 0) {
+			err("select failed: %s", strerror(errno));
+			drm_dev.flip_pending = false;
+			return;
+		}
+
+		if (FD_ISSET(drm_dev.fd, &fds))
+			drmHandleEvent(drm_dev.fd, &drm_dev.drm_event_ctx);
+	}
 }
 
 void drm_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
 	struct drm_buffer *fbuf = drm_dev.cur_bufs[1];
+	struct drm_damage *damage = &drm_dev.damage[drm_dev.frame % DRM_DAMAGE_HISTORY];
 	lv_coord_t w = (area->x2 - area->x1 + 1);
-	lv_coord_t h = (area->y2 - area->y1 + 1);
 	int i, y;
 
-	dbg("x %d:%d y %d:%d w %d h %d", area->x1, area->x2, area->y1, area->y2, w, h);
+	dbg("x %d:%d y %d:%d w %d h %d", area->x1, area->x2, area->y1, area->y2, w, area->y2 - area->y1 + 1);
 
-	/* Partial update */
-	if ((w != drm_dev.width || h != drm_dev.height) && drm_dev.cur_bufs[0])
-		memcpy(fbuf->map, drm_dev.cur_bufs[0]->map, fbuf->size);
+	if (!drm_dev.frame_started) {
+		/* The back buffer is still scanned out until the previous flip completes */
+		drm_wait_vsync(disp_drv);
+
+		if (drm_dev.cur_bufs[0])
+			drm_repair_back_buffer(fbuf, drm_dev.cur_bufs[0]);
+
+		damage->count = 0;
+		drm_dev.frame_started = true;
+	}
 
 	for (y = 0, i = area->y1 ; i <= area->y2 ; ++i, ++y) {
                 memcpy((uint8_t *)fbuf->map + (area->x1 * (LV_COLOR_SIZE/8)) + (fbuf->pitch * i),
@@ -729,17 +886,30 @@ void drm_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color
 		       w * (LV_COLOR_SIZE/8));
 	}
 
-	if (drm_dev.req)
-		drm_wait_vsync(disp_drv);
+	drm_damage_add(damage, area);
 
-	/* show fbuf plane */
-	if (drm_dmabuf_set_plane(fbuf)) {
+	/* The pixels are copied so LVGL can render the next area or frame meanwhile */
+	if (!lv_disp_flush_is_last(disp_drv)) {
+		lv_disp_flush_ready(disp_drv);
+		return;
+	}
+
+	drm_dev.frame_started = false;
+
+	/* show fbuf plane. The flip completes in the background, see drm_handle_events() */
+	if (drm_dmabuf_set_plane(fbuf, damage)) {
 		err("Flush fail");
+		/* Keep the back buffer and its damage. The next frame is drawn on top and shown with it. */
+		drm_dev.frame_started = true;
+		lv_disp_flush_ready(disp_drv);
 		return;
 	}
 	else
 		dbg("Flush done");
 
+	fbuf->frame = drm_dev.frame;
+	drm_dev.frame++;
+
 	if (!drm_dev.cur_bufs[0])
 		drm_dev.cur_bufs[1] = &drm_dev.drm_bufs[1];
 	else
@@ -794,6 +964,7 @@ void drm_init(void)
 
 void drm_exit(void)
 {
+	drm_wait_vsync(NULL);
 	close(drm_dev.fd);
 	drm_dev.fd = -1;
 }
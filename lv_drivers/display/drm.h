@@ -45,6 +45,10 @@ void drm_get_sizes(lv_coord_t *width, lv_coord_t *height, uint32_t *dpi);
 void drm_exit(void);
 void drm_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 void drm_wait_vsync(lv_disp_drv_t * drv);
+/* Page flips are non-blocking. Call this from the main loop (e.g. when drm_get_fd() is readable)
+ * to complete them, otherwise the next frame waits for the flip in drm_flush(). */
+void drm_handle_events(void);
+int drm_get_fd(void);
 
 
 /**********************
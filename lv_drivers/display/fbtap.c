@@ -0,0 +1,557 @@
+/**
+ * @file fbtap.c
+ * Stream the flushed areas of a display to a receiver over a socket
+ *
+ * The stream (all values are little-endian):
+ * - After connecting: "LVFB", version, bytes per pixel, color depth, 0 (reserved), width (u16), height (u16)
+ * - Messages: type (u8), 0 (u8), x, y, width, height (u16), payload size (u32), payload
+ *   - MSG_RECT: the run-length encoded pixels of the area
+ *   - MSG_DELTA: the run-length encoded XOR of the pixels of the area with the previously sent ones
+ *   - MSG_FRAME_END: all areas of an update were sent (x, y, width, height and size are 0)
+ * - Run-length encoding: a control byte c < 128 is followed by c + 1 literal pixels,
+ *   c >= 128 by a pixel which is repeated c - 126 times.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "fbtap.h"
+#if USE_FBTAP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef FBTAP_ADDR
+#define FBTAP_ADDR          "/tmp/fbtap.sock"
+#endif
+
+#ifndef FBTAP_CPU_SHARE
+#define FBTAP_CPU_SHARE     5
+#endif
+
+#ifndef FBTAP_PERIOD
+#define FBTAP_PERIOD        40
+#endif
+
+#ifndef FBTAP_DELTA
+#define FBTAP_DELTA         1
+#endif
+
+#define DIRTY_MAX           16      /*Number of areas stored until the next update. More are merged.*/
+#define SEND_TIMEOUT        2       /*[s] Drop the receiver if it doesn't read the stream for this long*/
+#define HELLO_SIZE          12
+#define MSG_HEADER_SIZE     14
+
+#define MSG_RECT            1
+#define MSG_DELTA           2
+#define MSG_FRAME_END       3
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static int open_listen_socket(const char * addr);
+static bool alloc_buffers(lv_coord_t w, lv_coord_t h);
+static void free_buffers(void);
+static void * tap_thread(void * arg);
+static bool accept_client(void);
+static void close_client(void);
+static bool send_update(void);
+static bool send_all(const void * buf, size_t size);
+static void add_dirty(const lv_area_t * area);
+static uint32_t rle_encode(uint8_t * dst, const lv_color_t * src, uint32_t px_cnt);
+static void put_u16(uint8_t * p, uint32_t v);
+static void put_u32(uint8_t * p, uint32_t v);
+static uint64_t thread_time_us(void);
+static void sleep_us(uint64_t us);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static void (*wrapped_flush_cb)(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static pthread_t thread;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;  /*Protects `frame`, `dirty` and `thread_exit`*/
+static bool thread_exit;
+static bool alloc_failed;
+static int listen_fd = -1;
+static int client_fd = -1;
+static lv_color_t * frame;          /*Copy of the flushed pixels*/
+static lv_color_t * sent;           /*The pixels the receiver has. Used only with FBTAP_DELTA.*/
+static lv_color_t * area_buf;       /*Pixels of the areas to send, copied from `frame`*/
+static uint8_t * msg_buf;           /*An encoded message*/
+static lv_coord_t frame_w;
+static lv_coord_t frame_h;
+static lv_area_t dirty[DIRTY_MAX];  /*Flushed since the last update*/
+static uint32_t dirty_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void fbtap_init(void (*flush_cb)(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p))
+{
+    wrapped_flush_cb = flush_cb;
+
+    listen_fd = open_listen_socket(FBTAP_ADDR);
+    if(listen_fd < 0) return;
+
+    thread_exit = false;
+    if(pthread_create(&thread, NULL, tap_thread, NULL) != 0) {
+        perror("Error: cannot create the fbtap thread");
+        close(listen_fd);
+        listen_fd = -1;
+        return;
+    }
+
+    LV_LOG_INFO("Streaming the display on %s", FBTAP_ADDR);
+}
+
+void fbtap_exit(void)
+{
+    if(listen_fd < 0) return;
+
+    pthread_mutex_lock(&mutex);
+    thread_exit = true;
+    pthread_mutex_unlock(&mutex);
+    pthread_join(thread, NULL);
+
+    close_client();
+    close(listen_fd);
+    listen_fd = -1;
+    if(strchr(FBTAP_ADDR, ':') == NULL) unlink(FBTAP_ADDR);
+
+    free_buffers();
+    dirty_cnt = 0;
+    alloc_failed = false;
+}
+
+void fbtap_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    if(listen_fd >= 0 && !alloc_failed) {
+        pthread_mutex_lock(&mutex);
+        if(frame == NULL && !alloc_buffers(drv->hor_res, drv->ver_res)) {
+            LV_LOG_WARN("Not enough memory to stream the display");
+            alloc_failed = true;
+        }
+
+        lv_area_t scr_area;
+        lv_area_t a;
+        lv_area_set(&scr_area, 0, 0, frame_w - 1, frame_h - 1);
+        if(frame && _lv_area_intersect(&a, area, &scr_area)) {
+            lv_coord_t src_w = lv_area_get_width(area);
+            const lv_color_t * src = color_p + (a.y1 - area->y1) * src_w + (a.x1 - area->x1);
+            lv_color_t * dst = frame + a.y1 * frame_w + a.x1;
+            size_t row_size = lv_area_get_width(&a) * sizeof(lv_color_t);
+            lv_coord_t y;
+            for(y = a.y1; y <= a.y2; y++) {
+                memcpy(dst, src, row_size);
+                src += src_w;
+                dst += frame_w;
+            }
+            add_dirty(&a);
+        }
+        pthread_mutex_unlock(&mutex);
+    }
+
+    wrapped_flush_cb(drv, area, color_p);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Open a non-blocking socket to accept the receiver on
+ * @param addr path of a Unix socket or "host:port" of a TCP socket
+ * @return the socket or -1 on error
+ */
+static int open_listen_socket(const char * addr)
+{
+    int fd;
+    const char * colon = strrchr(addr, ':');
+    if(colon == NULL) {
+        struct sockaddr_un sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sun_family = AF_UNIX;
+        if(strlen(addr) >= sizeof(sa.sun_path)) {
+            LV_LOG_WARN("Too long socket path: %s", addr);
+            return -1;
+        }
+        strcpy(sa.sun_path, addr);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(fd < 0) {
+            perror("Error: cannot open the fbtap socket");
+            return -1;
+        }
+
+        unlink(addr);
+        if(bind(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+            perror("Error: cannot bind the fbtap socket");
+            close(fd);
+            return -1;
+        }
+    }
+    else {
+        char host[64];
+        size_t host_len = colon - addr;
+        if(host_len >= sizeof(host)) host_len = sizeof(host) - 1;
+        memcpy(host, addr, host_len);
+        host[host_len] = '\0';
+
+        struct sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons(atoi(colon + 1));
+        /*Only local connections by default*/
+        if(host_len == 0) sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        else if(inet_pton(AF_INET, host, &sa.sin_addr) != 1) {
+            LV_LOG_WARN("Invalid address: %s", addr);
+            return -1;
+        }
+
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if(fd < 0) {
+            perror("Error: cannot open the fbtap socket");
+            return -1;
+        }
+
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if(bind(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+            perror("Error: cannot bind the fbtap socket");
+            close(fd);
+            return -1;
+        }
+    }
+
+    if(listen(fd, 1) < 0) {
+        perror("Error: cannot listen on the fbtap socket");
+        close(fd);
+        return -1;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+static bool alloc_buffers(lv_coord_t w, lv_coord_t h)
+{
+    size_t px_cnt = (size_t)w * h;
+    frame = calloc(px_cnt, sizeof(lv_color_t));
+    area_buf = malloc(px_cnt * sizeof(lv_color_t));
+    /*In the worst case every pixel has a control byte*/
+    msg_buf = malloc(MSG_HEADER_SIZE + px_cnt * (sizeof(lv_color_t) + 1));
+#if FBTAP_DELTA
+    sent = calloc(px_cnt, sizeof(lv_color_t));
+    if(sent == NULL) {
+        free_buffers();
+        return false;
+    }
+#endif
+
+    if(frame == NULL || area_buf == NULL || msg_buf == NULL) {
+        free_buffers();
+        return false;
+    }
+
+    frame_w = w;
+    frame_h = h;
+    return true;
+}
+
+static void free_buffers(void)
+{
+    free(frame);
+    free(sent);
+    free(area_buf);
+    free(msg_buf);
+    frame = NULL;
+    sent = NULL;
+    area_buf = NULL;
+    msg_buf = NULL;
+}
+
+static void * tap_thread(void * arg)
+{
+    (void)arg;
+
+    while(1) {
+        pthread_mutex_lock(&mutex);
+        bool exit_req = thread_exit;
+        pthread_mutex_unlock(&mutex);
+        if(exit_req) break;
+
+        sleep_us(FBTAP_PERIOD * 1000);
+
+        if(client_fd < 0 && !accept_client()) continue;
+
+        uint64_t t_start = thread_time_us();
+        if(!send_update()) {
+            close_client();
+            continue;
+        }
+
+        /*Rest to use at most FBTAP_CPU_SHARE % of a CPU. The period is slept anyway.*/
+        uint64_t t_work = thread_time_us() - t_start;
+        uint64_t t_rest = t_work * (100 - FBTAP_CPU_SHARE) / FBTAP_CPU_SHARE;
+        if(t_rest > FBTAP_PERIOD * 1000) sleep_us(t_rest - FBTAP_PERIOD * 1000);
+    }
+
+    return NULL;
+}
+
+static bool accept_client(void)
+{
+    /*The size of the display is known after the first flush*/
+    pthread_mutex_lock(&mutex);
+    bool ready = frame != NULL;
+    pthread_mutex_unlock(&mutex);
+    if(!ready) return false;
+
+    int fd = accept(listen_fd, NULL, NULL);
+    if(fd < 0) return false;
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    struct timeval timeout = {SEND_TIMEOUT, 0};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    client_fd = fd;
+
+    uint8_t hello[HELLO_SIZE] = {'L', 'V', 'F', 'B', FBTAP_VERSION, sizeof(lv_color_t), LV_COLOR_DEPTH, 0};
+    put_u16(&hello[8], frame_w);
+    put_u16(&hello[10], frame_h);
+    if(!send_all(hello, sizeof(hello))) {
+        close_client();
+        return false;
+    }
+
+    /*Start with the whole screen*/
+#if FBTAP_DELTA
+    memset(sent, 0, (size_t)frame_w * frame_h * sizeof(lv_color_t));
+#endif
+    pthread_mutex_lock(&mutex);
+    lv_area_set(&dirty[0], 0, 0, frame_w - 1, frame_h - 1);
+    dirty_cnt = 1;
+    pthread_mutex_unlock(&mutex);
+
+    return true;
+}
+
+static void close_client(void)
+{
+    if(client_fd < 0) return;
+
+    close(client_fd);
+    client_fd = -1;
+}
+
+/**
+ * Send the areas flushed since the last update
+ * @return false if the receiver is disconnected
+ */
+static bool send_update(void)
+{
+    lv_area_t areas[DIRTY_MAX];
+
+    pthread_mutex_lock(&mutex);
+    uint32_t area_cnt = dirty_cnt;
+    memcpy(areas, dirty, sizeof(lv_area_t) * area_cnt);
+    dirty_cnt = 0;
+
+    /*The overlapping areas might need more space than the screen*/
+    uint32_t i;
+    uint32_t total_px = 0;
+    for(i = 0; i < area_cnt; i++) total_px += lv_area_get_size(&areas[i]);
+    if(total_px > (uint32_t)frame_w * frame_h) {
+        lv_area_set(&areas[0], 0, 0, frame_w - 1, frame_h - 1);
+        area_cnt = 1;
+    }
+
+    /*Copy the pixels to not block the flushing while they are encoded and sent*/
+    lv_color_t * dst = area_buf;
+    for(i = 0; i < area_cnt; i++) {
+        lv_coord_t w = lv_area_get_width(&areas[i]);
+        lv_coord_t y;
+        for(y = areas[i].y1; y <= areas[i].y2; y++) {
+            memcpy(dst, frame + y * frame_w + areas[i].x1, w * sizeof(lv_color_t));
+            dst += w;
+        }
+    }
+    pthread_mutex_unlock(&mutex);
+
+    if(area_cnt == 0) {
+        /*Nothing to send, but notice if the receiver has disconnected*/
+        char c;
+        return recv(client_fd, &c, 1, MSG_DONTWAIT | MSG_PEEK) != 0;
+    }
+
+    lv_color_t * px = area_buf;
+    for(i = 0; i < area_cnt; i++) {
+        const lv_area_t * a = &areas[i];
+        lv_coord_t w = lv_area_get_width(a);
+        uint32_t px_cnt = lv_area_get_size(a);
+        uint8_t type = MSG_RECT;
+
+#if FBTAP_DELTA
+        /*Unchanged pixels become 0 which compresses well*/
+        type = MSG_DELTA;
+        lv_color_t * row = px;
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = a->y1; y <= a->y2; y++) {
+            lv_color_t * prev = sent + y * frame_w + a->x1;
+            for(x = 0; x < w; x++) {
+                lv_color_t c = row[x];
+                row[x].full ^= prev[x].full;
+                prev[x] = c;
+            }
+            row += w;
+        }
+#endif
+
+        uint32_t size = rle_encode(msg_buf + MSG_HEADER_SIZE, px, px_cnt);
+        msg_buf[0] = type;
+        msg_buf[1] = 0;
+        put_u16(&msg_buf[2], a->x1);
+        put_u16(&msg_buf[4], a->y1);
+        put_u16(&msg_buf[6], w);
+        put_u16(&msg_buf[8], lv_area_get_height(a));
+        put_u32(&msg_buf[10], size);
+        if(!send_all(msg_buf, MSG_HEADER_SIZE + size)) return false;
+
+        px += px_cnt;
+    }
+
+    uint8_t frame_end[MSG_HEADER_SIZE] = {MSG_FRAME_END};
+    return send_all(frame_end, sizeof(frame_end));
+}
+
+static bool send_all(const void * buf, size_t size)
+{
+    const uint8_t * p = buf;
+    while(size > 0) {
+        ssize_t n = send(client_fd, p, size, MSG_NOSIGNAL);
+        if(n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+
+    return true;
+}
+
+static void add_dirty(const lv_area_t * area)
+{
+    uint32_t i;
+    for(i = 0; i < dirty_cnt; i++) {
+        if(_lv_area_is_in(area, &dirty[i], 0)) return;
+
+        /*Join the overlapping areas if the joined area is smaller*/
+        if(_lv_area_is_on(area, &dirty[i])) {
+            lv_area_t joined;
+            _lv_area_join(&joined, area, &dirty[i]);
+            if(lv_area_get_size(&joined) < lv_area_get_size(area) + lv_area_get_size(&dirty[i])) {
+                dirty[i] = joined;
+                return;
+            }
+        }
+    }
+
+    if(dirty_cnt < DIRTY_MAX) {
+        dirty[dirty_cnt] = *area;
+        dirty_cnt++;
+        return;
+    }
+
+    /*No more space: keep only the bounding box*/
+    for(i = 1; i < dirty_cnt; i++) _lv_area_join(&dirty[0], &dirty[0], &dirty[i]);
+    _lv_area_join(&dirty[0], &dirty[0], area);
+    dirty_cnt = 1;
+}
+
+/**
+ * Run-length encode pixels
+ * @param dst       store the encoded data here. Needs `px_cnt * (sizeof(lv_color_t) + 1)` bytes in the worst case.
+ * @param src       the pixels
+ * @param px_cnt    number of pixels
+ * @return          size of the encoded data
+ */
+static uint32_t rle_encode(uint8_t * dst, const lv_color_t * src, uint32_t px_cnt)
+{
+    uint8_t * d = dst;
+    uint32_t i = 0;
+    while(i < px_cnt) {
+        uint32_t run = 1;
+        while(run < 129 && i + run < px_cnt && src[i + run].full == src[i].full) run++;
+
+        if(run >= 2) {
+            *d++ = (uint8_t)(run + 126);
+            memcpy(d, &src[i], sizeof(lv_color_t));
+            d += sizeof(lv_color_t);
+            i += run;
+            continue;
+        }
+
+        /*Collect the literals until a run starts*/
+        uint32_t lit = 1;
+        while(lit < 128 && i + lit < px_cnt) {
+            if(i + lit + 1 < px_cnt && src[i + lit].full == src[i + lit + 1].full) break;
+            lit++;
+        }
+
+        *d++ = (uint8_t)(lit - 1);
+        memcpy(d, &src[i], lit * sizeof(lv_color_t));
+        d += lit * sizeof(lv_color_t);
+        i += lit;
+    }
+
+    return d - dst;
+}
+
+static void put_u16(uint8_t * p, uint32_t v)
+{
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+}
+
+static void put_u32(uint8_t * p, uint32_t v)
+{
+    put_u16(p, v & 0xffff);
+    put_u16(p + 2, v >> 16);
+}
+
+static uint64_t thread_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sleep_us(uint64_t us)
+{
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+}
+
+#endif /*USE_FBTAP*/
@@ -0,0 +1,74 @@
+/**
+ * @file fbtap.h
+ * Stream the flushed areas of a display to a receiver over a socket
+ */
+
+#ifndef FBTAP_H
+#define FBTAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifndef LV_DRV_NO_CONF
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_drv_conf.h"
+#else
+#include "../../lv_drv_conf.h"
+#endif
+#endif
+
+#if USE_FBTAP
+
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Version of the stream. See `tools/fbtap_recv.c` for a receiver.*/
+#define FBTAP_VERSION   1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+/**
+ * Start listening on `FBTAP_ADDR`. Use `fbtap_flush` as the display's flush callback after this.
+ * @param flush_cb the flush callback to wrap, e.g. `fbdev_flush`
+ */
+void fbtap_init(void (*flush_cb)(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p));
+
+/**
+ * Stop the streaming thread and close the sockets
+ */
+void fbtap_exit(void);
+
+/**
+ * Save the flushed area for the receiver and call the wrapped flush callback
+ * @param drv pointer to driver where this function belongs
+ * @param area an area where to copy `color_p`
+ * @param color_p an array of pixels to copy to the `area` part of the screen
+ */
+void fbtap_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*USE_FBTAP*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*FBTAP_H*/
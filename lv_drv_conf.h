@@ -334,6 +334,21 @@
 # define FBDEV_PATH		"/dev/fb0"
 #endif
 
+/*-----------------------------------------
+ *  Stream the flushed areas to a receiver
+ *  (wraps another flush callback, e.g. fbdev_flush)
+ *-----------------------------------------*/
+#ifndef USE_FBTAP
+#  define USE_FBTAP           0
+#endif
+
+#if USE_FBTAP
+#  define FBTAP_ADDR          "/tmp/fbtap.sock"   /* Unix socket path or "host:port" for TCP (":port" is local only) */
+#  define FBTAP_CPU_SHARE     5                   /* [%] At most this much of a CPU is used for streaming */
+#  define FBTAP_PERIOD        40                  /* [ms] Send the changes at most this often */
+#  define FBTAP_DELTA         1                   /* 1: send only the changed pixels of the flushed areas */
+#endif
+
 /*-----------------------------------------
  *  DRM/KMS device (/dev/dri/cardX)
  *-----------------------------------------*/
@@ -92,6 +92,8 @@ static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px);
 static void scene_next_task_cb(lv_timer_t * timer);
 static void rect_create(lv_style_t * style);
 static void img_create(lv_style_t * style, const void * src, bool rotate, bool zoom, bool aa);
+static void img_set_exact_transform(bool rotate, bool zoom);
+static const lv_img_dsc_t * img_get_alpha8(void);
 static void txt_create(lv_style_t * style);
 static void line_create(lv_style_t * style);
 static void arc_create(lv_style_t * style);
@@ -408,6 +410,74 @@ static void img_argb_zoom_aa_cb(void)
 #endif
 }
 
+static void img_ckey_rot_aa_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    img_create(&style_common, &img_benchmark_cogwheel_chroma_keyed, true, false, true);
+}
+
+static void img_ckey_zoom_aa_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    img_create(&style_common, &img_benchmark_cogwheel_chroma_keyed, false, true, true);
+}
+
+static void img_alpha_rot_aa_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    img_create(&style_common, img_get_alpha8(), true, false, true);
+}
+
+static void img_alpha_zoom_aa_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    img_create(&style_common, img_get_alpha8(), false, true, true);
+}
+
+static void img_rgb_rot_90_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    img_create(&style_common, &img_benchmark_cogwheel_rgb, false, false, false);
+    img_set_exact_transform(true, false);
+}
+
+static void img_argb_rot_90_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+#if LV_DEMO_BENCHMARK_RGB565A8 && LV_COLOR_DEPTH == 16
+    img_create(&style_common, &img_benchmark_cogwheel_rgb565a8, false, false, false);
+#else
+    img_create(&style_common, &img_benchmark_cogwheel_argb, false, false, false);
+#endif
+    img_set_exact_transform(true, false);
+}
+
+static void img_rgb_zoom_2x_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    img_create(&style_common, &img_benchmark_cogwheel_rgb, false, false, false);
+    img_set_exact_transform(false, true);
+}
+
+static void img_argb_zoom_2x_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+#if LV_DEMO_BENCHMARK_RGB565A8 && LV_COLOR_DEPTH == 16
+    img_create(&style_common, &img_benchmark_cogwheel_rgb565a8, false, false, false);
+#else
+    img_create(&style_common, &img_benchmark_cogwheel_argb, false, false, false);
+#endif
+    img_set_exact_transform(false, true);
+}
+
 static void txt_small_cb(void)
 {
     lv_style_reset(&style_common);
@@ -606,6 +676,14 @@ static scene_dsc_t scenes[] = {
     {.name = "Image RGB zoom anti aliased",  .weight = 3, .create_cb = img_rgb_zoom_aa_cb},
     {.name = "Image ARGB zoom",              .weight = 5, .create_cb = img_argb_zoom_cb},
     {.name = "Image ARGB zoom anti aliased", .weight = 5, .create_cb = img_argb_zoom_aa_cb},
+    {.name = "Image chroma keyed rotate anti aliased", .weight = 2, .create_cb = img_ckey_rot_aa_cb},
+    {.name = "Image chroma keyed zoom anti aliased", .weight = 2, .create_cb = img_ckey_zoom_aa_cb},
+    {.name = "Image alpha only rotate anti aliased", .weight = 2, .create_cb = img_alpha_rot_aa_cb},
+    {.name = "Image alpha only zoom anti aliased", .weight = 2, .create_cb = img_alpha_zoom_aa_cb},
+    {.name = "Image RGB rotate 90",          .weight = 2, .create_cb = img_rgb_rot_90_cb},
+    {.name = "Image ARGB rotate 90",         .weight = 3, .create_cb = img_argb_rot_90_cb},
+    {.name = "Image RGB zoom 2x",            .weight = 2, .create_cb = img_rgb_zoom_2x_cb},
+    {.name = "Image ARGB zoom 2x",           .weight = 3, .create_cb = img_argb_zoom_2x_cb},
 
     {.name = "Text small",                   .weight = 20, .create_cb = txt_small_cb},
     {.name = "Text medium",                  .weight = 30, .create_cb = txt_medium_cb},
@@ -1074,6 +1152,44 @@ static void img_create(lv_style_t * style, const void * src, bool rotate, bool z
 }
 
 
+/*Rotate the images by 90, 180 or 270 degrees or zoom them to 2x to measure the exact transformations*/
+static void img_set_exact_transform(bool rotate, bool zoom)
+{
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(scene_bg); i++) {
+        lv_obj_t * obj = lv_obj_get_child(scene_bg, i);
+        if(rotate) lv_img_set_angle(obj, rnd_next(1, 3) * 900);
+        if(zoom) lv_img_set_zoom(obj, 2 * LV_IMG_ZOOM_NONE);
+    }
+}
+
+/*Only 8 bit alpha images can be transformed, so convert the 4 bit alpha image*/
+static const lv_img_dsc_t * img_get_alpha8(void)
+{
+    static uint8_t map[IMG_WIDH * IMG_HEIGHT];
+    static lv_img_dsc_t dsc;
+    if(dsc.data) return &dsc;
+
+    const lv_img_dsc_t * src = &img_benchmark_cogwheel_alpha16;
+    uint32_t src_stride = (src->header.w + 1) / 2;
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < src->header.h; y++) {
+        for(x = 0; x < src->header.w; x++) {
+            uint8_t px = src->data[y * src_stride + x / 2];
+            px = (x & 1) ? (px & 0x0F) : (px >> 4);
+            map[y * src->header.w + x] = px * 17;
+        }
+    }
+
+    dsc.header.w = src->header.w;
+    dsc.header.h = src->header.h;
+    dsc.header.cf = LV_IMG_CF_ALPHA_8BIT;
+    dsc.data_size = sizeof(map);
+    dsc.data = map;
+    return &dsc;
+}
+
 static void txt_create(lv_style_t * style)
 {
     uint32_t i;
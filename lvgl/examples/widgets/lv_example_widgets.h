@@ -108,6 +108,8 @@ void lv_example_msgbox_1(void);
 void lv_example_obj_1(void);
 void lv_example_obj_2(void);
 
+void lv_example_readout_1(void);
+
 void lv_example_roller_1(void);
 void lv_example_roller_2(void);
 void lv_example_roller_3(void);
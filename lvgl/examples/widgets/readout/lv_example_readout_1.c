@@ -0,0 +1,26 @@
+#include "../../lv_examples.h"
+#if LV_USE_READOUT && LV_BUILD_EXAMPLES
+
+static void timer_cb(lv_timer_t * timer)
+{
+    lv_obj_t * readout = timer->user_data;
+
+    /*Only the changed digits will be redrawn*/
+    int32_t v = lv_readout_get_value(readout) + (int32_t)lv_rand(0, 10) - 5;
+    lv_readout_set_value(readout, v);
+}
+
+/**
+ * Show a temperature with 0.1 °C resolution
+ */
+void lv_example_readout_1(void)
+{
+    lv_obj_t * readout = lv_readout_create(lv_scr_act());
+    lv_readout_set_format(readout, "%d °C", 3, 1);
+    lv_readout_set_value(readout, 253);
+    lv_obj_center(readout);
+
+    lv_timer_create(timer_cb, 200, readout);
+}
+
+#endif
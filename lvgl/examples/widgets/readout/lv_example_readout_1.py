@@ -0,0 +1,16 @@
+import random
+
+def timer_cb(timer):
+    # Only the changed digits will be redrawn
+    v = readout.get_value() + random.randint(0, 10) - 5
+    readout.set_value(v)
+
+#
+# Show a temperature with 0.1 °C resolution
+#
+readout = lv.readout(lv.scr_act())
+readout.set_format("%d °C", 3, 1)
+readout.set_value(253)
+readout.center()
+
+lv.timer_create(timer_cb, 200, None)
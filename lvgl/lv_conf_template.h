@@ -67,6 +67,22 @@
 #define LV_STRLEN       lv_strlen_builtin
 #define LV_STRNCPY      lv_strncpy_builtin
 
+/*=================
+ * OPERATING SYSTEM
+ *=================*/
+
+/*Select an operating system to use. Possible options:
+ * - LV_OS_NONE
+ * - LV_OS_PTHREAD
+ * - LV_OS_CUSTOM
+ *It's used by the modules which can use threads (e.g. GIF pre-decoding)
+ *and to make the built-in memory manager thread safe.*/
+#define LV_USE_OS   LV_OS_NONE
+
+#if LV_USE_OS == LV_OS_CUSTOM
+    #define LV_OS_CUSTOM_INCLUDE <stdint.h>
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -111,7 +127,7 @@
 
     /*Allow buffering some shadow calculation.
     *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost which is shared by the recently used smaller shadows*/
     #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
     /* Set number of maximally cached circle data.
@@ -120,6 +136,13 @@
     * 0: to disable caching */
     #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
 
+    /*Size of the cache in bytes for the anti-aliased edges of the recently drawn arcs and rounded rectangles.
+     *The quarter of a ring is cached by its radius and width, so e.g. arcs which change only their angles,
+     *rounded backgrounds and borders are drawn without calculating their edges again.
+     *About `width * radius` bytes are used per ring.
+     *0: to disable caching */
+    #define LV_DRAW_SW_RING_CACHE_SIZE 0
+
     /*Default gradient buffer size.
      *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
      *LV_DRAW_SW_GRADIENT_CACHE_DEF_SIZE sets the size of this cache in bytes.
@@ -216,6 +239,16 @@
     *0: User need to register a callback with `lv_log_register_print_cb()`*/
     #define LV_LOG_PRINTF 0
 
+    /*1: Only copy the format string pointer and the arguments of the logs into a ring buffer of the logging thread
+     *and format and print them on a background thread. Requires `LV_USE_OS`.
+     *The format strings need to be string literals as they are formatted later.*/
+    #define LV_LOG_ASYNC 0
+    #if LV_LOG_ASYNC
+        #define LV_LOG_ASYNC_BUF_SIZE   (16 * 1024) /*Size of the ring buffer of each thread [bytes]. Should be a power of 2.*/
+        #define LV_LOG_ASYNC_THREAD_CNT 4           /*Number of threads which can log asynchronously. The others log synchronously.*/
+        #define LV_LOG_ASYNC_RATE_LIMIT 100         /*Max. number of logs per second from a line of code. 0: no limit*/
+    #endif
+
     /*Enable/disable LV_LOG_TRACE in modules that produces a huge number of logs*/
     #define LV_LOG_TRACE_MEM        1
     #define LV_LOG_TRACE_TIMER      1
@@ -264,6 +297,14 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*1: Record the begin/end of the main rendering steps (timer handler, layout, refresh, draw, flush, indev read)
+ *into a ring buffer. `lv_profiler_flush()` writes them in Chrome trace event (JSON) format.*/
+#define LV_USE_PROFILER 0
+#if LV_USE_PROFILER
+    /*Number of events to store. When the buffer is full the oldest events are overwritten.*/
+    #define LV_PROFILER_BUF_SIZE 4096
+#endif
+
 /*Maximum buffer size to allocate for rotation.
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
@@ -284,6 +325,20 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*Decode image files on worker threads instead of while rendering. Requires `LV_USE_OS`.
+ *A placeholder is drawn until an image is decoded and then the image is swapped in.*/
+#define LV_USE_IMG_DECODER_ASYNC 0
+#if LV_USE_IMG_DECODER_ASYNC
+    #define LV_IMG_DECODER_ASYNC_THREADS 1                                  /*Number of worker threads*/
+    #define LV_IMG_DECODER_ASYNC_CACHE_SIZE (1024 * 1024)                   /*Max. memory of the decoded images [bytes]*/
+    #define LV_IMG_DECODER_ASYNC_PLACEHOLDER_COLOR lv_color_hex(0xe0e0e0)   /*Color of the placeholder*/
+#endif
+
+/*Max. memory used by the cached layers of the objects with `LV_OBJ_FLAG_CACHE_LAYER` [bytes].
+ *A cached object and its children are redrawn only where they have changed.
+ *If the limit is reached the least recently drawn layers are freed.
+ *0: to disable layer caching*/
+#define LV_LAYER_CACHE_MAX_SIZE 0
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -420,6 +475,11 @@
 /*The control character to use for signalling text recoloring.*/
 #define LV_TXT_COLOR_CMD "#"
 
+/*Size of the cache in bytes for the line breaks and line widths of the recently measured or drawn texts.
+ *It helps if the same short texts (e.g. "25.3 C") are set again and again.
+ *0: to disable caching*/
+#define LV_TXT_LAYOUT_CACHE_SIZE 0
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -500,6 +560,8 @@
 
 #define LV_USE_MSGBOX     1
 
+#define LV_USE_READOUT    1   /*Requires: lv_label*/
+
 #define LV_USE_ROLLER     1   /*Requires: lv_label*/
 #if LV_USE_ROLLER
     #define LV_ROLLER_INF_PAGES 7 /*Number of extra "pages" when the roller is infinite*/
@@ -525,6 +587,9 @@
 #endif
 
 #define LV_USE_TABLE      1
+#if LV_USE_TABLE
+    #define LV_TABLE_VIRTUAL 1   /*Allow getting the cells from a callback on demand to show very many rows*/
+#endif
 
 #define LV_USE_TABVIEW    1
 
@@ -566,6 +631,15 @@
 /*A layout similar to Grid in CSS.*/
 #define LV_USE_GRID 1
 
+/*Remember the children and the tracks of flex and grid containers to skip
+ *the tracks and cells which haven't changed when the layout is updated again.
+ *Needs about 40 bytes per child of the containers.*/
+#define LV_USE_LAYOUT_CACHE 0
+#if LV_USE_LAYOUT_CACHE
+    /*Only the containers with at least this many children are cached. The smaller ones are updated quickly anyway.*/
+    #define LV_LAYOUT_CACHE_MIN_CHILD_CNT 16
+#endif
+
 /*====================
  * 3RD PARTS LIBRARIES
  *====================*/
@@ -596,6 +670,13 @@
     #define LV_FS_WIN32_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
 #endif
 
+/*API for mmap. Read only, the files are mapped into the memory and `lv_fs_get_buf()` gives direct access to them*/
+#define LV_USE_FS_MMAP 0
+#if LV_USE_FS_MMAP
+    #define LV_FS_MMAP_LETTER '\0'      /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+    #define LV_FS_MMAP_PATH ""          /*Set the working directory. File/directory paths will be appended to it.*/
+#endif
+
 /*API for FATFS (needs to be added separately). Uses f_open, f_read, etc*/
 #define LV_USE_FS_FATFS 0
 #if LV_USE_FS_FATFS
@@ -605,6 +686,11 @@
 
 /*PNG decoder library*/
 #define LV_USE_PNG 0
+#if LV_USE_PNG
+    /*Don't cache the decoded image but decode the required lines when drawing if the decoded image
+     *would need at least this many bytes. Saves RAM but redrawing the image is slower. 0: always decode the whole image*/
+    #define LV_PNG_READ_LINE_MIN_SIZE 0
+#endif
 
 /*BMP decoder library*/
 #define LV_USE_BMP 0
@@ -612,9 +698,21 @@
 /* JPG + split JPG decoder library.
  * Split JPG is a custom format optimized for embedded systems. */
 #define LV_USE_SJPG 0
+#if LV_USE_SJPG
+    /*Number of decoded strips kept for all JPG and SJPG images. Each strip needs `width * strip height * 3` bytes.
+     *The strips are kept after the image is closed, so redrawing a part of an image doesn't decode it again*/
+    #define LV_SJPG_CACHE_FRAMES 1
+    /*1: Decode the strip below the drawn one in advance on a separate thread. Requires `LV_USE_OS`.*/
+    #define LV_SJPG_PREFETCH 0
+#endif
 
 /*GIF decoder library*/
 #define LV_USE_GIF 0
+#if LV_USE_GIF
+    /*Number of frames to decode in advance on a separate thread. Requires `LV_USE_OS`.
+     *Each frame needs a buffer as large as the GIF. 0: decode the frames in `lv_timer_handler()`*/
+    #define LV_GIF_PREDECODE_FRAMES 0
+#endif
 
 /*QR code library*/
 #define LV_USE_QRCODE 0
@@ -653,6 +751,10 @@
 
 /*1: Enable API to take snapshot for object*/
 #define LV_USE_SNAPSHOT 0
+#if LV_USE_SNAPSHOT
+    /*1: Encode the snapshots of the snapshot sessions on a worker thread. Requires `LV_USE_OS`.*/
+    #define LV_SNAPSHOT_ENCODE_ASYNC 0
+#endif
 
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
@@ -23,12 +23,16 @@ extern "C" {
  *********************/
 
 #include "src/misc/lv_log.h"
+#include "src/misc/lv_log_async.h"
 #include "src/misc/lv_timer.h"
 #include "src/misc/lv_math.h"
 #include "src/misc/lv_mem.h"
 #include "src/misc/lv_async.h"
 #include "src/misc/lv_anim_timeline.h"
 #include "src/misc/lv_printf.h"
+#include "src/misc/lv_profiler.h"
+
+#include "src/osal/lv_os.h"
 
 #include "src/hal/lv_hal.h"
 
@@ -64,6 +68,7 @@ extern "C" {
 #include "src/widgets/menu/lv_menu.h"
 #include "src/widgets/meter/lv_meter.h"
 #include "src/widgets/msgbox/lv_msgbox.h"
+#include "src/widgets/readout/lv_readout.h"
 #include "src/widgets/roller/lv_roller.h"
 #include "src/widgets/slider/lv_slider.h"
 #include "src/widgets/span/lv_span.h"
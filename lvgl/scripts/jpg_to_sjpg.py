@@ -5,20 +5,30 @@
 SJPG_FILE_FORMAT_VERSION = "V1.00"  #
 JPEG_SPLIT_HEIGHT   = 16
 ##################################################################
-import math, os, sys, time
+import argparse, math, os, sys, time
 from PIL import Image
 
 
-OUTPUT_FILE_NAME = ""
-INPUT_FILE       = ""
+parser = argparse.ArgumentParser(description="Convert a JPG image to SJPG (split JPG)")
+parser.add_argument("input_file", help="the JPG image to convert")
+parser.add_argument("--strip-height", type=int, default=JPEG_SPLIT_HEIGHT,
+                    help="height of the JPG strips in rows (default: %(default)s)")
+parser.add_argument("--draw-buf-rows", type=int,
+                    help="rows of the display's draw buffer. The strip height is chosen to match it "
+                         "(rounded down to the 16 rows of the JPG blocks)")
+args = parser.parse_args()
 
+INPUT_FILE = args.input_file
+OUTPUT_FILE_NAME = INPUT_FILE.split("/")[-1].split("\\")[-1].split(".")[0]
 
-if len(sys.argv) == 2:
-    INPUT_FILE = sys.argv[1]
-    OUTPUT_FILE_NAME = INPUT_FILE.split("/")[-1].split("\\")[-1].split(".")[0]
+if args.draw_buf_rows:
+    JPEG_SPLIT_HEIGHT = max(16, args.draw_buf_rows // 16 * 16)
 else:
-    print("usage:\n\t python " + sys.argv[0] + " input_file.jpg")
-    sys.exit(0)
+    JPEG_SPLIT_HEIGHT = args.strip_height
+
+if JPEG_SPLIT_HEIGHT < 1 or JPEG_SPLIT_HEIGHT > 0xffff:
+    print("\nInvalid strip height!")
+    sys.exit(1)
 
 try:
     im = Image.open(INPUT_FILE)
@@ -33,7 +43,8 @@ width, height = im.size
 
 print("Input:")
 print("\t" + INPUT_FILE)
-print("\tRES = " + str(width) + " x " + str(height) + '\n')
+print("\tRES = " + str(width) + " x " + str(height))
+print("\tSTRIP HEIGHT = " + str(JPEG_SPLIT_HEIGHT) + '\n')
 
 
 lenbuf = []
@@ -65,6 +76,11 @@ for i in range(spilts):
     f.close()
     sjpeg_data = sjpeg_data + a
     lenbuf.append(len(a))
+    if len(a) > 0xffff:
+        print("\nA strip is larger than 64 KB, use a smaller strip height!")
+        for j in range(spilts):
+            os.remove(str(j) + ".jpg")
+        sys.exit(1)
 
 header = bytearray()
 
@@ -32,6 +32,11 @@ fout.write(
 
 #include <stdint.h>
 
+/*Operating system types for LV_USE_OS*/
+#define LV_OS_NONE      0
+#define LV_OS_PTHREAD   1
+#define LV_OS_CUSTOM    255
+
 /* Handle special Kconfig options */
 #ifndef LV_KCONFIG_IGNORE
     #include "lv_conf_kconfig.h"
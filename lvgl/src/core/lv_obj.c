@@ -21,6 +21,8 @@
 #include "../misc/lv_gc.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
+#include "../misc/lv_log_async.h"
+#include "../misc/lv_profiler.h"
 #include "../libs/bmp/lv_bmp.h"
 #include "../libs/ffmpeg/lv_ffmpeg.h"
 #include "../libs/freetype/lv_freetype.h"
@@ -28,6 +30,7 @@
 #include "../libs/gif/lv_gif.h"
 #include "../libs/png/lv_png.h"
 #include "../libs/sjpg/lv_sjpg.h"
+#include "../others/snapshot/lv_snapshot.h"
 #include "../layouts/flex/lv_flex.h"
 #include "../layouts/grid/lv_grid.h"
 
@@ -79,6 +82,7 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state);
  **********************/
 static bool lv_initialized = false;
 const lv_obj_class_t lv_obj_class = {
+    .name = "obj",
     .constructor_cb = lv_obj_constructor,
     .destructor_cb = lv_obj_destructor,
     .event_cb = lv_obj_event,
@@ -119,6 +123,16 @@ void lv_init(void)
 #endif
     _lv_timer_core_init();
 
+#if LV_USE_PROFILER
+    lv_profiler_config_t profiler_config;
+    lv_profiler_config_init(&profiler_config);
+    lv_profiler_init(&profiler_config);
+#endif
+
+#if LV_LOG_USE_ASYNC
+    _lv_log_async_init();
+#endif
+
     _lv_fs_init();
 
     _lv_anim_core_init();
@@ -148,7 +162,20 @@ void lv_init(void)
     /*Initialize the screen refresh system*/
     _lv_refr_init();
 
+#if LV_LAYER_CACHE_MAX_SIZE
+    _lv_obj_layer_cache_init();
+#endif
+#if LV_USE_LAYOUT_CACHE
+    _lv_obj_layout_cache_init();
+#endif
+#if LV_USE_SNAPSHOT
+    _lv_snapshot_session_init();
+#endif
+
     _lv_img_decoder_init();
+#if LV_IMG_DECODER_USE_ASYNC
+    _lv_img_decoder_async_init();
+#endif
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
 #endif
@@ -218,6 +245,10 @@ void lv_init(void)
     lv_fs_win32_init();
 #endif
 
+#if LV_USE_FS_MMAP != '\0'
+    lv_fs_mmap_init();
+#endif
+
 #if LV_USE_FFMPEG
     lv_ffmpeg_init();
 #endif
@@ -252,10 +283,30 @@ void lv_init(void)
 
 void lv_deinit(void)
 {
+#if LV_USE_SNAPSHOT
+    _lv_snapshot_session_deinit();
+#endif
+
+#if LV_IMG_DECODER_USE_ASYNC
+    _lv_img_decoder_async_deinit();
+#endif
+
+#if LV_USE_SJPG
+    lv_split_jpeg_deinit();
+#endif
+
+#if LV_LOG_USE_ASYNC
+    _lv_log_async_deinit();
+#endif
+
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
 
+#if LV_USE_PROFILER
+    lv_profiler_deinit();
+#endif
+
 #if LV_USE_BUILTIN_MALLOC
     lv_mem_deinit_builtin();
 #endif
@@ -326,6 +377,10 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+#if LV_LAYER_CACHE_MAX_SIZE
+    if(f & LV_OBJ_FLAG_CACHE_LAYER) _lv_obj_layer_cache_free(obj);
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
@@ -519,6 +574,18 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
 
+#if LV_LAYER_CACHE_MAX_SIZE
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER)) _lv_obj_layer_cache_free(obj);
+#endif
+
+#if LV_USE_SNAPSHOT
+    _lv_snapshot_session_obj_deleted(obj);
+#endif
+
+#if LV_USE_LAYOUT_CACHE
+    _lv_obj_layout_cache_invalidate(obj);
+#endif
+
     if(obj->spec_attr) {
         if(obj->spec_attr->children) {
             lv_free(obj->spec_attr->children);
@@ -801,6 +868,9 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
             lv_obj_t * child = obj->spec_attr->children[i];
             lv_obj_mark_layout_as_dirty(child);
         }
+#if LV_LAYER_CACHE_MAX_SIZE
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER)) _lv_obj_layer_cache_invalidate(obj);
+#endif
     }
     else if(code == LV_EVENT_KEY) {
         if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CHECKABLE)) {
@@ -901,6 +971,11 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
             lv_obj_t * child = obj->spec_attr->children[i];
             lv_obj_mark_layout_as_dirty(child);
         }
+
+#if LV_LAYER_CACHE_MAX_SIZE
+        /*The buffer is reallocated with the new size on the next drawing*/
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER)) _lv_obj_layer_cache_invalidate(obj);
+#endif
     }
     else if(code == LV_EVENT_CHILD_CHANGED) {
         lv_coord_t w = lv_obj_get_style_width(obj, LV_PART_MAIN);
@@ -108,6 +108,7 @@ enum {
     LV_OBJ_FLAG_IGNORE_LAYOUT   = (1L << 17), /**< Make the object position-able by the layouts*/
     LV_OBJ_FLAG_FLOATING        = (1L << 18), /**< Do not scroll the object when the parent scrolls and ignore layout*/
     LV_OBJ_FLAG_OVERFLOW_VISIBLE = (1L << 19), /**< Do not clip the children's content to the parent's boundary*/
+    LV_OBJ_FLAG_CACHE_LAYER     = (1L << 20), /**< Keep the rendered object and its children in a buffer and redraw only the changed parts. See `LV_LAYER_CACHE_MAX_SIZE`*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
@@ -139,6 +140,7 @@ typedef enum {
 #include "lv_obj_scroll.h"
 #include "lv_obj_style.h"
 #include "lv_obj_draw.h"
+#include "lv_obj_layer_cache.h"
 #include "lv_obj_class.h"
 #include "lv_event.h"
 #include "lv_group.h"
@@ -184,6 +186,8 @@ typedef struct _lv_obj_t {
     lv_state_t state;
     uint16_t layout_inv : 1;
     uint16_t scr_layout_inv : 1;
+    uint16_t child_layout_inv : 1;
+    uint16_t has_layout_cache : 1;
     uint16_t skip_trans : 1;
     uint16_t style_cnt  : 6;
     uint16_t h_layout   : 1;
@@ -60,6 +60,7 @@ typedef struct _lv_obj_class_t {
     uint32_t editable : 2;             /**< Value from ::lv_obj_class_editable_t*/
     uint32_t group_def : 2;            /**< Value from ::lv_obj_class_group_def_t*/
     uint32_t instance_size : 16;
+    const char * name;                 /**< Name of the class, e.g. for debugging and profiling*/
 } lv_obj_class_t;
 
 /**********************
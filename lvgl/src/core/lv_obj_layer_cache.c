@@ -0,0 +1,445 @@
+/**
+ * @file lv_obj_layer_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_layer_cache.h"
+#if LV_LAYER_CACHE_MAX_SIZE
+
+#include "lv_obj.h"
+#include "lv_refr.h"
+#include "../draw/sw/lv_draw_sw.h"
+#include "../misc/lv_gc.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of outdated areas stored per layer. More are merged into their bounding box.*/
+#define DIRTY_AREA_MAX  8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const lv_obj_t * obj;
+    uint8_t * buf;                      /*ARGB pixels of `area`. NULL if not allocated yet*/
+    lv_coord_t * opa_span;              /*Fully opaque part of each row as x1, x2 pairs relative to `area`. Stored after the pixels.*/
+    lv_area_t area;                     /*Absolute coordinates of the object with its extra draw size*/
+    lv_area_t dirty[DIRTY_AREA_MAX];    /*Outdated parts of `area` which need to be rendered again*/
+    uint8_t dirty_cnt;
+    uint8_t rendering : 1;              /*Can't be freed as the layer is being rendered*/
+} layer_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static layer_cache_entry_t * find_entry(const lv_obj_t * obj);
+static void free_entry(layer_cache_entry_t * entry);
+static bool alloc_buf(layer_cache_entry_t * entry, uint32_t size);
+static void add_dirty_area(layer_cache_entry_t * entry, const lv_area_t * area);
+static uint32_t get_px_size(const lv_area_t * area);
+static uint32_t get_buf_size(const lv_area_t * area);
+static void render_area(lv_draw_ctx_t * draw_ctx, layer_cache_entry_t * entry, const lv_area_t * area);
+static void update_opa_span(layer_cache_entry_t * entry, lv_coord_t y1, lv_coord_t y2);
+static void blend_px(lv_color_t * dest, const uint8_t * src, lv_coord_t len);
+static void blit(lv_draw_ctx_t * draw_ctx, const layer_cache_entry_t * entry, const lv_area_t * clip_area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t used_size;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_obj_layer_cache_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_layer_cache_ll), sizeof(layer_cache_entry_t));
+    used_size = 0;
+}
+
+lv_res_t _lv_obj_layer_cache_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    /*The layer is rendered directly into a buffer which is possible only with the software renderer*/
+    if(draw_ctx->layer_init != lv_draw_sw_layer_create) return LV_RES_INV;
+
+    /*The children might be drawn out of the cached area*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return LV_RES_INV;
+
+    lv_area_t area;
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &area);
+    lv_area_increase(&area, ext_draw_size, ext_draw_size);
+
+    lv_area_t clip_area;
+    if(!_lv_area_intersect(&clip_area, draw_ctx->clip_area, &area)) return LV_RES_OK;
+
+    /*The masks of the parents (e.g. rounded clip corner) would be saved into the layer too*/
+    if(lv_draw_mask_is_any(&area)) return LV_RES_INV;
+
+    lv_coord_t w = lv_area_get_width(&area);
+    lv_coord_t h = lv_area_get_height(&area);
+    uint32_t size = get_buf_size(&area);
+    layer_cache_entry_t * entry = find_entry(obj);
+
+    if(size > LV_LAYER_CACHE_MAX_SIZE) {
+        if(entry) free_entry(entry);
+        return LV_RES_INV;
+    }
+
+    if(entry == NULL) {
+        entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_layer_cache_ll));
+        LV_ASSERT_MALLOC(entry);
+        if(entry == NULL) return LV_RES_INV;
+        lv_memzero(entry, sizeof(layer_cache_entry_t));
+        entry->obj = obj;
+    }
+    else {
+        /*Used most recently*/
+        _lv_ll_move_before(&LV_GC_ROOT(_lv_layer_cache_ll), entry, _lv_ll_get_head(&LV_GC_ROOT(_lv_layer_cache_ll)));
+    }
+
+    if(entry->buf && (lv_area_get_width(&entry->area) != w || lv_area_get_height(&entry->area) != h)) {
+        lv_free(entry->buf);
+        entry->buf = NULL;
+        used_size -= get_buf_size(&entry->area);
+    }
+
+    if(entry->buf == NULL) {
+        if(!alloc_buf(entry, size)) {
+            free_entry(entry);
+            return LV_RES_INV;
+        }
+        entry->area = area;
+        entry->opa_span = (lv_coord_t *)(entry->buf + get_px_size(&area));
+        entry->dirty[0] = area;
+        entry->dirty_cnt = 1;
+    }
+    else if(entry->area.x1 != area.x1 || entry->area.y1 != area.y1) {
+        /*The object was moved (e.g. its parent was scrolled) but its content is the same*/
+        lv_coord_t dx = area.x1 - entry->area.x1;
+        lv_coord_t dy = area.y1 - entry->area.y1;
+        uint32_t i;
+        for(i = 0; i < entry->dirty_cnt; i++) lv_area_move(&entry->dirty[i], dx, dy);
+        entry->area = area;
+    }
+
+    /*Render the outdated parts. New invalidations during rendering are handled in the next refresh.*/
+    if(entry->dirty_cnt) {
+        lv_area_t dirty[DIRTY_AREA_MAX];
+        uint32_t dirty_cnt = entry->dirty_cnt;
+        lv_memcpy(dirty, entry->dirty, sizeof(lv_area_t) * dirty_cnt);
+        entry->dirty_cnt = 0;
+
+        entry->rendering = 1;
+        uint32_t i;
+        for(i = 0; i < dirty_cnt; i++) render_area(draw_ctx, entry, &dirty[i]);
+        entry->rendering = 0;
+    }
+
+    /*Copy the pixels directly if possible. It's much faster than drawing an image with alpha.*/
+    if(draw_ctx->render_with_alpha == 0) {
+        lv_draw_wait_for_finish(draw_ctx);
+        blit(draw_ctx, entry, &clip_area);
+        return LV_RES_OK;
+    }
+
+    lv_img_dsc_t img;
+    lv_memzero(&img, sizeof(img));
+    img.data = entry->buf;
+    img.data_size = get_px_size(&area);
+    img.header.w = w;
+    img.header.h = h;
+    img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    lv_img_cache_invalidate_src(&img);
+
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    lv_draw_img(draw_ctx, &draw_dsc, &entry->area, &img);
+    lv_draw_wait_for_finish(draw_ctx);
+
+    return LV_RES_OK;
+}
+
+void _lv_obj_layer_cache_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
+{
+    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_layer_cache_ll))) return;
+
+    /*Changing an object changes the cached layers of all its parents*/
+    while(obj) {
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER)) {
+            layer_cache_entry_t * entry = find_entry(obj);
+            lv_area_t dirty;
+            if(entry && entry->buf && _lv_area_intersect(&dirty, area, &entry->area)) {
+                add_dirty_area(entry, &dirty);
+            }
+        }
+        obj = lv_obj_get_parent(obj);
+    }
+}
+
+void _lv_obj_layer_cache_invalidate_screen_area(const lv_area_t * area)
+{
+    layer_cache_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_layer_cache_ll), entry) {
+        lv_area_t dirty;
+        if(entry->buf && _lv_area_intersect(&dirty, area, &entry->area)) {
+            add_dirty_area(entry, &dirty);
+        }
+    }
+}
+
+void _lv_obj_layer_cache_invalidate(const lv_obj_t * obj)
+{
+    layer_cache_entry_t * entry = find_entry(obj);
+    if(entry == NULL) return;
+
+    entry->dirty[0] = entry->area;
+    entry->dirty_cnt = 1;
+}
+
+void _lv_obj_layer_cache_free(const lv_obj_t * obj)
+{
+    layer_cache_entry_t * entry = find_entry(obj);
+    if(entry) free_entry(entry);
+}
+
+uint32_t lv_obj_layer_cache_get_used_size(void)
+{
+    return used_size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static layer_cache_entry_t * find_entry(const lv_obj_t * obj)
+{
+    layer_cache_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_layer_cache_ll), entry) {
+        if(entry->obj == obj) return entry;
+    }
+
+    return NULL;
+}
+
+static void free_entry(layer_cache_entry_t * entry)
+{
+    if(entry->buf) {
+        lv_free(entry->buf);
+        used_size -= get_buf_size(&entry->area);
+    }
+
+    _lv_ll_remove(&LV_GC_ROOT(_lv_layer_cache_ll), entry);
+    lv_free(entry);
+}
+
+/**
+ * Allocate a layer buffer. Free the least recently drawn layers if the memory budget would be exceeded.
+ */
+static bool alloc_buf(layer_cache_entry_t * entry, uint32_t size)
+{
+    layer_cache_entry_t * old = _lv_ll_get_tail(&LV_GC_ROOT(_lv_layer_cache_ll));
+    while(old && used_size + size > LV_LAYER_CACHE_MAX_SIZE) {
+        layer_cache_entry_t * prev = _lv_ll_get_prev(&LV_GC_ROOT(_lv_layer_cache_ll), old);
+        if(old != entry && old->rendering == 0) free_entry(old);
+        old = prev;
+    }
+
+    if(used_size + size > LV_LAYER_CACHE_MAX_SIZE) return false;
+
+    entry->buf = lv_malloc(size);
+    if(entry->buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate %"LV_PRIu32" bytes for the layer", size);
+        return false;
+    }
+
+    used_size += size;
+    return true;
+}
+
+static void add_dirty_area(layer_cache_entry_t * entry, const lv_area_t * area)
+{
+    uint32_t i;
+    for(i = 0; i < entry->dirty_cnt; i++) {
+        if(_lv_area_is_in(area, &entry->dirty[i], 0)) return;
+
+        /*Join the overlapping areas if the joined area is smaller (e.g. the old and new area of a label)*/
+        if(_lv_area_is_on(area, &entry->dirty[i])) {
+            lv_area_t joined;
+            _lv_area_join(&joined, area, &entry->dirty[i]);
+            if(lv_area_get_size(&joined) < lv_area_get_size(area) + lv_area_get_size(&entry->dirty[i])) {
+                entry->dirty[i] = joined;
+                return;
+            }
+        }
+    }
+
+    if(entry->dirty_cnt < DIRTY_AREA_MAX) {
+        entry->dirty[entry->dirty_cnt] = *area;
+        entry->dirty_cnt++;
+        return;
+    }
+
+    /*No more space: keep only the bounding box*/
+    for(i = 1; i < entry->dirty_cnt; i++) _lv_area_join(&entry->dirty[0], &entry->dirty[0], &entry->dirty[i]);
+    _lv_area_join(&entry->dirty[0], &entry->dirty[0], area);
+    entry->dirty_cnt = 1;
+}
+
+/*Size of the pixels rounded up to keep `opa_span` aligned*/
+static uint32_t get_px_size(const lv_area_t * area)
+{
+    return ((uint32_t)lv_area_get_size(area) * LV_IMG_PX_SIZE_ALPHA_BYTE + 3) & ~0x3;
+}
+
+static uint32_t get_buf_size(const lv_area_t * area)
+{
+    return get_px_size(area) + (uint32_t)lv_area_get_height(area) * 2 * sizeof(lv_coord_t);
+}
+
+/**
+ * Render an area of the object and its children into the layer buffer
+ */
+static void render_area(lv_draw_ctx_t * draw_ctx, layer_cache_entry_t * entry, const lv_area_t * area)
+{
+    bool has_alpha = true;
+#if LV_COLOR_DEPTH == 32
+    /*The layer has the same format as the draw buffer. If the object covers the area it can be
+     *rendered without alpha which is much faster.*/
+    if(_lv_area_is_in(area, &entry->obj->coords, 0)) {
+        lv_cover_check_info_t info;
+        info.res = LV_COVER_RES_COVER;
+        info.area = area;
+        lv_event_send((lv_obj_t *)entry->obj, LV_EVENT_COVER_CHECK, &info);
+        if(info.res == LV_COVER_RES_COVER) has_alpha = false;
+    }
+#endif
+
+    /*Clear the area to transparent*/
+    if(has_alpha) {
+        lv_coord_t layer_w = lv_area_get_width(&entry->area);
+        uint32_t row_size = lv_area_get_width(area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        uint8_t * row = entry->buf + ((area->y1 - entry->area.y1) * layer_w + area->x1 - entry->area.x1) *
+                        LV_IMG_PX_SIZE_ALPHA_BYTE;
+        lv_coord_t y;
+        for(y = area->y1; y <= area->y2; y++) {
+            lv_memzero(row, row_size);
+            row += layer_w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+
+    void * buf_ori = draw_ctx->buf;
+    lv_area_t * buf_area_ori = draw_ctx->buf_area;
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    bool render_with_alpha_ori = draw_ctx->render_with_alpha;
+
+    draw_ctx->buf = entry->buf;
+    draw_ctx->buf_area = &entry->area;
+    draw_ctx->clip_area = area;
+    draw_ctx->render_with_alpha = has_alpha;
+
+    lv_obj_redraw(draw_ctx, (lv_obj_t *)entry->obj);
+    lv_draw_wait_for_finish(draw_ctx);
+
+    draw_ctx->buf = buf_ori;
+    draw_ctx->buf_area = buf_area_ori;
+    draw_ctx->clip_area = clip_area_ori;
+    draw_ctx->render_with_alpha = render_with_alpha_ori;
+
+    update_opa_span(entry, area->y1 - entry->area.y1, area->y2 - entry->area.y1);
+}
+
+/**
+ * Find the fully opaque part of the rows to copy them at once in `blit`.
+ * It's usually the whole row except the rounded corners, the anti-aliased edges and the shadow.
+ */
+static void update_opa_span(layer_cache_entry_t * entry, lv_coord_t y1, lv_coord_t y2)
+{
+    lv_coord_t w = lv_area_get_width(&entry->area);
+    lv_coord_t y;
+    for(y = y1; y <= y2; y++) {
+        const uint8_t * a = entry->buf + (uint32_t)y * w * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1;
+        lv_coord_t x1 = 0;
+        while(x1 < w && a[x1 * LV_IMG_PX_SIZE_ALPHA_BYTE] != LV_OPA_COVER) x1++;
+        lv_coord_t x2 = x1;
+        while(x2 < w && a[x2 * LV_IMG_PX_SIZE_ALPHA_BYTE] == LV_OPA_COVER) x2++;
+        entry->opa_span[y * 2] = x1;
+        entry->opa_span[y * 2 + 1] = x2 - 1;  /*x1 > x2 if there are no opaque pixels*/
+    }
+}
+
+/**
+ * Blend the layer to the draw buffer. The opaque part of the rows is simply copied.
+ */
+static void blit(lv_draw_ctx_t * draw_ctx, const layer_cache_entry_t * entry, const lv_area_t * clip_area)
+{
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_coord_t src_stride = lv_area_get_width(&entry->area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_coord_t x1 = clip_area->x1 - entry->area.x1;
+    lv_coord_t x2 = clip_area->x2 - entry->area.x1;
+    lv_color_t * dest = (lv_color_t *)draw_ctx->buf + (clip_area->y1 - draw_ctx->buf_area->y1) * dest_stride +
+                        (clip_area->x1 - draw_ctx->buf_area->x1);
+    const uint8_t * src = entry->buf + (clip_area->y1 - entry->area.y1) * src_stride +
+                          x1 * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    const lv_coord_t * span = &entry->opa_span[(clip_area->y1 - entry->area.y1) * 2];
+
+    lv_coord_t y;
+    for(y = clip_area->y1; y <= clip_area->y2; y++) {
+        lv_coord_t opa_x1 = LV_MAX(span[0], x1);
+        lv_coord_t opa_x2 = LV_MIN(span[1], x2);
+        if(opa_x1 > opa_x2) {
+            blend_px(dest, src, x2 - x1 + 1);
+        }
+        else {
+            blend_px(dest, src, opa_x1 - x1);
+            lv_color_t * opa_dest = dest + (opa_x1 - x1);
+            const uint8_t * opa_src = src + (opa_x1 - x1) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+            lv_coord_t opa_len = opa_x2 - opa_x1 + 1;
+#if LV_COLOR_DEPTH == 32
+            /*The layer has the same format as the draw buffer*/
+            lv_memcpy(opa_dest, opa_src, opa_len * sizeof(lv_color_t));
+#else
+            lv_coord_t i;
+            for(i = 0; i < opa_len; i++) {
+                lv_memcpy(&opa_dest[i], opa_src + i * LV_IMG_PX_SIZE_ALPHA_BYTE, sizeof(lv_color_t));
+            }
+#endif
+            blend_px(opa_dest + opa_len, opa_src + opa_len * LV_IMG_PX_SIZE_ALPHA_BYTE, x2 - opa_x2);
+        }
+
+        dest += dest_stride;
+        src += src_stride;
+        span += 2;
+    }
+}
+
+static void blend_px(lv_color_t * dest, const uint8_t * src, lv_coord_t len)
+{
+    lv_coord_t x;
+    for(x = 0; x < len; x++) {
+        lv_opa_t opa = src[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        if(opa > LV_OPA_MIN) {
+            lv_color_t c;
+#if LV_COLOR_DEPTH == 32
+            c.full = *((const uint32_t *)src) | 0xff000000;
+#else
+            lv_memcpy(&c, src, sizeof(lv_color_t));
+#endif
+            dest[x] = opa >= LV_OPA_MAX ? c : lv_color_mix(c, dest[x], opa);
+        }
+        src += LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+}
+
+#endif /*LV_LAYER_CACHE_MAX_SIZE*/
@@ -0,0 +1,93 @@
+/**
+ * @file lv_obj_layer_cache.h
+ * Keep the rendered pixels of the objects with `LV_OBJ_FLAG_CACHE_LAYER`
+ */
+
+#ifndef LV_OBJ_LAYER_CACHE_H
+#define LV_OBJ_LAYER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_area.h"
+#include "../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+struct _lv_draw_ctx_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_LAYER_CACHE_MAX_SIZE
+
+/**
+ * Initialize the layer cache. Called by `lv_init`.
+ */
+void _lv_obj_layer_cache_init(void);
+
+/**
+ * Draw an object and its children from its cached layer.
+ * The parts of the layer which were invalidated since the last drawing are rendered again.
+ * @param draw_ctx  pointer to the current draw context
+ * @param obj       pointer to an object with `LV_OBJ_FLAG_CACHE_LAYER`
+ * @return          LV_RES_OK: the object is drawn; LV_RES_INV: the object can't be cached now, draw it normally
+ */
+lv_res_t _lv_obj_layer_cache_draw(struct _lv_draw_ctx_t * draw_ctx, struct _lv_obj_t * obj);
+
+/**
+ * Mark an area of the cached layers of `obj` and its parents as outdated.
+ * @param obj       pointer to an object which content has changed
+ * @param area      the changed area in absolute coordinates
+ */
+void _lv_obj_layer_cache_invalidate_area(const struct _lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Mark an area as outdated in all cached layers. Used when something is changed on the screen which is not an object
+ * (e.g. an image finished decoding in the background).
+ * @param area      the changed area in absolute coordinates
+ */
+void _lv_obj_layer_cache_invalidate_screen_area(const lv_area_t * area);
+
+/**
+ * Mark the whole cached layer of an object as outdated
+ * @param obj       pointer to an object with `LV_OBJ_FLAG_CACHE_LAYER`
+ */
+void _lv_obj_layer_cache_invalidate(const struct _lv_obj_t * obj);
+
+/**
+ * Free the cached layer of an object
+ * @param obj       pointer to an object
+ */
+void _lv_obj_layer_cache_free(const struct _lv_obj_t * obj);
+
+/**
+ * Get the memory used by all the cached layers
+ * @return          the size of the layer buffers in bytes
+ */
+uint32_t lv_obj_layer_cache_get_used_size(void);
+
+#endif /*LV_LAYER_CACHE_MAX_SIZE*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_LAYER_CACHE_H*/
@@ -10,6 +10,8 @@
 #include "lv_disp.h"
 #include "lv_refr.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_profiler.h"
+#include "../others/snapshot/lv_snapshot.h"
 
 /*********************
  *      DEFINES
@@ -19,6 +21,12 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_LAYOUT_CACHE
+typedef struct {
+    const lv_obj_t * obj;
+    void * data;
+} layout_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -27,6 +35,9 @@ static lv_coord_t calc_content_width(lv_obj_t * obj);
 static lv_coord_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv);
+#if LV_USE_LAYOUT_CACHE
+static layout_cache_entry_t * find_layout_cache(const lv_obj_t * obj);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -289,8 +300,13 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
 
-    /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
+    /*Mark the parents too so that only the branches with dirty objects will be visited.
+     *Mark the screen as dirty too to mark that there is something to do on this screen*/
+    lv_obj_t * scr = obj;
+    while(scr->parent) {
+        scr = scr->parent;
+        scr->child_layout_inv = 1;
+    }
     scr->scr_layout_inv = 1;
 
     /*Make the display refreshing*/
@@ -307,6 +323,8 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     }
     mutex = true;
 
+    LV_PROFILER_BEGIN;
+
     lv_obj_t * scr = lv_obj_get_screen(obj);
 
     /*Repeat until there where layout invalidations*/
@@ -317,9 +335,53 @@ void lv_obj_update_layout(const lv_obj_t * obj)
         LV_LOG_TRACE("Layout update end");
     }
 
+    LV_PROFILER_END;
+
     mutex = false;
 }
 
+#if LV_USE_LAYOUT_CACHE
+void _lv_obj_layout_cache_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_layout_cache_ll), sizeof(layout_cache_entry_t));
+}
+
+void * _lv_obj_layout_cache_get(const lv_obj_t * obj)
+{
+    layout_cache_entry_t * entry = find_layout_cache(obj);
+    return entry ? entry->data : NULL;
+}
+
+void _lv_obj_layout_cache_set(lv_obj_t * obj, void * data)
+{
+    layout_cache_entry_t * entry = find_layout_cache(obj);
+    if(entry == NULL) {
+        if(data == NULL) return;
+        entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_layout_cache_ll));
+        LV_ASSERT_MALLOC(entry);
+        if(entry == NULL) {
+            lv_free(data);
+            return;
+        }
+        entry->obj = obj;
+        entry->data = NULL;
+    }
+
+    lv_free(entry->data);
+    entry->data = data;
+    if(data == NULL) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_layout_cache_ll), entry);
+        lv_free(entry);
+    }
+    obj->has_layout_cache = data ? 1 : 0;
+}
+
+void _lv_obj_layout_cache_invalidate(lv_obj_t * obj)
+{
+    _lv_obj_layout_cache_set(obj, NULL);
+}
+#endif
+
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
 {
     layout_cnt++;
@@ -826,6 +888,12 @@ void lv_obj_get_transformed_area(const lv_obj_t * obj, lv_area_t * area, bool re
     lv_obj_transform_point(obj, &p[2], recursive, inv);
     lv_obj_transform_point(obj, &p[3], recursive, inv);
 
+    /*Not transformed*/
+    if(p[0].x == area->x1 && p[0].y == area->y1 && p[3].x == area->x2 && p[3].y == area->y2 &&
+       p[1].x == area->x1 && p[2].y == area->y1) {
+        return;
+    }
+
     area->x1 = LV_MIN4(p[0].x, p[1].x, p[2].x, p[3].x);
     area->x2 = LV_MAX4(p[0].x, p[1].x, p[2].x, p[3].x);
     area->y1 = LV_MIN4(p[0].y, p[1].y, p[2].y, p[3].y);
@@ -838,6 +906,16 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_LAYER_CACHE_MAX_SIZE
+    /*Update the cached layers even if the object is not visible now*/
+    _lv_obj_layer_cache_invalidate_area(obj, area);
+#endif
+
+#if LV_USE_SNAPSHOT
+    /*The snapshot sessions watch the objects even if they are not on the screen*/
+    _lv_snapshot_session_invalidate_area(obj, area);
+#endif
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
@@ -1130,11 +1208,14 @@ static lv_coord_t calc_content_height(lv_obj_t * obj)
 
 static void layout_update_core(lv_obj_t * obj)
 {
+    obj->child_layout_inv = 0;
+
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
     for(i = 0; i < child_cnt; i++) {
         lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+        /*Skip the branches where nothing is dirty*/
+        if(child->layout_inv || child->child_layout_inv) layout_update_core(child);
     }
 
     if(obj->layout_inv == 0) return;
@@ -1153,6 +1234,21 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+#if LV_USE_LAYOUT_CACHE
+static layout_cache_entry_t * find_layout_cache(const lv_obj_t * obj)
+{
+    /*Only a few large containers are cached so a list is enough*/
+    if(!obj->has_layout_cache) return NULL;
+
+    layout_cache_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_layout_cache_ll), entry) {
+        if(entry->obj == obj) return entry;
+    }
+
+    return NULL;
+}
+#endif
+
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv)
 {
     int16_t angle = lv_obj_get_style_transform_angle(obj, 0);
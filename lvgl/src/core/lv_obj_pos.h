@@ -152,6 +152,35 @@ void lv_obj_mark_layout_as_dirty(struct _lv_obj_t * obj);
  */
 void lv_obj_update_layout(const struct _lv_obj_t * obj);
 
+#if LV_USE_LAYOUT_CACHE
+/**
+ * Initialize the storage of the layout caches
+ */
+void _lv_obj_layout_cache_init(void);
+
+/**
+ * Get the data the layout of an object cached about its children.
+ * @param obj      pointer to an object
+ * @return         the data set by `_lv_obj_layout_cache_set()` or NULL if the object has no cache
+ */
+void * _lv_obj_layout_cache_get(const struct _lv_obj_t * obj);
+
+/**
+ * Set the data the layout of an object caches about its children. The previous data is freed.
+ * @param obj      pointer to an object
+ * @param data     data allocated with `lv_malloc`. It's freed with `lv_free` when the object is deleted
+ *                 or the cache is invalidated.
+ */
+void _lv_obj_layout_cache_set(struct _lv_obj_t * obj, void * data);
+
+/**
+ * Free the data the layout of an object cached about its children.
+ * The layout will be calculated from scratch on the next update.
+ * @param obj      pointer to an object
+ */
+void _lv_obj_layout_cache_invalidate(struct _lv_obj_t * obj);
+#endif
+
 /**
  * Register a new layout
  * @param cb        the layout update callback
@@ -52,6 +52,9 @@ static void trans_anim_cb(void * _tr, int32_t v);
 static void trans_anim_start_cb(lv_anim_t * a);
 static void trans_anim_ready_cb(lv_anim_t * a);
 static lv_layer_type_t calculate_layer_type(lv_obj_t * obj);
+#if LV_USE_LAYOUT_CACHE
+    static bool is_size_or_pos_prop(lv_style_prop_t prop);
+#endif
 static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_ready(lv_anim_t * a);
 
@@ -187,11 +190,21 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
            lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT) {
             lv_event_send(obj, LV_EVENT_STYLE_CHANGED, NULL);
             lv_obj_mark_layout_as_dirty(obj);
+#if LV_USE_LAYOUT_CACHE
+            _lv_obj_layout_cache_invalidate(obj);
+#endif
         }
     }
     if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || is_layout_refr)) {
         lv_obj_t * parent = lv_obj_get_parent(obj);
-        if(parent) lv_obj_mark_layout_as_dirty(parent);
+        if(parent) {
+            lv_obj_mark_layout_as_dirty(parent);
+#if LV_USE_LAYOUT_CACHE
+            /*The layout sees the new size of the children and ignores their position,
+             *but any other property (e.g. translate or the grid cell) can change its result*/
+            if(!is_size_or_pos_prop(prop)) _lv_obj_layout_cache_invalidate(parent);
+#endif
+        }
     }
 
     /*Cache the layer type*/
@@ -850,6 +863,22 @@ static lv_layer_type_t calculate_layer_type(lv_obj_t * obj)
     return LV_LAYER_TYPE_NONE;
 }
 
+#if LV_USE_LAYOUT_CACHE
+static bool is_size_or_pos_prop(lv_style_prop_t prop)
+{
+    switch(prop) {
+        case LV_STYLE_WIDTH:
+        case LV_STYLE_HEIGHT:
+        case LV_STYLE_X:
+        case LV_STYLE_Y:
+        case LV_STYLE_ALIGN:
+            return true;
+        default:
+            return false;
+    }
+}
+#endif
+
 static void fade_anim_cb(void * obj, int32_t v)
 {
     lv_obj_set_style_opa(obj, v, 0);
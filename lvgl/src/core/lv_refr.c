@@ -15,6 +15,7 @@
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_profiler.h"
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../others/snapshot/lv_snapshot.h"
@@ -286,6 +287,7 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
 void _lv_disp_refr_timer(lv_timer_t * tmr)
 {
     REFR_TRACE("begin");
+    LV_PROFILER_BEGIN;
 
     uint32_t start = lv_tick_get();
     volatile uint32_t elaps = 0;
@@ -316,11 +318,13 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr->inv_p = 0;
         LV_LOG_WARN("there is no active screen");
         REFR_TRACE("finished");
+        LV_PROFILER_END;
         return;
     }
 
     if(disp_refr->driver->direct_mode && disp_refr->driver->draw_ctx->color_format != LV_COLOR_FORMAT_NATIVE) {
         LV_LOG_WARN("In direct_mode only LV_COLOR_FORMAT_NATIVE color format is supported");
+        LV_PROFILER_END;
         return;
     }
 
@@ -446,6 +450,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 #endif
 
     REFR_TRACE("finished");
+    LV_PROFILER_END;
 }
 
 #if LV_USE_PERF_MONITOR
@@ -555,6 +560,7 @@ static void refr_invalid_areas(void)
  */
 static void refr_area(const lv_area_t * area_p)
 {
+    LV_PROFILER_BEGIN;
     lv_draw_ctx_t * draw_ctx = disp_refr->driver->draw_ctx;
     draw_ctx->buf = disp_refr->driver->draw_buf->buf_act;
 
@@ -575,6 +581,7 @@ static void refr_area(const lv_area_t * area_p)
             draw_ctx->clip_area = area_p;
             refr_area_part(draw_ctx);
         }
+        LV_PROFILER_END;
         return;
     }
 
@@ -618,6 +625,7 @@ static void refr_area(const lv_area_t * area_p)
         disp_refr->driver->draw_buf->last_part = 1;
         refr_area_part(draw_ctx);
     }
+    LV_PROFILER_END;
 }
 
 static void refr_area_part(lv_draw_ctx_t * draw_ctx)
@@ -892,7 +900,15 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
+        LV_PROFILER_BEGIN_TAG(obj->class_p->name);
+#if LV_LAYER_CACHE_MAX_SIZE
+        if(!lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER) || _lv_obj_layer_cache_draw(draw_ctx, obj) != LV_RES_OK) {
+            lv_obj_redraw(draw_ctx, obj);
+        }
+#else
         lv_obj_redraw(draw_ctx, obj);
+#endif
+        LV_PROFILER_END_TAG(obj->class_p->name);
     }
     else {
         lv_opa_t opa = lv_obj_get_style_opa(obj, 0);
@@ -914,9 +930,11 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 
         if(layer_type == LV_LAYER_TYPE_SIMPLE) flags |= LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE;
 
+        LV_PROFILER_BEGIN_TAG(obj->class_p->name);
         lv_draw_layer_ctx_t * layer_ctx = lv_draw_layer_create(draw_ctx, &layer_area_full, flags);
         if(layer_ctx == NULL) {
             LV_LOG_WARN("Couldn't create a new layer context");
+            LV_PROFILER_END_TAG(obj->class_p->name);
             return;
         }
         lv_point_t pivot = {
@@ -961,6 +979,7 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         }
 
         lv_draw_layer_destroy(draw_ctx, layer_ctx);
+        LV_PROFILER_END_TAG(obj->class_p->name);
     }
 }
 
@@ -1248,7 +1267,9 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
 
     if(drv->draw_ctx->buffer_convert) drv->draw_ctx->buffer_convert(drv->draw_ctx);
 
+    LV_PROFILER_BEGIN_TAG("flush_cb");
     drv->flush_cb(drv, &offset_area, color_p);
+    LV_PROFILER_END_TAG("flush_cb");
 }
 
 #if LV_USE_PERF_MONITOR
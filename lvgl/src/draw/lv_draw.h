@@ -19,6 +19,7 @@ extern "C" {
 #include "../misc/lv_txt.h"
 #include "lv_img_decoder.h"
 #include "lv_img_cache.h"
+#include "lv_img_decoder_async.h"
 
 #include "lv_draw_rect.h"
 #include "lv_draw_label.h"
@@ -29,6 +30,7 @@ extern "C" {
 #include "lv_draw_mask.h"
 #include "lv_draw_transform.h"
 #include "lv_draw_layer.h"
+#include "sw/lv_draw_sw_filter.h"
 
 /*********************
  *      DEFINES
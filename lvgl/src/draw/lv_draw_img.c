@@ -8,11 +8,13 @@
  *********************/
 #include "lv_draw_img.h"
 #include "lv_img_cache.h"
+#include "lv_img_decoder_async.h"
 #include "../hal/lv_hal_disp.h"
 #include "../misc/lv_log.h"
 #include "../core/lv_refr.h"
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +31,10 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
                                                       const lv_area_t * coords, const void * src);
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg);
+#if LV_IMG_DECODER_USE_ASYNC
+    static const void * get_async_src(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                                      const void * src);
+#endif
 static void draw_cleanup(_lv_img_cache_entry_t * cache);
 
 /**********************
@@ -69,6 +75,14 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
 
     if(dsc->opa <= LV_OPA_MIN) return;
 
+#if LV_IMG_DECODER_USE_ASYNC
+    /*Draw a placeholder while the image is being decoded*/
+    src = get_async_src(draw_ctx, dsc, coords, src);
+    if(src == NULL) return;
+#endif
+
+    LV_PROFILER_BEGIN;
+
     lv_res_t res;
     if(draw_ctx->draw_img) {
         res = draw_ctx->draw_img(draw_ctx, dsc, coords, src);
@@ -77,6 +91,8 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
         res = decode_and_draw(draw_ctx, dsc, coords, src);
     }
 
+    LV_PROFILER_END;
+
     if(res == LV_RES_INV) {
         LV_LOG_WARN("Image draw error");
         show_error(draw_ctx, coords, "No\ndata");
@@ -343,6 +359,38 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
     lv_draw_label(draw_ctx, &label_dsc, coords, msg, NULL);
 }
 
+#if LV_IMG_DECODER_USE_ASYNC
+/**
+ * Get the decoded image of a file or draw a placeholder if it's not decoded yet
+ * @return      the source to draw or NULL if the placeholder was drawn
+ */
+static const void * get_async_src(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                                  const void * src)
+{
+    if(dsc->frame_id != 0 || lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return src;
+
+    /*The area of the placeholder which will be invalidated when the image is ready*/
+    lv_area_t area = *coords;
+    if(dsc->angle || dsc->zoom != LV_IMG_ZOOM_NONE) {
+        _lv_img_buf_get_transformed_area(&area, lv_area_get_width(coords), lv_area_get_height(coords),
+                                         dsc->angle, dsc->zoom, &dsc->pivot);
+        lv_area_move(&area, coords->x1, coords->y1);
+    }
+
+    src = _lv_img_decoder_async_get(src, _lv_refr_get_disp_refreshing(), &area);
+    if(src) return src;
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = LV_IMG_DECODER_ASYNC_PLACEHOLDER_COLOR;
+    rect_dsc.bg_opa = dsc->opa;
+    rect_dsc.blend_mode = dsc->blend_mode;
+    lv_draw_rect(draw_ctx, &rect_dsc, &area);
+
+    return NULL;
+}
+#endif
+
 static void draw_cleanup(_lv_img_cache_entry_t * cache)
 {
     /*Automatically close images with no caching*/
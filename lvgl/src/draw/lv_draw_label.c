@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -35,6 +36,10 @@ typedef uint8_t cmd_state_t;
  **********************/
 
 static uint8_t hex_char_to_num(char hex);
+static uint32_t get_line_end(const lv_txt_layout_t * layout, uint32_t line_id, const char * txt, uint32_t line_start,
+                             const lv_draw_label_dsc_t * dsc, lv_coord_t max_width);
+static lv_coord_t get_line_width(const lv_txt_layout_t * layout, uint32_t line_id, const char * txt,
+                                 uint32_t line_start, uint32_t line_end, const lv_draw_label_dsc_t * dsc);
 
 /**********************
  *  STATIC VARIABLES
@@ -134,8 +139,13 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_id        = 0;
     int32_t last_line_start = -1;
 
+    /*With the cached line breaks the first visible line can be found quickly without the hint*/
+    const lv_txt_layout_t * layout = _lv_txt_get_layout(txt, font, dsc->letter_space, w, dsc->flag);
+    if(layout) hint = NULL;
+
     /*Check the hint to use the cached info*/
     if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
@@ -151,13 +161,14 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+    uint32_t line_end = get_line_end(layout, line_id, txt, line_start, dsc, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_id++;
+        line_end = get_line_end(layout, line_id, txt, line_start, dsc, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -172,14 +183,14 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(layout, line_id, txt, line_start, line_end, dsc);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(layout, line_id, txt, line_start, line_end, dsc);
         pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
@@ -334,21 +345,20 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_id++;
+        line_end = get_line_end(layout, line_id, txt, line_start, dsc, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(layout, line_id, txt, line_start, line_end, dsc);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(layout, line_id, txt, line_start, line_end, dsc);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -364,7 +374,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,  const lv_point_t * pos_p,
                     uint32_t letter)
 {
+    LV_PROFILER_BEGIN;
     draw_ctx->draw_letter(draw_ctx, dsc, pos_p, letter);
+    LV_PROFILER_END;
 }
 
 
@@ -415,3 +427,26 @@ static uint8_t hex_char_to_num(char hex)
     return result;
 }
 
+
+/**
+ * Get the end of a line from the cached layout or by measuring the text
+ */
+static uint32_t get_line_end(const lv_txt_layout_t * layout, uint32_t line_id, const char * txt, uint32_t line_start,
+                             const lv_draw_label_dsc_t * dsc, lv_coord_t max_width)
+{
+    if(layout) return layout->lines[LV_MIN(line_id + 1, layout->line_cnt)].start;
+
+    return line_start + _lv_txt_get_next_line(&txt[line_start], dsc->font, dsc->letter_space, max_width, NULL,
+                                              dsc->flag);
+}
+
+/**
+ * Get the width of a line from the cached layout or by measuring the text
+ */
+static lv_coord_t get_line_width(const lv_txt_layout_t * layout, uint32_t line_id, const char * txt,
+                                 uint32_t line_start, uint32_t line_end, const lv_draw_label_dsc_t * dsc)
+{
+    if(layout) return layout->lines[LV_MIN(line_id, layout->line_cnt)].width;
+
+    return lv_txt_get_width(&txt[line_start], line_end - line_start, dsc->font, dsc->letter_space, dsc->flag);
+}
@@ -12,6 +12,8 @@
 #include "lv_draw_img.h"
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
+#include "lv_img_decoder_async.h"
+#include "../libs/sjpg/lv_sjpg.h"
 
 /*********************
  *      DEFINES
@@ -180,6 +182,13 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
 void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
+#if LV_IMG_DECODER_USE_ASYNC
+    _lv_img_decoder_async_invalidate_src(src);
+#endif
+#if LV_USE_SJPG
+    /*The decoded strips are kept after the image is closed*/
+    lv_split_jpeg_invalidate(src);
+#endif
 #if LV_IMG_CACHE_DEF_SIZE
     _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
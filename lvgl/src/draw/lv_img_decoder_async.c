@@ -0,0 +1,494 @@
+/**
+ * @file lv_img_decoder_async.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_decoder_async.h"
+#if LV_IMG_DECODER_USE_ASYNC
+
+#include "lv_img_decoder.h"
+#include "lv_img_cache.h"
+#include "../core/lv_refr.h"
+#include "../core/lv_obj_layer_cache.h"
+#include "../others/snapshot/lv_snapshot.h"
+#include "../hal/lv_hal_disp.h"
+#include "../misc/lv_timer.h"
+#include "../misc/lv_ll.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_assert.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define JOB_LL              LV_GC_ROOT(_lv_img_decoder_async_ll)
+#define CHECK_PERIOD        10      /*[ms] Check the finished images this often*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    JOB_STATE_QUEUED,       /*Waiting for a worker*/
+    JOB_STATE_DECODING,     /*A worker is decoding it*/
+    JOB_STATE_READY,        /*Decoded into `img`*/
+    JOB_STATE_SYNC,         /*Can't be decoded in advance, it should be drawn as usual*/
+} job_state_t;
+
+typedef struct {
+    char * src;
+    lv_img_dsc_t img;               /*The decoded image*/
+    lv_img_decoder_dsc_t dec_dsc;   /*Kept open if the decoder returned the whole image in `img_data`*/
+    lv_disp_t * disp;               /*Invalidate `inv_area` on this display when the image is decoded*/
+    lv_area_t inv_area;
+    uint32_t size;                  /*Memory used by the job [bytes]*/
+    uint32_t life;                  /*Used to find the least recently used image*/
+    job_state_t state;
+    uint8_t inv : 1;                /*`inv_area` needs to be invalidated*/
+    uint8_t inv_all : 1;            /*Drawn on more displays so invalidate all of them*/
+    uint8_t dec_opened : 1;         /*`img` points into `dec_dsc`. Else `img.data` was allocated here.*/
+    uint8_t stale : 1;              /*Invalidated while it was decoded, decode it again*/
+    uint8_t drawn : 1;              /*Drawn since it's ready*/
+} job_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;          /*Wakes up the worker when a new image is queued or it should stop*/
+} worker_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static job_t * find_job(const char * src);
+static job_t * add_job(const char * src);
+static void free_job(job_t * job);
+static void invalidate_job(job_t * job);
+static void start_workers(void);
+static void worker_thread_cb(void * user_data);
+static bool decode(const char * src, lv_img_decoder_dsc_t * dec_dsc, lv_img_dsc_t * img, bool * opened);
+static void check_timer_cb(lv_timer_t * t);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static worker_t workers[LV_IMG_DECODER_ASYNC_THREADS];
+static lv_mutex_t mutex;            /*Protects the jobs. Don't allocate memory in the workers while it's locked.*/
+static lv_timer_t * check_timer;
+static uint32_t used_size;
+static uint32_t access_cnt;
+static bool workers_started;
+static bool workers_exit;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_img_decoder_async_init(void)
+{
+    _lv_ll_init(&JOB_LL, sizeof(job_t));
+    lv_mutex_init(&mutex);
+    used_size = 0;
+    access_cnt = 0;
+}
+
+void _lv_img_decoder_async_deinit(void)
+{
+    uint32_t i;
+    if(workers_started) {
+        lv_mutex_lock(&mutex);
+        workers_exit = true;
+        lv_mutex_unlock(&mutex);
+
+        for(i = 0; i < LV_IMG_DECODER_ASYNC_THREADS; i++) {
+            lv_thread_sync_signal(&workers[i].sync);
+            lv_thread_delete(&workers[i].thread);
+            lv_thread_sync_delete(&workers[i].sync);
+        }
+        workers_started = false;
+        workers_exit = false;
+    }
+
+    lv_mutex_lock(&mutex);
+    job_t * job = _lv_ll_get_head(&JOB_LL);
+    while(job) {
+        job_t * next = _lv_ll_get_next(&JOB_LL, job);
+        free_job(job);
+        job = next;
+    }
+    lv_mutex_unlock(&mutex);
+    lv_mutex_delete(&mutex);
+
+    if(check_timer) {
+        lv_timer_del(check_timer);
+        check_timer = NULL;
+    }
+}
+
+const void * _lv_img_decoder_async_get(const void * src, lv_disp_t * disp, const lv_area_t * area)
+{
+    /*Draw the image as usual if not a display is rendered (e.g. a snapshot is taken)*/
+    lv_disp_t * d = lv_disp_get_next(NULL);
+    while(d && d != disp) d = lv_disp_get_next(d);
+    if(d == NULL) return src;
+
+    if(!workers_started) start_workers();
+
+    lv_mutex_lock(&mutex);
+    job_t * job = find_job(src);
+    if(job == NULL) job = add_job(src);
+
+    const void * res = src;
+    if(job) {
+        access_cnt++;
+        job->life = access_cnt;
+
+        if(job->state == JOB_STATE_READY) {
+            job->drawn = 1;
+            res = &job->img;
+        }
+        else if(job->state != JOB_STATE_SYNC) {
+            if(!job->inv) {
+                job->inv_area = *area;
+                job->disp = disp;
+                job->inv = 1;
+            }
+            else {
+                _lv_area_join(&job->inv_area, &job->inv_area, area);
+                if(job->disp != disp) job->inv_all = 1;
+            }
+            res = NULL;
+        }
+    }
+    lv_mutex_unlock(&mutex);
+
+    return res;
+}
+
+void _lv_img_decoder_async_invalidate_src(const void * src)
+{
+    /*Only files are decoded here. Don't lock for the variables (e.g. the decoded images when they are freed)*/
+    if(src && lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return;
+
+    lv_mutex_lock(&mutex);
+    job_t * job = _lv_ll_get_head(&JOB_LL);
+    while(job) {
+        job_t * next = _lv_ll_get_next(&JOB_LL, job);
+        if(src == NULL || strcmp(src, job->src) == 0) {
+            if(job->state == JOB_STATE_DECODING) job->stale = 1;
+            else if(job->state != JOB_STATE_QUEUED) free_job(job);
+        }
+        job = next;
+    }
+    lv_mutex_unlock(&mutex);
+}
+
+void lv_img_decoder_async_preload(const char * src)
+{
+    LV_ASSERT_NULL(src);
+
+    if(!workers_started) start_workers();
+
+    lv_mutex_lock(&mutex);
+    if(find_job(src) == NULL) add_job(src);
+    lv_mutex_unlock(&mutex);
+}
+
+uint32_t lv_img_decoder_async_get_pending_cnt(void)
+{
+    uint32_t cnt = 0;
+    lv_mutex_lock(&mutex);
+    job_t * job;
+    _LV_LL_READ(&JOB_LL, job) {
+        if(job->state == JOB_STATE_QUEUED || job->state == JOB_STATE_DECODING) cnt++;
+    }
+    lv_mutex_unlock(&mutex);
+
+    return cnt;
+}
+
+uint32_t lv_img_decoder_async_get_used_size(void)
+{
+    lv_mutex_lock(&mutex);
+    uint32_t size = used_size;
+    lv_mutex_unlock(&mutex);
+
+    return size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static job_t * find_job(const char * src)
+{
+    job_t * job;
+    _LV_LL_READ(&JOB_LL, job) {
+        if(strcmp(src, job->src) == 0) return job;
+    }
+
+    return NULL;
+}
+
+/**
+ * Queue an image for decoding. Called with locked mutex from the UI thread.
+ */
+static job_t * add_job(const char * src)
+{
+    if(!workers_started) return NULL;
+
+    size_t len = strlen(src);
+    job_t * job = _lv_ll_ins_head(&JOB_LL);
+    LV_ASSERT_MALLOC(job);
+    if(job == NULL) return NULL;
+    lv_memzero(job, sizeof(job_t));
+
+    job->src = lv_malloc(len + 1);
+    LV_ASSERT_MALLOC(job->src);
+    if(job->src == NULL) {
+        _lv_ll_remove(&JOB_LL, job);
+        lv_free(job);
+        return NULL;
+    }
+    lv_memcpy(job->src, src, len + 1);
+    job->state = JOB_STATE_QUEUED;
+
+    if(check_timer == NULL) {
+        check_timer = lv_timer_create(check_timer_cb, CHECK_PERIOD, NULL);
+        LV_ASSERT_MALLOC(check_timer);
+    }
+    if(check_timer) lv_timer_resume(check_timer);
+
+    uint32_t i;
+    for(i = 0; i < LV_IMG_DECODER_ASYNC_THREADS; i++) {
+        lv_thread_sync_signal(&workers[i].sync);
+    }
+
+    return job;
+}
+
+/**
+ * Free a ready or not decodable image. Called with locked mutex from the UI thread.
+ */
+static void free_job(job_t * job)
+{
+    if(job->inv) invalidate_job(job);
+
+    if(job->state == JOB_STATE_READY) {
+        /*It might be opened in the image cache as a variable*/
+        lv_img_cache_invalidate_src(&job->img);
+        if(job->dec_opened) lv_img_decoder_close(&job->dec_dsc);
+        else lv_free((void *)job->img.data);
+    }
+
+    used_size -= job->size;
+    lv_free(job->src);
+    _lv_ll_remove(&JOB_LL, job);
+    lv_free(job);
+}
+
+static void invalidate_job(job_t * job)
+{
+    lv_disp_t * disp = lv_disp_get_next(NULL);
+    while(disp) {
+        if(job->inv_all) {
+            lv_area_t disp_area;
+            lv_area_set(&disp_area, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+            _lv_inv_area(disp, &disp_area);
+        }
+        else if(disp == job->disp) {
+            _lv_inv_area(disp, &job->inv_area);
+        }
+        disp = lv_disp_get_next(disp);
+    }
+
+#if LV_LAYER_CACHE_MAX_SIZE
+    /*The placeholder might be saved in a cached layer too*/
+    _lv_obj_layer_cache_invalidate_screen_area(&job->inv_area);
+#endif
+#if LV_USE_SNAPSHOT
+    _lv_snapshot_session_invalidate_screen_area(&job->inv_area);
+#endif
+
+    job->inv = 0;
+    job->inv_all = 0;
+}
+
+static void start_workers(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_IMG_DECODER_ASYNC_THREADS; i++) {
+        lv_thread_sync_init(&workers[i].sync);
+        if(lv_thread_init(&workers[i].thread, LV_THREAD_PRIO_LOW, worker_thread_cb, 0, &workers[i]) != LV_RES_OK) {
+            LV_LOG_WARN("couldn't create a worker thread");
+            lv_thread_sync_delete(&workers[i].sync);
+            break;
+        }
+    }
+
+    if(i == LV_IMG_DECODER_ASYNC_THREADS) {
+        workers_started = true;
+        return;
+    }
+
+    /*Stop the already started workers*/
+    lv_mutex_lock(&mutex);
+    workers_exit = true;
+    lv_mutex_unlock(&mutex);
+    while(i > 0) {
+        i--;
+        lv_thread_sync_signal(&workers[i].sync);
+        lv_thread_delete(&workers[i].thread);
+        lv_thread_sync_delete(&workers[i].sync);
+    }
+    workers_exit = false;
+}
+
+static void worker_thread_cb(void * user_data)
+{
+    worker_t * worker = user_data;
+
+    while(1) {
+        lv_mutex_lock(&mutex);
+        if(workers_exit) {
+            lv_mutex_unlock(&mutex);
+            break;
+        }
+
+        /*The oldest queued image is at the tail*/
+        job_t * job = _lv_ll_get_tail(&JOB_LL);
+        while(job && job->state != JOB_STATE_QUEUED) job = _lv_ll_get_prev(&JOB_LL, job);
+        if(job) {
+            job->state = JOB_STATE_DECODING;
+            job->stale = 0;
+        }
+        lv_mutex_unlock(&mutex);
+
+        if(job == NULL) {
+            lv_thread_sync_wait(&worker->sync);
+            continue;
+        }
+
+        /*Only this worker uses `src` and `dec_dsc` of a job while it's being decoded*/
+        lv_img_dsc_t img;
+        bool opened = false;
+        bool ok = decode(job->src, &job->dec_dsc, &img, &opened);
+
+        lv_mutex_lock(&mutex);
+        bool stale = job->stale;
+        if(!stale) {
+            if(ok) {
+                job->img = img;
+                job->dec_opened = opened;
+                job->size = sizeof(job_t) + img.data_size;
+                job->state = JOB_STATE_READY;
+            }
+            else {
+                job->size = sizeof(job_t);
+                job->state = JOB_STATE_SYNC;
+            }
+            used_size += job->size;
+        }
+        lv_mutex_unlock(&mutex);
+
+        if(stale) {
+            /*The source has changed, drop the result and decode it again*/
+            if(ok) {
+                if(opened) lv_img_decoder_close(&job->dec_dsc);
+                else lv_free((void *)img.data);
+            }
+            lv_mutex_lock(&mutex);
+            job->state = JOB_STATE_QUEUED;
+            lv_mutex_unlock(&mutex);
+        }
+    }
+}
+
+/**
+ * Decode a whole image on a worker thread.
+ * @param src       path to the image file
+ * @param dec_dsc   decoder descriptor. Left opened if `opened` is set to true.
+ * @param img       store the decoded image here
+ * @param opened    true: the data of `img` belongs to `dec_dsc`; false: it was allocated here
+ * @return          true: decoded; false: the image can't be decoded in advance
+ */
+static bool decode(const char * src, lv_img_decoder_dsc_t * dec_dsc, lv_img_dsc_t * img, bool * opened)
+{
+    if(lv_img_decoder_open(dec_dsc, src, lv_color_black(), 0) != LV_RES_OK) return false;
+
+    /*Only the formats which don't depend on the color of the image and can be drawn from a variable*/
+    lv_img_cf_t cf = dec_dsc->header.cf;
+    if(cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA && cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        lv_img_decoder_close(dec_dsc);
+        return false;
+    }
+
+    lv_coord_t w = dec_dsc->header.w;
+    lv_coord_t h = dec_dsc->header.h;
+    uint32_t line_size = (uint32_t)w * (lv_img_cf_get_px_size(cf) >> 3);
+
+    lv_memzero(img, sizeof(lv_img_dsc_t));
+    img->header = dec_dsc->header;
+    img->data_size = line_size * h;
+
+    if(dec_dsc->img_data) {
+        img->data = dec_dsc->img_data;
+        *opened = true;
+        return true;
+    }
+
+    /*Read the lines into a buffer if the decoder can't return the whole image*/
+    uint8_t * buf = lv_malloc(img->data_size);
+    LV_ASSERT_MALLOC(buf);
+    lv_res_t res = buf ? LV_RES_OK : LV_RES_INV;
+    lv_coord_t y;
+    for(y = 0; y < h && res == LV_RES_OK; y++) {
+        res = lv_img_decoder_read_line(dec_dsc, 0, y, w, buf + y * line_size);
+    }
+    lv_img_decoder_close(dec_dsc);
+
+    if(res != LV_RES_OK) {
+        lv_free(buf);
+        return false;
+    }
+
+    img->data = buf;
+    *opened = false;
+    return true;
+}
+
+static void check_timer_cb(lv_timer_t * t)
+{
+    lv_mutex_lock(&mutex);
+
+    /*Redraw the placeholders of the finished images*/
+    uint32_t pending = 0;
+    job_t * job;
+    _LV_LL_READ(&JOB_LL, job) {
+        if(job->state == JOB_STATE_QUEUED || job->state == JOB_STATE_DECODING) pending++;
+        else if(job->inv) invalidate_job(job);
+    }
+
+    /*Free the least recently used images. Keep the ones not drawn yet.*/
+    while(used_size > LV_IMG_DECODER_ASYNC_CACHE_SIZE) {
+        job_t * oldest = NULL;
+        _LV_LL_READ(&JOB_LL, job) {
+            if(job->state == JOB_STATE_SYNC || (job->state == JOB_STATE_READY && job->drawn)) {
+                if(oldest == NULL || job->life < oldest->life) oldest = job;
+            }
+        }
+        if(oldest == NULL) break;
+        free_job(oldest);
+    }
+
+    if(pending == 0) lv_timer_pause(t);
+
+    lv_mutex_unlock(&mutex);
+}
+
+#endif /*LV_IMG_DECODER_USE_ASYNC*/
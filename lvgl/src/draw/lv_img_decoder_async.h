@@ -0,0 +1,93 @@
+/**
+ * @file lv_img_decoder_async.h
+ *
+ */
+
+#ifndef LV_IMG_DECODER_ASYNC_H
+#define LV_IMG_DECODER_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_area.h"
+#include "../osal/lv_os.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_IMG_DECODER_USE_ASYNC (LV_USE_IMG_DECODER_ASYNC && LV_USE_OS != LV_OS_NONE)
+
+#if LV_IMG_DECODER_USE_ASYNC
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_disp_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the asynchronous image decoding. The worker threads are started when the first image is queued.
+ */
+void _lv_img_decoder_async_init(void);
+
+/**
+ * Stop the worker threads and free the decoded images
+ */
+void _lv_img_decoder_async_deinit(void);
+
+/**
+ * Get the source to draw instead of an image file. If the image is not decoded yet it's queued for decoding
+ * and `area` will be invalidated on `disp` when it's ready.
+ * @param src       path to an image file
+ * @param disp      the display which draws the image
+ * @param area      the area of the image on the display
+ * @return          pointer to an `lv_img_dsc_t` with the decoded image,
+ *                  `src` if the image should be drawn as usual (e.g. its color format can't be decoded in advance),
+ *                  or NULL if the image is being decoded and a placeholder should be drawn instead
+ */
+const void * _lv_img_decoder_async_get(const void * src, struct _lv_disp_t * disp, const lv_area_t * area);
+
+/**
+ * Forget the decoded image of a source. It will be decoded again when it's drawn next time.
+ * @param src       path to an image file or NULL to forget all images
+ */
+void _lv_img_decoder_async_invalidate_src(const void * src);
+
+/**
+ * Start decoding an image in the background before it's shown. E.g. the next page of a carousel.
+ * @param src       path to an image file
+ */
+void lv_img_decoder_async_preload(const char * src);
+
+/**
+ * Get the number of images which are queued or being decoded
+ * @return          the number of pending images
+ */
+uint32_t lv_img_decoder_async_get_pending_cnt(void);
+
+/**
+ * Get the memory used by the decoded images
+ * @return          the used memory in bytes
+ */
+uint32_t lv_img_decoder_async_get_used_size(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_IMG_DECODER_USE_ASYNC*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_DECODER_ASYNC_H*/
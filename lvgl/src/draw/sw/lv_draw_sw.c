@@ -151,7 +151,9 @@ void lv_draw_sw_buffer_convert(lv_draw_ctx_t * draw_ctx)
 
         return;
     }
-    else if(draw_ctx->color_format == LV_COLOR_FORMAT_L8) {
+#endif
+
+    if(draw_ctx->color_format == LV_COLOR_FORMAT_L8) {
         size_t buf_size_px = lv_area_get_size(draw_ctx->buf_area);
 
         uint8_t * buf8 = draw_ctx->buf;
@@ -163,7 +165,6 @@ void lv_draw_sw_buffer_convert(lv_draw_ctx_t * draw_ctx)
         }
         return;
     }
-#endif
 
     LV_LOG_WARN("Couldn't convert the image to the desired format");
 }
@@ -12,7 +12,9 @@
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_log.h"
 #include "../../misc/lv_mem.h"
+#include "../../misc/lv_assert.h"
 #include "../lv_draw.h"
+#include "lv_draw_sw_ring_cache.h"
 
 /*********************
  *      DEFINES
@@ -23,6 +25,10 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if !(LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE)
+typedef void _lv_draw_sw_ring_t;
+#endif
+
 typedef struct {
     const lv_point_t * center;
     lv_coord_t radius;
@@ -34,6 +40,7 @@ typedef struct {
     lv_draw_rect_dsc_t * draw_dsc;
     const lv_area_t * draw_area;
     lv_draw_ctx_t * draw_ctx;
+    const _lv_draw_sw_ring_t * ring;
 } quarter_draw_dsc_t;
 
 /**********************
@@ -44,9 +51,15 @@ typedef struct {
     static void draw_quarter_1(quarter_draw_dsc_t * q);
     static void draw_quarter_2(quarter_draw_dsc_t * q);
     static void draw_quarter_3(quarter_draw_dsc_t * q);
+    static void draw_quarter_area(quarter_draw_dsc_t * q);
     static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
 #endif /*LV_USE_DRAW_MASKS*/
 
+#if LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE
+    static void draw_ring(lv_draw_ctx_t * draw_ctx, const _lv_draw_sw_ring_t * ring, const lv_point_t * center,
+                          const lv_draw_rect_dsc_t * dsc);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -96,24 +109,42 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
     area_in.x2 -= dsc->width;
     area_in.y2 -= dsc->width;
 
+    /*If only the angle needs to be masked use the cached coverage of the ring instead of the radius masks*/
+    const _lv_draw_sw_ring_t * ring = NULL;
+#if LV_DRAW_SW_RING_CACHE_SIZE
+    if(dsc->img_src == NULL && !lv_draw_mask_is_any(&area_out)) ring = _lv_draw_sw_ring_cache_get(radius, width, true);
+#endif
+
+    bool full_ring = start_angle + 360 == end_angle || start_angle == end_angle + 360;
+
     /*Create inner the mask*/
     int16_t mask_in_id = LV_MASK_ID_INV;
     lv_draw_mask_radius_param_t mask_in_param;
     bool mask_in_param_valid = false;
-    if(lv_area_get_width(&area_in) > 0 && lv_area_get_height(&area_in) > 0) {
+    if(ring == NULL && lv_area_get_width(&area_in) > 0 && lv_area_get_height(&area_in) > 0) {
         lv_draw_mask_radius_init(&mask_in_param, &area_in, LV_RADIUS_CIRCLE, true);
         mask_in_param_valid = true;
         mask_in_id = lv_draw_mask_add(&mask_in_param, NULL);
     }
 
+    /*The cached ring already contains the outer edge, however a full ring is drawn as a circle
+     *and its radius masks the outer edge once again.*/
+    int16_t mask_out_id = LV_MASK_ID_INV;
     lv_draw_mask_radius_param_t mask_out_param;
-    lv_draw_mask_radius_init(&mask_out_param, &area_out, LV_RADIUS_CIRCLE, false);
-    int16_t mask_out_id = lv_draw_mask_add(&mask_out_param, NULL);
+    if(ring == NULL || full_ring) {
+        lv_draw_mask_radius_init(&mask_out_param, &area_out, LV_RADIUS_CIRCLE, false);
+        mask_out_id = lv_draw_mask_add(&mask_out_param, NULL);
+    }
 
     /*Draw a full ring*/
-    if(start_angle + 360 == end_angle || start_angle == end_angle + 360) {
+    if(full_ring) {
         cir_dsc.radius = LV_RADIUS_CIRCLE;
+#if LV_DRAW_SW_RING_CACHE_SIZE
+        if(ring) draw_ring(draw_ctx, ring, center, &cir_dsc);
+        else lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
+#else
         lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
+#endif
 
         lv_draw_mask_remove_id(mask_out_id);
         if(mask_in_id != LV_MASK_ID_INV) lv_draw_mask_remove_id(mask_in_id);
@@ -143,37 +174,40 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
 
     const lv_area_t * clip_area_ori = draw_ctx->clip_area;
 
+    quarter_draw_dsc_t q_dsc;
+    q_dsc.center = center;
+    q_dsc.radius = radius;
+    q_dsc.start_angle = start_angle;
+    q_dsc.end_angle = end_angle;
+    q_dsc.start_quarter = (start_angle / 90) & 0x3;
+    q_dsc.end_quarter = (end_angle / 90) & 0x3;
+    q_dsc.width = width;
+    q_dsc.draw_dsc = &cir_dsc;
+    q_dsc.draw_area = &area_out;
+    q_dsc.draw_ctx = draw_ctx;
+    q_dsc.ring = ring;
+
     if(angle_gap > SPLIT_ANGLE_GAP_LIMIT && radius > SPLIT_RADIUS_LIMIT) {
         /*Handle each quarter individually and skip which is empty*/
-        quarter_draw_dsc_t q_dsc;
-        q_dsc.center = center;
-        q_dsc.radius = radius;
-        q_dsc.start_angle = start_angle;
-        q_dsc.end_angle = end_angle;
-        q_dsc.start_quarter = (start_angle / 90) & 0x3;
-        q_dsc.end_quarter = (end_angle / 90) & 0x3;
-        q_dsc.width = width;
-        q_dsc.draw_dsc = &cir_dsc;
-        q_dsc.draw_area = &area_out;
-        q_dsc.draw_ctx = draw_ctx;
-
         draw_quarter_0(&q_dsc);
         draw_quarter_1(&q_dsc);
         draw_quarter_2(&q_dsc);
         draw_quarter_3(&q_dsc);
     }
     else {
-        lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
+        draw_quarter_area(&q_dsc);
     }
 
     lv_draw_mask_free_param(&mask_angle_param);
-    lv_draw_mask_free_param(&mask_out_param);
+    if(mask_out_id != LV_MASK_ID_INV) {
+        lv_draw_mask_free_param(&mask_out_param);
+    }
     if(mask_in_param_valid) {
         lv_draw_mask_free_param(&mask_in_param);
     }
 
     lv_draw_mask_remove_id(mask_angle_id);
-    lv_draw_mask_remove_id(mask_out_id);
+    if(mask_out_id != LV_MASK_ID_INV) lv_draw_mask_remove_id(mask_out_id);
     if(mask_in_id != LV_MASK_ID_INV) lv_draw_mask_remove_id(mask_in_id);
 
     if(dsc->rounded) {
@@ -245,7 +279,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_quarter_area(q);
         }
     }
     else if(q->start_quarter == 0 || q->end_quarter == 0) {
@@ -260,7 +294,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_quarter_area(q);
             }
         }
         if(q->end_quarter == 0) {
@@ -273,7 +307,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_quarter_area(q);
             }
         }
     }
@@ -290,7 +324,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_quarter_area(q);
         }
     }
     q->draw_ctx->clip_area = clip_area_ori;
@@ -312,7 +346,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_quarter_area(q);
         }
     }
     else if(q->start_quarter == 1 || q->end_quarter == 1) {
@@ -327,7 +361,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_quarter_area(q);
             }
         }
         if(q->end_quarter == 1) {
@@ -340,7 +374,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_quarter_area(q);
             }
         }
     }
@@ -357,7 +391,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_quarter_area(q);
         }
     }
     q->draw_ctx->clip_area = clip_area_ori;
@@ -379,7 +413,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_quarter_area(q);
         }
     }
     else if(q->start_quarter == 2 || q->end_quarter == 2) {
@@ -394,7 +428,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_quarter_area(q);
             }
         }
         if(q->end_quarter == 2) {
@@ -407,7 +441,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_quarter_area(q);
             }
         }
     }
@@ -424,7 +458,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_quarter_area(q);
         }
     }
     q->draw_ctx->clip_area = clip_area_ori;
@@ -446,7 +480,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_quarter_area(q);
         }
     }
     else if(q->start_quarter == 3 || q->end_quarter == 3) {
@@ -461,7 +495,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_quarter_area(q);
             }
         }
         if(q->end_quarter == 3) {
@@ -474,7 +508,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_quarter_area(q);
             }
         }
     }
@@ -491,13 +525,27 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_quarter_area(q);
         }
     }
 
     q->draw_ctx->clip_area = clip_area_ori;
 }
 
+/**
+ * Draw the arc on the current clip area either from the ring cache or with the masks
+ */
+static void draw_quarter_area(quarter_draw_dsc_t * q)
+{
+#if LV_DRAW_SW_RING_CACHE_SIZE
+    if(q->ring) {
+        draw_ring(q->draw_ctx, q->ring, q->center, q->draw_dsc);
+        return;
+    }
+#endif
+    lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+}
+
 static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area)
 {
     const uint8_t ps = 8;
@@ -536,5 +584,82 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness
     }
 }
 
+#if LV_DRAW_SW_RING_CACHE_SIZE
+/**
+ * Draw the cached ring on the clip area. The other masks (e.g. the angle mask) are applied on the ring.
+ */
+static void draw_ring(lv_draw_ctx_t * draw_ctx, const _lv_draw_sw_ring_t * ring, const lv_point_t * center,
+                      const lv_draw_rect_dsc_t * dsc)
+{
+    lv_coord_t radius = ring->radius;
+    lv_area_t area_out;
+    area_out.x1 = center->x - radius;
+    area_out.y1 = center->y - radius;
+    area_out.x2 = center->x + radius - 1;
+    area_out.y2 = center->y + radius - 1;
+
+    lv_area_t clipped_coords;
+    if(!_lv_area_intersect(&clipped_coords, &area_out, draw_ctx->clip_area)) return;
+
+    lv_opa_t * mask_buf = lv_malloc(radius);
+    LV_ASSERT_MALLOC(mask_buf);
+    if(mask_buf == NULL) return;
+
+    lv_area_t blend_area;
+    lv_draw_sw_blend_dsc_t blend_dsc = {0};
+    blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.color = dsc->bg_color;
+    blend_dsc.opa = dsc->bg_opa >= LV_OPA_MAX ? LV_OPA_COVER : dsc->bg_opa;
+    blend_dsc.mask_buf = mask_buf;
+    blend_dsc.blend_area = &blend_area;
+    blend_dsc.mask_area = &blend_area;
+
+    lv_coord_t y;
+    for(y = clipped_coords.y1; y <= clipped_coords.y2; y++) {
+        /*The bottom half is the mirror of the top half*/
+        const _lv_draw_sw_ring_row_t * row = _lv_draw_sw_ring_get_row(ring, y < center->y ? y - area_out.y1 :
+                                                                      area_out.y2 - y);
+        if(row->len == 0) continue;
+        const lv_opa_t * cov = _lv_draw_sw_ring_get_cov(ring, row);
+
+        blend_area.y1 = y;
+        blend_area.y2 = y;
+
+        /*Draw the left part and the mirrored right part of the row*/
+        uint32_t side;
+        for(side = 0; side < 2; side++) {
+            lv_coord_t x_ofs;
+            if(side == 0) {
+                blend_area.x1 = area_out.x1 + row->x;
+                blend_area.x2 = blend_area.x1 + row->len - 1;
+                x_ofs = LV_MAX(clipped_coords.x1 - blend_area.x1, 0);
+            }
+            else {
+                blend_area.x2 = area_out.x2 - row->x;
+                blend_area.x1 = blend_area.x2 - row->len + 1;
+                x_ofs = LV_MAX(blend_area.x2 - clipped_coords.x2, 0);
+            }
+            if(!_lv_area_intersect(&blend_area, &blend_area, &clipped_coords)) continue;
+
+            lv_coord_t w = lv_area_get_width(&blend_area);
+            lv_coord_t i;
+            if(side == 0) {
+                lv_memcpy(mask_buf, &cov[x_ofs], w);
+            }
+            else {
+                for(i = 0; i < w; i++) mask_buf[i] = cov[x_ofs + w - 1 - i];
+            }
+
+            blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, y, w);
+            if(blend_dsc.mask_res == LV_DRAW_MASK_RES_TRANSP) continue;
+            blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+        }
+    }
+
+    lv_free(mask_buf);
+}
+#endif /*LV_DRAW_SW_RING_CACHE_SIZE*/
+
 #endif /*LV_USE_DRAW_MASKS*/
 #endif /*LV_USE_DRAW_SW*/
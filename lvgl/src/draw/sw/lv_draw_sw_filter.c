@@ -0,0 +1,529 @@
+/**
+ * @file lv_draw_sw_filter.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_filter.h"
+#if LV_USE_DRAW_SW
+
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_gc.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_log.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define FILTER_BUF          LV_GC_ROOT(_lv_draw_sw_filter_buf)
+#define FILTER_ALIGN(X)     (((X) + 15) & ~15)
+
+/*Width of the column blocks of the vertical blur. The sums and the saved rows of a block fit into the L1 cache.*/
+#define VER_BLOCK_W         64
+
+/*Unpacked pixels are `blue, green, red, alpha` bytes, the same as `lv_color32_t`*/
+#define CH_CNT_COLOR        4
+#define CH_CNT_ALPHA        1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*An image to filter*/
+typedef struct {
+    uint8_t * data;
+    uint32_t stride;        /*Size of a row in bytes*/
+    lv_coord_t w;
+    lv_coord_t h;
+    uint8_t px_size;        /*Size of a pixel in the image in bytes*/
+    uint8_t ch_cnt;         /*Number of channels of the unpacked pixels*/
+    uint8_t has_alpha : 1;
+    uint8_t native : 1;     /*1: the pixels are stored unpacked in the image*/
+} filter_img_t;
+
+typedef void (*filter_px_cb_t)(uint8_t * px, uint32_t px_cnt, const void * user_data);
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_res_t filter_img_init(filter_img_t * fimg, lv_img_dsc_t * img, bool color_only);
+static const uint8_t * read_px(const filter_img_t * fimg, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
+static void write_px(const filter_img_t * fimg, lv_coord_t x, lv_coord_t y, lv_coord_t len, const uint8_t * px);
+static uint8_t * get_buf(uint32_t size);
+static lv_res_t box_blur_hor(const filter_img_t * fimg, const lv_area_t * area, uint16_t r);
+static lv_res_t box_blur_ver(const filter_img_t * fimg, const lv_area_t * area, uint16_t r);
+static void hor_line(const uint8_t * src, lv_coord_t src_len, lv_coord_t ofs, uint8_t * dst, lv_coord_t dst_len,
+                     uint8_t ch_cnt, uint16_t r);
+static void ver_add(uint16_t * sum, const uint8_t * add, uint32_t len);
+static void ver_update(uint16_t * sum, const uint8_t * add, const uint8_t * sub, uint32_t len);
+static void ver_div(const uint16_t * sum, uint8_t * dst, uint32_t len, uint32_t m);
+static lv_res_t filter_px(lv_img_dsc_t * img, const lv_area_t * area, filter_px_cb_t cb, const void * user_data);
+static void matrix_cb(uint8_t * px, uint32_t px_cnt, const void * user_data);
+static void lut_cb(uint8_t * px, uint32_t px_cnt, const void * user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t filter_buf_size;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*The reciprocal of the box size to replace the divisions. `(sum * m) >> 16` is `sum / r` rounded down
+ *or in a few cases up by one.*/
+#define BOX_RECIPROCAL(r)   ((65536 + (r) - 1) / (r))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_res_t lv_draw_sw_filter_box_blur(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r_hor, uint16_t r_ver)
+{
+    filter_img_t fimg;
+    if(filter_img_init(&fimg, img, false) != LV_RES_OK) return LV_RES_INV;
+
+    lv_area_t a;
+    lv_area_set(&a, 0, 0, fimg.w - 1, fimg.h - 1);
+    if(area && !_lv_area_intersect(&a, &a, area)) return LV_RES_OK;
+
+    if(r_hor > LV_DRAW_SW_FILTER_BOX_MAX) r_hor = LV_DRAW_SW_FILTER_BOX_MAX;
+    if(r_ver > LV_DRAW_SW_FILTER_BOX_MAX) r_ver = LV_DRAW_SW_FILTER_BOX_MAX;
+
+    /*A box of 1 pixel leaves the image as it is*/
+    if(r_hor > 1 && box_blur_hor(&fimg, &a, r_hor) != LV_RES_OK) return LV_RES_INV;
+    if(r_ver > 1 && box_blur_ver(&fimg, &a, r_ver) != LV_RES_OK) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_draw_sw_filter_gauss_blur(lv_img_dsc_t * img, const lv_area_t * area, uint16_t radius)
+{
+    if(radius > LV_DRAW_SW_FILTER_GAUSS_MAX) radius = LV_DRAW_SW_FILTER_GAUSS_MAX;
+    if(radius == 0) return LV_RES_OK;
+
+    /*Repeating a box blur 3 times results in a close to Gaussian blur.
+     *Find the two odd box sizes (`w` and `w + 2`) and how many times to use the smaller one
+     *to get the same variance (`12 * radius^2`) as the Gaussian blur.*/
+    int32_t var = 12 * (int32_t)radius * radius;
+    lv_sqrt_res_t res;
+    lv_sqrt(var / 3 + 1, &res, 0x8000);
+    int32_t w = res.i;
+    if((w & 0x1) == 0) w--;
+
+    int32_t den = 4 * w + 4;
+    int32_t num = 3 * w * w + 12 * w + 9 - var;
+    int32_t small_cnt = num <= 0 ? 0 : (2 * num + den) / (2 * den);
+    if(small_cnt > 3) small_cnt = 3;
+
+    int32_t i;
+    for(i = 0; i < 3; i++) {
+        uint16_t r = (uint16_t)(i < small_cnt ? w : w + 2);
+        if(lv_draw_sw_filter_box_blur(img, area, r, r) != LV_RES_OK) return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_draw_sw_filter_color_matrix(lv_img_dsc_t * img, const lv_area_t * area,
+                                        const lv_draw_sw_filter_matrix_t * matrix)
+{
+    return filter_px(img, area, matrix_cb, matrix);
+}
+
+lv_res_t lv_draw_sw_filter_brightness(lv_img_dsc_t * img, const lv_area_t * area, uint16_t scale)
+{
+    if(scale == 256) return LV_RES_OK;
+
+    uint8_t lut[256];
+    uint32_t i;
+    for(i = 0; i < 256; i++) {
+        uint32_t v = (i * scale + 128) >> 8;
+        lut[i] = (uint8_t)LV_MIN(v, 255);
+    }
+
+    return filter_px(img, area, lut_cb, lut);
+}
+
+void lv_draw_sw_filter_matrix_init_saturation(lv_draw_sw_filter_matrix_t * matrix, uint16_t sat)
+{
+    /*Weights of the channels in the luminance (BT.709)*/
+    static const int32_t lum[3] = {54, 183, 19};
+
+    if(sat > 1024) sat = 1024;
+
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < 3; i++) {
+        for(j = 0; j < 3; j++) {
+            int32_t v = (256 - (int32_t)sat) * lum[j];
+            if(i == j) v += (int32_t)sat * 256;
+            matrix->m[i][j] = (int16_t)(v / 256);
+        }
+        matrix->m[i][3] = 0;
+    }
+}
+
+void lv_draw_sw_filter_free_buf(void)
+{
+    lv_free(FILTER_BUF);
+    FILTER_BUF = NULL;
+    filter_buf_size = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_res_t filter_img_init(filter_img_t * fimg, lv_img_dsc_t * img, bool color_only)
+{
+    fimg->has_alpha = 0;
+    fimg->ch_cnt = CH_CNT_COLOR;
+    switch(img->header.cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+            fimg->px_size = LV_COLOR_SIZE / 8;
+            break;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            fimg->px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+            fimg->has_alpha = 1;
+            break;
+        case LV_IMG_CF_ALPHA_8BIT:
+            if(color_only) return LV_RES_INV;
+            fimg->px_size = 1;
+            fimg->ch_cnt = CH_CNT_ALPHA;
+            fimg->has_alpha = 1;
+            break;
+        default:
+            LV_LOG_WARN("not supported color format: %d", img->header.cf);
+            return LV_RES_INV;
+    }
+
+    fimg->data = (uint8_t *)img->data;
+    fimg->w = img->header.w;
+    fimg->h = img->header.h;
+    fimg->stride = (uint32_t)fimg->w * fimg->px_size;
+    fimg->native = fimg->px_size == fimg->ch_cnt;
+    return LV_RES_OK;
+}
+
+/**
+ * Get `len` unpacked pixels from (x;y). Unpack them into `buf` if the image has other format.
+ */
+static const uint8_t * read_px(const filter_img_t * fimg, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    const uint8_t * p = fimg->data + (uint32_t)y * fimg->stride + (uint32_t)x * fimg->px_size;
+    if(fimg->native) return p;
+
+    uint8_t * px = buf;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        lv_color_t c;
+        lv_memcpy(&c, p, sizeof(c));
+        lv_color32_t c32;
+        c32.full = lv_color_to32(c);
+        px[0] = c32.ch.blue;
+        px[1] = c32.ch.green;
+        px[2] = c32.ch.red;
+        px[3] = fimg->has_alpha ? p[fimg->px_size - 1] : LV_OPA_COVER;
+        p += fimg->px_size;
+        px += CH_CNT_COLOR;
+    }
+
+    return buf;
+}
+
+/**
+ * Store `len` unpacked pixels at (x;y)
+ */
+static void write_px(const filter_img_t * fimg, lv_coord_t x, lv_coord_t y, lv_coord_t len, const uint8_t * px)
+{
+    uint8_t * p = fimg->data + (uint32_t)y * fimg->stride + (uint32_t)x * fimg->px_size;
+    if(fimg->native) {
+        if(p != px) lv_memcpy(p, px, (uint32_t)len * fimg->ch_cnt);
+        return;
+    }
+
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        lv_color_t c = lv_color_make(px[2], px[1], px[0]);
+        lv_memcpy(p, &c, sizeof(c));
+        if(fimg->has_alpha) p[fimg->px_size - 1] = px[3];
+        p += fimg->px_size;
+        px += CH_CNT_COLOR;
+    }
+}
+
+/**
+ * Get the working buffer. It's only reallocated if a larger one is required.
+ */
+static uint8_t * get_buf(uint32_t size)
+{
+    /*The GC roots are cleared by `lv_deinit()`*/
+    if(FILTER_BUF == NULL) filter_buf_size = 0;
+
+    if(size > filter_buf_size) {
+        lv_free(FILTER_BUF);
+        FILTER_BUF = lv_malloc(size);
+        LV_ASSERT_MALLOC(FILTER_BUF);
+        filter_buf_size = FILTER_BUF ? size : 0;
+    }
+
+    return FILTER_BUF;
+}
+
+static lv_res_t box_blur_hor(const filter_img_t * fimg, const lv_area_t * area, uint16_t r)
+{
+    lv_coord_t r_back = r / 2;
+    lv_coord_t r_front = r / 2;
+    if((r & 0x1) == 0) r_back--;
+
+    /*Only the pixels which are in a box of the area are required*/
+    lv_coord_t src_x1 = LV_MAX(area->x1 - r_back, 0);
+    lv_coord_t src_x2 = LV_MIN(area->x2 + r_front, fimg->w - 1);
+    lv_coord_t src_len = src_x2 - src_x1 + 1;
+    lv_coord_t dst_len = lv_area_get_width(area);
+
+    uint32_t src_size = FILTER_ALIGN((uint32_t)src_len * fimg->ch_cnt);
+    uint8_t * buf = get_buf(src_size + (uint32_t)dst_len * fimg->ch_cnt);
+    if(buf == NULL) return LV_RES_INV;
+    uint8_t * src_buf = buf;
+    uint8_t * dst_buf = buf + src_size;
+
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        const uint8_t * src = read_px(fimg, src_x1, y, src_len, src_buf);
+        hor_line(src, src_len, area->x1 - src_x1, dst_buf, dst_len, fimg->ch_cnt, r);
+        write_px(fimg, area->x1, y, dst_len, dst_buf);
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Blur columns of blocks from top to bottom. The original value of the last rows are saved in a ring buffer
+ * because they are overwritten when they are subtracted from the sums. This way the rows are read and
+ * written continuously and the same operation is applied to all the channels of the block's row.
+ */
+static lv_res_t box_blur_ver(const filter_img_t * fimg, const lv_area_t * area, uint16_t r)
+{
+    lv_coord_t r_back = r / 2;
+    lv_coord_t r_front = r / 2;
+    if((r & 0x1) == 0) r_back--;
+
+    uint32_t m = BOX_RECIPROCAL(r);
+    uint32_t row_size = FILTER_ALIGN(VER_BLOCK_W * fimg->ch_cnt);
+    uint32_t ring_cnt = (uint32_t)r_back + 1;
+    uint8_t * buf = get_buf(row_size * 2 + row_size * (3 + ring_cnt));
+    if(buf == NULL) return LV_RES_INV;
+    uint16_t * sum = (uint16_t *)buf;
+    uint8_t * dst_buf = buf + row_size * 2;
+    uint8_t * add_buf = dst_buf + row_size;
+    uint8_t * sub_buf = add_buf + row_size;
+    uint8_t * ring = sub_buf + row_size;
+
+    lv_coord_t x;
+    for(x = area->x1; x <= area->x2; x += VER_BLOCK_W) {
+        lv_coord_t block_w = LV_MIN(VER_BLOCK_W, area->x2 - x + 1);
+        uint32_t len = (uint32_t)block_w * fimg->ch_cnt;
+
+        lv_memzero(sum, len * sizeof(uint16_t));
+        lv_coord_t y;
+        for(y = area->y1 - r_back; y <= area->y1 + r_front; y++) {
+            lv_coord_t y_safe = LV_CLAMP(0, y, fimg->h - 1);
+            ver_add(sum, read_px(fimg, x, y_safe, block_w, add_buf), len);
+        }
+
+        for(y = area->y1; y <= area->y2; y++) {
+            uint8_t * saved = ring + ((uint32_t)(y - area->y1) % ring_cnt) * row_size;
+            const uint8_t * ori = read_px(fimg, x, y, block_w, add_buf);
+            lv_memcpy(saved, ori, len);
+
+            /*The unpacked pixels can be written directly to the image*/
+            uint8_t * dst = fimg->native ? (uint8_t *)ori : dst_buf;
+            ver_div(sum, dst, len, m);
+            write_px(fimg, x, y, block_w, dst);
+
+            if(y == area->y2) break;
+
+            lv_coord_t y_sub = LV_MAX(y - r_back, 0);
+            lv_coord_t y_add = LV_MIN(y + 1 + r_front, fimg->h - 1);
+            const uint8_t * sub;
+            if(y_sub >= area->y1) sub = ring + ((uint32_t)(y_sub - area->y1) % ring_cnt) * row_size;
+            else sub = read_px(fimg, x, y_sub, block_w, sub_buf);
+            ver_update(sum, read_px(fimg, x, y_add, block_w, add_buf), sub, len);
+        }
+    }
+
+    return LV_RES_OK;
+}
+
+/*Spread the 4 bytes of a pixel to 4 16 bit lanes to add them at once*/
+static inline uint64_t px_spread(const uint8_t * px)
+{
+    uint64_t v = (uint32_t)px[0] | ((uint32_t)px[1] << 8) | ((uint32_t)px[2] << 16) | ((uint32_t)px[3] << 24);
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+    return v;
+}
+
+/**
+ * Blur a line with a sliding box. `dst[i]` is the average of the box around `src[i + ofs]`.
+ * The pixels out of `src` are the same as its first and last pixels.
+ */
+static void hor_line(const uint8_t * src, lv_coord_t src_len, lv_coord_t ofs, uint8_t * dst, lv_coord_t dst_len,
+                     uint8_t ch_cnt, uint16_t r)
+{
+    lv_coord_t r_back = r / 2;
+    lv_coord_t r_front = r / 2;
+    if((r & 0x1) == 0) r_back--;
+
+    uint32_t m = BOX_RECIPROCAL(r);
+    lv_coord_t last = src_len - 1;
+    lv_coord_t i;
+
+    if(ch_cnt == CH_CNT_ALPHA) {
+        uint32_t sum = 0;
+        for(i = ofs - r_back; i <= ofs + r_front; i++) sum += src[LV_CLAMP(0, i, last)];
+
+        for(i = 0; i < dst_len; i++) {
+            dst[i] = (uint8_t)((sum * m) >> 16);
+            lv_coord_t sub = LV_MAX(i + ofs - r_back, 0);
+            lv_coord_t add = LV_MIN(i + ofs + 1 + r_front, last);
+            sum = sum - src[sub] + src[add];
+        }
+        return;
+    }
+
+    /*All the 4 channels are summed in one 64 bit integer. A lane is at most `255 * r` which fits into 16 bits.
+     *Subtract first to never overflow into the next lane.*/
+    uint64_t sum = 0;
+    for(i = ofs - r_back; i <= ofs + r_front; i++) sum += px_spread(&src[LV_CLAMP(0, i, last) * CH_CNT_COLOR]);
+
+    for(i = 0; i < dst_len; i++) {
+        dst[0] = (uint8_t)(((uint32_t)(sum & 0xFFFF) * m) >> 16);
+        dst[1] = (uint8_t)(((uint32_t)((sum >> 16) & 0xFFFF) * m) >> 16);
+        dst[2] = (uint8_t)(((uint32_t)((sum >> 32) & 0xFFFF) * m) >> 16);
+        dst[3] = (uint8_t)(((uint32_t)(sum >> 48) * m) >> 16);
+        dst += CH_CNT_COLOR;
+
+        lv_coord_t sub = LV_MAX(i + ofs - r_back, 0);
+        lv_coord_t add = LV_MIN(i + ofs + 1 + r_front, last);
+        sum -= px_spread(&src[sub * CH_CNT_COLOR]);
+        sum += px_spread(&src[add * CH_CNT_COLOR]);
+    }
+}
+
+static void ver_add(uint16_t * sum, const uint8_t * add, uint32_t len)
+{
+    uint32_t i;
+    for(i = 0; i < len; i++) sum[i] += add[i];
+}
+
+/**
+ * Move the box down by one row: `sum += add - sub`.
+ * The sums wrap around in 16 bit but the result is always in range.
+ */
+static void ver_update(uint16_t * sum, const uint8_t * add, const uint8_t * sub, uint32_t len)
+{
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 16 <= len; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&add[i]);
+        __m128i s = _mm_loadu_si128((const __m128i *)&sub[i]);
+        __m128i lo = _mm_loadu_si128((const __m128i *)&sum[i]);
+        __m128i hi = _mm_loadu_si128((const __m128i *)&sum[i + 8]);
+        lo = _mm_add_epi16(lo, _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(s, zero)));
+        hi = _mm_add_epi16(hi, _mm_sub_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(s, zero)));
+        _mm_storeu_si128((__m128i *)&sum[i], lo);
+        _mm_storeu_si128((__m128i *)&sum[i + 8], hi);
+    }
+#endif
+    for(; i < len; i++) sum[i] = (uint16_t)(sum[i] + add[i] - sub[i]);
+}
+
+/**
+ * Get the averages from the sums: `dst = (sum * m) >> 16`
+ */
+static void ver_div(const uint16_t * sum, uint8_t * dst, uint32_t len, uint32_t m)
+{
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    const __m128i mv = _mm_set1_epi16((short)m);
+    for(; i + 16 <= len; i += 16) {
+        __m128i lo = _mm_mulhi_epu16(_mm_loadu_si128((const __m128i *)&sum[i]), mv);
+        __m128i hi = _mm_mulhi_epu16(_mm_loadu_si128((const __m128i *)&sum[i + 8]), mv);
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for(; i < len; i++) dst[i] = (uint8_t)((sum[i] * m) >> 16);
+}
+
+/**
+ * Call `cb` with the unpacked pixels of each row of the area
+ */
+static lv_res_t filter_px(lv_img_dsc_t * img, const lv_area_t * area, filter_px_cb_t cb, const void * user_data)
+{
+    filter_img_t fimg;
+    if(filter_img_init(&fimg, img, true) != LV_RES_OK) return LV_RES_INV;
+
+    lv_area_t a;
+    lv_area_set(&a, 0, 0, fimg.w - 1, fimg.h - 1);
+    if(area && !_lv_area_intersect(&a, &a, area)) return LV_RES_OK;
+
+    lv_coord_t w = lv_area_get_width(&a);
+    uint8_t * buf = NULL;
+    if(!fimg.native) {
+        buf = get_buf((uint32_t)w * CH_CNT_COLOR);
+        if(buf == NULL) return LV_RES_INV;
+    }
+
+    lv_coord_t y;
+    for(y = a.y1; y <= a.y2; y++) {
+        uint8_t * px = (uint8_t *)read_px(&fimg, a.x1, y, w, buf);
+        cb(px, (uint32_t)w, user_data);
+        write_px(&fimg, a.x1, y, w, px);
+    }
+
+    return LV_RES_OK;
+}
+
+static void matrix_cb(uint8_t * px, uint32_t px_cnt, const void * user_data)
+{
+    const lv_draw_sw_filter_matrix_t * matrix = user_data;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        int32_t b = px[0];
+        int32_t g = px[1];
+        int32_t r = px[2];
+        uint32_t ch;
+        for(ch = 0; ch < 3; ch++) {
+            const int16_t * row = matrix->m[ch];
+            int32_t v = ((row[0] * r + row[1] * g + row[2] * b + 128) >> 8) + row[3];
+            px[2 - ch] = (uint8_t)LV_CLAMP(0, v, 255);
+        }
+        px += CH_CNT_COLOR;
+    }
+}
+
+static void lut_cb(uint8_t * px, uint32_t px_cnt, const void * user_data)
+{
+    const uint8_t * lut = user_data;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        px[0] = lut[px[0]];
+        px[1] = lut[px[1]];
+        px[2] = lut[px[2]];
+        px += CH_CNT_COLOR;
+    }
+}
+
+#endif /*LV_USE_DRAW_SW*/
@@ -0,0 +1,112 @@
+/**
+ * @file lv_draw_sw_filter.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_FILTER_H
+#define LV_DRAW_SW_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#include "../../misc/lv_area.h"
+#include "../../misc/lv_color.h"
+#include "../lv_img_buf.h"
+
+#if LV_USE_DRAW_SW
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The largest radius of a box blur. The larger values are limited to it.*/
+#define LV_DRAW_SW_FILTER_BOX_MAX   255
+
+/*The largest radius of a Gaussian blur. The larger values are limited to it.*/
+#define LV_DRAW_SW_FILTER_GAUSS_MAX 100
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A color matrix in 1/256 units. Each row calculates a channel of the result:
+ * `red = (m[0][0] * red + m[0][1] * green + m[0][2] * blue) / 256 + m[0][3]`
+ * The rows are for red, green and blue. The alpha channel is not changed.
+ */
+typedef struct {
+    int16_t m[3][4];
+} lv_draw_sw_filter_matrix_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Blur an area of an image with a box blur, i.e. every pixel will be the average of the pixels in a box around it.
+ * The pixels around the area are used too, and the pixels of the image's edges are repeated out of the image.
+ * @param img       pointer to an image with `LV_IMG_CF_TRUE_COLOR`, `LV_IMG_CF_TRUE_COLOR_ALPHA`,
+ *                  `LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED` or `LV_IMG_CF_ALPHA_8BIT` color format
+ * @param area      the area to blur relative to the image. NULL to blur the whole image.
+ * @param r_hor     width of the box. 0 or 1: don't blur horizontally
+ * @param r_ver     height of the box. 0 or 1: don't blur vertically
+ * @return          LV_RES_OK: the area is blurred; LV_RES_INV: the color format is not supported or out of memory
+ */
+lv_res_t lv_draw_sw_filter_box_blur(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r_hor, uint16_t r_ver);
+
+/**
+ * Blur an area of an image with an approximated Gaussian blur (3 box blurs in both directions)
+ * @param img       pointer to an image (see `lv_draw_sw_filter_box_blur()` for the color formats)
+ * @param area      the area to blur relative to the image. NULL to blur the whole image.
+ * @param radius    standard deviation of the Gaussian blur in pixels (like in CSS's `blur()`)
+ * @return          LV_RES_OK: the area is blurred; LV_RES_INV: the color format is not supported or out of memory
+ */
+lv_res_t lv_draw_sw_filter_gauss_blur(lv_img_dsc_t * img, const lv_area_t * area, uint16_t radius);
+
+/**
+ * Transform the colors of an area of an image with a color matrix
+ * @param img       pointer to an image with `LV_IMG_CF_TRUE_COLOR`, `LV_IMG_CF_TRUE_COLOR_ALPHA`
+ *                  or `LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED` color format
+ * @param area      the area to change relative to the image. NULL to change the whole image.
+ * @param matrix    pointer to a color matrix
+ * @return          LV_RES_OK: the colors are changed; LV_RES_INV: the color format is not supported or out of memory
+ */
+lv_res_t lv_draw_sw_filter_color_matrix(lv_img_dsc_t * img, const lv_area_t * area,
+                                        const lv_draw_sw_filter_matrix_t * matrix);
+
+/**
+ * Scale the brightness of an area of an image
+ * @param img       pointer to an image (see `lv_draw_sw_filter_color_matrix()` for the color formats)
+ * @param area      the area to change relative to the image. NULL to change the whole image.
+ * @param scale     256: keep the colors, < 256: darken, > 256: lighten. E.g. 128 halves the channels.
+ * @return          LV_RES_OK: the colors are changed; LV_RES_INV: the color format is not supported or out of memory
+ */
+lv_res_t lv_draw_sw_filter_brightness(lv_img_dsc_t * img, const lv_area_t * area, uint16_t scale);
+
+/**
+ * Initialize a color matrix which changes the saturation
+ * @param matrix    pointer to a color matrix to initialize
+ * @param sat       256: keep the colors, 0: grayscale, > 256: more saturated colors
+ */
+void lv_draw_sw_filter_matrix_init_saturation(lv_draw_sw_filter_matrix_t * matrix, uint16_t sat);
+
+/**
+ * Free the working buffer of the filters. It's kept between the calls to avoid allocating it for every frame.
+ */
+void lv_draw_sw_filter_free_buf(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_FILTER_H*/
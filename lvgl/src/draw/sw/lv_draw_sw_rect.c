@@ -14,6 +14,7 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
 #include "lv_draw_sw_dither.h"
+#include "lv_draw_sw_ring_cache.h"
 
 /*********************
  *      DEFINES
@@ -26,6 +27,20 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if !(LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE)
+typedef void _lv_draw_sw_ring_t;
+#endif
+
+#if LV_USE_DRAW_MASKS && LV_DRAW_SW_SHADOW_CACHE_SIZE
+/*A blurred shadow corner in the shadow cache. Followed by `size * size` opacity values.*/
+typedef struct {
+    uint32_t life;          /*Used to find the least recently used corner*/
+    uint16_t sw;            /*Shadow width*/
+    uint16_t r;             /*Radius of the shadow*/
+    uint16_t w;             /*Width of the blurred rectangle or 0 if it's too wide to affect the corner*/
+    uint16_t h;             /*Height of the blurred rectangle or 0 if it's too tall to affect the corner*/
+} sh_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -39,9 +54,13 @@ static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * ds
 #if LV_USE_DRAW_MASKS
 LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
                                               const lv_area_t * coords);
-LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, lv_coord_t s,
-                                                         lv_coord_t r);
-LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+LV_ATTRIBUTE_FAST_MEM static lv_res_t shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf,
+                                                             lv_coord_t s, lv_coord_t r);
+LV_ATTRIBUTE_FAST_MEM static lv_res_t shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#endif
+#if LV_USE_DRAW_MASKS && LV_DRAW_SW_SHADOW_CACHE_SIZE
+static const lv_opa_t * shadow_cache_get(lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h);
+static void shadow_cache_add(const lv_opa_t * sh_buf, lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h);
 #endif
 
 void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
@@ -50,14 +69,25 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
 static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
                                lv_color_t color, lv_opa_t opa);
 
+#if LV_USE_DRAW_MASKS
+static lv_draw_mask_res_t get_row_mask(const _lv_draw_sw_ring_t * ring, const lv_area_t * coords, lv_opa_t * buf,
+                                       lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_opa_t opa);
+#endif
+#if LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE
+static void get_corner_mask(lv_opa_t * buf, int32_t step, const _lv_draw_sw_ring_t * ring, lv_coord_t ring_y,
+                            lv_coord_t i_min, lv_coord_t i_max, lv_opa_t opa);
+static inline lv_opa_t mask_mix_opa(lv_opa_t cov, lv_opa_t opa);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+#if LV_USE_DRAW_MASKS && LV_DRAW_SW_SHADOW_CACHE_SIZE
+    /*Room for the largest corner or for more smaller ones*/
+    #define SH_CACHE_ENTRY_SIZE(size)   ((sizeof(sh_cache_entry_t) + (size) * (size) + 3) & ~3)
+    static uint32_t sh_cache[SH_CACHE_ENTRY_SIZE(LV_DRAW_SW_SHADOW_CACHE_SIZE) / 4];
+    static uint32_t sh_cache_used;
+    static uint32_t sh_cache_access_cnt;
 #endif
 
 /**********************
@@ -148,6 +178,12 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     int32_t short_side = LV_MIN(coords_bg_w, coords_bg_h);
     int32_t rout = LV_MIN(dsc->radius, short_side >> 1);
 
+    /*Without other masks the corners can be copied from the cache*/
+    const _lv_draw_sw_ring_t * ring = NULL;
+#if LV_DRAW_SW_RING_CACHE_SIZE
+    if(!mask_any) ring = _lv_draw_sw_ring_cache_get(rout, rout, false);
+#endif
+
     /*Add a radius mask if there is radius*/
     int32_t clipped_w = lv_area_get_width(&clipped_coords);
     int16_t mask_rout_id = LV_MASK_ID_INV;
@@ -155,8 +191,10 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     lv_draw_mask_radius_param_t mask_rout_param;
     if(rout > 0 || mask_any) {
         mask_buf = lv_malloc(clipped_w);
-        lv_draw_mask_radius_init(&mask_rout_param, &bg_coords, rout, false);
-        mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
+        if(ring == NULL) {
+            lv_draw_mask_radius_init(&mask_rout_param, &bg_coords, rout, false);
+            mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
+        }
     }
 
     int32_t h;
@@ -251,8 +289,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
 
         /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
          * It saves calculating the final opa in lv_draw_sw_blend*/
-        lv_memset(mask_buf, opa, clipped_w);
-        blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, top_y, clipped_w);
+        blend_dsc.mask_res = get_row_mask(ring, &bg_coords, mask_buf, blend_area.x1, top_y, clipped_w, opa);
         if(blend_dsc.mask_res == LV_DRAW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
 
         if(top_y >= clipped_coords.y1) {
@@ -490,22 +527,25 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
+    /*The size of the blurred rectangle matters only if its far edges are close to the corner*/
+    lv_coord_t key_w = lv_area_get_width(&core_area);
+    lv_coord_t key_h = lv_area_get_height(&core_area);
+    if(key_w >= corner_size + r_sh) key_w = 0;
+    if(key_h >= corner_size + r_sh) key_h = 0;
+
+    const lv_opa_t * sh_cached = shadow_cache_get(dsc->shadow_width, r_sh, key_w, key_h);
+    if(sh_cached) {
         /*Use the cache if available*/
         sh_buf = lv_malloc(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        lv_memcpy(sh_buf, sh_cached, corner_size * corner_size);
     }
     else {
         /*A larger buffer is required for calculation*/
         sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
+        lv_res_t res = shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+        /*Cache the corner if it fits into the cache size. Don't keep a badly blurred corner.*/
+        if(res == LV_RES_OK) shadow_cache_add(sh_buf, dsc->shadow_width, r_sh, key_w, key_h);
     }
 #else
     sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
@@ -953,9 +993,10 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
  * @param sh_buf a buffer to store the result. Its size should be `(sw + r)^2 * 2`
  * @param sw shadow width
  * @param r radius
+ * @return LV_RES_OK: ready; LV_RES_INV: the corner couldn't be blurred entirely due to lack of memory
  */
-LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, lv_coord_t sw,
-                                                         lv_coord_t r)
+LV_ATTRIBUTE_FAST_MEM static lv_res_t shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf,
+                                                             lv_coord_t sw, lv_coord_t r)
 {
     int32_t sw_ori = sw;
     int32_t size = sw_ori  + r;
@@ -1007,10 +1048,10 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coord
         for(i = 0; i < size * size; i++) {
             res_buf[i] = (sh_buf[i] >> SHADOW_UPSCALE_SHIFT);
         }
-        return;
+        return LV_RES_OK;
     }
 
-    shadow_blur_corner(size, sw, sh_buf);
+    lv_res_t res = shadow_blur_corner(size, sw, sh_buf);
 
 #if SHADOW_ENHANCE == 0
     /*The result is required in lv_opa_t not uint16_t*/
@@ -1030,7 +1071,7 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coord
             else  sh_buf[i] = (sh_buf[i] << SHADOW_UPSCALE_SHIFT) / sw;
         }
 
-        shadow_blur_corner(size, sw, sh_buf);
+        if(res == LV_RES_OK) res = shadow_blur_corner(size, sw, sh_buf);
     }
     int32_t x;
     lv_opa_t * res_buf = (lv_opa_t *)sh_buf;
@@ -1039,9 +1080,17 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coord
     }
 #endif
 
+    return res;
 }
 
-LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf)
+/**
+ * Blur a corner horizontally and vertically
+ * @param size size of the corner
+ * @param sw shadow width
+ * @param sh_ups_buf the upscaled corner to blur in place
+ * @return LV_RES_OK: ready; LV_RES_INV: not or only horizontally blurred due to lack of memory
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_res_t shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf)
 {
     int32_t s_left = sw >> 1;
     int32_t s_right = (sw >> 1);
@@ -1049,6 +1098,8 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
 
     /*Horizontal blur*/
     uint16_t * sh_ups_blur_buf = lv_malloc(size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sh_ups_blur_buf);
+    if(sh_ups_blur_buf == NULL) return LV_RES_INV;
 
     int32_t x;
     int32_t y;
@@ -1085,34 +1136,133 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
         else sh_ups_buf[i] = sh_ups_buf[i] / sw;
     }
 
+    /*Blur the columns row by row to read the buffer sequentially.
+     *A row is still needed `s_right` rows later so keep the results in a ring of `s_right + 1` rows*/
+    int32_t * v_buf = lv_malloc(size * sizeof(int32_t));
+    uint16_t * res_buf = lv_malloc((s_right + 1) * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(v_buf);
+    LV_ASSERT_MALLOC(res_buf);
+    if(v_buf == NULL || res_buf == NULL) {
+        /*Leave the corner blurred only horizontally*/
+        lv_free(v_buf);
+        lv_free(res_buf);
+        lv_free(sh_ups_blur_buf);
+        return LV_RES_INV;
+    }
+
     for(x = 0; x < size; x++) {
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        int32_t v = sh_ups_tmp_buf[0] * sw;
-        for(y = 0; y < size ; y++, sh_ups_tmp_buf += size) {
-            sh_ups_blur_buf[y] = v < 0 ? 0 : (v >> SHADOW_UPSCALE_SHIFT);
-
-            /*Forget the top pixel*/
-            uint32_t top_val;
-            if(y - s_right <= 0) top_val = sh_ups_tmp_buf[0];
-            else top_val = sh_ups_buf[(y - s_right) * size + x];
-            v -= top_val;
-
-            /*Add the bottom pixel*/
-            uint32_t bottom_val;
-            if(y + s_left + 1 < size) bottom_val = sh_ups_buf[(y + s_left + 1) * size + x];
-            else bottom_val = sh_ups_buf[(size - 1) * size + x];
-            v += bottom_val;
+        v_buf[x] = sh_ups_buf[x] * sw;
+    }
+
+    for(y = 0; y < size; y++) {
+        uint16_t * res_row = &res_buf[(y % (s_right + 1)) * size];
+        for(x = 0; x < size; x++) {
+            res_row[x] = v_buf[x] < 0 ? 0 : (v_buf[x] >> SHADOW_UPSCALE_SHIFT);
         }
 
-        /*Write back the result into `sh_ups_buf`*/
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        for(y = 0; y < size; y++, sh_ups_tmp_buf += size) {
-            (*sh_ups_tmp_buf) = sh_ups_blur_buf[y];
+        /*Forget the top pixel*/
+        const uint16_t * top_row = &sh_ups_buf[(y - s_right <= 0 ? y : y - s_right) * size];
+        for(x = 0; x < size; x++) {
+            v_buf[x] -= top_row[x];
         }
+
+        /*Add the bottom pixel*/
+        const uint16_t * bottom_row = &sh_ups_buf[(y + s_left + 1 < size ? y + s_left + 1 : size - 1) * size];
+        for(x = 0; x < size; x++) {
+            v_buf[x] += bottom_row[x];
+        }
+
+        /*The row `s_right` above is not read anymore so write back its result into `sh_ups_buf`*/
+        if(y >= s_right) {
+            lv_memcpy(&sh_ups_buf[(y - s_right) * size], &res_buf[((y - s_right) % (s_right + 1)) * size],
+                      size * sizeof(uint16_t));
+        }
+    }
+
+    /*Write back the remaining rows*/
+    for(y = LV_MAX(size - s_right, 0); y < size; y++) {
+        lv_memcpy(&sh_ups_buf[y * size], &res_buf[(y % (s_right + 1)) * size], size * sizeof(uint16_t));
     }
 
+    lv_free(v_buf);
+    lv_free(res_buf);
     lv_free(sh_ups_blur_buf);
+
+    return LV_RES_OK;
+}
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * Find a blurred corner in the shadow cache
+ * @param sw    shadow width
+ * @param r     radius of the shadow
+ * @param w     width of the blurred rectangle or 0 if it doesn't affect the corner
+ * @param h     height of the blurred rectangle or 0 if it doesn't affect the corner
+ * @return      the `(sw + r)^2` opacity values of the corner or NULL if it's not cached
+ */
+static const lv_opa_t * shadow_cache_get(lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h)
+{
+    sh_cache_access_cnt++;
+
+    uint8_t * p = (uint8_t *)sh_cache;
+    uint8_t * end = p + sh_cache_used;
+    while(p < end) {
+        sh_cache_entry_t * entry = (sh_cache_entry_t *)p;
+        if(entry->sw == sw && entry->r == r && entry->w == w && entry->h == h) {
+            entry->life = sh_cache_access_cnt;
+            return (const lv_opa_t *)(entry + 1);
+        }
+        p += SH_CACHE_ENTRY_SIZE(entry->sw + entry->r);
+    }
+
+    return NULL;
+}
+
+/**
+ * Add a blurred corner to the shadow cache. Free the least recently used corners if there is not enough space.
+ * @param sh_buf    the `(sw + r)^2` opacity values of the corner
+ * @param sw        shadow width
+ * @param r         radius of the shadow
+ * @param w         width of the blurred rectangle or 0 if it doesn't affect the corner
+ * @param h         height of the blurred rectangle or 0 if it doesn't affect the corner
+ */
+static void shadow_cache_add(const lv_opa_t * sh_buf, lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h)
+{
+    uint32_t size = sw + r;
+    uint32_t entry_size = SH_CACHE_ENTRY_SIZE(size);
+    if(entry_size > sizeof(sh_cache)) return;
+
+    uint8_t * cache = (uint8_t *)sh_cache;
+    while(sh_cache_used + entry_size > sizeof(sh_cache)) {
+        sh_cache_entry_t * oldest = NULL;
+        uint8_t * p = cache;
+        while(p < cache + sh_cache_used) {
+            sh_cache_entry_t * entry = (sh_cache_entry_t *)p;
+            if(oldest == NULL || entry->life < oldest->life) oldest = entry;
+            p += SH_CACHE_ENTRY_SIZE(entry->sw + entry->r);
+        }
+
+        /*Move the next corners to the place of the removed one*/
+        uint8_t * dst = (uint8_t *)oldest;
+        uint8_t * src = dst + SH_CACHE_ENTRY_SIZE(oldest->sw + oldest->r);
+        while(src < cache + sh_cache_used) {
+            *dst = *src;
+            dst++;
+            src++;
+        }
+        sh_cache_used = dst - cache;
+    }
+
+    sh_cache_entry_t * entry = (sh_cache_entry_t *)(cache + sh_cache_used);
+    entry->life = sh_cache_access_cnt;
+    entry->sw = sw;
+    entry->r = r;
+    entry->w = w;
+    entry->h = h;
+    lv_memcpy(entry + 1, sh_buf, size * size);
+    sh_cache_used += entry_size;
 }
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
 #endif
 
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
@@ -1179,19 +1329,34 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
     lv_memzero(&blend_dsc, sizeof(blend_dsc));
     blend_dsc.mask_buf = lv_malloc(draw_area_w);;
 
+    /*If the width is the same on each side and there are no other masks,
+     *the corners are the quarters of a ring which can be copied from the cache*/
+    const _lv_draw_sw_ring_t * ring = NULL;
+#if LV_DRAW_SW_RING_CACHE_SIZE
+    lv_coord_t border_w = inner_area->x1 - outer_area->x1;
+    if(!mask_any && border_w > 0 && rout >= border_w && rin == rout - border_w &&
+       inner_area->y1 - outer_area->y1 == border_w && outer_area->x2 - inner_area->x2 == border_w &&
+       outer_area->y2 - inner_area->y2 == border_w &&
+       rout <= LV_MIN(lv_area_get_width(outer_area), lv_area_get_height(outer_area)) >> 1) {
+        ring = _lv_draw_sw_ring_cache_get(rout, border_w, false);
+    }
+#endif
 
     /*Create mask for the outer area*/
     int16_t mask_rout_id = LV_MASK_ID_INV;
     lv_draw_mask_radius_param_t mask_rout_param;
-    if(rout > 0) {
+    if(rout > 0 && ring == NULL) {
         lv_draw_mask_radius_init(&mask_rout_param, outer_area, rout, false);
         mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
     }
 
     /*Create mask for the inner mask*/
+    int16_t mask_rin_id = LV_MASK_ID_INV;
     lv_draw_mask_radius_param_t mask_rin_param;
-    lv_draw_mask_radius_init(&mask_rin_param, inner_area, rin, true);
-    int16_t mask_rin_id = lv_draw_mask_add(&mask_rin_param, NULL);
+    if(ring == NULL) {
+        lv_draw_mask_radius_init(&mask_rin_param, inner_area, rin, true);
+        mask_rin_id = lv_draw_mask_add(&mask_rin_param, NULL);
+    }
 
     int32_t h;
     lv_area_t blend_area;
@@ -1296,8 +1461,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
             lv_coord_t bottom_y = outer_area->y2 - h;
             if(top_y < draw_area.y1 && bottom_y > draw_area.y2) continue;   /*This line is clipped now*/
 
-            lv_memset(blend_dsc.mask_buf, 0xff, draw_area_w);
-            blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, top_y, draw_area_w);
+            blend_dsc.mask_res = get_row_mask(ring, outer_area, blend_dsc.mask_buf, blend_area.x1, top_y, draw_area_w,
+                                              LV_OPA_COVER);
 
             if(top_y >= draw_area.y1) {
                 blend_area.y1 = top_y;
@@ -1323,8 +1488,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
                     blend_area.y1 = h;
                     blend_area.y2 = h;
 
-                    lv_memset(blend_dsc.mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, h, blend_w);
+                    blend_dsc.mask_res = get_row_mask(ring, outer_area, blend_dsc.mask_buf, blend_area.x1, h, blend_w,
+                                                      LV_OPA_COVER);
                     lv_draw_sw_blend(draw_ctx, &blend_dsc);
                 }
             }
@@ -1334,8 +1499,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
                     blend_area.y1 = h;
                     blend_area.y2 = h;
 
-                    lv_memset(blend_dsc.mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, h, blend_w);
+                    blend_dsc.mask_res = get_row_mask(ring, outer_area, blend_dsc.mask_buf, blend_area.x1, h, blend_w,
+                                                      LV_OPA_COVER);
                     lv_draw_sw_blend(draw_ctx, &blend_dsc);
                 }
             }
@@ -1352,8 +1517,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
                     blend_area.y1 = h;
                     blend_area.y2 = h;
 
-                    lv_memset(blend_dsc.mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, h, blend_w);
+                    blend_dsc.mask_res = get_row_mask(ring, outer_area, blend_dsc.mask_buf, blend_area.x1, h, blend_w,
+                                                      LV_OPA_COVER);
                     lv_draw_sw_blend(draw_ctx, &blend_dsc);
                 }
             }
@@ -1363,18 +1528,22 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
                     blend_area.y1 = h;
                     blend_area.y2 = h;
 
-                    lv_memset(blend_dsc.mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, h, blend_w);
+                    blend_dsc.mask_res = get_row_mask(ring, outer_area, blend_dsc.mask_buf, blend_area.x1, h, blend_w,
+                                                      LV_OPA_COVER);
                     lv_draw_sw_blend(draw_ctx, &blend_dsc);
                 }
             }
         }
     }
 
-    lv_draw_mask_free_param(&mask_rin_param);
-    lv_draw_mask_remove_id(mask_rin_id);
-    lv_draw_mask_free_param(&mask_rout_param);
-    lv_draw_mask_remove_id(mask_rout_id);
+    if(mask_rin_id != LV_MASK_ID_INV) {
+        lv_draw_mask_free_param(&mask_rin_param);
+        lv_draw_mask_remove_id(mask_rin_id);
+    }
+    if(mask_rout_id != LV_MASK_ID_INV) {
+        lv_draw_mask_free_param(&mask_rout_param);
+        lv_draw_mask_remove_id(mask_rout_id);
+    }
     lv_free(blend_dsc.mask_buf);
 
 #else /*LV_USE_DRAW_MASKS*/
@@ -1430,4 +1599,118 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
     }
 }
 
+#if LV_USE_DRAW_MASKS
+/**
+ * Get the mask of a row in the corners of a rectangle or border
+ * @param ring      the cached corners or NULL to apply the added masks
+ * @param coords    the outer area of the rectangle or border
+ * @param buf       store the mask here
+ * @param abs_x     absolute x coordinate of the first pixel of `buf`
+ * @param abs_y     absolute y coordinate of the row. Should be in the corners.
+ * @param len       number of pixels to get
+ * @param opa       opacity of the fully covered pixels
+ * @return          LV_DRAW_MASK_RES_TRANSP, LV_DRAW_MASK_RES_FULL_COVER, or LV_DRAW_MASK_RES_CHANGED
+ */
+static lv_draw_mask_res_t get_row_mask(const _lv_draw_sw_ring_t * ring, const lv_area_t * coords, lv_opa_t * buf,
+                                       lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_opa_t opa)
+{
+    lv_memset(buf, opa, len);
+
+#if LV_DRAW_SW_RING_CACHE_SIZE
+    if(ring) {
+        lv_coord_t radius = ring->radius;
+        lv_coord_t ring_y = abs_y - coords->y1;
+        if(ring_y >= radius) ring_y = coords->y2 - abs_y;
+
+        /*Clear the hole of the ring between the corners*/
+        lv_coord_t abs_x2 = abs_x + len - 1;
+        if(ring->width < radius && ring_y >= ring->width) {
+            lv_coord_t mid_x1 = LV_MAX(abs_x, coords->x1 + radius);
+            lv_coord_t mid_x2 = LV_MIN(abs_x2, coords->x2 - radius);
+            if(mid_x1 <= mid_x2) lv_memzero(&buf[mid_x1 - abs_x], mid_x2 - mid_x1 + 1);
+        }
+
+        /*The left corner from left to right and the right corner from right to left*/
+        lv_coord_t i_min = LV_MAX(0, abs_x - coords->x1);
+        lv_coord_t i_max = LV_MIN(radius - 1, abs_x2 - coords->x1);
+        if(i_min <= i_max) get_corner_mask(&buf[coords->x1 + i_min - abs_x], 1, ring, ring_y, i_min, i_max, opa);
+
+        i_min = LV_MAX(0, coords->x2 - abs_x2);
+        i_max = LV_MIN(radius - 1, coords->x2 - abs_x);
+        if(i_min <= i_max) get_corner_mask(&buf[coords->x2 - i_min - abs_x], -1, ring, ring_y, i_min, i_max, opa);
+
+        return LV_DRAW_MASK_RES_CHANGED;
+    }
+#else
+    LV_UNUSED(ring);
+    LV_UNUSED(coords);
+#endif
+
+    return lv_draw_mask_apply(buf, abs_x, abs_y, len);
+}
+#endif /*LV_USE_DRAW_MASKS*/
+
+#if LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE
+/**
+ * Mask the pixels of a corner with the cached ring like the radius masks do.
+ * The fully covered pixels are not changed.
+ * @param buf       the mask of the `i_min`th pixel
+ * @param step      1: the next pixels are to the right; -1: to the left (mirrored corner)
+ * @param ring      the ring whose top left quarter is the top left corner
+ * @param ring_y    the row of the ring
+ * @param i_min     distance of the first pixel from the side of the rectangle
+ * @param i_max     distance of the last pixel from the side of the rectangle
+ * @param opa       opacity of the fully covered pixels
+ */
+static void get_corner_mask(lv_opa_t * buf, int32_t step, const _lv_draw_sw_ring_t * ring, lv_coord_t ring_y,
+                            lv_coord_t i_min, lv_coord_t i_max, lv_opa_t opa)
+{
+    const _lv_draw_sw_ring_row_t * row = _lv_draw_sw_ring_get_row(ring, ring_y);
+    const lv_opa_t * cov = _lv_draw_sw_ring_get_cov(ring, row) - row->x;
+
+    /*Transparent before the outer edge, anti-aliased, fully covered, anti-aliased (inner edge)
+     *and transparent in the hole of the ring*/
+    lv_coord_t end = i_max + 1;
+    lv_coord_t cover_start = LV_MIN(row->x + row->cover_x, end);
+    lv_coord_t cover_end = LV_MIN(cover_start + row->cover_len, end);
+    lv_coord_t cov_end = LV_MIN(row->x + row->len, end);
+    lv_coord_t i = i_min;
+    for(; i < row->x && i < end; i++) {
+        *buf = LV_OPA_TRANSP;
+        buf += step;
+    }
+
+    for(; i < cover_start; i++) {
+        *buf = mask_mix_opa(cov[i], opa);
+        buf += step;
+    }
+
+    if(i < cover_end) {
+        buf += (cover_end - i) * step;
+        i = cover_end;
+    }
+
+    for(; i < cov_end; i++) {
+        *buf = mask_mix_opa(cov[i], opa);
+        buf += step;
+    }
+
+    for(; i < end; i++) {
+        *buf = LV_OPA_TRANSP;
+        buf += step;
+    }
+}
+
+/**
+ * Mix the coverage of a pixel with the opacity of the buffer as the masks do
+ */
+static inline lv_opa_t mask_mix_opa(lv_opa_t cov, lv_opa_t opa)
+{
+    if(opa >= LV_OPA_MAX) return cov;
+    if(opa <= LV_OPA_MIN) return 0;
+
+    return LV_UDIV255(cov * opa);
+}
+#endif /*LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE*/
+
 #endif /*LV_USE_DRAW_SW*/
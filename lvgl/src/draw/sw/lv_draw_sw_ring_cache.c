@@ -0,0 +1,224 @@
+/**
+ * @file lv_draw_sw_ring_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_ring_cache.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE
+
+#include "../lv_draw_mask.h"
+#include "../lv_draw_rect.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_gc.h"
+#include "../../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RING_CACHE_ALIGN(X)  (((X) + 3) & ~3)
+#define RING_CACHE_MEM       LV_GC_ROOT(_lv_draw_sw_ring_cache_mem)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static _lv_draw_sw_ring_t * ring_cache_add(lv_opa_t * buf, uint16_t radius, uint16_t width, bool inner_first,
+                                           lv_draw_mask_radius_param_t * mask_in_param,
+                                           lv_draw_mask_radius_param_t * mask_out_param);
+static _lv_draw_sw_ring_t * ring_cache_alloc(uint32_t size);
+static void get_row(lv_opa_t * buf, uint16_t radius, bool inner_first, lv_draw_mask_radius_param_t * mask_in_param,
+                    lv_draw_mask_radius_param_t * mask_out_param, lv_coord_t y, _lv_draw_sw_ring_row_t * row);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t * ring_cache_end;
+static uint32_t ring_cache_access_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+const _lv_draw_sw_ring_t * _lv_draw_sw_ring_cache_get(uint16_t radius, uint16_t width, bool inner_first)
+{
+    if(radius == 0) return NULL;
+
+    /*Without hole the order of the masks doesn't matter*/
+    if(width >= radius) {
+        width = radius;
+        inner_first = false;
+    }
+
+    if(RING_CACHE_MEM == NULL) {
+        RING_CACHE_MEM = lv_malloc(LV_DRAW_SW_RING_CACHE_SIZE);
+        LV_ASSERT_MALLOC(RING_CACHE_MEM);
+        if(RING_CACHE_MEM == NULL) return NULL;
+        ring_cache_end = RING_CACHE_MEM;
+    }
+
+    ring_cache_access_cnt++;
+
+    uint8_t * p = RING_CACHE_MEM;
+    while(p < ring_cache_end) {
+        _lv_draw_sw_ring_t * ring = (_lv_draw_sw_ring_t *)p;
+        if(ring->radius == radius && ring->width == width && ring->inner_first == inner_first) {
+            ring->life = ring_cache_access_cnt;
+            return ring;
+        }
+        p += ring->size;
+    }
+
+    /*The ring is calculated with its top left corner at (0;0)*/
+    lv_area_t area_out;
+    lv_area_set(&area_out, 0, 0, 2 * radius - 1, 2 * radius - 1);
+    lv_area_t area_in;
+    lv_area_set(&area_in, width, width, 2 * radius - 1 - width, 2 * radius - 1 - width);
+
+    lv_draw_mask_radius_param_t mask_in_param;
+    lv_draw_mask_radius_param_t * mask_in = NULL;
+    if(lv_area_get_width(&area_in) > 0 && lv_area_get_height(&area_in) > 0) {
+        lv_draw_mask_radius_init(&mask_in_param, &area_in, LV_RADIUS_CIRCLE, true);
+        mask_in = &mask_in_param;
+    }
+    lv_draw_mask_radius_param_t mask_out_param;
+    lv_draw_mask_radius_init(&mask_out_param, &area_out, LV_RADIUS_CIRCLE, false);
+
+    _lv_draw_sw_ring_t * ring = NULL;
+    lv_opa_t * buf = lv_malloc(radius);
+    LV_ASSERT_MALLOC(buf);
+    if(buf) {
+        ring = ring_cache_add(buf, radius, width, inner_first, mask_in, &mask_out_param);
+        lv_free(buf);
+    }
+
+    lv_draw_mask_free_param(&mask_out_param);
+    if(mask_in) lv_draw_mask_free_param(mask_in);
+
+    return ring;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Calculate the rows of a ring and add them to the cache
+ */
+static _lv_draw_sw_ring_t * ring_cache_add(lv_opa_t * buf, uint16_t radius, uint16_t width, bool inner_first,
+                                           lv_draw_mask_radius_param_t * mask_in_param,
+                                           lv_draw_mask_radius_param_t * mask_out_param)
+{
+    /*Measure the rows first to know the size of the ring*/
+    uint32_t cov_size = 0;
+    _lv_draw_sw_ring_row_t row;
+    lv_coord_t y;
+    for(y = 0; y < radius; y++) {
+        get_row(buf, radius, inner_first, mask_in_param, mask_out_param, y, &row);
+        cov_size += row.len;
+    }
+
+    uint32_t size = RING_CACHE_ALIGN(sizeof(_lv_draw_sw_ring_t) + radius * sizeof(_lv_draw_sw_ring_row_t) + cov_size);
+    _lv_draw_sw_ring_t * ring = ring_cache_alloc(size);
+    if(ring == NULL) return NULL;
+
+    _lv_draw_sw_ring_row_t * rows = (_lv_draw_sw_ring_row_t *)(ring + 1);
+    lv_opa_t * cov = (lv_opa_t *)(rows + radius);
+    uint32_t ofs = 0;
+    for(y = 0; y < radius; y++) {
+        get_row(buf, radius, inner_first, mask_in_param, mask_out_param, y, &rows[y]);
+        rows[y].ofs = ofs;
+        lv_memcpy(&cov[ofs], &buf[rows[y].x], rows[y].len);
+        ofs += rows[y].len;
+    }
+
+    ring->size = size;
+    ring->life = ring_cache_access_cnt;
+    ring->radius = radius;
+    ring->width = width;
+    ring->inner_first = inner_first;
+    ring_cache_end = (uint8_t *)ring + size;
+
+    return ring;
+}
+
+/**
+ * Get space at the end of the cache. Free the least recently used rings if there is not enough space.
+ */
+static _lv_draw_sw_ring_t * ring_cache_alloc(uint32_t size)
+{
+    if(size > LV_DRAW_SW_RING_CACHE_SIZE) return NULL;
+
+    while(ring_cache_end + size > RING_CACHE_MEM + LV_DRAW_SW_RING_CACHE_SIZE) {
+        _lv_draw_sw_ring_t * oldest = NULL;
+        uint8_t * p = RING_CACHE_MEM;
+        while(p < ring_cache_end) {
+            _lv_draw_sw_ring_t * ring = (_lv_draw_sw_ring_t *)p;
+            if(oldest == NULL || ring->life < oldest->life) oldest = ring;
+            p += ring->size;
+        }
+
+        /*Move the next rings to the place of the removed one*/
+        uint8_t * dst = (uint8_t *)oldest;
+        uint8_t * src = dst + oldest->size;
+        while(src < ring_cache_end) {
+            *dst = *src;
+            dst++;
+            src++;
+        }
+        ring_cache_end = dst;
+    }
+
+    return (_lv_draw_sw_ring_t *)ring_cache_end;
+}
+
+/**
+ * Get the coverage of the left half of a row of the ring into `buf` and
+ * the not transparent and fully covered ranges into `row`. The hole of the ring is not part of the ranges.
+ */
+static void get_row(lv_opa_t * buf, uint16_t radius, bool inner_first, lv_draw_mask_radius_param_t * mask_in_param,
+                    lv_draw_mask_radius_param_t * mask_out_param, lv_coord_t y, _lv_draw_sw_ring_row_t * row)
+{
+    lv_memset(buf, LV_OPA_COVER, radius);
+    lv_draw_mask_radius_param_t * masks[2];
+    masks[0] = inner_first ? mask_in_param : mask_out_param;
+    masks[1] = inner_first ? mask_out_param : mask_in_param;
+
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(masks[i] == NULL) continue;
+        lv_draw_mask_res_t res = masks[i]->dsc.cb(buf, 0, y, radius, masks[i]);
+        if(res == LV_DRAW_MASK_RES_TRANSP) {
+            lv_memzero(buf, radius);
+            break;
+        }
+    }
+
+    lv_coord_t x_start = 0;
+    while(x_start < radius && buf[x_start] == LV_OPA_TRANSP) x_start++;
+
+    lv_coord_t x_end = radius;
+    while(x_end > x_start && buf[x_end - 1] == LV_OPA_TRANSP) x_end--;
+
+    lv_coord_t cover_start = x_start;
+    while(cover_start < x_end && buf[cover_start] != LV_OPA_COVER) cover_start++;
+
+    lv_coord_t cover_end = cover_start;
+    while(cover_end < x_end && buf[cover_end] == LV_OPA_COVER) cover_end++;
+
+    row->x = x_start;
+    row->len = x_end - x_start;
+    row->cover_x = cover_start - x_start;
+    row->cover_len = cover_end - cover_start;
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE*/
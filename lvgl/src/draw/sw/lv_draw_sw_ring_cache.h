@@ -0,0 +1,97 @@
+/**
+ * @file lv_draw_sw_ring_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_RING_CACHE_H
+#define LV_DRAW_SW_RING_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_area.h"
+#include "../../misc/lv_color.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A row of the top left quarter of a ring*/
+typedef struct {
+    uint32_t ofs;           /*Offset of the coverage in the coverage buffer of the ring*/
+    uint16_t x;             /*The first not transparent pixel relative to the left of the ring*/
+    uint16_t len;           /*Number of pixels from `x` to the inner edge of the ring or to the vertical center line*/
+    uint16_t cover_x;       /*The first fully covered pixel relative to `x`*/
+    uint16_t cover_len;     /*Number of fully covered pixels from `cover_x`. 0 if there are no such pixels.*/
+} _lv_draw_sw_ring_row_t;
+
+/*The anti-aliased coverage of the top left quarter of a ring. The other quarters are its mirrors.
+ *Followed by `radius` rows and the coverage of the rows.*/
+typedef struct {
+    uint32_t size;          /*Size of the ring with the rows and the coverage*/
+    uint32_t life;          /*Used to find the least recently used ring*/
+    uint16_t radius;
+    uint16_t width;
+    uint8_t inner_first;    /*1: the inner edge was masked first; 0: the outer edge was masked first*/
+} _lv_draw_sw_ring_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the coverage of a ring from the cache or calculate it and add it to the cache.
+ * The outer edge is a circle with `radius` in a `2 * radius` wide square. The inner edge is a circle
+ * with `radius - width` radius in the square shrunk by `width` on each side.
+ * The same radius masks are used as the masked drawing of arcs and rounded rectangles, so the result is the same.
+ * @param radius        radius of the outer edge
+ * @param width         width of the ring. If `width >= radius` there is no hole.
+ * @param inner_first   true: mask the inner edge first (arcs); false: mask the outer edge first (borders)
+ * @return              the ring or NULL if it doesn't fit into the cache. Valid until the next call.
+ */
+const _lv_draw_sw_ring_t * _lv_draw_sw_ring_cache_get(uint16_t radius, uint16_t width, bool inner_first);
+
+/**
+ * Get a row of the top left quarter of a ring
+ * @param ring      pointer to a ring
+ * @param y         the row, 0: the top row of the ring
+ * @return          pointer to the row
+ */
+static inline const _lv_draw_sw_ring_row_t * _lv_draw_sw_ring_get_row(const _lv_draw_sw_ring_t * ring, lv_coord_t y)
+{
+    return (const _lv_draw_sw_ring_row_t *)(ring + 1) + y;
+}
+
+/**
+ * Get the coverage of a row
+ * @param ring      pointer to a ring
+ * @param row       a row of `ring`
+ * @return          the coverage of the pixels from `row->x`
+ */
+static inline const lv_opa_t * _lv_draw_sw_ring_get_cov(const _lv_draw_sw_ring_t * ring,
+                                                        const _lv_draw_sw_ring_row_t * row)
+{
+    return (const lv_opa_t *)((const _lv_draw_sw_ring_row_t *)(ring + 1) + ring->radius) + row->ofs;
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_MASKS && LV_DRAW_SW_RING_CACHE_SIZE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_RING_CACHE_H*/
@@ -16,10 +16,22 @@
 /*********************
  *      DEFINES
  *********************/
+/*Use the generic vector extension of GCC and Clang to process 4 pixels in one step.
+ *It's compiled to NEON instructions on ARM (if enabled with e.g. `-mfpu=neon`) and to SSE on x86*/
+#if defined(__GNUC__) && LV_COLOR_DEPTH == 32
+    #define TRANSFORM_SIMD  1
+#else
+    #define TRANSFORM_SIMD  0
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if TRANSFORM_SIMD
+typedef uint32_t vec_u32_t __attribute__((vector_size(16)));
+typedef int32_t vec_i32_t __attribute__((vector_size(16)));
+#endif
+
 typedef struct {
     int32_t x_in;
     int32_t y_in;
@@ -48,6 +60,12 @@ typedef struct {
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout);
 
+static void transform_90(const lv_area_t * dest_area, const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h,
+                         lv_coord_t src_stride, int32_t angle, lv_point_t pivot, lv_img_cf_t cf,
+                         lv_color_t * cbuf, lv_opa_t * abuf);
+
+static void clip_range(int32_t v_ups, int32_t step, int32_t min, int32_t max, int32_t * x_start, int32_t * x_end);
+
 static void argb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                        int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
@@ -66,9 +84,25 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                             int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
 
+static void argb_and_rgb_aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                                 int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                 int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
+
+static void argb_and_rgb_aa_inner(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                  int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
+
+static void a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                     int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                     int32_t x_end, uint8_t * abuf);
+
 static void a8_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                   int32_t x_end, uint8_t * abuf);
+
+static void a8_aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                       int32_t x_start, int32_t x_end, uint8_t * abuf);
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -87,6 +121,12 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
 {
     LV_UNUSED(draw_ctx);
 
+    /*Rotating by 90, 180 or 270 degree without zoom maps every pixel exactly to a source pixel*/
+    if(draw_dsc->zoom == LV_IMG_ZOOM_NONE && draw_dsc->angle % 900 == 0) {
+        transform_90(dest_area, src_buf, src_w, src_h, src_stride, draw_dsc->angle, draw_dsc->pivot, cf, cbuf, abuf);
+        return;
+    }
+
     point_transform_dsc_t tr_dsc;
     tr_dsc.angle = -draw_dsc->angle;
     tr_dsc.zoom = (256 * 256) / draw_dsc->zoom;
@@ -111,6 +151,7 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
 
     lv_coord_t dest_w = lv_area_get_width(dest_area);
     lv_coord_t dest_h = lv_area_get_height(dest_area);
+    int32_t ys_prev = INT32_MIN;
     lv_coord_t y;
     for(y = 0; y < dest_h; y++) {
         int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
@@ -118,6 +159,20 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
         transform_point_upscaled(&tr_dsc, dest_area->x1, dest_area->y1 + y, &xs1_ups, &ys1_ups);
         transform_point_upscaled(&tr_dsc, dest_area->x2, dest_area->y1 + y, &xs2_ups, &ys2_ups);
 
+        /*Without rotation only the Y coordinate depends on the row. If it's the same source row as in the
+         *previous row (e.g. in every 2nd row with 2x zoom) the previous row can be just copied.*/
+        if(tr_dsc.angle == 0 && draw_dsc->antialias == 0) {
+            int32_t ys = ys1_ups >> 8;
+            if(ys == ys_prev) {
+                lv_memcpy(cbuf, cbuf - dest_w, dest_w * sizeof(lv_color_t));
+                lv_memcpy(abuf, abuf - dest_w, dest_w);
+                cbuf += dest_w;
+                abuf += dest_w;
+                continue;
+            }
+            ys_prev = ys;
+        }
+
         int32_t xs_diff = xs2_ups - xs1_ups;
         int32_t ys_diff = ys2_ups - ys1_ups;
         int32_t xs_step_256 = 0;
@@ -145,6 +200,9 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
                     rgb565a8_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
                     break;
 #endif
+                case LV_IMG_CF_ALPHA_8BIT:
+                    a8_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, abuf);
+                    break;
                 default:
                     break;
             }
@@ -169,46 +227,254 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
  *   STATIC FUNCTIONS
  **********************/
 
+static void transform_90(const lv_area_t * dest_area, const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h,
+                         lv_coord_t src_stride, int32_t angle, lv_point_t pivot, lv_img_cf_t cf,
+                         lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    angle = angle % 3600;
+    if(angle < 0) angle += 3600;
+
+    /*The source coordinates of the first pixel of the first row and their change
+     *in the next pixel (`xs_dx`, `ys_dx`) and in the next row (`xs_dy`, `ys_dy`)*/
+    int32_t dx = dest_area->x1 - pivot.x;
+    int32_t dy = dest_area->y1 - pivot.y;
+    int32_t xs0, ys0, xs_dx, ys_dx, xs_dy, ys_dy;
+    switch(angle) {
+        case 900:
+            xs0 = dy;
+            ys0 = -dx;
+            xs_dx = 0;
+            ys_dx = -1;
+            xs_dy = 1;
+            ys_dy = 0;
+            break;
+        case 1800:
+            xs0 = -dx;
+            ys0 = -dy;
+            xs_dx = -1;
+            ys_dx = 0;
+            xs_dy = 0;
+            ys_dy = -1;
+            break;
+        case 2700:
+            xs0 = -dy;
+            ys0 = dx;
+            xs_dx = 0;
+            ys_dx = 1;
+            xs_dy = -1;
+            ys_dy = 0;
+            break;
+        default:
+            xs0 = dx;
+            ys0 = dy;
+            xs_dx = 1;
+            ys_dx = 0;
+            xs_dy = 0;
+            ys_dy = 1;
+            break;
+    }
+    xs0 += pivot.x;
+    ys0 += pivot.y;
+
+    int32_t px_size;
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+            break;
+        case LV_IMG_CF_ALPHA_8BIT:
+            px_size = 1;
+            break;
+        default:
+            px_size = sizeof(lv_color_t);
+            break;
+    }
+
+    lv_disp_t * d = _lv_refr_get_disp_refreshing();
+    lv_color_t ck = d->driver->color_chroma_key;
+
+    lv_coord_t dest_w = lv_area_get_width(dest_area);
+    lv_coord_t dest_h = lv_area_get_height(dest_area);
+    int32_t step = xs_dx + ys_dx * src_stride;
+    lv_coord_t y;
+    for(y = 0; y < dest_h; y++) {
+        int32_t xs = xs0 + xs_dy * y;
+        int32_t ys = ys0 + ys_dy * y;
+
+        /*Find the range where the source pixels are on the image*/
+        int32_t x_start = 0;
+        int32_t x_end = dest_w;
+        if(xs_dx == 0) {
+            if(xs < 0 || xs >= src_w) x_end = 0;
+            else if(ys_dx > 0) {
+                x_start = LV_MAX(-ys, 0);
+                x_end = LV_MIN(src_h - ys, dest_w);
+            }
+            else {
+                x_start = LV_MAX(ys - src_h + 1, 0);
+                x_end = LV_MIN(ys + 1, dest_w);
+            }
+        }
+        else {
+            if(ys < 0 || ys >= src_h) x_end = 0;
+            else if(xs_dx > 0) {
+                x_start = LV_MAX(-xs, 0);
+                x_end = LV_MIN(src_w - xs, dest_w);
+            }
+            else {
+                x_start = LV_MAX(xs - src_w + 1, 0);
+                x_end = LV_MIN(xs + 1, dest_w);
+            }
+        }
+        if(x_start > dest_w) x_start = dest_w;
+        if(x_end < x_start) x_end = x_start;
+
+        lv_memzero(abuf, x_start);
+        lv_memzero(&abuf[x_end], dest_w - x_end);
+
+        int32_t i = (ys + ys_dx * x_start) * src_stride + xs + xs_dx * x_start;
+        const uint8_t * src_tmp = src + i * px_size;
+        lv_coord_t x;
+        switch(cf) {
+            case LV_IMG_CF_TRUE_COLOR_ALPHA:
+                for(x = x_start; x < x_end; x++) {
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+                    cbuf[x].full = src_tmp[0];
+#elif LV_COLOR_DEPTH == 16
+                    cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+                    cbuf[x].full = *((uint32_t *)src_tmp);
+#endif
+                    abuf[x] = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                    src_tmp += step * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                }
+                break;
+            case LV_IMG_CF_ALPHA_8BIT:
+                for(x = x_start; x < x_end; x++) {
+                    abuf[x] = src_tmp[0];
+                    src_tmp += step;
+                }
+                break;
+#if LV_COLOR_DEPTH == 16
+            case LV_IMG_CF_RGB565A8: {
+                    const lv_color_t * c_tmp = (const lv_color_t *)src_tmp;
+                    const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t) + i;
+                    for(x = x_start; x < x_end; x++) {
+                        cbuf[x] = *c_tmp;
+                        abuf[x] = *a_tmp;
+                        c_tmp += step;
+                        a_tmp += step;
+                    }
+                    break;
+                }
+#endif
+            default: {
+                    const lv_color_t * c_tmp = (const lv_color_t *)src_tmp;
+                    for(x = x_start; x < x_end; x++) {
+                        cbuf[x] = *c_tmp;
+                        abuf[x] = cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && c_tmp->full == ck.full ? 0x00 : 0xff;
+                        c_tmp += step;
+                    }
+                    break;
+                }
+        }
+
+        cbuf += dest_w;
+        abuf += dest_w;
+    }
+}
+
+/**
+ * Narrow the `[x_start, x_end)` range to the pixels where `min <= (v_ups + ((step * x) >> 8)) >> 8 <= max`,
+ * i.e. to where the source coordinate is in the `[min, max]` range.
+ * @param v_ups     upscaled source coordinate of the first pixel
+ * @param step      change of `v_ups` on a pixel upscaled by 256
+ * @param min       the smallest valid source coordinate
+ * @param max       the largest valid source coordinate
+ * @param x_start   start of the range, will be narrowed
+ * @param x_end     end of the range (exclusive), will be narrowed
+ */
+static void clip_range(int32_t v_ups, int32_t step, int32_t min, int32_t max, int32_t * x_start, int32_t * x_end)
+{
+    /*The source coordinate is monotonic so find where it enters and leaves the range with binary search*/
+    int32_t min_ups = min * 256;
+    int32_t max_ups = max * 256 + 255;
+    int32_t lo = *x_start;
+    int32_t hi = *x_end;
+    while(lo < hi) {
+        int32_t mid = (lo + hi) / 2;
+        int32_t v = v_ups + ((step * mid) >> 8);
+        if(step >= 0 ? v >= min_ups : v <= max_ups) hi = mid;
+        else lo = mid + 1;
+    }
+    *x_start = lo;
+
+    hi = *x_end;
+    while(lo < hi) {
+        int32_t mid = (lo + hi) / 2;
+        int32_t v = v_ups + ((step * mid) >> 8);
+        if(step >= 0 ? v > max_ups : v < min_ups) hi = mid;
+        else lo = mid + 1;
+    }
+    *x_end = lo;
+}
+
+/**
+ * Get the direction of the neighbor pixel to interpolate with and its weight
+ * @param v_ups     upscaled source coordinate
+ * @param next      -1 or 1: direction of the neighbor
+ * @param fract     weight of the neighbor in 0x00..0xFF range
+ */
+static inline void get_neighbor(int32_t v_ups, int32_t * next, int32_t * fract)
+{
+    int32_t f = v_ups & 0xFF;
+    if(f < 0x80) {
+        *next = -1;
+        *fract = (0x7F - f) * 2;
+    }
+    else {
+        *next = 1;
+        *fract = (f - 0x80) * 2;
+    }
+}
+
 static void rgb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                       int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
     lv_disp_t * d = _lv_refr_get_disp_refreshing();
     lv_color_t ck = d->driver->color_chroma_key;
 
-    lv_memset(abuf, 0xff, x_end);
+    /*Only the pixels in the range are on the image*/
+    int32_t x_in_start = 0;
+    int32_t x_in_end = x_end;
+    clip_range(xs_ups, xs_step, 0, src_w - 1, &x_in_start, &x_in_end);
+    clip_range(ys_ups, ys_step, 0, src_h - 1, &x_in_start, &x_in_end);
+    lv_memzero(abuf, x_in_start);
+    lv_memzero(&abuf[x_in_end], x_end - x_in_end);
 
+    int32_t xs_acc = xs_step * x_in_start;
+    int32_t ys_acc = ys_step * x_in_start;
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-        }
-        else {
+    for(x = x_in_start; x < x_in_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
 
 #if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-            const uint8_t * src_tmp = src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x].full = src_tmp[0];
+        const uint8_t * src_tmp = src;
+        src_tmp += ys_int * src_stride + xs_int;
+        cbuf[x].full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
+        const lv_color_t * src_tmp = (const lv_color_t *)src;
+        src_tmp += ys_int * src_stride + xs_int;
+        cbuf[x] = *src_tmp;
 #elif LV_COLOR_DEPTH == 32
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * sizeof(lv_color_t)) + xs_int * sizeof(lv_color_t);
-            cbuf[x].full = *((uint32_t *)src_tmp);
+        const uint8_t * src_tmp = src;
+        src_tmp += (ys_int * src_stride * sizeof(lv_color_t)) + xs_int * sizeof(lv_color_t);
+        cbuf[x].full = *((uint32_t *)src_tmp);
 #endif
-        }
-        if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && cbuf[x].full == ck.full) {
-            abuf[x] = 0x00;
-        }
+        abuf[x] = cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && cbuf[x].full == ck.full ? 0x00 : 0xff;
     }
 }
 
@@ -216,32 +482,33 @@ static void argb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h,
                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                        int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-
+    int32_t x_in_start = 0;
+    int32_t x_in_end = x_end;
+    clip_range(xs_ups, xs_step, 0, src_w - 1, &x_in_start, &x_in_end);
+    clip_range(ys_ups, ys_step, 0, src_h - 1, &x_in_start, &x_in_end);
+    lv_memzero(abuf, x_in_start);
+    lv_memzero(&abuf[x_in_end], x_end - x_in_end);
+
+    int32_t xs_acc = xs_step * x_in_start;
+    int32_t ys_acc = ys_step * x_in_start;
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = x_in_start; x < x_in_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
 
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0;
-        }
-        else {
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE) + xs_int * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        const uint8_t * src_tmp = src;
+        src_tmp += (ys_int * src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE) + xs_int * LV_IMG_PX_SIZE_ALPHA_BYTE;
 
 #if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-            cbuf[x].full = src_tmp[0];
+        cbuf[x].full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
-            cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
+        cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-            cbuf[x].full = *((uint32_t *)src_tmp);
+        cbuf[x].full = *((uint32_t *)src_tmp);
 #endif
-            abuf[x] = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-        }
+        abuf[x] = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
     }
 }
 
@@ -250,53 +517,302 @@ static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src
                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
+    int32_t x_in_start = 0;
+    int32_t x_in_end = x_end;
+    clip_range(xs_ups, xs_step, 0, src_w - 1, &x_in_start, &x_in_end);
+    clip_range(ys_ups, ys_step, 0, src_h - 1, &x_in_start, &x_in_end);
+    lv_memzero(abuf, x_in_start);
+    lv_memzero(&abuf[x_in_end], x_end - x_in_end);
+
+    const lv_opa_t * src_a = src + src_stride * src_h * sizeof(lv_color_t);
+    int32_t xs_acc = xs_step * x_in_start;
+    int32_t ys_acc = ys_step * x_in_start;
+    lv_coord_t x;
+    for(x = x_in_start; x < x_in_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t i = ys_int * src_stride + xs_int;
+        cbuf[x] = ((const lv_color_t *)src)[i];
+        abuf[x] = src_a[i];
+    }
+}
+#endif
 
+static void a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                     int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                     int32_t x_end, uint8_t * abuf)
+{
+    int32_t x_in_start = 0;
+    int32_t x_in_end = x_end;
+    clip_range(xs_ups, xs_step, 0, src_w - 1, &x_in_start, &x_in_end);
+    clip_range(ys_ups, ys_step, 0, src_h - 1, &x_in_start, &x_in_end);
+    lv_memzero(abuf, x_in_start);
+    lv_memzero(&abuf[x_in_end], x_end - x_in_end);
+
+    int32_t xs_acc = xs_step * x_in_start;
+    int32_t ys_acc = ys_step * x_in_start;
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = x_in_start; x < x_in_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
 
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0;
-        }
-        else {
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
+        abuf[x] = src[ys_int * src_stride + xs_int];
+    }
+}
+
+static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
+{
+    /*In the inner range all the neighbor pixels are on the image, so no checks are required there*/
+    int32_t x_in_start = 0;
+    int32_t x_in_end = x_end;
+    clip_range(xs_ups, xs_step, 1, src_w - 2, &x_in_start, &x_in_end);
+    clip_range(ys_ups, ys_step, 1, src_h - 2, &x_in_start, &x_in_end);
+
+    argb_and_rgb_aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, 0, x_in_start, cbuf, abuf, cf);
+    argb_and_rgb_aa_inner(src, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_in_start, x_in_end, cbuf, abuf, cf);
+    argb_and_rgb_aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_in_end, x_end, cbuf, abuf, cf);
+}
 
+/**
+ * Interpolate a pixel from the base pixel and its horizontal and vertical neighbors.
+ * All 3 pixels need to be on the image.
+ */
+static inline void argb_and_rgb_aa_px(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                                      int32_t xs_int, int32_t ys_int, int32_t x_next, int32_t y_next,
+                                      int32_t xs_fract, int32_t ys_fract, lv_img_cf_t cf, int32_t px_size,
+                                      lv_color_t ck, lv_color_t * cbuf, uint8_t * abuf)
+{
+    LV_UNUSED(src_h);
+
+    const uint8_t * px_base = src + (ys_int * src_stride * px_size) + xs_int * px_size;
+    const uint8_t * px_hor = px_base + x_next * px_size;
+    const uint8_t * px_ver = px_base + y_next * src_stride * px_size;
+    lv_color_t c_base;
+    lv_color_t c_ver;
+    lv_color_t c_hor;
+
+    if(cf != LV_IMG_CF_TRUE_COLOR) {
+        lv_opa_t a_base;
+        lv_opa_t a_ver;
+        lv_opa_t a_hor;
+        if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+            a_base = px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            a_ver = px_ver[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            a_hor = px_hor[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        }
+#if LV_COLOR_DEPTH == 16
+        else if(cf == LV_IMG_CF_RGB565A8) {
             const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-            a_tmp += ys_int * src_stride + xs_int;
-            abuf[x] = *a_tmp;
+            a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
+            a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
+            a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
         }
+#endif
+        else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+            if(((lv_color_t *)px_base)->full == ck.full ||
+               ((lv_color_t *)px_ver)->full == ck.full ||
+               ((lv_color_t *)px_hor)->full == ck.full) {
+                *abuf = 0x00;
+                return;
+            }
+            else {
+                a_base = 0xff;
+                a_ver = 0xff;
+                a_hor = 0xff;
+            }
+        }
+        else {
+            a_base = 0xff;
+            a_ver = 0xff;
+            a_hor = 0xff;
+        }
+
+        if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
+        if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
+        *abuf = (a_ver + a_hor) >> 1;
+
+        if(*abuf == 0x00) return;
+
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+        c_base.full = px_base[0];
+        c_ver.full = px_ver[0];
+        c_hor.full = px_hor[0];
+#elif LV_COLOR_DEPTH == 16
+        c_base.full = px_base[0] + (px_base[1] << 8);
+        c_ver.full = px_ver[0] + (px_ver[1] << 8);
+        c_hor.full = px_hor[0] + (px_hor[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+        c_base.full = *((uint32_t *)px_base);
+        c_ver.full = *((uint32_t *)px_ver);
+        c_hor.full = *((uint32_t *)px_hor);
+#endif
+    }
+    /*No alpha channel -> RGB*/
+    else {
+        c_base = *((const lv_color_t *) px_base);
+        c_hor = *((const lv_color_t *) px_hor);
+        c_ver = *((const lv_color_t *) px_ver);
+        *abuf = 0xff;
+    }
+
+    if(c_base.full == c_ver.full && c_base.full == c_hor.full) {
+        *cbuf = c_base;
+    }
+    else {
+        c_ver = lv_color_mix(c_ver, c_base, ys_fract);
+        c_hor = lv_color_mix(c_hor, c_base, xs_fract);
+        *cbuf = lv_color_mix(c_hor, c_ver, LV_OPA_50);
     }
 }
+
+#if TRANSFORM_SIMD
+/**
+ * The same as `lv_color_mix` but on 4 colors at once
+ */
+static inline vec_u32_t color_mix_4(vec_u32_t c1, vec_u32_t c2, vec_u32_t mix)
+{
+    vec_u32_t mix_inv = 255 - mix;
+    vec_u32_t r = ((((c1 >> 16) & 0xFF) * mix + ((c2 >> 16) & 0xFF) * mix_inv + LV_COLOR_MIX_ROUND_OFS) * 0x8081U) >> 0x17;
+    vec_u32_t g = ((((c1 >> 8) & 0xFF) * mix + ((c2 >> 8) & 0xFF) * mix_inv + LV_COLOR_MIX_ROUND_OFS) * 0x8081U) >> 0x17;
+    vec_u32_t b = (((c1 & 0xFF) * mix + (c2 & 0xFF) * mix_inv + LV_COLOR_MIX_ROUND_OFS) * 0x8081U) >> 0x17;
+    return 0xFF000000U | (r << 16) | (g << 8) | b;
+}
 #endif
 
+static void argb_and_rgb_aa_inner(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                  int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
+{
+    int32_t px_size;
+    lv_color_t ck = {0};
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+            px_size = sizeof(lv_color_t);
+            break;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+            break;
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
+                px_size = sizeof(lv_color_t);
+                lv_disp_t * d = _lv_refr_get_disp_refreshing();
+                ck = d->driver->color_chroma_key;
+                break;
+            }
+#if LV_COLOR_DEPTH == 16
+        case LV_IMG_CF_RGB565A8:
+            px_size = sizeof(lv_color_t);
+            break;
+#endif
+        default:
+            return;
+    }
 
-static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+    int32_t x = x_start;
+
+#if TRANSFORM_SIMD
+    /*Gather the 3 pixels of 4 destination pixels and interpolate them at once*/
+    const uint32_t * src32 = (const uint32_t *)src;
+    const vec_u32_t opa_cover = {LV_OPA_COVER, LV_OPA_COVER, LV_OPA_COVER, LV_OPA_COVER};
+    const vec_u32_t opa_50 = {LV_OPA_50, LV_OPA_50, LV_OPA_50, LV_OPA_50};
+    vec_i32_t xs_acc_v = {xs_acc, xs_acc + xs_step, xs_acc + 2 * xs_step, xs_acc + 3 * xs_step};
+    vec_i32_t ys_acc_v = {ys_acc, ys_acc + ys_step, ys_acc + 2 * ys_step, ys_acc + 3 * ys_step};
+    for(; x + 4 <= x_end; x += 4) {
+        vec_i32_t xs_cur = xs_ups + (xs_acc_v >> 8);
+        vec_i32_t ys_cur = ys_ups + (ys_acc_v >> 8);
+        xs_acc_v += 4 * xs_step;
+        ys_acc_v += 4 * ys_step;
+        xs_acc += 4 * xs_step;
+        ys_acc += 4 * ys_step;
+
+        /*The same as `get_neighbor` but on 4 pixels at once.
+         *`x_prev` and `y_prev` are -1 where the previous pixel is the neighbor and 0 where the next*/
+        vec_i32_t xf = xs_cur & 0xFF;
+        vec_i32_t yf = ys_cur & 0xFF;
+        vec_i32_t x_prev = xf < 0x80;
+        vec_i32_t y_prev = yf < 0x80;
+        vec_u32_t xs_fract = (vec_u32_t)((((0x7F - xf) & x_prev) | ((xf - 0x80) & ~x_prev)) * 2);
+        vec_u32_t ys_fract = (vec_u32_t)((((0x7F - yf) & y_prev) | ((yf - 0x80) & ~y_prev)) * 2);
+        vec_i32_t i_base = (ys_cur >> 8) * src_stride + (xs_cur >> 8);
+        vec_i32_t i_hor = i_base + (x_prev | 1);
+        vec_i32_t i_ver = i_base + ((-src_stride & y_prev) | (src_stride & ~y_prev));
+
+        vec_u32_t c_base = {src32[i_base[0]], src32[i_base[1]], src32[i_base[2]], src32[i_base[3]]};
+        vec_u32_t c_hor = {src32[i_hor[0]], src32[i_hor[1]], src32[i_hor[2]], src32[i_hor[3]]};
+        vec_u32_t c_ver = {src32[i_ver[0]], src32[i_ver[1]], src32[i_ver[2]], src32[i_ver[3]]};
+
+        vec_u32_t a;
+        if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+            vec_u32_t a_base = c_base >> 24;
+            vec_u32_t a_ver = ((c_ver >> 24) * ys_fract + a_base * (0x100 - ys_fract)) >> 8;
+            vec_u32_t a_hor = ((c_hor >> 24) * xs_fract + a_base * (0x100 - xs_fract)) >> 8;
+            a = (a_ver + a_hor) >> 1;
+        }
+        else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+            vec_u32_t keyed = (vec_u32_t)(c_base == ck.full) | (vec_u32_t)(c_ver == ck.full) |
+                              (vec_u32_t)(c_hor == ck.full);
+            a = ~keyed & 0xFF;
+        }
+        else {
+            a = opa_cover;
+        }
+
+        /*Keep the original color where all 3 pixels are the same*/
+        vec_u32_t same = (vec_u32_t)(c_base == c_ver) & (vec_u32_t)(c_base == c_hor);
+        vec_u32_t c_ver_mix = color_mix_4(c_ver, c_base, ys_fract);
+        vec_u32_t c_hor_mix = color_mix_4(c_hor, c_base, xs_fract);
+        vec_u32_t c = color_mix_4(c_hor_mix, c_ver_mix, opa_50);
+        c = (c_base & same) | (c & ~same);
+
+        int32_t i;
+        for(i = 0; i < 4; i++) {
+            cbuf[x + i].full = c[i];
+            abuf[x + i] = a[i];
+        }
+    }
+#endif
+
+    for(; x < x_end; x++) {
+        int32_t xs_cur = xs_ups + (xs_acc >> 8);
+        int32_t ys_cur = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t x_next;
+        int32_t y_next;
+        int32_t xs_fract;
+        int32_t ys_fract;
+        get_neighbor(xs_cur, &x_next, &xs_fract);
+        get_neighbor(ys_cur, &y_next, &ys_fract);
+        argb_and_rgb_aa_px(src, src_h, src_stride, xs_cur >> 8, ys_cur >> 8, x_next, y_next, xs_fract, ys_fract,
+                           cf, px_size, ck, &cbuf[x], &abuf[x]);
+    }
+}
+
+static void argb_and_rgb_aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                                 int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                 int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
-    bool has_alpha;
     int32_t px_size;
     lv_color_t ck = {0};
     switch(cf) {
         case LV_IMG_CF_TRUE_COLOR:
-            has_alpha = false;
             px_size = sizeof(lv_color_t);
             break;
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
-            has_alpha = true;
             px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
             break;
         case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
-                has_alpha = true;
                 px_size = sizeof(lv_color_t);
                 lv_disp_t * d = _lv_refr_get_disp_refreshing();
                 ck = d->driver->color_chroma_key;
@@ -304,7 +820,6 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
             }
 #if LV_COLOR_DEPTH == 16
         case LV_IMG_CF_RGB565A8:
-            has_alpha = true;
             px_size = sizeof(lv_color_t);
             break;
 #endif
@@ -313,7 +828,7 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
     }
 
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -328,119 +843,24 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
 
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
+        int32_t xs_fract;
+        int32_t ys_fract;
         int32_t x_next;
         int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
-        }
-        else {
-            x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
-        }
-        else {
-            y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
-        }
-
-        const uint8_t * src_tmp = src;
-        src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
-
+        get_neighbor(xs_ups, &x_next, &xs_fract);
+        get_neighbor(ys_ups, &y_next, &ys_fract);
 
         if(xs_int + x_next >= 0 &&
            xs_int + x_next <= src_w - 1 &&
            ys_int + y_next >= 0 &&
            ys_int + y_next <= src_h - 1) {
-
-            const uint8_t * px_base = src_tmp;
-            const uint8_t * px_hor = src_tmp + x_next * px_size;
-            const uint8_t * px_ver = src_tmp + y_next * src_stride * px_size;
-            lv_color_t c_base;
-            lv_color_t c_ver;
-            lv_color_t c_hor;
-
-            if(has_alpha) {
-                lv_opa_t a_base;
-                lv_opa_t a_ver;
-                lv_opa_t a_hor;
-                if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
-                    a_base = px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    a_ver = px_ver[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    a_hor = px_hor[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                }
-#if LV_COLOR_DEPTH == 16
-                else if(cf == LV_IMG_CF_RGB565A8) {
-                    const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-                    a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
-                    a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
-                    a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
-                }
-#endif
-                else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
-                    if(((lv_color_t *)px_base)->full == ck.full ||
-                       ((lv_color_t *)px_ver)->full == ck.full ||
-                       ((lv_color_t *)px_hor)->full == ck.full) {
-                        abuf[x] = 0x00;
-                        continue;
-                    }
-                    else {
-                        a_base = 0xff;
-                        a_ver = 0xff;
-                        a_hor = 0xff;
-                    }
-                }
-                else {
-                    a_base = 0xff;
-                    a_ver = 0xff;
-                    a_hor = 0xff;
-                }
-
-                if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
-                if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
-                abuf[x] = (a_ver + a_hor) >> 1;
-
-                if(abuf[x] == 0x00) continue;
-
-#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-                c_base.full = px_base[0];
-                c_ver.full = px_ver[0];
-                c_hor.full = px_hor[0];
-#elif LV_COLOR_DEPTH == 16
-                c_base.full = px_base[0] + (px_base[1] << 8);
-                c_ver.full = px_ver[0] + (px_ver[1] << 8);
-                c_hor.full = px_hor[0] + (px_hor[1] << 8);
-#elif LV_COLOR_DEPTH == 32
-                c_base.full = *((uint32_t *)px_base);
-                c_ver.full = *((uint32_t *)px_ver);
-                c_hor.full = *((uint32_t *)px_hor);
-#endif
-            }
-            /*No alpha channel -> RGB*/
-            else {
-                c_base = *((const lv_color_t *) px_base);
-                c_hor = *((const lv_color_t *) px_hor);
-                c_ver = *((const lv_color_t *) px_ver);
-                abuf[x] = 0xff;
-            }
-
-            if(c_base.full == c_ver.full && c_base.full == c_hor.full) {
-                cbuf[x] = c_base;
-            }
-            else {
-                c_ver = lv_color_mix(c_ver, c_base, ys_fract);
-                c_hor = lv_color_mix(c_hor, c_base, xs_fract);
-                cbuf[x] = lv_color_mix(c_hor, c_ver, LV_OPA_50);
-            }
+            argb_and_rgb_aa_px(src, src_h, src_stride, xs_int, ys_int, x_next, y_next, xs_fract, ys_fract,
+                               cf, px_size, ck, &cbuf[x], &abuf[x]);
         }
         /*Partially out of the image*/
         else {
+            const uint8_t * src_tmp = src;
+            src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
 #if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
             cbuf[x].full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
@@ -481,12 +901,53 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
 static void a8_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                   int32_t x_end, uint8_t * abuf)
+{
+    /*In the inner range all the neighbor pixels are on the image, so no checks are required there*/
+    int32_t x_in_start = 0;
+    int32_t x_in_end = x_end;
+    clip_range(xs_ups, xs_step, 1, src_w - 2, &x_in_start, &x_in_end);
+    clip_range(ys_ups, ys_step, 1, src_h - 2, &x_in_start, &x_in_end);
+
+    a8_aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, 0, x_in_start, abuf);
+
+    int32_t xs_acc = xs_step * x_in_start;
+    int32_t ys_acc = ys_step * x_in_start;
+    lv_coord_t x;
+    for(x = x_in_start; x < x_in_end; x++) {
+        int32_t xs_cur = xs_ups + (xs_acc >> 8);
+        int32_t ys_cur = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t x_next;
+        int32_t y_next;
+        int32_t xs_fract;
+        int32_t ys_fract;
+        get_neighbor(xs_cur, &x_next, &xs_fract);
+        get_neighbor(ys_cur, &y_next, &ys_fract);
+
+        const uint8_t * src_tmp = src + (ys_cur >> 8) * src_stride + (xs_cur >> 8);
+        lv_opa_t a_base = src_tmp[0];
+        lv_opa_t a_ver = src_tmp[x_next];
+        lv_opa_t a_hor = src_tmp[y_next * src_stride];
+
+        if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
+        if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
+        abuf[x] = (a_ver + a_hor) >> 1;
+    }
+
+    a8_aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_in_end, x_end, abuf);
+}
+
+static void a8_aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                       int32_t x_start, int32_t x_end, uint8_t * abuf)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
 
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -501,27 +962,12 @@ static void a8_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_co
 
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
+        int32_t xs_fract;
+        int32_t ys_fract;
         int32_t x_next;
         int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
-        }
-        else {
-            x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
-        }
-        else {
-            y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
-        }
+        get_neighbor(xs_ups, &x_next, &xs_fract);
+        get_neighbor(ys_ups, &y_next, &ys_fract);
 
         const uint8_t * src_tmp = src;
         src_tmp += ys_int * src_stride + xs_int;
@@ -117,6 +117,9 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+        /*A new font might be loaded to the same address*/
+        lv_txt_layout_cache_clear();
+
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
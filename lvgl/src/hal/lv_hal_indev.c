@@ -13,6 +13,7 @@
 #include "../core/lv_indev.h"
 #include "../misc/lv_mem.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_profiler.h"
 #include "lv_hal_disp.h"
 
 /*********************
@@ -183,7 +184,9 @@ void _lv_indev_read(lv_indev_t * indev, lv_indev_data_t * data)
 
     if(indev->driver->read_cb) {
         INDEV_TRACE("calling indev_read_cb");
+        LV_PROFILER_BEGIN_TAG("indev_read");
         indev->driver->read_cb(indev->driver, data);
+        LV_PROFILER_END_TAG("indev_read");
     }
     else {
         LV_LOG_WARN("indev_read_cb is not registered");
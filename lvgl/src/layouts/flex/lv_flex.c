@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_flex.h"
+#include <string.h>
 
 #if LV_USE_FLEX
 
@@ -45,6 +46,50 @@ typedef struct {
     uint32_t grow_dsc_calc : 1;
 } track_t;
 
+#if LV_USE_LAYOUT_CACHE
+/*Everything of the container which is used by the layout*/
+typedef struct {
+    lv_flex_flow_t flow;
+    lv_flex_align_t main_place;
+    lv_flex_align_t cross_place;
+    lv_flex_align_t track_place;
+    lv_flex_align_t track_cross_place;
+    lv_coord_t track_gap;
+    lv_coord_t item_gap;
+    lv_coord_t max_main_size;
+    lv_coord_t max_cross_size;
+    lv_coord_t abs_x;
+    lv_coord_t abs_y;
+    lv_coord_t w_set;
+    lv_coord_t h_set;
+    bool rtl;
+} flex_cache_key_t;
+
+/*A child after the last update*/
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t coords;
+    lv_obj_flag_t flags;
+} flex_cache_item_t;
+
+/*A track after the last update*/
+typedef struct {
+    int32_t first_item;
+    int32_t next_first_item;
+    lv_coord_t track_cross_size;
+    lv_coord_t cross_pos;
+} flex_cache_track_t;
+
+/*Stored as the layout cache of the container followed by `cap` items and `cap` tracks*/
+typedef struct {
+    uint32_t layout;
+    flex_cache_key_t key;
+    uint32_t cap;
+    uint32_t item_cnt;
+    uint32_t track_cnt;
+} flex_cache_t;
+#endif
+
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -61,6 +106,14 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 static void place_content(lv_flex_align_t place, lv_coord_t max_size, lv_coord_t content_size, lv_coord_t item_cnt,
                           lv_coord_t * start_pos, lv_coord_t * gap);
 static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id);
+#if LV_USE_LAYOUT_CACHE
+static flex_cache_t * cache_get(lv_obj_t * cont, const flex_cache_key_t * key);
+static const flex_cache_track_t * cache_get_track(lv_obj_t * cont, flex_cache_t * cache, flex_t * f, uint32_t track_id,
+                                                  int32_t first_item, const lv_coord_t * cross_pos);
+static void cache_set_track(flex_cache_t * cache, uint32_t track_id, int32_t first_item, int32_t next_first_item,
+                            lv_coord_t track_cross_size, lv_coord_t cross_pos);
+static void cache_set_items(lv_obj_t * cont, flex_cache_t * cache, uint32_t track_cnt);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -101,6 +154,7 @@ void lv_flex_init(void)
     LV_STYLE_FLEX_MAIN_PLACE = lv_style_register_prop(LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
     LV_STYLE_FLEX_CROSS_PLACE = lv_style_register_prop(LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
     LV_STYLE_FLEX_TRACK_PLACE = lv_style_register_prop(LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
+    LV_STYLE_FLEX_GROW = lv_style_register_prop(LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
 }
 
 void lv_obj_set_flex_flow(lv_obj_t * obj, lv_flex_flow_t flow)
@@ -253,6 +307,30 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         else if(track_cross_place == LV_FLEX_ALIGN_END) track_cross_place = LV_FLEX_ALIGN_START;
     }
 
+    lv_coord_t max_cross_size = (f.row ? lv_obj_get_content_height(cont) : lv_obj_get_content_width(cont));
+
+#if LV_USE_LAYOUT_CACHE
+    /*Tracks whose children have the same size as last time can be reused*/
+    flex_cache_key_t key;
+    lv_memzero(&key, sizeof(key));
+    key.flow = flow;
+    key.main_place = f.main_place;
+    key.cross_place = f.cross_place;
+    key.track_place = f.track_place;
+    key.track_cross_place = track_cross_place;
+    key.track_gap = track_gap;
+    key.item_gap = item_gap;
+    key.max_main_size = max_main_size;
+    key.max_cross_size = max_cross_size;
+    key.abs_x = abs_x;
+    key.abs_y = abs_y;
+    key.w_set = w_set;
+    key.h_set = h_set;
+    key.rtl = rtl;
+    flex_cache_t * cache = cache_get(cont, &key);
+    const flex_cache_track_t * ct;
+#endif
+
     lv_coord_t total_track_cross_size = 0;
     lv_coord_t gap = 0;
     uint32_t track_cnt = 0;
@@ -263,6 +341,15 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         track_first_item = f.rev ? cont->spec_attr->child_cnt - 1 : 0;
         track_t t;
         while(track_first_item < (int32_t)cont->spec_attr->child_cnt && track_first_item >= 0) {
+#if LV_USE_LAYOUT_CACHE
+            ct = cache_get_track(cont, cache, &f, track_cnt, track_first_item, NULL);
+            if(ct) {
+                total_track_cross_size += ct->track_cross_size + track_gap;
+                track_cnt++;
+                track_first_item = ct->next_first_item;
+                continue;
+            }
+#endif
             /*Search the first item of the next row*/
             t.grow_dsc_calc = 0;
             next_track_first_item = find_track_end(cont, &f, track_first_item, max_main_size, item_gap, &t);
@@ -274,7 +361,6 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         if(track_cnt) total_track_cross_size -= track_gap;   /*No gap after the last track*/
 
         /*Place the tracks to get the start position*/
-        lv_coord_t max_cross_size = (f.row ? lv_obj_get_content_height(cont) : lv_obj_get_content_width(cont));
         place_content(track_cross_place, max_cross_size, total_track_cross_size, track_cnt, cross_pos, &gap);
     }
 
@@ -284,19 +370,38 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         *cross_pos += total_track_cross_size;
     }
 
+    uint32_t track_id = 0;
     while(track_first_item < (int32_t)cont->spec_attr->child_cnt && track_first_item >= 0) {
         track_t t;
-        t.grow_dsc_calc = 1;
-        /*Search the first item of the next row*/
-        next_track_first_item = find_track_end(cont, &f, track_first_item, max_main_size, item_gap, &t);
+#if LV_USE_LAYOUT_CACHE
+        lv_coord_t track_cross_pos = *cross_pos;
+
+        /*If the children are already in the right place the track can be skipped*/
+        ct = cache_get_track(cont, cache, &f, track_id, track_first_item, cross_pos);
+        if(ct) {
+            t.track_cross_size = ct->track_cross_size;
+            next_track_first_item = ct->next_first_item;
+            if(rtl && !f.row) *cross_pos -= t.track_cross_size;
+        }
+        else
+#endif
+        {
+            t.grow_dsc_calc = 1;
+            /*Search the first item of the next row*/
+            next_track_first_item = find_track_end(cont, &f, track_first_item, max_main_size, item_gap, &t);
 
-        if(rtl && !f.row) {
-            *cross_pos -= t.track_cross_size;
+            if(rtl && !f.row) {
+                *cross_pos -= t.track_cross_size;
+            }
+            children_repos(cont, &f, track_first_item, next_track_first_item, abs_x, abs_y, max_main_size, item_gap, &t);
+            lv_free(t.grow_dsc);
+            t.grow_dsc = NULL;
         }
-        children_repos(cont, &f, track_first_item, next_track_first_item, abs_x, abs_y, max_main_size, item_gap, &t);
+#if LV_USE_LAYOUT_CACHE
+        cache_set_track(cache, track_id, track_first_item, next_track_first_item, t.track_cross_size, track_cross_pos);
+#endif
         track_first_item = next_track_first_item;
-        lv_free(t.grow_dsc);
-        t.grow_dsc = NULL;
+        track_id++;
         if(rtl && !f.row) {
             *cross_pos -= gap + track_gap;
         }
@@ -304,6 +409,9 @@ static void flex_update(lv_obj_t * cont, void * user_data)
             *cross_pos += t.track_cross_size + gap + track_gap;
         }
     }
+#if LV_USE_LAYOUT_CACHE
+    cache_set_items(cont, cache, track_id);
+#endif
     LV_ASSERT_MEM_INTEGRITY();
 
     if(w_set == LV_SIZE_CONTENT || h_set == LV_SIZE_CONTENT) {
@@ -597,4 +705,116 @@ static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id)
     }
 }
 
+#if LV_USE_LAYOUT_CACHE
+
+/**
+ * Get the cache of a container and reset it if the container has changed since the last update
+ */
+static flex_cache_t * cache_get(lv_obj_t * cont, const flex_cache_key_t * key)
+{
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
+    flex_cache_t * cache = _lv_obj_layout_cache_get(cont);
+    if(cache && (cache->layout != LV_LAYOUT_FLEX || cache->cap != child_cnt)) {
+        _lv_obj_layout_cache_invalidate(cont);
+        cache = NULL;
+    }
+
+    if(child_cnt < LV_LAYOUT_CACHE_MIN_CHILD_CNT) return NULL;
+
+    if(cache == NULL) {
+        cache = lv_malloc(sizeof(flex_cache_t) + child_cnt * (sizeof(flex_cache_item_t) + sizeof(flex_cache_track_t)));
+        if(cache == NULL) return NULL;
+        cache->layout = LV_LAYOUT_FLEX;
+        cache->cap = child_cnt;
+        cache->item_cnt = 0;
+        cache->track_cnt = 0;
+        _lv_obj_layout_cache_set(cont, cache);
+    }
+    else if(memcmp(&cache->key, key, sizeof(flex_cache_key_t)) != 0) {
+        cache->item_cnt = 0;
+        cache->track_cnt = 0;
+    }
+
+    cache->key = *key;
+    return cache;
+}
+
+/**
+ * Get a track of the last update if it starts with the same item and its children (and the first item of the next
+ * track which might have not fit) have the same size and flags.
+ * If `cross_pos` is not NULL the track needs to start at the same position and its children need to be
+ * in the same place too.
+ */
+static const flex_cache_track_t * cache_get_track(lv_obj_t * cont, flex_cache_t * cache, flex_t * f, uint32_t track_id,
+                                                  int32_t first_item, const lv_coord_t * cross_pos)
+{
+    if(cache == NULL || track_id >= cache->track_cnt) return NULL;
+
+    const flex_cache_item_t * items = (const flex_cache_item_t *)(cache + 1);
+    const flex_cache_track_t * track = (const flex_cache_track_t *)(items + cache->cap) + track_id;
+    if(track->first_item != first_item) return NULL;
+    if(cross_pos && track->cross_pos != *cross_pos) return NULL;
+
+    int32_t item_id = first_item;
+    while(item_id >= 0 && item_id < (int32_t)cont->spec_attr->child_cnt) {
+        if(item_id >= (int32_t)cache->item_cnt) return NULL;
+
+        const flex_cache_item_t * ci = &items[item_id];
+        lv_obj_t * item = cont->spec_attr->children[item_id];
+        if(ci->obj != item || ci->flags != item->flags) return NULL;
+
+        if(item_id == track->next_first_item) {
+            if(lv_area_get_width(&ci->coords) != lv_area_get_width(&item->coords)) return NULL;
+            if(lv_area_get_height(&ci->coords) != lv_area_get_height(&item->coords)) return NULL;
+            break;
+        }
+
+        if(cross_pos) {
+            if(!_lv_area_is_equal(&ci->coords, &item->coords)) return NULL;
+        }
+        else {
+            if(lv_area_get_width(&ci->coords) != lv_area_get_width(&item->coords)) return NULL;
+            if(lv_area_get_height(&ci->coords) != lv_area_get_height(&item->coords)) return NULL;
+        }
+
+        item_id += f->rev ? -1 : 1;
+    }
+
+    return track;
+}
+
+static void cache_set_track(flex_cache_t * cache, uint32_t track_id, int32_t first_item, int32_t next_first_item,
+                            lv_coord_t track_cross_size, lv_coord_t cross_pos)
+{
+    if(cache == NULL || track_id >= cache->cap) return;
+
+    flex_cache_item_t * items = (flex_cache_item_t *)(cache + 1);
+    flex_cache_track_t * track = (flex_cache_track_t *)(items + cache->cap) + track_id;
+    track->first_item = first_item;
+    track->next_first_item = next_first_item;
+    track->track_cross_size = track_cross_size;
+    track->cross_pos = cross_pos;
+}
+
+/**
+ * Save the children after the update
+ */
+static void cache_set_items(lv_obj_t * cont, flex_cache_t * cache, uint32_t track_cnt)
+{
+    if(cache == NULL) return;
+
+    flex_cache_item_t * items = (flex_cache_item_t *)(cache + 1);
+    uint32_t i;
+    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        items[i].obj = item;
+        items[i].coords = item->coords;
+        items[i].flags = item->flags;
+    }
+    cache->item_cnt = cont->spec_attr->child_cnt;
+    cache->track_cnt = LV_MIN(track_cnt, cache->cap);
+}
+
+#endif /*LV_USE_LAYOUT_CACHE*/
+
 #endif /*LV_USE_FLEX*/
@@ -40,6 +40,36 @@ typedef struct {
     lv_coord_t grid_h;
 } _lv_grid_calc_t;
 
+typedef struct {
+    uint8_t col_pos;
+    uint8_t col_span;
+    uint8_t row_pos;
+    uint8_t row_span;
+} cell_t;
+
+#if LV_USE_LAYOUT_CACHE
+/*A child after the last update*/
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t coords;
+    lv_obj_flag_t flags;
+    cell_t cell;
+} grid_cache_item_t;
+
+/*Stored as the layout cache of the container followed by `item_cap` items
+ *and the `x`, `w`, `y` and `h` arrays of the last calculation*/
+typedef struct {
+    uint32_t layout;
+    uint32_t item_cap;
+    uint32_t item_cnt;
+    uint32_t track_cap;
+    uint32_t col_num;
+    uint32_t row_num;
+    lv_point_t grid_abs;
+    uint32_t calc_valid : 1;
+} grid_cache_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -48,14 +78,20 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static void grid_update(lv_obj_t * cont, void * user_data);
-static void calc(lv_obj_t * obj, _lv_grid_calc_t * calc);
+static void calc(lv_obj_t * obj, const cell_t * cells, _lv_grid_calc_t * calc);
 static void calc_free(_lv_grid_calc_t * calc);
-static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c);
-static void calc_rows(lv_obj_t * cont, _lv_grid_calc_t * c);
-static void item_repos(lv_obj_t * item, _lv_grid_calc_t * c, item_repos_hint_t * hint);
+static void calc_cols(lv_obj_t * cont, const cell_t * cells, _lv_grid_calc_t * c);
+static void calc_rows(lv_obj_t * cont, const cell_t * cells, _lv_grid_calc_t * c);
+static void item_repos(lv_obj_t * item, const cell_t * cell, _lv_grid_calc_t * c, item_repos_hint_t * hint);
 static lv_coord_t grid_align(lv_coord_t cont_size,  bool auto_size, uint8_t align, lv_coord_t gap, uint32_t track_num,
                              lv_coord_t * size_array, lv_coord_t * pos_array, bool reverse);
 static uint32_t count_tracks(const lv_coord_t * templ);
+static void get_cells(lv_obj_t * cont, cell_t * cells);
+#if LV_USE_LAYOUT_CACHE
+static grid_cache_t * cache_get(lv_obj_t * cont, const lv_point_t * grid_abs);
+static bool cache_item_is_placed(lv_obj_t * cont, grid_cache_t * cache, uint32_t item_id, _lv_grid_calc_t * c);
+static void cache_set(lv_obj_t * cont, grid_cache_t * cache, const cell_t * cells, _lv_grid_calc_t * c);
+#endif
 
 static inline const lv_coord_t * get_col_dsc(lv_obj_t * obj)
 {
@@ -354,9 +390,6 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     const lv_coord_t * row_templ = get_row_dsc(cont);
     if(col_templ == NULL || row_templ == NULL) return;
 
-    _lv_grid_calc_t c;
-    calc(cont, &c);
-
     item_repos_hint_t hint;
     lv_memzero(&hint, sizeof(hint));
 
@@ -368,12 +401,34 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     hint.grid_abs.x = pad_left + cont->coords.x1 - lv_obj_get_scroll_x(cont);
     hint.grid_abs.y = pad_top + cont->coords.y1 - lv_obj_get_scroll_y(cont);
 
+#if LV_USE_LAYOUT_CACHE
+    grid_cache_t * cache = cache_get(cont, &hint.grid_abs);
+#endif
+
+    /*Get the cell of the children only once*/
+    cell_t * cells = lv_malloc(sizeof(cell_t) * cont->spec_attr->child_cnt);
+    LV_ASSERT_MALLOC(cells);
+    if(cells == NULL) return;
+    get_cells(cont, cells);
+
+    _lv_grid_calc_t c;
+    calc(cont, cells, &c);
+
     uint32_t i;
     for(i = 0; i < cont->spec_attr->child_cnt; i++) {
         lv_obj_t * item = cont->spec_attr->children[i];
-        item_repos(item, &c, &hint);
+#if LV_USE_LAYOUT_CACHE
+        /*Children which are in the same place and whose tracks are the same as last time can be skipped*/
+        if(cache_item_is_placed(cont, cache, i, &c)) continue;
+#endif
+        item_repos(item, &cells[i], &c, &hint);
     }
+
+#if LV_USE_LAYOUT_CACHE
+    cache_set(cont, cache, cells, &c);
+#endif
     calc_free(&c);
+    lv_free(cells);
 
     lv_coord_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
     lv_coord_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
@@ -389,18 +444,19 @@ static void grid_update(lv_obj_t * cont, void * user_data)
 /**
  * Calculate the grid cells coordinates
  * @param cont an object that has a grid
+ * @param cells the cell of each child
  * @param calc store the calculated cells sizes here
  * @note `_lv_grid_calc_free(calc_out)` needs to be called when `calc_out` is not needed anymore
  */
-static void calc(lv_obj_t * cont, _lv_grid_calc_t * calc_out)
+static void calc(lv_obj_t * cont, const cell_t * cells, _lv_grid_calc_t * calc_out)
 {
     if(lv_obj_get_child(cont, 0) == NULL) {
         lv_memzero(calc_out, sizeof(_lv_grid_calc_t));
         return;
     }
 
-    calc_rows(cont, calc_out);
-    calc_cols(cont, calc_out);
+    calc_rows(cont, cells, calc_out);
+    calc_cols(cont, cells, calc_out);
 
     lv_coord_t col_gap = lv_obj_get_style_pad_column(cont, LV_PART_MAIN);
     lv_coord_t row_gap = lv_obj_get_style_pad_row(cont, LV_PART_MAIN);
@@ -434,7 +490,7 @@ static void calc_free(_lv_grid_calc_t * calc)
     lv_free(calc->h);
 }
 
-static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c)
+static void calc_cols(lv_obj_t * cont, const cell_t * cells, _lv_grid_calc_t * c)
 {
     const lv_coord_t * col_templ = get_col_dsc(cont);
     lv_coord_t cont_w = lv_obj_get_content_width(cont);
@@ -443,27 +499,19 @@ static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c)
     c->x = lv_malloc(sizeof(lv_coord_t) * c->col_num);
     c->w = lv_malloc(sizeof(lv_coord_t) * c->col_num);
 
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells by checking the size of the children in them*/
     uint32_t i;
-    for(i = 0; i < c->col_num; i++) {
-        lv_coord_t size = LV_COORD_MIN;
-        if(IS_CONTENT(col_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_cnt(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t col_span = get_col_span(item);
-                if(col_span != 1) continue;
-
-                uint32_t col_pos = get_col_pos(item);
-                if(col_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_width(item));
-            }
-            if(size >= 0) c->w[i] = size;
-            else c->w[i] = 0;
-        }
+    for(i = 0; i < c->col_num; i++) c->w[i] = 0;
+
+    for(i = 0; i < lv_obj_get_child_cnt(cont); i++) {
+        lv_obj_t * item = lv_obj_get_child(cont, i);
+        if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+        if(cells[i].col_span != 1) continue;
+
+        uint32_t col_pos = cells[i].col_pos;
+        if(col_pos >= c->col_num || !IS_CONTENT(col_templ[col_pos])) continue;
+
+        c->w[col_pos] = LV_MAX(c->w[col_pos], lv_obj_get_width(item));
     }
 
     uint32_t col_fr_cnt = 0;
@@ -506,33 +554,26 @@ static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c)
     }
 }
 
-static void calc_rows(lv_obj_t * cont, _lv_grid_calc_t * c)
+static void calc_rows(lv_obj_t * cont, const cell_t * cells, _lv_grid_calc_t * c)
 {
     uint32_t i;
     const lv_coord_t * row_templ = get_row_dsc(cont);
     c->row_num = count_tracks(row_templ);
     c->y = lv_malloc(sizeof(lv_coord_t) * c->row_num);
     c->h = lv_malloc(sizeof(lv_coord_t) * c->row_num);
-    /*Set sizes for CONTENT cells*/
-    for(i = 0; i < c->row_num; i++) {
-        lv_coord_t size = LV_COORD_MIN;
-        if(IS_CONTENT(row_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_cnt(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t row_span = get_row_span(item);
-                if(row_span != 1) continue;
-
-                uint32_t row_pos = get_row_pos(item);
-                if(row_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_height(item));
-            }
-            if(size >= 0) c->h[i] = size;
-            else c->h[i] = 0;
-        }
+
+    /*Set sizes for CONTENT cells by checking the size of the children in them*/
+    for(i = 0; i < c->row_num; i++) c->h[i] = 0;
+
+    for(i = 0; i < lv_obj_get_child_cnt(cont); i++) {
+        lv_obj_t * item = lv_obj_get_child(cont, i);
+        if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+        if(cells[i].row_span != 1) continue;
+
+        uint32_t row_pos = cells[i].row_pos;
+        if(row_pos >= c->row_num || !IS_CONTENT(row_templ[row_pos])) continue;
+
+        c->h[row_pos] = LV_MAX(c->h[row_pos], lv_obj_get_height(item));
     }
 
     uint32_t row_fr_cnt = 0;
@@ -579,19 +620,20 @@ static void calc_rows(lv_obj_t * cont, _lv_grid_calc_t * c)
 /**
  * Reposition a grid item in its cell
  * @param item a grid item to reposition
+ * @param cell the cell of the item
  * @param calc the calculated grid of `cont`
  * @param child_id_ext helper value if the ID of the child is know (order from the oldest) else -1
  * @param grid_abs helper value, the absolute position of the grid, NULL if unknown
  */
-static void item_repos(lv_obj_t * item, _lv_grid_calc_t * c, item_repos_hint_t * hint)
+static void item_repos(lv_obj_t * item, const cell_t * cell, _lv_grid_calc_t * c, item_repos_hint_t * hint)
 {
     if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) return;
-    uint32_t col_span = get_col_span(item);
-    uint32_t row_span = get_row_span(item);
+    uint32_t col_span = cell->col_span;
+    uint32_t row_span = cell->row_span;
     if(row_span == 0 || col_span == 0) return;
 
-    uint32_t col_pos = get_col_pos(item);
-    uint32_t row_pos = get_row_pos(item);
+    uint32_t col_pos = cell->col_pos;
+    uint32_t row_pos = cell->row_pos;
     lv_grid_align_t col_align = get_cell_col_align(item);
     lv_grid_align_t row_align = get_cell_row_align(item);
 
@@ -783,4 +825,131 @@ static uint32_t count_tracks(const lv_coord_t * templ)
 }
 
 
+/**
+ * Get the cell of all children of a container
+ */
+static void get_cells(lv_obj_t * cont, cell_t * cells)
+{
+#if LV_USE_LAYOUT_CACHE
+    /*The cells are cached until the style of the children changes*/
+    const grid_cache_t * cache = _lv_obj_layout_cache_get(cont);
+    const grid_cache_item_t * items = cache ? (const grid_cache_item_t *)(cache + 1) : NULL;
+#endif
+
+    uint32_t i;
+    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+#if LV_USE_LAYOUT_CACHE
+        if(cache && i < cache->item_cnt && items[i].obj == item) {
+            cells[i] = items[i].cell;
+            continue;
+        }
+#endif
+        cells[i].col_pos = get_col_pos(item);
+        cells[i].col_span = get_col_span(item);
+        cells[i].row_pos = get_row_pos(item);
+        cells[i].row_span = get_row_span(item);
+    }
+}
+
+#if LV_USE_LAYOUT_CACHE
+
+/**
+ * Get the cache of a container. The tracks of the last update are used only if the grid is in the same place
+ */
+static grid_cache_t * cache_get(lv_obj_t * cont, const lv_point_t * grid_abs)
+{
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
+    uint32_t col_num = count_tracks(get_col_dsc(cont));
+    uint32_t row_num = count_tracks(get_row_dsc(cont));
+
+    grid_cache_t * cache = _lv_obj_layout_cache_get(cont);
+    if(cache && (cache->layout != LV_LAYOUT_GRID || cache->item_cap != child_cnt ||
+                 cache->track_cap != col_num + row_num)) {
+        _lv_obj_layout_cache_invalidate(cont);
+        cache = NULL;
+    }
+
+    if(child_cnt < LV_LAYOUT_CACHE_MIN_CHILD_CNT) return NULL;
+
+    if(cache == NULL) {
+        cache = lv_malloc(sizeof(grid_cache_t) + child_cnt * sizeof(grid_cache_item_t) +
+                          (col_num + row_num) * 2 * sizeof(lv_coord_t));
+        if(cache == NULL) return NULL;
+        cache->layout = LV_LAYOUT_GRID;
+        cache->item_cap = child_cnt;
+        cache->item_cnt = 0;
+        cache->track_cap = col_num + row_num;
+        cache->calc_valid = 0;
+        _lv_obj_layout_cache_set(cont, cache);
+    }
+    else if(cache->col_num != col_num || cache->row_num != row_num ||
+            cache->grid_abs.x != grid_abs->x || cache->grid_abs.y != grid_abs->y) {
+        cache->calc_valid = 0;
+    }
+
+    cache->grid_abs = *grid_abs;
+    return cache;
+}
+
+/**
+ * Check if a child hasn't changed since the last update and its tracks are also the same
+ */
+static bool cache_item_is_placed(lv_obj_t * cont, grid_cache_t * cache, uint32_t item_id, _lv_grid_calc_t * c)
+{
+    if(cache == NULL || !cache->calc_valid || item_id >= cache->item_cnt) return false;
+
+    const grid_cache_item_t * ci = (const grid_cache_item_t *)(cache + 1) + item_id;
+    lv_obj_t * item = cont->spec_attr->children[item_id];
+    if(ci->obj != item || ci->flags != item->flags || !_lv_area_is_equal(&ci->coords, &item->coords)) return false;
+
+    const lv_coord_t * x = (const lv_coord_t *)((const grid_cache_item_t *)(cache + 1) + cache->item_cap);
+    const lv_coord_t * w = x + c->col_num;
+    const lv_coord_t * y = w + c->col_num;
+    const lv_coord_t * h = y + c->row_num;
+
+    uint32_t i;
+    uint32_t col_end = LV_MIN(ci->cell.col_pos + ci->cell.col_span, c->col_num);
+    for(i = ci->cell.col_pos; i < col_end; i++) {
+        if(x[i] != c->x[i] || w[i] != c->w[i]) return false;
+    }
+
+    uint32_t row_end = LV_MIN(ci->cell.row_pos + ci->cell.row_span, c->row_num);
+    for(i = ci->cell.row_pos; i < row_end; i++) {
+        if(y[i] != c->y[i] || h[i] != c->h[i]) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Save the children and the tracks after the update
+ */
+static void cache_set(lv_obj_t * cont, grid_cache_t * cache, const cell_t * cells, _lv_grid_calc_t * c)
+{
+    if(cache == NULL) return;
+
+    grid_cache_item_t * items = (grid_cache_item_t *)(cache + 1);
+    uint32_t i;
+    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        items[i].obj = item;
+        items[i].coords = item->coords;
+        items[i].flags = item->flags;
+        items[i].cell = cells[i];
+    }
+    cache->item_cnt = cont->spec_attr->child_cnt;
+
+    lv_coord_t * x = (lv_coord_t *)(items + cache->item_cap);
+    lv_memcpy(x, c->x, c->col_num * sizeof(lv_coord_t));
+    lv_memcpy(x + c->col_num, c->w, c->col_num * sizeof(lv_coord_t));
+    lv_memcpy(x + 2 * c->col_num, c->y, c->row_num * sizeof(lv_coord_t));
+    lv_memcpy(x + 2 * c->col_num + c->row_num, c->h, c->row_num * sizeof(lv_coord_t));
+    cache->col_num = c->col_num;
+    cache->row_num = c->row_num;
+    cache->calc_valid = 1;
+}
+
+#endif /*LV_USE_LAYOUT_CACHE*/
+
 #endif /*LV_USE_GRID*/
@@ -0,0 +1,330 @@
+/**
+ * @file lv_fs_mmap.c
+ *
+ */
+
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_FS_MMAP
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if LV_FS_MMAP_LETTER == '\0'
+    #error "LV_FS_MMAP_LETTER must be an upper case ASCII letter"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint8_t * data;     /*Start of the mapping. NULL for empty files*/
+    uint32_t size;      /*Size of the file in bytes*/
+    uint32_t pos;       /*Read position*/
+} mmap_file_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_get_buf(lv_fs_drv_t * drv, void * file_p, const void ** buf, uint32_t * size);
+static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn);
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register a read only driver which maps the files into the memory
+ */
+void lv_fs_mmap_init(void)
+{
+    /*---------------------------------------------------
+     * Register the file system interface in LVGL
+     *--------------------------------------------------*/
+
+    static lv_fs_drv_t fs_drv; /*A driver descriptor*/
+    lv_fs_drv_init(&fs_drv);
+
+    /*Set up fields...
+     *No cache is used as the data is already in the memory*/
+    fs_drv.letter = LV_FS_MMAP_LETTER;
+    fs_drv.cache_size = 0;
+
+    fs_drv.open_cb = fs_open;
+    fs_drv.close_cb = fs_close;
+    fs_drv.read_cb = fs_read;
+    fs_drv.seek_cb = fs_seek;
+    fs_drv.tell_cb = fs_tell;
+    fs_drv.get_buf_cb = fs_get_buf;
+
+    fs_drv.dir_close_cb = fs_dir_close;
+    fs_drv.dir_open_cb = fs_dir_open;
+    fs_drv.dir_read_cb = fs_dir_read;
+
+    lv_fs_drv_register(&fs_drv);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Open a file and map its content into the memory
+ * @param drv pointer to a driver where this function belongs
+ * @param path path to the file beginning with the driver letter (e.g. M:/folder/file.txt)
+ * @param mode only LV_FS_MODE_RD is supported
+ * @return a file handle or NULL in case of fail
+ */
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+
+    if(mode != LV_FS_MODE_RD) {
+        LV_LOG_WARN("only read mode is supported");
+        return NULL;
+    }
+
+    /*Make the path relative to the current directory (the projects root folder)*/
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_MMAP_PATH "%s", path);
+
+    int fd = open(buf, O_RDONLY);
+    if(fd < 0) return NULL;
+
+    struct stat st;
+    if(fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || (uint64_t)st.st_size > UINT32_MAX) {
+        close(fd);
+        return NULL;
+    }
+
+    mmap_file_t * f = lv_malloc(sizeof(mmap_file_t));
+    LV_ASSERT_MALLOC(f);
+    if(f == NULL) {
+        close(fd);
+        return NULL;
+    }
+
+    lv_memzero(f, sizeof(mmap_file_t));
+    f->size = (uint32_t)st.st_size;
+
+    /*Zero length mappings are not allowed*/
+    if(f->size > 0) {
+        void * p = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(p == MAP_FAILED) {
+            LV_LOG_WARN("couldn't map %s", buf);
+            lv_free(f);
+            close(fd);
+            return NULL;
+        }
+        f->data = p;
+
+        /*The images and fonts are mostly read from the beginning to the end*/
+        madvise(f->data, f->size, MADV_SEQUENTIAL);
+    }
+
+    /*The mapping remains valid after closing the descriptor*/
+    close(fd);
+
+    return f;
+}
+
+/**
+ * Close an opened file and unmap it
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle. (opened with fs_open)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    if(f->data) munmap(f->data, f->size);
+    lv_free(f);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Copy data from the mapped file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param buf pointer to a memory block where to store the read data
+ * @param btr number of Bytes To Read
+ * @param br the real number of read bytes (Byte Read)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+
+    uint32_t remaining = f->pos < f->size ? f->size - f->pos : 0;
+    if(btr > remaining) btr = remaining;
+    if(btr) lv_memcpy(buf, f->data + f->pos, btr);
+    f->pos += btr;
+    *br = btr;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read pointer. It can't be moved beyond the end of the file.
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable. (opened with fs_open )
+ * @param pos the new position of read pointer
+ * @param whence tells from where to interpret the `pos`. See @lv_fs_whence_t
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+
+    int64_t new_pos;
+    switch(whence) {
+        case LV_FS_SEEK_SET:
+            new_pos = pos;
+            break;
+        case LV_FS_SEEK_CUR:
+            new_pos = (int64_t)f->pos + (int32_t)pos;
+            break;
+        case LV_FS_SEEK_END:
+            new_pos = (int64_t)f->size + (int32_t)pos;
+            break;
+        default:
+            return LV_FS_RES_INV_PARAM;
+    }
+
+    if(new_pos < 0) return LV_FS_RES_INV_PARAM;
+    if(new_pos > f->size) new_pos = f->size;
+
+    f->pos = (uint32_t)new_pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the position of the read pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param pos_p pointer to to store the result
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    *pos_p = f->pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the mapped content of the file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param buf store the address of the first byte here
+ * @param size store the size of the file here
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_get_buf(lv_fs_drv_t * drv, void * file_p, const void ** buf, uint32_t * size)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    *buf = f->data;
+    *size = f->size;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Initialize a 'DIR' variable for directory reading
+ * @param drv pointer to a driver where this function belongs
+ * @param path path to a directory
+ * @return pointer to an initialized 'DIR' variable
+ */
+static void * fs_dir_open(lv_fs_drv_t * drv, const char * path)
+{
+    LV_UNUSED(drv);
+
+    /*Make the path relative to the current directory (the projects root folder)*/
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_MMAP_PATH "%s", path);
+    return opendir(buf);
+}
+
+/**
+ * Read the next filename from a directory.
+ * The name of the directories will begin with '/'
+ * @param drv pointer to a driver where this function belongs
+ * @param dir_p pointer to an initialized 'DIR' variable
+ * @param fn pointer to a buffer to store the filename
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn)
+{
+    LV_UNUSED(drv);
+
+    struct dirent * entry;
+    do {
+        entry = readdir(dir_p);
+        if(entry) {
+            if(entry->d_type == DT_DIR) sprintf(fn, "/%s", entry->d_name);
+            else strcpy(fn, entry->d_name);
+        }
+        else {
+            strcpy(fn, "");
+        }
+    } while(strcmp(fn, "/.") == 0 || strcmp(fn, "/..") == 0);
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Close the directory reading
+ * @param drv pointer to a driver where this function belongs
+ * @param dir_p pointer to an initialized 'DIR' variable
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p)
+{
+    LV_UNUSED(drv);
+    closedir(dir_p);
+    return LV_FS_RES_OK;
+}
+#else /*LV_USE_FS_MMAP == 0*/
+
+#if defined(LV_FS_MMAP_LETTER) && LV_FS_MMAP_LETTER != '\0'
+    #warning "LV_USE_FS_MMAP is not enabled but LV_FS_MMAP_LETTER is set"
+#endif
+
+#endif /*LV_USE_FS_MMAP*/
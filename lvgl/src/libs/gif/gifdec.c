@@ -568,17 +568,49 @@ dispose(gd_GIF * gif)
     }
 }
 
+/* Add the frame rectangle to the changed area of the canvas. */
+static void
+add_dirty_rect(gd_GIF * gif)
+{
+    int x1, y1, x2, y2;
+
+    if(gif->fw == 0 || gif->fh == 0 || gif->fx >= gif->width || gif->fy >= gif->height)
+        return;
+    x1 = gif->fx;
+    y1 = gif->fy;
+    x2 = MIN(gif->fx + gif->fw, gif->width);
+    y2 = MIN(gif->fy + gif->fh, gif->height);
+    if(gif->dw && gif->dh) {
+        x1 = MIN(x1, gif->dx);
+        y1 = MIN(y1, gif->dy);
+        x2 = MAX(x2, gif->dx + gif->dw);
+        y2 = MAX(y2, gif->dy + gif->dh);
+    }
+    gif->dx = x1;
+    gif->dy = y1;
+    gif->dw = x2 - x1;
+    gif->dh = y2 - y1;
+}
+
 /* Return 1 if got a frame; 0 if got GIF trailer; -1 if error. */
 int
 gd_get_frame(gd_GIF * gif)
 {
     char sep;
 
+    /* Only "restore to background" changes the canvas while disposing,
+     * the other methods keep (or redraw) the previous frame. */
+    gif->dw = gif->dh = 0;
+    if(gif->gce.disposal == 2)
+        add_dirty_rect(gif);
     dispose(gif);
     f_gif_read(gif, &sep, 1);
     while(sep != ',') {
-        if(sep == ';')
+        if(sep == ';') {
+            /* The current frame is rendered again. */
+            add_dirty_rect(gif);
             return 0;
+        }
         if(sep == '!')
             read_ext(gif);
         else return -1;
@@ -586,6 +618,7 @@ gd_get_frame(gd_GIF * gif)
     }
     if(read_image(gif) == -1)
         return -1;
+    add_dirty_rect(gif);
     return 1;
 }
 
@@ -41,6 +41,8 @@ typedef struct gd_GIF {
     void (*comment)(struct gd_GIF * gif);
     void (*application)(struct gd_GIF * gif, char id[8], char auth[3]);
     uint16_t fx, fy, fw, fh;
+    /* Area of the canvas changed by the last gd_get_frame() + gd_render_frame() */
+    uint16_t dx, dy, dw, dh;
     uint8_t bgindex;
     uint8_t * canvas, *frame;
 } gd_GIF;
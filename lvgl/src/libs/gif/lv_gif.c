@@ -19,7 +19,27 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_GIF_USE_PREDECODE
+typedef struct {
+    uint8_t * buf;          /*As large as the canvas but only `area` is valid*/
+    lv_area_t area;         /*Area changed compared to the previous frame*/
+    uint16_t delay;         /*Delay of the frame in 10 ms units*/
+    bool last;              /*The last repeat ended with this frame*/
+} predecode_frame_t;
 
+typedef struct _lv_gif_predecode_t {
+    gd_GIF * gif;           /*Used only by the worker thread while it's running*/
+    lv_thread_t thread;
+    lv_mutex_t mutex;       /*Protects the fields below*/
+    lv_thread_sync_t sync;  /*Wakes up the worker when a frame is consumed or it should stop*/
+    predecode_frame_t frames[LV_GIF_PREDECODE_FRAMES];
+    uint32_t rd;            /*Index of the next frame to show*/
+    uint32_t cnt;           /*Number of decoded but not shown frames*/
+    bool restart;
+    bool ended;
+    bool exit;
+} lv_gif_predecode_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -27,11 +47,24 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void close_gif(lv_gif_t * gifobj);
+static bool decode_next_frame(gd_GIF * gif);
+static bool get_dirty_area(gd_GIF * gif, lv_area_t * area);
+static void invalidate_img_area(lv_obj_t * obj, const lv_area_t * area);
+#if LV_GIF_USE_PREDECODE
+    static lv_gif_predecode_t * predecode_start(gd_GIF * gif);
+    static void predecode_stop(lv_gif_predecode_t * pd);
+    static void predecode_restart(lv_gif_predecode_t * pd);
+    static void predecode_thread_cb(void * user_data);
+    static void show_predecoded_frame(lv_obj_t * obj);
+    static void copy_area(uint8_t * dst, const uint8_t * src, const lv_area_t * area, uint16_t w);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_gif_class = {
+    .name = "gif",
     .constructor_cb = lv_gif_constructor,
     .destructor_cb = lv_gif_destructor,
     .instance_size = sizeof(lv_gif_t),
@@ -61,10 +94,7 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     /*Close previous gif if any*/
     if(gifobj->gif) {
-        lv_img_cache_invalidate_src(&gifobj->imgdsc);
-        gd_close_gif(gifobj->gif);
-        gifobj->gif = NULL;
-        gifobj->imgdsc.data = NULL;
+        close_gif(gifobj);
     }
 
     if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
@@ -86,18 +116,49 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     gifobj->imgdsc.header.w = gifobj->gif->width;
     gifobj->last_call = lv_tick_get();
 
+#if LV_GIF_USE_PREDECODE
+    /*Decode the first frame here to show it immediately and let the worker decode the rest.
+     *The widget shows its own copy of the canvas as the worker keeps updating the decoder's.*/
+    decode_next_frame(gifobj->gif);
+    gifobj->delay = gifobj->gif->gce.delay;
+    uint32_t canvas_size = (uint32_t)gifobj->gif->width * gifobj->gif->height * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t * canvas = lv_malloc(canvas_size);
+    LV_ASSERT_MALLOC(canvas);
+    if(canvas) {
+        lv_memcpy(canvas, gifobj->gif->canvas, canvas_size);
+        gifobj->predecode = predecode_start(gifobj->gif);
+        if(gifobj->predecode) gifobj->imgdsc.data = canvas;
+        else lv_free(canvas);
+    }
+
+    lv_img_set_src(obj, &gifobj->imgdsc);
+
+    lv_timer_resume(gifobj->timer);
+    lv_timer_reset(gifobj->timer);
+
+    if(gifobj->predecode == NULL) {
+        LV_LOG_WARN("Couldn't start pre-decoding, decoding the frames in the timer");
+    }
+#else
     lv_img_set_src(obj, &gifobj->imgdsc);
 
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 
     next_frame_task_cb(gifobj->timer);
+#endif
 
 }
 
 void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
+#if LV_GIF_USE_PREDECODE
+    if(gifobj->predecode) {
+        predecode_restart(gifobj->predecode);
+        return;
+    }
+#endif
     gd_rewind(gifobj->gif);
 }
 
@@ -119,8 +180,7 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
     LV_UNUSED(class_p);
     lv_gif_t * gifobj = (lv_gif_t *) obj;
-    lv_img_cache_invalidate_src(&gifobj->imgdsc);
-    gd_close_gif(gifobj->gif);
+    if(gifobj->gif) close_gif(gifobj);
     lv_timer_del(gifobj->timer);
 }
 
@@ -128,28 +188,280 @@ static void next_frame_task_cb(lv_timer_t * t)
 {
     lv_obj_t * obj = t->user_data;
     lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+#if LV_GIF_USE_PREDECODE
+    if(gifobj->predecode) {
+        show_predecoded_frame(obj);
+        return;
+    }
+#endif
+
     uint32_t elaps = lv_tick_elaps(gifobj->last_call);
     if(elaps < gifobj->gif->gce.delay * 10) return;
 
     gifobj->last_call = lv_tick_get();
 
-    int has_next = gd_get_frame(gifobj->gif);
-    if(has_next == 0) {
+    if(decode_next_frame(gifobj->gif)) {
         /*It was the last repeat*/
-        if(gifobj->gif->loop_count == 1) {
-            lv_res_t res = lv_event_send(obj, LV_EVENT_READY, NULL);
-            if(res != LV_FS_RES_OK) return;
+        lv_res_t res = lv_event_send(obj, LV_EVENT_READY, NULL);
+        if(res != LV_RES_OK) return;
+    }
+
+    lv_area_t area;
+    if(get_dirty_area(gifobj->gif, &area)) {
+        lv_img_cache_invalidate_src(lv_img_get_src(obj));
+        invalidate_img_area(obj, &area);
+    }
+}
+
+static void close_gif(lv_gif_t * gifobj)
+{
+    lv_img_cache_invalidate_src(&gifobj->imgdsc);
+#if LV_GIF_USE_PREDECODE
+    if(gifobj->predecode) {
+        predecode_stop(gifobj->predecode);
+        gifobj->predecode = NULL;
+        lv_free((void *)gifobj->imgdsc.data);
+    }
+#endif
+    gd_close_gif(gifobj->gif);
+    gifobj->gif = NULL;
+    gifobj->imgdsc.data = NULL;
+}
+
+/**
+ * Decode the next frame into the canvas of the decoder and handle the repeats
+ * @param gif       pointer to a decoder
+ * @return          true: the last repeat has ended
+ */
+static bool decode_next_frame(gd_GIF * gif)
+{
+    bool ended = false;
+    int has_next = gd_get_frame(gif);
+    if(has_next == 0) {
+        if(gif->loop_count == 1) {
+            ended = true;
         }
         else {
-            if(gifobj->gif->loop_count > 1)  gifobj->gif->loop_count--;
-            gd_rewind(gifobj->gif);
+            if(gif->loop_count > 1) gif->loop_count--;
+            gd_rewind(gif);
         }
     }
 
-    gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
+    gd_render_frame(gif, gif->canvas);
+    return ended;
+}
 
-    lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+/**
+ * Get the area of the canvas changed by the last frame
+ * @param gif       pointer to a decoder
+ * @param area      store the area here in image coordinates
+ * @return          true: the area is not empty
+ */
+static bool get_dirty_area(gd_GIF * gif, lv_area_t * area)
+{
+    if(gif->dw == 0 || gif->dh == 0) {
+        lv_area_set(area, 0, 0, -1, -1);
+        return false;
+    }
+
+    lv_area_set(area, gif->dx, gif->dy, gif->dx + gif->dw - 1, gif->dy + gif->dh - 1);
+    return true;
 }
 
+/**
+ * Invalidate only the changed part of the image if it's drawn 1:1, else invalidate the whole object
+ * @param obj       pointer to a gif object
+ * @param area      the changed area in image coordinates
+ */
+static void invalidate_img_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_img_t * img = (lv_img_t *) obj;
+
+    /*The image can be tiled or transformed, don't bother to find the changed parts then*/
+    if(img->zoom != LV_IMG_ZOOM_NONE || img->angle != 0 || img->offset.x != 0 || img->offset.y != 0 ||
+       img->obj_size_mode != LV_IMG_SIZE_MODE_VIRTUAL ||
+       lv_obj_get_content_width(obj) > img->w || lv_obj_get_content_height(obj) > img->h) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_coord_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_area_t inv_area;
+    lv_area_copy(&inv_area, area);
+    lv_area_move(&inv_area, obj->coords.x1 + lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width,
+                 obj->coords.y1 + lv_obj_get_style_pad_top(obj, LV_PART_MAIN) + border_width);
+    lv_obj_invalidate_area(obj, &inv_area);
+}
+
+#if LV_GIF_USE_PREDECODE
+
+static lv_gif_predecode_t * predecode_start(gd_GIF * gif)
+{
+    lv_gif_predecode_t * pd = lv_malloc(sizeof(lv_gif_predecode_t));
+    LV_ASSERT_MALLOC(pd);
+    if(pd == NULL) return NULL;
+    lv_memzero(pd, sizeof(lv_gif_predecode_t));
+    pd->gif = gif;
+
+    uint32_t canvas_size = (uint32_t)gif->width * gif->height * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint32_t i;
+    for(i = 0; i < LV_GIF_PREDECODE_FRAMES; i++) {
+        pd->frames[i].buf = lv_malloc(canvas_size);
+        LV_ASSERT_MALLOC(pd->frames[i].buf);
+        if(pd->frames[i].buf == NULL) break;
+    }
+
+    if(i < LV_GIF_PREDECODE_FRAMES) {
+        for(i = 0; i < LV_GIF_PREDECODE_FRAMES; i++) lv_free(pd->frames[i].buf);
+        lv_free(pd);
+        return NULL;
+    }
+
+    lv_mutex_init(&pd->mutex);
+    lv_thread_sync_init(&pd->sync);
+    if(lv_thread_init(&pd->thread, LV_THREAD_PRIO_LOW, predecode_thread_cb, 0, pd) != LV_RES_OK) {
+        lv_thread_sync_delete(&pd->sync);
+        lv_mutex_delete(&pd->mutex);
+        for(i = 0; i < LV_GIF_PREDECODE_FRAMES; i++) lv_free(pd->frames[i].buf);
+        lv_free(pd);
+        return NULL;
+    }
+
+    return pd;
+}
+
+static void predecode_stop(lv_gif_predecode_t * pd)
+{
+    lv_mutex_lock(&pd->mutex);
+    pd->exit = true;
+    lv_mutex_unlock(&pd->mutex);
+    lv_thread_sync_signal(&pd->sync);
+    lv_thread_delete(&pd->thread);
+
+    lv_thread_sync_delete(&pd->sync);
+    lv_mutex_delete(&pd->mutex);
+
+    uint32_t i;
+    for(i = 0; i < LV_GIF_PREDECODE_FRAMES; i++) lv_free(pd->frames[i].buf);
+    lv_free(pd);
+}
+
+static void predecode_restart(lv_gif_predecode_t * pd)
+{
+    /*Drop the decoded frames. The worker rewinds the decoder before decoding the next frame*/
+    lv_mutex_lock(&pd->mutex);
+    pd->restart = true;
+    pd->rd = 0;
+    pd->cnt = 0;
+    lv_mutex_unlock(&pd->mutex);
+    lv_thread_sync_signal(&pd->sync);
+}
+
+static void predecode_thread_cb(void * user_data)
+{
+    lv_gif_predecode_t * pd = user_data;
+    gd_GIF * gif = pd->gif;
+    bool full_area = false;
+
+    while(1) {
+        lv_mutex_lock(&pd->mutex);
+        if(pd->exit) {
+            lv_mutex_unlock(&pd->mutex);
+            break;
+        }
+
+        if(pd->restart) {
+            pd->restart = false;
+            pd->ended = false;
+            gd_rewind(gif);
+            /*The shown canvas differs from the decoder's so copy the whole next frame*/
+            full_area = true;
+        }
+
+        bool has_free = pd->cnt < LV_GIF_PREDECODE_FRAMES && !pd->ended;
+        uint32_t wr = (pd->rd + pd->cnt) % LV_GIF_PREDECODE_FRAMES;
+        lv_mutex_unlock(&pd->mutex);
+
+        if(!has_free) {
+            lv_thread_sync_wait(&pd->sync);
+            continue;
+        }
+
+        /*The slot is not used by the UI until `cnt` is increased so it can be written without locking*/
+        predecode_frame_t * frame = &pd->frames[wr];
+        frame->last = decode_next_frame(gif);
+        frame->delay = gif->gce.delay;
+        if(full_area) lv_area_set(&frame->area, 0, 0, gif->width - 1, gif->height - 1);
+        else get_dirty_area(gif, &frame->area);
+        copy_area(frame->buf, gif->canvas, &frame->area, gif->width);
+
+        lv_mutex_lock(&pd->mutex);
+        /*Drop the frame if restarted in the meantime*/
+        if(!pd->restart) {
+            pd->cnt++;
+            if(frame->last) pd->ended = true;
+            full_area = false;
+        }
+        lv_mutex_unlock(&pd->mutex);
+    }
+}
+
+static void show_predecoded_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    lv_gif_predecode_t * pd = gifobj->predecode;
+
+    uint32_t elaps = lv_tick_elaps(gifobj->last_call);
+    if(elaps < gifobj->delay * 10) return;
+
+    lv_mutex_lock(&pd->mutex);
+    uint32_t rd = pd->rd;
+    uint32_t cnt = pd->cnt;
+    lv_mutex_unlock(&pd->mutex);
+
+    /*The next frame is not decoded yet, try again later*/
+    if(cnt == 0) return;
+
+    /*The worker doesn't touch the frame until it's released by decreasing `cnt`*/
+    predecode_frame_t * frame = &pd->frames[rd];
+    copy_area((uint8_t *)gifobj->imgdsc.data, frame->buf, &frame->area, gifobj->imgdsc.header.w);
+    lv_area_t area = frame->area;
+    bool last = frame->last;
+    gifobj->delay = frame->delay;
+
+    lv_mutex_lock(&pd->mutex);
+    pd->rd = (rd + 1) % LV_GIF_PREDECODE_FRAMES;
+    pd->cnt--;
+    lv_mutex_unlock(&pd->mutex);
+    lv_thread_sync_signal(&pd->sync);
+
+    gifobj->last_call = lv_tick_get();
+
+    if(lv_area_get_width(&area) > 0 && lv_area_get_height(&area) > 0) {
+        lv_img_cache_invalidate_src(lv_img_get_src(obj));
+        invalidate_img_area(obj, &area);
+    }
+
+    /*It was the last repeat*/
+    if(last) lv_event_send(obj, LV_EVENT_READY, NULL);
+}
+
+static void copy_area(uint8_t * dst, const uint8_t * src, const lv_area_t * area, uint16_t w)
+{
+    lv_coord_t area_w = lv_area_get_width(area);
+    if(area_w <= 0) return;
+
+    uint32_t stride = (uint32_t)w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint32_t line_size = (uint32_t)area_w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint32_t ofs = area->y1 * stride + area->x1 * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(dst + ofs, src + ofs, line_size);
+        ofs += stride;
+    }
+}
+
+#endif /*LV_GIF_USE_PREDECODE*/
+
 #endif /*LV_USE_GIF*/
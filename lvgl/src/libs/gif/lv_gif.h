@@ -23,6 +23,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Decode the frames in advance on a separate thread*/
+#define LV_GIF_USE_PREDECODE (LV_GIF_PREDECODE_FRAMES > 0 && LV_USE_OS != LV_OS_NONE)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,6 +36,10 @@ typedef struct {
     lv_timer_t * timer;
     lv_img_dsc_t imgdsc;
     uint32_t last_call;
+#if LV_GIF_USE_PREDECODE
+    struct _lv_gif_predecode_t * predecode;     /*The frames decoded by the worker thread*/
+    uint16_t delay;                             /*Delay of the current frame in 10 ms units*/
+#endif
 } lv_gif_t;
 
 extern const lv_obj_class_t lv_gif_class;
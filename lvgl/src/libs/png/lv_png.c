@@ -10,6 +10,7 @@
 #if LV_USE_PNG
 
 #include "lv_png.h"
+#include "lv_png_stream.h"
 #include "lodepng.h"
 #include <stdlib.h>
 
@@ -20,13 +21,22 @@
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+    lv_fs_file_t f;
+    bool f_opened;
+    lv_png_stream_t * stream;
+} png_dsc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static void png_dsc_free(png_dsc_t * p);
+static uint8_t * decode_with_lodepng(const uint8_t * png_data, size_t png_data_size, const char * fn);
 static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
 
 /**********************
@@ -49,6 +59,7 @@ void lv_png_init(void)
     lv_img_decoder_t * dec = lv_img_decoder_create();
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
     lv_img_decoder_set_close_cb(dec, decoder_close);
 }
 
@@ -125,72 +136,121 @@ static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * sr
  */
 static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
 {
-
     (void) decoder; /*Unused*/
-    uint32_t error;                 /*For the return values of PNG decoder functions*/
 
-    uint8_t * img_data = NULL;
+    const char * fn = NULL;
+    const uint8_t * png_data = NULL;    /*Pointer to the compressed data if it's in the memory*/
+    uint32_t png_data_size = 0;
+
+    png_dsc_t * p = lv_malloc(sizeof(png_dsc_t));
+    LV_ASSERT_MALLOC(p);
+    if(p == NULL) return LV_RES_INV;
+    lv_memzero(p, sizeof(png_dsc_t));
 
     /*If it's a PNG file...*/
     if(dsc->src_type == LV_IMG_SRC_FILE) {
-        const char * fn = dsc->src;
-        if(strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
-
-            /*Load the PNG file into buffer. It's still compressed (not decoded)*/
-            unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
-            size_t png_data_size;          /*Size of `png_data` in bytes*/
-
-            error = lodepng_load_file(&png_data, &png_data_size, fn);   /*Load the file*/
-            if(error) {
-                LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
-                return LV_RES_INV;
-            }
-
-            /*Decode the PNG image*/
-            uint32_t png_width;             /*Will be the width of the decoded image*/
-            uint32_t png_height;            /*Will be the width of the decoded image*/
-
-            /*Decode the loaded image in ARGB8888 */
-            error = lodepng_decode32(&img_data, &png_width, &png_height, png_data, png_data_size);
-            lv_free(png_data); /*Free the loaded file*/
-            if(error) {
-                if(img_data != NULL) {
-                    lv_free(img_data);
-                }
-                LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
-                return LV_RES_INV;
-            }
-
-            /*Convert the image to the system's color depth*/
-            convert_color_depth(img_data,  png_width * png_height);
-            dsc->img_data = img_data;
-            return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
+        fn = dsc->src;
+        if(strcmp(lv_fs_get_ext(fn), "png") != 0 || lv_fs_open(&p->f, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            lv_free(p);
+            return LV_RES_INV;
+        }
+        p->f_opened = true;
+
+        /*If the file system can give a direct pointer to the file (e.g. it's memory mapped)
+         *decode the PNG in place. Else read the file in small chunks while decoding.*/
+        const void * mapped_data = NULL;
+        uint32_t mapped_size = 0;
+        if(lv_fs_get_buf(&p->f, &mapped_data, &mapped_size) == LV_FS_RES_OK && mapped_data) {
+            png_data = mapped_data;
+            png_data_size = mapped_size;
+            p->stream = _lv_png_stream_create_from_data(png_data, png_data_size);
+        }
+        else {
+            p->stream = _lv_png_stream_create_from_file(&p->f);
         }
     }
     /*If it's a PNG file in a  C array...*/
     else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = dsc->src;
-        uint32_t png_width;             /*No used, just required by he decoder*/
-        uint32_t png_height;            /*No used, just required by he decoder*/
+        png_data = img_dsc->data;
+        png_data_size = img_dsc->data_size;
+        p->stream = _lv_png_stream_create_from_data(png_data, png_data_size);
+    }
+    else {
+        lv_free(p);
+        return LV_RES_INV;
+    }
 
-        /*Decode the image in ARGB8888 */
-        error = lodepng_decode32(&img_data, &png_width, &png_height, img_dsc->data, img_dsc->data_size);
+    /*Interlaced and 16 bit images can't be streamed, decode them with lodepng*/
+    if(p->stream == NULL) {
+        dsc->img_data = decode_with_lodepng(png_data, png_data_size, fn);
+        png_dsc_free(p);
+        return dsc->img_data ? LV_RES_OK : LV_RES_INV;
+    }
 
-        if(error) {
-            if(img_data != NULL) {
-                lv_free(img_data);
-            }
-            return LV_RES_INV;
+    lv_png_stream_t * s = p->stream;
+    uint32_t line_size = s->w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+#if LV_PNG_READ_LINE_MIN_SIZE
+    /*Don't store the large images but decode their lines when they are drawn*/
+    if(line_size * s->h >= LV_PNG_READ_LINE_MIN_SIZE) {
+        dsc->img_data = NULL;
+        dsc->user_data = p;
+        return LV_RES_OK;
+    }
+#endif
+
+    /*Decode the rows directly into the final color format*/
+    uint8_t * img_data = lv_malloc(line_size * s->h);
+    LV_ASSERT_MALLOC(img_data);
+    uint32_t y;
+    for(y = 0; img_data && y < s->h; y++) {
+        if(!_lv_png_stream_next_row(s)) {
+            lv_free(img_data);
+            img_data = NULL;
+            break;
         }
+        _lv_png_stream_convert_row(s, 0, s->w, img_data + y * line_size);
+    }
+
+    png_dsc_free(p);
+    if(img_data == NULL) return LV_RES_INV;
+
+    dsc->img_data = img_data;
+    return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
+}
+
+/**
+ * Decode a line of a PNG image which is not decoded in `decoder_open`
+ * @param decoder pointer to the decoder
+ * @param dsc pointer to the decoder descriptor
+ * @param x start x coordinate
+ * @param y start y coordinate
+ * @param len number of pixels to decode
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
 
-        /*Convert the image to the system's color depth*/
-        convert_color_depth(img_data,  png_width * png_height);
+    png_dsc_t * p = dsc->user_data;
+    if(p == NULL) return LV_RES_INV;
+    lv_png_stream_t * s = p->stream;
 
-        dsc->img_data = img_data;
-        return LV_RES_OK;     /*Return with its pointer*/
+    /*The rows can be decoded only forward so start again if an earlier row is needed.
+     *`s->y` is the number of decoded rows so the last decoded row is `s->y - 1`.*/
+    if((uint32_t)y + 1 < s->y) {
+        if(!_lv_png_stream_rewind(s)) return LV_RES_INV;
     }
 
-    return LV_RES_INV;    /*If not returned earlier then it failed*/
+    while(s->y < (uint32_t)y + 1) {
+        if(!_lv_png_stream_next_row(s)) return LV_RES_INV;
+    }
+
+    _lv_png_stream_convert_row(s, x, len, buf);
+    return LV_RES_OK;
 }
 
 /**
@@ -203,6 +263,59 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
         lv_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
     }
+
+    if(dsc->user_data) {
+        png_dsc_free(dsc->user_data);
+        dsc->user_data = NULL;
+    }
+}
+
+static void png_dsc_free(png_dsc_t * p)
+{
+    _lv_png_stream_delete(p->stream);
+    if(p->f_opened) lv_fs_close(&p->f);
+    lv_free(p);
+}
+
+/**
+ * Decode a PNG image with lodepng
+ * @param png_data pointer to the PNG file's content or NULL to load the file
+ * @param png_data_size size of `png_data`
+ * @param fn path to the file if `png_data == NULL`
+ * @return the decoded image in `LV_IMG_CF_TRUE_COLOR_ALPHA` format or NULL on error
+ */
+static uint8_t * decode_with_lodepng(const uint8_t * png_data, size_t png_data_size, const char * fn)
+{
+    uint32_t error;                 /*For the return values of PNG decoder functions*/
+    unsigned char * png_data_loaded = NULL;  /*The file loaded into the RAM if it couldn't be used in place*/
+
+    if(png_data == NULL) {
+        if(fn == NULL) return NULL;
+        error = lodepng_load_file(&png_data_loaded, &png_data_size, fn);   /*Load the file*/
+        if(error) {
+            LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+            return NULL;
+        }
+        png_data = png_data_loaded;
+    }
+
+    /*Decode the image in ARGB8888 */
+    uint8_t * img_data = NULL;
+    uint32_t png_width;             /*Will be the width of the decoded image*/
+    uint32_t png_height;            /*Will be the width of the decoded image*/
+    error = lodepng_decode32(&img_data, &png_width, &png_height, png_data, png_data_size);
+    if(png_data_loaded) lv_free(png_data_loaded); /*Free the loaded file*/
+    if(error) {
+        if(img_data != NULL) {
+            lv_free(img_data);
+        }
+        LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+        return NULL;
+    }
+
+    /*Convert the image to the system's color depth*/
+    convert_color_depth(img_data,  png_width * png_height);
+    return img_data;
 }
 
 /**
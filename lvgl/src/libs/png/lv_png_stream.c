@@ -0,0 +1,831 @@
+/**
+ * @file lv_png_stream.c
+ * Decode non-interlaced PNG images row-by-row directly into LVGL's color format.
+ * The IDAT chunks are inflated on the fly so neither the whole file
+ * nor the whole decompressed image needs to be in the memory.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_png_stream.h"
+#if LV_USE_PNG
+
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_log.h"
+#include "../../misc/lv_color.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_printf.h"
+#include "../../draw/lv_img_buf.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define WINDOW_SIZE     32768   /*The largest back reference distance of deflate*/
+#define WINDOW_MASK     (WINDOW_SIZE - 1)
+#define FILE_BUF_SIZE   2048
+#define MAX_CODE_LEN    15
+#define FAST_BITS       9       /*Codes up to this length are decoded with a single table lookup*/
+#define LIT_CODES       288
+#define DIST_CODES      32
+
+#define COLOR_TYPE_GRAY         0
+#define COLOR_TYPE_RGB          2
+#define COLOR_TYPE_PALETTE      3
+#define COLOR_TYPE_GRAY_ALPHA   4
+#define COLOR_TYPE_RGBA         6
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _lv_png_huffman_t {
+    uint16_t fast[1 << FAST_BITS];      /*symbol | (code length << 9) indexed by the bit reversed codes*/
+    uint16_t count[MAX_CODE_LEN + 1];   /*Number of codes of each length*/
+    uint16_t symbol[LIT_CODES];         /*Symbols ordered by their codes*/
+} lv_png_huffman_t;
+
+enum {
+    BLOCK_NONE,
+    BLOCK_STORED,
+    BLOCK_HUFFMAN,
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_png_stream_t * stream_create(const uint8_t * data, uint32_t size, lv_fs_file_t * file);
+static bool read_header(lv_png_stream_t * s);
+static bool src_read(lv_png_stream_t * s, void * buf, uint32_t len);
+static bool src_skip(lv_png_stream_t * s, uint32_t len);
+static bool fill_input(lv_png_stream_t * s);
+static bool inflate_read(lv_png_stream_t * s, uint8_t * out, uint32_t len);
+static bool read_block_header(lv_png_stream_t * s);
+static bool read_dynamic_tables(lv_png_stream_t * s);
+static void build_huffman(lv_png_huffman_t * h, const uint8_t * lens, uint32_t n);
+static int32_t decode_symbol(lv_png_stream_t * s, const lv_png_huffman_t * h);
+static void unfilter_row(lv_png_stream_t * s);
+static inline uint32_t next_byte(lv_png_stream_t * s);
+static inline void need_bits(lv_png_stream_t * s, uint32_t n);
+static inline uint32_t get_bits(lv_png_stream_t * s, uint32_t n);
+static inline uint32_t read_be32(const uint8_t * p);
+static inline void write_px(uint8_t * dst, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_png_stream_t * _lv_png_stream_create_from_data(const void * data, uint32_t size)
+{
+    LV_ASSERT_NULL(data);
+    return stream_create(data, size, NULL);
+}
+
+lv_png_stream_t * _lv_png_stream_create_from_file(lv_fs_file_t * file)
+{
+    LV_ASSERT_NULL(file);
+    return stream_create(NULL, 0, file);
+}
+
+bool _lv_png_stream_next_row(lv_png_stream_t * s)
+{
+    if(s->y >= s->h) return false;
+
+    uint8_t * tmp = s->prev_row;
+    s->prev_row = s->row;
+    s->row = tmp;
+
+    if(!inflate_read(s, s->row, s->row_bytes + 1)) {
+        LV_LOG_WARN("corrupted PNG data in row %" LV_PRIu32, s->y);
+        return false;
+    }
+
+    unfilter_row(s);
+    s->y++;
+    return true;
+}
+
+void _lv_png_stream_convert_row(const lv_png_stream_t * s, uint32_t x, uint32_t len, uint8_t * buf)
+{
+    const uint8_t * src = s->row + 1;
+    uint32_t i;
+
+    switch(s->color_type) {
+        case COLOR_TYPE_RGBA:
+            src += x * 4;
+            for(i = 0; i < len; i++) {
+                write_px(buf, src[0], src[1], src[2], src[3]);
+                src += 4;
+                buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+            break;
+        case COLOR_TYPE_RGB:
+            src += x * 3;
+            for(i = 0; i < len; i++) {
+                bool transp = s->has_key && src[0] == s->key[0] && src[1] == s->key[1] && src[2] == s->key[2];
+                write_px(buf, src[0], src[1], src[2], transp ? 0x00 : 0xFF);
+                src += 3;
+                buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+            break;
+        case COLOR_TYPE_GRAY_ALPHA:
+            src += x * 2;
+            for(i = 0; i < len; i++) {
+                write_px(buf, src[0], src[0], src[0], src[1]);
+                src += 2;
+                buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+            break;
+        case COLOR_TYPE_GRAY:
+        case COLOR_TYPE_PALETTE: {
+                /*Pixels can be stored on 1, 2, 4 or 8 bits*/
+                uint32_t bpp = s->bit_depth;
+                uint32_t mask = (1 << bpp) - 1;
+                uint32_t bit = x * bpp;
+                for(i = 0; i < len; i++) {
+                    uint32_t v = (src[bit >> 3] >> (8 - bpp - (bit & 0x7))) & mask;
+                    if(s->color_type == COLOR_TYPE_PALETTE) {
+                        const uint8_t * c = s->palette[v];
+                        write_px(buf, c[0], c[1], c[2], c[3]);
+                    }
+                    else {
+                        uint8_t gray = (uint8_t)((v * 0xFF) / mask);
+                        write_px(buf, gray, gray, gray, s->has_key && v == s->key[0] ? 0x00 : 0xFF);
+                    }
+                    bit += bpp;
+                    buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool _lv_png_stream_rewind(lv_png_stream_t * s)
+{
+    if(s->data) {
+        if(s->idat_pos > s->data_size) return false;
+    }
+    else {
+        if(lv_fs_seek(s->file, s->idat_pos, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+    }
+
+    s->pos = s->idat_pos;
+    s->chunk_left = s->idat_size;
+    s->in = NULL;
+    s->in_end = NULL;
+    s->idat_ended = false;
+    s->pad_cnt = 0;
+    s->bitbuf = 0;
+    s->bitcnt = 0;
+    s->block = BLOCK_NONE;
+    s->final = false;
+    s->stored_left = 0;
+    s->match_len = 0;
+    s->out_cnt = 0;
+    s->y = 0;
+    lv_memzero(s->row, s->row_bytes + 1);
+
+    /*Check the zlib header: deflate compression, no preset dictionary*/
+    uint32_t cmf = get_bits(s, 8);
+    uint32_t flg = get_bits(s, 8);
+    if((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || (flg & 0x20) || ((cmf << 8) | flg) % 31 != 0 || s->pad_cnt) {
+        LV_LOG_WARN("invalid zlib header");
+        return false;
+    }
+
+    return true;
+}
+
+void _lv_png_stream_delete(lv_png_stream_t * s)
+{
+    if(s == NULL) return;
+    lv_free(s->file_buf);
+    lv_free(s->window);
+    lv_free(s->lit);
+    lv_free(s->dist);
+    lv_free(s->row);
+    lv_free(s->prev_row);
+    lv_free(s);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+static lv_png_stream_t * stream_create(const uint8_t * data, uint32_t size, lv_fs_file_t * file)
+{
+    lv_png_stream_t * s = lv_malloc(sizeof(lv_png_stream_t));
+    LV_ASSERT_MALLOC(s);
+    if(s == NULL) return NULL;
+    lv_memzero(s, sizeof(lv_png_stream_t));
+
+    s->data = data;
+    s->data_size = size;
+    s->file = file;
+    if(file) {
+        s->file_buf = lv_malloc(FILE_BUF_SIZE);
+        LV_ASSERT_MALLOC(s->file_buf);
+        if(s->file_buf == NULL || lv_fs_seek(file, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK) {
+            _lv_png_stream_delete(s);
+            return NULL;
+        }
+    }
+
+    if(!read_header(s)) {
+        _lv_png_stream_delete(s);
+        return NULL;
+    }
+
+    s->window = lv_malloc(WINDOW_SIZE);
+    s->lit = lv_malloc(sizeof(lv_png_huffman_t));
+    s->dist = lv_malloc(sizeof(lv_png_huffman_t));
+    s->row = lv_malloc(s->row_bytes + 1);
+    s->prev_row = lv_malloc(s->row_bytes + 1);
+    LV_ASSERT_MALLOC(s->window);
+    LV_ASSERT_MALLOC(s->lit);
+    LV_ASSERT_MALLOC(s->dist);
+    LV_ASSERT_MALLOC(s->row);
+    LV_ASSERT_MALLOC(s->prev_row);
+    if(s->window == NULL || s->lit == NULL || s->dist == NULL || s->row == NULL || s->prev_row == NULL ||
+       !_lv_png_stream_rewind(s)) {
+        _lv_png_stream_delete(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+/**
+ * Process the chunks until the first IDAT
+ * @param s     pointer to a stream
+ * @return      true: the image can be decoded; false: not a PNG, corrupted or not supported
+ */
+static bool read_header(lv_png_stream_t * s)
+{
+    static const uint8_t magic[] = {0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a};
+
+    /*Signature, length, type, IHDR data and CRC*/
+    uint8_t buf[8 + 8 + 13 + 4];
+    if(!src_read(s, buf, sizeof(buf))) return false;
+    if(memcmp(buf, magic, sizeof(magic)) != 0) return false;
+    if(read_be32(&buf[8]) != 13 || memcmp(&buf[12], "IHDR", 4) != 0) return false;
+
+    s->w = read_be32(&buf[16]);
+    s->h = read_be32(&buf[20]);
+    s->bit_depth = buf[24];
+    s->color_type = buf[25];
+    if(s->w == 0 || s->h == 0 || s->w > 0xFFFFFF || s->h > 0xFFFFFF) return false;
+    if(buf[26] != 0 || buf[27] != 0) return false;  /*Unknown compression or filter method*/
+
+    /*Let lodepng deal with the rare formats*/
+    if(buf[28] != 0) {
+        LV_LOG_INFO("interlaced PNG images can't be streamed");
+        return false;
+    }
+
+    uint32_t channels;
+    switch(s->color_type) {
+        case COLOR_TYPE_GRAY:
+        case COLOR_TYPE_PALETTE:
+            channels = 1;
+            break;
+        case COLOR_TYPE_GRAY_ALPHA:
+            channels = 2;
+            break;
+        case COLOR_TYPE_RGB:
+            channels = 3;
+            break;
+        case COLOR_TYPE_RGBA:
+            channels = 4;
+            break;
+        default:
+            return false;
+    }
+
+    bool depth_ok = s->bit_depth == 8;
+    if(channels == 1) depth_ok |= s->bit_depth == 1 || s->bit_depth == 2 || s->bit_depth == 4;
+    if(!depth_ok) {
+        LV_LOG_INFO("%d bit PNG images can't be streamed", s->bit_depth);
+        return false;
+    }
+
+    uint32_t px_bits = channels * s->bit_depth;
+    s->px_bytes = px_bits >= 8 ? px_bits / 8 : 1;
+    s->row_bytes = (s->w * px_bits + 7) / 8;
+
+    uint32_t i;
+    for(i = 0; i < 256; i++) {
+        s->palette[i][0] = 0;
+        s->palette[i][1] = 0;
+        s->palette[i][2] = 0;
+        s->palette[i][3] = 0xFF;
+    }
+
+    /*Process the chunks until the image data*/
+    while(1) {
+        uint8_t hdr[8];
+        if(!src_read(s, hdr, sizeof(hdr))) return false;
+        uint32_t len = read_be32(hdr);
+        const uint8_t * type = &hdr[4];
+
+        if(memcmp(type, "IDAT", 4) == 0) {
+            s->idat_pos = s->pos;
+            s->idat_size = len;
+            return true;
+        }
+        else if(memcmp(type, "IEND", 4) == 0) {
+            return false;
+        }
+        else if(memcmp(type, "PLTE", 4) == 0) {
+            uint8_t rgb[3];
+            for(i = 0; i < len / 3 && i < 256; i++) {
+                if(!src_read(s, rgb, 3)) return false;
+                s->palette[i][0] = rgb[0];
+                s->palette[i][1] = rgb[1];
+                s->palette[i][2] = rgb[2];
+            }
+            len -= i * 3;
+        }
+        else if(memcmp(type, "tRNS", 4) == 0) {
+            if(s->color_type == COLOR_TYPE_PALETTE) {
+                for(i = 0; i < len && i < 256; i++) {
+                    if(!src_read(s, &s->palette[i][3], 1)) return false;
+                }
+                len -= i;
+            }
+            else if(len >= 2 && (s->color_type == COLOR_TYPE_GRAY || s->color_type == COLOR_TYPE_RGB)) {
+                /*The key is stored on 16 bits, only the lower byte is relevant for the supported depths*/
+                uint8_t key[6];
+                uint32_t key_len = s->color_type == COLOR_TYPE_GRAY ? 2 : 6;
+                if(len < key_len || !src_read(s, key, key_len)) return false;
+                s->key[0] = (key[0] << 8) | key[1];
+                s->key[1] = (key[2] << 8) | key[3];
+                s->key[2] = (key[4] << 8) | key[5];
+                s->has_key = true;
+                len -= key_len;
+            }
+        }
+
+        /*Skip the rest of the chunk and the CRC*/
+        if(!src_skip(s, len + 4)) return false;
+    }
+}
+
+static bool src_read(lv_png_stream_t * s, void * buf, uint32_t len)
+{
+    if(s->data) {
+        if(len > s->data_size - s->pos) return false;
+        lv_memcpy(buf, s->data + s->pos, len);
+    }
+    else {
+        uint32_t rn;
+        if(lv_fs_read(s->file, buf, len, &rn) != LV_FS_RES_OK || rn != len) return false;
+    }
+
+    s->pos += len;
+    return true;
+}
+
+static bool src_skip(lv_png_stream_t * s, uint32_t len)
+{
+    if(s->data) {
+        if(len > s->data_size - s->pos) return false;
+    }
+    else {
+        if(lv_fs_seek(s->file, s->pos + len, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+    }
+
+    s->pos += len;
+    return true;
+}
+
+/**
+ * Make the next part of the compressed data available in `s->in`.
+ * Continue with the next IDAT chunk if the current is consumed.
+ * @param s     pointer to a stream
+ * @return      false: no more data
+ */
+static bool fill_input(lv_png_stream_t * s)
+{
+    while(s->chunk_left == 0) {
+        if(s->idat_ended) return false;
+
+        /*CRC of the current chunk and the length and type of the next*/
+        uint8_t hdr[12];
+        if(!src_read(s, hdr, sizeof(hdr)) || memcmp(&hdr[8], "IDAT", 4) != 0) {
+            s->idat_ended = true;
+            return false;
+        }
+        s->chunk_left = read_be32(&hdr[4]);
+    }
+
+    uint32_t n = s->chunk_left;
+    if(s->data) {
+        if(n > s->data_size - s->pos) n = s->data_size - s->pos;
+        s->in = s->data + s->pos;
+    }
+    else {
+        if(n > FILE_BUF_SIZE) n = FILE_BUF_SIZE;
+        if(lv_fs_read(s->file, s->file_buf, n, &n) != LV_FS_RES_OK) return false;
+        s->in = s->file_buf;
+    }
+
+    if(n == 0) return false;
+
+    s->pos += n;
+    s->chunk_left -= n;
+    s->in_end = s->in + n;
+    return true;
+}
+
+/**
+ * Get the next byte of the compressed data. After the end of the data 0 is returned.
+ */
+static inline uint32_t next_byte(lv_png_stream_t * s)
+{
+    if(s->in == s->in_end && !fill_input(s)) {
+        /*A valid stream ends with the 4 bytes Adler-32 checksum so it's fine to look ahead a little*/
+        if(s->pad_cnt < 0xFF) s->pad_cnt++;
+        return 0;
+    }
+    return *s->in++;
+}
+
+static inline void need_bits(lv_png_stream_t * s, uint32_t n)
+{
+    while(s->bitcnt < n) {
+        s->bitbuf |= next_byte(s) << s->bitcnt;
+        s->bitcnt += 8;
+    }
+}
+
+static inline uint32_t get_bits(lv_png_stream_t * s, uint32_t n)
+{
+    need_bits(s, n);
+    uint32_t v = s->bitbuf & ((1UL << n) - 1);
+    s->bitbuf >>= n;
+    s->bitcnt -= n;
+    return v;
+}
+
+static inline void put_byte(lv_png_stream_t * s, uint8_t ** out, uint8_t b)
+{
+    s->window[s->out_cnt & WINDOW_MASK] = b;
+    s->out_cnt++;
+    **out = b;
+    (*out)++;
+}
+
+/**
+ * Inflate the next `len` bytes
+ * @param s     pointer to a stream
+ * @param out   store the inflated bytes here
+ * @param len   number of bytes to inflate
+ * @return      true: success; false: the data is corrupted or ended
+ */
+static bool inflate_read(lv_png_stream_t * s, uint8_t * out, uint32_t len)
+{
+    while(len) {
+        /*Continue a back reference from the previous call*/
+        if(s->match_len) {
+            uint32_t n = LV_MIN(s->match_len, len);
+            s->match_len -= n;
+            len -= n;
+            uint32_t from = s->out_cnt - s->match_dist;
+            while(n--) {
+                put_byte(s, &out, s->window[from & WINDOW_MASK]);
+                from++;
+            }
+            continue;
+        }
+
+        if(s->block == BLOCK_NONE) {
+            if(s->final) return false;  /*All blocks are processed but the image is not complete*/
+            if(!read_block_header(s)) return false;
+        }
+        else if(s->block == BLOCK_STORED) {
+            if(s->stored_left == 0) {
+                s->block = BLOCK_NONE;
+                continue;
+            }
+            put_byte(s, &out, get_bits(s, 8));
+            s->stored_left--;
+            len--;
+        }
+        else {
+            int32_t sym = decode_symbol(s, s->lit);
+            if(sym < 0) return false;
+
+            if(sym < 256) {
+                put_byte(s, &out, (uint8_t)sym);
+                len--;
+            }
+            else if(sym == 256) {
+                s->block = BLOCK_NONE;
+            }
+            else {
+                sym -= 257;
+                if(sym >= 29) return false;
+                uint32_t match_len = len_base[sym] + get_bits(s, len_extra[sym]);
+
+                int32_t dsym = decode_symbol(s, s->dist);
+                if(dsym < 0 || dsym >= 30) return false;
+                uint32_t dist = dist_base[dsym] + get_bits(s, dist_extra[dsym]);
+                if(dist > s->out_cnt) return false;
+
+                s->match_len = match_len;
+                s->match_dist = dist;
+            }
+        }
+
+        if(s->pad_cnt > 4) return false;
+    }
+
+    return true;
+}
+
+static bool read_block_header(lv_png_stream_t * s)
+{
+    s->final = get_bits(s, 1);
+    uint32_t type = get_bits(s, 2);
+
+    if(type == 0) {
+        /*Stored block: skip to the byte boundary and read the length and its complement*/
+        get_bits(s, s->bitcnt & 0x7);
+        uint32_t len = get_bits(s, 16);
+        uint32_t nlen = get_bits(s, 16);
+        if(len != (~nlen & 0xFFFF)) return false;
+        s->stored_left = len;
+        s->block = BLOCK_STORED;
+        return true;
+    }
+    else if(type == 1) {
+        /*Fixed Huffman codes*/
+        uint8_t lens[LIT_CODES];
+        uint32_t i;
+        for(i = 0; i < 144; i++) lens[i] = 8;
+        for(; i < 256; i++) lens[i] = 9;
+        for(; i < 280; i++) lens[i] = 7;
+        for(; i < LIT_CODES; i++) lens[i] = 8;
+        build_huffman(s->lit, lens, LIT_CODES);
+
+        for(i = 0; i < DIST_CODES; i++) lens[i] = 5;
+        build_huffman(s->dist, lens, DIST_CODES);
+
+        s->block = BLOCK_HUFFMAN;
+        return true;
+    }
+    else if(type == 2) {
+        if(!read_dynamic_tables(s)) return false;
+        s->block = BLOCK_HUFFMAN;
+        return true;
+    }
+
+    return false;
+}
+
+static bool read_dynamic_tables(lv_png_stream_t * s)
+{
+    static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+    uint32_t nlen = get_bits(s, 5) + 257;
+    uint32_t ndist = get_bits(s, 5) + 1;
+    uint32_t ncode = get_bits(s, 4) + 4;
+    if(nlen > 286 || ndist > 30) return false;
+
+    /*Huffman codes of the code lengths. Use the distance table temporarily.*/
+    uint8_t lens[LIT_CODES + DIST_CODES];
+    lv_memzero(lens, 19);
+    uint32_t i;
+    for(i = 0; i < ncode; i++) lens[order[i]] = get_bits(s, 3);
+    build_huffman(s->dist, lens, 19);
+
+    /*Code lengths of the literal/length and distance codes*/
+    i = 0;
+    while(i < nlen + ndist) {
+        int32_t sym = decode_symbol(s, s->dist);
+        if(sym < 0) return false;
+
+        if(sym < 16) {
+            lens[i++] = sym;
+            continue;
+        }
+
+        uint8_t v = 0;
+        uint32_t rep;
+        if(sym == 16) {
+            if(i == 0) return false;
+            v = lens[i - 1];
+            rep = 3 + get_bits(s, 2);
+        }
+        else if(sym == 17) {
+            rep = 3 + get_bits(s, 3);
+        }
+        else {
+            rep = 11 + get_bits(s, 7);
+        }
+
+        if(i + rep > nlen + ndist) return false;
+        while(rep--) lens[i++] = v;
+    }
+
+    /*The end of block code is required*/
+    if(lens[256] == 0) return false;
+
+    build_huffman(s->lit, lens, nlen);
+    build_huffman(s->dist, &lens[nlen], ndist);
+    return true;
+}
+
+/**
+ * Build the decoding tables of canonical Huffman codes from the code lengths
+ * @param h     the table to initialize
+ * @param lens  code length of each symbol. 0: the symbol is not used
+ * @param n     number of symbols
+ */
+static void build_huffman(lv_png_huffman_t * h, const uint8_t * lens, uint32_t n)
+{
+    uint16_t offs[MAX_CODE_LEN + 2];
+    uint32_t next_code[MAX_CODE_LEN + 1];
+    uint32_t i;
+
+    lv_memzero(h->count, sizeof(h->count));
+    lv_memzero(h->fast, sizeof(h->fast));
+
+    for(i = 0; i < n; i++) h->count[lens[i]]++;
+    h->count[0] = 0;
+
+    /*Sort the symbols by code length (and by value within the same length)*/
+    offs[1] = 0;
+    for(i = 1; i <= MAX_CODE_LEN; i++) offs[i + 1] = offs[i] + h->count[i];
+    for(i = 0; i < n; i++) {
+        if(lens[i]) h->symbol[offs[lens[i]]++] = i;
+    }
+
+    /*Fill the lookup table with the short codes. Deflate stores the codes starting with the MSB
+     *so they are bit reversed compared to the bit buffer.*/
+    uint32_t code = 0;
+    next_code[0] = 0;
+    for(i = 1; i <= MAX_CODE_LEN; i++) {
+        code = (code + h->count[i - 1]) << 1;
+        next_code[i] = code;
+    }
+
+    for(i = 0; i < n; i++) {
+        uint32_t len = lens[i];
+        if(len == 0 || len > FAST_BITS) continue;
+
+        uint32_t c = next_code[len]++;
+        uint32_t rev = 0;
+        uint32_t b;
+        for(b = 0; b < len; b++) {
+            rev = (rev << 1) | (c & 1);
+            c >>= 1;
+        }
+
+        for(; rev < (1 << FAST_BITS); rev += 1 << len) {
+            h->fast[rev] = i | (len << 9);
+        }
+    }
+}
+
+/**
+ * Decode a symbol with a Huffman table
+ * @param s     pointer to a stream
+ * @param h     the table to use
+ * @return      the symbol or -1 on error
+ */
+static int32_t decode_symbol(lv_png_stream_t * s, const lv_png_huffman_t * h)
+{
+    need_bits(s, MAX_CODE_LEN);
+
+    uint32_t e = h->fast[s->bitbuf & ((1 << FAST_BITS) - 1)];
+    if(e) {
+        uint32_t len = e >> 9;
+        s->bitbuf >>= len;
+        s->bitcnt -= len;
+        return e & 0x1FF;
+    }
+
+    /*Longer code: walk the canonical code bit-by-bit*/
+    uint32_t bits = s->bitbuf;
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    uint32_t len;
+    for(len = 1; len <= MAX_CODE_LEN; len++) {
+        code |= bits & 1;
+        bits >>= 1;
+        int32_t count = h->count[len];
+        if(code - count < first) {
+            s->bitbuf >>= len;
+            s->bitcnt -= len;
+            return h->symbol[index + (code - first)];
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+/**
+ * Reverse the filter of the current row using the previous row
+ */
+static void unfilter_row(lv_png_stream_t * s)
+{
+    uint8_t * cur = s->row + 1;
+    const uint8_t * prev = s->prev_row + 1;
+    uint32_t n = s->row_bytes;
+    uint32_t bpp = s->px_bytes;
+    uint32_t i;
+
+    switch(s->row[0]) {
+        case 1: /*Sub*/
+            for(i = bpp; i < n; i++) cur[i] += cur[i - bpp];
+            break;
+        case 2: /*Up*/
+            for(i = 0; i < n; i++) cur[i] += prev[i];
+            break;
+        case 3: /*Average*/
+            for(i = 0; i < bpp; i++) cur[i] += prev[i] >> 1;
+            for(; i < n; i++) cur[i] += (cur[i - bpp] + prev[i]) >> 1;
+            break;
+        case 4: /*Paeth*/
+            for(i = 0; i < bpp; i++) cur[i] += prev[i];
+            for(; i < n; i++) {
+                int32_t a = cur[i - bpp];
+                int32_t b = prev[i];
+                int32_t c = prev[i - bpp];
+                int32_t pa = LV_ABS(b - c);
+                int32_t pb = LV_ABS(a - c);
+                int32_t pc = LV_ABS(a + b - 2 * c);
+                if(pa <= pb && pa <= pc) cur[i] += a;
+                else if(pb <= pc) cur[i] += b;
+                else cur[i] += c;
+            }
+            break;
+        default:    /*None*/
+            break;
+    }
+}
+
+static inline uint32_t read_be32(const uint8_t * p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * Write a pixel in `LV_IMG_CF_TRUE_COLOR_ALPHA` format
+ */
+static inline void write_px(uint8_t * dst, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+#if LV_COLOR_DEPTH == 32
+    dst[0] = b;
+    dst[1] = g;
+    dst[2] = r;
+    dst[3] = a;
+#elif LV_COLOR_DEPTH == 16
+    lv_color_t c = lv_color_make(r, g, b);
+    dst[0] = c.full & 0xFF;
+    dst[1] = c.full >> 8;
+    dst[2] = a;
+#elif LV_COLOR_DEPTH == 8
+    lv_color_t c = lv_color_make(r, g, b);
+    dst[0] = c.full;
+    dst[1] = a;
+#elif LV_COLOR_DEPTH == 1
+    dst[0] = (r | g | b) > 128 ? 1 : 0;
+    dst[1] = a;
+#endif
+}
+
+#endif /*LV_USE_PNG*/
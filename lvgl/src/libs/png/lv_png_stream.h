@@ -0,0 +1,138 @@
+/**
+ * @file lv_png_stream.h
+ * Decode non-interlaced PNG images row-by-row directly into LVGL's color format
+ */
+
+#ifndef LV_PNG_STREAM_H
+#define LV_PNG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#if LV_USE_PNG
+
+#include "../../misc/lv_fs.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_png_huffman_t;
+
+typedef struct {
+    /*Source: either the whole file in the memory or an opened file*/
+    const uint8_t * data;
+    uint32_t data_size;
+    lv_fs_file_t * file;
+    uint8_t * file_buf;
+    uint32_t pos;               /*Position of the next byte to read in the source*/
+
+    /*The not yet consumed part of the current IDAT chunk*/
+    const uint8_t * in;
+    const uint8_t * in_end;
+    uint32_t chunk_left;
+    uint32_t idat_pos;          /*Position of the first IDAT's data to rewind*/
+    uint32_t idat_size;         /*Size of the first IDAT's data*/
+    bool idat_ended;            /*A non IDAT chunk is reached*/
+    uint8_t pad_cnt;            /*Number of bytes read after the end of the compressed data*/
+
+    /*Image properties*/
+    uint32_t w;
+    uint32_t h;
+    uint8_t bit_depth;
+    uint8_t color_type;
+    uint8_t px_bytes;           /*Bytes per complete pixel, at least 1. Used by the filters*/
+    uint32_t row_bytes;         /*Size of a row without the filter type byte*/
+    uint8_t palette[256][4];    /*RGBA*/
+    bool has_key;
+    uint16_t key[3];            /*Transparent color of gray and RGB images*/
+
+    /*Inflate*/
+    uint32_t bitbuf;
+    uint8_t bitcnt;
+    uint8_t block;              /*Type of the current deflate block*/
+    bool final;
+    uint32_t stored_left;
+    uint16_t match_len;
+    uint16_t match_dist;
+    uint8_t * window;           /*The last 32 kB of the output for the back references*/
+    uint32_t out_cnt;           /*Number of bytes inflated so far*/
+    struct _lv_png_huffman_t * lit;
+    struct _lv_png_huffman_t * dist;
+
+    /*Rows*/
+    uint8_t * row;              /*The current row with the filter type byte*/
+    uint8_t * prev_row;
+    uint32_t y;                 /*Number of rows decoded so far*/
+} lv_png_stream_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start decoding a PNG image stored in the memory (C array or memory mapped file)
+ * @param data      pointer to the PNG file's content. Needs to be valid until the stream is deleted.
+ * @param size      size of `data` in bytes
+ * @return          the stream or NULL if it's not a PNG or it's not supported (interlaced or 16 bit)
+ */
+lv_png_stream_t * _lv_png_stream_create_from_data(const void * data, uint32_t size);
+
+/**
+ * Start decoding a PNG image by reading the file in small chunks
+ * @param file      pointer to an opened file. Needs to be open until the stream is deleted.
+ * @return          the stream or NULL if it's not a PNG or it's not supported (interlaced or 16 bit)
+ */
+lv_png_stream_t * _lv_png_stream_create_from_file(lv_fs_file_t * file);
+
+/**
+ * Decode the next row. Its index is `stream->y - 1` afterwards.
+ * @param stream    pointer to a stream
+ * @return          true: the row is decoded; false: no more rows or the image is corrupted
+ */
+bool _lv_png_stream_next_row(lv_png_stream_t * stream);
+
+/**
+ * Convert a part of the last decoded row to `LV_IMG_CF_TRUE_COLOR_ALPHA` format
+ * @param stream    pointer to a stream
+ * @param x         the first pixel to convert
+ * @param len       number of pixels to convert
+ * @param buf       store the pixels here. `len * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes are written.
+ */
+void _lv_png_stream_convert_row(const lv_png_stream_t * stream, uint32_t x, uint32_t len, uint8_t * buf);
+
+/**
+ * Start decoding from the first row again
+ * @param stream    pointer to a stream
+ * @return          true: success; false: couldn't seek in the source or the data is invalid
+ */
+bool _lv_png_stream_rewind(lv_png_stream_t * stream);
+
+/**
+ * Free the resources of the stream. The source (data or file) is not closed.
+ * @param stream    pointer to a stream
+ */
+void _lv_png_stream_delete(lv_png_stream_t * stream);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PNG*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PNG_STREAM_H*/
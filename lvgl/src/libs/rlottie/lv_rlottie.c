@@ -33,6 +33,7 @@ static void next_frame_task_cb(lv_timer_t * t);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_rlottie_class = {
+    .name = "rlottie",
     .constructor_cb = lv_rlottie_constructor,
     .destructor_cb = lv_rlottie_destructor,
     .instance_size = sizeof(lv_rlottie_t),
@@ -65,6 +65,11 @@
 #define SJPEG_BLOCK_WIDTH_OFFSET        20
 #define SJPEG_FRAME_INFO_ARRAY_OFFSET   22
 
+#define STRIP_CACHE_SIZE                LV_MAX(LV_SJPG_CACHE_FRAMES, 1)
+
+/*The strips are shared by the images opened in the drawing threads, the async image decoder's threads and the prefetch worker*/
+#define SJPG_USE_LOCK                   (LV_USE_OS != LV_OS_NONE)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -80,23 +85,58 @@ typedef struct {
     uint8_t * img_cache_buff;
     int img_cache_x_res;
     int img_cache_y_res;
-    uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY.
+    uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY or the file is memory mapped.
     uint32_t raw_sjpg_data_size;          //Num bytes pointed to by raw_sjpg_data.
     uint32_t raw_sjpg_data_next_read_pos; //Used for all types.
 } io_source_t;
 
 
+/*A decoded strip of an image. The strips are kept after the image is closed.*/
 typedef struct {
+    uint8_t * buf;                      //decoded strip, `sjpeg_x_res * sjpeg_single_frame_height * 3` bytes
+    uint32_t buf_size;
+    const uint8_t * src_data;           //data of the image if it's a variable
+    char * src_fn;                      //copy of the path of the image if it's a file
+    int index;                          //index of the strip or -1
+    uint32_t life;                      //used to find the least recently used strip
+    uint32_t gen;                       //incremented when the strip is replaced or invalidated
+    uint8_t busy : 1;                   //being decoded, don't replace it
+    uint8_t prefetched : 1;             //decoded in advance and not read yet
+} strip_t;
+
+#if LV_SJPG_USE_PREFETCH
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;              //wakes up the worker when a strip is requested or it should stop
+    lv_thread_sync_t done;              //signaled by the worker when a strip is decoded and somebody waits for it
+    strip_t strip;                      //the strip decoded in advance. It's swapped into the cache when it's read.
+    uint32_t gen;                       //`strip.gen` when it was requested
+    io_source_t io;                     //positioned to the requested strip
+    lv_fs_file_t file;                  //the worker's own handle of the last prefetched file
+    char * fn;                          //path of `file` or NULL if it's not opened
+    JDEC jd;
+    uint8_t * workb;
+    uint32_t waiters;                   //number of threads waiting for `done`
+    bool started;
+    bool exit;
+} prefetch_worker_t;
+#endif
+
+typedef struct _SJPEG {
     uint8_t * sjpeg_data;
     uint32_t sjpeg_data_size;
     int sjpeg_x_res;
     int sjpeg_y_res;
     int sjpeg_total_frames;
     int sjpeg_single_frame_height;
-    int sjpeg_cache_frame_index;
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
+    const char * fn;                    //path of the image or NULL if it's a variable
+    strip_t * last_strip;               //the strip of the last read line
+    uint32_t last_gen;                  //`last_strip->gen` when it was read
+    int last_frame_index;               //the frame of the last read line
+    uint8_t * own_buf;                  //used only if all strips are being decoded by other threads
+    int own_index;                      //frame in `own_buf` or -1
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
@@ -111,13 +151,42 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
                                   lv_coord_t len, uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
+static void io_source_set_file(io_source_t * io, lv_fs_file_t * file);
 static int is_jpg(const uint8_t * raw_data, size_t len);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
+static void frame_cache_init(SJPEG * sjpeg);
+static const uint8_t * get_frame(SJPEG * sjpeg, int index);
+static strip_t * find_strip(const SJPEG * sjpeg, int index);
+static strip_t * claim_strip(const SJPEG * sjpeg, int index);
+static bool assign_strip(strip_t * strip, const SJPEG * sjpeg, int index);
+static bool strip_has_src(const strip_t * strip, const uint8_t * src_data, const char * src_fn);
+static void strip_lock(void);
+static void strip_unlock(void);
+static void seek_frame(const SJPEG * sjpeg, io_source_t * io, int index);
+static bool decode_frame(io_source_t * io, JDEC * jd, uint8_t * workb, uint8_t * buf);
+#if LV_SJPG_USE_PREFETCH
+    static bool prefetch_start(void);
+    static void prefetch_stop(void);
+    static void prefetch_request(const SJPEG * sjpeg, int index);
+    static void prefetch_wait(void);
+    static strip_t * prefetch_take(const SJPEG * sjpeg, int index);
+    static void prefetch_thread_cb(void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static bool inited;
+static strip_t strips[STRIP_CACHE_SIZE];
+static uint32_t strip_life;
+static lv_split_jpeg_stats_t stats;
+#if SJPG_USE_LOCK
+    static lv_mutex_t strip_mutex;      //protects the strips, the stats and the prefetch worker
+#endif
+#if LV_SJPG_USE_PREFETCH
+    static prefetch_worker_t worker;
+#endif
 
 /**********************
  *      MACROS
@@ -133,6 +202,92 @@ void lv_split_jpeg_init(void)
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
     lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+
+    lv_memzero(strips, sizeof(strips));
+    for(int i = 0; i < STRIP_CACHE_SIZE; i++) strips[i].index = -1;
+    strip_life = 0;
+#if SJPG_USE_LOCK
+    lv_mutex_init(&strip_mutex);
+#endif
+#if LV_SJPG_USE_PREFETCH
+    lv_memzero(&worker, sizeof(worker));
+    worker.strip.index = -1;
+#endif
+    inited = true;
+}
+
+void lv_split_jpeg_deinit(void)
+{
+    if(!inited) return;
+    inited = false;
+
+#if LV_SJPG_USE_PREFETCH
+    prefetch_stop();
+#endif
+
+    for(int i = 0; i < STRIP_CACHE_SIZE; i++) {
+        lv_free(strips[i].buf);
+        lv_free(strips[i].src_fn);
+    }
+    lv_memzero(strips, sizeof(strips));
+
+#if SJPG_USE_LOCK
+    lv_mutex_delete(&strip_mutex);
+#endif
+}
+
+void lv_split_jpeg_invalidate(const void * src)
+{
+    /*`lv_img_cache_invalidate_src()` calls it before init and after deinit too*/
+    if(!inited) return;
+
+    const uint8_t * src_data = NULL;
+    const char * src_fn = NULL;
+    if(src) {
+        lv_img_src_t src_type = lv_img_src_get_type(src);
+        if(src_type == LV_IMG_SRC_VARIABLE) src_data = ((const lv_img_dsc_t *)src)->data;
+        else if(src_type == LV_IMG_SRC_FILE) src_fn = src;
+        else return;
+    }
+
+    strip_lock();
+#if LV_SJPG_USE_PREFETCH
+    /*Let the worker finish if it reads this image. Don't wait for others, e.g. on every canvas update.*/
+    while(worker.strip.busy && (src == NULL || strip_has_src(&worker.strip, src_data, src_fn))) prefetch_wait();
+
+    if(worker.fn && (src == NULL || (src_fn && strcmp(worker.fn, src_fn) == 0))) {
+        lv_fs_close(&worker.file);
+        lv_free(worker.fn);
+        worker.fn = NULL;
+    }
+    if(src == NULL || strip_has_src(&worker.strip, src_data, src_fn)) {
+        worker.strip.index = -1;
+        worker.strip.gen++;
+    }
+#endif
+
+    for(int i = 0; i < STRIP_CACHE_SIZE; i++) {
+        /*The strips being decoded now are dropped when they are ready as their `gen` changes*/
+        if(src == NULL || strip_has_src(&strips[i], src_data, src_fn)) {
+            strips[i].index = -1;
+            strips[i].gen++;
+        }
+    }
+    strip_unlock();
+}
+
+void lv_split_jpeg_get_stats(lv_split_jpeg_stats_t * stats_p)
+{
+    strip_lock();
+    *stats_p = stats;
+    strip_unlock();
+}
+
+void lv_split_jpeg_reset_stats(void)
+{
+    strip_lock();
+    lv_memzero(&stats, sizeof(stats));
+    strip_unlock();
 }
 
 /**********************
@@ -258,10 +413,8 @@ end:
             }
 
             io_source_t io_source_temp;
-            io_source_temp.type = SJPEG_IO_SOURCE_DISK;
-            io_source_temp.raw_sjpg_data_next_read_pos = 0;
+            io_source_set_file(&io_source_temp, &file);
             io_source_temp.img_cache_buff = NULL;
-            io_source_temp.lv_file = file;
             JDEC jd_tmp;
 
             JRESULT rc = jd_prepare(&jd_tmp, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, &io_source_temp);
@@ -305,7 +458,8 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
 
     if(!io) return 0;
 
-    if(io->type == SJPEG_IO_SOURCE_C_ARRAY) {
+    /*Memory mapped files are read directly like C arrays*/
+    if(io->type == SJPEG_IO_SOURCE_C_ARRAY || (io->type == SJPEG_IO_SOURCE_DISK && io->raw_sjpg_data)) {
         const uint32_t bytes_left = io->raw_sjpg_data_size - io->raw_sjpg_data_next_read_pos;
         const uint32_t to_read = ndata <= bytes_left ? (uint32_t)ndata : bytes_left;
         if(to_read == 0)
@@ -335,6 +489,31 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
     return 0;
 }
 
+/**
+ * Use an opened file as the source of the decoder.
+ * If the file system can give a direct pointer to the file (e.g. it's memory mapped)
+ * the data will be read from there without copying it through `lv_fs_read()`.
+ * @param io        the IO source to set
+ * @param file      an opened file. It will be copied into `io`
+ */
+static void io_source_set_file(io_source_t * io, lv_fs_file_t * file)
+{
+    io->type = SJPEG_IO_SOURCE_DISK;
+    io->lv_file = *file;
+    io->raw_sjpg_data_next_read_pos = 0;
+
+    const void * buf = NULL;
+    uint32_t size = 0;
+    if(lv_fs_get_buf(file, &buf, &size) == LV_FS_RES_OK) {
+        io->raw_sjpg_data = (uint8_t *)buf;
+        io->raw_sjpg_data_size = size;
+    }
+    else {
+        io->raw_sjpg_data = NULL;
+        io->raw_sjpg_data_size = 0;
+    }
+}
+
 /**
  * Open SJPG image and return the decided image
  * @param decoder pointer to the decoder where this function belongs
@@ -395,14 +574,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 offset |= *data++ << 8;
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
-            sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_malloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
-                lv_sjpg_cleanup(sjpeg);
-                sjpeg = NULL;
-                return LV_RES_INV;
-            }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
+            frame_cache_init(sjpeg);
             sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
             sjpeg->workb =   lv_malloc(TJPGD_WORKBUFF_SIZE);
             if(! sjpeg->workb) {
@@ -458,15 +630,8 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 uint8_t * img_frame_base = sjpeg->sjpeg_data;
                 sjpeg->frame_base_array[0] = img_frame_base;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_malloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_sjpg_cleanup(sjpeg);
-                    sjpeg = NULL;
-                    return LV_RES_INV;
-                }
+                frame_cache_init(sjpeg);
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_malloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -577,14 +742,7 @@ end:
                     sjpeg->frame_base_offset[i] = sjpeg->frame_base_offset[i - 1] + offset;
                 }
 
-                sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_malloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
+                frame_cache_init(sjpeg);
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_malloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -600,8 +758,8 @@ end:
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.type = SJPEG_IO_SOURCE_DISK;
-                sjpeg->io.lv_file = lv_file;
+                io_source_set_file(&sjpeg->io, &lv_file);
+                sjpeg->fn = fn;
                 dsc->img_data = NULL;
                 return LV_RES_OK;
             }
@@ -636,10 +794,8 @@ end:
             }
 
             io_source_t io_source_temp;
-            io_source_temp.type = SJPEG_IO_SOURCE_DISK;
-            io_source_temp.raw_sjpg_data_next_read_pos = 0;
+            io_source_set_file(&io_source_temp, &lv_file);
             io_source_temp.img_cache_buff = NULL;
-            io_source_temp.lv_file = lv_file;
 
             JDEC jd_tmp;
 
@@ -665,15 +821,8 @@ end:
                 int img_frame_start_offset = 0;
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_malloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
+                frame_cache_init(sjpeg);
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_malloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -689,8 +838,8 @@ end:
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.type = SJPEG_IO_SOURCE_DISK;
-                sjpeg->io.lv_file = lv_file;
+                io_source_set_file(&sjpeg->io, &lv_file);
+                sjpeg->fn = fn;
                 dsc->img_data = NULL;
                 return LV_RES_OK;
 
@@ -722,143 +871,59 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
                                   lv_coord_t len, uint8_t * buf)
 {
     LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
-            }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(!sjpeg) return LV_RES_INV;
+
+    /*The strip can be replaced by an other thread when it's not locked*/
+    strip_lock();
+    const uint8_t * frame = get_frame(sjpeg, y / sjpeg->sjpeg_single_frame_height);
+    if(!frame) {
+        strip_unlock();
+        return LV_RES_INV;
+    }
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
+    int offset = 0;
+    const uint8_t * cache = frame + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res * 3;
 
 #if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
-        }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
-
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
+    for(int i = 0; i < len; i++) {
+        buf[offset + 3] = 0xff;
+        buf[offset + 2] = *cache++;
+        buf[offset + 1] = *cache++;
+        buf[offset + 0] = *cache++;
+        offset += 4;
     }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
 
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
 #elif  LV_COLOR_DEPTH == 16
 
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
+    for(int i = 0; i < len; i++) {
+        uint16_t col_16bit = (*cache++ & 0xf8) << 8;
+        col_16bit |= (*cache++ & 0xFC) << 3;
+        col_16bit |= (*cache++ >> 3);
 #if  LV_BIG_ENDIAN_SYSTEM == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
 #else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
 #endif // LV_BIG_ENDIAN_SYSTEM
-        }
+    }
 
 #elif  LV_COLOR_DEPTH == 8
 
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-
+    for(int i = 0; i < len; i++) {
+        uint8_t col_8bit = (*cache++ & 0xC0);
+        col_8bit |= (*cache++ & 0xe0) >> 2;
+        col_8bit |= (*cache++ & 0xe0) >> 5;
+        buf[offset++] = col_8bit;
+    }
 #else
 #error Unsupported LV_COLOR_DEPTH
 
 
 #endif // LV_COLOR_DEPTH
-
-        return LV_RES_OK;
-    }
-end:
-    return LV_RES_INV;
+    strip_unlock();
+    return LV_RES_OK;
 }
 
 /**
@@ -899,7 +964,8 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
 
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
-    if(sjpeg->frame_cache) lv_free(sjpeg->frame_cache);
+    /*The decoded strips are kept in the cache*/
+    if(sjpeg->own_buf) lv_free(sjpeg->own_buf);
     if(sjpeg->frame_base_array) lv_free(sjpeg->frame_base_array);
     if(sjpeg->frame_base_offset) lv_free(sjpeg->frame_base_offset);
     if(sjpeg->tjpeg_jd) lv_free(sjpeg->tjpeg_jd);
@@ -914,4 +980,420 @@ static void lv_sjpg_cleanup(SJPEG * sjpeg)
     lv_free(sjpeg);
 }
 
+/**
+ * Prepare an opened image to read its strips
+ * @param sjpeg     an image with known resolution and frame height
+ */
+static void frame_cache_init(SJPEG * sjpeg)
+{
+    sjpeg->last_strip = NULL;
+    sjpeg->last_frame_index = -1;
+    sjpeg->own_index = -1;
+}
+
+/**
+ * Get a decoded frame from the strip cache or decode it into the least recently used strip.
+ * Call it with the lock held.
+ * @param sjpeg     an opened image
+ * @param index     index of the frame
+ * @return          the decoded frame or NULL on error. It can be read until the lock is released.
+ */
+static const uint8_t * get_frame(SJPEG * sjpeg, int index)
+{
+    strip_t * strip = sjpeg->last_strip;
+    if(strip && strip->gen == sjpeg->last_gen && strip->index == index && !strip->busy) {
+        return strip->buf;
+    }
+    if(sjpeg->own_index == index) return sjpeg->own_buf;
+
+    strip = find_strip(sjpeg, index);
+#if LV_SJPG_USE_PREFETCH
+    while(strip == &worker.strip && worker.strip.busy) {
+        prefetch_wait();
+        strip = find_strip(sjpeg, index);
+    }
+
+    if(strip == &worker.strip) strip = prefetch_take(sjpeg, index);
+#endif
+
+    if(strip) {
+        if(strip->prefetched) {
+            strip->prefetched = 0;
+            stats.prefetch_cnt++;
+        }
+        else if(index != sjpeg->last_frame_index) {
+            stats.hit_cnt++;
+        }
+    }
+    else {
+        uint8_t * buf;
+        uint32_t gen = 0;
+        strip = claim_strip(sjpeg, index);
+        if(strip) {
+            buf = strip->buf;
+            gen = strip->gen;
+        }
+        else {
+            /*All strips are being decoded by other threads*/
+            if(sjpeg->own_buf == NULL) {
+                sjpeg->own_buf = lv_malloc((uint32_t)sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
+                if(sjpeg->own_buf == NULL) return NULL;
+            }
+            buf = sjpeg->own_buf;
+            sjpeg->own_index = -1;
+        }
+
+        strip_unlock();
+        seek_frame(sjpeg, &sjpeg->io, index);
+        bool ok = decode_frame(&sjpeg->io, sjpeg->tjpeg_jd, sjpeg->workb, buf);
+        strip_lock();
+
+        if(strip) {
+            strip->busy = 0;
+            /*Drop it if it was invalidated in the meantime. It still can be read while the lock is held.*/
+            if(!ok || strip->gen != gen) strip->index = -1;
+        }
+        else if(ok) {
+            sjpeg->own_index = index;
+        }
+        if(!ok) return NULL;
+        stats.decode_cnt++;
+        if(strip == NULL) {
+            sjpeg->last_frame_index = index;
+            return buf;
+        }
+    }
+
+    strip->life = ++strip_life;
+    sjpeg->last_strip = strip;
+    sjpeg->last_gen = strip->gen;
+
+#if LV_SJPG_USE_PREFETCH
+    /*Decode the next frame while this one is drawn. The worker's strip is read now so it can't be reused yet.*/
+    if(strip != &worker.strip && index != sjpeg->last_frame_index && index + 1 < sjpeg->sjpeg_total_frames) {
+        prefetch_request(sjpeg, index + 1);
+    }
+#endif
+
+    sjpeg->last_frame_index = index;
+    return strip->buf;
+}
+
+/**
+ * Find a decoded (or being decoded by the worker) frame of an image. Call it with the lock held.
+ * @param sjpeg     an opened image
+ * @param index     index of the frame
+ * @return          the strip containing the frame or NULL if it's not decoded
+ */
+static strip_t * find_strip(const SJPEG * sjpeg, int index)
+{
+    const uint8_t * src_data = sjpeg->fn ? NULL : sjpeg->sjpeg_data;
+    for(int i = 0; i < STRIP_CACHE_SIZE; i++) {
+        strip_t * strip = &strips[i];
+        if(strip->index == index && !strip->busy && strip_has_src(strip, src_data, sjpeg->fn)) return strip;
+    }
+
+#if LV_SJPG_USE_PREFETCH
+    if(worker.strip.index == index && strip_has_src(&worker.strip, src_data, sjpeg->fn)) return &worker.strip;
+#endif
+
+    return NULL;
+}
+
+/**
+ * Assign the least recently used strip which is not being decoded to a frame of an image and mark it busy.
+ * Call it with the lock held.
+ * @param sjpeg     an opened image
+ * @param index     index of the frame
+ * @return          the strip or NULL if all strips are busy or out of memory
+ */
+static strip_t * claim_strip(const SJPEG * sjpeg, int index)
+{
+    strip_t * lru = NULL;
+    for(int i = 0; i < STRIP_CACHE_SIZE; i++) {
+        strip_t * strip = &strips[i];
+        if(strip->busy) continue;
+        if(lru == NULL || strip->life < lru->life) lru = strip;
+    }
+
+    if(lru == NULL || !assign_strip(lru, sjpeg, index)) return NULL;
+    lru->busy = 1;
+    return lru;
+}
+
+/**
+ * Set the image and frame of a strip and make its buffer large enough for the frame
+ * @param strip     a strip which is not busy
+ * @param sjpeg     an opened image
+ * @param index     index of the frame
+ * @return          true: assigned; false: out of memory
+ */
+static bool assign_strip(strip_t * strip, const SJPEG * sjpeg, int index)
+{
+    strip->index = -1;
+    strip->gen++;
+    strip->prefetched = 0;
+
+    uint32_t size = (uint32_t)sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3;
+    if(strip->buf_size < size) {
+        uint8_t * buf = lv_realloc(strip->buf, size);
+        if(buf == NULL) return false;
+        strip->buf = buf;
+        strip->buf_size = size;
+    }
+
+    if(sjpeg->fn) {
+        if(strip->src_fn == NULL || strcmp(strip->src_fn, sjpeg->fn) != 0) {
+            size_t len = strlen(sjpeg->fn) + 1;
+            char * fn = lv_realloc(strip->src_fn, len);
+            if(fn == NULL) return false;
+            lv_memcpy(fn, sjpeg->fn, len);
+            strip->src_fn = fn;
+        }
+        strip->src_data = NULL;
+    }
+    else {
+        lv_free(strip->src_fn);
+        strip->src_fn = NULL;
+        strip->src_data = sjpeg->sjpeg_data;
+    }
+
+    strip->index = index;
+    return true;
+}
+
+static bool strip_has_src(const strip_t * strip, const uint8_t * src_data, const char * src_fn)
+{
+    if(src_fn) return strip->src_fn && strcmp(strip->src_fn, src_fn) == 0;
+    else return strip->src_fn == NULL && strip->src_data == src_data;
+}
+
+static void strip_lock(void)
+{
+#if SJPG_USE_LOCK
+    lv_mutex_lock(&strip_mutex);
+#endif
+}
+
+static void strip_unlock(void)
+{
+#if SJPG_USE_LOCK
+    lv_mutex_unlock(&strip_mutex);
+#endif
+}
+
+/**
+ * Set the read position of an IO source to a frame of an image
+ * @param sjpeg     an opened image. Only the fields set when it was opened are used.
+ * @param io        the IO source to position. Its file (if any) is seeked too.
+ * @param index     index of the frame
+ */
+static void seek_frame(const SJPEG * sjpeg, io_source_t * io, int index)
+{
+    io->img_cache_x_res = sjpeg->sjpeg_x_res;
+    if(sjpeg->frame_base_array) {
+        io->raw_sjpg_data = sjpeg->frame_base_array[index];
+        if(index == (sjpeg->sjpeg_total_frames - 1)) {
+            /*This is the last frame. */
+            const uint32_t frame_offset = (uint32_t)(io->raw_sjpg_data - sjpeg->sjpeg_data);
+            io->raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
+        }
+        else {
+            io->raw_sjpg_data_size = (uint32_t)(sjpeg->frame_base_array[index + 1] - io->raw_sjpg_data);
+        }
+        io->raw_sjpg_data_next_read_pos = 0;
+    }
+    else {
+        io->raw_sjpg_data_next_read_pos = (uint32_t)sjpeg->frame_base_offset[index];
+        /*Memory mapped files are read from `raw_sjpg_data_next_read_pos`*/
+        if(io->raw_sjpg_data == NULL) lv_fs_seek(&io->lv_file, io->raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+    }
+}
+
+/**
+ * Decode a frame from a positioned IO source
+ * @param io        the IO source positioned with `seek_frame()`
+ * @param jd        a decoder
+ * @param workb     work buffer of the decoder
+ * @param buf       store the decoded frame here
+ * @return          true: decoded; false: error
+ */
+static bool decode_frame(io_source_t * io, JDEC * jd, uint8_t * workb, uint8_t * buf)
+{
+    io->img_cache_buff = buf;
+    if(jd_prepare(jd, input_func, workb, (size_t)TJPGD_WORKBUFF_SIZE, io) != JDR_OK) return false;
+    return jd_decomp(jd, img_data_cb, 0) == JDR_OK;
+}
+
+#if LV_SJPG_USE_PREFETCH
+
+/**
+ * Start the worker thread which decodes the frames in advance. It runs until `lv_split_jpeg_deinit()`.
+ * Call it with the lock held.
+ * @return          true: started; false: error, the frames will be decoded when they are needed
+ */
+static bool prefetch_start(void)
+{
+    worker.workb = lv_malloc(TJPGD_WORKBUFF_SIZE);
+    if(worker.workb == NULL) return false;
+
+    lv_thread_sync_init(&worker.sync);
+    lv_thread_sync_init(&worker.done);
+    if(lv_thread_init(&worker.thread, LV_THREAD_PRIO_LOW, prefetch_thread_cb, 0, NULL) != LV_RES_OK) {
+        LV_LOG_WARN("couldn't create the prefetch thread");
+        lv_thread_sync_delete(&worker.done);
+        lv_thread_sync_delete(&worker.sync);
+        lv_free(worker.workb);
+        worker.workb = NULL;
+        return false;
+    }
+
+    worker.started = true;
+    return true;
+}
+
+static void prefetch_stop(void)
+{
+    if(worker.started) {
+        strip_lock();
+        worker.exit = true;
+        strip_unlock();
+
+        lv_thread_sync_signal(&worker.sync);
+        lv_thread_delete(&worker.thread);
+        lv_thread_sync_delete(&worker.done);
+        lv_thread_sync_delete(&worker.sync);
+    }
+
+    if(worker.fn) {
+        lv_fs_close(&worker.file);
+        lv_free(worker.fn);
+    }
+    lv_free(worker.workb);
+    lv_free(worker.strip.buf);
+    lv_free(worker.strip.src_fn);
+    lv_memzero(&worker, sizeof(worker));
+    worker.strip.index = -1;
+}
+
+/**
+ * Let the worker decode a frame if it's idle and the frame is not decoded yet. Call it with the lock held.
+ * The worker gets its own copy of everything it needs so the image can be closed any time.
+ * @param sjpeg     an opened image
+ * @param index     index of the frame
+ */
+static void prefetch_request(const SJPEG * sjpeg, int index)
+{
+    if(worker.strip.busy) return;
+    if(find_strip(sjpeg, index)) return;
+    if(!worker.started && !prefetch_start()) return;
+
+    if(sjpeg->fn) {
+        /*Files are read through the worker's own handle as the image's handle is closed with the image*/
+        if(worker.fn == NULL || strcmp(worker.fn, sjpeg->fn) != 0) {
+            if(worker.fn) {
+                lv_fs_close(&worker.file);
+                lv_free(worker.fn);
+                worker.fn = NULL;
+            }
+
+            size_t len = strlen(sjpeg->fn) + 1;
+            char * fn = lv_malloc(len);
+            if(fn == NULL) return;
+            if(lv_fs_open(&worker.file, sjpeg->fn, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+                lv_free(fn);
+                return;
+            }
+            lv_memcpy(fn, sjpeg->fn, len);
+            worker.fn = fn;
+        }
+        io_source_set_file(&worker.io, &worker.file);
+    }
+    else {
+        worker.io = sjpeg->io;
+    }
+
+    if(!assign_strip(&worker.strip, sjpeg, index)) return;
+    seek_frame(sjpeg, &worker.io, index);
+    worker.strip.busy = 1;
+    worker.gen = worker.strip.gen;
+    lv_thread_sync_signal(&worker.sync);
+}
+
+/**
+ * Wait until the worker finishes a frame. Call it with the lock held.
+ */
+static void prefetch_wait(void)
+{
+    worker.waiters++;
+    strip_unlock();
+    lv_thread_sync_wait(&worker.done);
+    strip_lock();
+    worker.waiters--;
+
+    /*Only one thread is woken up so wake up the next one too*/
+    if(worker.waiters > 0) lv_thread_sync_signal(&worker.done);
+}
+
+/**
+ * Move the frame decoded by the worker into the strip cache. Call it with the lock held.
+ * @param sjpeg     an opened image
+ * @param index     index of the frame in the worker's strip
+ * @return          the strip containing the frame. It's the worker's strip if all strips are busy.
+ */
+static strip_t * prefetch_take(const SJPEG * sjpeg, int index)
+{
+    strip_t * lru = claim_strip(sjpeg, index);
+    if(lru == NULL) return &worker.strip;
+
+    /*Swap the buffers, the worker will decode the next frame into the replaced one*/
+    uint8_t * buf = lru->buf;
+    uint32_t buf_size = lru->buf_size;
+    lru->buf = worker.strip.buf;
+    lru->buf_size = worker.strip.buf_size;
+    lru->prefetched = worker.strip.prefetched;
+    lru->busy = 0;
+    worker.strip.buf = buf;
+    worker.strip.buf_size = buf_size;
+    worker.strip.index = -1;
+    worker.strip.prefetched = 0;
+    worker.strip.gen++;
+
+    return lru;
+}
+
+static void prefetch_thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    while(1) {
+        strip_lock();
+        if(worker.exit) {
+            strip_unlock();
+            break;
+        }
+        bool busy = worker.strip.busy;
+        strip_unlock();
+
+        if(!busy) {
+            lv_thread_sync_wait(&worker.sync);
+            continue;
+        }
+
+        /*`strip.buf`, `io`, `file`, `jd` and `workb` are used only by the worker while `strip.busy` is set*/
+        bool ok = decode_frame(&worker.io, &worker.jd, worker.workb, worker.strip.buf);
+
+        strip_lock();
+        worker.strip.busy = 0;
+        if(ok && worker.strip.gen == worker.gen) worker.strip.prefetched = 1;
+        else worker.strip.index = -1;
+        bool wake = worker.waiters > 0;
+        strip_unlock();
+
+        if(wake) lv_thread_sync_signal(&worker.done);
+    }
+}
+
+#endif /*LV_SJPG_USE_PREFETCH*/
+
 #endif /*LV_USE_SJPG*/
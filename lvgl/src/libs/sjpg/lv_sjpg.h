@@ -20,16 +20,49 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Decode the next strip in advance on a separate thread*/
+#define LV_SJPG_USE_PREFETCH (LV_SJPG_PREFETCH && LV_USE_OS != LV_OS_NONE)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    uint32_t decode_cnt;        /*Number of strips decoded while drawing*/
+    uint32_t prefetch_cnt;      /*Number of strips decoded in advance and used*/
+    uint32_t hit_cnt;           /*Number of times a strip was found in the cache*/
+} lv_split_jpeg_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 void lv_split_jpeg_init(void);
 
+/**
+ * Stop the prefetch worker and free the decoded strips
+ */
+void lv_split_jpeg_deinit(void);
+
+/**
+ * Drop the decoded strips of an image. The strips are kept after the image is closed.
+ * `lv_img_cache_invalidate_src()` calls it, so it's enough to call that when an image file or variable changes.
+ * @param src       the image (file path or `lv_img_dsc_t` variable) or NULL to drop all strips
+ */
+void lv_split_jpeg_invalidate(const void * src);
+
+/**
+ * Get the statistics of the strip decoding of all JPG and SJPG images.
+ * E.g. reset them in every refresh to see how many strips are decoded per frame.
+ * @param stats     store the statistics here
+ */
+void lv_split_jpeg_get_stats(lv_split_jpeg_stats_t * stats);
+
+/**
+ * Reset the statistics of the strip decoding
+ */
+void lv_split_jpeg_reset_stats(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -10,6 +10,11 @@
 
 #include <stdint.h>
 
+/*Operating system types for LV_USE_OS*/
+#define LV_OS_NONE      0
+#define LV_OS_PTHREAD   1
+#define LV_OS_CUSTOM    255
+
 /* Handle special Kconfig options */
 #ifndef LV_KCONFIG_IGNORE
     #include "lv_conf_kconfig.h"
@@ -237,6 +242,34 @@
     #endif
 #endif
 
+/*=================
+ * OPERATING SYSTEM
+ *=================*/
+
+/*Select an operating system to use. Possible options:
+ * - LV_OS_NONE
+ * - LV_OS_PTHREAD
+ * - LV_OS_CUSTOM
+ *It's used by the modules which can use threads (e.g. GIF pre-decoding)
+ *and to make the built-in memory manager thread safe.*/
+#ifndef LV_USE_OS
+    #ifdef CONFIG_LV_USE_OS
+        #define LV_USE_OS CONFIG_LV_USE_OS
+    #else
+        #define LV_USE_OS   LV_OS_NONE
+    #endif
+#endif
+
+#if LV_USE_OS == LV_OS_CUSTOM
+    #ifndef LV_OS_CUSTOM_INCLUDE
+        #ifdef CONFIG_LV_OS_CUSTOM_INCLUDE
+            #define LV_OS_CUSTOM_INCLUDE CONFIG_LV_OS_CUSTOM_INCLUDE
+        #else
+            #define LV_OS_CUSTOM_INCLUDE <stdint.h>
+        #endif
+    #endif
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -347,7 +380,7 @@
 
     /*Allow buffering some shadow calculation.
     *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost which is shared by the recently used smaller shadows*/
     #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
         #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
             #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
@@ -368,6 +401,19 @@
         #endif
     #endif
 
+    /*Size of the cache in bytes for the anti-aliased edges of the recently drawn arcs and rounded rectangles.
+     *The quarter of a ring is cached by its radius and width, so e.g. arcs which change only their angles,
+     *rounded backgrounds and borders are drawn without calculating their edges again.
+     *About `width * radius` bytes are used per ring.
+     *0: to disable caching */
+    #ifndef LV_DRAW_SW_RING_CACHE_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_RING_CACHE_SIZE
+            #define LV_DRAW_SW_RING_CACHE_SIZE CONFIG_LV_DRAW_SW_RING_CACHE_SIZE
+        #else
+            #define LV_DRAW_SW_RING_CACHE_SIZE 0
+        #endif
+    #endif
+
     /*Default gradient buffer size.
      *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
      *LV_DRAW_SW_GRADIENT_CACHE_DEF_SIZE sets the size of this cache in bytes.
@@ -584,6 +630,40 @@
         #endif
     #endif
 
+    /*1: Only copy the format string pointer and the arguments of the logs into a ring buffer of the logging thread
+     *and format and print them on a background thread. Requires `LV_USE_OS`.
+     *The format strings need to be string literals as they are formatted later.*/
+    #ifndef LV_LOG_ASYNC
+        #ifdef CONFIG_LV_LOG_ASYNC
+            #define LV_LOG_ASYNC CONFIG_LV_LOG_ASYNC
+        #else
+            #define LV_LOG_ASYNC 0
+        #endif
+    #endif
+    #if LV_LOG_ASYNC
+        #ifndef LV_LOG_ASYNC_BUF_SIZE
+            #ifdef CONFIG_LV_LOG_ASYNC_BUF_SIZE
+                #define LV_LOG_ASYNC_BUF_SIZE CONFIG_LV_LOG_ASYNC_BUF_SIZE
+            #else
+                #define LV_LOG_ASYNC_BUF_SIZE   (16 * 1024) /*Size of the ring buffer of each thread [bytes]. Should be a power of 2.*/
+            #endif
+        #endif
+        #ifndef LV_LOG_ASYNC_THREAD_CNT
+            #ifdef CONFIG_LV_LOG_ASYNC_THREAD_CNT
+                #define LV_LOG_ASYNC_THREAD_CNT CONFIG_LV_LOG_ASYNC_THREAD_CNT
+            #else
+                #define LV_LOG_ASYNC_THREAD_CNT 4           /*Number of threads which can log asynchronously. The others log synchronously.*/
+            #endif
+        #endif
+        #ifndef LV_LOG_ASYNC_RATE_LIMIT
+            #ifdef CONFIG_LV_LOG_ASYNC_RATE_LIMIT
+                #define LV_LOG_ASYNC_RATE_LIMIT CONFIG_LV_LOG_ASYNC_RATE_LIMIT
+            #else
+                #define LV_LOG_ASYNC_RATE_LIMIT 100         /*Max. number of logs per second from a line of code. 0: no limit*/
+            #endif
+        #endif
+    #endif
+
     /*Enable/disable LV_LOG_TRACE in modules that produces a huge number of logs*/
     #ifndef LV_LOG_TRACE_MEM
         #ifdef _LV_KCONFIG_PRESENT
@@ -792,6 +872,26 @@
     #endif
 #endif
 
+/*1: Record the begin/end of the main rendering steps (timer handler, layout, refresh, draw, flush, indev read)
+ *into a ring buffer. `lv_profiler_flush()` writes them in Chrome trace event (JSON) format.*/
+#ifndef LV_USE_PROFILER
+    #ifdef CONFIG_LV_USE_PROFILER
+        #define LV_USE_PROFILER CONFIG_LV_USE_PROFILER
+    #else
+        #define LV_USE_PROFILER 0
+    #endif
+#endif
+#if LV_USE_PROFILER
+    /*Number of events to store. When the buffer is full the oldest events are overwritten.*/
+    #ifndef LV_PROFILER_BUF_SIZE
+        #ifdef CONFIG_LV_PROFILER_BUF_SIZE
+            #define LV_PROFILER_BUF_SIZE CONFIG_LV_PROFILER_BUF_SIZE
+        #else
+            #define LV_PROFILER_BUF_SIZE 4096
+        #endif
+    #endif
+#endif
+
 /*Maximum buffer size to allocate for rotation.
  *Only used if software rotation is enabled in the display driver.*/
 #ifndef LV_DISP_ROT_MAX_BUF
@@ -846,6 +946,54 @@
     #endif
 #endif
 
+/*Decode image files on worker threads instead of while rendering. Requires `LV_USE_OS`.
+ *A placeholder is drawn until an image is decoded and then the image is swapped in.*/
+#ifndef LV_USE_IMG_DECODER_ASYNC
+    #ifdef CONFIG_LV_USE_IMG_DECODER_ASYNC
+        #define LV_USE_IMG_DECODER_ASYNC CONFIG_LV_USE_IMG_DECODER_ASYNC
+    #else
+        #define LV_USE_IMG_DECODER_ASYNC 0
+    #endif
+#endif
+#if LV_USE_IMG_DECODER_ASYNC
+    #ifndef LV_IMG_DECODER_ASYNC_THREADS
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_IMG_DECODER_ASYNC_THREADS
+                #define LV_IMG_DECODER_ASYNC_THREADS CONFIG_LV_IMG_DECODER_ASYNC_THREADS
+            #else
+                #define LV_IMG_DECODER_ASYNC_THREADS 0
+            #endif
+        #else
+            #define LV_IMG_DECODER_ASYNC_THREADS 1                                  /*Number of worker threads*/
+        #endif
+    #endif
+    #ifndef LV_IMG_DECODER_ASYNC_CACHE_SIZE
+        #ifdef CONFIG_LV_IMG_DECODER_ASYNC_CACHE_SIZE
+            #define LV_IMG_DECODER_ASYNC_CACHE_SIZE CONFIG_LV_IMG_DECODER_ASYNC_CACHE_SIZE
+        #else
+            #define LV_IMG_DECODER_ASYNC_CACHE_SIZE (1024 * 1024)                   /*Max. memory of the decoded images [bytes]*/
+        #endif
+    #endif
+    #ifndef LV_IMG_DECODER_ASYNC_PLACEHOLDER_COLOR
+        #ifdef CONFIG_LV_IMG_DECODER_ASYNC_PLACEHOLDER_COLOR
+            #define LV_IMG_DECODER_ASYNC_PLACEHOLDER_COLOR CONFIG_LV_IMG_DECODER_ASYNC_PLACEHOLDER_COLOR
+        #else
+            #define LV_IMG_DECODER_ASYNC_PLACEHOLDER_COLOR lv_color_hex(0xe0e0e0)   /*Color of the placeholder*/
+        #endif
+    #endif
+#endif
+
+/*Max. memory used by the cached layers of the objects with `LV_OBJ_FLAG_CACHE_LAYER` [bytes].
+ *A cached object and its children are redrawn only where they have changed.
+ *If the limit is reached the least recently drawn layers are freed.
+ *0: to disable layer caching*/
+#ifndef LV_LAYER_CACHE_MAX_SIZE
+    #ifdef CONFIG_LV_LAYER_CACHE_MAX_SIZE
+        #define LV_LAYER_CACHE_MAX_SIZE CONFIG_LV_LAYER_CACHE_MAX_SIZE
+    #else
+        #define LV_LAYER_CACHE_MAX_SIZE 0
+    #endif
+#endif
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -1300,6 +1448,17 @@
     #endif
 #endif
 
+/*Size of the cache in bytes for the line breaks and line widths of the recently measured or drawn texts.
+ *It helps if the same short texts (e.g. "25.3 C") are set again and again.
+ *0: to disable caching*/
+#ifndef LV_TXT_LAYOUT_CACHE_SIZE
+    #ifdef CONFIG_LV_TXT_LAYOUT_CACHE_SIZE
+        #define LV_TXT_LAYOUT_CACHE_SIZE CONFIG_LV_TXT_LAYOUT_CACHE_SIZE
+    #else
+        #define LV_TXT_LAYOUT_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -1672,6 +1831,18 @@
     #endif
 #endif
 
+#ifndef LV_USE_READOUT
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_READOUT
+            #define LV_USE_READOUT CONFIG_LV_USE_READOUT
+        #else
+            #define LV_USE_READOUT 0
+        #endif
+    #else
+        #define LV_USE_READOUT    1   /*Requires: lv_label*/
+    #endif
+#endif
+
 #ifndef LV_USE_ROLLER
     #ifdef _LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_ROLLER
@@ -1795,6 +1966,19 @@
         #define LV_USE_TABLE      1
     #endif
 #endif
+#if LV_USE_TABLE
+    #ifndef LV_TABLE_VIRTUAL
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_TABLE_VIRTUAL
+                #define LV_TABLE_VIRTUAL CONFIG_LV_TABLE_VIRTUAL
+            #else
+                #define LV_TABLE_VIRTUAL 0
+            #endif
+        #else
+            #define LV_TABLE_VIRTUAL 1   /*Allow getting the cells from a callback on demand to show very many rows*/
+        #endif
+    #endif
+#endif
 
 #ifndef LV_USE_TABVIEW
     #ifdef _LV_KCONFIG_PRESENT
@@ -1938,6 +2122,27 @@
     #endif
 #endif
 
+/*Remember the children and the tracks of flex and grid containers to skip
+ *the tracks and cells which haven't changed when the layout is updated again.
+ *Needs about 40 bytes per child of the containers.*/
+#ifndef LV_USE_LAYOUT_CACHE
+    #ifdef CONFIG_LV_USE_LAYOUT_CACHE
+        #define LV_USE_LAYOUT_CACHE CONFIG_LV_USE_LAYOUT_CACHE
+    #else
+        #define LV_USE_LAYOUT_CACHE 0
+    #endif
+#endif
+#if LV_USE_LAYOUT_CACHE
+    /*Only the containers with at least this many children are cached. The smaller ones are updated quickly anyway.*/
+    #ifndef LV_LAYOUT_CACHE_MIN_CHILD_CNT
+        #ifdef CONFIG_LV_LAYOUT_CACHE_MIN_CHILD_CNT
+            #define LV_LAYOUT_CACHE_MIN_CHILD_CNT CONFIG_LV_LAYOUT_CACHE_MIN_CHILD_CNT
+        #else
+            #define LV_LAYOUT_CACHE_MIN_CHILD_CNT 16
+        #endif
+    #endif
+#endif
+
 /*====================
  * 3RD PARTS LIBRARIES
  *====================*/
@@ -2040,6 +2245,31 @@
     #endif
 #endif
 
+/*API for mmap. Read only, the files are mapped into the memory and `lv_fs_get_buf()` gives direct access to them*/
+#ifndef LV_USE_FS_MMAP
+    #ifdef CONFIG_LV_USE_FS_MMAP
+        #define LV_USE_FS_MMAP CONFIG_LV_USE_FS_MMAP
+    #else
+        #define LV_USE_FS_MMAP 0
+    #endif
+#endif
+#if LV_USE_FS_MMAP
+    #ifndef LV_FS_MMAP_LETTER
+        #ifdef CONFIG_LV_FS_MMAP_LETTER
+            #define LV_FS_MMAP_LETTER CONFIG_LV_FS_MMAP_LETTER
+        #else
+            #define LV_FS_MMAP_LETTER '\0'      /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+        #endif
+    #endif
+    #ifndef LV_FS_MMAP_PATH
+        #ifdef CONFIG_LV_FS_MMAP_PATH
+            #define LV_FS_MMAP_PATH CONFIG_LV_FS_MMAP_PATH
+        #else
+            #define LV_FS_MMAP_PATH ""          /*Set the working directory. File/directory paths will be appended to it.*/
+        #endif
+    #endif
+#endif
+
 /*API for FATFS (needs to be added separately). Uses f_open, f_read, etc*/
 #ifndef LV_USE_FS_FATFS
     #ifdef CONFIG_LV_USE_FS_FATFS
@@ -2073,6 +2303,17 @@
         #define LV_USE_PNG 0
     #endif
 #endif
+#if LV_USE_PNG
+    /*Don't cache the decoded image but decode the required lines when drawing if the decoded image
+     *would need at least this many bytes. Saves RAM but redrawing the image is slower. 0: always decode the whole image*/
+    #ifndef LV_PNG_READ_LINE_MIN_SIZE
+        #ifdef CONFIG_LV_PNG_READ_LINE_MIN_SIZE
+            #define LV_PNG_READ_LINE_MIN_SIZE CONFIG_LV_PNG_READ_LINE_MIN_SIZE
+        #else
+            #define LV_PNG_READ_LINE_MIN_SIZE 0
+        #endif
+    #endif
+#endif
 
 /*BMP decoder library*/
 #ifndef LV_USE_BMP
@@ -2092,6 +2333,29 @@
         #define LV_USE_SJPG 0
     #endif
 #endif
+#if LV_USE_SJPG
+    /*Number of decoded strips kept for all JPG and SJPG images. Each strip needs `width * strip height * 3` bytes.
+     *The strips are kept after the image is closed, so redrawing a part of an image doesn't decode it again*/
+    #ifndef LV_SJPG_CACHE_FRAMES
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_SJPG_CACHE_FRAMES
+                #define LV_SJPG_CACHE_FRAMES CONFIG_LV_SJPG_CACHE_FRAMES
+            #else
+                #define LV_SJPG_CACHE_FRAMES 0
+            #endif
+        #else
+            #define LV_SJPG_CACHE_FRAMES 1
+        #endif
+    #endif
+    /*1: Decode the strip below the drawn one in advance on a separate thread. Requires `LV_USE_OS`.*/
+    #ifndef LV_SJPG_PREFETCH
+        #ifdef CONFIG_LV_SJPG_PREFETCH
+            #define LV_SJPG_PREFETCH CONFIG_LV_SJPG_PREFETCH
+        #else
+            #define LV_SJPG_PREFETCH 0
+        #endif
+    #endif
+#endif
 
 /*GIF decoder library*/
 #ifndef LV_USE_GIF
@@ -2101,6 +2365,17 @@
         #define LV_USE_GIF 0
     #endif
 #endif
+#if LV_USE_GIF
+    /*Number of frames to decode in advance on a separate thread. Requires `LV_USE_OS`.
+     *Each frame needs a buffer as large as the GIF. 0: decode the frames in `lv_timer_handler()`*/
+    #ifndef LV_GIF_PREDECODE_FRAMES
+        #ifdef CONFIG_LV_GIF_PREDECODE_FRAMES
+            #define LV_GIF_PREDECODE_FRAMES CONFIG_LV_GIF_PREDECODE_FRAMES
+        #else
+            #define LV_GIF_PREDECODE_FRAMES 0
+        #endif
+    #endif
+#endif
 
 /*QR code library*/
 #ifndef LV_USE_QRCODE
@@ -2199,6 +2474,16 @@
         #define LV_USE_SNAPSHOT 0
     #endif
 #endif
+#if LV_USE_SNAPSHOT
+    /*1: Encode the snapshots of the snapshot sessions on a worker thread. Requires `LV_USE_OS`.*/
+    #ifndef LV_SNAPSHOT_ENCODE_ASYNC
+        #ifdef CONFIG_LV_SNAPSHOT_ENCODE_ASYNC
+            #define LV_SNAPSHOT_ENCODE_ASYNC CONFIG_LV_SNAPSHOT_ENCODE_ASYNC
+        #else
+            #define LV_SNAPSHOT_ENCODE_ASYNC 0
+        #endif
+    #endif
+#endif
 
 /*1: Enable Monkey test*/
 #ifndef LV_USE_MONKEY
@@ -157,6 +157,9 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
                 /*If remaining data chuck is bigger than buffer size, then do not use cache, instead read it directly from FS*/
                 res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)(buf + buffer_remaining_length),
                                            btr - buffer_remaining_length, &bytes_read_to_buffer);
+                /*The FS position is not at the end of the buffer anymore so invalidate it*/
+                file_p->cache->start = UINT32_MAX;
+                file_p->cache->end = UINT32_MAX - 1;
             }
             else {
                 /*If remaining data chunk is smaller than buffer size, then read into cache buffer*/
@@ -175,6 +178,9 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
         if(btr > buffer_size) {
             /*If bigger data is requested, then do not use cache, instead read it directly*/
             res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)buf, btr, br);
+            /*The FS position is not at the end of the buffer anymore so invalidate it*/
+            file_p->cache->start = UINT32_MAX;
+            file_p->cache->end = UINT32_MAX - 1;
         }
         else {
             /*If small data is requested, then read from FS into cache buffer*/
@@ -321,6 +327,30 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+lv_fs_res_t lv_fs_get_buf(lv_fs_file_t * file_p, const void ** buf, uint32_t * size)
+{
+    *buf = NULL;
+    if(size) *size = 0;
+
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->get_buf_cb == NULL) {
+        return LV_FS_RES_NOT_IMP;
+    }
+
+    uint32_t size_tmp = 0;
+    lv_fs_res_t res = file_p->drv->get_buf_cb(file_p->drv, file_p->file_d, buf, &size_tmp);
+    if(res != LV_FS_RES_OK) {
+        *buf = NULL;
+        return res;
+    }
+
+    if(size) *size = size_tmp;
+    return LV_FS_RES_OK;
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -78,6 +78,7 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*write_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
     lv_fs_res_t (*seek_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+    lv_fs_res_t (*get_buf_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void ** buf, uint32_t * size);
 
     void * (*dir_open_cb)(struct _lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
@@ -199,6 +200,17 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Get a direct pointer to the whole content of a file (e.g. a memory mapped file).
+ * It allows reading the file in place without copying it into a buffer.
+ * The returned buffer is read only and valid until the file is closed.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param buf       store the pointer to the first byte of the file here
+ * @param size      store the size of the file in bytes here. NULL if unused.
+ * @return          LV_FS_RES_OK or LV_FS_RES_NOT_IMP if the driver can't provide a direct pointer
+ */
+lv_fs_res_t lv_fs_get_buf(lv_fs_file_t * file_p, const void ** buf, uint32_t * size);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
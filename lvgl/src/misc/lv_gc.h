@@ -49,7 +49,14 @@ extern "C" {
     LV_DISPATCH(f, lv_ll_t, _lv_group_ll)                                                              \
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
+    LV_DISPATCH(f, lv_ll_t, _lv_layer_cache_ll)                                                        \
+    LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_async_ll)                                                  \
+    LV_DISPATCH(f, lv_ll_t, _lv_layout_cache_ll)                                                       \
+    LV_DISPATCH(f, lv_ll_t, _lv_snapshot_session_ll)                                                   \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
+    LV_DISPATCH(f, uint8_t * , _lv_txt_layout_cache_mem)                                               \
+    LV_DISPATCH(f, uint8_t * , _lv_draw_sw_ring_cache_mem)                                             \
+    LV_DISPATCH(f, uint8_t * , _lv_draw_sw_filter_buf)                                                 \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
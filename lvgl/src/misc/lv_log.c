@@ -12,6 +12,7 @@
 #include <stdarg.h>
 #include <string.h>
 #include "lv_printf.h"
+#include "lv_log_async.h"
 #include "../hal/lv_hal_tick.h"
 
 #if LV_LOG_PRINTF
@@ -29,11 +30,13 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static const char * get_file_name(const char * file);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static lv_log_print_g_cb_t custom_print_cb;
+static const char * lvl_prefix[] = {"Trace", "Info", "Warn", "Error", "User"};
 
 /**********************
  *      MACROS
@@ -73,33 +76,29 @@ void _lv_log_add(lv_log_level_t level, const char * file, int line, const char *
         va_list args;
         va_start(args, format);
 
-        /*Use only the file name not the path*/
-        size_t p;
-        for(p = strlen(file); p > 0; p--) {
-            if(file[p] == '/' || file[p] == '\\') {
-                p++;    /*Skip the slash*/
-                break;
-            }
+#if LV_LOG_USE_ASYNC
+        if(_lv_log_async_add(level, file, line, func, format, args)) {
+            va_end(args);
+            return;
         }
+#endif
 
         uint32_t t = lv_tick_get();
-        static const char * lvl_prefix[] = {"Trace", "Info", "Warn", "Error", "User"};
 
 #if LV_LOG_PRINTF
-        printf("[%s]\t(%" LV_PRId32 ".%03" LV_PRId32 ", +%" LV_PRId32 ")\t %s: ",
-               lvl_prefix[level], t / 1000, t % 1000, t - last_log_time, func);
-        vprintf(format, args);
-        printf(" \t(in %s line #%d)\n", &file[p], line);
-#else
+        if(custom_print_cb == NULL) {
+            printf("[%s]\t(%" LV_PRId32 ".%03" LV_PRId32 ", +%" LV_PRId32 ")\t %s: ",
+                   lvl_prefix[level], t / 1000, t % 1000, t - last_log_time, func);
+            vprintf(format, args);
+            printf(" \t(in %s line #%d)\n", get_file_name(file), line);
+        }
+#endif
+
         if(custom_print_cb) {
-            char buf[512];
             char msg[256];
             lv_vsnprintf(msg, sizeof(msg), format, args);
-            lv_snprintf(buf, sizeof(buf), "[%s]\t(%" LV_PRId32 ".%03" LV_PRId32 ", +%" LV_PRId32 ")\t %s: %s \t(in %s line #%d)\n",
-                        lvl_prefix[level], t / 1000, t % 1000, t - last_log_time, func, msg, &file[p], line);
-            custom_print_cb(buf);
+            _lv_log_print_msg(level, t, t - last_log_time, -1, file, line, func, msg);
         }
-#endif
 
         last_log_time = t;
         va_end(args);
@@ -113,21 +112,70 @@ void lv_log(const char * format, ...)
     va_list args;
     va_start(args, format);
 
+#if LV_LOG_USE_ASYNC
+    if(_lv_log_async_add(_LV_LOG_LEVEL_NUM, NULL, 0, NULL, format, args)) {
+        va_end(args);
+        return;
+    }
+#endif
+
 #if LV_LOG_PRINTF
-    vprintf(format, args);
-#else
+    if(custom_print_cb == NULL) {
+        vprintf(format, args);
+    }
+#endif
+
     if(custom_print_cb) {
         char buf[512];
         lv_vsnprintf(buf, sizeof(buf), format, args);
-        custom_print_cb(buf);
+        _lv_log_print(buf);
     }
-#endif
 
     va_end(args);
 }
 
+void _lv_log_print_msg(lv_log_level_t level, uint32_t t, uint32_t t_diff, int thread_id, const char * file, int line,
+                       const char * func, const char * msg)
+{
+    char thread[16] = "";
+    if(thread_id >= 0) lv_snprintf(thread, sizeof(thread), "[T%d] ", thread_id);
+
+    char buf[512];
+    lv_snprintf(buf, sizeof(buf), "[%s]\t(%" LV_PRId32 ".%03" LV_PRId32 ", +%" LV_PRId32 ")\t %s%s: %s \t(in %s line #%d)\n",
+                lvl_prefix[level], t / 1000, t % 1000, t_diff, thread, func, msg, get_file_name(file), line);
+    _lv_log_print(buf);
+}
+
+void _lv_log_print(const char * buf)
+{
+    if(custom_print_cb) {
+        custom_print_cb(buf);
+        return;
+    }
+
+#if LV_LOG_PRINTF
+    printf("%s", buf);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Use only the file name not the path
+ */
+static const char * get_file_name(const char * file)
+{
+    size_t p;
+    for(p = strlen(file); p > 0; p--) {
+        if(file[p] == '/' || file[p] == '\\') {
+            p++;    /*Skip the slash*/
+            break;
+        }
+    }
+
+    return &file[p];
+}
+
 #endif /*LV_USE_LOG*/
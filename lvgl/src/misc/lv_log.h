@@ -59,6 +59,8 @@ typedef void (*lv_log_print_g_cb_t)(const char * buf);
  * Register custom print/write function to call when a log is added.
  * It can format its "File path", "Line number" and "Description" as required
  * and send the formatted log message to a console or serial port.
+ * If registered it's used instead of `printf` even if `LV_LOG_PRINTF` is enabled.
+ * With `LV_LOG_ASYNC` it's called on the thread which prints the logs.
  * @param           print_cb a function pointer to print a log
  */
 void lv_log_register_print_cb(lv_log_print_g_cb_t print_cb);
@@ -83,6 +85,26 @@ void lv_log(const char * format, ...) LV_FORMAT_ATTRIBUTE(1, 2);
 void _lv_log_add(lv_log_level_t level, const char * file, int line,
                  const char * func, const char * format, ...) LV_FORMAT_ATTRIBUTE(5, 6);
 
+/**
+ * Print a log whose message is already formatted. Used when the logs are formatted later.
+ * @param level     the level of log. (From `lv_log_level_t` enum)
+ * @param t         time of the log [ms]
+ * @param t_diff    time since the previous log [ms]
+ * @param thread_id index of the thread which added the log or -1 to not print it
+ * @param file      name of the file when the log added
+ * @param line      line number in the source code where the log added
+ * @param func      name of the function when the log added
+ * @param msg       the formatted message
+ */
+void _lv_log_print_msg(lv_log_level_t level, uint32_t t, uint32_t t_diff, int thread_id, const char * file, int line,
+                       const char * func, const char * msg);
+
+/**
+ * Print a buffer with the registered print callback or with `printf` if enabled and there is no callback
+ * @param buf       the text to print
+ */
+void _lv_log_print(const char * buf);
+
 /**********************
  *      MACROS
  **********************/
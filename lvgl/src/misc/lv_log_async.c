@@ -0,0 +1,823 @@
+/**
+ * @file lv_log_async.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_log_async.h"
+#if LV_LOG_USE_ASYNC
+
+#include "lv_timer.h"
+#include "lv_printf.h"
+#include "lv_mem.h"
+#include "lv_math.h"
+#include "../hal/lv_hal_tick.h"
+#include <string.h>
+#include <stddef.h>
+#if LV_USE_OS == LV_OS_PTHREAD
+    #include <pthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if defined(__GNUC__) || defined(__clang__)
+    #define ATOMIC_LOAD(p)          __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define ATOMIC_STORE(p, v)      __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define ATOMIC_CAS(p, e, v)     __atomic_compare_exchange_n((p), (e), (v), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+    #define ATOMIC_ADD(p, v)        __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+    #define ATOMIC_SUB(p, v)        __atomic_sub_fetch((p), (v), __ATOMIC_SEQ_CST)
+    #define ATOMIC_FENCE()          __atomic_thread_fence(__ATOMIC_SEQ_CST)
+    #define THREAD_LOCAL            __thread
+#else
+    #error "LV_LOG_ASYNC needs the atomic built-ins and thread local storage of GCC or Clang"
+#endif
+
+#define RING_SIZE           LV_LOG_ASYNC_BUF_SIZE
+#define RING_MASK           (RING_SIZE - 1)
+#define RECORD_MAX_SIZE     512     /*A log with its arguments is never larger than this [bytes]*/
+#define STR_MAX_LEN         255     /*Longer string arguments are truncated*/
+#define MSG_MAX_LEN         256     /*Same as the message of the synchronous log*/
+#define SITE_CNT            32      /*Number of lines whose rate is limited by a thread at the same time*/
+#define WAKE_PERIOD         50      /*[ms] Wake up the printing thread this often if there are logs*/
+#define LEVEL_RAW           _LV_LOG_LEVEL_NUM   /*Added by `lv_log()`*/
+
+#if (RING_SIZE & RING_MASK) != 0 || RING_SIZE < 2 * RECORD_MAX_SIZE
+    #error "LV_LOG_ASYNC_BUF_SIZE should be a power of 2 and at least 1024"
+#endif
+
+/*Round up to the size of the argument slots*/
+#define ALIGN_SLOT(x)       (((x) + 7) & ~7U)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A log in the ring buffer. It's followed by the arguments in 8 byte slots
+ *in the order of the conversions in `format`. Strings are copied with their length.*/
+typedef struct {
+    uint32_t size;          /*Size with the arguments. 0: the rest of the buffer is unused*/
+    uint32_t tick;
+    uint32_t suppressed;    /*Logs of the same line dropped by the rate limit before this one*/
+    int32_t line;
+    const char * file;
+    const char * func;
+    const char * format;
+    lv_log_level_t level;
+} record_t;
+
+typedef struct {
+    const char * file;      /*Or the format of `lv_log()`*/
+    int line;
+    uint32_t start;         /*Start of the current one second long window*/
+    uint32_t cnt;           /*Logs in the current window*/
+    uint32_t suppressed;    /*Logs dropped since the last added one*/
+} site_t;
+
+typedef struct {
+    uint64_t buf[RING_SIZE / sizeof(uint64_t)];
+    uint32_t head;          /*Written only by the thread of the ring*/
+    uint32_t tail;          /*Written only by the printing thread*/
+    uint32_t dropped;       /*Logs dropped because the buffer was full. Written only by the thread of the ring.*/
+    uint32_t dropped_printed;
+    uint32_t last_tick;     /*Tick of the last printed log*/
+    site_t sites[SITE_CNT];
+    bool used;              /*Taken by a thread*/
+} ring_t;
+
+typedef enum {
+    ARG_NONE,               /*`%%` or `%n`*/
+    ARG_INT,
+    ARG_UINT,
+    ARG_DOUBLE,
+    ARG_PTR,
+    ARG_STR,
+    ARG_UNKNOWN,            /*Not supported conversion, the rest of the format is printed as it is*/
+} arg_type_t;
+
+typedef enum {
+    LEN_NONE,
+    LEN_HH,
+    LEN_H,
+    LEN_L,
+    LEN_LL,
+    LEN_Z,
+    LEN_J,
+    LEN_T,
+    LEN_LONG_DOUBLE,
+} len_mod_t;
+
+typedef struct {
+    const char * start;     /*The `%`*/
+    const char * mod;       /*The length modifier after the flags, width and precision*/
+    const char * end;       /*After the conversion character*/
+    char conv;
+    len_mod_t len;
+    arg_type_t type;
+    uint8_t star_cnt;       /*Width and/or precision are given as `int` arguments*/
+} spec_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool api_enter(void);
+static void api_leave(void);
+static ring_t * get_own_ring(void);
+static void release_ring(void * ring);
+static bool check_rate(ring_t * ring, const char * site_file, int line, uint32_t t, uint32_t * suppressed);
+static bool ring_write(ring_t * ring, const record_t * rec);
+static record_t * ring_peek(ring_t * ring);
+static void print_all(void);
+static void print_record(ring_t * ring, const record_t * rec);
+static void parse_spec(const char * p, spec_t * spec);
+static bool put_slot(uint8_t * buf, uint32_t buf_size, uint32_t * ofs, const void * v);
+static bool get_slot(const uint8_t * args, uint32_t args_size, uint32_t * ofs, void * v);
+static uint32_t encode_args(uint8_t * buf, uint32_t buf_size, const char * format, va_list args);
+static void format_args(char * out, uint32_t out_size, const char * format, const uint8_t * args, uint32_t args_size);
+static void thread_cb(void * user_data);
+static void wake_timer_cb(lv_timer_t * t);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static ring_t rings[LV_LOG_ASYNC_THREAD_CNT];   /*Static so that logging never allocates memory*/
+static uint32_t ring_gen;                       /*Incremented on init so that the threads take a ring again*/
+static THREAD_LOCAL ring_t * own_ring;
+static THREAD_LOCAL uint32_t own_gen;
+
+static lv_thread_t thread;
+static lv_thread_sync_t sync;
+static lv_mutex_t print_mutex;                  /*Only one thread can read the rings*/
+static lv_timer_t * wake_timer;
+static bool running;
+static bool thread_exit;
+static uint32_t api_cnt;                        /*Threads in `_lv_log_async_add()` or `lv_log_flush()`*/
+#if LV_USE_OS == LV_OS_PTHREAD
+    static pthread_key_t ring_key;              /*Releases the ring when a thread exits*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_log_async_init(void)
+{
+    if(running) return;
+
+    lv_memzero(rings, sizeof(rings));
+    ring_gen++;
+    thread_exit = false;
+#if LV_USE_OS == LV_OS_PTHREAD
+    if(pthread_key_create(&ring_key, release_ring) != 0) {
+        LV_LOG_WARN("Couldn't create the thread key, the logs are printed synchronously");
+        return;
+    }
+#endif
+    lv_mutex_init(&print_mutex);
+    lv_thread_sync_init(&sync);
+
+    if(lv_thread_init(&thread, LV_THREAD_PRIO_LOWEST, thread_cb, 0, NULL) != LV_RES_OK) {
+        lv_thread_sync_delete(&sync);
+        lv_mutex_delete(&print_mutex);
+#if LV_USE_OS == LV_OS_PTHREAD
+        pthread_key_delete(ring_key);
+#endif
+        LV_LOG_WARN("Couldn't start the log thread, the logs are printed synchronously");
+        return;
+    }
+
+    wake_timer = lv_timer_create(wake_timer_cb, WAKE_PERIOD, NULL);
+    ATOMIC_STORE(&running, true);
+}
+
+void _lv_log_async_deinit(void)
+{
+    if(!running) return;
+
+    ATOMIC_STORE(&running, false);
+
+    /*Wait for the threads which saw `running` before it was cleared. They don't block so it's short.*/
+    ATOMIC_FENCE();
+    while(ATOMIC_LOAD(&api_cnt) != 0) {}
+
+    lv_timer_del(wake_timer);
+    wake_timer = NULL;
+
+    ATOMIC_STORE(&thread_exit, true);
+    lv_thread_sync_signal(&sync);
+    lv_thread_delete(&thread);
+
+    print_all();
+    lv_thread_sync_delete(&sync);
+    lv_mutex_delete(&print_mutex);
+#if LV_USE_OS == LV_OS_PTHREAD
+    pthread_key_delete(ring_key);
+#endif
+}
+
+bool _lv_log_async_add(lv_log_level_t level, const char * file, int line, const char * func, const char * format,
+                       va_list args)
+{
+    if(!api_enter()) return false;
+
+    ring_t * ring = get_own_ring();
+    if(ring == NULL) {
+        /*All rings are taken by other threads*/
+        api_leave();
+        return false;
+    }
+
+    uint32_t t = lv_tick_get();
+    uint32_t suppressed;
+    if(!check_rate(ring, file ? file : format, line, t, &suppressed)) {
+        api_leave();
+        return true;
+    }
+
+    uint64_t rec_buf[RECORD_MAX_SIZE / sizeof(uint64_t)];
+    record_t * rec = (record_t *)rec_buf;
+    rec->tick = t;
+    rec->suppressed = suppressed;
+    rec->line = line;
+    rec->file = file;
+    rec->func = func;
+    rec->format = format;
+    rec->level = level;
+    rec->size = ALIGN_SLOT(sizeof(record_t));
+    rec->size += encode_args((uint8_t *)rec + rec->size, RECORD_MAX_SIZE - rec->size, format, args);
+
+    if(!ring_write(ring, rec)) {
+        ATOMIC_STORE(&ring->dropped, ring->dropped + 1);
+    }
+
+    api_leave();
+    return true;
+}
+
+void lv_log_flush(void)
+{
+    if(!api_enter()) return;
+
+    print_all();
+    api_leave();
+}
+
+void lv_log_release_thread(void)
+{
+    if(!api_enter()) return;
+
+    if(own_gen == ring_gen && own_ring) {
+#if LV_USE_OS == LV_OS_PTHREAD
+        pthread_setspecific(ring_key, NULL);
+#endif
+        release_ring(own_ring);
+    }
+
+    /*Take a ring again if the thread logs later*/
+    own_gen = ring_gen - 1;
+    own_ring = NULL;
+    api_leave();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Count the threads which use the rings and the printing thread so that `_lv_log_async_deinit()`
+ * deletes them only when nobody uses them.
+ * @return          true: the asynchronous logging is running and `api_leave()` should be called
+ */
+static bool api_enter(void)
+{
+    ATOMIC_ADD(&api_cnt, 1);
+    ATOMIC_FENCE();
+    if(ATOMIC_LOAD(&running)) return true;
+
+    ATOMIC_SUB(&api_cnt, 1);
+    return false;
+}
+
+static void api_leave(void)
+{
+    ATOMIC_SUB(&api_cnt, 1);
+}
+
+static ring_t * get_own_ring(void)
+{
+    if(own_gen == ring_gen) return own_ring;
+
+    own_gen = ring_gen;
+    own_ring = NULL;
+    uint32_t i;
+    for(i = 0; i < LV_LOG_ASYNC_THREAD_CNT; i++) {
+        bool expected = false;
+        if(ATOMIC_CAS(&rings[i].used, &expected, true)) {
+            own_ring = &rings[i];
+            /*The rate of the lines of the previous thread of the ring doesn't matter*/
+            lv_memzero(own_ring->sites, sizeof(own_ring->sites));
+#if LV_USE_OS == LV_OS_PTHREAD
+            pthread_setspecific(ring_key, own_ring);
+#endif
+            break;
+        }
+    }
+
+    return own_ring;
+}
+
+/**
+ * Let an other thread take the ring. Its remaining logs are still printed.
+ * Called by `lv_log_release_thread()` or when a pthread exits.
+ */
+static void release_ring(void * ring)
+{
+    ATOMIC_STORE(&((ring_t *)ring)->used, false);
+}
+
+/**
+ * Count the logs of a line in one second long windows.
+ * @param suppressed    number of logs of the line dropped since the last added one
+ * @return              true: the log can be added; false: drop it
+ */
+static bool check_rate(ring_t * ring, const char * site_file, int line, uint32_t t, uint32_t * suppressed)
+{
+#if LV_LOG_ASYNC_RATE_LIMIT
+    uint32_t h = ((uint32_t)(uintptr_t)site_file >> 3) ^ ((uint32_t)line * 2654435761U);
+    site_t * site = &ring->sites[h % SITE_CNT];
+    if(site->file != site_file || site->line != line) {
+        /*Replace the line which used this slot*/
+        site->file = site_file;
+        site->line = line;
+        site->start = t;
+        site->cnt = 0;
+        site->suppressed = 0;
+    }
+    else if(t - site->start >= 1000) {
+        site->start = t;
+        site->cnt = 0;
+    }
+
+    if(site->cnt >= LV_LOG_ASYNC_RATE_LIMIT) {
+        site->suppressed++;
+        return false;
+    }
+
+    site->cnt++;
+    *suppressed = site->suppressed;
+    site->suppressed = 0;
+#else
+    LV_UNUSED(ring);
+    LV_UNUSED(site_file);
+    LV_UNUSED(line);
+    LV_UNUSED(t);
+    *suppressed = 0;
+#endif
+    return true;
+}
+
+/**
+ * Copy a record into the ring. A record is never split: if it doesn't fit to the end of the buffer
+ * the rest of the buffer is skipped.
+ * @return          false: there is no space for it
+ */
+static bool ring_write(ring_t * ring, const record_t * rec)
+{
+    uint8_t * buf = (uint8_t *)ring->buf;
+    uint32_t head = ring->head;
+    uint32_t tail = ATOMIC_LOAD(&ring->tail);
+    uint32_t pos = head & RING_MASK;
+    uint32_t skip = pos + rec->size > RING_SIZE ? RING_SIZE - pos : 0;
+    uint32_t used = head - tail;
+    if(used + skip + rec->size > RING_SIZE) return false;
+
+    if(skip) {
+        ((record_t *)(buf + pos))->size = 0;
+        pos = 0;
+    }
+
+    lv_memcpy(buf + pos, rec, rec->size);
+    ATOMIC_STORE(&ring->head, head + skip + rec->size);
+
+    /*Don't wait for the timer if the buffer is getting full*/
+    if(used < RING_SIZE / 2 && used + skip + rec->size >= RING_SIZE / 2) {
+        lv_thread_sync_signal(&sync);
+    }
+
+    return true;
+}
+
+/**
+ * Get the oldest record of a ring
+ * @return          the record or NULL if the ring is empty
+ */
+static record_t * ring_peek(ring_t * ring)
+{
+    uint8_t * buf = (uint8_t *)ring->buf;
+    uint32_t head = ATOMIC_LOAD(&ring->head);
+    uint32_t tail = ring->tail;
+    while(tail != head) {
+        record_t * rec = (record_t *)(buf + (tail & RING_MASK));
+        if(rec->size) return rec;
+
+        /*Skip to the beginning of the buffer*/
+        tail += RING_SIZE - (tail & RING_MASK);
+        ATOMIC_STORE(&ring->tail, tail);
+    }
+
+    return NULL;
+}
+
+/**
+ * Print the logs of all rings in the order of their time
+ */
+static void print_all(void)
+{
+    lv_mutex_lock(&print_mutex);
+
+    while(1) {
+        ring_t * oldest = NULL;
+        record_t * oldest_rec = NULL;
+        uint32_t i;
+        for(i = 0; i < LV_LOG_ASYNC_THREAD_CNT; i++) {
+            ring_t * ring = &rings[i];
+            uint32_t dropped = ATOMIC_LOAD(&ring->dropped);
+            if(dropped != ring->dropped_printed) {
+                char msg[64];
+                lv_snprintf(msg, sizeof(msg), "[T%d] %" LV_PRIu32 " logs were dropped because the log buffer was full\n",
+                            (int)i, dropped - ring->dropped_printed);
+                _lv_log_print(msg);
+                ring->dropped_printed = dropped;
+            }
+
+            record_t * rec = ring_peek(ring);
+            if(rec == NULL) continue;
+            if(oldest_rec == NULL || (int32_t)(rec->tick - oldest_rec->tick) < 0) {
+                oldest = ring;
+                oldest_rec = rec;
+            }
+        }
+
+        if(oldest == NULL) break;
+
+        print_record(oldest, oldest_rec);
+        ATOMIC_STORE(&oldest->tail, oldest->tail + oldest_rec->size);
+    }
+
+    lv_mutex_unlock(&print_mutex);
+}
+
+static void print_record(ring_t * ring, const record_t * rec)
+{
+    char msg[MSG_MAX_LEN];
+    uint32_t args_ofs = ALIGN_SLOT(sizeof(record_t));
+    format_args(msg, sizeof(msg), rec->format, (const uint8_t *)rec + args_ofs, rec->size - args_ofs);
+
+    if(rec->level == LEVEL_RAW) {
+        _lv_log_print(msg);
+        return;
+    }
+
+    if(rec->suppressed) {
+        size_t len = strlen(msg);
+        lv_snprintf(msg + len, sizeof(msg) - len, " (%" LV_PRIu32 " similar logs were suppressed)", rec->suppressed);
+    }
+
+    _lv_log_print_msg(rec->level, rec->tick, rec->tick - ring->last_tick, (int)(ring - rings),
+                      rec->file, rec->line, rec->func, msg);
+    ring->last_tick = rec->tick;
+}
+
+/**
+ * Parse a conversion specification
+ * @param p         points to the `%`
+ * @param spec      store the result here
+ */
+static void parse_spec(const char * p, spec_t * spec)
+{
+    spec->start = p;
+    spec->star_cnt = 0;
+    spec->len = LEN_NONE;
+    p++;
+
+    while(*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') p++;
+
+    if(*p == '*') {
+        spec->star_cnt++;
+        p++;
+    }
+    else {
+        while(*p >= '0' && *p <= '9') p++;
+    }
+
+    if(*p == '.') {
+        p++;
+        if(*p == '*') {
+            spec->star_cnt++;
+            p++;
+        }
+        else {
+            while(*p >= '0' && *p <= '9') p++;
+        }
+    }
+
+    spec->mod = p;
+    switch(*p) {
+        case 'h':
+            p++;
+            if(*p == 'h') {
+                spec->len = LEN_HH;
+                p++;
+            }
+            else spec->len = LEN_H;
+            break;
+        case 'l':
+            p++;
+            if(*p == 'l') {
+                spec->len = LEN_LL;
+                p++;
+            }
+            else spec->len = LEN_L;
+            break;
+        case 'z':
+            spec->len = LEN_Z;
+            p++;
+            break;
+        case 'j':
+            spec->len = LEN_J;
+            p++;
+            break;
+        case 't':
+            spec->len = LEN_T;
+            p++;
+            break;
+        case 'L':
+            spec->len = LEN_LONG_DOUBLE;
+            p++;
+            break;
+        default:
+            break;
+    }
+
+    spec->conv = *p;
+    switch(*p) {
+        case 'd':
+        case 'i':
+        case 'c':
+            spec->type = ARG_INT;
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            spec->type = ARG_UINT;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+            spec->type = ARG_DOUBLE;
+            break;
+        case 'p':
+            spec->type = ARG_PTR;
+            break;
+        case 's':
+            spec->type = ARG_STR;
+            break;
+        case '%':
+        case 'n':
+            spec->type = ARG_NONE;
+            break;
+        default:
+            spec->type = ARG_UNKNOWN;
+            break;
+    }
+
+    spec->end = spec->type == ARG_UNKNOWN ? p : p + 1;
+}
+
+static bool put_slot(uint8_t * buf, uint32_t buf_size, uint32_t * ofs, const void * v)
+{
+    if(*ofs + 8 > buf_size) return false;
+    lv_memcpy(buf + *ofs, v, 8);
+    *ofs += 8;
+    return true;
+}
+
+/**
+ * Copy the arguments of a format into a buffer
+ * @return          the used size
+ */
+static uint32_t encode_args(uint8_t * buf, uint32_t buf_size, const char * format, va_list args)
+{
+    uint32_t ofs = 0;
+    const char * p = format;
+    while((p = strchr(p, '%')) != NULL) {
+        spec_t spec;
+        parse_spec(p, &spec);
+        p = spec.end;
+
+        uint32_t i;
+        for(i = 0; i < spec.star_cnt; i++) {
+            int64_t v = va_arg(args, int);
+            if(!put_slot(buf, buf_size, &ofs, &v)) return ofs;
+        }
+
+        bool ok = true;
+        switch(spec.type) {
+            case ARG_INT: {
+                    int64_t v;
+                    if(spec.len == LEN_L) v = va_arg(args, long);
+                    else if(spec.len == LEN_LL) v = va_arg(args, long long);
+                    else if(spec.len == LEN_Z) v = (int64_t)va_arg(args, size_t);
+                    else if(spec.len == LEN_J) v = va_arg(args, intmax_t);
+                    else if(spec.len == LEN_T) v = va_arg(args, ptrdiff_t);
+                    else if(spec.len == LEN_HH) v = (signed char)va_arg(args, int);
+                    else if(spec.len == LEN_H) v = (short)va_arg(args, int);
+                    else v = va_arg(args, int);
+                    ok = put_slot(buf, buf_size, &ofs, &v);
+                    break;
+                }
+            case ARG_UINT: {
+                    uint64_t v;
+                    if(spec.len == LEN_L) v = va_arg(args, unsigned long);
+                    else if(spec.len == LEN_LL) v = va_arg(args, unsigned long long);
+                    else if(spec.len == LEN_Z) v = va_arg(args, size_t);
+                    else if(spec.len == LEN_J) v = va_arg(args, uintmax_t);
+                    else if(spec.len == LEN_T) v = (uint64_t)va_arg(args, ptrdiff_t);
+                    else if(spec.len == LEN_HH) v = (unsigned char)va_arg(args, unsigned int);
+                    else if(spec.len == LEN_H) v = (unsigned short)va_arg(args, unsigned int);
+                    else v = va_arg(args, unsigned int);
+                    ok = put_slot(buf, buf_size, &ofs, &v);
+                    break;
+                }
+            case ARG_DOUBLE: {
+                    double v;
+                    if(spec.len == LEN_LONG_DOUBLE) v = (double)va_arg(args, long double);
+                    else v = va_arg(args, double);
+                    ok = put_slot(buf, buf_size, &ofs, &v);
+                    break;
+                }
+            case ARG_PTR: {
+                    uint64_t v = (uintptr_t)va_arg(args, void *);
+                    ok = put_slot(buf, buf_size, &ofs, &v);
+                    break;
+                }
+            case ARG_STR: {
+                    /*The string might change or be freed before it's printed so copy it*/
+                    const char * s = va_arg(args, const char *);
+                    if(s == NULL) s = "(null)";
+                    if(ofs + 8 > buf_size) return ofs;
+                    uint32_t max_len = LV_MIN(STR_MAX_LEN, buf_size - ofs - sizeof(uint32_t) - 1);
+                    uint32_t len = 0;
+                    while(len < max_len && s[len] != '\0') len++;
+                    lv_memcpy(buf + ofs, &len, sizeof(uint32_t));
+                    lv_memcpy(buf + ofs + sizeof(uint32_t), s, len);
+                    buf[ofs + sizeof(uint32_t) + len] = '\0';
+                    ofs += ALIGN_SLOT(sizeof(uint32_t) + len + 1);
+                    break;
+                }
+            case ARG_NONE:
+                if(spec.conv == 'n') (void)va_arg(args, void *);    /*Nothing is written to it*/
+                break;
+            case ARG_UNKNOWN:
+                return ofs;
+        }
+
+        if(!ok) return ofs;
+    }
+
+    return ofs;
+}
+
+static bool get_slot(const uint8_t * args, uint32_t args_size, uint32_t * ofs, void * v)
+{
+    if(*ofs + 8 > args_size) return false;
+    lv_memcpy(v, args + *ofs, 8);
+    *ofs += 8;
+    return true;
+}
+
+/**
+ * Format the saved arguments of a log
+ */
+static void format_args(char * out, uint32_t out_size, const char * format, const uint8_t * args, uint32_t args_size)
+{
+    uint32_t pos = 0;
+    uint32_t ofs = 0;
+    const char * p = format;
+    while(*p != '\0' && pos + 1 < out_size) {
+        if(*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+
+        spec_t spec;
+        parse_spec(p, &spec);
+        if(spec.type == ARG_UNKNOWN) {
+            /*The arguments weren't saved from here*/
+            while(*p != '\0' && pos + 1 < out_size) out[pos++] = *p++;
+            break;
+        }
+        p = spec.end;
+
+        if(spec.type == ARG_NONE) {
+            if(spec.conv == '%') out[pos++] = '%';
+            continue;
+        }
+
+        /*Rebuild the conversion with the saved width and precision and the size of the saved value*/
+        char fmt[32];
+        uint32_t fmt_len = 0;
+        const char * f;
+        bool truncated = false;
+        for(f = spec.start; f < spec.mod && fmt_len < sizeof(fmt) - 16; f++) {
+            if(*f != '*') {
+                fmt[fmt_len++] = *f;
+                continue;
+            }
+
+            int64_t v;
+            if(!get_slot(args, args_size, &ofs, &v)) {
+                truncated = true;
+                break;
+            }
+            if(v < 0 && fmt[fmt_len - 1] == '.') fmt_len--;     /*Negative precision is ignored*/
+            else fmt_len += lv_snprintf(&fmt[fmt_len], sizeof(fmt) - 16 - fmt_len, "%d", (int)v);
+        }
+        if(truncated || f < spec.mod) break;
+
+        if((spec.type == ARG_INT && spec.conv != 'c') || spec.type == ARG_UINT) {
+            fmt[fmt_len++] = 'l';
+            fmt[fmt_len++] = 'l';
+        }
+        fmt[fmt_len++] = spec.conv;
+        fmt[fmt_len] = '\0';
+
+        int len = 0;
+        if(spec.type == ARG_STR) {
+            uint32_t str_len;
+            if(ofs + sizeof(uint32_t) > args_size) break;
+            lv_memcpy(&str_len, args + ofs, sizeof(uint32_t));
+            len = lv_snprintf(out + pos, out_size - pos, fmt, (const char *)args + ofs + sizeof(uint32_t));
+            ofs += ALIGN_SLOT(sizeof(uint32_t) + str_len + 1);
+        }
+        else {
+            uint64_t v;
+            if(!get_slot(args, args_size, &ofs, &v)) break;
+
+            if(spec.type == ARG_INT && spec.conv == 'c') len = lv_snprintf(out + pos, out_size - pos, fmt, (int)v);
+            else if(spec.type == ARG_INT) len = lv_snprintf(out + pos, out_size - pos, fmt, (long long)v);
+            else if(spec.type == ARG_UINT) len = lv_snprintf(out + pos, out_size - pos, fmt, (unsigned long long)v);
+            else if(spec.type == ARG_PTR) len = lv_snprintf(out + pos, out_size - pos, fmt, (void *)(uintptr_t)v);
+            else {
+                double d;
+                lv_memcpy(&d, &v, sizeof(d));
+                len = lv_snprintf(out + pos, out_size - pos, fmt, d);
+            }
+        }
+
+        if(len < 0) break;
+        pos = LV_MIN(pos + (uint32_t)len, out_size - 1);
+    }
+
+    out[pos] = '\0';
+}
+
+static void thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    while(1) {
+        lv_thread_sync_wait(&sync);
+        if(ATOMIC_LOAD(&thread_exit)) break;
+        print_all();
+    }
+}
+
+/**
+ * Wake up the printing thread if there are logs to print
+ */
+static void wake_timer_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+
+    uint32_t i;
+    for(i = 0; i < LV_LOG_ASYNC_THREAD_CNT; i++) {
+        if(ATOMIC_LOAD(&rings[i].head) != ATOMIC_LOAD(&rings[i].tail) ||
+           ATOMIC_LOAD(&rings[i].dropped) != rings[i].dropped_printed) {
+            lv_thread_sync_signal(&sync);
+            return;
+        }
+    }
+}
+
+#endif /*LV_LOG_USE_ASYNC*/
@@ -0,0 +1,76 @@
+/**
+ * @file lv_log_async.h
+ *
+ */
+
+#ifndef LV_LOG_ASYNC_H
+#define LV_LOG_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../osal/lv_os.h"
+#include "lv_log.h"
+#include <stdarg.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_LOG_USE_ASYNC (LV_USE_LOG && LV_LOG_ASYNC && LV_USE_OS != LV_OS_NONE)
+
+#if LV_LOG_USE_ASYNC
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start the thread which formats and prints the logs.
+ */
+void _lv_log_async_init(void);
+
+/**
+ * Print the remaining logs and stop the thread. The later logs are printed synchronously.
+ */
+void _lv_log_async_deinit(void);
+
+/**
+ * Copy a log with its arguments into the ring buffer of the calling thread.
+ * @param level     the level of log or `_LV_LOG_LEVEL_NUM` for `lv_log()`
+ * @param file      name of the file when the log added
+ * @param line      line number in the source code where the log added
+ * @param func      name of the function when the log added
+ * @param format    printf-like format string. Only the pointer is saved.
+ * @param args      parameters for `format`
+ * @return          true: the log is added or it's dropped by the rate limit;
+ *                  false: it should be printed synchronously and `args` wasn't used
+ */
+bool _lv_log_async_add(lv_log_level_t level, const char * file, int line, const char * func, const char * format,
+                       va_list args);
+
+/**
+ * Print the logs of all threads which are waiting in the ring buffers on the calling thread.
+ * Returns when all the logs added before the call are printed.
+ */
+void lv_log_flush(void);
+
+/**
+ * Give back the ring buffer of the calling thread so that an other thread can log asynchronously.
+ * Call it before a thread which logged exits. With `LV_OS_PTHREAD` it's called automatically on exit.
+ * If the thread logs again it takes a ring again.
+ */
+void lv_log_release_thread(void);
+
+#endif /*LV_LOG_USE_ASYNC*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_LOG_ASYNC_H*/
@@ -12,6 +12,7 @@
 #include "lv_assert.h"
 #include "lv_log.h"
 #include "lv_math.h"
+#include "../osal/lv_os.h"
 
 #ifdef LV_MEM_POOL_INCLUDE
     #include LV_MEM_POOL_INCLUDE
@@ -48,6 +49,9 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 static lv_tlsf_t tlsf;
 static uint32_t cur_used;
 static uint32_t max_used;
+#if LV_USE_OS != LV_OS_NONE
+    static lv_mutex_t mutex;  /*TLSF is not thread safe, protect it if other threads can allocate too*/
+#endif
 
 /**********************
  *      MACROS
@@ -58,6 +62,14 @@ static uint32_t max_used;
     #define MEM_TRACE(...)
 #endif
 
+#if LV_USE_OS != LV_OS_NONE
+    #define MEM_LOCK()      lv_mutex_lock(&mutex)
+    #define MEM_UNLOCK()    lv_mutex_unlock(&mutex)
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+#endif
+
 #define _COPY(d, s) *d = *s; d++; s++;
 #define _SET(d, v) *d = v; d++;
 #define _REPEAT8(expr) expr expr expr expr expr expr expr expr
@@ -82,6 +94,12 @@ void lv_mem_init_builtin(void)
 #else
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
+    cur_used = 0;
+    max_used = 0;
+
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_init(&mutex);
+#endif
 
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
@@ -91,6 +109,9 @@ void lv_mem_init_builtin(void)
 void lv_mem_deinit_builtin(void)
 {
     lv_tlsf_destroy(tlsf);
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_delete(&mutex);
+#endif
     lv_mem_init_builtin();
 }
 
@@ -100,7 +121,9 @@ void lv_mem_monitor_builtin(lv_mem_monitor_t * mon_p)
     lv_memset(mon_p, 0, sizeof(lv_mem_monitor_t));
     MEM_TRACE("begin");
 
+    MEM_LOCK();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+    MEM_UNLOCK();
 
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
@@ -117,16 +140,40 @@ void lv_mem_monitor_builtin(lv_mem_monitor_t * mon_p)
     MEM_TRACE("finished");
 }
 
+void lv_mem_reset_max_used_builtin(void)
+{
+    MEM_LOCK();
+    max_used = cur_used;
+    MEM_UNLOCK();
+}
+
 void * lv_malloc_builtin(size_t size)
 {
-    cur_used += size;
-    max_used = LV_MAX(cur_used, max_used);
-    return lv_tlsf_malloc(tlsf, size);
+    MEM_LOCK();
+    void * p = lv_tlsf_malloc(tlsf, size);
+    /*Count the size of the block as `lv_free_builtin` does*/
+    if(p) {
+        cur_used += lv_tlsf_block_size(p);
+        max_used = LV_MAX(cur_used, max_used);
+    }
+    MEM_UNLOCK();
+    return p;
 }
 
 void * lv_realloc_builtin(void * p, size_t new_size)
 {
-    return lv_tlsf_realloc(tlsf, p, new_size);
+    MEM_LOCK();
+    size_t old_size = p ? lv_tlsf_block_size(p) : 0;
+    void * new_p = lv_tlsf_realloc(tlsf, p, new_size);
+    /*Track the usage as if the old block was freed and the new one allocated*/
+    if(new_p || new_size == 0) {
+        if(cur_used > old_size) cur_used -= old_size;
+        else cur_used = 0;
+        if(new_p) cur_used += lv_tlsf_block_size(new_p);
+        max_used = LV_MAX(cur_used, max_used);
+    }
+    MEM_UNLOCK();
+    return new_p;
 }
 
 void lv_free_builtin(void * p)
@@ -134,22 +181,28 @@ void lv_free_builtin(void * p)
 #if LV_MEM_ADD_JUNK
     lv_memset(p, 0xbb, lv_tlsf_block_size(data));
 #endif
+    MEM_LOCK();
     size_t size = lv_tlsf_free(tlsf, p);
     if(cur_used > size) cur_used -= size;
     else cur_used = 0;
+    MEM_UNLOCK();
 }
 
 lv_res_t lv_mem_test_builtin(void)
 {
+    MEM_LOCK();
     if(lv_tlsf_check(tlsf)) {
+        MEM_UNLOCK();
         LV_LOG_WARN("failed");
         return LV_RES_INV;
     }
 
     if(lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf))) {
+        MEM_UNLOCK();
         LV_LOG_WARN("pool failed");
         return LV_RES_INV;
     }
+    MEM_UNLOCK();
 
     MEM_TRACE("passed");
     return LV_RES_OK;
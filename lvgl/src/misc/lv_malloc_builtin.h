@@ -55,6 +55,12 @@ lv_res_t lv_mem_test_builtin(void);
  */
 void lv_mem_monitor_builtin(lv_mem_monitor_t * mon_p);
 
+/**
+ * Restart tracking the maximal memory usage (`max_used` of `lv_mem_monitor_t`) from the current usage.
+ * Useful to measure the peak memory usage of a given part of the application.
+ */
+void lv_mem_reset_max_used_builtin(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,204 @@
+/**
+ * @file lv_profiler.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_profiler.h"
+#if LV_USE_PROFILER
+
+#include "lv_mem.h"
+#include "lv_log.h"
+#include "lv_printf.h"
+#include "lv_assert.h"
+#include "../hal/lv_hal_tick.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ITEM_BUF_SIZE   128
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define ATOMIC_FETCH_ADD(p, v)  __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+    #define ATOMIC_EXCHANGE(p, v)   __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#else
+    #define ATOMIC_FETCH_ADD(p, v)  ((*(p) += (v)) - (v))
+    #define ATOMIC_EXCHANGE(p, v)   exchange_u32((p), (v))
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * tag;
+    uint32_t tick;
+    int tid;
+    char type;
+} lv_profiler_item_t;
+
+typedef struct {
+    lv_profiler_item_t * items;
+    uint32_t item_num;
+    uint32_t cur_index;
+    bool enable;
+    lv_profiler_config_t config;
+} lv_profiler_ctx_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t default_tick_get_cb(void);
+static void default_flush_cb(const char * buf);
+#if !defined(__GNUC__) && !defined(__clang__)
+    static uint32_t exchange_u32(uint32_t * p, uint32_t v);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_profiler_ctx_t profiler_ctx;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_profiler_config_init(lv_profiler_config_t * config)
+{
+    LV_ASSERT_NULL(config);
+    lv_memzero(config, sizeof(lv_profiler_config_t));
+    config->tick_get_cb = default_tick_get_cb;
+    config->tick_per_sec = 1000;
+    config->flush_cb = default_flush_cb;
+}
+
+void lv_profiler_init(const lv_profiler_config_t * config)
+{
+    LV_ASSERT_NULL(config);
+    LV_ASSERT_MSG(config->tick_per_sec > 0, "tick_per_sec must be > 0");
+
+    if(profiler_ctx.items == NULL) {
+        profiler_ctx.items = lv_malloc(LV_PROFILER_BUF_SIZE * sizeof(lv_profiler_item_t));
+        LV_ASSERT_MALLOC(profiler_ctx.items);
+        if(profiler_ctx.items == NULL) {
+            LV_LOG_ERROR("Couldn't allocate the event buffer");
+            return;
+        }
+    }
+
+    profiler_ctx.item_num = LV_PROFILER_BUF_SIZE;
+    profiler_ctx.cur_index = 0;
+    profiler_ctx.config = *config;
+    if(profiler_ctx.config.tick_get_cb == NULL) profiler_ctx.config.tick_get_cb = default_tick_get_cb;
+    if(profiler_ctx.config.flush_cb == NULL) profiler_ctx.config.flush_cb = default_flush_cb;
+    profiler_ctx.enable = true;
+}
+
+void lv_profiler_deinit(void)
+{
+    profiler_ctx.enable = false;
+    lv_free(profiler_ctx.items);
+    lv_memzero(&profiler_ctx, sizeof(profiler_ctx));
+}
+
+void lv_profiler_enable(bool enable)
+{
+    profiler_ctx.enable = enable;
+}
+
+void lv_profiler_write(const char * tag, char type)
+{
+    if(!profiler_ctx.enable) return;
+
+    /*Reserve a slot first so that concurrent writers never get the same one*/
+    uint32_t index = ATOMIC_FETCH_ADD(&profiler_ctx.cur_index, 1) % profiler_ctx.item_num;
+    lv_profiler_item_t * item = &profiler_ctx.items[index];
+    item->tag = tag;
+    item->type = type;
+    item->tick = profiler_ctx.config.tick_get_cb();
+    item->tid = profiler_ctx.config.tid_get_cb ? profiler_ctx.config.tid_get_cb() : 0;
+}
+
+void lv_profiler_flush(void)
+{
+    if(profiler_ctx.items == NULL) return;
+
+    bool enable_ori = profiler_ctx.enable;
+    profiler_ctx.enable = false;
+
+    /*Take the events and clear the buffer with the same atomic as the writers*/
+    uint32_t cur_index = ATOMIC_EXCHANGE(&profiler_ctx.cur_index, 0);
+    uint32_t start;
+    uint32_t cnt;
+    if(cur_index > profiler_ctx.item_num) {
+        /*The buffer has wrapped around, start with the oldest event*/
+        start = cur_index % profiler_ctx.item_num;
+        cnt = profiler_ctx.item_num;
+    }
+    else {
+        start = 0;
+        cnt = cur_index;
+    }
+
+    const lv_profiler_config_t * config = &profiler_ctx.config;
+    char buf[ITEM_BUF_SIZE];
+    config->flush_cb("[\n");
+
+    /*The 32 bit ticks can wrap around (e.g. after 71 minutes with us ticks) so extend them to 64 bit.
+     *The events are in order, only the ones of different threads can be a little out of order.*/
+    int64_t tick = 0;
+    uint32_t tick_prev = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        const lv_profiler_item_t * item = &profiler_ctx.items[(start + i) % profiler_ctx.item_num];
+        if(i == 0) tick = item->tick;
+        else tick += (int32_t)(item->tick - tick_prev);
+        tick_prev = item->tick;
+
+        uint64_t us = tick > 0 ? ((uint64_t)tick * 1000000) / config->tick_per_sec : 0;
+        /*Print the timestamp as s and the remaining 6 digits of us to avoid 64 bit formatting*/
+        uint32_t sec = (uint32_t)(us / 1000000);
+        uint32_t us_rem = (uint32_t)(us % 1000000);
+        char ts[24];
+        if(sec) lv_snprintf(ts, sizeof(ts), "%" LV_PRIu32 "%06" LV_PRIu32, sec, us_rem);
+        else lv_snprintf(ts, sizeof(ts), "%" LV_PRIu32, us_rem);
+
+        lv_snprintf(buf, sizeof(buf), "{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":0,\"tid\":%d,\"ts\":%s}%s\n",
+                    item->tag ? item->tag : "unknown", item->type, item->tid, ts, i + 1 < cnt ? "," : "");
+        config->flush_cb(buf);
+    }
+
+    config->flush_cb("]\n");
+
+    profiler_ctx.enable = enable_ori;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t default_tick_get_cb(void)
+{
+    return lv_tick_get();
+}
+
+static void default_flush_cb(const char * buf)
+{
+    LV_LOG("%s", buf);
+}
+
+#if !defined(__GNUC__) && !defined(__clang__)
+static uint32_t exchange_u32(uint32_t * p, uint32_t v)
+{
+    uint32_t old = *p;
+    *p = v;
+    return old;
+}
+#endif
+
+#endif /*LV_USE_PROFILER*/
@@ -0,0 +1,109 @@
+/**
+ * @file lv_profiler.h
+ *
+ */
+
+#ifndef LV_PROFILER_H
+#define LV_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lv_types.h"
+
+#if LV_USE_PROFILER
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Receives a chunk of the trace (zero terminated string) when `lv_profiler_flush()` is called
+ */
+typedef void (*lv_profiler_flush_cb_t)(const char * buf);
+
+typedef struct {
+    uint32_t (*tick_get_cb)(void);      /**< Get the current time. If NULL `lv_tick_get()` is used. It can wrap around.*/
+    uint32_t tick_per_sec;              /**< Number of ticks in a second (e.g. 1000 for ms, 1000000 for us)*/
+    int (*tid_get_cb)(void);            /**< Get the ID of the current thread. If NULL 0 is used*/
+    lv_profiler_flush_cb_t flush_cb;    /**< Called by `lv_profiler_flush()` to write the trace*/
+} lv_profiler_config_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a profiler configuration with default values:
+ * ms resolution via `lv_tick_get()`, single thread, output with `LV_LOG`.
+ * @param config    pointer to a configuration to initialize
+ */
+void lv_profiler_config_init(lv_profiler_config_t * config);
+
+/**
+ * Initialize the profiler. Called by `lv_init()` with the default configuration,
+ * but it can be called again to use a custom configuration.
+ * @param config    pointer to a configuration. It will be copied.
+ */
+void lv_profiler_init(const lv_profiler_config_t * config);
+
+/**
+ * Free the event buffer of the profiler
+ */
+void lv_profiler_deinit(void);
+
+/**
+ * Enable or disable the recording of events
+ * @param enable    true: record events; false: ignore them
+ */
+void lv_profiler_enable(bool enable);
+
+/**
+ * Add a begin or end event to the ring buffer. If the buffer is full the oldest event is overwritten.
+ * Use it via the `LV_PROFILER_...` macros.
+ * @param tag       name of the span. Must be a static string as only the pointer is stored.
+ * @param type      'B' for begin, 'E' for end
+ */
+void lv_profiler_write(const char * tag, char type);
+
+/**
+ * Write the recorded events in Chrome trace event (JSON) format via the `flush_cb`
+ * and clear the buffer. The output can be opened with `chrome://tracing` or https://ui.perfetto.dev
+ */
+void lv_profiler_flush(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_PROFILER_BEGIN           lv_profiler_write(__func__, 'B')
+#define LV_PROFILER_END             lv_profiler_write(__func__, 'E')
+#define LV_PROFILER_BEGIN_TAG(tag)  lv_profiler_write((tag), 'B')
+#define LV_PROFILER_END_TAG(tag)    lv_profiler_write((tag), 'E')
+
+#else /*LV_USE_PROFILER*/
+
+#define LV_PROFILER_BEGIN
+#define LV_PROFILER_END
+#define LV_PROFILER_BEGIN_TAG(tag)  LV_UNUSED(tag)
+#define LV_PROFILER_END_TAG(tag)    LV_UNUSED(tag)
+
+#endif /*LV_USE_PROFILER*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PROFILER_H*/
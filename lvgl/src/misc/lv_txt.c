@@ -13,19 +13,54 @@
 #include "lv_log.h"
 #include "lv_mem.h"
 #include "lv_assert.h"
+#include "lv_gc.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+#undef ALIGN
+#if defined(LV_ARCH_64)
+    #define ALIGN(X)    (((X) + 7) & ~7)
+#else
+    #define ALIGN(X)    (((X) + 3) & ~3)
+#endif
+
+/*The layout cache starts with the hash table. It stores `offset + 1` of the first item
+ *in each bucket or 0 if the bucket is empty. The items follow the table.*/
+#define LAYOUT_CACHE_BUCKET_CNT     (LV_TXT_LAYOUT_CACHE_SIZE / 128 + 1)
+#define LAYOUT_CACHE_BUCKETS        ((uint32_t *)LV_GC_ROOT(_lv_txt_layout_cache_mem))
+#define LAYOUT_CACHE_ITEMS          (LV_GC_ROOT(_lv_txt_layout_cache_mem) + ALIGN(LAYOUT_CACHE_BUCKET_CNT * sizeof(uint32_t)))
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*An item of the layout cache. Followed by the lines and the text without the closing '\0'.*/
+typedef struct {
+    uint32_t size;              /*Size of the item with the lines and the text*/
+    uint32_t next;              /*`offset + 1` of the next item in the same bucket or 0*/
+    uint32_t life;              /*Value of `layout_cache_access_cnt` when the item was used last time*/
+    uint32_t hash;
+    const lv_font_t * font;
+    lv_coord_t letter_space;
+    lv_coord_t max_width;
+    uint16_t txt_len;
+    lv_text_flag_t flag;
+    lv_txt_layout_t layout;
+} layout_cache_item_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_TXT_LAYOUT_CACHE_SIZE
+    static layout_cache_item_t * layout_cache_find(uint32_t hash, const char * txt, uint32_t len, const lv_font_t * font,
+                                                   lv_coord_t letter_space, lv_coord_t max_width, lv_text_flag_t flag);
+    static layout_cache_item_t * layout_cache_alloc(uint32_t size);
+    static void layout_cache_free_item(layout_cache_item_t * item);
+    static uint32_t * layout_cache_get_link(uint32_t hash, uint32_t ofs);
+#endif
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_txt_utf8_size(const char * str);
@@ -49,6 +84,10 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_TXT_LAYOUT_CACHE_SIZE
+    static uint8_t * layout_cache_end;
+    static uint32_t layout_cache_access_cnt;
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -103,25 +142,35 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
     uint32_t new_line_start = 0;
     uint16_t letter_height = lv_font_get_line_height(font);
 
-    /*Calc. the height and longest line*/
-    while(text[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+    /*Use the cached line widths if possible*/
+    const lv_txt_layout_t * layout = _lv_txt_get_layout(text, font, letter_space, max_width, flag);
+    if(layout &&
+       (unsigned long)layout->line_cnt * ((unsigned long)letter_height + (unsigned long)line_space) <= LV_MAX_OF(lv_coord_t)) {
+        size_res->x = layout->max_line_width;
+        size_res->y = layout->line_cnt * (letter_height + line_space);
+        line_start = layout->lines[layout->line_cnt].start;
+    }
+    else {
+        /*Calc. the height and longest line*/
+        while(text[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
 
-        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
-            LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
-            return;
-        }
-        else {
-            size_res->y += letter_height;
-            size_res->y += line_space;
-        }
+            if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
+                LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
+                return;
+            }
+            else {
+                size_res->y += letter_height;
+                size_res->y += line_space;
+            }
 
-        /*Calculate the longest line*/
-        lv_coord_t act_line_length = lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
-                                                      flag);
+            /*Calculate the longest line*/
+            lv_coord_t act_line_length = lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
+                                                          flag);
 
-        size_res->x = LV_MAX(act_line_length, size_res->x);
-        line_start  = new_line_start;
+            size_res->x = LV_MAX(act_line_length, size_res->x);
+            line_start  = new_line_start;
+        }
     }
 
     /*Make the text one line taller if the last character is '\n' or '\r'*/
@@ -379,6 +428,95 @@ lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t *
     return width;
 }
 
+const lv_txt_layout_t * _lv_txt_get_layout(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                                           lv_coord_t max_width, lv_text_flag_t flag)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE
+    if(txt == NULL || font == NULL) return NULL;
+
+    /*FNV-1a hash of the text*/
+    uint32_t hash = 2166136261u;
+    uint32_t len = 0;
+    while(txt[len] != '\0') {
+        hash = (hash ^ (uint8_t)txt[len]) * 16777619u;
+        len++;
+        if(len >= LV_TXT_LAYOUT_CACHE_MAX_LEN) return NULL;
+    }
+
+    /*The lines are broken only at the new line characters, so the max. width doesn't matter*/
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    if(LV_GC_ROOT(_lv_txt_layout_cache_mem) == NULL) {
+        LV_GC_ROOT(_lv_txt_layout_cache_mem) = lv_malloc(LV_TXT_LAYOUT_CACHE_SIZE);
+        LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_txt_layout_cache_mem));
+        if(LV_GC_ROOT(_lv_txt_layout_cache_mem) == NULL) return NULL;
+        lv_memset(LAYOUT_CACHE_BUCKETS, 0x00, LAYOUT_CACHE_BUCKET_CNT * sizeof(uint32_t));
+        layout_cache_end = LAYOUT_CACHE_ITEMS;
+    }
+
+    layout_cache_item_t * item = layout_cache_find(hash, txt, len, font, letter_space, max_width, flag);
+    if(item == NULL) {
+        /*Allocate space for the max. number of lines (1 line per character) and free the unused part later*/
+        item = layout_cache_alloc(ALIGN(sizeof(layout_cache_item_t) + (len + 1) * sizeof(lv_txt_layout_line_t) + len));
+        if(item == NULL) return NULL;
+
+        lv_txt_layout_line_t * lines = (lv_txt_layout_line_t *)(item + 1);
+        uint32_t line_cnt = 0;
+        lv_coord_t max_line_width = 0;
+        uint32_t line_start = 0;
+        while(line_start < len) {
+            uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_width, NULL, flag);
+            lines[line_cnt].start = line_start;
+            lines[line_cnt].width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+            max_line_width = LV_MAX(max_line_width, lines[line_cnt].width);
+            line_cnt++;
+            line_start = line_end;
+        }
+        lines[line_cnt].start = len;
+        lines[line_cnt].width = 0;
+        lv_memcpy(&lines[line_cnt + 1], txt, len);
+
+        item->size = ALIGN(sizeof(layout_cache_item_t) + (line_cnt + 1) * sizeof(lv_txt_layout_line_t) + len);
+        item->hash = hash;
+        item->font = font;
+        item->letter_space = letter_space;
+        item->max_width = max_width;
+        item->txt_len = len;
+        item->flag = flag;
+        item->layout.line_cnt = line_cnt;
+        item->layout.max_line_width = max_line_width;
+        layout_cache_end = (uint8_t *)item + item->size;
+
+        uint32_t * bucket = &LAYOUT_CACHE_BUCKETS[hash % LAYOUT_CACHE_BUCKET_CNT];
+        item->next = *bucket;
+        *bucket = (uint8_t *)item - LAYOUT_CACHE_ITEMS + 1;
+    }
+
+    layout_cache_access_cnt++;
+    item->life = layout_cache_access_cnt;
+
+    /*The items might have been moved since the last time*/
+    item->layout.lines = (lv_txt_layout_line_t *)(item + 1);
+    return &item->layout;
+#else
+    LV_UNUSED(txt);
+    LV_UNUSED(font);
+    LV_UNUSED(letter_space);
+    LV_UNUSED(max_width);
+    LV_UNUSED(flag);
+    return NULL;
+#endif
+}
+
+void lv_txt_layout_cache_clear(void)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE
+    lv_free(LV_GC_ROOT(_lv_txt_layout_cache_mem));
+    LV_GC_ROOT(_lv_txt_layout_cache_mem) = NULL;
+    layout_cache_end = NULL;
+#endif
+}
+
 bool _lv_txt_is_cmd(lv_text_cmd_state_t * state, uint32_t c)
 {
     bool ret = false;
@@ -496,6 +634,95 @@ void _lv_txt_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? _lv_txt_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+#if LV_TXT_LAYOUT_CACHE_SIZE
+static layout_cache_item_t * layout_cache_find(uint32_t hash, const char * txt, uint32_t len, const lv_font_t * font,
+                                               lv_coord_t letter_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+    uint32_t ofs = LAYOUT_CACHE_BUCKETS[hash % LAYOUT_CACHE_BUCKET_CNT];
+    while(ofs) {
+        layout_cache_item_t * item = (layout_cache_item_t *)(LAYOUT_CACHE_ITEMS + ofs - 1);
+        if(item->hash == hash && item->txt_len == len && item->font == font && item->letter_space == letter_space &&
+           item->max_width == max_width && item->flag == flag) {
+            const char * item_txt = (const char *)((lv_txt_layout_line_t *)(item + 1) + item->layout.line_cnt + 1);
+            uint32_t i;
+            for(i = 0; i < len && item_txt[i] == txt[i]; i++);
+            if(i == len) return item;
+        }
+        ofs = item->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Get space at the end of the cache. Free the least recently used items if there is not enough space.
+ */
+static layout_cache_item_t * layout_cache_alloc(uint32_t size)
+{
+    if(LAYOUT_CACHE_ITEMS + size > LV_GC_ROOT(_lv_txt_layout_cache_mem) + LV_TXT_LAYOUT_CACHE_SIZE) return NULL;
+
+    while(layout_cache_end + size > LV_GC_ROOT(_lv_txt_layout_cache_mem) + LV_TXT_LAYOUT_CACHE_SIZE) {
+        layout_cache_item_t * oldest = NULL;
+        uint8_t * p = LAYOUT_CACHE_ITEMS;
+        while(p < layout_cache_end) {
+            layout_cache_item_t * item = (layout_cache_item_t *)p;
+            if(oldest == NULL || item->life < oldest->life) oldest = item;
+            p += item->size;
+        }
+        layout_cache_free_item(oldest);
+    }
+
+    return (layout_cache_item_t *)layout_cache_end;
+}
+
+/**
+ * Remove an item and move the next items to its place
+ */
+static void layout_cache_free_item(layout_cache_item_t * item)
+{
+    uint32_t item_ofs = (uint8_t *)item - LAYOUT_CACHE_ITEMS + 1;
+    uint32_t size = item->size;
+
+    /*Remove the item from its bucket*/
+    uint32_t * link = layout_cache_get_link(item->hash, item_ofs);
+    *link = item->next;
+
+    uint8_t * dst = (uint8_t *)item;
+    uint8_t * src = dst + size;
+    while(src < layout_cache_end) {
+        *dst = *src;
+        dst++;
+        src++;
+    }
+    layout_cache_end = dst;
+
+    /*Update the references to the moved items*/
+    uint32_t i;
+    for(i = 0; i < LAYOUT_CACHE_BUCKET_CNT; i++) {
+        if(LAYOUT_CACHE_BUCKETS[i] > item_ofs) LAYOUT_CACHE_BUCKETS[i] -= size;
+    }
+
+    uint8_t * p = LAYOUT_CACHE_ITEMS;
+    while(p < layout_cache_end) {
+        layout_cache_item_t * moved = (layout_cache_item_t *)p;
+        if(moved->next > item_ofs) moved->next -= size;
+        p += moved->size;
+    }
+}
+
+/**
+ * Get the bucket entry or the `next` field which refers to an item
+ */
+static uint32_t * layout_cache_get_link(uint32_t hash, uint32_t ofs)
+{
+    uint32_t * link = &LAYOUT_CACHE_BUCKETS[hash % LAYOUT_CACHE_BUCKET_CNT];
+    while(*link != ofs) {
+        link = &((layout_cache_item_t *)(LAYOUT_CACHE_ITEMS + *link - 1))->next;
+    }
+    return link;
+}
+#endif
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -29,6 +29,11 @@ extern "C" {
 #define LV_TXT_COLOR_CMD "#"
 #endif
 
+/*Texts longer than this (in bytes) are not stored in the layout cache*/
+#ifndef LV_TXT_LAYOUT_CACHE_MAX_LEN
+#define LV_TXT_LAYOUT_CACHE_MAX_LEN 256
+#endif
+
 #define LV_TXT_ENC_UTF8 1
 #define LV_TXT_ENC_ASCII 2
 
@@ -65,6 +70,19 @@ enum {
 };
 typedef uint8_t lv_text_align_t;
 
+/** A line of a text layout*/
+typedef struct {
+    uint32_t start;         /**< Byte index of the first character of the line*/
+    lv_coord_t width;       /**< Width of the line in pixels*/
+} lv_txt_layout_line_t;
+
+/** The line breaks and line widths of a text. See `_lv_txt_get_layout`*/
+typedef struct {
+    uint32_t line_cnt;
+    lv_coord_t max_line_width;      /**< Width of the longest line*/
+    lv_txt_layout_line_t * lines;   /**< `line_cnt + 1` lines. The `start` of the last is the length of the text.*/
+} lv_txt_layout_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -112,6 +130,27 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coor
 lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                             lv_text_flag_t flag);
 
+/**
+ * Get the line breaks and line widths of a text from the layout cache.
+ * The layout is calculated and cached if it's not cached yet.
+ * Only used if `LV_TXT_LAYOUT_CACHE_SIZE > 0` and for texts shorter than `LV_TXT_LAYOUT_CACHE_MAX_LEN`.
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the text (break the lines to fit this size). Set COORD_MAX to avoid
+ * line breaks
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return the layout or NULL if the text is not cached. It's valid until the next call of this function.
+ */
+const lv_txt_layout_t * _lv_txt_get_layout(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                                           lv_coord_t max_width, lv_text_flag_t flag);
+
+/**
+ * Remove all the cached text layouts.
+ * Needs to be called if a font is deleted or its glyphs are changed.
+ */
+void lv_txt_layout_cache_clear(void);
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
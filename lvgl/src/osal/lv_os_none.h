@@ -0,0 +1,42 @@
+/**
+ * @file lv_os_none.h
+ *
+ */
+
+#ifndef LV_OS_NONE_H
+#define LV_OS_NONE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Placeholders to allow using the types in structs without an OS*/
+typedef int lv_mutex_t;
+typedef int lv_thread_t;
+typedef int lv_thread_sync_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OS_NONE_H*/
@@ -15,6 +15,7 @@
  *      DEFINES
  *********************/
 #define MY_CLASS    &lv_ime_pinyin_class
+#define PY_MAX_LEN  15      /*Max. length of a pinyin (size of `input_char` without the '\0')*/
 
 /**********************
  *      TYPEDEFS
@@ -30,9 +31,22 @@ static void lv_ime_pinyin_kb_event(lv_event_t * e);
 static void lv_ime_pinyin_cand_panel_event(lv_event_t * e);
 
 static void init_pinyin_dict(lv_obj_t * obj, lv_pinyin_dict_t * dict);
+static void free_pinyin_dict(lv_obj_t * obj);
+static uint32_t parse_dict_file(lv_ime_pinyin_entry_t * entries, const char * buf, uint32_t size);
+static bool is_blank(char c);
+static const char * entry_py(const lv_ime_pinyin_t * pinyin_ime, const lv_ime_pinyin_entry_t * e);
+static const char * entry_text(const lv_ime_pinyin_t * pinyin_ime, const lv_ime_pinyin_entry_t * e);
+static int32_t entry_cmp(const lv_ime_pinyin_t * pinyin_ime, const lv_ime_pinyin_entry_t * a,
+                         const lv_ime_pinyin_entry_t * b);
+static void sift_down(lv_ime_pinyin_t * pinyin_ime, uint32_t root, uint32_t cnt);
+static void sort_entries(lv_ime_pinyin_t * pinyin_ime);
 static void pinyin_input_proc(lv_obj_t * obj);
 static void pinyin_page_proc(lv_obj_t * obj, uint16_t btn);
-static char * pinyin_search_matching(lv_obj_t * obj, char * py_str, uint16_t * cand_num);
+static void pinyin_fill_cand(lv_obj_t * obj);
+static bool pinyin_search_matching(lv_obj_t * obj, const char * py_str, uint16_t * cand_num);
+static void pinyin_search_step(const lv_ime_pinyin_t * pinyin_ime, const char * py_str, uint32_t depth,
+                               uint32_t * lo, uint32_t * hi);
+static void pinyin_search_range(lv_obj_t * obj, const char * py_str, uint32_t depth, uint32_t * lo, uint32_t * hi);
 static void pinyin_ime_clear_data(lv_obj_t * obj);
 
 #if LV_IME_PINYIN_USE_K9_MODE
@@ -47,6 +61,7 @@ static void pinyin_ime_clear_data(lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_ime_pinyin_class = {
+    .name = "ime_pinyin",
     .constructor_cb = lv_ime_pinyin_constructor,
     .destructor_cb  = lv_ime_pinyin_destructor,
     .width_def      = LV_SIZE_CONTENT,
@@ -68,7 +83,7 @@ static lv_btnmatrix_ctrl_t default_kb_ctrl_k9_map[LV_IME_PINYIN_K9_CAND_TEXT_NUM
 static char   lv_pinyin_k9_cand_str[LV_IME_PINYIN_K9_CAND_TEXT_NUM + 2][LV_IME_PINYIN_K9_MAX_INPUT] = {0};
 #endif
 
-static char   lv_pinyin_cand_str[LV_IME_PINYIN_CAND_TEXT_NUM][4];
+static char   lv_pinyin_cand_str[LV_IME_PINYIN_CAND_TEXT_NUM][LV_IME_PINYIN_CAND_MAX_LEN];
 static char * lv_btnm_def_pinyin_sel_map[LV_IME_PINYIN_CAND_TEXT_NUM + 3];
 
 #if LV_IME_PINYIN_USE_DEFAULT_DICT
@@ -447,9 +462,72 @@ void lv_ime_pinyin_set_dict(lv_obj_t * obj, lv_pinyin_dict_t * dict)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    pinyin_ime_clear_data(obj);
     init_pinyin_dict(obj, dict);
 }
 
+lv_res_t lv_ime_pinyin_set_dict_file(lv_obj_t * obj, const char * path)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(path);
+
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
+
+    pinyin_ime_clear_data(obj);
+    free_pinyin_dict(obj);
+
+    if(lv_fs_open(&pinyin_ime->dict_file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_WARN("couldn't open %s", path);
+        return LV_RES_INV;
+    }
+    pinyin_ime->dict_file_open = 1;
+
+    /*Use the content of the file directly if possible (e.g. memory mapped file) else read it*/
+    const void * buf = NULL;
+    uint32_t size = 0;
+    if(lv_fs_get_buf(&pinyin_ime->dict_file, &buf, &size) != LV_FS_RES_OK || buf == NULL) {
+        lv_fs_seek(&pinyin_ime->dict_file, 0, LV_FS_SEEK_END);
+        lv_fs_tell(&pinyin_ime->dict_file, &size);
+        lv_fs_seek(&pinyin_ime->dict_file, 0, LV_FS_SEEK_SET);
+
+        pinyin_ime->dict_buf = lv_malloc(size + 1);
+        LV_ASSERT_MALLOC(pinyin_ime->dict_buf);
+        uint32_t br = 0;
+        if(pinyin_ime->dict_buf == NULL ||
+           lv_fs_read(&pinyin_ime->dict_file, pinyin_ime->dict_buf, size, &br) != LV_FS_RES_OK || br != size) {
+            LV_LOG_WARN("couldn't read %s", path);
+            free_pinyin_dict(obj);
+            return LV_RES_INV;
+        }
+        lv_fs_close(&pinyin_ime->dict_file);
+        pinyin_ime->dict_file_open = 0;
+        buf = pinyin_ime->dict_buf;
+    }
+    pinyin_ime->dict_data = buf;
+
+    /*Count the entries first to allocate the index at once*/
+    uint32_t cnt = parse_dict_file(NULL, buf, size);
+    if(cnt == 0) {
+        LV_LOG_WARN("no entries in %s", path);
+        free_pinyin_dict(obj);
+        return LV_RES_INV;
+    }
+
+    pinyin_ime->entries = lv_malloc(cnt * sizeof(lv_ime_pinyin_entry_t));
+    LV_ASSERT_MALLOC(pinyin_ime->entries);
+    if(pinyin_ime->entries == NULL) {
+        free_pinyin_dict(obj);
+        return LV_RES_INV;
+    }
+
+    pinyin_ime->entry_cnt = parse_dict_file(pinyin_ime->entries, buf, size);
+    pinyin_ime->cand_per_char = 0;
+    sort_entries(pinyin_ime);
+
+    LV_LOG_INFO("%"LV_PRIu32" entries loaded from %s", pinyin_ime->entry_cnt, path);
+    return LV_RES_OK;
+}
+
 /**
  * Set mode, 26-key input(k26) or 9-key input(k9).
  * @param obj  pointer to a Pinyin input method object
@@ -559,8 +637,6 @@ static void lv_ime_pinyin_constructor(const lv_obj_class_t * class_p, lv_obj_t *
     pinyin_ime->ta_count = 0;
     pinyin_ime->cand_num = 0;
     lv_memzero(pinyin_ime->input_char, sizeof(pinyin_ime->input_char));
-    lv_memzero(pinyin_ime->py_num, sizeof(pinyin_ime->py_num));
-    lv_memzero(pinyin_ime->py_pos, sizeof(pinyin_ime->py_pos));
 
     lv_obj_set_size(obj, LV_PCT(100), LV_PCT(55));
     lv_obj_align(obj, LV_ALIGN_BOTTOM_MID, 0, 0);
@@ -625,6 +701,12 @@ static void lv_ime_pinyin_destructor(const lv_obj_class_t * class_p, lv_obj_t *
 
     if(lv_obj_is_valid(pinyin_ime->cand_panel))
         lv_obj_del(pinyin_ime->cand_panel);
+
+    free_pinyin_dict(obj);
+
+#if LV_IME_PINYIN_USE_K9_MODE
+    _lv_ll_clear(&pinyin_ime->k9_legal_py_ll);
+#endif
 }
 
 
@@ -800,24 +882,12 @@ static void pinyin_input_proc(lv_obj_t * obj)
 {
     lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
 
-    pinyin_ime->cand_str = pinyin_search_matching(obj, pinyin_ime->input_char, &pinyin_ime->cand_num);
-    if(pinyin_ime->cand_str == NULL) {
+    if(!pinyin_search_matching(obj, pinyin_ime->input_char, &pinyin_ime->cand_num)) {
         return;
     }
 
     pinyin_ime->py_page = 0;
-
-    for(uint8_t i = 0; i < LV_IME_PINYIN_CAND_TEXT_NUM; i++) {
-        memset(lv_pinyin_cand_str[i], 0x00, sizeof(lv_pinyin_cand_str[i]));
-        lv_pinyin_cand_str[i][0] = ' ';
-    }
-
-    // fill buf
-    for(uint8_t i = 0; (i < pinyin_ime->cand_num && i < LV_IME_PINYIN_CAND_TEXT_NUM); i++) {
-        for(uint8_t j = 0; j < 3; j++) {
-            lv_pinyin_cand_str[i][j] = pinyin_ime->cand_str[i * 3 + j];
-        }
-    }
+    pinyin_fill_cand(obj);
 
     lv_obj_clear_flag(pinyin_ime->cand_panel, LV_OBJ_FLAG_HIDDEN);
 }
@@ -843,22 +913,45 @@ static void pinyin_page_proc(lv_obj_t * obj, uint16_t dir)
         else return;
     }
 
+    pinyin_fill_cand(obj);
+}
+
+/*Copy the candidates of the current page to the buttons of the candidate panel*/
+static void pinyin_fill_cand(lv_obj_t * obj)
+{
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
+
     for(uint8_t i = 0; i < LV_IME_PINYIN_CAND_TEXT_NUM; i++) {
-        memset(lv_pinyin_cand_str[i], 0x00, sizeof(lv_pinyin_cand_str[i]));
+        lv_memzero(lv_pinyin_cand_str[i], sizeof(lv_pinyin_cand_str[i]));
         lv_pinyin_cand_str[i][0] = ' ';
     }
 
-    // fill buf
-    uint16_t offset = pinyin_ime->py_page * (3 * LV_IME_PINYIN_CAND_TEXT_NUM);
-    for(uint8_t i = 0; (i < pinyin_ime->cand_num && i < LV_IME_PINYIN_CAND_TEXT_NUM); i++) {
-        if((sur > 0) && (pinyin_ime->py_page == page_num)) {
-            if(i > sur)
-                break;
+    uint32_t first = (uint32_t)pinyin_ime->py_page * LV_IME_PINYIN_CAND_TEXT_NUM;
+    const lv_ime_pinyin_entry_t * e = &pinyin_ime->entries[pinyin_ime->cand_start];
+    uint32_t ofs = 0;
+    uint32_t c;
+    for(c = 0; c < first + LV_IME_PINYIN_CAND_TEXT_NUM && c < pinyin_ime->cand_num; c++) {
+        /*A character of the entry or a whole entry*/
+        const char * txt;
+        uint32_t len;
+        if(pinyin_ime->cand_per_char) {
+            txt = entry_text(pinyin_ime, e) + ofs;
+            len = _lv_txt_encoded_size(txt);
+            ofs += len;
         }
-        for(uint8_t j = 0; j < 3; j++) {
-            lv_pinyin_cand_str[i][j] = pinyin_ime->cand_str[offset + (i * 3) + j];
+        else {
+            txt = entry_text(pinyin_ime, &e[c]);
+            len = e[c].text_len;
+        }
+
+        if(c >= first) {
+            len = LV_MIN(len, LV_IME_PINYIN_CAND_MAX_LEN - 1);
+            lv_memcpy(lv_pinyin_cand_str[c - first], txt, len);
+            lv_pinyin_cand_str[c - first][len] = '\0';
         }
     }
+
+    lv_obj_invalidate(pinyin_ime->cand_panel);
 }
 
 
@@ -880,72 +973,265 @@ static void init_pinyin_dict(lv_obj_t * obj, lv_pinyin_dict_t * dict)
 {
     lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
 
-    char headletter = 'a';
-    uint16_t offset_sum = 0;
-    uint16_t offset_count = 0;
-    uint16_t letter_calc = 0;
-
+    free_pinyin_dict(obj);
     pinyin_ime->dict = dict;
+    if(dict == NULL) return;
+
+    uint32_t cnt = 0;
+    while(dict[cnt].py && dict[cnt].py_mb) cnt++;
+    if(cnt == 0) return;
+
+    pinyin_ime->entries = lv_malloc(cnt * sizeof(lv_ime_pinyin_entry_t));
+    LV_ASSERT_MALLOC(pinyin_ime->entries);
+    if(pinyin_ime->entries == NULL) return;
+
+    /*The characters of an entry are candidates in their order.
+     *Keep the order of the entries with the same pinyin too.*/
+    for(uint32_t i = 0; i < cnt; i++) {
+        lv_ime_pinyin_entry_t * e = &pinyin_ime->entries[i];
+        e->ref = i;
+        e->py_len = (uint8_t)LV_MIN(strlen(dict[i].py), 255);
+        e->text_ofs = 0;
+        e->text_len = (uint8_t)LV_MIN(strlen(dict[i].py_mb), 255);
+        e->freq = UINT32_MAX - i;
+    }
+    pinyin_ime->entry_cnt = cnt;
+    pinyin_ime->cand_per_char = 1;
+    sort_entries(pinyin_ime);
+}
 
-    for(uint16_t i = 0; ; i++) {
-        if((NULL == (dict[i].py)) || (NULL == (dict[i].py_mb))) {
-            headletter = dict[i - 1].py[0];
-            letter_calc = headletter - 'a';
-            pinyin_ime->py_num[letter_calc] = offset_count;
-            break;
-        }
+static void free_pinyin_dict(lv_obj_t * obj)
+{
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
+
+    if(pinyin_ime->dict_file_open) {
+        lv_fs_close(&pinyin_ime->dict_file);
+        pinyin_ime->dict_file_open = 0;
+    }
+    lv_free(pinyin_ime->dict_buf);
+    lv_free(pinyin_ime->entries);
+    pinyin_ime->dict_buf = NULL;
+    pinyin_ime->dict_data = NULL;
+    pinyin_ime->entries = NULL;
+    pinyin_ime->entry_cnt = 0;
+    pinyin_ime->dict = NULL;
+    pinyin_ime->cand_num = 0;
+
+    /*Invalidate the saved search*/
+    lv_memzero(pinyin_ime->search_str, sizeof(pinyin_ime->search_str));
+    pinyin_ime->search_lo[0] = 0;
+    pinyin_ime->search_hi[0] = 0;
+}
+
+static bool is_blank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
 
-        if(headletter == (dict[i].py[0])) {
-            offset_count++;
+/*Parse the lines of a dictionary file into `entries` or just count them if `entries == NULL`*/
+static uint32_t parse_dict_file(lv_ime_pinyin_entry_t * entries, const char * buf, uint32_t size)
+{
+    uint32_t cnt = 0;
+    const char * end = buf + size;
+    const char * line = buf;
+    while(line < end) {
+        const char * line_end = memchr(line, '\n', end - line);
+        if(line_end == NULL) line_end = end;
+
+        const char * p = line;
+        line = line_end + 1;
+
+        while(p < line_end && is_blank(*p)) p++;
+        if(p == line_end || *p == '#') continue;
+
+        /*Pinyin*/
+        const char * py = p;
+        while(p < line_end && *p >= 'a' && *p <= 'z') p++;
+        uint32_t py_len = p - py;
+        if(py_len == 0 || py_len > PY_MAX_LEN || p == line_end || !is_blank(*p)) continue;
+
+        /*Candidate*/
+        while(p < line_end && is_blank(*p)) p++;
+        const char * text = p;
+        while(p < line_end && !is_blank(*p)) p++;
+        uint32_t text_len = p - text;
+        if(text_len == 0 || text_len >= LV_IME_PINYIN_CAND_MAX_LEN || text - py > UINT8_MAX) continue;
+
+        /*Optional frequency*/
+        while(p < line_end && is_blank(*p)) p++;
+        uint32_t freq = 0;
+        while(p < line_end && *p >= '0' && *p <= '9') {
+            freq = freq * 10 + (*p - '0');
+            p++;
         }
-        else {
-            headletter = dict[i].py[0];
-            letter_calc = headletter - 'a';
-            pinyin_ime->py_num[letter_calc - 1] = offset_count;
-            offset_sum += offset_count;
-            pinyin_ime->py_pos[letter_calc] = offset_sum;
 
-            offset_count = 1;
+        if(entries) {
+            entries[cnt].ref = py - buf;
+            entries[cnt].py_len = (uint8_t)py_len;
+            entries[cnt].text_ofs = (uint8_t)(text - py);
+            entries[cnt].text_len = (uint8_t)text_len;
+            entries[cnt].freq = freq;
         }
+        cnt++;
     }
+
+    return cnt;
 }
 
+static const char * entry_py(const lv_ime_pinyin_t * pinyin_ime, const lv_ime_pinyin_entry_t * e)
+{
+    if(pinyin_ime->dict_data) return pinyin_ime->dict_data + e->ref;
+    else return pinyin_ime->dict[e->ref].py;
+}
 
-static char * pinyin_search_matching(lv_obj_t * obj, char * py_str, uint16_t * cand_num)
+static const char * entry_text(const lv_ime_pinyin_t * pinyin_ime, const lv_ime_pinyin_entry_t * e)
 {
-    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
+    if(pinyin_ime->dict_data) return pinyin_ime->dict_data + e->ref + e->text_ofs;
+    else return pinyin_ime->dict[e->ref].py_mb;
+}
 
-    lv_pinyin_dict_t * cpHZ;
-    uint8_t index, len = 0, offset;
-    volatile uint8_t count = 0;
+/*Order by pinyin and by descending frequency for the same pinyin*/
+static int32_t entry_cmp(const lv_ime_pinyin_t * pinyin_ime, const lv_ime_pinyin_entry_t * a,
+                         const lv_ime_pinyin_entry_t * b)
+{
+    uint32_t len = LV_MIN(a->py_len, b->py_len);
+    int r = memcmp(entry_py(pinyin_ime, a), entry_py(pinyin_ime, b), len);
+    if(r) return r;
+    if(a->py_len != b->py_len) return (int32_t)a->py_len - b->py_len;
+    if(a->freq != b->freq) return a->freq > b->freq ? -1 : 1;
+    return 0;
+}
 
-    if(*py_str == '\0')    return NULL;
-    if(*py_str == 'i')     return NULL;
-    if(*py_str == 'u')     return NULL;
-    if(*py_str == 'v')     return NULL;
+static void sift_down(lv_ime_pinyin_t * pinyin_ime, uint32_t root, uint32_t cnt)
+{
+    lv_ime_pinyin_entry_t * entries = pinyin_ime->entries;
+    while(root * 2 + 1 < cnt) {
+        uint32_t child = root * 2 + 1;
+        if(child + 1 < cnt && entry_cmp(pinyin_ime, &entries[child], &entries[child + 1]) < 0) child++;
+        if(entry_cmp(pinyin_ime, &entries[root], &entries[child]) >= 0) return;
+
+        lv_ime_pinyin_entry_t tmp = entries[root];
+        entries[root] = entries[child];
+        entries[child] = tmp;
+        root = child;
+    }
+}
 
-    offset = py_str[0] - 'a';
-    len = strlen(py_str);
+/*Heap sort to sort large dictionaries in place*/
+static void sort_entries(lv_ime_pinyin_t * pinyin_ime)
+{
+    lv_ime_pinyin_entry_t * entries = pinyin_ime->entries;
+    uint32_t cnt = pinyin_ime->entry_cnt;
 
-    cpHZ  = &pinyin_ime->dict[pinyin_ime->py_pos[offset]];
-    count = pinyin_ime->py_num[offset];
+    /*Usually the dictionaries are already sorted*/
+    uint32_t i;
+    for(i = 1; i < cnt; i++) {
+        if(entry_cmp(pinyin_ime, &entries[i - 1], &entries[i]) > 0) break;
+    }
+    if(i >= cnt) return;
+
+    for(i = cnt / 2; i > 0; i--) sift_down(pinyin_ime, i - 1, cnt);
+    for(i = cnt - 1; i > 0; i--) {
+        lv_ime_pinyin_entry_t tmp = entries[0];
+        entries[0] = entries[i];
+        entries[i] = tmp;
+        sift_down(pinyin_ime, 0, i);
+    }
+}
 
-    while(count--) {
-        for(index = 0; index < len; index++) {
-            if(*(py_str + index) != *((cpHZ->py) + index)) {
-                break;
-            }
-        }
+/**
+ * Narrow the range of entries starting with `py_str[0..depth-1]` to the ones starting with `py_str[0..depth]`.
+ * As the entries are sorted, the entries with the same prefix are in a continuous range
+ * (i.e. the ranges are the nodes of a prefix trie) and it can be found by binary searches.
+ */
+static void pinyin_search_step(const lv_ime_pinyin_t * pinyin_ime, const char * py_str, uint32_t depth,
+                               uint32_t * lo, uint32_t * hi)
+{
+    const lv_ime_pinyin_entry_t * entries = pinyin_ime->entries;
+    char c = py_str[depth];
+
+    /*First entry whose letter at `depth` is not less than `c` (shorter entries are less)*/
+    uint32_t l = *lo;
+    uint32_t h = *hi;
+    while(l < h) {
+        uint32_t m = l + (h - l) / 2;
+        if(entries[m].py_len <= depth || entry_py(pinyin_ime, &entries[m])[depth] < c) l = m + 1;
+        else h = m;
+    }
+    uint32_t first = l;
+
+    /*First entry whose letter at `depth` is greater than `c`*/
+    h = *hi;
+    while(l < h) {
+        uint32_t m = l + (h - l) / 2;
+        if(entry_py(pinyin_ime, &entries[m])[depth] <= c) l = m + 1;
+        else h = m;
+    }
+
+    *lo = first;
+    *hi = l;
+}
 
-        // perfect match
-        if(len == 1 || index == len) {
-            // The Chinese character in UTF-8 encoding format is 3 bytes
-            * cand_num = strlen((const char *)(cpHZ->py_mb)) / 3;
-            return (char *)(cpHZ->py_mb);
+/*Find the range of the entries starting with `py_str[0..depth-1]`.
+ *Continue from the saved ranges of the previous search.*/
+static void pinyin_search_range(lv_obj_t * obj, const char * py_str, uint32_t depth, uint32_t * lo, uint32_t * hi)
+{
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
+
+    /*The ranges of the common prefix with the previous search are still valid*/
+    uint32_t d = 0;
+    while(d < depth && pinyin_ime->search_str[d] == py_str[d]) d++;
+
+    pinyin_ime->search_lo[0] = 0;
+    pinyin_ime->search_hi[0] = pinyin_ime->entry_cnt;
+    while(d < depth) {
+        pinyin_ime->search_lo[d + 1] = pinyin_ime->search_lo[d];
+        pinyin_ime->search_hi[d + 1] = pinyin_ime->search_hi[d];
+        pinyin_search_step(pinyin_ime, py_str, d, &pinyin_ime->search_lo[d + 1], &pinyin_ime->search_hi[d + 1]);
+        pinyin_ime->search_str[d] = py_str[d];
+        d++;
+    }
+    pinyin_ime->search_str[depth] = '\0';
+
+    *lo = pinyin_ime->search_lo[depth];
+    *hi = pinyin_ime->search_hi[depth];
+}
+
+static bool pinyin_search_matching(lv_obj_t * obj, const char * py_str, uint16_t * cand_num)
+{
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
+
+    uint32_t len = strlen(py_str);
+    if(len == 0 || len > PY_MAX_LEN || pinyin_ime->entry_cnt == 0) return false;
+
+    uint32_t lo;
+    uint32_t hi;
+    pinyin_search_range(obj, py_str, len, &lo, &hi);
+    if(lo >= hi) return false;
+
+    /*The first entry is the perfect match if there is any, else the first longer pinyin.
+     *Its candidates are the entries with the same pinyin (already ordered by frequency).*/
+    const lv_ime_pinyin_entry_t * e = &pinyin_ime->entries[lo];
+    uint32_t cnt = 0;
+    if(pinyin_ime->cand_per_char) {
+        const char * text = entry_text(pinyin_ime, e);
+        uint32_t ofs = 0;
+        while(ofs < e->text_len) {
+            ofs += _lv_txt_encoded_size(&text[ofs]);
+            cnt++;
+        }
+    }
+    else {
+        const char * py = entry_py(pinyin_ime, e);
+        while(lo + cnt < hi && cnt < UINT16_MAX && e[cnt].py_len == e->py_len &&
+              memcmp(entry_py(pinyin_ime, &e[cnt]), py, e->py_len) == 0) {
+            cnt++;
         }
-        cpHZ++;
     }
-    return NULL;
+
+    pinyin_ime->cand_start = lo;
+    *cand_num = (uint16_t)cnt;
+    return cnt > 0;
 }
 
 static void pinyin_ime_clear_data(lv_obj_t * obj)
@@ -975,6 +1261,8 @@ static void pinyin_ime_clear_data(lv_obj_t * obj)
 #if LV_IME_PINYIN_USE_K9_MODE
 static void pinyin_k9_init_data(lv_obj_t * obj)
 {
+    LV_UNUSED(obj);
+
     uint16_t py_str_i = 0;
     uint16_t btnm_i = 0;
     for(btnm_i = 19; btnm_i < (LV_IME_PINYIN_K9_CAND_TEXT_NUM + 21); btnm_i++) {
@@ -1027,11 +1315,11 @@ static void pinyin_k9_get_legal_py(lv_obj_t * obj, char * k9_input, const char *
     while(index != -1) {
         if(index == len) {
             if(pinyin_k9_is_valid_py(obj, py_comp)) {
-                if((count >= ll_len) || (ll_len == 0)) {
+                if(((uint32_t)count >= ll_len) || (ll_len == 0)) {
                     ll_index = _lv_ll_ins_tail(&pinyin_ime->k9_legal_py_ll);
                     strcpy(ll_index->py_str, py_comp);
                 }
-                else if((count < ll_len)) {
+                else if(((uint32_t)count < ll_len)) {
                     strcpy(ll_index->py_str, py_comp);
                     ll_index = _lv_ll_get_next(&pinyin_ime->k9_legal_py_ll, ll_index);
                 }
@@ -1041,7 +1329,7 @@ static void pinyin_k9_get_legal_py(lv_obj_t * obj, char * k9_input, const char *
         }
         else {
             flag = mark[index];
-            if(flag < strlen(py9_map[k9_input[index] - '2'])) {
+            if((size_t)flag < strlen(py9_map[k9_input[index] - '2'])) {
                 py_comp[index] = py9_map[k9_input[index] - '2'][flag];
                 mark[index] = mark[index] + 1;
                 index++;
@@ -1063,37 +1351,13 @@ static void pinyin_k9_get_legal_py(lv_obj_t * obj, char * k9_input, const char *
 /*true: visible; false: not visible*/
 static bool pinyin_k9_is_valid_py(lv_obj_t * obj, char * py_str)
 {
-    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
-
-    lv_pinyin_dict_t * cpHZ = NULL;
-    uint8_t index = 0, len = 0, offset = 0;
-    volatile uint8_t count = 0;
-
-    if(*py_str == '\0')    return false;
-    if(*py_str == 'i')     return false;
-    if(*py_str == 'u')     return false;
-    if(*py_str == 'v')     return false;
-
-    offset = py_str[0] - 'a';
-    len = strlen(py_str);
+    uint32_t len = strlen(py_str);
+    if(len == 0 || len > PY_MAX_LEN) return false;
 
-    cpHZ  = &pinyin_ime->dict[pinyin_ime->py_pos[offset]];
-    count = pinyin_ime->py_num[offset];
-
-    while(count--) {
-        for(index = 0; index < len; index++) {
-            if(*(py_str + index) != *((cpHZ->py) + index)) {
-                break;
-            }
-        }
-
-        // perfect match
-        if(len == 1 || index == len) {
-            return true;
-        }
-        cpHZ++;
-    }
-    return false;
+    uint32_t lo;
+    uint32_t hi;
+    pinyin_search_range(obj, py_str, len, &lo, &hi);
+    return lo < hi;
 }
 
 
@@ -20,6 +20,7 @@ extern "C" {
  *      DEFINES
  *********************/
 #define LV_IME_PINYIN_K9_MAX_INPUT  7
+#define LV_IME_PINYIN_CAND_MAX_LEN  32  /*Max. length of a candidate (character or word) in bytes with the closing '\0'*/
 
 /**********************
  *      TYPEDEFS
@@ -37,6 +38,15 @@ typedef struct {
     const char * const py_mb;
 } lv_pinyin_dict_t;
 
+/*An entry of the sorted index of the dictionary: a pinyin and its candidate(s)*/
+typedef struct {
+    uint32_t ref;               /* Index in the `lv_pinyin_dict_t` array or offset of the line in the dictionary file */
+    uint32_t freq;              /* Entries with the same pinyin are ordered by descending frequency */
+    uint8_t py_len;
+    uint8_t text_ofs;           /* Offset of the candidate from the start of the line in the dictionary file */
+    uint8_t text_len;
+} lv_ime_pinyin_entry_t;
+
 /*Data of 9-key input(k9) mode*/
 typedef struct {
     char py_str[7];
@@ -48,8 +58,18 @@ typedef struct {
     lv_obj_t * kb;
     lv_obj_t * cand_panel;
     lv_pinyin_dict_t * dict;
+    lv_ime_pinyin_entry_t * entries;    /* Index of the dictionary sorted by pinyin */
+    uint32_t entry_cnt;
+    uint32_t search_lo[16];     /* Range of the entries matching the first i letters of `search_str` */
+    uint32_t search_hi[16];
+    char   search_str[16];      /* The input of the last search */
+    uint32_t cand_start;        /* First entry of the candidates */
+    lv_fs_file_t dict_file;     /* The open dictionary file */
+    const char * dict_data;     /* Content of the dictionary file */
+    char * dict_buf;            /* Content of the dictionary file if it couldn't be accessed directly */
+    uint8_t dict_file_open : 1;
+    uint8_t cand_per_char : 1;  /* 1: each character of an entry is a candidate (`lv_pinyin_dict_t`) */
     lv_ll_t k9_legal_py_ll;
-    char * cand_str;            /* Candidate string */
     char   input_char[16];      /* Input box character */
 #if LV_IME_PINYIN_USE_K9_MODE
     char   k9_input_str[LV_IME_PINYIN_K9_MAX_INPUT]; /* 9-key input(k9) mode input string */
@@ -60,8 +80,6 @@ typedef struct {
     uint16_t ta_count;          /* The number of characters entered in the text box this time */
     uint16_t cand_num;          /* Number of candidates */
     uint16_t py_page;           /* Current pinyin map pages(k26) */
-    uint16_t py_num[26];        /* Number and length of Pinyin */
-    uint16_t py_pos[26];        /* Pinyin position */
     lv_ime_pinyin_mode_t  mode; /* Set mode, 1: 26-key input(k26), 0: 9-key input(k9). Default: 1. */
 } lv_ime_pinyin_t;
 
@@ -92,6 +110,18 @@ void lv_ime_pinyin_set_keyboard(lv_obj_t * obj, lv_obj_t * kb);
  */
 void lv_ime_pinyin_set_dict(lv_obj_t * obj, lv_pinyin_dict_t * dict);
 
+/**
+ * Load the dictionary of Pinyin input method from a file.
+ * The file is accessed directly if the driver supports it (e.g. a memory mapped file), else it's read into the memory.
+ * It's a UTF-8 text file with one entry per line: `pinyin candidate [frequency]`, e.g. `yumi 玉米 950`.
+ * The fields are separated by spaces or tabs, the lines starting with `#` are ignored.
+ * The pinyin can contain only the letters `a`-`z`, and the candidates of a pinyin are ordered by descending frequency.
+ * @param obj  pointer to a Pinyin input method object
+ * @param path path to the dictionary file
+ * @return     LV_RES_OK: the dictionary is loaded; LV_RES_INV: the file couldn't be loaded
+ */
+lv_res_t lv_ime_pinyin_set_dict_file(lv_obj_t * obj, const char * path);
+
 /**
  * Set mode, 26-key input(k26) or 9-key input(k9).
  * @param obj  pointer to a Pinyin input method object
@@ -121,9 +151,9 @@ lv_obj_t * lv_ime_pinyin_get_cand_panel(lv_obj_t * obj);
 
 
 /**
- * Set the dictionary of Pinyin input method.
+ * Get the dictionary of Pinyin input method.
  * @param obj  pointer to a Pinyin input method object
- * @return     pointer to the Pinyin input method dictionary
+ * @return     pointer to the Pinyin input method dictionary or NULL if it was loaded from a file
  */
 lv_pinyin_dict_t * lv_ime_pinyin_get_dict(lv_obj_t * obj);
 
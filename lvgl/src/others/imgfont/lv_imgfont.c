@@ -79,6 +79,8 @@ void lv_imgfont_destroy(lv_font_t * font)
 
     imgfont_dsc_t * dsc = (imgfont_dsc_t *)font->dsc;
     lv_free(dsc);
+
+    lv_txt_layout_cache_clear();
 }
 
 /**********************
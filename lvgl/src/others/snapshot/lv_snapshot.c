@@ -12,21 +12,94 @@
 #include <stdbool.h>
 #include "../../core/lv_disp.h"
 #include "../../core/lv_refr.h"
+#include "../../draw/lv_img_cache.h"
+#include "../../misc/lv_gc.h"
+#include "../../misc/lv_timer.h"
+#include "../../osal/lv_os.h"
 /*********************
  *      DEFINES
  *********************/
+#define SESSION_LL          LV_GC_ROOT(_lv_snapshot_session_ll)
+
+/*Number of outdated areas stored per session. More are merged into their bounding box.*/
+#define DIRTY_AREA_MAX      8
+
+#define CHECK_PERIOD        10      /*[ms] Check the finished encodings this often*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+typedef enum {
+    ENCODE_IDLE,
+    ENCODE_QUEUED,          /*Waiting for the encoder thread*/
+    ENCODE_RUNNING,         /*The encoder thread is encoding it*/
+    ENCODE_READY,           /*`enc_buf` can be passed to the callback*/
+} encode_state_t;
+#endif
+
+struct _lv_snapshot_session_t {
+    lv_obj_t * obj;                     /*The watched object. NULL if it was deleted.*/
+    lv_disp_t disp;                     /*Fake display to render with*/
+    lv_disp_drv_t driver;
+    lv_img_dsc_t img;                   /*The last snapshot. `data` is NULL until the first take.*/
+    lv_area_t area;                     /*Absolute coordinates of the object with its extra draw size*/
+    lv_area_t dirty[DIRTY_AREA_MAX];    /*Outdated parts of the image, relative to the image*/
+    lv_area_t changed;                  /*Rendered by the last take, relative to the image*/
+    lv_area_t unsent;                   /*Changed since the last encoding, relative to the image*/
+    lv_snapshot_encoded_cb_t encoded_cb;
+    void * encoded_user_data;
+    uint8_t * enc_src;                  /*Copy of the pixels to encode*/
+    uint8_t * enc_buf;                  /*Header and the encoded pixels*/
+    uint32_t enc_src_size;              /*Allocated size of `enc_src`*/
+    uint32_t enc_buf_size;              /*Allocated size of `enc_buf`*/
+    uint32_t enc_size;                  /*Size of the encoded data in `enc_buf`*/
+    uint32_t enc_px_cnt;
+    uint8_t enc_px_size;
+    uint8_t dirty_cnt;
+    uint8_t has_changed : 1;
+    uint8_t has_unsent : 1;
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    uint8_t deleted : 1;                /*Deleted while it was encoded, free it when finished*/
+    encode_state_t enc_state;           /*Protected by `mutex`*/
+#endif
+};
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static uint32_t get_px_size(lv_img_cf_t cf);
+static uint32_t get_render_px_size(lv_img_cf_t cf);
+static void free_session(lv_snapshot_session_t * session);
+static void free_unlinked_session(lv_snapshot_session_t * session);
+static void get_snapshot_area(lv_obj_t * obj, lv_area_t * area);
+static void add_dirty_area(lv_snapshot_session_t * session, const lv_area_t * area);
+static void add_changed_area(lv_snapshot_session_t * session, const lv_area_t * area);
+static void clear_area(lv_snapshot_session_t * session, const lv_area_t * area);
+static bool reserve_buf(uint8_t ** buf, uint32_t * buf_size, uint32_t size);
+static void encode_session(lv_snapshot_session_t * session);
+static uint32_t rle_encode(uint8_t * dst, const uint8_t * src, uint32_t px_cnt, uint32_t px_size);
+static void put_u16(uint8_t * p, uint32_t v);
+static uint32_t get_u16(const uint8_t * p);
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+static bool start_encoder(void);
+static void encoder_thread_cb(void * user_data);
+static void check_timer_cb(lv_timer_t * t);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static const uint8_t magic[4] = {'L', 'V', 'S', 'S'};
+
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+static lv_thread_t encoder_thread;
+static lv_thread_sync_t encoder_sync;   /*Wakes up the encoder when a session is queued or it should stop*/
+static lv_mutex_t mutex;                /*Protects the session list and `enc_state`*/
+static lv_timer_t * check_timer;
+static bool encoder_started;
+static bool encoder_exit;
+#endif
 
 /**********************
  *      MACROS
@@ -210,8 +283,698 @@ void lv_snapshot_free(lv_img_dsc_t * dsc)
     lv_free(dsc);
 }
 
+void _lv_snapshot_session_init(void)
+{
+    _lv_ll_init(&SESSION_LL, sizeof(lv_snapshot_session_t));
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    lv_mutex_init(&mutex);
+#endif
+}
+
+void _lv_snapshot_session_deinit(void)
+{
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    if(encoder_started) {
+        lv_mutex_lock(&mutex);
+        encoder_exit = true;
+        lv_mutex_unlock(&mutex);
+
+        lv_thread_sync_signal(&encoder_sync);
+        lv_thread_delete(&encoder_thread);
+        lv_thread_sync_delete(&encoder_sync);
+        encoder_started = false;
+        encoder_exit = false;
+    }
+#endif
+
+    lv_snapshot_session_t * session = _lv_ll_get_head(&SESSION_LL);
+    while(session) {
+        lv_snapshot_session_t * next = _lv_ll_get_next(&SESSION_LL, session);
+        free_session(session);
+        session = next;
+    }
+
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    lv_mutex_delete(&mutex);
+    if(check_timer) {
+        lv_timer_del(check_timer);
+        check_timer = NULL;
+    }
+#endif
+}
+
+lv_snapshot_session_t * lv_snapshot_session_create(lv_obj_t * obj, lv_img_cf_t cf)
+{
+    LV_ASSERT_NULL(obj);
+    if(get_px_size(cf) == 0) {
+        LV_LOG_WARN("Not supported color format");
+        return NULL;
+    }
+
+    lv_disp_t * obj_disp = lv_obj_get_disp(obj);
+    lv_draw_ctx_t * draw_ctx = lv_malloc(obj_disp->driver->draw_ctx_size);
+    LV_ASSERT_MALLOC(draw_ctx);
+    if(draw_ctx == NULL) return NULL;
+
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    lv_mutex_lock(&mutex);
+#endif
+    lv_snapshot_session_t * session = _lv_ll_ins_head(&SESSION_LL);
+    if(session) lv_memzero(session, sizeof(lv_snapshot_session_t));
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    lv_mutex_unlock(&mutex);
+#endif
+    LV_ASSERT_MALLOC(session);
+    if(session == NULL) {
+        lv_free(draw_ctx);
+        return NULL;
+    }
+
+    session->obj = obj;
+    session->img.header.cf = cf;
+
+    lv_disp_drv_init(&session->driver);
+    /*In lack of a better idea use the resolution of the object's display*/
+    session->driver.hor_res = lv_disp_get_hor_res(obj_disp);
+    session->driver.ver_res = lv_disp_get_ver_res(obj_disp);
+    session->driver.draw_ctx_init = obj_disp->driver->draw_ctx_init;
+    session->driver.draw_ctx_deinit = obj_disp->driver->draw_ctx_deinit;
+    session->driver.draw_ctx_size = obj_disp->driver->draw_ctx_size;
+    session->disp.driver = &session->driver;
+
+    session->driver.draw_ctx_init(&session->driver, draw_ctx);
+    session->driver.draw_ctx = draw_ctx;
+    if(cf == LV_IMG_CF_ALPHA_8BIT) draw_ctx->color_format = LV_COLOR_FORMAT_L8;
+    else draw_ctx->render_with_alpha = cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+
+    return session;
+}
+
+void lv_snapshot_session_del(lv_snapshot_session_t * session)
+{
+    LV_ASSERT_NULL(session);
+
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    /*The encoder or the callback still uses it, it will be freed by the check timer*/
+    lv_mutex_lock(&mutex);
+    bool busy = session->enc_state == ENCODE_RUNNING || session->enc_state == ENCODE_READY;
+    if(busy) {
+        session->deleted = 1;
+        session->obj = NULL;
+    }
+    else {
+        /*Unlink a queued session in the same critical section so that the encoder thread can't take it*/
+        session->enc_state = ENCODE_IDLE;
+        _lv_ll_remove(&SESSION_LL, session);
+    }
+    lv_mutex_unlock(&mutex);
+    if(!busy) free_unlinked_session(session);
+#else
+    free_session(session);
+#endif
+}
+
+const lv_img_dsc_t * lv_snapshot_session_take(lv_snapshot_session_t * session)
+{
+    LV_ASSERT_NULL(session);
+
+    session->has_changed = 0;
+    if(session->obj == NULL) return NULL;
+
+    lv_obj_update_layout(session->obj);
+
+    lv_area_t area;
+    get_snapshot_area(session->obj, &area);
+    lv_coord_t w = lv_area_get_width(&area);
+    lv_coord_t h = lv_area_get_height(&area);
+    lv_img_cf_t cf = session->img.header.cf;
+    lv_area_t full_area = {0, 0, w - 1, h - 1};
+
+    if(session->img.data == NULL || session->img.header.w != w || session->img.header.h != h) {
+        void * buf = lv_realloc((void *)session->img.data, (uint32_t)w * h * get_render_px_size(cf));
+        LV_ASSERT_MALLOC(buf);
+        if(buf == NULL) return NULL;
+
+        session->img.data = buf;
+        session->img.header.w = w;
+        session->img.header.h = h;
+        session->img.data_size = (uint32_t)w * h * get_px_size(cf);
+        session->dirty[0] = full_area;
+        session->dirty_cnt = 1;
+        session->has_unsent = 0;
+    }
+    else if(cf == LV_IMG_CF_ALPHA_8BIT) {
+        /*The pixels are converted in place after rendering so they can't be updated*/
+        session->dirty[0] = full_area;
+        session->dirty_cnt = 1;
+    }
+    /*If the object was moved (e.g. its parent was scrolled) the dirty areas are still valid
+     *as they are relative to the object*/
+    session->area = area;
+
+    if(session->dirty_cnt == 0) return &session->img;
+
+    lv_area_t dirty[DIRTY_AREA_MAX];
+    uint32_t dirty_cnt = session->dirty_cnt;
+    lv_memcpy(dirty, session->dirty, sizeof(lv_area_t) * dirty_cnt);
+    session->dirty_cnt = 0;
+
+    lv_draw_ctx_t * draw_ctx = session->driver.draw_ctx;
+    draw_ctx->buf = (void *)session->img.data;
+    draw_ctx->buf_area = &session->area;
+
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&session->disp);
+
+    uint32_t i;
+    for(i = 0; i < dirty_cnt; i++) {
+        lv_area_t clip_area;
+        if(!_lv_area_intersect(&clip_area, &dirty[i], &full_area)) continue;
+        lv_area_move(&clip_area, area.x1, area.y1);
+
+        clear_area(session, &clip_area);
+        draw_ctx->clip_area = &clip_area;
+        lv_obj_redraw(draw_ctx, session->obj);
+        add_changed_area(session, &clip_area);
+    }
+
+    lv_draw_wait_for_finish(draw_ctx);
+    if(draw_ctx->buffer_convert) draw_ctx->buffer_convert(draw_ctx);
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+
+    /*The image might be used by an image object too*/
+    lv_img_cache_invalidate_src(&session->img);
+
+    return &session->img;
+}
+
+bool lv_snapshot_session_get_changed_area(lv_snapshot_session_t * session, lv_area_t * area)
+{
+    LV_ASSERT_NULL(session);
+    LV_ASSERT_NULL(area);
+
+    if(!session->has_changed) return false;
+
+    *area = session->changed;
+    return true;
+}
+
+void lv_snapshot_session_invalidate(lv_snapshot_session_t * session)
+{
+    LV_ASSERT_NULL(session);
+
+    lv_area_set(&session->dirty[0], 0, 0, lv_area_get_width(&session->area) - 1,
+                lv_area_get_height(&session->area) - 1);
+    session->dirty_cnt = 1;
+}
+
+lv_res_t lv_snapshot_session_encode(lv_snapshot_session_t * session, bool changed_only, lv_snapshot_encoded_cb_t cb,
+                                    void * user_data)
+{
+    LV_ASSERT_NULL(session);
+    LV_ASSERT_NULL(cb);
+
+    if(session->img.data == NULL) return LV_RES_INV;
+
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    lv_mutex_lock(&mutex);
+    bool busy = session->enc_state != ENCODE_IDLE;
+    lv_mutex_unlock(&mutex);
+    if(busy) return LV_RES_INV;
+#endif
+
+    lv_area_t area;
+    if(!changed_only) {
+        lv_area_set(&area, 0, 0, session->img.header.w - 1, session->img.header.h - 1);
+    }
+    else if(session->has_unsent) {
+        area = session->unsent;
+    }
+    else {
+        return LV_RES_INV;
+    }
+
+    uint32_t px_size = get_px_size(session->img.header.cf);
+    uint32_t px_cnt = lv_area_get_size(&area);
+    if(!reserve_buf(&session->enc_src, &session->enc_src_size, px_cnt * px_size)) return LV_RES_INV;
+    /*In the worst case every pixel has a control byte*/
+    if(!reserve_buf(&session->enc_buf, &session->enc_buf_size,
+                    LV_SNAPSHOT_ENCODED_HEADER_SIZE + px_cnt * (px_size + 1))) return LV_RES_INV;
+
+    /*Copy the pixels as the image can be updated while they are encoded*/
+    uint32_t img_row_size = session->img.header.w * px_size;
+    uint32_t row_size = lv_area_get_width(&area) * px_size;
+    const uint8_t * src = session->img.data + area.y1 * img_row_size + area.x1 * px_size;
+    uint8_t * dst = session->enc_src;
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        lv_memcpy(dst, src, row_size);
+        dst += row_size;
+        src += img_row_size;
+    }
+
+    uint8_t * header = session->enc_buf;
+    lv_memcpy(header, magic, sizeof(magic));
+    header[4] = session->img.header.cf;
+    header[5] = px_size;
+    put_u16(&header[6], session->img.header.w);
+    put_u16(&header[8], session->img.header.h);
+    put_u16(&header[10], area.x1);
+    put_u16(&header[12], area.y1);
+    put_u16(&header[14], lv_area_get_width(&area));
+    put_u16(&header[16], lv_area_get_height(&area));
+
+    session->enc_px_cnt = px_cnt;
+    session->enc_px_size = px_size;
+    session->encoded_cb = cb;
+    session->encoded_user_data = user_data;
+    session->has_unsent = 0;
+
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    if(check_timer == NULL) {
+        check_timer = lv_timer_create(check_timer_cb, CHECK_PERIOD, NULL);
+        LV_ASSERT_MALLOC(check_timer);
+    }
+
+    if(check_timer && (encoder_started || start_encoder())) {
+        lv_mutex_lock(&mutex);
+        session->enc_state = ENCODE_QUEUED;
+        lv_mutex_unlock(&mutex);
+        lv_thread_sync_signal(&encoder_sync);
+        lv_timer_resume(check_timer);
+        return LV_RES_OK;
+    }
+#endif
+
+    encode_session(session);
+    cb(session, session->enc_buf, session->enc_size, user_data);
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_snapshot_decode(const void * data, uint32_t size, lv_img_dsc_t * img)
+{
+    LV_ASSERT_NULL(data);
+    LV_ASSERT_NULL(img);
+
+    const uint8_t * p = data;
+    if(size < LV_SNAPSHOT_ENCODED_HEADER_SIZE) return LV_RES_INV;
+    if(p[0] != magic[0] || p[1] != magic[1] || p[2] != magic[2] || p[3] != magic[3]) return LV_RES_INV;
+
+    uint32_t px_size = p[5];
+    if(p[4] != img->header.cf || px_size == 0 || px_size != get_px_size(img->header.cf)) return LV_RES_INV;
+
+    uint32_t img_w = get_u16(&p[6]);
+    uint32_t img_h = get_u16(&p[8]);
+    uint32_t x = get_u16(&p[10]);
+    uint32_t y = get_u16(&p[12]);
+    uint32_t w = get_u16(&p[14]);
+    uint32_t h = get_u16(&p[16]);
+    if(img_w != img->header.w || img_h != img->header.h) return LV_RES_INV;
+    if(w == 0 || h == 0 || x + w > img_w || y + h > img_h) return LV_RES_INV;
+
+    const uint8_t * end = p + size;
+    p += LV_SNAPSHOT_ENCODED_HEADER_SIZE;
+
+    uint8_t * row = (uint8_t *)img->data + (y * img_w + x) * px_size;
+    uint32_t row_px_left = w;
+    uint32_t px_left = w * h;
+    while(px_left) {
+        if(p >= end) return LV_RES_INV;
+
+        /*< 128: literal pixels; >= 128: the next pixel is repeated*/
+        uint32_t ctrl = *p++;
+        bool repeat = ctrl >= 128;
+        uint32_t cnt = repeat ? ctrl - 126 : ctrl + 1;
+        uint32_t data_size = repeat ? px_size : cnt * px_size;
+        if(cnt > px_left || (uint32_t)(end - p) < data_size) return LV_RES_INV;
+        px_left -= cnt;
+
+        while(cnt) {
+            uint32_t n = LV_MIN(cnt, row_px_left);
+            uint8_t * dst = row + (w - row_px_left) * px_size;
+            if(repeat) {
+                uint32_t i;
+                for(i = 0; i < n; i++) {
+                    lv_memcpy(dst, p, px_size);
+                    dst += px_size;
+                }
+            }
+            else {
+                lv_memcpy(dst, p, n * px_size);
+                p += n * px_size;
+            }
+
+            cnt -= n;
+            row_px_left -= n;
+            if(row_px_left == 0) {
+                row += img_w * px_size;
+                row_px_left = w;
+            }
+        }
+        if(repeat) p += px_size;
+    }
+
+    return p == end ? LV_RES_OK : LV_RES_INV;
+}
+
+void _lv_snapshot_session_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
+{
+    if(_lv_ll_is_empty(&SESSION_LL)) return;
+
+    /*Changing an object changes the snapshots of all its parents*/
+    while(obj) {
+        lv_snapshot_session_t * session;
+        _LV_LL_READ(&SESSION_LL, session) {
+            if(session->obj == obj) add_dirty_area(session, area);
+        }
+        obj = lv_obj_get_parent(obj);
+    }
+}
+
+void _lv_snapshot_session_invalidate_screen_area(const lv_area_t * area)
+{
+    lv_snapshot_session_t * session;
+    _LV_LL_READ(&SESSION_LL, session) {
+        if(session->obj) add_dirty_area(session, area);
+    }
+}
+
+void _lv_snapshot_session_obj_deleted(const lv_obj_t * obj)
+{
+    lv_snapshot_session_t * session;
+    _LV_LL_READ(&SESSION_LL, session) {
+        if(session->obj == obj) session->obj = NULL;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/*Size of a pixel in the snapshot image. 0 if the color format is not supported.*/
+static uint32_t get_px_size(lv_img_cf_t cf)
+{
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+            return sizeof(lv_color_t);
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            return LV_IMG_PX_SIZE_ALPHA_BYTE;
+        case LV_IMG_CF_ALPHA_8BIT:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*Size of a pixel while rendering. LV_IMG_CF_ALPHA_8BIT is rendered as colors and converted after that.*/
+static uint32_t get_render_px_size(lv_img_cf_t cf)
+{
+    return cf == LV_IMG_CF_ALPHA_8BIT ? sizeof(lv_color_t) : get_px_size(cf);
+}
+
+static void free_session(lv_snapshot_session_t * session)
+{
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    lv_mutex_lock(&mutex);
+#endif
+    _lv_ll_remove(&SESSION_LL, session);
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+    lv_mutex_unlock(&mutex);
+#endif
+
+    free_unlinked_session(session);
+}
+
+/*Free a session which is already removed from the list, so the encoder thread can't see it*/
+static void free_unlinked_session(lv_snapshot_session_t * session)
+{
+    lv_draw_ctx_t * draw_ctx = session->driver.draw_ctx;
+    session->driver.draw_ctx_deinit(&session->driver, draw_ctx);
+    lv_free(draw_ctx);
+
+    if(session->img.data) {
+        lv_img_cache_invalidate_src(&session->img);
+        lv_free((void *)session->img.data);
+    }
+    lv_free(session->enc_src);
+    lv_free(session->enc_buf);
+    lv_free(session);
+}
+
+/*The area of the object with its extra draw size in absolute coordinates*/
+static void get_snapshot_area(lv_obj_t * obj, lv_area_t * area)
+{
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, area);
+    lv_area_increase(area, ext_size, ext_size);
+}
+
+static void add_dirty_area(lv_snapshot_session_t * session, const lv_area_t * area)
+{
+    /*The first take renders everything anyway*/
+    if(session->img.data == NULL) return;
+
+    /*Save the area relative to the object's current position as it can be moved before the next take*/
+    lv_area_t obj_area;
+    get_snapshot_area(session->obj, &obj_area);
+    lv_area_t a;
+    if(!_lv_area_intersect(&a, area, &obj_area)) return;
+    lv_area_move(&a, -obj_area.x1, -obj_area.y1);
+
+    uint32_t i;
+    for(i = 0; i < session->dirty_cnt; i++) {
+        if(_lv_area_is_in(&a, &session->dirty[i], 0)) return;
+
+        /*Join the overlapping areas if the joined area is smaller (e.g. the old and new area of a label)*/
+        if(_lv_area_is_on(&a, &session->dirty[i])) {
+            lv_area_t joined;
+            _lv_area_join(&joined, &a, &session->dirty[i]);
+            if(lv_area_get_size(&joined) < lv_area_get_size(&a) + lv_area_get_size(&session->dirty[i])) {
+                session->dirty[i] = joined;
+                return;
+            }
+        }
+    }
+
+    if(session->dirty_cnt < DIRTY_AREA_MAX) {
+        session->dirty[session->dirty_cnt] = a;
+        session->dirty_cnt++;
+        return;
+    }
+
+    /*No more space: keep only the bounding box*/
+    for(i = 1; i < session->dirty_cnt; i++) _lv_area_join(&session->dirty[0], &session->dirty[0], &session->dirty[i]);
+    _lv_area_join(&session->dirty[0], &session->dirty[0], &a);
+    session->dirty_cnt = 1;
+}
+
+/**
+ * Save a rendered area into the changed and unsent areas
+ * @param session   the session
+ * @param area      the rendered area in absolute coordinates
+ */
+static void add_changed_area(lv_snapshot_session_t * session, const lv_area_t * area)
+{
+    lv_area_t a = *area;
+    lv_area_move(&a, -session->area.x1, -session->area.y1);
+
+    if(session->has_changed) _lv_area_join(&session->changed, &session->changed, &a);
+    else session->changed = a;
+
+    if(session->has_unsent) _lv_area_join(&session->unsent, &session->unsent, &a);
+    else session->unsent = a;
+
+    session->has_changed = 1;
+    session->has_unsent = 1;
+}
+
+/*Clear an area of the image to transparent black before rendering it again*/
+static void clear_area(lv_snapshot_session_t * session, const lv_area_t * area)
+{
+    uint32_t px_size = get_render_px_size(session->img.header.cf);
+    uint32_t img_row_size = session->img.header.w * px_size;
+    uint32_t row_size = lv_area_get_width(area) * px_size;
+    uint8_t * row = (uint8_t *)session->img.data + (area->y1 - session->area.y1) * img_row_size +
+                    (area->x1 - session->area.x1) * px_size;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memzero(row, row_size);
+        row += img_row_size;
+    }
+}
+
+static bool reserve_buf(uint8_t ** buf, uint32_t * buf_size, uint32_t size)
+{
+    if(*buf_size >= size) return true;
+
+    uint8_t * new_buf = lv_realloc(*buf, size);
+    LV_ASSERT_MALLOC(new_buf);
+    if(new_buf == NULL) return false;
+
+    *buf = new_buf;
+    *buf_size = size;
+    return true;
+}
+
+/*Encode the copied pixels after the header. Called by the encoder thread with LV_SNAPSHOT_ENCODE_ASYNC.*/
+static void encode_session(lv_snapshot_session_t * session)
+{
+    session->enc_size = LV_SNAPSHOT_ENCODED_HEADER_SIZE;
+    session->enc_size += rle_encode(session->enc_buf + LV_SNAPSHOT_ENCODED_HEADER_SIZE, session->enc_src,
+                                    session->enc_px_cnt, session->enc_px_size);
+}
+
+static inline bool px_is_equal(const uint8_t * a, const uint8_t * b, uint32_t px_size)
+{
+    switch(px_size) {
+        case 4:
+            return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+        case 3:
+            return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+        case 2:
+            return a[0] == b[0] && a[1] == b[1];
+        default:
+            return a[0] == b[0];
+    }
+}
+
+/**
+ * Run-length encode pixels. A control byte < 128 is followed by `control + 1` literal pixels,
+ * a control byte >= 128 is followed by a pixel which is repeated `control - 126` times.
+ * @param dst       store the encoded data here. Needs `px_cnt * (px_size + 1)` bytes in the worst case.
+ * @param src       the pixels
+ * @param px_cnt    number of pixels
+ * @param px_size   size of a pixel in bytes
+ * @return          size of the encoded data
+ */
+static uint32_t rle_encode(uint8_t * dst, const uint8_t * src, uint32_t px_cnt, uint32_t px_size)
+{
+    uint8_t * d = dst;
+    uint32_t i = 0;
+    while(i < px_cnt) {
+        const uint8_t * px = src + i * px_size;
+        uint32_t run = 1;
+        while(run < 129 && i + run < px_cnt && px_is_equal(px, px + run * px_size, px_size)) run++;
+
+        if(run >= 2) {
+            *d++ = (uint8_t)(run + 126);
+            lv_memcpy(d, px, px_size);
+            d += px_size;
+            i += run;
+            continue;
+        }
+
+        /*Collect the literals until a run starts*/
+        uint32_t lit = 1;
+        while(lit < 128 && i + lit < px_cnt) {
+            const uint8_t * next = px + lit * px_size;
+            if(i + lit + 1 < px_cnt && px_is_equal(next, next + px_size, px_size)) break;
+            lit++;
+        }
+
+        *d++ = (uint8_t)(lit - 1);
+        lv_memcpy(d, px, lit * px_size);
+        d += lit * px_size;
+        i += lit;
+    }
+
+    return d - dst;
+}
+
+static void put_u16(uint8_t * p, uint32_t v)
+{
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+}
+
+static uint32_t get_u16(const uint8_t * p)
+{
+    return p[0] | ((uint32_t)p[1] << 8);
+}
+
+#if LV_SNAPSHOT_USE_ENCODE_ASYNC
+
+static bool start_encoder(void)
+{
+    lv_thread_sync_init(&encoder_sync);
+    if(lv_thread_init(&encoder_thread, LV_THREAD_PRIO_LOW, encoder_thread_cb, 0, NULL) != LV_RES_OK) {
+        LV_LOG_WARN("couldn't create the encoder thread");
+        lv_thread_sync_delete(&encoder_sync);
+        return false;
+    }
+
+    encoder_started = true;
+    return true;
+}
+
+static void encoder_thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    while(1) {
+        lv_mutex_lock(&mutex);
+        if(encoder_exit) {
+            lv_mutex_unlock(&mutex);
+            break;
+        }
+
+        lv_snapshot_session_t * session;
+        _LV_LL_READ(&SESSION_LL, session) {
+            if(session->enc_state == ENCODE_QUEUED) break;
+        }
+        if(session) session->enc_state = ENCODE_RUNNING;
+        lv_mutex_unlock(&mutex);
+
+        if(session == NULL) {
+            lv_thread_sync_wait(&encoder_sync);
+            continue;
+        }
+
+        /*Only the encoder uses the buffers of a session while it's running*/
+        encode_session(session);
+
+        lv_mutex_lock(&mutex);
+        session->enc_state = ENCODE_READY;
+        lv_mutex_unlock(&mutex);
+    }
+}
+
+/*Pass the finished encodings to the callbacks in the LVGL thread*/
+static void check_timer_cb(lv_timer_t * t)
+{
+    while(1) {
+        lv_snapshot_session_t * ready = NULL;
+        bool pending = false;
+
+        lv_mutex_lock(&mutex);
+        lv_snapshot_session_t * session;
+        _LV_LL_READ(&SESSION_LL, session) {
+            if(session->enc_state == ENCODE_READY) {
+                ready = session;
+                break;
+            }
+            if(session->enc_state != ENCODE_IDLE) pending = true;
+        }
+        lv_mutex_unlock(&mutex);
+
+        if(ready == NULL) {
+            if(!pending) lv_timer_pause(t);
+            return;
+        }
+
+        /*The callback can't encode the same session again as it's still ready*/
+        if(!ready->deleted) ready->encoded_cb(ready, ready->enc_buf, ready->enc_size, ready->encoded_user_data);
+
+        lv_mutex_lock(&mutex);
+        ready->enc_state = ENCODE_IDLE;
+        lv_mutex_unlock(&mutex);
+
+        if(ready->deleted) free_session(ready);
+    }
+}
+
+#endif /*LV_SNAPSHOT_USE_ENCODE_ASYNC*/
+
 #endif /*LV_USE_SNAPSHOT*/
@@ -23,10 +23,25 @@ extern "C" {
  *********************/
 
 #if LV_USE_SNAPSHOT
+
+#define LV_SNAPSHOT_USE_ENCODE_ASYNC (LV_SNAPSHOT_ENCODE_ASYNC && LV_USE_OS != LV_OS_NONE)
+
+/*Size of the header of the encoded snapshots*/
+#define LV_SNAPSHOT_ENCODED_HEADER_SIZE 18
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+struct _lv_snapshot_session_t;
+typedef struct _lv_snapshot_session_t lv_snapshot_session_t;
+
+/**
+ * Called with the encoded snapshot. `data` is valid only in the callback.
+ */
+typedef void (*lv_snapshot_encoded_cb_t)(lv_snapshot_session_t * session, const uint8_t * data, uint32_t size,
+                                         void * user_data);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -70,6 +85,104 @@ uint32_t lv_snapshot_buf_size_needed(lv_obj_t * obj, lv_img_cf_t cf);
  */
 lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t * dsc, void * buf, uint32_t buff_size);
 
+/** Create a snapshot session to take snapshots of an object repeatedly.
+ * The session keeps its image and renders only the parts which were invalidated since the last snapshot.
+ *
+ * @param obj    The object to generate snapshots.
+ * @param cf     color format for generated images.
+ *
+ * @return the new session, or NULL if failed.
+ */
+lv_snapshot_session_t * lv_snapshot_session_create(lv_obj_t * obj, lv_img_cf_t cf);
+
+/** Delete a snapshot session and free its image.
+ *
+ * @param session    The session to delete. Its encoding callback won't be called anymore.
+ */
+void lv_snapshot_session_del(lv_snapshot_session_t * session);
+
+/** Update the snapshot of the session's object.
+ *
+ * Only the invalidated parts are rendered again, except with LV_IMG_CF_ALPHA_8BIT which is always rendered entirely.
+ *
+ * @param session    The session.
+ *
+ * @return the image of the session (valid until the next take), or NULL if the object was deleted or out of memory.
+ */
+const lv_img_dsc_t * lv_snapshot_session_take(lv_snapshot_session_t * session);
+
+/** Get the area rendered by the last take.
+ *
+ * @param session    The session.
+ * @param area       store the area relative to the image here.
+ *
+ * @return true: something was rendered; false: the image hasn't changed.
+ */
+bool lv_snapshot_session_get_changed_area(lv_snapshot_session_t * session, lv_area_t * area);
+
+/** Render the whole object again on the next take.
+ *
+ * @param session    The session.
+ */
+void lv_snapshot_session_invalidate(lv_snapshot_session_t * session);
+
+/** Encode the image of the last take to a compact, run-length encoded format.
+ *
+ * With `LV_SNAPSHOT_ENCODE_ASYNC` the pixels are copied and encoded on a worker thread, and `cb` is called later
+ * by `lv_timer_handler()`. Else `cb` is called before returning.
+ *
+ * @param session      The session.
+ * @param changed_only true: encode only the area changed since the previous encoding; false: encode the whole image.
+ * @param cb           called with the encoded data.
+ * @param user_data    passed to `cb`.
+ *
+ * @return LV_RES_OK: `cb` will be called; LV_RES_INV: nothing has changed, the previous encoding hasn't finished
+ *         yet or out of memory.
+ */
+lv_res_t lv_snapshot_session_encode(lv_snapshot_session_t * session, bool changed_only, lv_snapshot_encoded_cb_t cb,
+                                    void * user_data);
+
+/** Decode an encoded snapshot into an image.
+ *
+ * Only the encoded area is written, so applying the encodings of a session in order keeps a copy of its image.
+ *
+ * @param data   The encoded data.
+ * @param size   Size of the encoded data in bytes.
+ * @param img    image with the same size and color format as the encoded snapshot.
+ *
+ * @return LV_RES_OK on success, LV_RES_INV if the data is invalid or doesn't match the image.
+ */
+lv_res_t lv_snapshot_decode(const void * data, uint32_t size, lv_img_dsc_t * img);
+
+/**
+ * Initialize the snapshot sessions. Called by `lv_init`.
+ */
+void _lv_snapshot_session_init(void);
+
+/**
+ * Delete the snapshot sessions and stop the encoder thread. Called by `lv_deinit`.
+ */
+void _lv_snapshot_session_deinit(void);
+
+/**
+ * Mark an area of an object and its parents outdated in the snapshot sessions watching them
+ * @param obj       the invalidated object
+ * @param area      the invalidated area in absolute coordinates
+ */
+void _lv_snapshot_session_invalidate_area(const lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Mark an area of the screen outdated in all snapshot sessions
+ * @param area      the invalidated area in absolute coordinates
+ */
+void _lv_snapshot_session_invalidate_screen_area(const lv_area_t * area);
+
+/**
+ * Detach the sessions from a deleted object
+ * @param obj       the deleted object
+ */
+void _lv_snapshot_session_obj_deleted(const lv_obj_t * obj);
+
 
 /**********************
  *      MACROS
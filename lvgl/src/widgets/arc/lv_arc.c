@@ -44,6 +44,7 @@ static void value_update(lv_obj_t * arc);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_arc_class  = {
+    .name = "arc",
     .constructor_cb = lv_arc_constructor,
     .event_cb = lv_arc_event,
     .instance_size = sizeof(lv_arc_t),
@@ -58,6 +58,7 @@ static void lv_bar_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_bar_class = {
+    .name = "bar",
     .constructor_cb = lv_bar_constructor,
     .destructor_cb = lv_bar_destructor,
     .event_cb = lv_bar_event,
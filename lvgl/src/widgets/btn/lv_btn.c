@@ -28,6 +28,7 @@ static void lv_btn_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_btn_class  = {
+    .name = "btn",
     .constructor_cb = lv_btn_constructor,
     .width_def = LV_SIZE_CONTENT,
     .height_def = LV_SIZE_CONTENT,
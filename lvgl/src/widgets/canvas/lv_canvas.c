@@ -20,9 +20,48 @@
  *********************/
 #define MY_CLASS &lv_canvas_class
 
+/*Number of opaque rectangles remembered to skip the batched primitives below them*/
+#define BATCH_COVER_MAX 16
+
 /**********************
  *      TYPEDEFS
  **********************/
+typedef enum {
+    CANVAS_CMD_RECT,
+    CANVAS_CMD_TEXT,
+    CANVAS_CMD_IMG,
+    CANVAS_CMD_LINE,
+    CANVAS_CMD_POLYGON,
+    CANVAS_CMD_ARC,
+} canvas_cmd_type_t;
+
+/*A primitive to draw on the canvas*/
+typedef struct {
+    union {
+        lv_draw_rect_dsc_t rect;        /*Rectangle and polygon*/
+        lv_draw_label_dsc_t label;
+        lv_draw_img_dsc_t img;
+        lv_draw_line_dsc_t line;
+        lv_draw_arc_dsc_t arc;
+    } dsc;
+    lv_area_t coords;                   /*Coordinates of a rectangle, text or image*/
+    lv_area_t area;                     /*The area of the canvas affected by the primitive*/
+    const void * data;                  /*Text, image source or points*/
+    uint32_t data_size;                 /*Size of `data` to copy when the primitive is queued. 0: not copied*/
+    uint32_t point_cnt;
+    lv_point_t center;                  /*Center of an arc*/
+    lv_coord_t radius;
+    int32_t start_angle;
+    int32_t end_angle;
+    uint8_t type : 3;                   /*A `canvas_cmd_type_t` value*/
+    uint8_t hidden : 1;                 /*Covered by a later opaque rectangle*/
+} canvas_cmd_t;
+
+struct _lv_canvas_batch_t {
+    canvas_cmd_t * cmds;
+    uint32_t cnt;
+    uint32_t size;
+};
 
 /**********************
  *  STATIC PROTOTYPES
@@ -31,11 +70,24 @@ static void lv_canvas_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
 static void lv_canvas_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void init_fake_disp(lv_obj_t * canvas, lv_disp_t * disp, lv_disp_drv_t * drv, lv_area_t * clip_area);
 static void deinit_fake_disp(lv_obj_t * canvas, lv_disp_t * disp);
+static bool can_draw(lv_obj_t * canvas, const char * func);
+static void add_cmd(lv_obj_t * canvas, canvas_cmd_t * cmd);
+static void draw_cmds(lv_obj_t * canvas, canvas_cmd_t * cmds, uint32_t cnt);
+static void draw_cmd(lv_draw_ctx_t * draw_ctx, const canvas_cmd_t * cmd);
+static void cull_covered_cmds(canvas_cmd_t * cmds, uint32_t cnt);
+static bool areas_joinable(const lv_area_t * a1, const lv_area_t * a2);
+static void flush_batch(lv_obj_t * canvas);
+static void clear_batch(lv_obj_t * canvas);
+static void free_batch(lv_obj_t * canvas);
+static lv_coord_t rect_ext_size(const lv_draw_rect_dsc_t * draw_dsc);
+static void get_points_area(const lv_point_t points[], uint32_t point_cnt, lv_area_t * area);
+static void invalidate_canvas_area(lv_obj_t * canvas, const lv_area_t * area);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_canvas_class = {
+    .name = "canvas",
     .constructor_cb = lv_canvas_constructor,
     .destructor_cb = lv_canvas_destructor,
     .instance_size = sizeof(lv_canvas_t),
@@ -69,6 +121,8 @@ void lv_canvas_set_buffer(lv_obj_t * obj, void * buf, lv_coord_t w, lv_coord_t h
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
+    flush_batch(obj);
+
     canvas->dsc.header.cf = cf;
     canvas->dsc.header.w  = w;
     canvas->dsc.header.h  = h;
@@ -84,6 +138,7 @@ void lv_canvas_set_px_color(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_color
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
+    flush_batch(obj);
     lv_img_buf_set_px_color(&canvas->dsc, x, y, c);
     lv_obj_invalidate(obj);
 }
@@ -94,6 +149,7 @@ void lv_canvas_set_px_opa(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_opa_t o
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
+    flush_batch(obj);
     lv_img_buf_set_px_alpha(&canvas->dsc, x, y, opa);
     lv_obj_invalidate(obj);
 }
@@ -119,6 +175,8 @@ lv_color_t lv_canvas_get_px(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
     lv_color_t color = lv_obj_get_style_img_recolor(obj, LV_PART_MAIN);
 
+    flush_batch(obj);
+
     return lv_img_buf_get_px_color(&canvas->dsc, x, y, color);
 }
 
@@ -146,6 +204,8 @@ void lv_canvas_copy_buf(lv_obj_t * obj, const void * to_copy, lv_coord_t x, lv_c
         return;
     }
 
+    flush_batch(obj);
+
     uint32_t px_size   = lv_img_cf_get_px_size(canvas->dsc.header.cf) >> 3;
     uint32_t px        = canvas->dsc.header.w * y * px_size + x * px_size;
     uint8_t * to_copy8 = (uint8_t *)to_copy;
@@ -168,6 +228,8 @@ void lv_canvas_transform(lv_obj_t * obj, lv_img_dsc_t * src_img, int16_t angle,
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
     lv_img_dsc_t * dest_img = &canvas->dsc;
 
+    flush_batch(obj);
+
     int32_t x;
     int32_t y;
 
@@ -233,106 +295,10 @@ void lv_canvas_blur_hor(lv_obj_t * obj, const lv_area_t * area, uint16_t r)
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
-    lv_area_t a;
-    if(area) {
-        lv_area_copy(&a, area);
-        if(a.x1 < 0) a.x1 = 0;
-        if(a.y1 < 0) a.y1 = 0;
-        if(a.x2 > canvas->dsc.header.w - 1) a.x2 = canvas->dsc.header.w - 1;
-        if(a.y2 > canvas->dsc.header.h - 1) a.y2 = canvas->dsc.header.h - 1;
-    }
-    else {
-        a.x1 = 0;
-        a.y1 = 0;
-        a.x2 = canvas->dsc.header.w - 1;
-        a.y2 = canvas->dsc.header.h - 1;
-    }
-
-    lv_color_t color = lv_obj_get_style_img_recolor(obj, LV_PART_MAIN);
-
-    uint16_t r_back = r / 2;
-    uint16_t r_front = r / 2;
-
-    if((r & 0x1) == 0) r_back--;
-
-    bool has_alpha = lv_img_cf_has_alpha(canvas->dsc.header.cf);
-
-    lv_coord_t line_w = lv_img_buf_get_img_size(canvas->dsc.header.w, 1, canvas->dsc.header.cf);
-    uint8_t * line_buf = lv_malloc(line_w);
-
-    lv_img_dsc_t line_img;
-    line_img.data = line_buf;
-    line_img.header.always_zero = 0;
-    line_img.header.w = canvas->dsc.header.w;
-    line_img.header.h = 1;
-    line_img.header.cf = canvas->dsc.header.cf;
-
-    lv_coord_t x;
-    lv_coord_t y;
-    lv_coord_t x_safe;
-
-    for(y = a.y1; y <= a.y2; y++) {
-        uint32_t asum = 0;
-        uint32_t rsum = 0;
-        uint32_t gsum = 0;
-        uint32_t bsum = 0;
-
-        lv_color_t c;
-        lv_opa_t opa = LV_OPA_TRANSP;
-        lv_memcpy(line_buf, &canvas->dsc.data[y * line_w], line_w);
-
-        for(x = a.x1 - r_back; x <= a.x1 + r_front; x++) {
-            x_safe = x < 0 ? 0 : x;
-            x_safe = x_safe > canvas->dsc.header.w - 1 ? canvas->dsc.header.w - 1 : x_safe;
-
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
+    flush_batch(obj);
 
-            rsum += c.ch.red;
-            gsum += c.ch.green;
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-
-        /*Just to indicate that the px is visible*/
-        if(has_alpha == false) asum = LV_OPA_COVER;
-
-        for(x = a.x1; x <= a.x2; x++) {
-
-            if(asum) {
-                c.ch.red = rsum / r;
-                c.ch.green = gsum / r;
-                c.ch.blue = bsum / r;
-                if(has_alpha) opa = asum / r;
-
-                lv_img_buf_set_px_color(&canvas->dsc, x, y, c);
-            }
-            if(has_alpha) lv_img_buf_set_px_alpha(&canvas->dsc, x, y, opa);
-
-            x_safe = x - r_back;
-            x_safe = x_safe < 0 ? 0 : x_safe;
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum -= c.ch.red;
-            gsum -= c.ch.green;
-            bsum -= c.ch.blue;
-            if(has_alpha) asum -= opa;
-
-            x_safe = x + 1 + r_front;
-            x_safe = x_safe > canvas->dsc.header.w - 1 ? canvas->dsc.header.w - 1 : x_safe;
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, lv_color_white());
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum += c.ch.red;
-            gsum += c.ch.green;
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-    }
+    lv_draw_sw_filter_box_blur(&canvas->dsc, area, r, 0);
     lv_obj_invalidate(obj);
-
-    lv_free(line_buf);
 }
 
 void lv_canvas_blur_ver(lv_obj_t * obj, const lv_area_t * area, uint16_t r)
@@ -343,111 +309,24 @@ void lv_canvas_blur_ver(lv_obj_t * obj, const lv_area_t * area, uint16_t r)
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
-    lv_area_t a;
-    if(area) {
-        lv_area_copy(&a, area);
-        if(a.x1 < 0) a.x1 = 0;
-        if(a.y1 < 0) a.y1 = 0;
-        if(a.x2 > canvas->dsc.header.w - 1) a.x2 = canvas->dsc.header.w - 1;
-        if(a.y2 > canvas->dsc.header.h - 1) a.y2 = canvas->dsc.header.h - 1;
-    }
-    else {
-        a.x1 = 0;
-        a.y1 = 0;
-        a.x2 = canvas->dsc.header.w - 1;
-        a.y2 = canvas->dsc.header.h - 1;
-    }
-
-    lv_color_t color = lv_obj_get_style_img_recolor(obj, LV_PART_MAIN);
-
-    uint16_t r_back = r / 2;
-    uint16_t r_front = r / 2;
-
-    if((r & 0x1) == 0) r_back--;
-
-    bool has_alpha = lv_img_cf_has_alpha(canvas->dsc.header.cf);
-    lv_coord_t col_w = lv_img_buf_get_img_size(1, canvas->dsc.header.h, canvas->dsc.header.cf);
-    uint8_t * col_buf = lv_malloc(col_w);
-    lv_img_dsc_t line_img;
-
-    line_img.data = col_buf;
-    line_img.header.always_zero = 0;
-    line_img.header.w = 1;
-    line_img.header.h = canvas->dsc.header.h;
-    line_img.header.cf = canvas->dsc.header.cf;
-
-    lv_coord_t x;
-    lv_coord_t y;
-    lv_coord_t y_safe;
-
-    for(x = a.x1; x <= a.x2; x++) {
-        uint32_t asum = 0;
-        uint32_t rsum = 0;
-        uint32_t gsum = 0;
-        uint32_t bsum = 0;
+    flush_batch(obj);
 
-        lv_color_t c;
-        lv_opa_t opa = LV_OPA_COVER;
-
-        for(y = a.y1 - r_back; y <= a.y1 + r_front; y++) {
-            y_safe = y < 0 ? 0 : y;
-            y_safe = y_safe > canvas->dsc.header.h - 1 ? canvas->dsc.header.h - 1 : y_safe;
-
-            c = lv_img_buf_get_px_color(&canvas->dsc, x, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&canvas->dsc, x, y_safe);
-
-            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
-            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
-
-            rsum += c.ch.red;
-            gsum += c.ch.green;
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-
-        /*Just to indicate that the px is visible*/
-        if(has_alpha == false) asum = LV_OPA_COVER;
-
-        for(y = a.y1; y <= a.y2; y++) {
-            if(asum) {
-                c.ch.red = rsum / r;
-                c.ch.green = gsum / r;
-                c.ch.blue = bsum / r;
-                if(has_alpha) opa = asum / r;
-
-                lv_img_buf_set_px_color(&canvas->dsc, x, y, c);
-            }
-            if(has_alpha) lv_img_buf_set_px_alpha(&canvas->dsc, x, y, opa);
-
-            y_safe = y - r_back;
-            y_safe = y_safe < 0 ? 0 : y_safe;
-            c = lv_img_buf_get_px_color(&line_img, 0, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, 0, y_safe);
-
-            rsum -= c.ch.red;
-            gsum -= c.ch.green;
-            bsum -= c.ch.blue;
-            if(has_alpha) asum -= opa;
+    lv_draw_sw_filter_box_blur(&canvas->dsc, area, 0, r);
+    lv_obj_invalidate(obj);
+}
 
-            y_safe = y + 1 + r_front;
-            y_safe = y_safe > canvas->dsc.header.h - 1 ? canvas->dsc.header.h - 1 : y_safe;
+void lv_canvas_blur(lv_obj_t * obj, const lv_area_t * area, uint16_t radius)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
 
-            c = lv_img_buf_get_px_color(&canvas->dsc, x, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&canvas->dsc, x, y_safe);
+    if(radius == 0) return;
 
-            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
-            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
-            rsum += c.ch.red;
-            gsum += c.ch.green;
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-    }
+    flush_batch(obj);
 
+    lv_draw_sw_filter_gauss_blur(&canvas->dsc, area, radius);
     lv_obj_invalidate(obj);
-
-    lv_free(col_buf);
 }
 
 void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
@@ -456,6 +335,9 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
 
     lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
 
+    /*The queued primitives would be overwritten anyway*/
+    clear_batch(canvas);
+
     if(dsc->header.cf == LV_IMG_CF_INDEXED_1BIT) {
         uint32_t row_byte_cnt = (dsc->header.w + 7) >> 3;
         /*+8 skip the palette*/
@@ -484,43 +366,22 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
 {
     LV_ASSERT_OBJ(canvas, MY_CLASS);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    if(!can_draw(canvas, "lv_canvas_draw_rect")) return;
 
-    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
-        LV_LOG_WARN("lv_canvas_draw_rect: can't draw to LV_IMG_CF_INDEXED canvas");
-        return;
-    }
+    canvas_cmd_t cmd;
+    lv_memzero(&cmd, sizeof(cmd));
+    cmd.type = CANVAS_CMD_RECT;
+    cmd.dsc.rect = *draw_dsc;
+    cmd.coords.x1 = x;
+    cmd.coords.y1 = y;
+    cmd.coords.x2 = x + w - 1;
+    cmd.coords.y2 = y + h - 1;
 
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_coord_t ext = rect_ext_size(draw_dsc);
+    lv_area_copy(&cmd.area, &cmd.coords);
+    lv_area_increase(&cmd.area, ext, ext);
 
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = lv_disp_get_chroma_key_color(refr_ori);
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->bg_color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
-    }
-
-    lv_area_t coords;
-    coords.x1 = x;
-    coords.y1 = y;
-    coords.x2 = x + w - 1;
-    coords.y2 = y + h - 1;
-
-    lv_draw_rect(driver.draw_ctx, draw_dsc, &coords);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    deinit_fake_disp(canvas, &fake_disp);
-
-    lv_obj_invalidate(canvas);
+    add_cmd(canvas, &cmd);
 }
 
 void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
@@ -528,35 +389,26 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
 {
     LV_ASSERT_OBJ(canvas, MY_CLASS);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
-
-    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
-        LV_LOG_WARN("lv_canvas_draw_text: can't draw to LV_IMG_CF_INDEXED canvas");
-        return;
-    }
-
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
-
-    lv_area_t coords;
-    coords.x1 = x;
-    coords.y1 = y;
-    coords.x2 = x + max_w - 1;
-    coords.y2 = dsc->header.h - 1;
-    lv_draw_label(driver.draw_ctx, draw_dsc, &coords, txt, NULL);
+    if(!can_draw(canvas, "lv_canvas_draw_text")) return;
+    if(txt == NULL) return;
 
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    deinit_fake_disp(canvas, &fake_disp);
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
 
-    lv_obj_invalidate(canvas);
+    canvas_cmd_t cmd;
+    lv_memzero(&cmd, sizeof(cmd));
+    cmd.type = CANVAS_CMD_TEXT;
+    cmd.dsc.label = *draw_dsc;
+    cmd.coords.x1 = x;
+    cmd.coords.y1 = y;
+    cmd.coords.x2 = x + max_w - 1;
+    cmd.coords.y2 = dsc->header.h - 1;
+    cmd.data = txt;
+    cmd.data_size = strlen(txt) + 1;
+
+    /*The text is clipped to its coordinates*/
+    lv_area_copy(&cmd.area, &cmd.coords);
+
+    add_cmd(canvas, &cmd);
 }
 
 void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const void * src,
@@ -564,12 +416,7 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
 {
     LV_ASSERT_OBJ(canvas, MY_CLASS);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
-
-    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
-        LV_LOG_WARN("lv_canvas_draw_img: can't draw to LV_IMG_CF_INDEXED canvas");
-        return;
-    }
+    if(!can_draw(canvas, "lv_canvas_draw_img")) return;
 
     lv_img_header_t header;
     lv_res_t res = lv_img_decoder_get_info(src, &header);
@@ -577,29 +424,29 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
         LV_LOG_WARN("lv_canvas_draw_img: Couldn't get the image data.");
         return;
     }
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
-
-    lv_area_t coords;
-    coords.x1 = x;
-    coords.y1 = y;
-    coords.x2 = x + header.w - 1;
-    coords.y2 = y + header.h - 1;
-
-    lv_draw_img(driver.draw_ctx, draw_dsc, &coords, src);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    deinit_fake_disp(canvas, &fake_disp);
+    canvas_cmd_t cmd;
+    lv_memzero(&cmd, sizeof(cmd));
+    cmd.type = CANVAS_CMD_IMG;
+    cmd.dsc.img = *draw_dsc;
+    cmd.coords.x1 = x;
+    cmd.coords.y1 = y;
+    cmd.coords.x2 = x + header.w - 1;
+    cmd.coords.y2 = y + header.h - 1;
+    cmd.data = src;
+
+    /*Only the paths and symbols are copied, the image descriptors need to remain valid*/
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) cmd.data_size = strlen(src) + 1;
+
+    if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        _lv_img_buf_get_transformed_area(&cmd.area, header.w, header.h, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
+        lv_area_move(&cmd.area, x, y);
+    }
+    else {
+        lv_area_copy(&cmd.area, &cmd.coords);
+    }
 
-    lv_obj_invalidate(canvas);
+    add_cmd(canvas, &cmd);
 }
 
 void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
@@ -607,41 +454,22 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t
 {
     LV_ASSERT_OBJ(canvas, MY_CLASS);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
-
-    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
-        LV_LOG_WARN("lv_canvas_draw_line: can't draw to LV_IMG_CF_INDEXED canvas");
-        return;
-    }
-
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
-
-
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = lv_disp_get_chroma_key_color(refr_ori);
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
-    }
-
-    uint32_t i;
-    for(i = 0; i < point_cnt - 1; i++) {
-        lv_draw_line(driver.draw_ctx, draw_dsc, &points[i], &points[i + 1]);
-    }
+    if(!can_draw(canvas, "lv_canvas_draw_line")) return;
+    if(point_cnt < 2) return;
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    canvas_cmd_t cmd;
+    lv_memzero(&cmd, sizeof(cmd));
+    cmd.type = CANVAS_CMD_LINE;
+    cmd.dsc.line = *draw_dsc;
+    cmd.data = points;
+    cmd.data_size = point_cnt * sizeof(lv_point_t);
+    cmd.point_cnt = point_cnt;
 
-    deinit_fake_disp(canvas, &fake_disp);
+    /*The corners of the skew lines are out of the points' area*/
+    get_points_area(points, point_cnt, &cmd.area);
+    lv_area_increase(&cmd.area, draw_dsc->width, draw_dsc->width);
 
-    lv_obj_invalidate(canvas);
+    add_cmd(canvas, &cmd);
 }
 
 void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
@@ -649,37 +477,21 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
 {
     LV_ASSERT_OBJ(canvas, MY_CLASS);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    if(!can_draw(canvas, "lv_canvas_draw_polygon")) return;
+    if(point_cnt < 3) return;
 
-    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
-        LV_LOG_WARN("lv_canvas_draw_polygon: can't draw to LV_IMG_CF_INDEXED canvas");
-        return;
-    }
+    canvas_cmd_t cmd;
+    lv_memzero(&cmd, sizeof(cmd));
+    cmd.type = CANVAS_CMD_POLYGON;
+    cmd.dsc.rect = *draw_dsc;
+    cmd.data = points;
+    cmd.data_size = point_cnt * sizeof(lv_point_t);
+    cmd.point_cnt = point_cnt;
 
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
-
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = lv_disp_get_chroma_key_color(refr_ori);
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->bg_color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
-    }
+    /*The polygon is clipped to the area of its points*/
+    get_points_area(points, point_cnt, &cmd.area);
 
-    lv_draw_polygon(driver.draw_ctx, draw_dsc, points, point_cnt);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    deinit_fake_disp(canvas, &fake_disp);
-
-    lv_obj_invalidate(canvas);
+    add_cmd(canvas, &cmd);
 }
 
 void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t r, int32_t start_angle,
@@ -688,31 +500,20 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
 #if LV_USE_DRAW_MASKS
     LV_ASSERT_OBJ(canvas, MY_CLASS);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
-
-    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
-        LV_LOG_WARN("lv_canvas_draw_arc: can't draw to LV_IMG_CF_INDEXED canvas");
-        return;
-    }
-
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
+    if(!can_draw(canvas, "lv_canvas_draw_arc")) return;
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    canvas_cmd_t cmd;
+    lv_memzero(&cmd, sizeof(cmd));
+    cmd.type = CANVAS_CMD_ARC;
+    cmd.dsc.arc = *draw_dsc;
+    cmd.center.x = x;
+    cmd.center.y = y;
+    cmd.radius = r;
+    cmd.start_angle = start_angle;
+    cmd.end_angle = end_angle;
+    lv_area_set(&cmd.area, x - r, y - r, x + r - 1, y + r - 1);
 
-    lv_point_t p = {x, y};
-    lv_draw_arc(driver.draw_ctx, draw_dsc, &p, r,  start_angle, end_angle);
-
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    deinit_fake_disp(canvas, &fake_disp);
-
-    lv_obj_invalidate(canvas);
+    add_cmd(canvas, &cmd);
 #else
     LV_UNUSED(canvas);
     LV_UNUSED(x);
@@ -725,6 +526,36 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
 #endif
 }
 
+void lv_canvas_batch_begin(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    if(canvas->batch) {
+        LV_LOG_WARN("lv_canvas_batch_begin: a batch is already started");
+        return;
+    }
+
+    canvas->batch = lv_malloc(sizeof(lv_canvas_batch_t));
+    LV_ASSERT_MALLOC(canvas->batch);
+    if(canvas->batch == NULL) return;
+    lv_memzero(canvas->batch, sizeof(lv_canvas_batch_t));
+}
+
+void lv_canvas_batch_end(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    if(canvas->batch == NULL) {
+        LV_LOG_WARN("lv_canvas_batch_end: no batch was started");
+        return;
+    }
+
+    flush_batch(obj);
+    free_batch(obj);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -742,6 +573,7 @@ static void lv_canvas_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     canvas->dsc.header.w           = 0;
     canvas->dsc.data_size          = 0;
     canvas->dsc.data               = NULL;
+    canvas->batch                  = NULL;
 
     lv_img_set_src(obj, &canvas->dsc);
 
@@ -755,6 +587,8 @@ static void lv_canvas_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
     lv_img_cache_invalidate_src(&canvas->dsc);
+
+    free_batch(obj);
 }
 
 
@@ -812,6 +646,312 @@ static void deinit_fake_disp(lv_obj_t * canvas, lv_disp_t * disp)
     lv_free(disp->driver->draw_ctx);
 }
 
+static bool can_draw(lv_obj_t * canvas, const char * func)
+{
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+
+    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
+        LV_LOG_WARN("%s: can't draw to LV_IMG_CF_INDEXED canvas", func);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Draw a primitive or queue it if a batch is started.
+ * @param canvas pointer to a canvas object
+ * @param cmd    the primitive. Its `area` is clipped to the canvas.
+ */
+static void add_cmd(lv_obj_t * canvas, canvas_cmd_t * cmd)
+{
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+
+    lv_area_t canvas_area;
+    lv_area_set(&canvas_area, 0, 0, dsc->header.w - 1, dsc->header.h - 1);
+    if(!_lv_area_intersect(&cmd->area, &cmd->area, &canvas_area)) return;
+
+    lv_canvas_batch_t * batch = ((lv_canvas_t *)canvas)->batch;
+    if(batch == NULL) {
+        draw_cmds(canvas, cmd, 1);
+        return;
+    }
+
+    if(batch->cnt == batch->size) {
+        uint32_t new_size = batch->size ? batch->size * 2 : 16;
+        canvas_cmd_t * new_cmds = lv_realloc(batch->cmds, new_size * sizeof(canvas_cmd_t));
+        LV_ASSERT_MALLOC(new_cmds);
+        if(new_cmds == NULL) {
+            /*Draw the queued primitives and this one without queuing*/
+            flush_batch(canvas);
+            draw_cmds(canvas, cmd, 1);
+            return;
+        }
+        batch->cmds = new_cmds;
+        batch->size = new_size;
+    }
+
+    /*The caller's data can be changed or freed before the batch ends*/
+    if(cmd->data_size) {
+        void * data = lv_malloc(cmd->data_size);
+        LV_ASSERT_MALLOC(data);
+        if(data == NULL) {
+            flush_batch(canvas);
+            draw_cmds(canvas, cmd, 1);
+            return;
+        }
+        lv_memcpy(data, cmd->data, cmd->data_size);
+        cmd->data = data;
+    }
+
+    batch->cmds[batch->cnt] = *cmd;
+    batch->cnt++;
+}
+
+/*Draw the primitives with one fake display and invalidate only the affected area*/
+static void draw_cmds(lv_obj_t * canvas, canvas_cmd_t * cmds, uint32_t cnt)
+{
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+
+    /*Create a dummy display to fool the lv_draw function.
+     *It will think it draws to real screen.*/
+    lv_disp_t fake_disp;
+    lv_disp_drv_t driver;
+    lv_area_t clip_area;
+    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
+    if(driver.draw_ctx == NULL) return;
+
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&fake_disp);
+
+    lv_color_t ctransp = lv_disp_get_chroma_key_color(refr_ori);
+    bool chroma_keyed = dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+    uint32_t antialiasing = driver.antialiasing;
+
+    lv_area_t inv_area;
+    bool inv = false;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        const canvas_cmd_t * cmd = &cmds[i];
+        if(cmd->hidden) continue;
+
+        /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
+        driver.antialiasing = antialiasing;
+        if(chroma_keyed) {
+            if((cmd->type == CANVAS_CMD_RECT || cmd->type == CANVAS_CMD_POLYGON) &&
+               cmd->dsc.rect.bg_color.full == ctransp.full) {
+                driver.antialiasing = 0;
+            }
+            else if(cmd->type == CANVAS_CMD_LINE && cmd->dsc.line.color.full == ctransp.full) {
+                driver.antialiasing = 0;
+            }
+        }
+
+        draw_cmd(driver.draw_ctx, cmd);
+
+        if(inv) _lv_area_join(&inv_area, &inv_area, &cmd->area);
+        else lv_area_copy(&inv_area, &cmd->area);
+        inv = true;
+    }
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+
+    deinit_fake_disp(canvas, &fake_disp);
+
+    if(inv) invalidate_canvas_area(canvas, &inv_area);
+}
+
+static void draw_cmd(lv_draw_ctx_t * draw_ctx, const canvas_cmd_t * cmd)
+{
+    const lv_point_t * points = cmd->data;
+    uint32_t i;
+
+    switch(cmd->type) {
+        case CANVAS_CMD_RECT:
+            lv_draw_rect(draw_ctx, &cmd->dsc.rect, &cmd->coords);
+            break;
+        case CANVAS_CMD_TEXT:
+            lv_draw_label(draw_ctx, &cmd->dsc.label, &cmd->coords, cmd->data, NULL);
+            break;
+        case CANVAS_CMD_IMG:
+            lv_draw_img(draw_ctx, &cmd->dsc.img, &cmd->coords, cmd->data);
+            break;
+        case CANVAS_CMD_LINE:
+            for(i = 0; i < cmd->point_cnt - 1; i++) {
+                lv_draw_line(draw_ctx, &cmd->dsc.line, &points[i], &points[i + 1]);
+            }
+            break;
+        case CANVAS_CMD_POLYGON:
+            lv_draw_polygon(draw_ctx, &cmd->dsc.rect, points, cmd->point_cnt);
+            break;
+        case CANVAS_CMD_ARC:
+            lv_draw_arc(draw_ctx, &cmd->dsc.arc, &cmd->center, cmd->radius, cmd->start_angle, cmd->end_angle);
+            break;
+    }
+}
+
+/**
+ * Hide the primitives which are completely covered by a later opaque rectangle.
+ * E.g. the cells of a heat map redrawn in the same batch.
+ */
+static void cull_covered_cmds(canvas_cmd_t * cmds, uint32_t cnt)
+{
+    lv_area_t covers[BATCH_COVER_MAX];
+    uint32_t cover_cnt = 0;
+
+    uint32_t i = cnt;
+    while(i > 0) {
+        i--;
+        canvas_cmd_t * cmd = &cmds[i];
+
+        uint32_t c;
+        for(c = 0; c < cover_cnt; c++) {
+            if(_lv_area_is_in(&cmd->area, &covers[c], 0)) break;
+        }
+        if(c < cover_cnt) {
+            cmd->hidden = 1;
+            continue;
+        }
+
+        if(cmd->type != CANVAS_CMD_RECT) continue;
+        const lv_draw_rect_dsc_t * rect_dsc = &cmd->dsc.rect;
+        if(rect_dsc->radius != 0 || rect_dsc->bg_opa < LV_OPA_COVER || rect_dsc->blend_mode != LV_BLEND_MODE_NORMAL) continue;
+
+        /*The background covers the rectangle's area on the canvas*/
+        lv_area_t cover;
+        if(!_lv_area_intersect(&cover, &cmd->coords, &cmd->area)) continue;
+
+        /*Join it with the neighbors forming a rectangle together (e.g. a row of cells)*/
+        c = 0;
+        while(c < cover_cnt) {
+            if(areas_joinable(&cover, &covers[c])) {
+                _lv_area_join(&cover, &cover, &covers[c]);
+                cover_cnt--;
+                covers[c] = covers[cover_cnt];
+                c = 0;  /*The larger area might be joinable with the previous ones too*/
+            }
+            else {
+                c++;
+            }
+        }
+
+        /*Keep the largest ones if there are too many*/
+        if(cover_cnt < BATCH_COVER_MAX) {
+            covers[cover_cnt] = cover;
+            cover_cnt++;
+        }
+        else {
+            uint32_t min_c = 0;
+            for(c = 1; c < cover_cnt; c++) {
+                if(lv_area_get_size(&covers[c]) < lv_area_get_size(&covers[min_c])) min_c = c;
+            }
+            if(lv_area_get_size(&cover) > lv_area_get_size(&covers[min_c])) covers[min_c] = cover;
+        }
+    }
+}
+
+/*True if the union of the areas is a rectangle*/
+static bool areas_joinable(const lv_area_t * a1, const lv_area_t * a2)
+{
+    if(_lv_area_is_in(a1, a2, 0) || _lv_area_is_in(a2, a1, 0)) return true;
+
+    /*Side by side with the same height or below each other with the same width*/
+    if(a1->y1 == a2->y1 && a1->y2 == a2->y2 && a1->x1 <= a2->x2 + 1 && a2->x1 <= a1->x2 + 1) return true;
+    if(a1->x1 == a2->x1 && a1->x2 == a2->x2 && a1->y1 <= a2->y2 + 1 && a2->y1 <= a1->y2 + 1) return true;
+
+    return false;
+}
+
+/*Draw and remove the queued primitives*/
+static void flush_batch(lv_obj_t * canvas)
+{
+    lv_canvas_batch_t * batch = ((lv_canvas_t *)canvas)->batch;
+    if(batch == NULL || batch->cnt == 0) return;
+
+    cull_covered_cmds(batch->cmds, batch->cnt);
+    draw_cmds(canvas, batch->cmds, batch->cnt);
+    clear_batch(canvas);
+}
+
+/*Remove the queued primitives without drawing them*/
+static void clear_batch(lv_obj_t * canvas)
+{
+    lv_canvas_batch_t * batch = ((lv_canvas_t *)canvas)->batch;
+    if(batch == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < batch->cnt; i++) {
+        if(batch->cmds[i].data_size) lv_free((void *)batch->cmds[i].data);
+    }
+    batch->cnt = 0;
+}
+
+/*Drop the queued primitives and free the batch*/
+static void free_batch(lv_obj_t * canvas)
+{
+    lv_canvas_t * c = (lv_canvas_t *)canvas;
+    if(c->batch == NULL) return;
+
+    clear_batch(canvas);
+    lv_free(c->batch->cmds);
+    lv_free(c->batch);
+    c->batch = NULL;
+}
+
+/*The same as the extra draw size of an object with the same style*/
+static lv_coord_t rect_ext_size(const lv_draw_rect_dsc_t * draw_dsc)
+{
+    lv_coord_t s = 0;
+    if(draw_dsc->shadow_width && draw_dsc->shadow_opa > LV_OPA_MIN) {
+        lv_coord_t sh_width = draw_dsc->shadow_width / 2 + 1;    /*The blur adds only half width*/
+        sh_width += draw_dsc->shadow_spread;
+        sh_width += LV_MAX(LV_ABS(draw_dsc->shadow_ofs_x), LV_ABS(draw_dsc->shadow_ofs_y));
+        s = LV_MAX(s, sh_width);
+    }
+
+    if(draw_dsc->outline_width && draw_dsc->outline_opa > LV_OPA_MIN) {
+        s = LV_MAX(s, draw_dsc->outline_pad + draw_dsc->outline_width);
+    }
+
+    return s;
+}
+
+static void get_points_area(const lv_point_t points[], uint32_t point_cnt, lv_area_t * area)
+{
+    lv_area_set(area, LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN);
+    uint32_t i;
+    for(i = 0; i < point_cnt; i++) {
+        area->x1 = LV_MIN(area->x1, points[i].x);
+        area->y1 = LV_MIN(area->y1, points[i].y);
+        area->x2 = LV_MAX(area->x2, points[i].x);
+        area->y2 = LV_MAX(area->y2, points[i].y);
+    }
+}
+
+/**
+ * Invalidate an area of the canvas' image.
+ * @param canvas pointer to a canvas object
+ * @param area   the area relative to the image
+ */
+static void invalidate_canvas_area(lv_obj_t * canvas, const lv_area_t * area)
+{
+    lv_img_t * img = (lv_img_t *)canvas;
+
+    /*Invalidate the whole canvas if the image is transformed, tiled or aligned*/
+    lv_area_t content;
+    lv_obj_get_content_coords(canvas, &content);
+    if(img->zoom != LV_IMG_ZOOM_NONE || img->angle != 0 || img->offset.x != 0 || img->offset.y != 0 ||
+       lv_area_get_width(&content) != img->w || lv_area_get_height(&content) != img->h) {
+        lv_obj_invalidate(canvas);
+        return;
+    }
+
+    lv_area_t a;
+    lv_area_copy(&a, area);
+    lv_area_move(&a, content.x1, content.y1);
+    lv_obj_invalidate_area(canvas, &a);
+}
+
 
 
 #endif
@@ -29,10 +29,14 @@ extern "C" {
  **********************/
 extern const lv_obj_class_t lv_canvas_class;
 
+struct _lv_canvas_batch_t;
+typedef struct _lv_canvas_batch_t lv_canvas_batch_t;
+
 /*Data of canvas*/
 typedef struct {
     lv_img_t img;
     lv_img_dsc_t dsc;
+    lv_canvas_batch_t * batch;      /*The queued primitives between `lv_canvas_batch_begin/end()`*/
 } lv_canvas_t;
 
 /**********************
@@ -163,7 +167,7 @@ void lv_canvas_transform(lv_obj_t * canvas, lv_img_dsc_t * img, int16_t angle, u
  * Apply horizontal blur on the canvas
  * @param canvas pointer to a canvas object
  * @param area the area to blur. If `NULL` the whole canvas will be blurred.
- * @param r radius of the blur
+ * @param r radius of the blur (at most 255)
  */
 void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
 
@@ -171,10 +175,19 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
  * Apply vertical blur on the canvas
  * @param canvas pointer to a canvas object
  * @param area the area to blur. If `NULL` the whole canvas will be blurred.
- * @param r radius of the blur
+ * @param r radius of the blur (at most 255)
  */
 void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
 
+/**
+ * Apply an approximated Gaussian blur on the canvas.
+ * It's the same as 3 horizontal and vertical blurs with sizes calculated from `radius`.
+ * @param canvas pointer to a canvas object
+ * @param area the area to blur. If `NULL` the whole canvas will be blurred.
+ * @param radius standard deviation of the blur in pixels (at most 100)
+ */
+void lv_canvas_blur(lv_obj_t * canvas, const lv_area_t * area, uint16_t radius);
+
 /**
  * Fill the canvas with color
  * @param canvas pointer to a canvas
@@ -251,6 +264,23 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
 void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t r, int32_t start_angle,
                         int32_t end_angle, const lv_draw_arc_dsc_t * draw_dsc);
 
+/**
+ * Start to queue the primitives of the `lv_canvas_draw_...()` functions instead of drawing them immediately.
+ * The draw descriptors, texts, points and image paths are copied,
+ * but the image descriptors and fonts need to remain valid until `lv_canvas_batch_end()`.
+ * The other functions modifying the canvas (e.g. `lv_canvas_set_px_color()`) draw the queued primitives first.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_batch_begin(lv_obj_t * canvas);
+
+/**
+ * Draw the queued primitives at once and stop queuing.
+ * The primitives fully covered by a later opaque rectangle are skipped
+ * and only the area affected by the primitives is invalidated.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_batch_end(lv_obj_t * canvas);
+
 /**********************
  *      MACROS
  **********************/
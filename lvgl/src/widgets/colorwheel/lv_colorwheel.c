@@ -51,7 +51,8 @@ static uint16_t get_angle(lv_obj_t * obj);
 /**********************
  *  STATIC VARIABLES
  **********************/
-const lv_obj_class_t lv_colorwheel_class = {.instance_size = sizeof(lv_colorwheel_t), .base_class = &lv_obj_class,
+const lv_obj_class_t lv_colorwheel_class = {.name = "colorwheel",
+                                            .instance_size = sizeof(lv_colorwheel_t), .base_class = &lv_obj_class,
                                             .constructor_cb = lv_colorwheel_constructor,
                                             .event_cb = lv_colorwheel_event,
                                             .width_def = LV_DPI_DEF * 2,
@@ -60,6 +60,7 @@ static lv_obj_t * get_label(const lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_dropdown_class = {
+    .name = "dropdown",
     .constructor_cb = lv_dropdown_constructor,
     .destructor_cb = lv_dropdown_destructor,
     .event_cb = lv_dropdown_event,
@@ -72,6 +73,7 @@ const lv_obj_class_t lv_dropdown_class = {
 };
 
 const lv_obj_class_t lv_dropdownlist_class = {
+    .name = "dropdownlist",
     .constructor_cb = lv_dropdownlist_constructor,
     .destructor_cb = lv_dropdownlist_destructor,
     .event_cb = lv_dropdown_list_event,
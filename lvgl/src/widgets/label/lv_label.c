@@ -53,6 +53,7 @@ static void set_ofs_y_anim(void * obj, int32_t v);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_label_class = {
+    .name = "label",
     .constructor_cb = lv_label_constructor,
     .destructor_cb = lv_label_destructor,
     .event_cb = lv_label_event,
@@ -31,6 +31,7 @@ static void lv_led_event(const lv_obj_class_t * class_p, lv_event_t * e);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_led_class  = {
+    .name = "led",
     .base_class = &lv_obj_class,
     .constructor_cb = lv_led_constructor,
     .width_def = LV_DPI_DEF / 5,
@@ -35,6 +35,7 @@ static void lv_line_event(const lv_obj_class_t * class_p, lv_event_t * e);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_line_class = {
+    .name = "line",
     .constructor_cb = lv_line_constructor,
     .event_cb = lv_line_event,
     .width_def = LV_SIZE_CONTENT,
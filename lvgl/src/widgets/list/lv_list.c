@@ -29,16 +29,19 @@
  **********************/
 
 const lv_obj_class_t lv_list_class = {
+    .name = "list",
     .base_class = &lv_obj_class,
     .width_def = (LV_DPI_DEF * 3) / 2,
     .height_def = LV_DPI_DEF * 2
 };
 
 const lv_obj_class_t lv_list_btn_class = {
+    .name = "list_btn",
     .base_class = &lv_btn_class,
 };
 
 const lv_obj_class_t lv_list_text_class = {
+    .name = "list_text",
     .base_class = &lv_label_class,
 };
 
@@ -0,0 +1,471 @@
+/**
+ * @file lv_readout.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_readout.h"
+#if LV_USE_READOUT
+
+#include "../../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_readout_class
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Horizontal positions relative to the start of the text*/
+typedef struct {
+    lv_coord_t cells_x;     /*Start of the first digit cell*/
+    lv_coord_t cell_w;      /*Width of a digit cell without letter space*/
+    lv_coord_t point_w;     /*Width of the decimal point without letter space*/
+    lv_coord_t prefix_w;
+    lv_coord_t suffix_x;
+    lv_coord_t suffix_w;
+    lv_coord_t w;           /*Width of the whole text*/
+} lv_readout_geometry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_readout_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_readout_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_readout_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void draw_main(lv_event_t * e);
+static void fill_cells(lv_readout_t * readout, int32_t value, char * cells);
+static void update_text(lv_readout_t * readout, char * txt);
+static void get_geometry(lv_obj_t * obj, lv_readout_geometry_t * geom);
+static void get_text_pos(lv_obj_t * obj, const lv_readout_geometry_t * geom, lv_point_t * pos);
+static lv_coord_t get_cell_x(lv_readout_t * readout, const lv_readout_geometry_t * geom, uint32_t cell_id);
+static void get_letter_area(const lv_font_t * font, const lv_point_t * pos, uint32_t letter, lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_readout_class = {
+    .name = "readout",
+    .constructor_cb = lv_readout_constructor,
+    .destructor_cb = lv_readout_destructor,
+    .event_cb = lv_readout_event,
+    .width_def = LV_SIZE_CONTENT,
+    .height_def = LV_SIZE_CONTENT,
+    .instance_size = sizeof(lv_readout_t),
+    .base_class = &lv_label_class
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_readout_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+void lv_readout_set_format(lv_obj_t * obj, const char * fmt, uint8_t digit_count, uint8_t dec_point_pos)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(fmt);
+
+    lv_readout_t * readout = (lv_readout_t *)obj;
+
+    if(digit_count < 1) digit_count = 1;
+    if(digit_count > LV_READOUT_MAX_DIGIT_COUNT) digit_count = LV_READOUT_MAX_DIGIT_COUNT;
+    if(dec_point_pos >= digit_count) dec_point_pos = digit_count - 1;
+
+    /*Allocate the prefix, the suffix and the label's text together.
+     *The text can't be longer than the prefix and suffix with all the digits and the decimal point.*/
+    uint32_t fmt_len = strlen(fmt);
+    char * buf = lv_malloc(fmt_len * 2 + digit_count + 4);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return;
+
+    char * prefix = buf;
+    char * suffix = NULL;
+    char * p = prefix;
+    uint32_t i;
+    for(i = 0; fmt[i] != '\0'; i++) {
+        if(fmt[i] == '%' && fmt[i + 1] == '%') {
+            *p = '%';
+            p++;
+            i++;
+        }
+        else if(fmt[i] == '%' && fmt[i + 1] == 'd' && suffix == NULL) {
+            *p = '\0';
+            p++;
+            suffix = p;
+            i++;
+        }
+        else {
+            *p = fmt[i];
+            p++;
+        }
+    }
+    *p = '\0';
+    p++;
+
+    /*No `%d`: show the value after the text*/
+    if(suffix == NULL) {
+        suffix = p - 1;
+    }
+
+    char * old_buf = readout->prefix;
+    readout->prefix = prefix;
+    readout->suffix = suffix;
+    readout->digit_count = digit_count;
+    readout->dec_point_pos = dec_point_pos;
+    fill_cells(readout, readout->value, readout->cells);
+    update_text(readout, p);
+
+    lv_obj_invalidate(obj);
+    lv_label_set_text_static(obj, p);
+    lv_free(old_buf);
+}
+
+void lv_readout_set_value(lv_obj_t * obj, int32_t value)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_readout_t * readout = (lv_readout_t *)obj;
+
+    char cells[LV_READOUT_MAX_DIGIT_COUNT];
+    fill_cells(readout, value, cells);
+    readout->value = value;
+
+    /*Invalidate only the cells which have changed. As the cells have fixed positions,
+     *the rest of the text remains in place.*/
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_readout_geometry_t geom;
+    lv_point_t text_pos;
+    bool inv = false;
+    lv_area_t inv_area;
+    uint32_t i;
+    for(i = 0; i < readout->digit_count; i++) {
+        if(cells[i] == readout->cells[i]) continue;
+
+        if(!inv) {
+            get_geometry(obj, &geom);
+            get_text_pos(obj, &geom, &text_pos);
+        }
+
+        lv_area_t a;
+        lv_coord_t cell_x = text_pos.x + get_cell_x(readout, &geom, i);
+        a.x1 = cell_x;
+        a.y1 = text_pos.y;
+        a.x2 = cell_x + geom.cell_w - 1;
+        a.y2 = text_pos.y + lv_font_get_line_height(font) - 1;
+        if(!inv) inv_area = a;
+        else _lv_area_join(&inv_area, &inv_area, &a);
+
+        /*The letters might be larger than the cell*/
+        lv_point_t pos;
+        pos.y = text_pos.y;
+        if(readout->cells[i] != ' ') {
+            pos.x = cell_x + (geom.cell_w - lv_font_get_glyph_width(font, readout->cells[i], 0)) / 2;
+            get_letter_area(font, &pos, readout->cells[i], &a);
+            _lv_area_join(&inv_area, &inv_area, &a);
+        }
+        if(cells[i] != ' ') {
+            pos.x = cell_x + (geom.cell_w - lv_font_get_glyph_width(font, cells[i], 0)) / 2;
+            get_letter_area(font, &pos, cells[i], &a);
+            _lv_area_join(&inv_area, &inv_area, &a);
+        }
+
+        readout->cells[i] = cells[i];
+        inv = true;
+    }
+
+    if(!inv) return;
+
+    update_text(readout, readout->label.text);
+    lv_obj_invalidate_area(obj, &inv_area);
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+int32_t lv_readout_get_value(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_readout_t * readout = (lv_readout_t *)obj;
+    return readout->value;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_readout_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_readout_t * readout = (lv_readout_t *)obj;
+
+    readout->value = 0;
+    readout->prefix = NULL;
+    readout->suffix = NULL;
+    lv_readout_set_format(obj, "%d", 5, 0);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_readout_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_readout_t * readout = (lv_readout_t *)obj;
+
+    /*The label's text is in the same buffer as the prefix*/
+    lv_free(readout->prefix);
+    readout->prefix = NULL;
+    readout->suffix = NULL;
+    readout->label.text = NULL;
+}
+
+static void lv_readout_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res;
+
+    /*The readout measures and draws the label's text on its own. Skip the label in these cases.*/
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code == LV_EVENT_GET_SELF_SIZE || code == LV_EVENT_DRAW_MAIN) res = lv_obj_event_base(&lv_label_class, e);
+    else res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RES_OK) return;
+
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_readout_t * readout = (lv_readout_t *)obj;
+
+    if(code == LV_EVENT_GET_SELF_SIZE) {
+        /*Not initialized yet*/
+        if(readout->prefix == NULL) return;
+
+        lv_readout_geometry_t geom;
+        get_geometry(obj, &geom);
+        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+
+        lv_point_t * self_size = lv_event_get_param(e);
+        self_size->x = LV_MAX(self_size->x, geom.w);
+        self_size->y = LV_MAX(self_size->y, lv_font_get_line_height(font));
+    }
+    else if(code == LV_EVENT_DRAW_MAIN) {
+        draw_main(e);
+    }
+}
+
+static void draw_main(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_readout_t * readout = (lv_readout_t *)obj;
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+    if(readout->prefix == NULL) return;
+
+    lv_draw_label_dsc_t label_draw_dsc;
+    lv_draw_label_dsc_init(&label_draw_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
+    label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
+    label_draw_dsc.flag = LV_TEXT_FLAG_EXPAND;
+
+    lv_readout_geometry_t geom;
+    get_geometry(obj, &geom);
+    lv_point_t text_pos;
+    get_text_pos(obj, &geom, &text_pos);
+
+    lv_area_t a;
+    a.y1 = text_pos.y;
+    a.y2 = a.y1 + lv_font_get_line_height(label_draw_dsc.font) - 1;
+
+    if(readout->prefix[0] != '\0') {
+        a.x1 = text_pos.x;
+        a.x2 = a.x1 + geom.prefix_w - 1;
+        lv_draw_label(draw_ctx, &label_draw_dsc, &a, readout->prefix, NULL);
+    }
+
+    uint32_t i;
+    lv_point_t pos;
+    pos.y = text_pos.y;
+    for(i = 0; i < readout->digit_count; i++) {
+        char c = readout->cells[i];
+        if(c == ' ') continue;
+
+        lv_coord_t x = text_pos.x + get_cell_x(readout, &geom, i);
+        pos.x = x + (geom.cell_w - lv_font_get_glyph_width(label_draw_dsc.font, c, 0)) / 2;
+        lv_draw_letter(draw_ctx, &label_draw_dsc, &pos, c);
+    }
+
+    if(readout->dec_point_pos) {
+        pos.x = text_pos.x + get_cell_x(readout, &geom, readout->digit_count - readout->dec_point_pos) -
+                label_draw_dsc.letter_space - geom.point_w;
+        lv_draw_letter(draw_ctx, &label_draw_dsc, &pos, '.');
+    }
+
+    if(readout->suffix[0] != '\0') {
+        a.x1 = text_pos.x + geom.suffix_x;
+        a.x2 = a.x1 + geom.suffix_w - 1;
+        lv_draw_label(draw_ctx, &label_draw_dsc, &a, readout->suffix, NULL);
+    }
+}
+
+/**
+ * Get the characters of the digit cells. The value is aligned to the right and the unused cells are ' '.
+ */
+static void fill_cells(lv_readout_t * readout, int32_t value, char * cells)
+{
+    /*Limit the value to the digit cells. A negative value needs a cell for the minus sign.*/
+    int64_t max = 1;
+    uint32_t i;
+    for(i = 0; i < readout->digit_count; i++) max *= 10;
+    int64_t min = readout->digit_count > readout->dec_point_pos + 1 ? -(max / 10 - 1) : 0;
+    max = max - 1;
+
+    int64_t v = value;
+    if(v > max) v = max;
+    if(v < min) v = min;
+
+    bool neg = v < 0;
+    if(neg) v = -v;
+
+    /*Show at least one integer digit, e.g. "0.5"*/
+    int32_t min_digits = readout->dec_point_pos + 1;
+    int32_t cell_id;
+    for(cell_id = readout->digit_count - 1; cell_id >= 0; cell_id--) {
+        if(v == 0 && min_digits <= 0) break;
+        cells[cell_id] = '0' + (v % 10);
+        v = v / 10;
+        min_digits--;
+    }
+
+    if(neg && cell_id >= 0) {
+        cells[cell_id] = '-';
+        cell_id--;
+    }
+
+    for(; cell_id >= 0; cell_id--) {
+        cells[cell_id] = ' ';
+    }
+}
+
+/**
+ * Write the whole text into the label's text buffer to make `lv_label_get_text` return the current text
+ */
+static void update_text(lv_readout_t * readout, char * txt)
+{
+    char * p = txt;
+    const char * src;
+    for(src = readout->prefix; *src != '\0'; src++) {
+        *p = *src;
+        p++;
+    }
+
+    uint32_t i;
+    for(i = 0; i < readout->digit_count; i++) {
+        if(readout->dec_point_pos && i == (uint32_t)(readout->digit_count - readout->dec_point_pos)) {
+            *p = '.';
+            p++;
+        }
+        if(readout->cells[i] == ' ') continue;
+        *p = readout->cells[i];
+        p++;
+    }
+
+    for(src = readout->suffix; *src != '\0'; src++) {
+        *p = *src;
+        p++;
+    }
+    *p = '\0';
+}
+
+static void get_geometry(lv_obj_t * obj, lv_readout_geometry_t * geom)
+{
+    lv_readout_t * readout = (lv_readout_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+
+    /*The cells are as wide as the widest digit or the minus sign*/
+    geom->cell_w = lv_font_get_glyph_width(font, '-', 0);
+    uint32_t c;
+    for(c = '0'; c <= '9'; c++) {
+        geom->cell_w = LV_MAX(geom->cell_w, lv_font_get_glyph_width(font, c, 0));
+    }
+    geom->point_w = readout->dec_point_pos ? lv_font_get_glyph_width(font, '.', 0) : 0;
+
+    geom->prefix_w = lv_txt_get_width(readout->prefix, strlen(readout->prefix), font, letter_space, LV_TEXT_FLAG_NONE);
+    geom->cells_x = geom->prefix_w ? geom->prefix_w + letter_space : 0;
+    geom->suffix_x = get_cell_x(readout, geom, readout->digit_count);
+    geom->suffix_w = lv_txt_get_width(readout->suffix, strlen(readout->suffix), font, letter_space, LV_TEXT_FLAG_NONE);
+    geom->w = geom->suffix_w ? geom->suffix_x + geom->suffix_w : geom->suffix_x - letter_space;
+}
+
+/**
+ * Get the absolute position of the text according to the text align
+ */
+static void get_text_pos(lv_obj_t * obj, const lv_readout_geometry_t * geom, lv_point_t * pos)
+{
+    lv_readout_t * readout = (lv_readout_t *)obj;
+    lv_area_t txt_coords;
+    lv_obj_get_content_coords(obj, &txt_coords);
+
+    pos->x = txt_coords.x1;
+    pos->y = txt_coords.y1;
+
+    lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, readout->label.text);
+    if(align == LV_TEXT_ALIGN_CENTER) pos->x += (lv_area_get_width(&txt_coords) - geom->w) / 2;
+    else if(align == LV_TEXT_ALIGN_RIGHT) pos->x += lv_area_get_width(&txt_coords) - geom->w;
+}
+
+/**
+ * Get the x coordinate of a digit cell relative to the start of the text.
+ * The decimal point is before the first fractional digit.
+ */
+static lv_coord_t get_cell_x(lv_readout_t * readout, const lv_readout_geometry_t * geom, uint32_t cell_id)
+{
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space((lv_obj_t *)readout, LV_PART_MAIN);
+    lv_coord_t x = geom->cells_x + cell_id * (geom->cell_w + letter_space);
+    if(readout->dec_point_pos && cell_id >= (uint32_t)(readout->digit_count - readout->dec_point_pos)) {
+        x += geom->point_w + letter_space;
+    }
+    return x;
+}
+
+/**
+ * Get the area of a letter's bitmap, drawn by `lv_draw_letter` at `pos`
+ */
+static void get_letter_area(const lv_font_t * font, const lv_point_t * pos, uint32_t letter, lv_area_t * area)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(font, &g, letter, 0)) {
+        area->x1 = pos->x;
+        area->y1 = pos->y;
+        area->x2 = pos->x;
+        area->y2 = pos->y;
+        return;
+    }
+
+    area->x1 = pos->x + g.ofs_x;
+    area->y1 = pos->y + (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+    area->x2 = area->x1 + g.box_w - 1;
+    area->y2 = area->y1 + g.box_h - 1;
+}
+
+#endif
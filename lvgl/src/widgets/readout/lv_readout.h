@@ -0,0 +1,103 @@
+/**
+ * @file lv_readout.h
+ *
+ */
+
+#ifndef LV_READOUT_H
+#define LV_READOUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../label/lv_label.h"
+
+#if LV_USE_READOUT
+
+/*Testing of dependencies*/
+#if LV_USE_LABEL == 0
+#error "lv_readout: lv_label is required. Enable it in lv_conf.h (LV_USE_LABEL  1) "
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_READOUT_MAX_DIGIT_COUNT 10
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Data of readout*/
+typedef struct {
+    lv_label_t label;   /*Ext. of ancestor*/
+    /*New data for this type*/
+    int32_t value;
+    char * prefix;      /*The text before the value. The suffix and the label's text are stored after it.*/
+    char * suffix;      /*The text after the value*/
+    char cells[LV_READOUT_MAX_DIGIT_COUNT]; /*The characters of the digit cells, ' ' if empty*/
+    uint8_t digit_count;
+    uint8_t dec_point_pos;  /*Number of fractional digits. If 0, there is no decimal point.*/
+} lv_readout_t;
+
+extern const lv_obj_class_t lv_readout_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a readout object
+ * @param parent    pointer to an object, it will be the parent of the new readout
+ * @return          pointer to the created readout
+ */
+lv_obj_t * lv_readout_create(lv_obj_t * parent);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the format of the readout. The size of the readout doesn't depend on the value
+ * because each digit has a cell as wide as the widest digit.
+ * @param obj               pointer to a readout
+ * @param fmt               the text around the value with a `%d` where the value should be, e.g. "%d ppm".
+ *                          Use `%%` for a `%` character.
+ * @param digit_count       number of digit cells including the fractional digits and the minus sign
+ *                          (1..LV_READOUT_MAX_DIGIT_COUNT)
+ * @param dec_point_pos     number of fractional digits, e.g. 1 to show 253 as "25.3". 0: no decimal point.
+ */
+void lv_readout_set_format(lv_obj_t * obj, const char * fmt, uint8_t digit_count, uint8_t dec_point_pos);
+
+/**
+ * Set the value of the readout. Only the digit cells which have changed are redrawn.
+ * @param obj       pointer to a readout
+ * @param value     the new value. It's limited to the values which fit into the digit cells.
+ */
+void lv_readout_set_value(lv_obj_t * obj, int32_t value);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the value of the readout
+ * @param obj       pointer to a readout
+ * @return          the value
+ */
+int32_t lv_readout_get_value(const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_READOUT*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_READOUT_H*/
@@ -21,6 +21,14 @@
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_table_class
+#define ROW_NONE 0xFFFFFFFF
+
+#if LV_TABLE_VIRTUAL
+/*Virtual tables can have much more rows than what fits to `lv_coord_t`. So only a window of rows
+ *is scrollable and it's moved when the visible rows get close to its edges.
+ *Moving the window is cheap so use the same size with large coordinates too.*/
+#define VIRTUAL_WIN_H LV_MIN(LV_COORD_MAX / 2, 4096)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -38,20 +46,41 @@ static lv_coord_t get_row_height(lv_obj_t * obj, uint16_t row_id, const lv_font_
                                  lv_coord_t cell_left, lv_coord_t cell_right, lv_coord_t cell_top, lv_coord_t cell_bottom);
 static void refr_size_form_row(lv_obj_t * obj, uint32_t start_row);
 static void refr_cell_size(lv_obj_t * obj, uint32_t row, uint32_t col);
-static lv_res_t get_pressed_cell(lv_obj_t * obj, uint16_t * row, uint16_t * col);
+static lv_res_t get_pressed_cell(lv_obj_t * obj, uint32_t * row, uint16_t * col);
 static size_t get_cell_txt_len(const char * txt);
 static void copy_cell_txt(char * dst, const char * txt);
 static void get_cell_area(lv_obj_t * obj, uint16_t row, uint16_t col, lv_area_t * area);
+static uint32_t get_row_cnt(lv_table_t * table);
+static uint32_t get_row_act(lv_table_t * table);
+static void set_row_act(lv_table_t * table, uint32_t row);
+#if LV_TABLE_VIRTUAL
+static void virt_refr_row_h(lv_obj_t * obj);
+static uint32_t virt_get_win_row_cnt(lv_table_t * table);
+static void virt_set_top_row(lv_obj_t * obj, uint32_t top_row);
+static void virt_check_rebase(lv_obj_t * obj);
+static void virt_scroll_to_visible(lv_obj_t * obj, uint32_t row);
+#endif
 
 static inline bool is_cell_empty(void * cell)
 {
     return cell == NULL;
 }
 
+static inline bool is_virtual(lv_table_t * table)
+{
+#if LV_TABLE_VIRTUAL
+    return table->virt != NULL;
+#else
+    LV_UNUSED(table);
+    return false;
+#endif
+}
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_table_class  = {
+    .name = "table",
     .constructor_cb = lv_table_constructor,
     .destructor_cb = lv_table_destructor,
     .event_cb = lv_table_event,
@@ -89,6 +118,11 @@ void lv_table_set_cell_value(lv_obj_t * obj, uint16_t row, uint16_t col, const c
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not available in virtual tables");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_col_cnt(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_cnt(obj, row + 1);
@@ -117,6 +151,12 @@ void lv_table_set_cell_value_fmt(lv_obj_t * obj, uint16_t row, uint16_t col, con
     LV_ASSERT_NULL(fmt);
 
     lv_table_t * table = (lv_table_t *)obj;
+
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not available in virtual tables");
+        return;
+    }
+
     if(col >= table->col_cnt) {
         lv_table_set_col_cnt(obj, col + 1);
     }
@@ -188,6 +228,11 @@ void lv_table_set_row_cnt(lv_obj_t * obj, uint16_t row_cnt)
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not available in virtual tables");
+        return;
+    }
+
     if(table->row_cnt == row_cnt) return;
 
     uint16_t old_row_cnt = table->row_cnt;
@@ -296,6 +341,11 @@ void lv_table_add_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_table
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not available in virtual tables");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_col_cnt(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_cnt(obj, row + 1);
@@ -320,6 +370,11 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_tab
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not available in virtual tables");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_col_cnt(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_cnt(obj, row + 1);
@@ -338,6 +393,102 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_tab
     table->cell_data[cell][0] &= (~ctrl);
 }
 
+#if LV_TABLE_VIRTUAL
+void lv_table_set_virtual(lv_obj_t * obj, uint32_t row_cnt, lv_table_virtual_cb_t cb)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+
+    if(cb == NULL) {
+        if(table->virt == NULL) return;
+        lv_free(table->virt);
+        table->virt = NULL;
+        table->row_act = 0;
+        lv_obj_scroll_to_y(obj, 0, LV_ANIM_OFF);
+        lv_table_set_row_cnt(obj, 1);
+        return;
+    }
+
+    if(table->virt == NULL) {
+        /*Free the cells of the normal mode*/
+        lv_table_set_row_cnt(obj, 0);
+
+        table->virt = lv_malloc(sizeof(lv_table_virtual_t));
+        LV_ASSERT_MALLOC(table->virt);
+        if(table->virt == NULL) return;
+        lv_memzero(table->virt, sizeof(lv_table_virtual_t));
+        lv_obj_scroll_to_y(obj, 0, LV_ANIM_OFF);
+        virt_refr_row_h(obj);
+    }
+
+    table->virt->cb = cb;
+    lv_table_set_virtual_row_cnt(obj, row_cnt);
+}
+
+void lv_table_set_virtual_row_cnt(lv_obj_t * obj, uint32_t row_cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+    if(table->virt == NULL) {
+        LV_LOG_WARN("not a virtual table");
+        return;
+    }
+
+    lv_table_virtual_t * virt = table->virt;
+    virt->row_cnt = row_cnt;
+    if(virt->row_act != ROW_NONE && virt->row_act >= row_cnt) virt->row_act = ROW_NONE;
+
+    /*Keep the visible rows in place if the window doesn't reach over the last row*/
+    virt_set_top_row(obj, virt->top_row);
+
+    refr_size_form_row(obj, 0);
+    lv_obj_readjust_scroll(obj, LV_ANIM_OFF);
+}
+#endif
+
+void lv_table_scroll_to_row(lv_obj_t * obj, uint32_t row, lv_anim_enable_t anim_en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+    uint32_t row_cnt = get_row_cnt(table);
+    if(row_cnt == 0) return;
+    if(row >= row_cnt) row = row_cnt - 1;
+
+#if LV_TABLE_VIRTUAL
+    lv_table_virtual_t * virt = table->virt;
+    if(virt) {
+        uint32_t win_row_cnt = virt_get_win_row_cnt(table);
+        uint32_t view_row_cnt = lv_obj_get_content_height(obj) / virt->row_h + 1;
+
+        /*Jump with the window if the row and the rows below it are not in it*/
+        if(row < virt->top_row || row + LV_MIN(view_row_cnt, win_row_cnt) > virt->top_row + win_row_cnt) {
+            uint32_t margin = (win_row_cnt - LV_MIN(view_row_cnt, win_row_cnt)) / 2;
+            virt->top_row = row > margin ? row - margin : 0;
+            if(virt->top_row > row_cnt - win_row_cnt) virt->top_row = row_cnt - win_row_cnt;
+
+            /*Far jumps can't be animated*/
+            virt->rebasing = 1;
+            lv_obj_scroll_to_y(obj, (row - virt->top_row) * virt->row_h, LV_ANIM_OFF);
+            virt->rebasing = 0;
+            lv_obj_invalidate(obj);
+            return;
+        }
+
+        lv_obj_scroll_to_y(obj, (row - virt->top_row) * virt->row_h, anim_en);
+        return;
+    }
+#endif
+
+    lv_coord_t y = 0;
+    uint32_t i;
+    for(i = 0; i < row; i++) y += table->row_h[i];
+
+    lv_obj_scroll_to_y(obj, y, anim_en);
+}
+
 /*=====================
  * Getter functions
  *====================*/
@@ -406,10 +557,29 @@ bool lv_table_has_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_table
 void lv_table_get_selected_cell(lv_obj_t * obj, uint16_t * row, uint16_t * col)
 {
     lv_table_t * table = (lv_table_t *)obj;
-    *row = table->row_act;
+    uint32_t row_act = get_row_act(table);
+    *row = row_act < LV_TABLE_CELL_NONE ? row_act : LV_TABLE_CELL_NONE;
     *col = table->col_act;
 }
 
+#if LV_TABLE_VIRTUAL
+uint32_t lv_table_get_virtual_row_cnt(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+    return table->virt ? table->virt->row_cnt : 0;
+}
+
+uint32_t lv_table_get_virtual_selected_row(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+    return table->virt ? table->virt->row_act : LV_TABLE_VIRTUAL_ROW_NONE;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -449,6 +619,9 @@ static void lv_table_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     if(table->cell_data) lv_free(table->cell_data);
     if(table->row_h) lv_free(table->row_h);
     if(table->col_w) lv_free(table->col_w);
+#if LV_TABLE_VIRTUAL
+    if(table->virt) lv_free(table->virt);
+#endif
 }
 
 static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -475,19 +648,23 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
         for(i = 0; i < table->col_cnt; i++) w += table->col_w[i];
 
         lv_coord_t h = 0;
-        for(i = 0; i < table->row_cnt; i++) h += table->row_h[i];
+#if LV_TABLE_VIRTUAL
+        if(table->virt) h = virt_get_win_row_cnt(table) * table->virt->row_h;
+        else
+#endif
+            for(i = 0; i < table->row_cnt; i++) h += table->row_h[i];
 
         p->x = w - 1;
         p->y = h - 1;
     }
     else if(code == LV_EVENT_PRESSED || code == LV_EVENT_PRESSING) {
         uint16_t col;
-        uint16_t row;
+        uint32_t row;
         lv_res_t pr_res = get_pressed_cell(obj, &row, &col);
 
-        if(pr_res == LV_RES_OK && (table->col_act != col || table->row_act != row)) {
+        if(pr_res == LV_RES_OK && (table->col_act != col || get_row_act(table) != row)) {
             table->col_act = col;
-            table->row_act = row;
+            set_row_act(table, row);
             lv_obj_invalidate(obj);
         }
     }
@@ -495,7 +672,7 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_obj_invalidate(obj);
         lv_indev_t * indev = lv_indev_get_act();
         lv_obj_t * scroll_obj = lv_indev_get_scroll_obj(indev);
-        if(table->col_act != LV_TABLE_CELL_NONE && table->row_act != LV_TABLE_CELL_NONE && scroll_obj == NULL) {
+        if(table->col_act != LV_TABLE_CELL_NONE && get_row_act(table) != ROW_NONE && scroll_obj == NULL) {
             res = lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
             if(res != LV_RES_OK) return;
         }
@@ -503,7 +680,7 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_indev_type_t indev_type = lv_indev_get_type(lv_indev_get_act());
         if(indev_type == LV_INDEV_TYPE_POINTER || indev_type == LV_INDEV_TYPE_BUTTON) {
             table->col_act = LV_TABLE_CELL_NONE;
-            table->row_act = LV_TABLE_CELL_NONE;
+            set_row_act(table, ROW_NONE);
         }
     }
     else if(code == LV_EVENT_FOCUSED) {
@@ -512,16 +689,18 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
     else if(code == LV_EVENT_KEY) {
         int32_t c = *((int32_t *)lv_event_get_param(e));
         int32_t col = table->col_act;
-        int32_t row = table->row_act;
-        if(col == LV_TABLE_CELL_NONE || row == LV_TABLE_CELL_NONE) {
+        uint32_t row_act = get_row_act(table);
+        if(col == LV_TABLE_CELL_NONE || row_act == ROW_NONE) {
             table->col_act = 0;
-            table->row_act = 0;
+            set_row_act(table, 0);
             lv_obj_invalidate(obj);
             return;
         }
 
+        int32_t row = row_act;
+        int32_t row_cnt = get_row_cnt(table);
         if(col >= table->col_cnt) col = 0;
-        if(row >= table->row_cnt) row = 0;
+        if(row >= row_cnt) row = 0;
 
         if(c == LV_KEY_LEFT) col--;
         else if(c == LV_KEY_RIGHT) col++;
@@ -530,7 +709,7 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
         else return;
 
         if(col >= table->col_cnt) {
-            if(row < table->row_cnt - 1) {
+            if(row < row_cnt - 1) {
                 col = 0;
                 row++;
             }
@@ -548,17 +727,20 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
             }
         }
 
-        if(row >= table->row_cnt) {
-            row = table->row_cnt - 1;
+        if(row >= row_cnt) {
+            row = row_cnt - 1;
         }
         else if(row < 0) {
             row = 0;
         }
 
-        if(table->col_act != col || table->row_act != row) {
+        if(table->col_act != col || row_act != (uint32_t)row) {
             table->col_act = col;
-            table->row_act = row;
+            set_row_act(table, row);
             lv_obj_invalidate(obj);
+#if LV_TABLE_VIRTUAL
+            if(table->virt) virt_scroll_to_visible(obj, row);
+#endif
 
             res = lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
             if(res != LV_RES_OK) return;
@@ -567,6 +749,11 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
     else if(code == LV_EVENT_DRAW_MAIN) {
         draw_main(e);
     }
+#if LV_TABLE_VIRTUAL
+    else if(code == LV_EVENT_SCROLL || code == LV_EVENT_SCROLL_END || code == LV_EVENT_SIZE_CHANGED) {
+        if(table->virt) virt_check_rebase(obj);
+    }
+#endif
 }
 
 
@@ -606,10 +793,29 @@ static void draw_main(lv_event_t * e)
     obj->skip_trans = 0;
 
     uint16_t col;
-    uint16_t row;
-    uint16_t cell = 0;
+    uint32_t row;
+    uint32_t cell = 0;
+    uint32_t row_start = 0;
+    uint32_t row_end = table->row_cnt;
+    uint32_t row_act = get_row_act(table);
+    bool virt = is_virtual(table);
 
     cell_area.y2 = obj->coords.y1 + bg_top - 1 - lv_obj_get_scroll_y(obj) + border_width;
+
+#if LV_TABLE_VIRTUAL
+    char virt_buf[LV_TABLE_VIRTUAL_CELL_BUF_SIZE];
+    if(virt) {
+        /*All rows have the same height so the rows above the clip area can be skipped directly*/
+        lv_coord_t row_h = table->virt->row_h;
+        row_start = table->virt->top_row;
+        row_end = row_start + virt_get_win_row_cnt(table);
+        if(clip_area.y1 > cell_area.y2 + 1) {
+            uint32_t skip = LV_MIN((uint32_t)(clip_area.y1 - cell_area.y2 - 1) / row_h, row_end - row_start);
+            row_start += skip;
+            cell_area.y2 += skip * row_h;
+        }
+    }
+#endif
     cell_area.x1 = 0;
     cell_area.x2 = 0;
     lv_coord_t scroll_x = lv_obj_get_scroll_x(obj) ;
@@ -624,8 +830,12 @@ static void draw_main(lv_event_t * e)
     part_draw_dsc.rect_dsc = &rect_dsc_act;
     part_draw_dsc.label_dsc = &label_dsc_act;
 
-    for(row = 0; row < table->row_cnt; row++) {
+    for(row = row_start; row < row_end; row++) {
+#if LV_TABLE_VIRTUAL
+        lv_coord_t h_row = virt ? table->virt->row_h : table->row_h[row];
+#else
         lv_coord_t h_row = table->row_h[row];
+#endif
 
         cell_area.y1 = cell_area.y2 + 1;
         cell_area.y2 = cell_area.y1 + h_row - 1;
@@ -636,8 +846,10 @@ static void draw_main(lv_event_t * e)
         else cell_area.x2 = obj->coords.x1 + bg_left - 1 - scroll_x + border_width;
 
         for(col = 0; col < table->col_cnt; col++) {
+            /*The cells of virtual tables are always cropped and never merged*/
             lv_table_cell_ctrl_t ctrl = 0;
-            if(table->cell_data[cell]) ctrl = table->cell_data[cell][0];
+            if(virt) ctrl = LV_TABLE_CELL_CTRL_TEXT_CROP;
+            else if(table->cell_data[cell]) ctrl = table->cell_data[cell][0];
 
             if(rtl) {
                 cell_area.x2 = cell_area.x1 - 1;
@@ -649,7 +861,7 @@ static void draw_main(lv_event_t * e)
             }
 
             uint16_t col_merge = 0;
-            for(col_merge = 0; col_merge + col < table->col_cnt - 1; col_merge++) {
+            for(col_merge = 0; !virt && col_merge + col < table->col_cnt - 1; col_merge++) {
                 char * next_cell_data = table->cell_data[cell + col_merge];
 
                 if(is_cell_empty(next_cell_data)) break;
@@ -690,7 +902,7 @@ static void draw_main(lv_event_t * e)
             }
 
             lv_state_t cell_state = LV_STATE_DEFAULT;
-            if(row == table->row_act && col == table->col_act) {
+            if(row == row_act && col == table->col_act) {
                 if(!(obj->state & LV_STATE_SCROLLED) && (obj->state & LV_STATE_PRESSED)) cell_state |= LV_STATE_PRESSED;
                 if(obj->state & LV_STATE_FOCUSED) cell_state |= LV_STATE_FOCUSED;
                 if(obj->state & LV_STATE_FOCUS_KEY) cell_state |= LV_STATE_FOCUS_KEY;
@@ -720,7 +932,14 @@ static void draw_main(lv_event_t * e)
 
             lv_draw_rect(draw_ctx, &rect_dsc_act, &cell_area_border);
 
-            if(table->cell_data[cell]) {
+            const char * txt = NULL;
+#if LV_TABLE_VIRTUAL
+            if(virt) txt = table->virt->cb(obj, row, col, virt_buf, sizeof(virt_buf));
+            else
+#endif
+                if(table->cell_data[cell]) txt = table->cell_data[cell] + 1;
+
+            if(txt) {
                 const lv_coord_t cell_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
                 const lv_coord_t cell_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
                 const lv_coord_t cell_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
@@ -737,7 +956,7 @@ static void draw_main(lv_event_t * e)
                 bool crop = ctrl & LV_TABLE_CELL_CTRL_TEXT_CROP ? true : false;
                 if(crop) txt_flags = LV_TEXT_FLAG_EXPAND;
 
-                lv_txt_get_size(&txt_size, table->cell_data[cell] + 1, label_dsc_def.font,
+                lv_txt_get_size(&txt_size, txt, label_dsc_def.font,
                                 label_dsc_act.letter_space, label_dsc_act.line_space,
                                 lv_area_get_width(&txt_area), txt_flags);
 
@@ -752,7 +971,7 @@ static void draw_main(lv_event_t * e)
                 label_mask_ok = _lv_area_intersect(&label_clip_area, &clip_area, &cell_area);
                 if(label_mask_ok) {
                     draw_ctx->clip_area = &label_clip_area;
-                    lv_draw_label(draw_ctx, &label_dsc_act, &txt_area, table->cell_data[cell] + 1, NULL);
+                    lv_draw_label(draw_ctx, &label_dsc_act, &txt_area, txt, NULL);
                     draw_ctx->clip_area = &clip_area;
                 }
             }
@@ -770,6 +989,15 @@ static void draw_main(lv_event_t * e)
 /* Refreshes size of the table starting from @start_row row */
 static void refr_size_form_row(lv_obj_t * obj, uint32_t start_row)
 {
+#if LV_TABLE_VIRTUAL
+    if(((lv_table_t *)obj)->virt) {
+        virt_refr_row_h(obj);
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+        return;
+    }
+#endif
+
     const lv_coord_t cell_pad_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
     const lv_coord_t cell_pad_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
     const lv_coord_t cell_pad_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
@@ -894,7 +1122,7 @@ static lv_coord_t get_row_height(lv_obj_t * obj, uint16_t row_id, const lv_font_
     return h_max;
 }
 
-static lv_res_t get_pressed_cell(lv_obj_t * obj, uint16_t * row, uint16_t * col)
+static lv_res_t get_pressed_cell(lv_obj_t * obj, uint32_t * row, uint16_t * col)
 {
     lv_table_t * table = (lv_table_t *)obj;
 
@@ -933,6 +1161,18 @@ static lv_res_t get_pressed_cell(lv_obj_t * obj, uint16_t * row, uint16_t * col)
         y -= obj->coords.y1;
         y -= lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
 
+#if LV_TABLE_VIRTUAL
+        if(table->virt) {
+            *row = table->virt->top_row + (y > 0 ? y / table->virt->row_h : 0);
+            /*Pressed below the last row*/
+            if(*row >= table->virt->row_cnt) {
+                *row = LV_TABLE_CELL_NONE;
+                return LV_RES_INV;
+            }
+            return LV_RES_OK;
+        }
+#endif
+
         *row = 0;
         tmp = 0;
 
@@ -1006,4 +1246,132 @@ static void get_cell_area(lv_obj_t * obj, uint16_t row, uint16_t col, lv_area_t
 
 }
 
+static uint32_t get_row_cnt(lv_table_t * table)
+{
+#if LV_TABLE_VIRTUAL
+    if(table->virt) return table->virt->row_cnt;
+#endif
+    return table->row_cnt;
+}
+
+/*Get the selected row independently of the mode. `ROW_NONE` if there is no selected row.*/
+static uint32_t get_row_act(lv_table_t * table)
+{
+#if LV_TABLE_VIRTUAL
+    if(table->virt) return table->virt->row_act;
+#endif
+    return table->row_act == LV_TABLE_CELL_NONE ? ROW_NONE : table->row_act;
+}
+
+static void set_row_act(lv_table_t * table, uint32_t row)
+{
+#if LV_TABLE_VIRTUAL
+    if(table->virt) {
+        table->virt->row_act = row;
+        return;
+    }
+#endif
+    table->row_act = row == ROW_NONE ? LV_TABLE_CELL_NONE : row;
+}
+
+#if LV_TABLE_VIRTUAL
+
+/*The height of the rows is estimated from a line of text as the texts are cropped anyway*/
+static void virt_refr_row_h(lv_obj_t * obj)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+
+    const lv_coord_t cell_pad_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
+    const lv_coord_t cell_pad_bottom = lv_obj_get_style_pad_bottom(obj, LV_PART_ITEMS);
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_ITEMS);
+    const lv_coord_t minh = lv_obj_get_style_min_height(obj, LV_PART_ITEMS);
+    const lv_coord_t maxh = lv_obj_get_style_max_height(obj, LV_PART_ITEMS);
+
+    lv_coord_t h = lv_font_get_line_height(font) + cell_pad_top + cell_pad_bottom;
+    table->virt->row_h = LV_MAX(LV_CLAMP(minh, h, maxh), 1);
+}
+
+/*Number of rows in the scrollable window*/
+static uint32_t virt_get_win_row_cnt(lv_table_t * table)
+{
+    uint32_t max_cnt = LV_MAX(VIRTUAL_WIN_H / table->virt->row_h, 1);
+    return LV_MIN(table->virt->row_cnt, max_cnt);
+}
+
+/*Move the window of scrollable rows and scroll by the same amount to keep the visible rows in place*/
+static void virt_set_top_row(lv_obj_t * obj, uint32_t top_row)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+    lv_table_virtual_t * virt = table->virt;
+
+    uint32_t max_top_row = virt->row_cnt - virt_get_win_row_cnt(table);
+    if(top_row > max_top_row) top_row = max_top_row;
+    if(top_row == virt->top_row) return;
+
+    int32_t diff = ((int32_t)virt->top_row - (int32_t)top_row) * virt->row_h;
+    virt->top_row = top_row;
+
+    /*The old rows are not in the window anymore (e.g. many rows were removed)*/
+    if(LV_ABS(diff) > VIRTUAL_WIN_H) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    virt->rebasing = 1;
+    _lv_obj_scroll_by_raw(obj, 0, -diff);
+    virt->rebasing = 0;
+}
+
+static void virt_check_rebase(lv_obj_t * obj)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+    lv_table_virtual_t * virt = table->virt;
+    if(virt->rebasing) return;
+
+    /*The scroll animations use absolute positions so don't move the window under them*/
+    if(lv_anim_get(obj, NULL)) return;
+
+    uint32_t win_row_cnt = virt_get_win_row_cnt(table);
+    if(win_row_cnt >= virt->row_cnt) return;
+
+    lv_coord_t win_h = win_row_cnt * virt->row_h;
+    lv_coord_t scroll_y = lv_obj_get_scroll_y(obj);
+    lv_coord_t view_h = lv_obj_get_content_height(obj);
+    bool near_top = virt->top_row > 0 && scroll_y < win_h / 4;
+    bool near_bottom = virt->top_row + win_row_cnt < virt->row_cnt && scroll_y + view_h > win_h - win_h / 4;
+    if(!near_top && !near_bottom) return;
+
+    /*Move the window to have the visible rows in its middle*/
+    uint32_t first_row = virt->top_row + LV_MAX(scroll_y, 0) / virt->row_h;
+    uint32_t view_row_cnt = LV_MIN((uint32_t)(view_h / virt->row_h), win_row_cnt);
+    uint32_t margin = (win_row_cnt - view_row_cnt) / 2;
+    virt_set_top_row(obj, first_row > margin ? first_row - margin : 0);
+}
+
+static void virt_scroll_to_visible(lv_obj_t * obj, uint32_t row)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+    lv_table_virtual_t * virt = table->virt;
+
+    lv_coord_t view_h = lv_obj_get_content_height(obj);
+    uint32_t view_row_cnt = LV_MAX(view_h / virt->row_h, 1);
+    lv_coord_t scroll_y = lv_obj_get_scroll_y(obj);
+    /*Row to show on the top to have `row` on the bottom*/
+    uint32_t bottom_top_row = row + 1 > view_row_cnt ? row + 1 - view_row_cnt : 0;
+
+    if(row < virt->top_row) {
+        lv_table_scroll_to_row(obj, row, LV_ANIM_OFF);
+    }
+    else if(row >= virt->top_row + virt_get_win_row_cnt(table)) {
+        lv_table_scroll_to_row(obj, bottom_top_row, LV_ANIM_OFF);
+    }
+    else {
+        lv_coord_t y = (row - virt->top_row) * virt->row_h;
+        if(y < scroll_y) lv_table_scroll_to_row(obj, row, LV_ANIM_OFF);
+        else if(y + virt->row_h > scroll_y + view_h) lv_table_scroll_to_row(obj, bottom_top_row, LV_ANIM_OFF);
+    }
+}
+
+#endif /*LV_TABLE_VIRTUAL*/
+
 #endif
@@ -29,6 +29,11 @@ extern "C" {
 #define LV_TABLE_CELL_NONE 0XFFFF
 LV_EXPORT_CONST_INT(LV_TABLE_CELL_NONE);
 
+#if LV_TABLE_VIRTUAL
+#define LV_TABLE_VIRTUAL_ROW_NONE 0xFFFFFFFF
+#define LV_TABLE_VIRTUAL_CELL_BUF_SIZE 128
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -44,6 +49,30 @@ enum {
 
 typedef uint8_t  lv_table_cell_ctrl_t;
 
+#if LV_TABLE_VIRTUAL
+/**
+ * Get the text of a cell of a virtual table.
+ * @param obj       pointer to the table
+ * @param row       id of the row [0 .. virtual row count - 1]
+ * @param col       id of the column [0 .. col_cnt - 1]
+ * @param buf       a buffer which can be used to print the text
+ * @param buf_size  size of `buf` in bytes
+ * @return          the text of the cell. `buf` or any other string which is valid until the next call.
+ */
+typedef const char * (*lv_table_virtual_cb_t)(lv_obj_t * obj, uint32_t row, uint16_t col, char * buf,
+                                                uint32_t buf_size);
+
+/*Data of a virtual table. Allocated only if the virtual mode is enabled.*/
+typedef struct {
+    lv_table_virtual_cb_t cb;
+    uint32_t row_cnt;
+    uint32_t top_row;       /*Index of the row at the top of the scrollable area*/
+    uint32_t row_act;
+    lv_coord_t row_h;       /*Every row has the same height*/
+    uint8_t rebasing : 1;
+} lv_table_virtual_t;
+#endif
+
 /*Data of table*/
 typedef struct {
     lv_obj_t obj;
@@ -54,6 +83,9 @@ typedef struct {
     lv_coord_t * col_w;
     uint16_t col_act;
     uint16_t row_act;
+#if LV_TABLE_VIRTUAL
+    lv_table_virtual_t * virt;
+#endif
 } lv_table_t;
 
 extern const lv_obj_class_t lv_table_class;
@@ -143,6 +175,34 @@ void lv_table_add_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_table
  */
 void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_table_cell_ctrl_t ctrl);
 
+#if LV_TABLE_VIRTUAL
+/**
+ * Make the table virtual: the cells are not stored but asked from a callback when they are drawn.
+ * Only the visible rows are processed so the table can have millions of rows.
+ * @param obj       pointer to a Table object
+ * @param row_cnt   number of rows
+ * @param cb        function to get the text of a cell, or `NULL` to switch back to normal mode with 1 empty row
+ * @note            All rows have the same height (one line of text) and the texts are cropped.
+ *                  The cell values and controls of the normal mode are not used.
+ */
+void lv_table_set_virtual(lv_obj_t * obj, uint32_t row_cnt, lv_table_virtual_cb_t cb);
+
+/**
+ * Set the number of rows of a virtual table. E.g. when new records are added to the data source.
+ * @param obj       pointer to a virtual Table object
+ * @param row_cnt   number of rows
+ */
+void lv_table_set_virtual_row_cnt(lv_obj_t * obj, uint32_t row_cnt);
+#endif
+
+/**
+ * Scroll the table to show a row on the top.
+ * @param obj       pointer to a Table object
+ * @param row       id of the row. In virtual tables [0 .. virtual row count - 1], else [0 .. row_cnt -1]
+ * @param anim_en   LV_ANIM_ON: scroll with animation
+ */
+void lv_table_scroll_to_row(lv_obj_t * obj, uint32_t row, lv_anim_enable_t anim_en);
+
 /*=====================
  * Getter functions
  *====================*/
@@ -196,6 +256,22 @@ bool lv_table_has_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_table
  */
 void lv_table_get_selected_cell(lv_obj_t * obj, uint16_t * row, uint16_t * col);
 
+#if LV_TABLE_VIRTUAL
+/**
+ * Get the number of rows of a virtual table.
+ * @param obj       pointer to a Table object
+ * @return          number of rows or 0 if the table is not virtual
+ */
+uint32_t lv_table_get_virtual_row_cnt(lv_obj_t * obj);
+
+/**
+ * Get the selected row of a virtual table.
+ * @param obj       pointer to a Table object
+ * @return          id of the selected row or `LV_TABLE_VIRTUAL_ROW_NONE` if no row is selected
+ */
+uint32_t lv_table_get_virtual_selected_row(lv_obj_t * obj);
+#endif
+
 /**********************
  *      MACROS
  **********************/
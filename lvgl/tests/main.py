@@ -3,6 +3,7 @@
 import argparse
 import errno
 import glob
+import json
 import shutil
 import subprocess
 import sys
@@ -24,14 +25,37 @@ test_options = {
     'OPTIONS_TEST_DEFHEAP': 'Test config, LVGL heap, 32 bit color depth',
 }
 
+perf_options = {
+    'OPTIONS_PERF': 'Test config, LVGL heap, performance suite',
+}
+
+perf_baseline_file = os.path.join(lvgl_test_dir, 'perf_baseline.json')
+
+# Metrics compared with the baseline. The deterministic ones depend only on
+# the code, the timing ones also on the machine and its load. The timing ones
+# are medians as the means are skewed by a few slow frames. The wall clock
+# time of a baseline from an other machine is meaningless, so it's only
+# printed unless --perf-time-gate is given.
+perf_deterministic_metrics = ['px_per_frame', 'mem_peak', 'create_allocs',
+                              'frame_allocs']
+perf_timing_metrics = ['frame_time_us.p50']
+
+# The cycles of the thread counted by the kernel. The time stamp counter
+# measures the wall clock time like the frame time, so it's not compared.
+perf_cycle_metric = 'frame_cycles.p50'
+perf_cycle_source = 'perf_event'
+
 
 def is_valid_option_name(option_name):
-    return option_name in build_only_options or option_name in test_options
+    return (option_name in build_only_options or option_name in test_options
+            or option_name in perf_options)
 
 
 def get_option_description(option_name):
     if option_name in build_only_options:
         return build_only_options[option_name]
+    if option_name in perf_options:
+        return perf_options[option_name]
     return test_options[option_name]
 
 
@@ -126,6 +150,101 @@ def run_tests(options_name):
         ['ctest', '--timeout', '30', '--parallel', str(os.cpu_count()), '--output-on-failure'])
 
 
+def get_perf_metric(scene, metric):
+    '''Get a metric like "frame_time_us.p50" of a scene or None if missing.'''
+    value = scene
+    for key in metric.split('.'):
+        if not isinstance(value, dict) or key not in value:
+            return None
+        value = value[key]
+    return value
+
+
+def compare_perf(results, baseline, threshold, time_threshold, time_gate):
+    '''Compare the perf results with the baseline.
+
+    Return the list of regressions exceeding the thresholds (in percent).
+    The timing metrics are only printed if time_gate is False.'''
+    metrics = [(m, threshold) for m in perf_deterministic_metrics]
+    metrics += [(m, time_threshold if time_gate else None)
+                for m in perf_timing_metrics]
+    if (results.get('cycle_source') == perf_cycle_source
+            and baseline.get('cycle_source') == perf_cycle_source):
+        metrics.append((perf_cycle_metric, time_threshold))
+    else:
+        print('Cycles are compared only if both the results and the baseline '
+              'are measured with %s (%s vs %s)' % (perf_cycle_source,
+                                                   results.get('cycle_source'),
+                                                   baseline.get('cycle_source')))
+
+    base_scenes = {s['name']: s for s in baseline['scenes']}
+    regressions = []
+    print('%-12s %-22s %14s %14s %8s' % ('scene', 'metric', 'baseline',
+                                        'current', 'change'))
+    for scene in results['scenes']:
+        base = base_scenes.get(scene['name'])
+        if base is None:
+            print('%-12s not in the baseline' % scene['name'])
+            continue
+        for metric, limit in metrics:
+            old = get_perf_metric(base, metric)
+            new = get_perf_metric(scene, metric)
+            if old is None or new is None:
+                continue
+            if old > 0:
+                change = (new - old) * 100.0 / old
+            else:
+                change = 0.0 if new == old else float('inf')
+            mark = ''
+            if limit is None:
+                mark = ' (not gated)'
+            elif change > limit:
+                mark = ' <-- regression (limit %g%%)' % limit
+                regressions.append((scene['name'], metric, old, new, change))
+            print('%-12s %-22s %14g %14g %+7.1f%%%s' % (scene['name'], metric,
+                  old, new, change, mark))
+    return regressions
+
+
+def run_perf(options_name, frames, threshold, time_threshold, time_gate,
+             update_baseline):
+    '''Run the performance suite and compare it with the baseline.
+
+    Return the number of regressions.'''
+
+    print()
+    print()
+    label = 'Running performance suite for %s' % options_abbrev(options_name)
+    print('=' * len(label))
+    print(label)
+    print('=' * len(label), flush=True)
+
+    build_dir = get_build_dir(options_name)
+    results_file = os.path.join(build_dir, 'perf_results.json')
+    os.chdir(lvgl_test_dir)
+    subprocess.check_call([os.path.join(build_dir, 'lv_test_perf'),
+                           '-n', str(frames), '-o', results_file])
+    with open(results_file) as f:
+        results = json.load(f)
+    print('Results: %s' % results_file)
+
+    if update_baseline or not os.path.exists(perf_baseline_file):
+        shutil.copyfile(results_file, perf_baseline_file)
+        print('Baseline updated: %s' % perf_baseline_file, flush=True)
+        return 0
+
+    with open(perf_baseline_file) as f:
+        baseline = json.load(f)
+    regressions = compare_perf(results, baseline, threshold, time_threshold,
+                               time_gate)
+    if regressions:
+        print('%d regression(s) compared to %s' % (len(regressions),
+              perf_baseline_file), flush=True)
+    else:
+        print('No regression compared to %s' % perf_baseline_file, flush=True)
+    return len(regressions)
+
+
 def generate_code_coverage_report():
     '''Produce code coverage test reports for the test execution.'''
     global lvgl_test_dir
@@ -159,7 +278,9 @@ if __name__ == "__main__":
     There are two types of LVGL tests: "build", and "test". The build-only
     tests, as their name suggests, only verify that the program successfully
     compiles and links (with various build options). There are also a set of
-    tests that execute to verify correct LVGL library behavior.
+    tests that execute to verify correct LVGL library behavior. The "perf"
+    action builds and runs the performance suite and compares its results
+    with perf_baseline.json.
     '''
     parser = argparse.ArgumentParser(
         description='Build and/or run LVGL tests.', epilog=epilog)
@@ -171,8 +292,21 @@ if __name__ == "__main__":
                         help='clean existing build artifacts before operation.')
     parser.add_argument('--report', action='store_true',
                         help='generate code coverage report for tests.')
-    parser.add_argument('actions', nargs='*', choices=['build', 'test'],
-                        help='build: compile build tests, test: compile/run executable tests.')
+    parser.add_argument('--perf-frames', type=int, default=100,
+                        help='number of measured frames per scene of the performance suite.')
+    parser.add_argument('--perf-threshold', type=float, default=5,
+                        help='''allowed increase of the deterministic perf metrics
+                        (pixels, memory, allocations) in percent.''')
+    parser.add_argument('--perf-time-threshold', type=float, default=25,
+                        help='allowed increase of the cycles and frame times in percent.')
+    parser.add_argument('--perf-time-gate', action='store_true', default=False,
+                        help='''fail on frame time regressions too. Use it only
+                        with a baseline recorded on the same machine.''')
+    parser.add_argument('--update-baseline', action='store_true', default=False,
+                        help='save the perf results as the new baseline instead of comparing.')
+    parser.add_argument('actions', nargs='*', choices=['build', 'test', 'perf'],
+                        help='''build: compile build tests, test: compile/run executable tests,
+                        perf: compile/run the performance suite.''')
 
     args = parser.parse_args()
 
@@ -184,8 +318,12 @@ if __name__ == "__main__":
                 options_to_build = {**build_only_options, **test_options}
             else:
                 options_to_build = build_only_options
+        elif 'perf' in args.actions and 'test' not in args.actions:
+            options_to_build = {}
         else:
             options_to_build = test_options
+        if 'perf' in args.actions:
+            options_to_build = {**options_to_build, **perf_options}
 
     for opt in options_to_build:
         if not is_valid_option_name(opt):
@@ -194,15 +332,29 @@ if __name__ == "__main__":
 
     generate_test_runners()
 
+    perf_regressions = 0
     for options_name in options_to_build:
         is_test = options_name in test_options
-        build_type = 'Debug'
+        is_perf = options_name in perf_options
+        build_type = 'Release' if is_perf else 'Debug'
         build_tests(options_name, build_type, args.clean)
         if is_test:
             try:
                 run_tests(options_name)
             except subprocess.CalledProcessError as e:
                 sys.exit(e.returncode)
+        if is_perf:
+            try:
+                perf_regressions += run_perf(options_name, args.perf_frames,
+                                             args.perf_threshold,
+                                             args.perf_time_threshold,
+                                             args.perf_time_gate,
+                                             args.update_baseline)
+            except subprocess.CalledProcessError as e:
+                sys.exit(e.returncode)
 
     if args.report:
         generate_code_coverage_report()
+
+    if perf_regressions:
+        sys.exit(1)
@@ -0,0 +1,337 @@
+/**
+ * @file lv_test_perf.c
+ * Render the scenes of `lv_test_perf_scenes.c` on the virtual display of the tests
+ * and print their performance metrics as JSON.
+ *
+ * Usage: lv_test_perf [-n frames] [-s scene] [-o output.json]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#if LV_BUILD_TEST
+#include "lv_test_perf.h"
+#include "../lv_test_init.h"
+#include "../../../src/misc/lv_malloc_builtin.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define DEF_FRAME_CNT   100
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    CYCLE_SRC_NONE,
+    CYCLE_SRC_PERF_EVENT,   /*CPU cycles of the thread counted by the kernel*/
+    CYCLE_SRC_TSC,          /*Time stamp counter: wall clock time in reference cycles*/
+} cycle_src_t;
+
+typedef struct {
+    const char * name;
+    uint32_t frame_cnt;
+    uint64_t cycles;
+    double cycles_p50;
+    double cycles_p90;
+    double cpu_time_us;
+    double frame_us_p50;
+    double frame_us_p90;
+    double frame_us_p99;
+    double frame_us_max;
+    uint64_t px;
+    uint32_t mem_peak;
+    uint32_t create_allocs;
+    uint32_t frame_allocs;
+} scene_res_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void cycles_init(void);
+static uint64_t cycles_get(void);
+static double time_us(clockid_t clk);
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px);
+static void run_scene(const lv_test_perf_scene_t * scene, uint32_t frame_cnt, scene_res_t * res);
+static int cmp_double(const void * a, const void * b);
+static void write_json(FILE * f, const scene_res_t * res, uint32_t res_cnt, uint32_t frame_cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static cycle_src_t cycle_src;
+#ifdef __linux__
+static int perf_fd = -1;
+#endif
+static uint64_t px_cnt;
+static uint32_t alloc_cnt;
+
+static const char * cycle_src_names[] = {"none", "perf_event", "tsc"};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/*The executable is linked with `--wrap` to count the allocations of LVGL*/
+void * __real_lv_malloc(size_t size);
+void * __real_lv_realloc(void * data_p, size_t new_size);
+
+void * __wrap_lv_malloc(size_t size)
+{
+    alloc_cnt++;
+    return __real_lv_malloc(size);
+}
+
+void * __wrap_lv_realloc(void * data_p, size_t new_size)
+{
+    alloc_cnt++;
+    return __real_lv_realloc(data_p, new_size);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t frame_cnt = DEF_FRAME_CNT;
+    const char * scene_name = NULL;
+    const char * out_path = NULL;
+
+    int a;
+    for(a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "-n") == 0 && a + 1 < argc) frame_cnt = (uint32_t)atoi(argv[++a]);
+        else if(strcmp(argv[a], "-s") == 0 && a + 1 < argc) scene_name = argv[++a];
+        else if(strcmp(argv[a], "-o") == 0 && a + 1 < argc) out_path = argv[++a];
+        else {
+            fprintf(stderr, "Usage: %s [-n frames] [-s scene] [-o output.json]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(frame_cnt == 0) frame_cnt = 1;
+
+    lv_test_init();
+    lv_disp_get_default()->driver->monitor_cb = monitor_cb;
+    cycles_init();
+
+    scene_res_t * res = calloc(lv_test_perf_scene_cnt, sizeof(scene_res_t));
+    uint32_t res_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < lv_test_perf_scene_cnt; i++) {
+        if(scene_name && strcmp(scene_name, lv_test_perf_scenes[i].name) != 0) continue;
+        run_scene(&lv_test_perf_scenes[i], frame_cnt, &res[res_cnt]);
+        res_cnt++;
+    }
+
+    if(res_cnt == 0) {
+        fprintf(stderr, "Unknown scene: %s\n", scene_name);
+        free(res);
+        return 1;
+    }
+
+    FILE * f = stdout;
+    if(out_path) {
+        f = fopen(out_path, "w");
+        if(f == NULL) {
+            fprintf(stderr, "Couldn't open %s\n", out_path);
+            free(res);
+            return 1;
+        }
+    }
+    write_json(f, res, res_cnt, frame_cnt);
+    if(f != stdout) fclose(f);
+
+    free(res);
+    lv_test_deinit();
+    return 0;
+}
+
+/*The perf executable doesn't run Unity tests but `lv_test_init.c` references Unity*/
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void cycles_init(void)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if(perf_fd >= 0) {
+        ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+        cycle_src = CYCLE_SRC_PERF_EVENT;
+        return;
+    }
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+    cycle_src = CYCLE_SRC_TSC;
+#else
+    cycle_src = CYCLE_SRC_NONE;
+#endif
+}
+
+static uint64_t cycles_get(void)
+{
+#ifdef __linux__
+    if(cycle_src == CYCLE_SRC_PERF_EVENT) {
+        uint64_t v = 0;
+        if(read(perf_fd, &v, sizeof(v)) != sizeof(v)) return 0;
+        return v;
+    }
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+    if(cycle_src == CYCLE_SRC_TSC) return __rdtsc();
+#endif
+
+    return 0;
+}
+
+static double time_us(clockid_t clk)
+{
+    struct timespec ts;
+    clock_gettime(clk, &ts);
+    return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+}
+
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px)
+{
+    LV_UNUSED(disp_drv);
+    LV_UNUSED(time);
+    px_cnt += px;
+}
+
+static void run_scene(const lv_test_perf_scene_t * scene, uint32_t frame_cnt, scene_res_t * res)
+{
+    lv_obj_t * def_scr = lv_scr_act();
+    double * frame_us = malloc(frame_cnt * sizeof(double));
+    double * frame_cycles = malloc(frame_cnt * sizeof(double));
+
+    res->name = scene->name;
+    res->frame_cnt = frame_cnt;
+
+    /*Create and render the first frame. It's not measured as it fills the caches.*/
+#if LV_USE_BUILTIN_MALLOC
+    lv_mem_reset_max_used_builtin();
+#endif
+    alloc_cnt = 0;
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_scr_load(scr);
+    scene->create(scr);
+    lv_tick_inc(LV_DEF_REFR_PERIOD);
+    lv_timer_handler();
+    res->create_allocs = alloc_cnt;
+
+    alloc_cnt = 0;
+    px_cnt = 0;
+    double cpu_start = time_us(CLOCK_PROCESS_CPUTIME_ID);
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        if(scene->frame) scene->frame(i);
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+
+        double t = time_us(CLOCK_MONOTONIC);
+        uint64_t c = cycles_get();
+        lv_timer_handler();
+        c = cycles_get() - c;
+        frame_us[i] = time_us(CLOCK_MONOTONIC) - t;
+        res->cycles += c;
+        frame_cycles[i] = (double)c;
+    }
+    res->cpu_time_us = time_us(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    res->frame_allocs = alloc_cnt;
+    res->px = px_cnt;
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    res->mem_peak = mon.max_used;
+
+    qsort(frame_us, frame_cnt, sizeof(double), cmp_double);
+    res->frame_us_p50 = frame_us[(frame_cnt - 1) * 50 / 100];
+    res->frame_us_p90 = frame_us[(frame_cnt - 1) * 90 / 100];
+    res->frame_us_p99 = frame_us[(frame_cnt - 1) * 99 / 100];
+    res->frame_us_max = frame_us[frame_cnt - 1];
+    free(frame_us);
+
+    /*The mean of the cycles is skewed by a few slow frames (e.g. preempted or migrated thread)*/
+    qsort(frame_cycles, frame_cnt, sizeof(double), cmp_double);
+    res->cycles_p50 = frame_cycles[(frame_cnt - 1) * 50 / 100];
+    res->cycles_p90 = frame_cycles[(frame_cnt - 1) * 90 / 100];
+    free(frame_cycles);
+
+    /*Clean up for the next scene*/
+    if(scene->del) scene->del();
+    lv_scr_load(def_scr);
+    lv_obj_del(scr);
+    lv_tick_inc(LV_DEF_REFR_PERIOD);
+    lv_timer_handler();
+}
+
+static int cmp_double(const void * a, const void * b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+static void write_json(FILE * f, const scene_res_t * res, uint32_t res_cnt, uint32_t frame_cnt)
+{
+    fprintf(f, "{\n");
+    fprintf(f, "  \"suite\": \"lvgl_perf\",\n");
+    fprintf(f, "  \"frames\": %"LV_PRIu32",\n", frame_cnt);
+    fprintf(f, "  \"cycle_source\": \"%s\",\n", cycle_src_names[cycle_src]);
+    fprintf(f, "  \"scenes\": [\n");
+
+    uint32_t i;
+    for(i = 0; i < res_cnt; i++) {
+        const scene_res_t * r = &res[i];
+        fprintf(f, "    {\n");
+        fprintf(f, "      \"name\": \"%s\",\n", r->name);
+        if(cycle_src == CYCLE_SRC_NONE) {
+            fprintf(f, "      \"cycles_per_frame\": null,\n");
+            fprintf(f, "      \"frame_cycles\": null,\n");
+        }
+        else {
+            fprintf(f, "      \"cycles_per_frame\": %.0f,\n", (double)r->cycles / r->frame_cnt);
+            fprintf(f, "      \"frame_cycles\": {\"p50\": %.0f, \"p90\": %.0f},\n", r->cycles_p50, r->cycles_p90);
+        }
+        fprintf(f, "      \"cpu_time_us_per_frame\": %.1f,\n", r->cpu_time_us / r->frame_cnt);
+        fprintf(f, "      \"frame_time_us\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f},\n",
+                r->frame_us_p50, r->frame_us_p90, r->frame_us_p99, r->frame_us_max);
+        fprintf(f, "      \"px_per_frame\": %.0f,\n", (double)r->px / r->frame_cnt);
+        fprintf(f, "      \"mem_peak\": %"LV_PRIu32",\n", r->mem_peak);
+        fprintf(f, "      \"create_allocs\": %"LV_PRIu32",\n", r->create_allocs);
+        fprintf(f, "      \"frame_allocs\": %"LV_PRIu32"\n", r->frame_allocs);
+        fprintf(f, "    }%s\n", i + 1 < res_cnt ? "," : "");
+    }
+
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+}
+
+#endif /*LV_BUILD_TEST*/
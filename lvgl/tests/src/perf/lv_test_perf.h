@@ -0,0 +1,45 @@
+/**
+ * @file lv_test_perf.h
+ *
+ */
+
+#ifndef LV_TEST_PERF_H
+#define LV_TEST_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A deterministic scene of the performance suite.
+ * It's created on an empty screen and rendered for a fixed number of frames.
+ * Between two frames the time advances by exactly `LV_DEF_REFR_PERIOD` milliseconds.
+ */
+typedef struct {
+    const char * name;
+    void (*create)(lv_obj_t * scr);     /*Create the widgets on `scr`*/
+    void (*frame)(uint32_t i);          /*Modify the scene before rendering the `i`th frame. Can be NULL.*/
+    void (*del)(void);                  /*Free what is not deleted with the screen (e.g. timers). Can be NULL.*/
+} lv_test_perf_scene_t;
+
+/**********************
+ * GLOBAL VARIABLES
+ **********************/
+
+extern const lv_test_perf_scene_t lv_test_perf_scenes[];
+extern const uint32_t lv_test_perf_scene_cnt;
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TEST_PERF_H*/
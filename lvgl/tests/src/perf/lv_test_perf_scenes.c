@@ -0,0 +1,401 @@
+/**
+ * @file lv_test_perf_scenes.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#if LV_BUILD_TEST
+#include "lv_test_perf.h"
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CARD_CNT        24
+#define CJK_LABEL_CNT   4
+#define CHART_POINT_CNT 2000
+#define CHART_STEP      20
+#define IMG_CNT         12
+#define ANIM_OBJ_CNT    200
+#define TIMER_CNT       1000
+#define TIMER_LABEL_CNT 20
+#define BLUR_W          400
+#define BLUR_H          240
+#define PINYIN_DICT     "/tmp/lv_test_perf_pinyin.txt"
+#define PINYIN_ENTRY_CNT 50000
+#define PINYIN_SYL_CNT  (sizeof(pinyin_syllables) / sizeof(pinyin_syllables[0]))
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void cards_create(lv_obj_t * scr);
+static void cards_frame(uint32_t i);
+#if LV_FONT_SIMSUN_16_CJK
+static void cjk_text_create(lv_obj_t * scr);
+static void cjk_text_frame(uint32_t i);
+#endif
+static void chart_create(lv_obj_t * scr);
+static void chart_frame(uint32_t i);
+static void img_rotate_create(lv_obj_t * scr);
+static void img_rotate_frame(uint32_t i);
+static void anims_create(lv_obj_t * scr);
+static void opa_anim_cb(void * var, int32_t v);
+static void timers_create(lv_obj_t * scr);
+static void timer_cb(lv_timer_t * t);
+static void timer_label_cb(lv_timer_t * t);
+static void timers_del(void);
+static void blur_create(lv_obj_t * scr);
+static void blur_frame(uint32_t i);
+#if LV_USE_IME_PINYIN
+static void pinyin_create(lv_obj_t * scr);
+static void pinyin_key_timer_cb(lv_timer_t * t);
+static void pinyin_del(void);
+#endif
+static lv_coord_t rnd(lv_coord_t max);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_test_perf_scene_t lv_test_perf_scenes[] = {
+    {"cards",      cards_create,      cards_frame,      NULL},
+#if LV_FONT_SIMSUN_16_CJK
+    {"cjk_text",   cjk_text_create,   cjk_text_frame,   NULL},
+#endif
+    {"chart",      chart_create,      chart_frame,      NULL},
+    {"img_rotate", img_rotate_create, img_rotate_frame, NULL},
+    {"anims",      anims_create,      NULL,             NULL},
+    {"timers",     timers_create,     NULL,             timers_del},
+    {"blur",       blur_create,       blur_frame,       NULL},
+#if LV_USE_IME_PINYIN
+    {"pinyin",     pinyin_create,     NULL,             pinyin_del},
+#endif
+};
+
+const uint32_t lv_test_perf_scene_cnt = sizeof(lv_test_perf_scenes) / sizeof(lv_test_perf_scenes[0]);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t rnd_seed;      /*Reset by the scenes using `rnd()` to not depend on the others*/
+static lv_obj_t * objs[LV_MAX(CARD_CNT, LV_MAX(CJK_LABEL_CNT, LV_MAX(IMG_CNT, TIMER_LABEL_CNT)))];
+static lv_obj_t * chart;
+static lv_chart_series_t * chart_ser[2];
+static lv_timer_t * timers[TIMER_CNT];
+static uint32_t timer_calls[TIMER_LABEL_CNT];
+static uint8_t blur_src[LV_CANVAS_BUF_SIZE_TRUE_COLOR(BLUR_W, BLUR_H)];
+static uint8_t blur_buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR(BLUR_W, BLUR_H)];
+static lv_timer_t * pinyin_timer;
+static uint32_t pinyin_step;
+
+static const char * pinyin_syllables[] = {
+    "a", "ai", "an", "ba", "bei", "bian", "chang", "chu", "da", "dian", "dong", "fa", "fen", "gao", "guo",
+    "hao", "hua", "ji", "jian", "kai", "lai", "li", "ma", "ming", "nian", "qi", "ren", "shang", "shi",
+    "shui", "tian", "wen", "xia", "xin", "yang", "yi", "you", "zhong", "zi", "zuo"
+};
+
+static const char * pinyin_inputs[] = {"zhongguo", "shuitian", "xinnian", "yiyang", "chudian", "bian", "renshi"};
+
+static const char * cjk_texts[] = {
+    "嵌入式控制的畫面可以使用很多控件、動畫效果和很低的內存。它可以在各種電子機械上運行，並且支持多種語言的文本。",
+    "熱感知每天更新很多次，系統根據當前的温度和光的強度自動控制風機和水的工作狀態，並把結果保存到本地。",
+    "你可以在設置畫面中選擇語言、時間和網絡。所有的修改都會立即生效，重新開機以後也會保留。",
+};
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*Card grid: shadows, gradients and labels on the whole screen which is redrawn in every frame*/
+static void cards_create(lv_obj_t * scr)
+{
+    rnd_seed = 1;
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(scr, 10, 0);
+    lv_obj_set_style_pad_gap(scr, 10, 0);
+
+    uint32_t i;
+    for(i = 0; i < CARD_CNT; i++) {
+        lv_obj_t * card = lv_obj_create(scr);
+        lv_obj_set_size(card, 180, 100);
+        lv_obj_set_style_radius(card, 12, 0);
+        lv_obj_set_style_shadow_width(card, 20, 0);
+        lv_obj_set_style_shadow_ofs_y(card, 5, 0);
+        lv_obj_set_style_bg_grad_color(card, lv_palette_lighten(LV_PALETTE_BLUE, 4), 0);
+        lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_VER, 0);
+
+        lv_obj_t * title = lv_label_create(card);
+        lv_label_set_text_fmt(title, "Sensor %d", (int)i);
+
+        objs[i] = lv_label_create(card);
+        lv_obj_align(objs[i], LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+        lv_label_set_text(objs[i], "0.0");
+    }
+}
+
+static void cards_frame(uint32_t i)
+{
+    lv_label_set_text_fmt(objs[i % CARD_CNT], "%d.%d", (int)rnd(100), (int)rnd(10));
+    lv_obj_invalidate(lv_scr_act());
+}
+
+#if LV_FONT_SIMSUN_16_CJK
+/*Long wrapped CJK paragraphs, one of them is replaced in every frame*/
+static void cjk_text_create(lv_obj_t * scr)
+{
+    uint32_t i;
+    for(i = 0; i < CJK_LABEL_CNT; i++) {
+        objs[i] = lv_label_create(scr);
+        lv_obj_set_style_text_font(objs[i], &lv_font_simsun_16_cjk, 0);
+        lv_obj_set_width(objs[i], 380);
+        lv_obj_set_pos(objs[i], (i % 2) * 400 + 10, (i / 2) * 240 + 10);
+        lv_label_set_text_static(objs[i], cjk_texts[i % 3]);
+    }
+}
+
+static void cjk_text_frame(uint32_t i)
+{
+    lv_label_set_text_static(objs[i % CJK_LABEL_CNT], cjk_texts[(i / CJK_LABEL_CNT + i) % 3]);
+}
+#endif
+
+/*Line chart with two long series scrolling by a few points in every frame*/
+static void chart_create(lv_obj_t * scr)
+{
+    rnd_seed = 1;
+    chart = lv_chart_create(scr);
+    lv_obj_set_size(chart, 760, 440);
+    lv_obj_center(chart);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(chart, CHART_POINT_CNT);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 1000);
+    lv_chart_set_div_line_count(chart, 5, 8);
+    lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR);
+
+    chart_ser[0] = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_RED), LV_CHART_AXIS_PRIMARY_Y);
+    chart_ser[1] = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_GREEN), LV_CHART_AXIS_PRIMARY_Y);
+
+    uint32_t i;
+    for(i = 0; i < CHART_POINT_CNT; i++) {
+        lv_chart_set_next_value(chart, chart_ser[0], rnd(1000));
+        lv_chart_set_next_value(chart, chart_ser[1], 300 + rnd(400));
+    }
+}
+
+static void chart_frame(uint32_t i)
+{
+    LV_UNUSED(i);
+    uint32_t j;
+    for(j = 0; j < CHART_STEP; j++) {
+        lv_chart_set_next_value(chart, chart_ser[0], rnd(1000));
+        lv_chart_set_next_value(chart, chart_ser[1], 300 + rnd(400));
+    }
+}
+
+/*Rotated and zoomed ARGB images with a new angle in every frame*/
+static void img_rotate_create(lv_obj_t * scr)
+{
+    LV_IMG_DECLARE(img_cogwheel_argb);
+
+    uint32_t i;
+    for(i = 0; i < IMG_CNT; i++) {
+        objs[i] = lv_img_create(scr);
+        lv_img_set_src(objs[i], &img_cogwheel_argb);
+        lv_obj_set_pos(objs[i], (i % 6) * 130 + 10, (i / 6) * 220 + 40);
+        if(i % 2) lv_img_set_zoom(objs[i], 200);
+    }
+}
+
+static void img_rotate_frame(uint32_t i)
+{
+    uint32_t j;
+    for(j = 0; j < IMG_CNT; j++) {
+        lv_img_set_angle(objs[j], (i * 35 + j * 300) % 3600);
+    }
+}
+
+/*Many small objects moved by independent animations*/
+static void anims_create(lv_obj_t * scr)
+{
+    uint32_t i;
+    for(i = 0; i < ANIM_OBJ_CNT; i++) {
+        lv_obj_t * obj = lv_obj_create(scr);
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_size(obj, 12, 12);
+        lv_obj_set_style_radius(obj, LV_RADIUS_CIRCLE, 0);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_main(i % 19), 0);
+        lv_obj_set_y(obj, (i * 7) % 460);
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, obj);
+        lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_x);
+        lv_anim_set_values(&a, 0, 780);
+        lv_anim_set_time(&a, 800 + (i * 37) % 1200);
+        lv_anim_set_playback_time(&a, 600 + (i * 53) % 900);
+        lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        lv_anim_set_path_cb(&a, i % 2 ? lv_anim_path_ease_in_out : lv_anim_path_overshoot);
+        lv_anim_start(&a);
+
+        if(i % 4 == 0) {
+            lv_anim_set_exec_cb(&a, opa_anim_cb);
+            lv_anim_set_values(&a, LV_OPA_20, LV_OPA_COVER);
+            lv_anim_set_path_cb(&a, lv_anim_path_linear);
+            lv_anim_start(&a);
+        }
+    }
+}
+
+static void opa_anim_cb(void * var, int32_t v)
+{
+    lv_obj_set_style_opa(var, (lv_opa_t)v, 0);
+}
+
+static void timer_cb(lv_timer_t * t)
+{
+    uint32_t id = (uint32_t)(uintptr_t)t->user_data;
+    timer_calls[id]++;
+}
+
+static void timer_label_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    uint32_t i;
+    for(i = 0; i < TIMER_LABEL_CNT; i++) {
+        lv_label_set_text_fmt(objs[i], "%"LV_PRIu32, timer_calls[i]);
+    }
+}
+
+/*Many timers with different periods and a few labels showing their state*/
+static void timers_create(lv_obj_t * scr)
+{
+    lv_memzero(timer_calls, sizeof(timer_calls));
+
+    uint32_t i;
+    for(i = 0; i < TIMER_LABEL_CNT; i++) {
+        objs[i] = lv_label_create(scr);
+        lv_obj_set_pos(objs[i], (i % 5) * 150 + 20, (i / 5) * 100 + 20);
+    }
+
+    for(i = 0; i < TIMER_CNT - 1; i++) {
+        timers[i] = lv_timer_create(timer_cb, 1 + (i * 7) % 50, (void *)(uintptr_t)(i % TIMER_LABEL_CNT));
+    }
+    timers[TIMER_CNT - 1] = lv_timer_create(timer_label_cb, 100, NULL);
+}
+
+static void timers_del(void)
+{
+    uint32_t i;
+    for(i = 0; i < TIMER_CNT; i++) {
+        lv_timer_del(timers[i]);
+    }
+}
+
+/*Frosted glass popup: the content behind it is blurred again in every frame*/
+static void blur_create(lv_obj_t * scr)
+{
+    rnd_seed = 1;
+    objs[0] = lv_canvas_create(scr);
+    lv_canvas_set_buffer(objs[0], blur_buf, BLUR_W, BLUR_H, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_center(objs[0]);
+    lv_canvas_fill_bg(objs[0], lv_palette_lighten(LV_PALETTE_GREY, 3), LV_OPA_COVER);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.radius = 8;
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_coord_t x = (lv_coord_t)((i % 4) * 100 + 5);
+        lv_coord_t y = (lv_coord_t)((i / 4) * 80 + 5);
+        rect_dsc.bg_color = lv_palette_main(rnd(19));
+        lv_canvas_draw_rect(objs[0], x, y, 90, 70, &rect_dsc);
+        lv_canvas_draw_text(objs[0], x + 10, y + 25, 80, &label_dsc, "Sensor");
+    }
+    lv_memcpy(blur_src, blur_buf, sizeof(blur_buf));
+}
+
+static void blur_frame(uint32_t i)
+{
+    LV_UNUSED(i);
+    lv_memcpy(blur_buf, blur_src, sizeof(blur_buf));
+    lv_canvas_blur(objs[0], NULL, 8);
+}
+
+#if LV_USE_IME_PINYIN
+/*Typing and deleting pinyin with a large dictionary file: one key is pressed in every frame
+ *so the time of the candidate search is measured with the rendering of the candidates*/
+static void pinyin_create(lv_obj_t * scr)
+{
+    FILE * f = fopen(PINYIN_DICT, "wb");
+    if(f == NULL) return;
+    uint32_t i;
+    for(i = 0; i < PINYIN_ENTRY_CNT; i++) {
+        fprintf(f, "%s%s%s 词%"LV_PRIu32" %"LV_PRIu32"\n", pinyin_syllables[i % PINYIN_SYL_CNT],
+                pinyin_syllables[(i / PINYIN_SYL_CNT) % PINYIN_SYL_CNT],
+                pinyin_syllables[(i * 7 / (PINYIN_SYL_CNT * PINYIN_SYL_CNT)) % PINYIN_SYL_CNT],
+                i, i * 2654435761u);
+    }
+    fclose(f);
+
+    lv_obj_t * ime = lv_ime_pinyin_create(scr);
+    objs[0] = lv_keyboard_create(scr);
+    lv_obj_t * ta = lv_textarea_create(scr);
+    lv_obj_align(ta, LV_ALIGN_TOP_MID, 0, 10);
+    lv_ime_pinyin_set_keyboard(ime, objs[0]);
+    lv_ime_pinyin_set_dict_file(ime, "C:" PINYIN_DICT);
+#if LV_FONT_SIMSUN_16_CJK
+    lv_obj_set_style_text_font(lv_ime_pinyin_get_cand_panel(ime), &lv_font_simsun_16_cjk, 0);
+#endif
+    lv_keyboard_set_textarea(objs[0], ta);
+
+    pinyin_step = 0;
+    pinyin_timer = lv_timer_create(pinyin_key_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+}
+
+/*Type the letters of an input and delete them again. Called in the measured `lv_timer_handler()`.*/
+static void pinyin_key_timer_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+
+    uint32_t step = pinyin_step;
+    uint32_t k = 0;
+    while(step >= 2 * strlen(pinyin_inputs[k])) {
+        step -= 2 * strlen(pinyin_inputs[k]);
+        k = (k + 1) % (sizeof(pinyin_inputs) / sizeof(pinyin_inputs[0]));
+    }
+    pinyin_step++;
+
+    const char * py = pinyin_inputs[k];
+    char key[2] = {py[step < strlen(py) ? step : 0], '\0'};
+    const char * key_txt = step < strlen(py) ? key : LV_SYMBOL_BACKSPACE;
+
+    uint16_t i;
+    for(i = 0; lv_btnmatrix_get_btn_text(objs[0], i); i++) {
+        if(strcmp(lv_btnmatrix_get_btn_text(objs[0], i), key_txt) == 0) {
+            lv_btnmatrix_set_selected_btn(objs[0], i);
+            lv_event_send(objs[0], LV_EVENT_VALUE_CHANGED, NULL);
+            return;
+        }
+    }
+}
+
+static void pinyin_del(void)
+{
+    lv_timer_del(pinyin_timer);
+    remove(PINYIN_DICT);
+}
+#endif
+
+/*Deterministic pseudo random number in [0, max)*/
+static lv_coord_t rnd(lv_coord_t max)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (lv_coord_t)((rnd_seed >> 16) % (uint32_t)max);
+}
+
+#endif /*LV_BUILD_TEST*/
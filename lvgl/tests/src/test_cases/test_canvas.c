@@ -0,0 +1,190 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+
+#define CANVAS_W    100
+#define CANVAS_H    80
+
+static lv_obj_t * canvas1;
+static lv_obj_t * canvas2;
+static uint8_t buf1[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(CANVAS_W, CANVAS_H)];
+static uint8_t buf2[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(CANVAS_W, CANVAS_H)];
+
+void setUp(void)
+{
+    canvas1 = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas1, buf1, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_canvas_fill_bg(canvas1, lv_color_white(), LV_OPA_COVER);
+
+    canvas2 = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas2, buf2, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_canvas_fill_bg(canvas2, lv_color_white(), LV_OPA_COVER);
+    lv_obj_set_pos(canvas2, 10, 20);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+/*Draw all kinds of primitives, some of them out of the canvas*/
+static void draw_scene(lv_obj_t * canvas)
+{
+    LV_IMG_DECLARE(img_caret_down);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE);
+    rect_dsc.radius = 5;
+    rect_dsc.shadow_width = 10;
+    rect_dsc.shadow_ofs_y = 3;
+    rect_dsc.border_width = 2;
+    lv_canvas_draw_rect(canvas, 10, 10, 40, 30, &rect_dsc);
+
+    rect_dsc.bg_opa = LV_OPA_50;
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_RED);
+    lv_canvas_draw_rect(canvas, 80, 60, 40, 40, &rect_dsc);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.color = lv_palette_main(LV_PALETTE_GREEN);
+    char txt[16];
+    strcpy(txt, "Canvas text");
+    lv_canvas_draw_text(canvas, 5, 45, 90, &label_dsc, txt);
+    strcpy(txt, "Changed");
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.width = 3;
+    lv_point_t points[] = {{0, 79}, {50, 60}, {99, 79}};
+    lv_canvas_draw_line(canvas, points, 3, &line_dsc);
+    points[1].y = 0;
+
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_ORANGE);
+    lv_point_t poly[] = {{60, 5}, {95, 10}, {70, 30}};
+    lv_canvas_draw_polygon(canvas, poly, 3, &rect_dsc);
+
+    lv_draw_arc_dsc_t arc_dsc;
+    lv_draw_arc_dsc_init(&arc_dsc);
+    arc_dsc.width = 4;
+    lv_canvas_draw_arc(canvas, 75, 50, 15, 0, 270, &arc_dsc);
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    img_dsc.angle = 300;
+    lv_canvas_draw_img(canvas, 30, 20, &img_caret_down, &img_dsc);
+}
+
+void test_canvas_batch_draws_the_same(void)
+{
+    draw_scene(canvas1);
+
+    static uint8_t buf_ori[sizeof(buf2)];
+    lv_memcpy(buf_ori, buf2, sizeof(buf2));
+    lv_canvas_batch_begin(canvas2);
+    draw_scene(canvas2);
+    /*Nothing is drawn until the end*/
+    TEST_ASSERT_EQUAL_MEMORY(buf_ori, buf2, sizeof(buf2));
+    lv_canvas_batch_end(canvas2);
+
+    TEST_ASSERT_EQUAL_MEMORY(buf1, buf2, sizeof(buf1));
+}
+
+void test_canvas_batch_skips_covered_primitives(void)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+
+    /*Cells of a heat map drawn many times and finally covered by other opaque cells*/
+    lv_canvas_batch_begin(canvas2);
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        rect_dsc.bg_color = lv_color_hsv_to_rgb(i, 100, 100);
+        rect_dsc.bg_opa = i % 3 ? LV_OPA_COVER : LV_OPA_50;
+        lv_canvas_draw_rect(canvas2, (i * 10) % CANVAS_W, (i / 10 * 10) % CANVAS_H, 10, 10, &rect_dsc);
+    }
+    lv_canvas_batch_end(canvas2);
+
+    /*The same drawn directly*/
+    for(i = 0; i < 200; i++) {
+        rect_dsc.bg_color = lv_color_hsv_to_rgb(i, 100, 100);
+        rect_dsc.bg_opa = i % 3 ? LV_OPA_COVER : LV_OPA_50;
+        lv_canvas_draw_rect(canvas1, (i * 10) % CANVAS_W, (i / 10 * 10) % CANVAS_H, 10, 10, &rect_dsc);
+    }
+
+    TEST_ASSERT_EQUAL_MEMORY(buf1, buf2, sizeof(buf1));
+}
+
+void test_canvas_batch_invalidates_only_the_touched_area(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_update_layout(canvas2);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    lv_canvas_batch_begin(canvas2);
+    lv_canvas_draw_rect(canvas2, 5, 5, 10, 10, &rect_dsc);
+    lv_canvas_draw_rect(canvas2, 20, 20, 5, 5, &rect_dsc);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+    lv_canvas_batch_end(canvas2);
+
+    lv_area_t touched;
+    lv_area_set(&touched, 10 + 5, 20 + 5, 10 + 24, 20 + 24);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&touched, &disp->inv_areas[0], 0));
+    TEST_ASSERT_LESS_THAN(lv_area_get_size(&canvas2->coords) / 4, lv_area_get_size(&disp->inv_areas[0]));
+    lv_refr_now(NULL);
+
+    /*Primitives out of the canvas don't invalidate anything*/
+    lv_canvas_draw_rect(canvas2, 200, 5, 10, 10, &rect_dsc);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+
+    /*A zoomed canvas is invalidated entirely*/
+    lv_img_set_zoom(canvas2, 512);
+    lv_refr_now(NULL);
+    lv_canvas_draw_rect(canvas2, 5, 5, 10, 10, &rect_dsc);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    lv_area_t obj_area;
+    lv_obj_get_coords(canvas2, &obj_area);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&obj_area, &disp->inv_areas[0], 0));
+}
+
+void test_canvas_batch_keeps_the_order_with_other_functions(void)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_color_black();
+
+    /*The queued rectangle is drawn before setting the pixel*/
+    lv_canvas_batch_begin(canvas2);
+    lv_canvas_draw_rect(canvas2, 0, 0, 10, 10, &rect_dsc);
+    lv_canvas_set_px_color(canvas2, 5, 5, lv_palette_main(LV_PALETTE_RED));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_color_black()), lv_color_to32(lv_canvas_get_px(canvas2, 4, 4)));
+    lv_canvas_draw_rect(canvas2, 20, 0, 10, 10, &rect_dsc);
+    lv_canvas_batch_end(canvas2);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_palette_main(LV_PALETTE_RED)),
+                            lv_color_to32(lv_canvas_get_px(canvas2, 5, 5)));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_color_black()), lv_color_to32(lv_canvas_get_px(canvas2, 25, 5)));
+
+    /*Filling the background drops the queued primitives*/
+    lv_canvas_batch_begin(canvas2);
+    lv_canvas_draw_rect(canvas2, 40, 0, 10, 10, &rect_dsc);
+    lv_canvas_fill_bg(canvas2, lv_color_white(), LV_OPA_COVER);
+    lv_canvas_batch_end(canvas2);
+    TEST_ASSERT_EQUAL_MEMORY(buf1, buf2, sizeof(buf1));
+
+    /*A canvas can be deleted during a batch*/
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_canvas_batch_begin(canvas2);
+    lv_canvas_draw_text(canvas2, 0, 0, 50, &label_dsc, "text");
+    lv_obj_del(canvas2);
+}
+
+#endif
@@ -0,0 +1,246 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+
+#define IMG_W   70
+#define IMG_H   50
+
+static uint8_t buf[IMG_W * IMG_H * 4];
+static uint8_t ref_buf[IMG_W * IMG_H * 4];
+static uint8_t tmp_buf[IMG_W * IMG_H * 4];
+static lv_img_dsc_t img;
+static uint32_t rnd_seed;
+
+void setUp(void)
+{
+    rnd_seed = 1;
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_filter_free_buf();
+}
+
+static uint8_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (uint8_t)(rnd_seed >> 16);
+}
+
+static void img_init(lv_img_cf_t cf)
+{
+    lv_memzero(&img, sizeof(img));
+    img.header.cf = cf;
+    img.header.w = IMG_W;
+    img.header.h = IMG_H;
+    img.data = buf;
+    img.data_size = lv_img_buf_get_img_size(IMG_W, IMG_H, cf);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(buf); i++) buf[i] = rnd();
+}
+
+/*Blur one direction of `ref_buf` in the simplest way*/
+static void ref_box_blur(const lv_area_t * area, uint32_t px_size, uint16_t r, bool hor)
+{
+    if(r <= 1) return;
+    lv_memcpy(tmp_buf, ref_buf, sizeof(ref_buf));
+
+    int32_t r_back = r / 2 - ((r & 0x1) == 0 ? 1 : 0);
+    int32_t r_front = r / 2;
+    uint32_t m = (65536 + r - 1) / r;
+    int32_t x, y, i;
+    uint32_t ch;
+    for(y = area->y1; y <= area->y2; y++) {
+        for(x = area->x1; x <= area->x2; x++) {
+            for(ch = 0; ch < px_size; ch++) {
+                uint32_t sum = 0;
+                for(i = -r_back; i <= r_front; i++) {
+                    int32_t sx = hor ? LV_CLAMP(0, x + i, IMG_W - 1) : x;
+                    int32_t sy = hor ? y : LV_CLAMP(0, y + i, IMG_H - 1);
+                    sum += tmp_buf[(sy * IMG_W + sx) * px_size + ch];
+                }
+                ref_buf[(y * IMG_W + x) * px_size + ch] = (uint8_t)((sum * m) >> 16);
+            }
+        }
+    }
+}
+
+static void check_box_blur(lv_img_cf_t cf, uint32_t px_size, const lv_area_t * area, uint16_t r_hor, uint16_t r_ver)
+{
+    img_init(cf);
+    lv_memcpy(ref_buf, buf, sizeof(buf));
+
+    lv_area_t a;
+    lv_area_set(&a, 0, 0, IMG_W - 1, IMG_H - 1);
+    if(area) _lv_area_intersect(&a, &a, area);
+    ref_box_blur(&a, px_size, LV_MIN(r_hor, 255), true);
+    ref_box_blur(&a, px_size, LV_MIN(r_ver, 255), false);
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_filter_box_blur(&img, area, r_hor, r_ver));
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf, IMG_W * IMG_H * px_size);
+}
+
+void test_draw_sw_filter_box_blur(void)
+{
+    static const uint16_t r[][2] = {{2, 0}, {3, 0}, {0, 2}, {0, 5}, {8, 8}, {4, 7}, {1, 1}, {90, 60}, {300, 300}};
+    lv_area_t areas[3];
+    lv_area_set(&areas[0], 5, 3, 66, 40);
+    lv_area_set(&areas[1], -10, -10, 20, 20);
+    lv_area_set(&areas[2], 30, 45, 100, 80);
+
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(r) / sizeof(r[0]); i++) {
+        check_box_blur(LV_IMG_CF_TRUE_COLOR_ALPHA, 4, NULL, r[i][0], r[i][1]);
+        check_box_blur(LV_IMG_CF_ALPHA_8BIT, 1, NULL, r[i][0], r[i][1]);
+        for(j = 0; j < sizeof(areas) / sizeof(areas[0]); j++) {
+            check_box_blur(LV_IMG_CF_TRUE_COLOR_ALPHA, 4, &areas[j], r[i][0], r[i][1]);
+            check_box_blur(LV_IMG_CF_ALPHA_8BIT, 1, &areas[j], r[i][0], r[i][1]);
+        }
+    }
+
+    /*Out of the image*/
+    lv_area_t out;
+    lv_area_set(&out, IMG_W, 0, IMG_W + 10, 10);
+    check_box_blur(LV_IMG_CF_TRUE_COLOR, 4, &out, 5, 5);
+
+    /*Not supported color formats*/
+    img_init(LV_IMG_CF_INDEXED_8BIT);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_draw_sw_filter_box_blur(&img, NULL, 5, 5));
+}
+
+void test_draw_sw_filter_gauss_blur(void)
+{
+    img_init(LV_IMG_CF_ALPHA_8BIT);
+
+    /*A uniform image remains the same*/
+    lv_memset(buf, 100, IMG_W * IMG_H);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_filter_gauss_blur(&img, NULL, 7));
+    uint32_t i;
+    for(i = 0; i < IMG_W * IMG_H; i++) TEST_ASSERT_EQUAL_UINT8(100, buf[i]);
+
+    /*A spot is blurred to a symmetric bell which is wider with larger radius*/
+    uint32_t radius;
+    uint32_t last_peak = 255;
+    for(radius = 1; radius <= 6; radius++) {
+        lv_memzero(buf, IMG_W * IMG_H);
+        lv_area_t spot;
+        lv_area_set(&spot, 30, 20, 39, 29);
+        lv_coord_t x, y;
+        for(y = spot.y1; y <= spot.y2; y++) lv_memset(&buf[y * IMG_W + spot.x1], 255, lv_area_get_width(&spot));
+
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_filter_gauss_blur(&img, NULL, radius));
+
+        uint32_t peak = buf[25 * IMG_W + 35];
+        TEST_ASSERT_LESS_OR_EQUAL(last_peak, peak);
+        last_peak = peak;
+
+        uint32_t total = 0;
+        for(y = 0; y < IMG_H; y++) {
+            for(x = 0; x < IMG_W; x++) {
+                total += buf[y * IMG_W + x];
+                /*Symmetric around the center of the spot (rounding can differ by a few)*/
+                lv_coord_t mx = 69 - x;
+                if(mx >= 0 && mx < IMG_W) {
+                    int32_t diff = (int32_t)buf[y * IMG_W + x] - buf[y * IMG_W + mx];
+                    TEST_ASSERT_LESS_OR_EQUAL(4, LV_ABS(diff));
+                }
+            }
+        }
+
+        /*Nothing is lost by the blur (the divisions are rounded down)*/
+        TEST_ASSERT_UINT32_WITHIN(100 * 255 / 10, 100 * 255, total);
+        TEST_ASSERT_LESS_THAN(255, buf[20 * IMG_W + 30]);
+        TEST_ASSERT_GREATER_THAN(0, buf[(20 - radius) * IMG_W + 30 - radius]);
+    }
+}
+
+void test_draw_sw_filter_color(void)
+{
+    img_init(LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_memcpy(ref_buf, buf, sizeof(buf));
+
+    /*Identity*/
+    lv_draw_sw_filter_matrix_t matrix;
+    lv_draw_sw_filter_matrix_init_saturation(&matrix, 256);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_filter_color_matrix(&img, NULL, &matrix));
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf, sizeof(buf));
+
+    /*Grayscale in an area, the alpha channel is not changed*/
+    lv_area_t area;
+    lv_area_set(&area, 10, 10, 19, 19);
+    lv_draw_sw_filter_matrix_init_saturation(&matrix, 0);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_filter_color_matrix(&img, &area, &matrix));
+    lv_coord_t x, y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x++) {
+            const lv_color32_t * c = (const lv_color32_t *)&buf[(y * IMG_W + x) * 4];
+            const lv_color32_t * ori = (const lv_color32_t *)&ref_buf[(y * IMG_W + x) * 4];
+            TEST_ASSERT_EQUAL_UINT8(ori->ch.alpha, c->ch.alpha);
+            if(_lv_area_is_point_on(&area, &(lv_point_t) {x, y}, 0)) {
+                TEST_ASSERT_UINT8_WITHIN(1, c->ch.red, c->ch.green);
+                TEST_ASSERT_UINT8_WITHIN(1, c->ch.red, c->ch.blue);
+                uint32_t lum = (54 * ori->ch.red + 183 * ori->ch.green + 19 * ori->ch.blue) >> 8;
+                TEST_ASSERT_UINT32_WITHIN(2, lum, c->ch.green);
+            }
+            else {
+                TEST_ASSERT_EQUAL_HEX32(ori->full, c->full);
+            }
+        }
+    }
+
+    /*Brightness*/
+    img_init(LV_IMG_CF_TRUE_COLOR);
+    lv_memcpy(ref_buf, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_filter_brightness(&img, NULL, 128));
+    uint32_t i;
+    for(i = 0; i < IMG_W * IMG_H * 4; i++) {
+        if(i % 4 == 3) TEST_ASSERT_EQUAL_UINT8(ref_buf[i], buf[i]);
+        else TEST_ASSERT_EQUAL_UINT8((ref_buf[i] + 1) / 2, buf[i]);
+    }
+
+    lv_memcpy(ref_buf, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_filter_brightness(&img, NULL, 512));
+    for(i = 0; i < IMG_W * IMG_H * 4; i++) {
+        if(i % 4 == 3) TEST_ASSERT_EQUAL_UINT8(ref_buf[i], buf[i]);
+        else TEST_ASSERT_EQUAL_UINT8(LV_MIN(ref_buf[i] * 2, 255), buf[i]);
+    }
+
+    /*Only colors can be changed*/
+    img_init(LV_IMG_CF_ALPHA_8BIT);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_draw_sw_filter_brightness(&img, NULL, 128));
+}
+
+void test_draw_sw_filter_canvas(void)
+{
+    static uint8_t canvas_buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(IMG_W, IMG_H)];
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, canvas_buf, IMG_W, IMG_H, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_obj_update_layout(canvas);
+    lv_refr_now(NULL);
+
+    /*The canvas blurs are the same as the filters*/
+    img_init(LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_memcpy(canvas_buf, buf, sizeof(canvas_buf));
+    lv_area_t area;
+    lv_area_set(&area, 10, 5, 50, 40);
+    lv_canvas_blur_hor(canvas, &area, 6);
+    lv_canvas_blur_ver(canvas, &area, 9);
+    lv_draw_sw_filter_box_blur(&img, &area, 6, 9);
+    TEST_ASSERT_EQUAL_MEMORY(buf, canvas_buf, sizeof(canvas_buf));
+    TEST_ASSERT_EQUAL(1, lv_disp_get_default()->inv_p);
+    lv_refr_now(NULL);
+
+    lv_canvas_blur(canvas, NULL, 4);
+    lv_draw_sw_filter_gauss_blur(&img, NULL, 4);
+    TEST_ASSERT_EQUAL_MEMORY(buf, canvas_buf, sizeof(canvas_buf));
+    TEST_ASSERT_EQUAL(1, lv_disp_get_default()->inv_p);
+
+    lv_obj_del(canvas);
+}
+
+#endif
@@ -59,4 +59,83 @@ void test_read(void)
     lv_fs_close(&fb);
 }
 
+void test_read_cached_after_large_read(void)
+{
+    /*'A' has 100 bytes cache*/
+    lv_fs_file_t fa;
+    lv_fs_res_t res = lv_fs_open(&fa, "A:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+
+    /*Fill the cache, read past it, then seek back into the cached range*/
+    uint8_t buf[300];
+    uint32_t br;
+    res = lv_fs_read(&fa, buf, 10, &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&fa, buf, 200, &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL_MEMORY(read_exp + 10, buf, br);
+
+    lv_fs_seek(&fa, 20, LV_FS_SEEK_SET);
+    res = lv_fs_read(&fa, buf, sizeof(buf), &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL(sizeof(buf), br);
+    TEST_ASSERT_EQUAL_MEMORY(read_exp + 20, buf, br);
+
+    lv_fs_close(&fa);
+}
+
+void test_mmap_read(void)
+{
+    lv_fs_res_t res;
+
+    /*'C' maps the file into the memory*/
+    lv_fs_file_t fc;
+    res = lv_fs_open(&fc, "C:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+
+    const void * data;
+    uint32_t size;
+    res = lv_fs_get_buf(&fc, &data, &size);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_TRUE(size >= strlen(read_exp));
+    TEST_ASSERT_TRUE(memcmp(data, read_exp, strlen(read_exp)) == 0);
+
+    /*Reading and seeking work as with the other drivers*/
+    uint8_t buf[79];
+    uint32_t br;
+    res = lv_fs_seek(&fc, 100, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&fc, buf, sizeof(buf), &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(buf), br);
+    TEST_ASSERT_TRUE(memcmp(buf, read_exp + 100, br) == 0);
+
+    uint32_t pos;
+    lv_fs_tell(&fc, &pos);
+    TEST_ASSERT_EQUAL_UINT32(100 + sizeof(buf), pos);
+
+    /*Read at the end of the file*/
+    res = lv_fs_seek(&fc, 10, LV_FS_SEEK_END);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&fc, buf, sizeof(buf), &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL_UINT32(0, br);
+
+    lv_fs_close(&fc);
+
+    /*Writing is not supported*/
+    res = lv_fs_open(&fc, "C:src/test_files/readtest.txt", LV_FS_MODE_WR);
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, res);
+
+    /*Drivers without direct access report it*/
+    lv_fs_file_t fb;
+    res = lv_fs_open(&fb, "B:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_get_buf(&fb, &data, &size);
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_IMP, res);
+    TEST_ASSERT_NULL(data);
+    lv_fs_close(&fb);
+}
+
 #endif
@@ -0,0 +1,119 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_GIF
+
+#include <unistd.h>
+
+extern const lv_img_dsc_t img_bulb_gif;
+
+static lv_obj_t * gif;
+static lv_disp_t * disp;
+
+void setUp(void)
+{
+    disp = lv_disp_get_default();
+    gif = lv_gif_create(lv_scr_act());
+    lv_obj_set_pos(gif, 100, 50);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+/*Run the timer of the GIF (but don't refresh the display) until it shows a new frame.
+ *Return false on timeout.*/
+static bool wait_next_frame(void)
+{
+    lv_timer_t * timer = ((lv_gif_t *)gif)->timer;
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        lv_tick_inc(10);
+        timer->timer_cb(timer);
+        if(disp->inv_p > 0) return true;
+        /*Let the worker thread decode the next frame*/
+        usleep(1000);
+    }
+    return false;
+}
+
+void test_gif_invalidates_only_the_changed_area(void)
+{
+    lv_gif_set_src(gif, &img_bulb_gif);
+    lv_obj_update_layout(gif);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+
+    /*Only the area changed by the 2nd frame should be invalidated (LVGL adds a few px margin)*/
+    gd_GIF * ref = gd_open_gif_data(img_bulb_gif.data);
+    TEST_ASSERT_NOT_NULL(ref);
+    gd_get_frame(ref);
+    gd_get_frame(ref);
+    lv_area_t changed_area;
+    lv_area_set(&changed_area, ref->dx, ref->dy, ref->dx + ref->dw - 1, ref->dy + ref->dh - 1);
+    lv_area_move(&changed_area, 100, 50);
+    gd_close_gif(ref);
+
+    TEST_ASSERT_TRUE(wait_next_frame());
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&changed_area, &disp->inv_areas[0], 0));
+    TEST_ASSERT_LESS_THAN(lv_area_get_size(&gif->coords) / 4, lv_area_get_size(&disp->inv_areas[0]));
+    lv_refr_now(NULL);
+
+    /*If the image is transformed the whole object is invalidated*/
+    lv_img_set_zoom(gif, 512);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(wait_next_frame());
+    lv_area_t obj_area;
+    lv_obj_get_coords(gif, &obj_area);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&obj_area, &disp->inv_areas[0], 0));
+}
+
+void test_gif_frames_are_the_same_as_decoded_directly(void)
+{
+    lv_gif_set_src(gif, &img_bulb_gif);
+    lv_refr_now(NULL);
+
+    gd_GIF * ref = gd_open_gif_data(img_bulb_gif.data);
+    TEST_ASSERT_NOT_NULL(ref);
+    uint32_t canvas_size = ref->width * ref->height * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    gd_get_frame(ref);
+    gd_render_frame(ref, ref->canvas);
+    const lv_img_dsc_t * dsc = lv_img_get_src(gif);
+    TEST_ASSERT_EQUAL_MEMORY(ref->canvas, dsc->data, canvas_size);
+
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(wait_next_frame());
+        lv_refr_now(NULL);
+
+        gd_get_frame(ref);
+        gd_render_frame(ref, ref->canvas);
+        TEST_ASSERT_EQUAL_MEMORY(ref->canvas, dsc->data, canvas_size);
+    }
+
+    gd_close_gif(ref);
+}
+
+void test_gif_set_src_again(void)
+{
+    lv_gif_set_src(gif, &img_bulb_gif);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(wait_next_frame());
+    lv_refr_now(NULL);
+    lv_gif_restart(gif);
+    TEST_ASSERT_TRUE(wait_next_frame());
+    lv_gif_set_src(gif, &img_bulb_gif);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(wait_next_frame());
+    lv_obj_del(gif);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+}
+
+#endif
+
+#endif
@@ -0,0 +1,298 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IME_PINYIN
+
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_DICT_PATH   "/tmp/lv_test_ime_pinyin_big.txt"
+#define BIG_ENTRY_CNT   50000
+#define BIG_SYL_CNT     (sizeof(syllables) / sizeof(syllables[0]))
+
+static lv_obj_t * ime;
+static lv_obj_t * kb;
+static lv_obj_t * ta;
+
+static const char * syllables[] = {
+    "a", "ai", "an", "ba", "bei", "bian", "chang", "chu", "da", "dian", "dong", "fa", "fen", "gao", "guo",
+    "hao", "hua", "ji", "jian", "kai", "lai", "li", "ma", "ming", "nian", "qi", "ren", "shang", "shi",
+    "shui", "tian", "wen", "xia", "xin", "yang", "yi", "you", "zhong", "zi", "zuo"
+};
+
+void setUp(void)
+{
+    ime = lv_ime_pinyin_create(lv_scr_act());
+    kb = lv_keyboard_create(lv_scr_act());
+    ta = lv_textarea_create(lv_scr_act());
+    lv_ime_pinyin_set_keyboard(ime, kb);
+    lv_keyboard_set_textarea(kb, ta);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static void write_file(const char * path, const char * txt)
+{
+    FILE * f = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fputs(txt, f);
+    fclose(f);
+}
+
+/*Click a button of the keyboard by its text*/
+static void press_key(const char * txt)
+{
+    uint16_t i;
+    for(i = 0; lv_btnmatrix_get_btn_text(kb, i); i++) {
+        if(strcmp(lv_btnmatrix_get_btn_text(kb, i), txt) == 0) {
+            lv_btnmatrix_set_selected_btn(kb, i);
+            lv_event_send(kb, LV_EVENT_VALUE_CHANGED, NULL);
+            return;
+        }
+    }
+    TEST_FAIL_MESSAGE("key not found");
+}
+
+static void type(const char * py)
+{
+    char txt[2] = {0};
+    while(*py) {
+        txt[0] = *py;
+        press_key(txt);
+        py++;
+    }
+}
+
+/*The `i`th candidate on the current page*/
+static const char * get_cand(uint16_t i)
+{
+    return lv_btnmatrix_get_btn_text(lv_ime_pinyin_get_cand_panel(ime), i + 1);
+}
+
+static void select_cand(uint16_t i)
+{
+    lv_obj_t * cand_panel = lv_ime_pinyin_get_cand_panel(ime);
+    lv_btnmatrix_set_selected_btn(cand_panel, i + 1);
+    lv_event_send(cand_panel, LV_EVENT_VALUE_CHANGED, NULL);
+}
+
+void test_ime_pinyin_default_dict(void)
+{
+    lv_obj_t * cand_panel = lv_ime_pinyin_get_cand_panel(ime);
+    TEST_ASSERT_TRUE(lv_obj_has_flag(cand_panel, LV_OBJ_FLAG_HIDDEN));
+
+    /*Every character of the entry is a candidate*/
+    type("an");
+    TEST_ASSERT_FALSE(lv_obj_has_flag(cand_panel, LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_EQUAL_STRING("安", get_cand(0));
+    TEST_ASSERT_EQUAL_STRING("暗", get_cand(1));
+    TEST_ASSERT_EQUAL_STRING("案", get_cand(2));
+    TEST_ASSERT_EQUAL_STRING(" ", get_cand(3));
+
+    /*Going back continues from the shorter pinyin*/
+    press_key(LV_SYMBOL_BACKSPACE);
+    TEST_ASSERT_EQUAL_STRING("啊", get_cand(0));
+    type("i");
+    TEST_ASSERT_EQUAL_STRING("愛", get_cand(0));
+
+    select_cand(0);
+    TEST_ASSERT_EQUAL_STRING("愛", lv_textarea_get_text(ta));
+    TEST_ASSERT_TRUE(lv_obj_has_flag(cand_panel, LV_OBJ_FLAG_HIDDEN));
+}
+
+static void check_small_dict(const char * path)
+{
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_ime_pinyin_set_dict_file(ime, path));
+    TEST_ASSERT_NULL(lv_ime_pinyin_get_dict(ime));
+
+    /*Ordered by frequency*/
+    type("yu");
+    TEST_ASSERT_EQUAL_STRING("鱼", get_cand(0));
+    TEST_ASSERT_EQUAL_STRING("玉", get_cand(1));
+    TEST_ASSERT_EQUAL_STRING("雨", get_cand(2));
+    TEST_ASSERT_EQUAL_STRING(" ", get_cand(3));
+
+    type("m");
+    TEST_ASSERT_EQUAL_STRING("玉米", get_cand(0));
+    TEST_ASSERT_EQUAL_STRING(" ", get_cand(1));
+
+    select_cand(0);
+    TEST_ASSERT_EQUAL_STRING("玉米", lv_textarea_get_text(ta));
+
+    /*Not complete pinyin shows the first completion*/
+    type("x");
+    TEST_ASSERT_EQUAL_STRING("小麦", get_cand(0));
+    type("iaom");
+    TEST_ASSERT_EQUAL_STRING("小麦", get_cand(0));
+    select_cand(0);
+
+    /*Entries without frequency and on the last line without new line*/
+    type("shuid");
+    TEST_ASSERT_EQUAL_STRING("水稻", get_cand(0));
+    select_cand(0);
+    TEST_ASSERT_EQUAL_STRING("玉米小麦水稻", lv_textarea_get_text(ta));
+
+    /*The invalid lines are skipped*/
+    lv_textarea_set_text(ta, "");
+    type("bad");
+    TEST_ASSERT_TRUE(lv_obj_has_flag(lv_ime_pinyin_get_cand_panel(ime), LV_OBJ_FLAG_HIDDEN));
+}
+
+void test_ime_pinyin_dict_file(void)
+{
+    write_file("/tmp/lv_test_ime_pinyin.txt",
+               "# pinyin candidate frequency\n"
+               "yumi 玉米 950\n"
+               "yu 雨 300\n"
+               "  xiaomai\t小麦 900\n"
+               "yu 鱼 800\n"
+               "yu 玉 500\r\n"
+               "\n"
+               "Bad 坏 100\n"
+               "bad\n"
+               "baddddddddddddddd 坏 100\n"
+               "shuidao 水稻");
+
+    /*Read into the memory and memory mapped*/
+    check_small_dict("A:/tmp/lv_test_ime_pinyin.txt");
+    lv_textarea_set_text(ta, "");
+    check_small_dict("C:/tmp/lv_test_ime_pinyin.txt");
+
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_ime_pinyin_set_dict_file(ime, "A:/tmp/lv_test_ime_pinyin_none.txt"));
+
+    /*Empty dictionary*/
+    write_file("/tmp/lv_test_ime_pinyin_empty.txt", "# nothing\n");
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_ime_pinyin_set_dict_file(ime, "A:/tmp/lv_test_ime_pinyin_empty.txt"));
+    type("yu");
+    TEST_ASSERT_TRUE(lv_obj_has_flag(lv_ime_pinyin_get_cand_panel(ime), LV_OBJ_FLAG_HIDDEN));
+
+    /*Switch back to a dictionary in the memory*/
+    static lv_pinyin_dict_t dict[] = {
+        {"an", "安暗"},
+        {"dou", "豆"},
+        {NULL, NULL}
+    };
+    lv_ime_pinyin_set_dict(ime, dict);
+    TEST_ASSERT_EQUAL_PTR(dict, lv_ime_pinyin_get_dict(ime));
+    lv_textarea_set_text(ta, "");
+    type("d");
+    TEST_ASSERT_EQUAL_STRING("豆", get_cand(0));
+}
+
+/*Pinyin of the `i`th generated entry*/
+static void big_entry_py(uint32_t i, char * buf)
+{
+    strcpy(buf, syllables[i % BIG_SYL_CNT]);
+    strcat(buf, syllables[(i / BIG_SYL_CNT) % BIG_SYL_CNT]);
+    strcat(buf, syllables[(i * 7 / (BIG_SYL_CNT * BIG_SYL_CNT)) % BIG_SYL_CNT]);
+}
+
+static uint32_t big_entry_freq(uint32_t i)
+{
+    return i * 2654435761u;     /*Unique to have a well defined order*/
+}
+
+/*The expected first candidate of a pinyin by checking all entries*/
+static void big_find_first(const char * py, char * text)
+{
+    char best_py[64] = "";
+    uint32_t best_freq = 0;
+    uint32_t len = strlen(py);
+    uint32_t i;
+    text[0] = '\0';
+    for(i = 0; i < BIG_ENTRY_CNT; i++) {
+        char epy[64];
+        big_entry_py(i, epy);
+        if(strncmp(epy, py, len) != 0) continue;
+
+        int r = best_py[0] ? strcmp(epy, best_py) : -1;
+        if(r < 0 || (r == 0 && big_entry_freq(i) > best_freq)) {
+            strcpy(best_py, epy);
+            best_freq = big_entry_freq(i);
+            sprintf(text, "词%"LV_PRIu32, i);
+        }
+    }
+}
+
+void test_ime_pinyin_big_dict(void)
+{
+    FILE * f = fopen(BIG_DICT_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    uint32_t i;
+    for(i = 0; i < BIG_ENTRY_CNT; i++) {
+        char py[64];
+        big_entry_py(i, py);
+        fprintf(f, "%s 词%"LV_PRIu32" %"LV_PRIu32"\n", py, i, big_entry_freq(i));
+    }
+    fclose(f);
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_ime_pinyin_set_dict_file(ime, "C:" BIG_DICT_PATH));
+
+    static const char * inputs[] = {"zhongguo", "shuitian", "xinnian", "yiyang", "chudian", "a", "bian", "renshi"};
+    char exp[32];
+    uint32_t k;
+    for(k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++) {
+        const char * py = inputs[k];
+        char typed[16] = {0};
+        uint32_t len = strlen(py);
+        uint32_t j;
+        for(j = 0; j < len; j++) {
+            char key[2] = {py[j], '\0'};
+            press_key(key);
+
+            typed[j] = py[j];
+            big_find_first(typed, exp);
+            TEST_ASSERT_EQUAL_STRING(exp, get_cand(0));
+        }
+
+        /*Delete and check again on the way back*/
+        for(j = len - 1; j > 0; j--) {
+            press_key(LV_SYMBOL_BACKSPACE);
+
+            typed[j] = '\0';
+            big_find_first(typed, exp);
+            TEST_ASSERT_EQUAL_STRING(exp, get_cand(0));
+        }
+        press_key(LV_SYMBOL_BACKSPACE);
+        lv_textarea_set_text(ta, "");
+    }
+
+    /*The time of the candidate search is measured by the "pinyin" scene of the performance suite*/
+    remove(BIG_DICT_PATH);
+}
+
+#else /*LV_USE_IME_PINYIN*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_ime_pinyin_default_dict(void)
+{
+
+}
+
+void test_ime_pinyin_dict_file(void)
+{
+
+}
+
+void test_ime_pinyin_big_dict(void)
+{
+
+}
+
+#endif
+
+#endif
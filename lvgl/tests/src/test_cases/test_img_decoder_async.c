@@ -0,0 +1,214 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_IMG_DECODER_USE_ASYNC && LV_USE_PNG && LV_COLOR_DEPTH == 32
+
+#include <unistd.h>
+
+/*Decoded in one piece and read line by line (larger than `LV_PNG_READ_LINE_MIN_SIZE`)*/
+#define SRC_SMALL   "A:src/test_files/png/rgba.png"
+#define SRC_LARGE   "A:src/test_files/png/large.png"
+
+#define CONT_W      200
+#define CONT_H      150
+
+extern lv_color_t test_fb[];
+
+static lv_obj_t * cont;
+
+void setUp(void)
+{
+    cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(cont, lv_color_white(), 0);
+    lv_obj_set_size(cont, CONT_W, CONT_H);
+    lv_obj_set_pos(cont, 50, 40);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+}
+
+static void draw_event_cb(lv_event_t * e)
+{
+    lv_obj_t * img = lv_event_get_target(e);
+    lv_obj_set_user_data(img, (void *)((uintptr_t)lv_obj_get_user_data(img) + 1));
+}
+
+static lv_obj_t * img_create(const char * src, lv_coord_t x, lv_coord_t y)
+{
+    lv_obj_t * img = lv_img_create(cont);
+    lv_img_set_src(img, src);
+    lv_obj_set_pos(img, x, y);
+    lv_obj_add_event_cb(img, draw_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+    return img;
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Let the workers decode the images and run the timers until the images are redrawn*/
+static void wait_decoded(void)
+{
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(cont); i++) lv_obj_set_user_data(lv_obj_get_child(cont, i), NULL);
+
+    for(i = 0; i < 1000 && lv_img_decoder_async_get_pending_cnt() > 0; i++) {
+        usleep(1000);
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL(0, lv_img_decoder_async_get_pending_cnt());
+
+    for(i = 0; i < 10; i++) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+}
+
+static bool is_redrawn(lv_obj_t * img)
+{
+    return lv_obj_get_user_data(img) != NULL;
+}
+
+static bool is_placeholder(lv_coord_t x, lv_coord_t y)
+{
+    lv_color_t c = test_fb[y * 800 + x];
+    lv_color_t p = LV_IMG_DECODER_ASYNC_PLACEHOLDER_COLOR;
+    return c.ch.red == p.ch.red && c.ch.green == p.ch.green && c.ch.blue == p.ch.blue;
+}
+
+/*Compare the container on the screen with the images drawn to a canvas which draws them synchronously*/
+static void check_same_as_sync(void)
+{
+    static lv_color_t canvas_buf[CONT_W * CONT_H];
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, canvas_buf, CONT_W, CONT_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(cont); i++) {
+        lv_obj_t * img = lv_obj_get_child(cont, i);
+        lv_draw_img_dsc_t dsc;
+        lv_draw_img_dsc_init(&dsc);
+        dsc.angle = lv_img_get_angle(img);
+        dsc.zoom = lv_img_get_zoom(img);
+        lv_img_get_pivot(img, &dsc.pivot);
+        lv_canvas_draw_img(canvas, lv_obj_get_x(img), lv_obj_get_y(img), lv_img_get_src(img), &dsc);
+    }
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < CONT_H; y++) {
+        for(x = 0; x < CONT_W; x++) {
+            lv_color_t c = test_fb[(cont->coords.y1 + y) * 800 + cont->coords.x1 + x];
+            lv_color_t r = canvas_buf[y * CONT_W + x];
+            char msg[64];
+            lv_snprintf(msg, sizeof(msg), "x: %d, y: %d", (int)x, (int)y);
+            TEST_ASSERT_EQUAL_MESSAGE(r.ch.red, c.ch.red, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(r.ch.green, c.ch.green, msg);
+            TEST_ASSERT_EQUAL_MESSAGE(r.ch.blue, c.ch.blue, msg);
+        }
+    }
+
+    lv_obj_del(canvas);
+}
+
+void test_img_decoder_async_placeholder_then_image(void)
+{
+    lv_obj_t * small = img_create(SRC_SMALL, 10, 10);
+    lv_obj_t * large = img_create(SRC_LARGE, 60, 20);
+    lv_obj_update_layout(cont);
+
+    /*The images are decoded on another thread so the placeholders are drawn first*/
+    refr_screen();
+    TEST_ASSERT_TRUE(is_placeholder(small->coords.x1 + 5, small->coords.y1 + 5));
+    TEST_ASSERT_TRUE(is_placeholder(large->coords.x1 + 5, large->coords.y1 + 5));
+
+    /*The placeholders are redrawn with the images when they are ready*/
+    wait_decoded();
+    TEST_ASSERT_TRUE(is_redrawn(small));
+    TEST_ASSERT_TRUE(is_redrawn(large));
+    TEST_ASSERT_NOT_EQUAL(0, lv_img_decoder_async_get_used_size());
+    refr_screen();
+    check_same_as_sync();
+
+    /*Transformed images too*/
+    lv_img_set_angle(small, 300);
+    lv_img_set_zoom(small, 384);
+    refr_screen();
+    check_same_as_sync();
+}
+
+void test_img_decoder_async_preload(void)
+{
+    lv_img_decoder_async_preload(SRC_LARGE);
+    wait_decoded();
+
+    /*Drawn right away*/
+    lv_obj_t * large = img_create(SRC_LARGE, 20, 20);
+    lv_obj_update_layout(cont);
+    refr_screen();
+    TEST_ASSERT_FALSE(is_placeholder(large->coords.x1 + 5, large->coords.y1 + 5));
+    check_same_as_sync();
+}
+
+void test_img_decoder_async_invalidate_src(void)
+{
+    lv_obj_t * small = img_create(SRC_SMALL, 10, 10);
+    lv_obj_update_layout(cont);
+    refr_screen();
+    wait_decoded();
+    TEST_ASSERT_NOT_EQUAL(0, lv_img_decoder_async_get_used_size());
+
+    /*The decoded image is freed and it's decoded again when drawn next time*/
+    lv_img_cache_invalidate_src(SRC_SMALL);
+    TEST_ASSERT_EQUAL(0, lv_img_decoder_async_get_used_size());
+
+    refr_screen();
+    TEST_ASSERT_TRUE(is_placeholder(small->coords.x1 + 5, small->coords.y1 + 5));
+
+    wait_decoded();
+    TEST_ASSERT_TRUE(is_redrawn(small));
+    refr_screen();
+    check_same_as_sync();
+}
+
+#else /*LV_IMG_DECODER_USE_ASYNC && LV_USE_PNG && LV_COLOR_DEPTH == 32*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_img_decoder_async_placeholder_then_image(void)
+{
+
+}
+
+void test_img_decoder_async_preload(void)
+{
+
+}
+
+void test_img_decoder_async_invalidate_src(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,274 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_COLOR_DEPTH == 32
+
+#include "../../src/draw/sw/lv_draw_sw.h"
+
+#define IMG_W   21
+#define IMG_H   10
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[800 * 480];
+
+static lv_color32_t argb_map[IMG_W * IMG_H];
+static lv_color32_t argb_exp_map[IMG_W * IMG_H * 4];
+static uint8_t a8_map[IMG_W * IMG_H];
+static uint8_t a8_exp_map[IMG_W * IMG_H * 4];
+
+static lv_img_dsc_t argb_img;
+static lv_img_dsc_t argb_exp_img;
+static lv_img_dsc_t a8_img;
+static lv_img_dsc_t a8_exp_img;
+
+static void img_dsc_init(lv_img_dsc_t * dsc, const void * map, lv_coord_t w, lv_coord_t h, lv_img_cf_t cf)
+{
+    lv_memzero(dsc, sizeof(lv_img_dsc_t));
+    dsc->header.w = w;
+    dsc->header.h = h;
+    dsc->header.cf = cf;
+    dsc->data_size = w * h * (cf == LV_IMG_CF_ALPHA_8BIT ? 1 : sizeof(lv_color32_t));
+    dsc->data = map;
+}
+
+void setUp(void)
+{
+    uint32_t i;
+    for(i = 0; i < IMG_W * IMG_H; i++) {
+        argb_map[i].full = 0xff000000 | (i * 0x3f1c95);
+        if(i % 7 == 0) argb_map[i].ch.alpha = i;
+        a8_map[i] = (i * 37) & 0xff;
+    }
+
+    img_dsc_init(&argb_img, argb_map, IMG_W, IMG_H, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    img_dsc_init(&a8_img, a8_map, IMG_W, IMG_H, LV_IMG_CF_ALPHA_8BIT);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Draw the transformed image, and the expected image without transformation to the same place*/
+static void check_img(const lv_img_dsc_t * src, int16_t angle, uint16_t zoom, bool antialias,
+                      const lv_img_dsc_t * exp_src, lv_coord_t exp_x, lv_coord_t exp_y)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, src);
+    lv_obj_set_pos(img, 100, 100);
+    lv_img_set_pivot(img, 5, 3);
+    lv_img_set_angle(img, angle);
+    lv_img_set_zoom(img, zoom);
+    lv_img_set_antialias(img, antialias);
+    refr_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_obj_del(img);
+
+    img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, exp_src);
+    lv_obj_set_pos(img, 100 + exp_x, 100 + exp_y);
+    refr_screen();
+    lv_obj_del(img);
+
+    TEST_ASSERT_EQUAL_MEMORY(test_fb, ref_fb, sizeof(ref_fb));
+}
+
+static void check_rotate(const lv_img_dsc_t * src, lv_img_dsc_t * exp_src, uint8_t * exp_map, int16_t angle)
+{
+    lv_coord_t px_size = src->header.cf == LV_IMG_CF_ALPHA_8BIT ? 1 : sizeof(lv_color32_t);
+    lv_coord_t exp_w = angle == 1800 ? IMG_W : IMG_H;
+    lv_coord_t exp_h = angle == 1800 ? IMG_H : IMG_W;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x++) {
+            lv_coord_t exp_x;
+            lv_coord_t exp_y;
+            if(angle == 900) {
+                exp_x = IMG_H - 1 - y;
+                exp_y = x;
+            }
+            else if(angle == 1800) {
+                exp_x = IMG_W - 1 - x;
+                exp_y = IMG_H - 1 - y;
+            }
+            else {
+                exp_x = y;
+                exp_y = IMG_W - 1 - x;
+            }
+            lv_memcpy(&exp_map[(exp_y * exp_w + exp_x) * px_size], &src->data[(y * IMG_W + x) * px_size], px_size);
+        }
+    }
+    img_dsc_init(exp_src, exp_map, exp_w, exp_h, src->header.cf);
+
+    /*The top left corner of the rotated image around the (5;3) pivot*/
+    lv_point_t exp_pos;
+    if(angle == 900) {
+        exp_pos.x = 5 + 3 - (IMG_H - 1);
+        exp_pos.y = 3 - 5;
+    }
+    else if(angle == 1800) {
+        exp_pos.x = 2 * 5 - (IMG_W - 1);
+        exp_pos.y = 2 * 3 - (IMG_H - 1);
+    }
+    else {
+        exp_pos.x = 5 - 3;
+        exp_pos.y = 3 + 5 - (IMG_W - 1);
+    }
+
+    /*There is nothing to interpolate so anti-aliasing shouldn't change anything*/
+    check_img(src, angle, LV_IMG_ZOOM_NONE, false, exp_src, exp_pos.x, exp_pos.y);
+    lv_img_cache_invalidate_src(NULL);
+    check_img(src, angle, LV_IMG_ZOOM_NONE, true, exp_src, exp_pos.x, exp_pos.y);
+    lv_img_cache_invalidate_src(NULL);
+}
+
+static void check_zoom_2x(const lv_img_dsc_t * src, lv_img_dsc_t * exp_src, uint8_t * exp_map)
+{
+    lv_coord_t px_size = src->header.cf == LV_IMG_CF_ALPHA_8BIT ? 1 : sizeof(lv_color32_t);
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < IMG_H * 2; y++) {
+        for(x = 0; x < IMG_W * 2; x++) {
+            lv_memcpy(&exp_map[(y * IMG_W * 2 + x) * px_size], &src->data[((y / 2) * IMG_W + x / 2) * px_size], px_size);
+        }
+    }
+    img_dsc_init(exp_src, exp_map, IMG_W * 2, IMG_H * 2, src->header.cf);
+
+    /*Every pixel is repeated around the (5;3) pivot*/
+    check_img(src, 0, 512, false, exp_src, -5, -3);
+}
+
+void test_img_transform_rotate_90(void)
+{
+    check_rotate(&argb_img, &argb_exp_img, (uint8_t *)argb_exp_map, 900);
+    check_rotate(&argb_img, &argb_exp_img, (uint8_t *)argb_exp_map, 1800);
+    check_rotate(&argb_img, &argb_exp_img, (uint8_t *)argb_exp_map, 2700);
+}
+
+void test_img_transform_rotate_90_a8(void)
+{
+    check_rotate(&a8_img, &a8_exp_img, a8_exp_map, 900);
+    check_rotate(&a8_img, &a8_exp_img, a8_exp_map, 1800);
+    check_rotate(&a8_img, &a8_exp_img, a8_exp_map, 2700);
+}
+
+void test_img_transform_zoom_2x(void)
+{
+    check_zoom_2x(&argb_img, &argb_exp_img, (uint8_t *)argb_exp_map);
+}
+
+void test_img_transform_zoom_2x_a8(void)
+{
+    check_zoom_2x(&a8_img, &a8_exp_img, a8_exp_map);
+}
+
+#define AA_IMG_SIZE  64
+
+static lv_color32_t aa_map[AA_IMG_SIZE * AA_IMG_SIZE];
+
+/*Transform every row at once (4 pixels at once on the inner part) and pixel by pixel (always one by one)*/
+static void check_aa_rows_same_as_pixels(lv_img_cf_t cf, int16_t angle, uint16_t zoom)
+{
+    static lv_color_t row_cbuf[800];
+    static lv_opa_t row_abuf[800];
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    dsc.angle = angle;
+    dsc.zoom = zoom;
+    dsc.pivot.x = AA_IMG_SIZE / 2;
+    dsc.pivot.y = AA_IMG_SIZE / 3;
+    dsc.antialias = 1;
+
+    lv_area_t area;
+    _lv_img_buf_get_transformed_area(&area, AA_IMG_SIZE, AA_IMG_SIZE, angle, zoom, &dsc.pivot);
+    lv_coord_t w = lv_area_get_width(&area);
+    TEST_ASSERT_LESS_OR_EQUAL(800, w);
+
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        lv_area_t row = {area.x1, y, area.x2, y};
+        lv_draw_sw_transform(NULL, &row, aa_map, AA_IMG_SIZE, AA_IMG_SIZE, AA_IMG_SIZE, &dsc, cf, row_cbuf, row_abuf);
+
+        lv_coord_t x;
+        for(x = area.x1; x <= area.x2; x++) {
+            lv_area_t px = {x, y, x, y};
+            lv_color_t c;
+            lv_opa_t a;
+            lv_draw_sw_transform(NULL, &px, aa_map, AA_IMG_SIZE, AA_IMG_SIZE, AA_IMG_SIZE, &dsc, cf, &c, &a);
+            TEST_ASSERT_EQUAL_HEX8(a, row_abuf[x - area.x1]);
+            /*The color of the transparent pixels is not set*/
+            if(a) TEST_ASSERT_EQUAL_HEX32(c.full, row_cbuf[x - area.x1].full);
+        }
+    }
+}
+
+void test_img_transform_aa_same_as_px_by_px(void)
+{
+    uint32_t i;
+    for(i = 0; i < AA_IMG_SIZE * AA_IMG_SIZE; i++) {
+        aa_map[i].full = 0xff000000 | (i * 0x3f1c95);
+        if(i % 5 == 0) aa_map[i].ch.alpha = i;
+    }
+
+    /*Only without rotation or with 1/4 zoom are the source coordinates exactly linear in a row,
+     *else the pixel by pixel transformation would be a little different*/
+    check_aa_rows_same_as_pixels(LV_IMG_CF_TRUE_COLOR_ALPHA, 0, 300);
+    check_aa_rows_same_as_pixels(LV_IMG_CF_TRUE_COLOR_ALPHA, 0, 700);
+    check_aa_rows_same_as_pixels(LV_IMG_CF_TRUE_COLOR, 0, 450);
+    check_aa_rows_same_as_pixels(LV_IMG_CF_TRUE_COLOR_ALPHA, 300, 64);
+    check_aa_rows_same_as_pixels(LV_IMG_CF_TRUE_COLOR_ALPHA, 1234, 64);
+    check_aa_rows_same_as_pixels(LV_IMG_CF_TRUE_COLOR, 2900, 64);
+}
+
+#else /*LV_COLOR_DEPTH == 32*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_img_transform_rotate_90(void)
+{
+
+}
+
+void test_img_transform_rotate_90_a8(void)
+{
+
+}
+
+void test_img_transform_zoom_2x(void)
+{
+
+}
+
+void test_img_transform_zoom_2x_a8(void)
+{
+
+}
+
+void test_img_transform_aa_same_as_px_by_px(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,273 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_LAYER_CACHE_MAX_SIZE
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[800 * 480];
+static uint32_t card_draw_cnt;
+
+static lv_obj_t * card;
+static lv_obj_t * value_label;
+static lv_obj_t * overlay;
+
+void setUp(void)
+{
+    card_draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static void card_draw_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    card_draw_cnt++;
+}
+
+/*A card with a shadow, title and value label, and a sibling overlapping it*/
+static void create_ui(bool cached)
+{
+    lv_obj_t * grid = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(grid, 600, 400);
+    lv_obj_center(grid);
+    lv_obj_set_style_bg_color(grid, lv_palette_lighten(LV_PALETTE_GREY, 3), 0);
+
+    card = lv_obj_create(grid);
+    lv_obj_set_size(card, 250, 200);
+    lv_obj_set_pos(card, 20, 20);
+    lv_obj_set_style_radius(card, 20, 0);
+    lv_obj_set_style_shadow_width(card, 30, 0);
+    lv_obj_set_style_bg_color(card, lv_color_hex(0x3399cc), 0);
+    lv_obj_add_event_cb(card, card_draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    if(cached) lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+
+    lv_obj_t * title = lv_label_create(card);
+    lv_label_set_text(title, "Temperature");
+
+    value_label = lv_label_create(card);
+    lv_label_set_text(value_label, "21.5 C");
+    lv_obj_align(value_label, LV_ALIGN_CENTER, 0, 0);
+
+    overlay = lv_obj_create(grid);
+    lv_obj_set_size(overlay, 100, 100);
+    lv_obj_set_pos(overlay, 200, 150);
+    lv_obj_set_style_bg_opa(overlay, LV_OPA_50, 0);
+}
+
+static void refr_screen(lv_color_t * dest)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    if(dest) lv_memcpy(dest, test_fb, sizeof(ref_fb));
+}
+
+static void check_same_as_not_cached(void (*change_cb)(void))
+{
+    create_ui(false);
+    refr_screen(NULL);
+    change_cb();
+    refr_screen(ref_fb);
+    lv_obj_clean(lv_scr_act());
+
+    create_ui(true);
+    refr_screen(NULL);
+    change_cb();
+    lv_refr_now(NULL);  /*Update only the changed area in the layer*/
+    refr_screen(NULL);
+
+    /*Blending the layer with alpha might round differently*/
+    uint32_t i;
+    for(i = 0; i < 800 * 480; i++) {
+        lv_color_t c1 = test_fb[i];
+        lv_color_t c2 = ref_fb[i];
+        if(LV_ABS(c1.ch.red - c2.ch.red) > 2 || LV_ABS(c1.ch.green - c2.ch.green) > 2 ||
+           LV_ABS(c1.ch.blue - c2.ch.blue) > 2) {
+            char msg[64];
+            lv_snprintf(msg, sizeof(msg), "x: %d, y: %d", (int)(i % 800), (int)(i / 800));
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+}
+
+static void change_nothing(void)
+{
+}
+
+static void change_label(void)
+{
+    /*Keep the size to test that only the label's area is updated in the layer*/
+    lv_obj_set_style_text_color(value_label, lv_palette_main(LV_PALETTE_RED), 0);
+}
+
+static void change_card_style(void)
+{
+    lv_obj_set_style_bg_color(card, lv_color_hex(0xcc3366), 0);
+}
+
+static void change_card_size(void)
+{
+    lv_obj_set_size(card, 200, 150);
+}
+
+static void move_card(void)
+{
+    lv_obj_set_pos(card, 60, 40);
+}
+
+static void delete_label(void)
+{
+    lv_obj_del(value_label);
+}
+
+void test_layer_cache_same_rendering(void)
+{
+    check_same_as_not_cached(change_nothing);
+}
+
+void test_layer_cache_child_changed(void)
+{
+    check_same_as_not_cached(change_label);
+}
+
+void test_layer_cache_style_changed(void)
+{
+    check_same_as_not_cached(change_card_style);
+}
+
+void test_layer_cache_size_changed(void)
+{
+    check_same_as_not_cached(change_card_size);
+}
+
+void test_layer_cache_moved(void)
+{
+    check_same_as_not_cached(move_card);
+}
+
+void test_layer_cache_child_deleted(void)
+{
+    check_same_as_not_cached(delete_label);
+}
+
+void test_layer_cache_not_redrawn(void)
+{
+    create_ui(true);
+    refr_screen(NULL);
+    TEST_ASSERT_EQUAL(1, card_draw_cnt);
+    TEST_ASSERT_GREATER_THAN(0, lv_obj_layer_cache_get_used_size());
+
+    /*The card is not drawn again if something else changes on it*/
+    lv_obj_set_style_bg_color(overlay, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_refr_now(NULL);
+    refr_screen(NULL);
+    TEST_ASSERT_EQUAL(1, card_draw_cnt);
+
+    /*Only the area of the label is drawn again*/
+    change_label();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(2, card_draw_cnt);
+}
+
+void test_layer_cache_memory_limit(void)
+{
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_set_size(obj, 200, 200);
+        lv_obj_set_pos(obj, (i % 4) * 200, (i / 4 % 2) * 200);
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_CACHE_LAYER);
+        refr_screen(NULL);
+        TEST_ASSERT_LESS_OR_EQUAL(LV_LAYER_CACHE_MAX_SIZE, lv_obj_layer_cache_get_used_size());
+    }
+
+    /*Too large to be cached*/
+    lv_obj_t * large = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(large, 800, 480);
+    lv_obj_add_flag(large, LV_OBJ_FLAG_CACHE_LAYER);
+    refr_screen(NULL);
+    TEST_ASSERT_LESS_OR_EQUAL(LV_LAYER_CACHE_MAX_SIZE, lv_obj_layer_cache_get_used_size());
+}
+
+void test_layer_cache_freed(void)
+{
+    create_ui(true);
+    refr_screen(NULL);
+    TEST_ASSERT_GREATER_THAN(0, lv_obj_layer_cache_get_used_size());
+
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+    TEST_ASSERT_EQUAL(0, lv_obj_layer_cache_get_used_size());
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+    refr_screen(NULL);
+    TEST_ASSERT_GREATER_THAN(0, lv_obj_layer_cache_get_used_size());
+
+    lv_obj_clean(lv_scr_act());
+    TEST_ASSERT_EQUAL(0, lv_obj_layer_cache_get_used_size());
+}
+
+#else /*LV_LAYER_CACHE_MAX_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_layer_cache_same_rendering(void)
+{
+
+}
+
+void test_layer_cache_child_changed(void)
+{
+
+}
+
+void test_layer_cache_style_changed(void)
+{
+
+}
+
+void test_layer_cache_size_changed(void)
+{
+
+}
+
+void test_layer_cache_moved(void)
+{
+
+}
+
+void test_layer_cache_child_deleted(void)
+{
+
+}
+
+void test_layer_cache_not_redrawn(void)
+{
+
+}
+
+void test_layer_cache_memory_limit(void)
+{
+
+}
+
+void test_layer_cache_freed(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,258 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define ITEM_CNT    60
+
+static lv_obj_t * cont;
+
+void setUp(void)
+{
+    cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 300, 400);
+    lv_obj_set_style_pad_all(cont, 5, 0);
+    lv_obj_set_style_pad_row(cont, 3, 0);
+    lv_obj_set_style_pad_column(cont, 4, 0);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static lv_obj_t * item_create(uint32_t i)
+{
+    lv_obj_t * item = lv_obj_create(cont);
+    lv_obj_remove_style_all(item);
+    lv_obj_set_size(item, 20 + (i * 7) % 50, 15 + (i * 5) % 30);
+    return item;
+}
+
+/*Check that the children are in the same place as if the layout was calculated from scratch*/
+static void check_same_as_fresh(void)
+{
+    static lv_area_t coords[ITEM_CNT + 1];
+    uint32_t cnt = lv_obj_get_child_cnt(cont);
+    TEST_ASSERT_LESS_OR_EQUAL(ITEM_CNT + 1, cnt);
+
+    uint32_t i;
+    lv_obj_update_layout(cont);
+    for(i = 0; i < cnt; i++) lv_obj_get_coords(lv_obj_get_child(cont, i), &coords[i]);
+
+#if LV_USE_LAYOUT_CACHE
+    _lv_obj_layout_cache_invalidate(cont);
+#endif
+    lv_obj_mark_layout_as_dirty(cont);
+    lv_obj_update_layout(cont);
+
+    for(i = 0; i < cnt; i++) {
+        lv_area_t a;
+        lv_obj_get_coords(lv_obj_get_child(cont, i), &a);
+        char msg[64];
+        lv_snprintf(msg, sizeof(msg), "child %d", (int)i);
+        TEST_ASSERT_EQUAL_MESSAGE(coords[i].x1, a.x1, msg);
+        TEST_ASSERT_EQUAL_MESSAGE(coords[i].y1, a.y1, msg);
+        TEST_ASSERT_EQUAL_MESSAGE(coords[i].x2, a.x2, msg);
+        TEST_ASSERT_EQUAL_MESSAGE(coords[i].y2, a.y2, msg);
+    }
+}
+
+/*Change the children in many ways and check the layout after each change*/
+static void change_items(void)
+{
+    uint32_t i;
+    for(i = 0; i < ITEM_CNT; i++) item_create(i);
+    check_same_as_fresh();
+
+    /*Small change which doesn't move the other tracks*/
+    lv_obj_set_width(lv_obj_get_child(cont, 10), lv_obj_get_width(lv_obj_get_child(cont, 10)) + 1);
+    check_same_as_fresh();
+
+    /*Large changes which move the items to other tracks*/
+    lv_obj_set_width(lv_obj_get_child(cont, 12), 150);
+    check_same_as_fresh();
+    lv_obj_set_height(lv_obj_get_child(cont, 30), 60);
+    check_same_as_fresh();
+    lv_obj_set_size(lv_obj_get_child(cont, 12), 10, 10);
+    check_same_as_fresh();
+
+    lv_obj_add_flag(lv_obj_get_child(cont, 5), LV_OBJ_FLAG_HIDDEN);
+    check_same_as_fresh();
+    lv_obj_clear_flag(lv_obj_get_child(cont, 5), LV_OBJ_FLAG_HIDDEN);
+    check_same_as_fresh();
+
+    lv_obj_set_style_translate_x(lv_obj_get_child(cont, 40), 7, 0);
+    check_same_as_fresh();
+
+    lv_obj_del(lv_obj_get_child(cont, 50));
+    check_same_as_fresh();
+    item_create(50);
+    check_same_as_fresh();
+    lv_obj_move_to_index(lv_obj_get_child(cont, -1), 3);
+    check_same_as_fresh();
+    lv_obj_swap(lv_obj_get_child(cont, 20), lv_obj_get_child(cont, 21));
+    check_same_as_fresh();
+
+    /*The container changes*/
+    lv_obj_set_width(cont, 250);
+    check_same_as_fresh();
+    lv_obj_set_style_pad_row(cont, 8, 0);
+    check_same_as_fresh();
+    lv_obj_set_style_base_dir(cont, LV_BASE_DIR_RTL, 0);
+    check_same_as_fresh();
+}
+
+void test_layout_update_flex(void)
+{
+    static const lv_flex_flow_t flows[] = {
+        LV_FLEX_FLOW_ROW_WRAP, LV_FLEX_FLOW_ROW_WRAP_REVERSE, LV_FLEX_FLOW_COLUMN_WRAP, LV_FLEX_FLOW_ROW
+    };
+    static const lv_flex_align_t track_places[] = {
+        LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_END
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(flows) / sizeof(flows[0]); i++) {
+        lv_obj_set_flex_flow(cont, flows[i]);
+        lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, track_places[i]);
+        change_items();
+
+        /*Grow items and new tracks*/
+        lv_obj_set_flex_grow(lv_obj_get_child(cont, 20), 1);
+        check_same_as_fresh();
+        lv_obj_set_style_max_width(lv_obj_get_child(cont, 20), 40, 0);
+        check_same_as_fresh();
+        lv_obj_add_flag(lv_obj_get_child(cont, 45), LV_OBJ_FLAG_FLEX_IN_NEW_TRACK);
+        check_same_as_fresh();
+        lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_END, track_places[i]);
+        check_same_as_fresh();
+
+        lv_obj_clean(cont);
+        lv_obj_set_width(cont, 300);
+        lv_obj_set_style_base_dir(cont, LV_BASE_DIR_LTR, 0);
+    }
+}
+
+void test_layout_update_grid(void)
+{
+    static const lv_coord_t col_dsc[] = {40, LV_GRID_CONTENT, LV_GRID_FR(1), LV_GRID_CONTENT, 30, LV_GRID_FR(2), LV_GRID_TEMPLATE_LAST};
+    static const lv_coord_t row_dsc[] = {LV_GRID_CONTENT, LV_GRID_CONTENT, 20, LV_GRID_CONTENT, LV_GRID_CONTENT,
+                                         LV_GRID_FR(1), LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_CONTENT,
+                                         LV_GRID_TEMPLATE_LAST
+                                        };
+    static const lv_grid_align_t aligns[] = {
+        LV_GRID_ALIGN_START, LV_GRID_ALIGN_CENTER, LV_GRID_ALIGN_END, LV_GRID_ALIGN_STRETCH
+    };
+
+    lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+
+    uint32_t i;
+    for(i = 0; i < ITEM_CNT; i++) {
+        lv_obj_t * item = item_create(i);
+        uint8_t span = i % 7 == 0 && i % 6 != 5 ? 2 : 1;
+        lv_obj_set_grid_cell(item, aligns[i % 4], i % 6, span, aligns[(i / 4) % 4], i / 6, 1);
+    }
+    check_same_as_fresh();
+
+    /*Content sized tracks change*/
+    lv_obj_set_width(lv_obj_get_child(cont, 1), 70);
+    check_same_as_fresh();
+    lv_obj_set_height(lv_obj_get_child(cont, 20), 50);
+    check_same_as_fresh();
+
+    /*Not content sized tracks don't change*/
+    lv_obj_set_width(lv_obj_get_child(cont, 4), 12);
+    check_same_as_fresh();
+
+    lv_obj_set_grid_cell(lv_obj_get_child(cont, 8), LV_GRID_ALIGN_END, 3, 1, LV_GRID_ALIGN_START, 9, 1);
+    check_same_as_fresh();
+    lv_obj_add_flag(lv_obj_get_child(cont, 13), LV_OBJ_FLAG_HIDDEN);
+    check_same_as_fresh();
+    lv_obj_set_style_translate_y(lv_obj_get_child(cont, 25), 5, 0);
+    check_same_as_fresh();
+    lv_obj_del(lv_obj_get_child(cont, 30));
+    check_same_as_fresh();
+
+    lv_obj_set_grid_align(cont, LV_GRID_ALIGN_SPACE_BETWEEN, LV_GRID_ALIGN_CENTER);
+    check_same_as_fresh();
+    lv_obj_set_height(cont, 500);
+    check_same_as_fresh();
+    lv_obj_set_style_base_dir(cont, LV_BASE_DIR_RTL, 0);
+    check_same_as_fresh();
+}
+
+static void layout_changed_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+static uint32_t get_layout_changed_cnt(uint32_t * cnt)
+{
+    uint32_t ret = *cnt;
+    *cnt = 0;
+    return ret;
+}
+
+void test_layout_update_dirty_subtree(void)
+{
+    /*Cards with fixed size in a wrapping flex container, like a dashboard*/
+    static uint32_t cont_cnt;
+    static uint32_t card_cnt[12];
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_add_event_cb(cont, layout_changed_cb, LV_EVENT_LAYOUT_CHANGED, &cont_cnt);
+
+    lv_obj_t * labels[12];
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * card = lv_obj_create(cont);
+        lv_obj_set_size(card, 90, 90);
+        lv_obj_set_flex_flow(card, LV_FLEX_FLOW_COLUMN);
+        lv_obj_add_event_cb(card, layout_changed_cb, LV_EVENT_LAYOUT_CHANGED, &card_cnt[i]);
+        lv_label_create(card);
+        labels[i] = lv_label_create(card);
+        lv_label_set_text(labels[i], "1");
+        lv_label_create(card);
+    }
+
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_FALSE(lv_scr_act()->child_layout_inv);
+    get_layout_changed_cnt(&cont_cnt);
+    for(i = 0; i < 12; i++) get_layout_changed_cnt(&card_cnt[i]);
+
+    /*Only the card of the label is updated*/
+    lv_label_set_text(labels[7], "A longer text\nin two lines");
+    TEST_ASSERT_TRUE(lv_scr_act()->child_layout_inv);
+    TEST_ASSERT_TRUE(cont->child_layout_inv);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_FALSE(lv_scr_act()->child_layout_inv);
+    TEST_ASSERT_FALSE(cont->child_layout_inv);
+
+    TEST_ASSERT_EQUAL(0, get_layout_changed_cnt(&cont_cnt));
+    for(i = 0; i < 12; i++) {
+        uint32_t cnt = get_layout_changed_cnt(&card_cnt[i]);
+        if(i == 7) TEST_ASSERT_NOT_EQUAL(0, cnt);
+        else TEST_ASSERT_EQUAL(0, cnt);
+    }
+
+    /*The labels below the changed one are moved*/
+    lv_obj_t * card = lv_obj_get_parent(labels[7]);
+    lv_obj_t * next = lv_obj_get_child(card, 2);
+    TEST_ASSERT_EQUAL(labels[7]->coords.y2 + 1 + lv_obj_get_style_pad_row(card, 0), next->coords.y1);
+
+    /*A card which grows moves the other cards too, but their content is not updated*/
+    lv_obj_set_height(card, LV_SIZE_CONTENT);
+    lv_label_set_text(labels[7], "A longer text\nin\nfour\nlines");
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_NOT_EQUAL(0, get_layout_changed_cnt(&cont_cnt));
+    for(i = 0; i < 12; i++) {
+        uint32_t cnt = get_layout_changed_cnt(&card_cnt[i]);
+        if(i == 7) TEST_ASSERT_NOT_EQUAL(0, cnt);
+        else TEST_ASSERT_EQUAL(0, cnt);
+    }
+    check_same_as_fresh();
+}
+
+#endif
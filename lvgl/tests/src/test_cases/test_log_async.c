@@ -0,0 +1,279 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_LOG_USE_ASYNC && LV_LOG_LEVEL <= LV_LOG_LEVEL_USER
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#define LINE_MAX_CNT    512
+#define THREAD_CNT      (LV_LOG_ASYNC_THREAD_CNT)   /*One more than the free rings as the main thread has one*/
+#define THREAD_LOG_CNT  50
+
+static char lines[LINE_MAX_CNT][512];
+static uint32_t line_cnt;
+static pthread_mutex_t lines_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_barrier_t threads_barrier;
+
+static void print_cb(const char * buf)
+{
+    pthread_mutex_lock(&lines_mutex);
+    if(line_cnt < LINE_MAX_CNT) {
+        strncpy(lines[line_cnt], buf, sizeof(lines[0]) - 1);
+        lines[line_cnt][sizeof(lines[0]) - 1] = '\0';
+    }
+    line_cnt++;
+    pthread_mutex_unlock(&lines_mutex);
+}
+
+void setUp(void)
+{
+    lv_log_flush();
+    lv_log_register_print_cb(print_cb);
+    line_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_log_flush();
+    lv_log_register_print_cb(NULL);
+}
+
+/*Get the message of a log line between the function name and the file name*/
+static const char * get_msg(uint32_t i)
+{
+    static char msg[512];
+    const char * start = strstr(lines[i], ": ");
+    TEST_ASSERT_NOT_NULL(start);
+    start += 2;
+    const char * end = strstr(start, " \t(in ");
+    TEST_ASSERT_NOT_NULL(end);
+    memcpy(msg, start, end - start);
+    msg[end - start] = '\0';
+    return msg;
+}
+
+/*Log and compare with the synchronously formatted text*/
+#define CHECK_FORMAT(...) do { \
+        char exp[256]; \
+        lv_snprintf(exp, sizeof(exp), __VA_ARGS__); \
+        line_cnt = 0; \
+        LV_LOG_USER(__VA_ARGS__); \
+        lv_log_flush(); \
+        TEST_ASSERT_EQUAL(1, line_cnt); \
+        TEST_ASSERT_EQUAL_STRING(exp, get_msg(0)); \
+    } while(0)
+
+void test_log_async_format(void)
+{
+    CHECK_FORMAT("int %d %i %5d|%-5d| %+d %05d", -12, 34, 56, 78, 9, 42);
+    CHECK_FORMAT("uint %u %x %X %#o %lu %llu %zu", 1u, 255u, 0xabcu, 8u, 123456789UL, 1234567890123ULL, (size_t)77);
+    CHECK_FORMAT("long %ld %lld %hd %hhd %hu", -123456789L, -1234567890123LL, (short)-5, (signed char)-7,
+                 (unsigned short)65535);
+    CHECK_FORMAT("float %f %.2f %8.3f %g", 1.5, 3.14159, -2.5, 0.25);
+    CHECK_FORMAT("str %s|%10s|%-6s|%.3s %c%c %%", "text", "ab", "cd", "truncated", 'o', 'k');
+    CHECK_FORMAT("star %*d|%-*d|%.*f|%.*s", 6, 12, 4, 7, 2, 2.71828, 3, "abcdef");
+    CHECK_FORMAT("ptr %p", (void *)0x1234);
+    CHECK_FORMAT("no arguments");
+
+    /*The place of the log is printed too*/
+    TEST_ASSERT_NOT_NULL(strstr(lines[0], "[User]"));
+    TEST_ASSERT_NOT_NULL(strstr(lines[0], "[T0] test_log_async_format: "));
+    TEST_ASSERT_NOT_NULL(strstr(lines[0], "(in test_log_async.c line #"));
+}
+
+void test_log_async_copy_strings(void)
+{
+    /*The strings are printed as they were when logged*/
+    char str[32];
+    strcpy(str, "original");
+    LV_LOG_USER("str: %s, null: %s", str, (char *)NULL);
+    strcpy(str, "changed");
+
+    lv_log_flush();
+    TEST_ASSERT_EQUAL(1, line_cnt);
+    TEST_ASSERT_EQUAL_STRING("str: original, null: (null)", get_msg(0));
+
+    /*Too long strings are truncated*/
+    char long_str[400];
+    memset(long_str, 'a', sizeof(long_str) - 1);
+    long_str[sizeof(long_str) - 1] = '\0';
+    LV_LOG_USER("%s", long_str);
+    lv_log_flush();
+    TEST_ASSERT_EQUAL(2, line_cnt);
+    TEST_ASSERT_LESS_THAN(sizeof(long_str) - 1, strlen(lines[1]));
+
+    LV_LOG("raw %d\n", 5);
+    lv_log_flush();
+    TEST_ASSERT_EQUAL(3, line_cnt);
+    TEST_ASSERT_EQUAL_STRING("raw 5\n", lines[2]);
+}
+
+void test_log_async_rate_limit(void)
+{
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        line_cnt = 0;
+        uint32_t i;
+        for(i = 0; i < LV_LOG_ASYNC_RATE_LIMIT + 50; i++) {
+            LV_LOG_USER("flood %d", (int)i);
+        }
+        lv_log_flush();
+
+        TEST_ASSERT_EQUAL(LV_LOG_ASYNC_RATE_LIMIT, line_cnt);
+        if(round == 0) TEST_ASSERT_EQUAL_STRING("flood 0", get_msg(0));
+        else TEST_ASSERT_EQUAL_STRING("flood 0 (50 similar logs were suppressed)", get_msg(0));
+
+        /*Go to the next window*/
+        lv_tick_inc(1000);
+    }
+}
+
+void test_log_async_full(void)
+{
+    char str[201];
+    memset(str, 'b', sizeof(str) - 1);
+    str[sizeof(str) - 1] = '\0';
+
+    /*Fill the buffer from more lines to not reach the rate limit*/
+    uint32_t i;
+    for(i = 0; i < LV_LOG_ASYNC_RATE_LIMIT; i++) {
+        LV_LOG_USER("1 %s", str);
+        LV_LOG_USER("2 %s", str);
+        LV_LOG_USER("3 %s", str);
+    }
+    lv_log_flush();
+
+    /*All logs are either printed or counted as dropped*/
+    uint32_t printed = 0;
+    uint32_t dropped = 0;
+    uint32_t cnt = LV_MIN(line_cnt, LINE_MAX_CNT);
+    for(i = 0; i < cnt; i++) {
+        unsigned int d;
+        if(sscanf(lines[i], "[T0] %u logs were dropped", &d) == 1) dropped += d;
+        else printed++;
+    }
+    TEST_ASSERT_EQUAL(3 * LV_LOG_ASYNC_RATE_LIMIT, printed + dropped);
+}
+
+static void * thread_cb(void * arg)
+{
+    int id = (int)(intptr_t)arg;
+    int i;
+    for(i = 0; i < THREAD_LOG_CNT; i++) {
+        LV_LOG_USER("thread %d log %d", id, i);
+        if(i % 10 == 0) usleep(100);
+    }
+
+    /*Keep the ring until all threads logged as it's released when the thread exits*/
+    pthread_barrier_wait(&threads_barrier);
+    return NULL;
+}
+
+void test_log_async_threads(void)
+{
+    pthread_t threads[THREAD_CNT];
+    int i;
+    pthread_barrier_init(&threads_barrier, NULL, THREAD_CNT);
+    for(i = 0; i < THREAD_CNT; i++) pthread_create(&threads[i], NULL, thread_cb, (void *)(intptr_t)i);
+    for(i = 0; i < THREAD_CNT; i++) pthread_join(threads[i], NULL);
+    pthread_barrier_destroy(&threads_barrier);
+    lv_log_flush();
+
+    TEST_ASSERT_EQUAL(THREAD_CNT * THREAD_LOG_CNT, line_cnt);
+
+    /*The logs of each thread are in order. The thread which didn't get a ring logged synchronously.*/
+    int next[THREAD_CNT] = {0};
+    uint32_t sync_cnt = 0;
+    uint32_t l;
+    for(l = 0; l < line_cnt; l++) {
+        int id;
+        int n;
+        TEST_ASSERT_EQUAL(2, sscanf(get_msg(l), "thread %d log %d", &id, &n));
+        TEST_ASSERT_EQUAL(next[id], n);
+        next[id]++;
+        if(strstr(lines[l], "[T") == NULL) sync_cnt++;
+    }
+    TEST_ASSERT_EQUAL(THREAD_LOG_CNT, sync_cnt);
+}
+
+static void * short_thread_cb(void * arg)
+{
+    int id = (int)(intptr_t)arg;
+    LV_LOG_USER("short thread %d", id);
+
+    /*The others release the ring on exit*/
+    if(id % 2) {
+        lv_log_release_thread();
+        LV_LOG_USER("short thread %d again", id);
+        lv_log_release_thread();
+    }
+    return NULL;
+}
+
+void test_log_async_thread_exit(void)
+{
+    /*More threads than rings log one after the other. All of them should get a ring.*/
+    int i;
+    for(i = 0; i < 3 * LV_LOG_ASYNC_THREAD_CNT; i++) {
+        pthread_t thread;
+        pthread_create(&thread, NULL, short_thread_cb, (void *)(intptr_t)i);
+        pthread_join(thread, NULL);
+    }
+    lv_log_flush();
+
+    TEST_ASSERT_EQUAL(3 * LV_LOG_ASYNC_THREAD_CNT + 3 * LV_LOG_ASYNC_THREAD_CNT / 2, line_cnt);
+    uint32_t l;
+    for(l = 0; l < line_cnt; l++) {
+        TEST_ASSERT_NOT_NULL(strstr(lines[l], "[T"));
+    }
+}
+
+#else /*LV_LOG_USE_ASYNC && LV_LOG_LEVEL <= LV_LOG_LEVEL_USER*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_log_async_format(void)
+{
+
+}
+
+void test_log_async_copy_strings(void)
+{
+
+}
+
+void test_log_async_rate_limit(void)
+{
+
+}
+
+void test_log_async_full(void)
+{
+
+}
+
+void test_log_async_threads(void)
+{
+
+}
+
+void test_log_async_thread_exit(void)
+{
+
+}
+
+#endif
+
+#endif
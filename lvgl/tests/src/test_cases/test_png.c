@@ -0,0 +1,152 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../src/libs/png/lodepng.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#if LV_USE_PNG
+
+extern const lv_img_dsc_t img_wink_png;
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+/*Compare a row of the decoded image with the RGBA reference. Assumes LV_COLOR_DEPTH 32.*/
+static void check_row(const uint8_t * ref, uint32_t w, uint32_t x, uint32_t y, uint32_t len, const uint8_t * px)
+{
+    const uint8_t * ref_px = ref + (y * w + x) * 4;
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        lv_color32_t c;
+        c.full = px[i * 4] | (px[i * 4 + 1] << 8) | (px[i * 4 + 2] << 16) | ((uint32_t)px[i * 4 + 3] << 24);
+        char msg[64];
+        lv_snprintf(msg, sizeof(msg), "x: %d, y: %d", (int)(x + i), (int)y);
+        TEST_ASSERT_EQUAL_MESSAGE(ref_px[0], c.ch.red, msg);
+        TEST_ASSERT_EQUAL_MESSAGE(ref_px[1], c.ch.green, msg);
+        TEST_ASSERT_EQUAL_MESSAGE(ref_px[2], c.ch.blue, msg);
+        TEST_ASSERT_EQUAL_MESSAGE(ref_px[3], c.ch.alpha, msg);
+        ref_px += 4;
+    }
+}
+
+/*Decode an image with the PNG decoder and compare it with lodepng's result*/
+static void check_png(const void * src, const uint8_t * png_data, uint32_t png_size, bool read_line)
+{
+    uint8_t * ref = NULL;
+    unsigned int w;
+    unsigned int h;
+    unsigned int error = png_data ? lodepng_decode32(&ref, &w, &h, png_data, png_size) :
+                         lodepng_decode32_file(&ref, &w, &h, src);
+    TEST_ASSERT_EQUAL_MESSAGE(0, error, lodepng_error_text(error));
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(w, dsc.header.w);
+    TEST_ASSERT_EQUAL(h, dsc.header.h);
+    TEST_ASSERT_EQUAL(read_line, dsc.img_data == NULL);
+
+    uint32_t y;
+    if(dsc.img_data) {
+        for(y = 0; y < h; y++) check_row(ref, w, 0, y, w, dsc.img_data + y * w * 4);
+    }
+    else {
+        static uint8_t line[1024 * 4];
+        TEST_ASSERT_LESS_OR_EQUAL(1024, w);
+        for(y = 0; y < h; y++) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, w, line));
+            check_row(ref, w, 0, y, w, line);
+        }
+
+        /*Going back and reading parts of the lines should work too*/
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 5, 10, 20, line));
+        check_row(ref, w, 5, 10, 20, line);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 30, 10, 7, line));
+        check_row(ref, w, 30, 10, 7, line);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, 3, w, line));
+        check_row(ref, w, 0, 3, w, line);
+    }
+
+    lv_img_decoder_close(&dsc);
+    lv_free(ref);
+}
+
+static void check_png_file(const char * name, bool read_line)
+{
+    char path[64];
+
+    /*Read by the decoder in chunks*/
+    lv_snprintf(path, sizeof(path), "A:src/test_files/png/%s", name);
+    check_png(path, NULL, 0, read_line);
+
+    /*Decoded in place from the mapped memory*/
+    lv_snprintf(path, sizeof(path), "C:src/test_files/png/%s", name);
+    check_png(path, NULL, 0, read_line);
+}
+
+void test_png_rgba(void)
+{
+    /*All filter types and the image data split into multiple IDAT chunks*/
+    check_png_file("rgba.png", false);
+}
+
+void test_png_rgb_with_color_key(void)
+{
+    /*Not compressed (stored) deflate blocks*/
+    check_png_file("rgb_key.png", false);
+}
+
+void test_png_gray(void)
+{
+    check_png_file("gray1.png", false);
+    check_png_file("gray2.png", false);
+    check_png_file("gray4.png", false);
+    check_png_file("gray_alpha.png", false);
+}
+
+void test_png_palette(void)
+{
+    check_png_file("palette4.png", false);
+    check_png_file("palette8.png", false);
+}
+
+void test_png_not_streamed_formats(void)
+{
+    /*Decoded by lodepng*/
+    check_png_file("interlaced.png", false);
+    check_png_file("rgb16.png", false);
+}
+
+void test_png_from_variable(void)
+{
+    check_png(&img_wink_png, img_wink_png.data, img_wink_png.data_size, false);
+}
+
+void test_png_read_line(void)
+{
+    /*Larger than LV_PNG_READ_LINE_MIN_SIZE*/
+    check_png_file("large.png", true);
+}
+
+void test_png_no_leak(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+
+    check_png_file("rgba.png", false);
+    check_png_file("interlaced.png", false);
+    check_png_file("large.png", true);
+
+    TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem());
+}
+
+#endif
+
+#endif
@@ -0,0 +1,163 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PROFILER
+
+#include <string.h>
+
+static char trace_buf[256 * 1024];
+static uint32_t fake_tick;
+
+static uint32_t fake_tick_get_cb(void)
+{
+    return fake_tick;
+}
+
+static void trace_flush_cb(const char * buf)
+{
+    size_t len = strlen(trace_buf);
+    TEST_ASSERT_LESS_THAN(sizeof(trace_buf), len + strlen(buf));
+    strcpy(trace_buf + len, buf);
+}
+
+void setUp(void)
+{
+    trace_buf[0] = '\0';
+    fake_tick = 0;
+
+    lv_profiler_config_t config;
+    lv_profiler_config_init(&config);
+    config.tick_get_cb = fake_tick_get_cb;
+    config.tick_per_sec = 1000000;
+    config.flush_cb = trace_flush_cb;
+    lv_profiler_init(&config);
+}
+
+void tearDown(void)
+{
+    /*Restore the default configuration for the other tests*/
+    lv_profiler_config_t config;
+    lv_profiler_config_init(&config);
+    lv_profiler_init(&config);
+    lv_profiler_enable(false);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_profiler_should_write_chrome_trace(void)
+{
+    fake_tick = 1234567;
+    LV_PROFILER_BEGIN_TAG("my_span");
+    fake_tick = 1235000;
+    LV_PROFILER_END_TAG("my_span");
+    lv_profiler_flush();
+
+    TEST_ASSERT_EQUAL_STRING("[\n"
+                             "{\"name\":\"my_span\",\"ph\":\"B\",\"pid\":0,\"tid\":0,\"ts\":1234567},\n"
+                             "{\"name\":\"my_span\",\"ph\":\"E\",\"pid\":0,\"tid\":0,\"ts\":1235000}\n"
+                             "]\n", trace_buf);
+
+    /*The buffer is cleared after flushing*/
+    trace_buf[0] = '\0';
+    lv_profiler_flush();
+    TEST_ASSERT_EQUAL_STRING("[\n]\n", trace_buf);
+}
+
+void test_profiler_should_keep_the_latest_events_if_full(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_BUF_SIZE + 2; i++) {
+        fake_tick = i;
+        LV_PROFILER_BEGIN_TAG("wrap");
+    }
+    lv_profiler_flush();
+
+    /*The 2 oldest events are overwritten*/
+    TEST_ASSERT_NULL(strstr(trace_buf, "\"ts\":1}"));
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "[\n{\"name\":\"wrap\",\"ph\":\"B\",\"pid\":0,\"tid\":0,\"ts\":2},"));
+}
+
+void test_profiler_should_extend_wrapped_ticks(void)
+{
+    fake_tick = UINT32_MAX - 9;
+    LV_PROFILER_BEGIN_TAG("wrap");
+    fake_tick = 20;
+    LV_PROFILER_END_TAG("wrap");
+    /*A little out of order, e.g. written by an other thread*/
+    fake_tick = 15;
+    LV_PROFILER_BEGIN_TAG("late");
+    lv_profiler_flush();
+
+    TEST_ASSERT_EQUAL_STRING("[\n"
+                             "{\"name\":\"wrap\",\"ph\":\"B\",\"pid\":0,\"tid\":0,\"ts\":4294967286},\n"
+                             "{\"name\":\"wrap\",\"ph\":\"E\",\"pid\":0,\"tid\":0,\"ts\":4294967316},\n"
+                             "{\"name\":\"late\",\"ph\":\"B\",\"pid\":0,\"tid\":0,\"ts\":4294967311}\n"
+                             "]\n", trace_buf);
+}
+
+void test_profiler_should_not_record_if_disabled(void)
+{
+    lv_profiler_enable(false);
+    LV_PROFILER_BEGIN_TAG("hidden");
+    LV_PROFILER_END_TAG("hidden");
+    lv_profiler_flush();
+
+    TEST_ASSERT_EQUAL_STRING("[\n]\n", trace_buf);
+}
+
+void test_profiler_should_trace_rendering_per_class(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Hello");
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_profiler_flush();
+
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "\"name\":\"refr_area\",\"ph\":\"B\""));
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "\"name\":\"obj\",\"ph\":\"B\""));
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "\"name\":\"label\",\"ph\":\"E\""));
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "\"name\":\"lv_draw_letter\",\"ph\":\"B\""));
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "\"name\":\"flush_cb\",\"ph\":\"E\""));
+}
+
+#else /*LV_USE_PROFILER*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_profiler_should_write_chrome_trace(void)
+{
+
+}
+
+void test_profiler_should_keep_the_latest_events_if_full(void)
+{
+
+}
+
+void test_profiler_should_extend_wrapped_ticks(void)
+{
+
+}
+
+void test_profiler_should_not_record_if_disabled(void)
+{
+
+}
+
+void test_profiler_should_trace_rendering_per_class(void)
+{
+
+}
+
+#endif /*LV_USE_PROFILER*/
+
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,195 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#if LV_USE_READOUT
+
+static lv_obj_t * readout;
+static lv_color_t fb[800 * 480];
+
+void setUp(void)
+{
+    readout = lv_readout_create(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+/*Keep the whole screen's content, not only the last flushed area as the test display does*/
+static void fb_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * 800 + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void check_text(int32_t value, const char * expected)
+{
+    lv_readout_set_value(readout, value);
+    TEST_ASSERT_EQUAL_STRING(expected, lv_label_get_text(readout));
+}
+
+void test_readout_text(void)
+{
+    lv_readout_set_format(readout, "%d ppm", 4, 0);
+    check_text(415, "415 ppm");
+    check_text(1024, "1024 ppm");
+    check_text(0, "0 ppm");
+    check_text(-12, "-12 ppm");
+    TEST_ASSERT_EQUAL(-12, lv_readout_get_value(readout));
+
+    /*Limited to the digit cells*/
+    check_text(12345, "9999 ppm");
+    check_text(-12345, "-999 ppm");
+
+    lv_readout_set_format(readout, "T: %d°C", 3, 1);
+    check_text(253, "T: 25.3°C");
+    check_text(5, "T: 0.5°C");
+    check_text(-5, "T: -0.5°C");
+    check_text(1000, "T: 99.9°C");
+
+    lv_readout_set_format(readout, "%d%%", 3, 0);
+    check_text(45, "45%");
+}
+
+void test_readout_fixed_size(void)
+{
+    lv_readout_set_format(readout, "%d lux", 4, 0);
+    lv_readout_set_value(readout, 1111);
+    lv_obj_update_layout(readout);
+    lv_coord_t w = lv_obj_get_width(readout);
+    lv_coord_t h = lv_obj_get_height(readout);
+    TEST_ASSERT_GREATER_THAN(lv_txt_get_width("1111 lux", 8, &lv_font_montserrat_14, 0, LV_TEXT_FLAG_NONE), w);
+
+    lv_readout_set_value(readout, 8888);
+    lv_obj_update_layout(readout);
+    TEST_ASSERT_EQUAL(w, lv_obj_get_width(readout));
+    TEST_ASSERT_EQUAL(h, lv_obj_get_height(readout));
+
+    lv_readout_set_value(readout, 7);
+    lv_obj_update_layout(readout);
+    TEST_ASSERT_EQUAL(w, lv_obj_get_width(readout));
+}
+
+void test_readout_invalidate_changed_digits(void)
+{
+    lv_readout_set_format(readout, "%d ppm", 4, 0);
+    lv_readout_set_value(readout, 1023);
+    lv_obj_center(readout);
+    lv_refr_now(NULL);
+
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+
+    /*Only the last digit is invalidated*/
+    lv_readout_set_value(readout, 1024);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_LESS_THAN(lv_obj_get_width(readout) / 4, lv_area_get_width(&disp->inv_areas[0]));
+
+    /*Nothing changed*/
+    lv_refr_now(NULL);
+    lv_readout_set_value(readout, 1024);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+}
+
+void test_readout_same_rendering_as_full_redraw(void)
+{
+    static lv_color_t ref_fb[800 * 480];
+
+    lv_disp_t * disp = lv_disp_get_default();
+    void (*flush_cb_ori)(struct _lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver->flush_cb;
+    disp->driver->flush_cb = fb_flush_cb;
+
+#if LV_FONT_MONTSERRAT_24
+    lv_obj_set_style_text_font(readout, &lv_font_montserrat_24, 0);
+#endif
+    lv_readout_set_format(readout, "%d°C", 3, 1);
+    lv_obj_center(readout);
+    refr_screen();
+
+    static const int32_t values[] = {253, 259, 260, 5, -5, 199, 200, 111};
+    uint32_t i;
+    for(i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        /*Draw only the changed digits*/
+        lv_readout_set_value(readout, values[i]);
+        lv_refr_now(NULL);
+        lv_memcpy(ref_fb, fb, sizeof(ref_fb));
+
+        refr_screen();
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, fb, sizeof(ref_fb));
+    }
+
+    disp->driver->flush_cb = flush_cb_ori;
+}
+
+void test_readout_no_leak(void)
+{
+    lv_obj_del(readout);
+
+    size_t mem_before = lv_test_get_free_mem();
+
+    readout = lv_readout_create(lv_scr_act());
+    lv_readout_set_format(readout, "%d ppm", 4, 0);
+    lv_readout_set_value(readout, 1234);
+    lv_readout_set_format(readout, "A longer text: %d%%", 3, 1);
+    lv_readout_set_value(readout, 567);
+    lv_obj_del(readout);
+
+    TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem());
+}
+
+#else /*LV_USE_READOUT*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_readout_text(void)
+{
+
+}
+
+void test_readout_fixed_size(void)
+{
+
+}
+
+void test_readout_invalidate_changed_digits(void)
+{
+
+}
+
+void test_readout_same_rendering_as_full_redraw(void)
+{
+
+}
+
+void test_readout_no_leak(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,234 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_SW_RING_CACHE_SIZE
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[800 * 480];
+static lv_draw_mask_fade_param_t fade_param;
+static int16_t fade_id;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_remove_event_cb(lv_scr_act(), NULL);
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Add a mask which doesn't change anything but it makes the arcs and rectangles to be drawn with the masks
+ *instead of the cache*/
+static void no_cache_event_cb(lv_event_t * e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        lv_area_t a;
+        lv_area_set(&a, -100, -100, -10, -10);
+        lv_draw_mask_fade_init(&fade_param, &a, LV_OPA_TRANSP, -100, LV_OPA_TRANSP, -10);
+        fade_id = lv_draw_mask_add(&fade_param, NULL);
+    }
+    else if(code == LV_EVENT_DRAW_POST_END) {
+        lv_draw_mask_free_param(&fade_param);
+        lv_draw_mask_remove_id(fade_id);
+    }
+}
+
+/*Render the screen with and without the cache and compare the results*/
+static void check_same_as_not_cached(void)
+{
+    refr_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_obj_add_event_cb(lv_scr_act(), no_cache_event_cb, LV_EVENT_ALL, NULL);
+    refr_screen();
+    lv_obj_remove_event_cb(lv_scr_act(), no_cache_event_cb);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+static lv_obj_t * arc_create(lv_coord_t x, lv_coord_t y, lv_coord_t size, lv_coord_t width, bool rounded)
+{
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
+    lv_obj_set_pos(arc, x, y);
+    lv_obj_set_size(arc, size, size);
+    lv_obj_set_style_arc_width(arc, width, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(arc, width, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_rounded(arc, rounded, LV_PART_MAIN);
+    lv_obj_set_style_arc_rounded(arc, rounded, LV_PART_INDICATOR);
+    return arc;
+}
+
+void test_ring_cache_arc_same_as_masks(void)
+{
+    static const lv_coord_t sizes[] = {9, 20, 31, 64, 101, 150};
+    static const lv_coord_t widths[] = {1, 4, 10, 15, 30, 80};
+    uint32_t i;
+    for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        lv_obj_t * arc = arc_create(10 + i * 125, 10, sizes[i], widths[i], i & 1);
+        lv_arc_set_value(arc, 35);
+
+        /*Full rings*/
+        arc = arc_create(10 + i * 125, 170, sizes[i], widths[i], false);
+        lv_arc_set_bg_angles(arc, 0, 360);
+        lv_arc_set_angles(arc, 0, 360);
+        lv_obj_set_style_arc_color(arc, lv_palette_main(LV_PALETTE_RED), LV_PART_INDICATOR);
+        lv_obj_set_style_arc_opa(arc, LV_OPA_TRANSP, LV_PART_MAIN);
+
+        /*Small arcs in one quarter and arcs with a small gap*/
+        arc = arc_create(10 + i * 125, 330, sizes[i], widths[i], !(i & 1));
+        lv_arc_set_bg_angles(arc, 100 + i * 40, 95 + i * 40);
+        lv_arc_set_angles(arc, 10 + i * 90, 40 + i * 90);
+    }
+
+    check_same_as_not_cached();
+}
+
+void test_ring_cache_arc_changing_angles(void)
+{
+    lv_obj_t * arc = arc_create(300, 140, 200, 25, true);
+    lv_arc_set_bg_angles(arc, 0, 360);
+
+    uint32_t i;
+    for(i = 0; i < 360; i += 25) {
+        lv_arc_set_angles(arc, i, i + 70 + i / 2);
+        check_same_as_not_cached();
+    }
+}
+
+void test_ring_cache_arc_eviction(void)
+{
+    /*Draw more rings than fit into the cache*/
+    uint32_t i;
+    for(i = 0; i < 24; i++) {
+        lv_obj_t * arc = arc_create((i % 8) * 100, (i / 8) * 160, 90 + i, 30 + i, false);
+        lv_arc_set_value(arc, 70);
+    }
+
+    check_same_as_not_cached();
+    check_same_as_not_cached();
+}
+
+static lv_obj_t * rect_create(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, lv_coord_t radius,
+                              lv_coord_t border_width)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_border_width(obj, border_width, 0);
+    lv_obj_set_style_border_color(obj, lv_palette_darken(LV_PALETTE_ORANGE, 2), 0);
+    return obj;
+}
+
+void test_ring_cache_rect_same_as_masks(void)
+{
+    static const lv_coord_t radii[] = {1, 3, 6, 10, 17, 30, LV_RADIUS_CIRCLE};
+    static const lv_coord_t border_widths[] = {0, 1, 2, 5};
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+        for(j = 0; j < sizeof(border_widths) / sizeof(border_widths[0]); j++) {
+            lv_obj_t * obj = rect_create(10 + i * 110, 10 + j * 110, 90 + j * 3, 70 + i * 4, radii[i], border_widths[j]);
+            if((i + j) % 3 == 1) lv_obj_set_style_bg_opa(obj, LV_OPA_60, 0);
+            if((i + j) % 3 == 2) lv_obj_set_style_border_opa(obj, LV_OPA_70, 0);
+            if(j == 3) {
+                lv_obj_set_style_outline_width(obj, 3, 0);
+                lv_obj_set_style_outline_pad(obj, 2, 0);
+                lv_obj_set_style_outline_color(obj, lv_palette_main(LV_PALETTE_GREEN), 0);
+            }
+        }
+    }
+
+    /*Partially clipped by the screen*/
+    rect_create(-20, -15, 100, 60, 25, 3);
+    rect_create(760, 450, 100, 60, 25, 3);
+
+    /*Smaller than the border and the radius*/
+    rect_create(700, 300, 12, 8, 10, 5);
+
+    check_same_as_not_cached();
+}
+
+void test_ring_cache_rect_partial_redraw(void)
+{
+    rect_create(100, 100, 300, 200, 40, 6);
+    refr_screen();
+
+    /*Redraw the rectangle in small pieces to clip the corners in every possible way*/
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 90; y < 310; y += 13) {
+        for(x = 90; x < 410; x += 17) {
+            lv_area_t a;
+            lv_area_set(&a, x, y, x + 16, y + 12);
+            uint32_t size = lv_area_get_size(&a) * sizeof(lv_color_t);
+
+            _lv_inv_area(NULL, &a);
+            lv_refr_now(NULL);
+            lv_memcpy(ref_fb, test_fb, size);
+
+            lv_obj_add_event_cb(lv_scr_act(), no_cache_event_cb, LV_EVENT_ALL, NULL);
+            _lv_inv_area(NULL, &a);
+            lv_refr_now(NULL);
+            lv_obj_remove_event_cb(lv_scr_act(), no_cache_event_cb);
+
+            TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, size);
+        }
+    }
+}
+
+#else /*LV_DRAW_SW_RING_CACHE_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_ring_cache_arc_same_as_masks(void)
+{
+
+}
+
+void test_ring_cache_arc_changing_angles(void)
+{
+
+}
+
+void test_ring_cache_arc_eviction(void)
+{
+
+}
+
+void test_ring_cache_rect_same_as_masks(void)
+{
+
+}
+
+void test_ring_cache_rect_partial_redraw(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+
+#define CELL_W  160
+#define CELL_H  120
+#define CELL_CNT    ((800 / CELL_W) * (480 / CELL_H))
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[800 * 480];
+static lv_obj_t * objs[CELL_CNT];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Draw a shadow which fills the whole cache to remove every other corner from it*/
+static void clear_shadow_cache(void)
+{
+    lv_coord_t r = 4;
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 200, 200);
+    lv_obj_center(obj);
+    lv_obj_set_style_radius(obj, r, 0);
+    lv_obj_set_style_shadow_width(obj, LV_DRAW_SW_SHADOW_CACHE_SIZE - r, 0);
+    refr_screen();
+    lv_obj_del(obj);
+}
+
+static lv_obj_t * shadow_create(uint32_t i, lv_coord_t w, lv_coord_t h, lv_coord_t radius, lv_coord_t sw,
+                                lv_coord_t spread, lv_coord_t ofs)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_50, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_pos(obj, (i % (800 / CELL_W)) * CELL_W + (CELL_W - w) / 2, (i / (800 / CELL_W)) * CELL_H + (CELL_H - h) / 2);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_shadow_width(obj, sw, 0);
+    lv_obj_set_style_shadow_spread(obj, spread, 0);
+    lv_obj_set_style_shadow_ofs_x(obj, ofs, 0);
+    lv_obj_set_style_shadow_ofs_y(obj, ofs, 0);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_COVER - i * 5, 0);
+    objs[i] = obj;
+    return obj;
+}
+
+static void copy_cell(lv_color_t * dst, const lv_color_t * src, uint32_t i)
+{
+    lv_coord_t y;
+    for(y = 0; y < CELL_H; y++) {
+        uint32_t ofs = ((i / (800 / CELL_W)) * CELL_H + y) * 800 + (i % (800 / CELL_W)) * CELL_W;
+        lv_memcpy(&dst[ofs], &src[ofs], CELL_W * sizeof(lv_color_t));
+    }
+}
+
+/*Render the shadows one by one with an empty cache*/
+static void render_ref(void)
+{
+    uint32_t i;
+    for(i = 0; i < CELL_CNT; i++) lv_obj_add_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+
+    for(i = 0; i < CELL_CNT; i++) {
+        clear_shadow_cache();
+        lv_obj_clear_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+        refr_screen();
+        copy_cell(ref_fb, test_fb, i);
+        lv_obj_add_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+    }
+
+    for(i = 0; i < CELL_CNT; i++) lv_obj_clear_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+}
+
+void test_shadow_cache_same_as_not_cached(void)
+{
+    uint32_t i;
+    for(i = 0; i < CELL_CNT; i++) {
+        /*Many shadows with the same width and radius but different sizes, spreads and offsets*/
+        lv_coord_t sw = 5 + (i % 4) * 9;
+        lv_coord_t radius = (i % 3) * 8;
+        lv_coord_t w = 10 + (i * 13) % 60;
+        lv_coord_t h = 6 + (i * 7) % 50;
+        shadow_create(i, w, h, radius, sw, (i % 5) - 2, (i % 3) - 1);
+    }
+
+    render_ref();
+
+    /*Render twice to draw some shadows from the cache and others after they were evicted*/
+    refr_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    refr_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+void test_shadow_cache_small_objects(void)
+{
+    /*The far edges of small objects are blurred into the corners so they can't share the corners*/
+    uint32_t i;
+    for(i = 0; i < CELL_CNT; i++) {
+        shadow_create(i, 2 + i, 2 + (i * 3) % 17, 4, 30, 0, 0);
+    }
+
+    render_ref();
+
+    refr_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+#else /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_shadow_cache_same_as_not_cached(void)
+{
+
+}
+
+void test_shadow_cache_small_objects(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,194 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_SJPG && LV_SJPG_CACHE_FRAMES >= 2
+
+#include <unistd.h>
+
+/*320x240 image with 15 strips of 16 rows*/
+#define SRC_FILE    "A:src/test_files/sjpg/small_image.sjpg"
+#define IMG_W       320
+#define IMG_H       240
+#define STRIP_CNT   15
+
+static uint8_t ref[IMG_H][IMG_W * sizeof(lv_color_t)];
+static uint8_t line[IMG_W * sizeof(lv_color_t)];
+
+void setUp(void)
+{
+    /*Read the image from top to bottom as the reference*/
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SRC_FILE, lv_color_black(), 0));
+    TEST_ASSERT_NULL(dsc.img_data);
+    lv_coord_t y;
+    for(y = 0; y < IMG_H; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, IMG_W, ref[y]));
+    }
+    lv_img_decoder_close(&dsc);
+
+    /*Start every test without decoded strips*/
+    lv_split_jpeg_invalidate(NULL);
+    lv_split_jpeg_reset_stats();
+}
+
+void tearDown(void)
+{
+}
+
+static void check_line(lv_img_decoder_dsc_t * dsc, lv_coord_t y)
+{
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, 0, y, IMG_W, line));
+    TEST_ASSERT_EQUAL_MEMORY(ref[y], line, sizeof(line));
+}
+
+/*Read the top and the bottom of the image alternately like when it's drawn in two areas*/
+static void check_two_areas(const void * src)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+
+    lv_split_jpeg_reset_stats();
+    lv_coord_t y;
+    for(y = 0; y < 128; y++) {
+        check_line(&dsc, y);
+        if(y + 128 < IMG_H) check_line(&dsc, y + 128);
+    }
+    lv_img_decoder_close(&dsc);
+
+    /*Every strip is decoded only once*/
+    lv_split_jpeg_stats_t stats;
+    lv_split_jpeg_get_stats(&stats);
+    TEST_ASSERT_EQUAL(STRIP_CNT, stats.decode_cnt + stats.prefetch_cnt);
+    TEST_ASSERT_GREATER_THAN(100, stats.hit_cnt);
+}
+
+void test_sjpg_strips_are_cached_from_file(void)
+{
+    check_two_areas(SRC_FILE);
+}
+
+void test_sjpg_strips_are_cached_from_variable(void)
+{
+    static uint8_t data[32 * 1024];
+    lv_fs_file_t f;
+    uint32_t size;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, SRC_FILE, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, data, sizeof(data), &size));
+    lv_fs_close(&f);
+
+    lv_img_dsc_t img;
+    lv_memzero(&img, sizeof(img));
+    img.header.cf = LV_IMG_CF_RAW;
+    img.header.w = IMG_W;
+    img.header.h = IMG_H;
+    img.data = data;
+    img.data_size = size;
+    check_two_areas(&img);
+}
+
+void test_sjpg_strips_are_kept_after_close(void)
+{
+    /*Draw the top of the image twice like without image cache*/
+    lv_split_jpeg_stats_t stats;
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_img_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SRC_FILE, lv_color_black(), 0));
+        lv_coord_t y;
+        for(y = 0; y < 32; y++) check_line(&dsc, y);
+        lv_img_decoder_close(&dsc);
+
+        lv_split_jpeg_get_stats(&stats);
+        if(i == 0) lv_split_jpeg_reset_stats();
+    }
+
+    TEST_ASSERT_EQUAL(0, stats.decode_cnt);
+    TEST_ASSERT_EQUAL(0, stats.prefetch_cnt);
+
+    /*Invalidated strips are decoded again*/
+    lv_split_jpeg_invalidate(SRC_FILE);
+    lv_split_jpeg_reset_stats();
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SRC_FILE, lv_color_black(), 0));
+    check_line(&dsc, 0);
+    lv_img_decoder_close(&dsc);
+    lv_split_jpeg_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.decode_cnt);
+
+    /*The image cache drops the strips too*/
+    lv_img_cache_invalidate_src(SRC_FILE);
+    lv_split_jpeg_reset_stats();
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SRC_FILE, lv_color_black(), 0));
+    check_line(&dsc, 0);
+    lv_img_decoder_close(&dsc);
+    lv_split_jpeg_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.decode_cnt);
+}
+
+#if LV_SJPG_USE_PREFETCH
+void test_sjpg_prefetch(void)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SRC_FILE, lv_color_black(), 0));
+
+    lv_split_jpeg_reset_stats();
+    lv_coord_t y;
+    for(y = 0; y < IMG_H; y++) {
+        check_line(&dsc, y);
+        /*Give time to the worker to decode the next strip*/
+        if(y % 16 == 0) usleep(20000);
+    }
+    lv_img_decoder_close(&dsc);
+
+    /*Only the first strip has to be decoded while reading the lines*/
+    lv_split_jpeg_stats_t stats;
+    lv_split_jpeg_get_stats(&stats);
+    TEST_ASSERT_EQUAL(STRIP_CNT, stats.decode_cnt + stats.prefetch_cnt);
+    TEST_ASSERT_EQUAL(1, stats.decode_cnt);
+}
+#else /*LV_SJPG_USE_PREFETCH*/
+
+void test_sjpg_prefetch(void)
+{
+
+}
+
+#endif
+
+#else /*LV_USE_SJPG && LV_SJPG_CACHE_FRAMES >= 2*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_sjpg_strips_are_cached_from_file(void)
+{
+
+}
+
+void test_sjpg_strips_are_cached_from_variable(void)
+{
+
+}
+
+void test_sjpg_strips_are_kept_after_close(void)
+{
+
+}
+
+void test_sjpg_prefetch(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -2,6 +2,7 @@
 #include "../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_indev.h"
 
 static lv_obj_t * scr = NULL;
 static lv_obj_t * table = NULL;
@@ -244,4 +245,192 @@ void test_table_should_reduce_cells_with_more_than_one_row(void)
     }
 }
 
+#if LV_TABLE_VIRTUAL
+
+#define VIRT_ROW_CNT 100000
+
+static uint32_t virt_min_row;
+static uint32_t virt_max_row;
+static uint32_t virt_cell_cnt;
+
+static const char * virt_cb(lv_obj_t * obj, uint32_t row, uint16_t col, char * buf, uint32_t buf_size)
+{
+    LV_UNUSED(obj);
+    if(row < virt_min_row) virt_min_row = row;
+    if(row > virt_max_row) virt_max_row = row;
+    virt_cell_cnt++;
+
+    lv_snprintf(buf, buf_size, "%d/%d", (int)row, (int)col);
+    return buf;
+}
+
+static void virt_refr(void)
+{
+    virt_min_row = UINT32_MAX;
+    virt_max_row = 0;
+    virt_cell_cnt = 0;
+    lv_obj_invalidate(table);
+    lv_refr_now(NULL);
+}
+
+static lv_coord_t virt_create(void)
+{
+    lv_obj_set_size(table, 300, 200);
+    /*To not draw the rows above and below into the padding*/
+    lv_obj_set_style_pad_ver(table, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(table, 0, LV_PART_MAIN);
+    lv_table_set_col_cnt(table, 3);
+    lv_table_set_virtual(table, VIRT_ROW_CNT, virt_cb);
+    lv_obj_update_layout(table);
+    return ((lv_table_t *)table)->virt->row_h;
+}
+
+void test_table_virtual_should_draw_only_the_visible_rows(void)
+{
+    lv_coord_t row_h = virt_create();
+    TEST_ASSERT_EQUAL_UINT32(VIRT_ROW_CNT, lv_table_get_virtual_row_cnt(table));
+    TEST_ASSERT_EQUAL_UINT16(0, lv_table_get_row_cnt(table));
+
+    virt_refr();
+    uint32_t visible_row_cnt = lv_obj_get_content_height(table) / row_h + 1;
+    TEST_ASSERT_EQUAL_UINT32(0, virt_min_row);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(visible_row_cnt, virt_max_row);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32((visible_row_cnt + 1) * 3, virt_cell_cnt);
+}
+
+void test_table_virtual_should_scroll_to_any_row(void)
+{
+    virt_create();
+
+    lv_table_scroll_to_row(table, 54321, LV_ANIM_OFF);
+    virt_refr();
+    TEST_ASSERT_EQUAL_UINT32(54321, virt_min_row);
+
+    lv_table_scroll_to_row(table, 10, LV_ANIM_OFF);
+    virt_refr();
+    TEST_ASSERT_EQUAL_UINT32(10, virt_min_row);
+
+    /*The last row can't be on the top but it should be visible*/
+    lv_table_scroll_to_row(table, VIRT_ROW_CNT - 1, LV_ANIM_OFF);
+    virt_refr();
+    TEST_ASSERT_EQUAL_UINT32(VIRT_ROW_CNT - 1, virt_max_row);
+    TEST_ASSERT_GREATER_THAN_UINT32(VIRT_ROW_CNT - 20, virt_min_row);
+}
+
+void test_table_virtual_should_scroll_continuously(void)
+{
+    lv_coord_t row_h = virt_create();
+
+    /*Scroll by 2000 rows which is more than the scrollable window*/
+    uint32_t i;
+    for(i = 0; i < 400; i++) {
+        lv_obj_scroll_by(table, 0, -5 * row_h, LV_ANIM_OFF);
+        /*Only a window of rows is scrollable*/
+        TEST_ASSERT_LESS_THAN(4096, lv_obj_get_scroll_y(table));
+    }
+
+    virt_refr();
+    TEST_ASSERT_EQUAL_UINT32(2000, virt_min_row);
+
+    /*And back*/
+    for(i = 0; i < 399; i++) {
+        lv_obj_scroll_by(table, 0, 5 * row_h, LV_ANIM_OFF);
+    }
+
+    virt_refr();
+    TEST_ASSERT_EQUAL_UINT32(5, virt_min_row);
+}
+
+void test_table_virtual_should_select_with_keys(void)
+{
+    virt_create();
+    lv_table_scroll_to_row(table, 500, LV_ANIM_OFF);
+
+    uint32_t key = LV_KEY_DOWN;
+    lv_event_send(table, LV_EVENT_KEY, &key);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_table_get_virtual_selected_row(table));
+
+    /*The selected row is scrolled into view*/
+    virt_refr();
+    TEST_ASSERT_EQUAL_UINT32(1, virt_min_row);
+
+    uint32_t i;
+    for(i = 0; i < 30; i++) lv_event_send(table, LV_EVENT_KEY, &key);
+    TEST_ASSERT_EQUAL_UINT32(31, lv_table_get_virtual_selected_row(table));
+    virt_refr();
+    /*The selected row is fully visible on the bottom, the next one can be partially visible*/
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(31, virt_max_row);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(32, virt_max_row);
+
+    uint16_t row;
+    uint16_t col;
+    lv_table_get_selected_cell(table, &row, &col);
+    TEST_ASSERT_EQUAL_UINT16(31, row);
+    TEST_ASSERT_EQUAL_UINT16(0, col);
+}
+
+void test_table_virtual_should_follow_the_row_count(void)
+{
+    virt_create();
+    lv_table_scroll_to_row(table, VIRT_ROW_CNT - 1, LV_ANIM_OFF);
+
+    /*The remaining rows fit to the table so it's scrolled back to the top*/
+    lv_table_set_virtual_row_cnt(table, 3);
+    virt_refr();
+    TEST_ASSERT_EQUAL_INT(0, lv_obj_get_scroll_y(table));
+    TEST_ASSERT_EQUAL_UINT32(0, virt_min_row);
+    TEST_ASSERT_EQUAL_UINT32(2, virt_max_row);
+
+    lv_table_set_virtual_row_cnt(table, 0);
+    virt_refr();
+    TEST_ASSERT_EQUAL_UINT32(0, virt_cell_cnt);
+}
+
+static uint32_t clicked_row;
+static uint32_t clicked_cnt;
+
+static void virt_clicked_cb(lv_event_t * e)
+{
+    clicked_row = lv_table_get_virtual_selected_row(lv_event_get_target(e));
+    clicked_cnt++;
+}
+
+void test_table_virtual_should_not_select_below_the_last_row(void)
+{
+    lv_coord_t row_h = virt_create();
+    lv_table_set_virtual_row_cnt(table, 3);
+    lv_obj_update_layout(table);
+    lv_obj_add_event_cb(table, virt_clicked_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    clicked_cnt = 0;
+
+    lv_test_mouse_click_at(table->coords.x1 + 10, table->coords.y1 + row_h + row_h / 2);
+    TEST_ASSERT_EQUAL_UINT32(1, clicked_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, clicked_row);
+
+    /*The table is larger than the 3 rows*/
+    lv_test_mouse_click_at(table->coords.x1 + 10, table->coords.y1 + 3 * row_h + row_h / 2);
+    lv_test_mouse_click_at(table->coords.x1 + 10, table->coords.y2 - 2);
+    TEST_ASSERT_EQUAL_UINT32(1, clicked_cnt);
+}
+
+void test_table_virtual_should_switch_back_to_normal(void)
+{
+    virt_create();
+
+    /*The normal API is ignored in virtual mode*/
+    lv_table_set_cell_value(table, 3, 0, "LVGL");
+    TEST_ASSERT_EQUAL_UINT16(0, lv_table_get_row_cnt(table));
+
+    lv_table_set_virtual(table, 0, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_table_get_virtual_row_cnt(table));
+    TEST_ASSERT_EQUAL_UINT16(1, lv_table_get_row_cnt(table));
+
+    lv_table_set_cell_value(table, 3, 0, "LVGL");
+    TEST_ASSERT_EQUAL_STRING("LVGL", lv_table_get_cell_value(table, 3, 0));
+    virt_refr();
+    TEST_ASSERT_EQUAL_UINT32(0, virt_cell_cnt);
+}
+
+#endif
+
 #endif
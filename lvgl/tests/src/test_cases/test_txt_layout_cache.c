@@ -0,0 +1,197 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#if LV_TXT_LAYOUT_CACHE_SIZE
+
+extern lv_color_t test_fb[];
+
+void setUp(void)
+{
+    lv_txt_layout_cache_clear();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+/*Measure the text without the cache, like `lv_txt_get_size` does*/
+static void get_size_ref(lv_point_t * size, const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+    if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
+
+    lv_coord_t line_height = lv_font_get_line_height(font);
+    uint32_t line_start = 0;
+    size->x = 0;
+    size->y = 0;
+    while(txt[line_start] != '\0') {
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_width, NULL, flag);
+        lv_coord_t w = lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        size->x = LV_MAX(size->x, w);
+        size->y += line_height + line_space;
+        line_start = line_end;
+    }
+
+    if(line_start != 0 && (txt[line_start - 1] == '\n' || txt[line_start - 1] == '\r')) size->y += line_height + line_space;
+
+    if(size->y == 0) size->y = line_height;
+    else size->y -= line_space;
+}
+
+static void check_size(const char * txt, lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_width,
+                       lv_text_flag_t flag)
+{
+    lv_point_t ref;
+    get_size_ref(&ref, txt, &lv_font_montserrat_14, letter_space, line_space, max_width, flag);
+
+    /*Measure twice to use the cached layout too*/
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_point_t size;
+        lv_txt_get_size(&size, txt, &lv_font_montserrat_14, letter_space, line_space, max_width, flag);
+        TEST_ASSERT_EQUAL_MESSAGE(ref.x, size.x, txt);
+        TEST_ASSERT_EQUAL_MESSAGE(ref.y, size.y, txt);
+    }
+}
+
+void test_txt_layout_cache_same_size(void)
+{
+    check_size("", 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    check_size("25.3 °C", 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    check_size("25.3 °C", 2, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    check_size("First line\nSecond line\n", 0, 5, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    check_size("A long text which is wrapped into multiple lines", 1, 3, 80, LV_TEXT_FLAG_NONE);
+    check_size("A long text which is not wrapped\nbut has 2 lines", 0, 0, 80, LV_TEXT_FLAG_EXPAND);
+    check_size("Some #ff0000 red# text", 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_RECOLOR);
+}
+
+void test_txt_layout_cache_lines(void)
+{
+    const char * txt = "Temperature\n25.3 °C";
+    const lv_txt_layout_t * layout = _lv_txt_get_layout(txt, &lv_font_montserrat_14, 0, LV_COORD_MAX,
+                                                        LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_NOT_NULL(layout);
+    TEST_ASSERT_EQUAL(2, layout->line_cnt);
+    TEST_ASSERT_EQUAL(0, layout->lines[0].start);
+    TEST_ASSERT_EQUAL(12, layout->lines[1].start);
+    TEST_ASSERT_EQUAL(strlen(txt), layout->lines[2].start);
+    TEST_ASSERT_EQUAL(lv_txt_get_width(txt, 12, &lv_font_montserrat_14, 0, LV_TEXT_FLAG_NONE), layout->lines[0].width);
+    TEST_ASSERT_EQUAL(LV_MAX(layout->lines[0].width, layout->lines[1].width), layout->max_line_width);
+
+    /*The same layout is returned from the cache*/
+    TEST_ASSERT_EQUAL_PTR(layout, _lv_txt_get_layout(txt, &lv_font_montserrat_14, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE));
+
+    /*The max. width doesn't matter if the lines are not wrapped*/
+    layout = _lv_txt_get_layout(txt, &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_EXPAND);
+    TEST_ASSERT_EQUAL_PTR(layout, _lv_txt_get_layout(txt, &lv_font_montserrat_14, 0, 200, LV_TEXT_FLAG_EXPAND));
+
+    /*Different font or letter space*/
+    layout = _lv_txt_get_layout(txt, &lv_font_montserrat_14, 3, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(lv_txt_get_width(txt, 12, &lv_font_montserrat_14, 3, LV_TEXT_FLAG_NONE), layout->lines[0].width);
+}
+
+void test_txt_layout_cache_long_text_not_cached(void)
+{
+    char txt[LV_TXT_LAYOUT_CACHE_MAX_LEN + 1];
+    lv_memset(txt, 'a', sizeof(txt) - 1);
+    txt[sizeof(txt) - 1] = '\0';
+    TEST_ASSERT_NULL(_lv_txt_get_layout(txt, &lv_font_montserrat_14, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE));
+    check_size(txt, 0, 0, 100, LV_TEXT_FLAG_NONE);
+}
+
+void test_txt_layout_cache_no_leak(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+
+    /*Many more texts than fit into the cache*/
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        char txt[32];
+        lv_snprintf(txt, sizeof(txt), "Value: %d", (int)i);
+        check_size(txt, 0, 0, 60, LV_TEXT_FLAG_NONE);
+    }
+
+    lv_txt_layout_cache_clear();
+    TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem());
+}
+
+void test_txt_layout_cache_label(void)
+{
+    static lv_color_t ref_fb[800 * 480];
+    const char * txt = "A long label which is wrapped into lines";
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 100);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(label, txt);
+    lv_obj_update_layout(label);
+
+    /*The same size as measured without the cache*/
+    lv_point_t ref;
+    get_size_ref(&ref, txt, &lv_font_montserrat_14, 0, 0, 100, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(ref.y, lv_obj_get_height(label));
+
+    /*The same rendering as without the cache. Make the text too long to be cached by adding new lines
+     *which are clipped as the height is fixed.*/
+    lv_obj_set_height(label, ref.y);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_CLIP);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    char long_txt[LV_TXT_LAYOUT_CACHE_MAX_LEN + 64];
+    lv_memset(long_txt, '\n', sizeof(long_txt) - 1);
+    long_txt[sizeof(long_txt) - 1] = '\0';
+    lv_memcpy(long_txt, txt, strlen(txt));
+    TEST_ASSERT_NULL(_lv_txt_get_layout(long_txt, &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE));
+    lv_label_set_text(label, long_txt);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+#else /*LV_TXT_LAYOUT_CACHE_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_txt_layout_cache_same_size(void)
+{
+
+}
+
+void test_txt_layout_cache_lines(void)
+{
+
+}
+
+void test_txt_layout_cache_long_text_not_cached(void)
+{
+
+}
+
+void test_txt_layout_cache_no_leak(void)
+{
+
+}
+
+void test_txt_layout_cache_label(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -1,24 +1,91 @@
 #include "lvgl/lvgl.h"
 #include "lvgl/demos/lv_demos.h"
 #include "lv_drivers/display/fbdev.h"
+#include "lv_drivers/display/fbtap.h"
 #include "lv_drivers/indev/evdev.h"
 #include <unistd.h>
 #include <pthread.h>
 #include <time.h>
 #include <sys/time.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include "lvgl/examples/lv_examples.h"
 #include "test/lv_font_source_han_sans_bold.h"
 #include "test/nongye.h"
 
 #define DISP_BUF_SIZE (480 * 1024)
 
+#if LV_USE_PROFILER
+/*trace文件: 收到SIGUSR1或退出时写入, 用chrome://tracing或ui.perfetto.dev打开*/
+#define PROFILER_TRACE_PATH "/tmp/lvgl_trace.json"
 
+static volatile sig_atomic_t profiler_dump_req = 0;
+static volatile sig_atomic_t profiler_quit_req = 0;
+static FILE * profiler_file = NULL;
+
+static struct timespec profiler_start;
+
+/*相对于启动时间的us, 约71分钟回绕一次, lv_profiler_flush()会把回绕的时间展开*/
+static uint32_t profiler_tick_get_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t us = (int64_t)(ts.tv_sec - profiler_start.tv_sec) * 1000000 + (ts.tv_nsec - profiler_start.tv_nsec) / 1000;
+    return (uint32_t)us;
+}
+
+static void profiler_write_cb(const char * buf)
+{
+    if(profiler_file) fputs(buf, profiler_file);
+}
+
+static void profiler_dump(void)
+{
+    profiler_file = fopen(PROFILER_TRACE_PATH, "w");
+    if(profiler_file == NULL) {
+        perror("open " PROFILER_TRACE_PATH);
+        return;
+    }
+    lv_profiler_flush();
+    fclose(profiler_file);
+    profiler_file = NULL;
+    printf("profiler trace written to %s\n", PROFILER_TRACE_PATH);
+}
+
+static void profiler_signal_handler(int sig)
+{
+    /*在主循环中处理, 信号处理函数中不能调用stdio*/
+    if(sig == SIGUSR1) profiler_dump_req = 1;
+    else profiler_quit_req = 1;     /*SIGINT/SIGTERM: 退出主循环, 通过atexit写入trace*/
+}
+
+static void profiler_setup(void)
+{
+    lv_profiler_config_t config;
+    lv_profiler_config_init(&config);
+    clock_gettime(CLOCK_MONOTONIC, &profiler_start);
+    config.tick_get_cb = profiler_tick_get_us;
+    config.tick_per_sec = 1000000;
+    config.flush_cb = profiler_write_cb;
+    lv_profiler_init(&config);
+
+    signal(SIGUSR1, profiler_signal_handler);
+    signal(SIGINT, profiler_signal_handler);
+    signal(SIGTERM, profiler_signal_handler);
+    atexit(profiler_dump);
+}
+#endif
 
 int main(void)
 {
     /*lvgl初始化*/
     lv_init();
 
+#if LV_USE_PROFILER
+    profiler_setup();
+#endif
+
 
     /*输出设备初始化及注册*/
     fbdev_init();
@@ -31,7 +98,13 @@ int main(void)
     static lv_disp_drv_t disp_drv;
     lv_disp_drv_init(&disp_drv);
     disp_drv.draw_buf   = &disp_buf;
+#if USE_FBTAP
+    /*把刷新的区域同时发送给远程查看工具 (tools/fbtap_recv.c)*/
+    fbtap_init(fbdev_flush);
+    disp_drv.flush_cb   = fbtap_flush;
+#else
     disp_drv.flush_cb   = fbdev_flush;
+#endif
     disp_drv.hor_res    = 800;
     disp_drv.ver_res    = 480;
     lv_disp_drv_register(&disp_drv);
@@ -67,12 +140,23 @@ int main(void)
 
     /*事物处理及告知lvgl节拍数*/
     while(1) {
+#if LV_USE_PROFILER
+        if(profiler_dump_req) {
+            profiler_dump_req = 0;
+            profiler_dump();
+        }
+        if(profiler_quit_req) break;
+#endif
         nongye_ui_refresh();
         lv_timer_handler();//事务处理
         lv_tick_inc(5);//节拍累计
         usleep(5000);
     }
 
+#if USE_FBTAP
+    fbtap_exit();
+#endif
+
     return 0;
 }
 
@@ -2,6 +2,7 @@
  *      INCLUDES
  *********************/
 #include "nongye.h"
+#include "ui_blob.h"
 #include <pthread.h>
 #include <signal.h>
 #include <stdio.h>
@@ -23,6 +24,9 @@
 #define SERVER_IP   "192.168.5.42"  // 服务器 IP
 #define SERVER_PORT 60005           // 服务器端口号
 
+/* ---------- 读数显示 ---------- */
+#define TEMP_TO_READOUT(t) ((int32_t)((t) * 10 + ((t) < 0 ? -0.5f : 0.5f)))  // 温度以 0.1 °C 为单位显示
+
 /* ---------- 静态变量 ---------- */
 static lv_obj_t *lab_temp = NULL;
 static lv_obj_t *lab_humi = NULL;
@@ -42,6 +46,7 @@ static lv_obj_t *auto_img = NULL;
 static lv_timer_t *img_timer = NULL;
 static int auto_idx = 0;
 static pthread_t recv_tid;
+static bool scripted_feed = false; // 脚本数据源模式: 不打开设备、不启动后台线程（用于无屏幕的性能测试）
 
 static struct {
     float temp;
@@ -73,17 +78,41 @@ static volatile bool queue_full = false;
 static pthread_mutex_t queue_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 /* 图片资源数组（假设图片已转换为 LVGL 格式或使用文件路径） */
-static const char *auto_imgs[] = {
-    "S:/root/tmp/1.jpg",
-    "S:/root/tmp/2.jpg",
-    "S:/root/tmp/3.jpg",
+static const void *auto_imgs[] = {
+    "M:/root/tmp/1.jpg",
+    "M:/root/tmp/2.jpg",
+    "M:/root/tmp/3.jpg",
 };
+static const void * const *carousel_srcs = auto_imgs;
+static int carousel_cnt = sizeof(auto_imgs) / sizeof(auto_imgs[0]);
 
 /* ---------- 定时器回调函数：切换图片 ---------- */
 static void img_timer_cb(lv_timer_t *timer)
 {
-    auto_idx = (auto_idx + 1) % (sizeof(auto_imgs) / sizeof(auto_imgs[0]));
-    lv_img_set_src(auto_img, auto_imgs[auto_idx]);
+    nongye_carousel_next();
+}
+
+/* ---------- 更新传感器数据（调用者需持有 data_mutex） ---------- */
+static void sensor_data_update(float temp, float humi, int co2, int lux)
+{
+    g_data.temp = temp;
+    g_data.humi = humi;
+    g_data.co2  = co2;
+    g_data.lux  = lux;
+    time_t now = time(NULL);
+    struct tm tm_now;
+    localtime_r(&now, &tm_now);
+    snprintf(g_data.time, sizeof(g_data.time), "%02d:%02d",
+             tm_now.tm_hour, tm_now.tm_min);
+
+    // 仅采集前 5 个点到折线图
+    if (g_data.sample_count < 5) {
+        g_data.co2_samples[g_data.sample_count] = (lv_coord_t)g_data.co2;
+        g_data.lux_samples[g_data.sample_count] = (lv_coord_t)g_data.lux;
+        g_data.temp_samples[g_data.sample_count] = (lv_coord_t)(g_data.temp * 10);
+        g_data.humi_samples[g_data.sample_count] = (lv_coord_t)g_data.humi;
+        g_data.sample_count++;
+    }
 }
 
 /* ---------- 主开关回调 - 控制 4 个 LED 全亮或全灭 ---------- */
@@ -108,7 +137,7 @@ static void sw_main_cb(lv_event_t *e)
     if (socket_fd >= 0) {
         const char *msg = g_data.led_main ? "开灯" : "关灯";
         send(socket_fd, msg, strlen(msg), 0);
-        printf("发送灯光状态: %s\n", msg);
+        LV_LOG_USER("发送灯光状态: %s", msg);
     }
 }
 
@@ -131,7 +160,7 @@ static void sw_aux_cb(lv_event_t *e)
     if (socket_fd >= 0) {
         const char *msg = g_data.led_aux ? "开启报警" : "关闭报警";
         send(socket_fd, msg, strlen(msg), 0);
-        printf("发送报警状态: %s\n", msg);
+        LV_LOG_USER("发送报警状态: %s", msg);
     }
 }
 
@@ -144,19 +173,10 @@ static void *recv_thread(void *arg)
 
     while ((n = recv(fd, buf, sizeof(buf) - 1, 0)) > 0) {
         buf[n] = '\0';
-        printf("收到服务器指令: %s\n", buf);
+        LV_LOG_USER("收到服务器指令: %s", buf);
 
         // 将指令放入队列
-        pthread_mutex_lock(&queue_mutex);
-        if ((queue_head + 1) % QUEUE_SIZE != queue_tail) { // 检查队列是否未满
-            strncpy(command_queue[queue_head], buf, sizeof(command_queue[queue_head]) - 1);
-            command_queue[queue_head][sizeof(command_queue[queue_head]) - 1] = '\0';
-            queue_head = (queue_head + 1) % QUEUE_SIZE;
-        } else {
-            queue_full = true;
-            printf("指令队列已满，丢弃指令: %s\n", buf);
-        }
-        pthread_mutex_unlock(&queue_mutex);
+        nongye_feed_command(buf);
     }
 
     printf("服务器断开连接，退出接收线程\n");
@@ -168,24 +188,10 @@ static void *refresh_thread(void *arg)
 {
     while (!quit_refresh) {
         pthread_mutex_lock(&data_mutex);
-        g_data.temp  = 20.0f + (rand() % 100) / 10.0f; // 温度: 20.0-29.9°C
-        g_data.humi  = 60   + (rand() % 20);           // 湿度: 60-79%
-        g_data.co2   = 400  + (rand() % 1600);         // CO2: 400-2000 ppm
-        g_data.lux   = 5000 + (rand() % 5000);         // 光照度: 5000-10000 lux
-        time_t now = time(NULL);
-        struct tm tm_now;
-        localtime_r(&now, &tm_now);
-        snprintf(g_data.time, sizeof(g_data.time), "%02d:%02d",
-                 tm_now.tm_hour, tm_now.tm_min);
-
-        // 仅采集前 5 个点到折线图
-        if (g_data.sample_count < 5) {
-            g_data.co2_samples[g_data.sample_count] = (lv_coord_t)g_data.co2;
-            g_data.lux_samples[g_data.sample_count] = (lv_coord_t)g_data.lux;
-            g_data.temp_samples[g_data.sample_count] = (lv_coord_t)(g_data.temp * 10);
-            g_data.humi_samples[g_data.sample_count] = (lv_coord_t)g_data.humi;
-            g_data.sample_count++;
-        }
+        sensor_data_update(20.0f + (rand() % 100) / 10.0f, // 温度: 20.0-29.9°C
+                           60   + (rand() % 20),           // 湿度: 60-79%
+                           400  + (rand() % 1600),         // CO2: 400-2000 ppm
+                           5000 + (rand() % 5000));        // 光照度: 5000-10000 lux
 
         // 构造要发送的数据字符串
         char buf[256];
@@ -200,7 +206,7 @@ static void *refresh_thread(void *arg)
             if (ret < 0) {
                 perror("发送数据失败");
             } else {
-                printf("发送数据: %s\n", buf);
+                LV_LOG_USER("发送数据: %s", buf);
             }
         }
 
@@ -212,6 +218,41 @@ static void *refresh_thread(void *arg)
     return NULL;
 }
 
+/* ---------- 界面描述中引用的字体、事件回调和对象 ---------- */
+extern const uint8_t nongye_ui_blob[];     // test/nongye_ui_blob.c, 由 make ui 生成
+extern const uint32_t nongye_ui_blob_size;
+
+static ui_blob_t ui_blob;
+
+static const ui_blob_font_t ui_fonts[] = {
+    {"chinese_ziku", &chinese_ziku},
+    {NULL, NULL}
+};
+
+static const ui_blob_event_t ui_events[] = {
+    {"sw_main_cb", sw_main_cb},
+    {"sw_aux_cb", sw_aux_cb},
+    {NULL, NULL}
+};
+
+static const ui_blob_bind_t ui_binds[] = {
+    {"lab_temp", &lab_temp},
+    {"lab_humi", &lab_humi},
+    {"lab_co2", &lab_co2},
+    {"lab_lux", &lab_lux},
+    {"sw_main", &sw_main},
+    {"sw_aux", &sw_aux},
+    {"bar_co2", &bar_co2},
+    {"lab_time_header", &lab_time_header},
+    {"lab_weather_header", &lab_weather_header},
+    {"chart_gas", &chart_gas},
+    {"chart_env", &chart_env},
+    {"auto_img", &auto_img},
+    {NULL, NULL}
+};
+
+static const ui_blob_syms_t ui_syms = {ui_fonts, ui_events, ui_binds};
+
 /* ---------- 界面创建（主线程） ---------- */
 void nongye_ui_create(void)
 {
@@ -222,225 +263,52 @@ void nongye_ui_create(void)
         return;
     }
 
-    /* 打开 LED 设备文件 */
-    led_fd = open("/dev/Led", O_RDWR);
-    if (led_fd < 0) {
-        perror("无法打开 /dev/Led");
-    }
+    if (!scripted_feed) {
+        /* 打开 LED 设备文件 */
+        led_fd = open("/dev/Led", O_RDWR);
+        if (led_fd < 0) {
+            perror("无法打开 /dev/Led");
+        }
 
-    /* 打开蜂鸣器设备文件 */
-    beep_fd = open("/dev/beep", O_RDWR);
-    if (beep_fd < 0) {
-        perror("无法打开 /dev/beep");
+        /* 打开蜂鸣器设备文件 */
+        beep_fd = open("/dev/beep", O_RDWR);
+        if (beep_fd < 0) {
+            perror("无法打开 /dev/beep");
+        }
     }
 
     lv_obj_clean(lv_scr_act());
-    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x0f2027), 0);
-
-    /* 标题栏 */
-    lv_obj_t *header = lv_obj_create(lv_scr_act());
-    lv_obj_set_size(header, 800, 50);
-    lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 0);
-    lv_obj_set_style_bg_color(header, lv_color_hex(0x10b981), 0);
-    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
-
-    /* 标题栏中间标题 */
-    lv_obj_t *title = lv_label_create(header);
-    lv_label_set_text(title, "智慧大棚监测系统");
-    lv_obj_set_style_text_font(title, &chinese_ziku, 0);
-    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, -10);
-
-    /* 标题栏左侧时间 */
-    lab_time_header = lv_label_create(header);
-    lv_label_set_text(lab_time_header, "2025-09-10 16:20");
-    lv_obj_set_style_text_font(lab_time_header, &chinese_ziku, 0);
-    lv_obj_align(lab_time_header, LV_ALIGN_TOP_LEFT, 20, -10);
-    lv_obj_set_style_text_align(lab_time_header, LV_TEXT_ALIGN_LEFT, 0);
-
-    /* 标题栏右侧天气 */
-    lab_weather_header = lv_label_create(header);
-    lv_label_set_text(lab_weather_header, "广州 晴天 30度");
-    lv_obj_set_style_text_font(lab_weather_header, &chinese_ziku, 0);
-    lv_obj_align(lab_weather_header, LV_ALIGN_TOP_RIGHT, -20, -10);
-    lv_obj_set_style_text_align(lab_weather_header, LV_TEXT_ALIGN_RIGHT, 0);
-
-    /* 主网格 */
-    lv_obj_t *grid = lv_obj_create(lv_scr_act());
-    lv_obj_set_size(grid, 800, 430);
-    lv_obj_align(grid, LV_ALIGN_BOTTOM_MID, 0, 0);
-    lv_obj_set_flex_flow(grid, LV_FLEX_FLOW_ROW_WRAP);
-    lv_obj_set_flex_align(grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_style_pad_all(grid, 10, 0);
-
-    /* LED 控制卡片 */
-    lv_obj_t *card6 = lv_obj_create(grid);
-    lv_obj_set_size(card6, 250, 200);
-    lv_obj_set_style_bg_color(card6, lv_color_hex(0x3399cc), 0);
-    lv_obj_add_flag(card6, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_add_flag(card6, LV_OBJ_FLAG_EVENT_BUBBLE);
-    lv_obj_t *label6 = lv_label_create(card6);
-    lv_label_set_text(label6, "照明报警系统");
-    lv_obj_set_style_text_font(label6, &chinese_ziku, 0);
-    lv_obj_align(label6, LV_ALIGN_TOP_LEFT, 10, 10);
-    sw_main = lv_switch_create(card6);
-    lv_obj_set_size(sw_main, 60, 30);
-    lv_obj_add_flag(sw_main, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_align(sw_main, LV_ALIGN_CENTER, -50, 60);
-    lv_obj_add_event_cb(sw_main, sw_main_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    if (g_data.led_main) lv_obj_add_state(sw_main, LV_STATE_CHECKED);
-    lv_obj_t *label_main = lv_label_create(card6);
-    lv_label_set_text(label_main, "灯光");
-    lv_obj_set_style_text_font(label_main, &chinese_ziku, 0);
-    lv_obj_align_to(label_main, sw_main, LV_ALIGN_OUT_TOP_MID, 0, -5);
-    sw_aux = lv_switch_create(card6);
-    lv_obj_set_size(sw_aux, 60, 30);
-    lv_obj_add_flag(sw_aux, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_align(sw_aux, LV_ALIGN_CENTER, 50, 60);
-    lv_obj_add_event_cb(sw_aux, sw_aux_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    if (g_data.led_aux) lv_obj_add_state(sw_aux, LV_STATE_CHECKED);
-    lv_obj_t *label_aux = lv_label_create(card6);
-    lv_label_set_text(label_aux, "报警");
-    lv_obj_set_style_text_font(label_aux, &chinese_ziku, 0);
-    lv_obj_align_to(label_aux, sw_aux, LV_ALIGN_OUT_TOP_MID, 0, -5);
-
-    /* 气体监测卡片 */
-    lv_obj_t *card4 = lv_obj_create(grid);
-    lv_obj_set_size(card4, 250, 200);
-    lv_obj_set_style_bg_color(card4, lv_color_hex(0x3399cc), 0);
-    lv_obj_t *label4 = lv_label_create(card4);
-    lv_label_set_text(label4, "气体监测");
-    lv_obj_set_style_text_font(label4, &chinese_ziku, 0);
-    lv_obj_align(label4, LV_ALIGN_TOP_LEFT, 10, 10);
-    lv_obj_t *label_co2_name = lv_label_create(card4);
-    lv_label_set_text(label_co2_name, "CO2浓度");
-    lv_obj_set_style_text_font(label_co2_name, &chinese_ziku, 0);
-    lv_obj_align(label_co2_name, LV_ALIGN_TOP_MID, -60, 70);
-    lab_co2 = lv_label_create(card4);
-    lv_label_set_text_fmt(lab_co2, "%d ppm", g_data.co2);
-    lv_obj_align(lab_co2, LV_ALIGN_TOP_MID, -60, 100);
-    lv_obj_t *label_lux_name = lv_label_create(card4);
-    lv_label_set_text(label_lux_name, "光照度");
-    lv_obj_set_style_text_font(label_lux_name, &chinese_ziku, 0);
-    lv_obj_align(label_lux_name, LV_ALIGN_TOP_MID, 60, 70);
-    lab_lux = lv_label_create(card4);
-    lv_label_set_text_fmt(lab_lux, "%d lux", g_data.lux);
-    lv_obj_align(lab_lux, LV_ALIGN_TOP_MID, 60, 100);
-
-    bar_co2 = lv_bar_create(card4);
-    lv_obj_set_size(bar_co2, 200, 10);
-    lv_obj_align(bar_co2, LV_ALIGN_CENTER, 0, 60);
-    lv_bar_set_range(bar_co2, 0, 100);
-    lv_bar_set_value(bar_co2, (g_data.co2 - 400) * 100 / 1600, LV_ANIM_OFF);
-
-    /* 气体检测折线图卡片 */
-    lv_obj_t *card3 = lv_obj_create(grid);
-    lv_obj_set_size(card3, 250, 200);
-    lv_obj_set_style_bg_color(card3, lv_color_hex(0x3399cc), 0);
-    lv_obj_t *label3 = lv_label_create(card3);
-    lv_label_set_text(label3, "气体检测趋势");
-    lv_obj_set_style_text_font(label3, &chinese_ziku, 0);
-    lv_obj_align(label3, LV_ALIGN_TOP_LEFT, 10, 10);
-
-    chart_gas = lv_chart_create(card3);
-    lv_obj_set_size(chart_gas, 200, 120);
-    lv_obj_align(chart_gas, LV_ALIGN_CENTER, 0, 20);
-    lv_chart_set_type(chart_gas, LV_CHART_TYPE_LINE);
-    lv_chart_set_point_count(chart_gas, 5);
-    lv_chart_set_range(chart_gas, LV_CHART_AXIS_PRIMARY_Y, 0, 11000);
-    lv_chart_set_range(chart_gas, LV_CHART_AXIS_SECONDARY_Y, 0, 7000);
-    lv_chart_set_div_line_count(chart_gas, 5, 5);
-
-    lv_chart_series_t *ser_co2 = lv_chart_add_series(chart_gas, lv_color_hex(0xFF0000), LV_CHART_AXIS_PRIMARY_Y);
-    lv_chart_series_t *ser_lux = lv_chart_add_series(chart_gas, lv_color_hex(0x00FF00), LV_CHART_AXIS_SECONDARY_Y);
-    lv_chart_set_all_value(chart_gas, ser_co2, LV_CHART_POINT_NONE);
-    lv_chart_set_all_value(chart_gas, ser_lux, LV_CHART_POINT_NONE);
-
-    lv_obj_t *label_co2_axis = lv_label_create(card3);
-    lv_label_set_text(label_co2_axis, "CO2 (ppm)");
-    lv_obj_set_style_text_color(label_co2_axis, lv_palette_main(LV_PALETTE_GREEN), 0);
-    lv_obj_set_style_text_font(label_co2_axis, &chinese_ziku, 0);
-    lv_obj_align_to(label_co2_axis, chart_gas, LV_ALIGN_OUT_RIGHT_MID, 30, 15);
-
-    lv_obj_t *label_lux_axis = lv_label_create(card3);
-    lv_label_set_text(label_lux_axis, "光照 (lux)");
-    lv_obj_set_style_text_color(label_lux_axis, lv_palette_main(LV_PALETTE_RED), 0);
-    lv_obj_set_style_text_font(label_lux_axis, &chinese_ziku, 0);
-    lv_obj_align_to(label_lux_axis, chart_gas, LV_ALIGN_OUT_RIGHT_MID, 30, -15);
-
-    /* 农业资讯卡片 */
-    lv_obj_t *card2 = lv_obj_create(grid);
-    lv_obj_set_size(card2, 250, 200);
-    lv_obj_set_style_bg_color(card2, lv_color_hex(0x3399cc), 0);
-    lv_obj_t *label2 = lv_label_create(card2);
-    lv_label_set_text(label2, "农业资讯");
-    lv_obj_set_style_text_font(label2, &chinese_ziku, 0);
-    lv_obj_align(label2, LV_ALIGN_TOP_LEFT, 0, -15);
-    auto_img = lv_img_create(card2);
-    lv_obj_set_size(auto_img, 230, 160);
-    lv_obj_align(auto_img, LV_ALIGN_BOTTOM_MID, 0, 16);
-    lv_img_set_src(auto_img, auto_imgs[auto_idx]);
-    img_timer = lv_timer_create(img_timer_cb, 3000, NULL);
-
-    /* 温湿度监测卡片 */
-    lv_obj_t *card1 = lv_obj_create(grid);
-    lv_obj_set_size(card1, 250, 200);
-    lv_obj_set_style_bg_color(card1, lv_color_hex(0x3399cc), 0);
-    lv_obj_t *label1 = lv_label_create(card1);
-    lv_label_set_text(label1, "温湿度监测");
-    lv_obj_set_style_text_font(label1, &chinese_ziku, 0);
-    lv_obj_align(label1, LV_ALIGN_TOP_LEFT, 10, 10);
-    lv_obj_t *label_temp_name = lv_label_create(card1);
-    lv_label_set_text(label_temp_name, "温度");
-    lv_obj_set_style_text_font(label_temp_name, &chinese_ziku, 0);
-    lv_obj_align(label_temp_name, LV_ALIGN_CENTER, -50, 10);
-    lab_temp = lv_label_create(card1);
-    lv_label_set_text_fmt(lab_temp, "%.1f°C", g_data.temp);
-    lv_obj_align(lab_temp, LV_ALIGN_CENTER, -50, 40);
-    lv_obj_t *label_humi_name = lv_label_create(card1);
-    lv_label_set_text(label_humi_name, "湿度");
-    lv_obj_set_style_text_font(label_humi_name, &chinese_ziku, 0);
-    lv_obj_align(label_humi_name, LV_ALIGN_CENTER, 50, 10);
-    lab_humi = lv_label_create(card1);
-    lv_label_set_text_fmt(lab_humi, "%.0f%%", g_data.humi);
-    lv_obj_align(lab_humi, LV_ALIGN_CENTER, 50, 40);
-
-    /* 温湿度趋势折线图卡片 */
-    lv_obj_t *card5 = lv_obj_create(grid);
-    lv_obj_set_size(card5, 250, 200);
-    lv_obj_set_style_bg_color(card5, lv_color_hex(0x3399cc), 0);
-    lv_obj_t *label5 = lv_label_create(card5);
-    lv_label_set_text(label5, "温湿度趋势");
-    lv_obj_set_style_text_font(label5, &chinese_ziku, 0);
-    lv_obj_align(label5, LV_ALIGN_TOP_LEFT, 10, 10);
-
-    chart_env = lv_chart_create(card5);
-    lv_obj_set_size(chart_env, 200, 120);
-    lv_obj_align(chart_env, LV_ALIGN_CENTER, 0, 20);
-    lv_chart_set_type(chart_env, LV_CHART_TYPE_LINE);
-    lv_chart_set_point_count(chart_env, 5);
-    lv_chart_set_range(chart_env, LV_CHART_AXIS_PRIMARY_Y, 0, 200);
-    lv_chart_set_range(chart_env, LV_CHART_AXIS_SECONDARY_Y, 0, 400);
-    lv_chart_set_div_line_count(chart_env, 5, 5);
-
-    lv_chart_series_t *ser_temp = lv_chart_add_series(chart_env, lv_color_hex(0xFF0000), LV_CHART_AXIS_PRIMARY_Y);
-    lv_chart_series_t *ser_humi = lv_chart_add_series(chart_env, lv_color_hex(0x00FF00), LV_CHART_AXIS_SECONDARY_Y);
-    lv_chart_set_all_value(chart_env, ser_temp, LV_CHART_POINT_NONE);
-    lv_chart_set_all_value(chart_env, ser_humi, LV_CHART_POINT_NONE);
-
-    lv_obj_t *label_temp_axis = lv_label_create(card5);
-    lv_label_set_text(label_temp_axis, "温度");
-    lv_obj_set_style_text_color(label_temp_axis, lv_palette_main(LV_PALETTE_RED), 0);
-    lv_obj_set_style_text_font(label_temp_axis, &chinese_ziku, 0);
-    lv_obj_align_to(label_temp_axis, chart_env, LV_ALIGN_OUT_RIGHT_MID, 30, 15);
-
-    lv_obj_t *label_humi_axis = lv_label_create(card5);
-    lv_label_set_text(label_humi_axis, "湿度");
-    lv_obj_set_style_text_color(label_humi_axis, lv_palette_main(LV_PALETTE_GREEN), 0);
-    lv_obj_set_style_text_font(label_humi_axis, &chinese_ziku, 0);
-    lv_obj_align_to(label_humi_axis, chart_env, LV_ALIGN_OUT_RIGHT_MID, 30, -15);
+
+    /* 界面由 test/nongye_ui.json 描述, make ui 编译; 设置 NONGYE_UI 时从文件加载, 更新界面不需要重新编译程序 */
+    if (ui_blob.data == NULL) {
+        const char *path = getenv("NONGYE_UI");
+        if (path == NULL || ui_blob_open(&ui_blob, path) < 0) {
+            ui_blob_init(&ui_blob, nongye_ui_blob, nongye_ui_blob_size);
+        }
+    }
+    if (ui_blob_load(&ui_blob, "main", lv_scr_act(), &ui_syms) < 0) {
+        puts("!!! 界面数据加载失败");
+        return;
+    }
+
+    /* 初始状态和数值 */
+    if (sw_main && g_data.led_main) lv_obj_add_state(sw_main, LV_STATE_CHECKED);
+    if (sw_aux && g_data.led_aux) lv_obj_add_state(sw_aux, LV_STATE_CHECKED);
+    if (lab_co2) lv_readout_set_value(lab_co2, g_data.co2);
+    if (lab_lux) lv_readout_set_value(lab_lux, g_data.lux);
+    if (bar_co2) lv_bar_set_value(bar_co2, (g_data.co2 - 400) * 100 / 1600, LV_ANIM_OFF);
+    if (lab_temp) lv_readout_set_value(lab_temp, TEMP_TO_READOUT(g_data.temp));
+    if (lab_humi) lv_readout_set_value(lab_humi, (int32_t)(g_data.humi + 0.5f));
+
+    /* 农业资讯图片轮播 */
+    if (auto_img) {
+        lv_img_set_src(auto_img, carousel_srcs[auto_idx]);
+        img_timer = lv_timer_create(img_timer_cb, 3000, NULL);
+        if (scripted_feed) lv_timer_pause(img_timer); // 由 nongye_carousel_next() 驱动
+    }
 
     /* 启动后台刷新线程 */
-    pthread_create(&refresh_tid, NULL, refresh_thread, NULL);
+    if (!scripted_feed) pthread_create(&refresh_tid, NULL, refresh_thread, NULL);
 }
 
 /* ---------- 主线程周期刷新（带 NULL 保护） ---------- */
@@ -520,10 +388,11 @@ void nongye_ui_refresh(void)
              tm_now.tm_hour, tm_now.tm_min);
     lv_label_set_text(lab_time_header, date_time_buf);
 
-    lv_label_set_text_fmt(lab_temp, "%.1f°C", temp);
-    lv_label_set_text_fmt(lab_humi, "%.0f%%", humi);
-    lv_label_set_text_fmt(lab_co2, "%d ppm", co2);
-    lv_label_set_text_fmt(lab_lux, "%d lux", lux);
+    /* 只重绘变化的数字 */
+    lv_readout_set_value(lab_temp, TEMP_TO_READOUT(temp));
+    lv_readout_set_value(lab_humi, (int32_t)(humi + 0.5f));
+    lv_readout_set_value(lab_co2, co2);
+    lv_readout_set_value(lab_lux, lux);
     lv_bar_set_value(bar_co2, (co2 - 400) * 100 / 1600, LV_ANIM_OFF);
 
     if (g_data.sample_count > 0) {
@@ -545,7 +414,7 @@ void nongye_ui_refresh(void)
 void nongye_ui_cleanup(void)
 {
     quit_refresh = true;
-    pthread_join(refresh_tid, NULL);
+    if (!scripted_feed) pthread_join(refresh_tid, NULL);
     pthread_join(recv_tid, NULL);
     if (led_fd >= 0) {
         close(led_fd);
@@ -563,6 +432,9 @@ void nongye_ui_cleanup(void)
     chart_env = NULL;
     pthread_mutex_destroy(&data_mutex);
     pthread_mutex_destroy(&queue_mutex);
+#if LV_LOG_USE_ASYNC
+    lv_log_flush();     // 输出日志缓冲区中还没打印的日志
+#endif
     printf("资源清理完成\n");
 }
 
@@ -602,4 +474,46 @@ void nongye_init(void)
 
     // 启动接收线程
     pthread_create(&recv_tid, NULL, recv_thread, (void *)(long)socket_fd);
-}
\ No newline at end of file
+}
+
+/* ---------- 脚本数据源（无屏幕性能测试用） ---------- */
+void nongye_set_scripted_feed(bool en)
+{
+    scripted_feed = en;
+}
+
+void nongye_feed_sensor(float temp, float humi, int co2, int lux)
+{
+    pthread_mutex_lock(&data_mutex);
+    sensor_data_update(temp, humi, co2, lux);
+    pthread_mutex_unlock(&data_mutex);
+}
+
+void nongye_feed_command(const char *cmd)
+{
+    pthread_mutex_lock(&queue_mutex);
+    if ((queue_head + 1) % QUEUE_SIZE != queue_tail) { // 检查队列是否未满
+        strncpy(command_queue[queue_head], cmd, sizeof(command_queue[queue_head]) - 1);
+        command_queue[queue_head][sizeof(command_queue[queue_head]) - 1] = '\0';
+        queue_head = (queue_head + 1) % QUEUE_SIZE;
+    } else {
+        queue_full = true;
+        printf("指令队列已满，丢弃指令: %s\n", cmd);
+    }
+    pthread_mutex_unlock(&queue_mutex);
+}
+
+void nongye_set_carousel_srcs(const void * const *srcs, int cnt)
+{
+    carousel_srcs = srcs;
+    carousel_cnt = cnt;
+    auto_idx = 0;
+    if (auto_img) lv_img_set_src(auto_img, carousel_srcs[auto_idx]);
+}
+
+void nongye_carousel_next(void)
+{
+    if (!auto_img || carousel_cnt <= 0) return;
+    auto_idx = (auto_idx + 1) % carousel_cnt;
+    lv_img_set_src(auto_img, carousel_srcs[auto_idx]);
+}
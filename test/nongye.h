@@ -30,5 +30,21 @@ void nongye_ui_refresh();
 
 void nongye_init();
 
+/* ---------- 脚本数据源（无屏幕性能测试用） ---------- */
+/* 在 nongye_ui_create() 之前调用: 不打开 /dev/Led、/dev/beep，不启动后台刷新线程，图片轮播定时器暂停 */
+void nongye_set_scripted_feed(bool en);
+
+/* 写入一组传感器数据（代替后台刷新线程） */
+void nongye_feed_sensor(float temp, float humi, int co2, int lux);
+
+/* 放入一条服务器指令（代替接收线程），如 "开灯"、"关闭报警" */
+void nongye_feed_command(const char *cmd);
+
+/* 替换轮播图片源（数组需一直有效） */
+void nongye_set_carousel_srcs(const void * const *srcs, int cnt);
+
+/* 切换到下一张轮播图片 */
+void nongye_carousel_next(void);
+
 #endif
 
@@ -0,0 +1,178 @@
+/* 由 tools/ui_compile.py 从 ./test/nongye_ui.json 生成, 不要手动修改 */
+
+#include <stdint.h>
+
+const uint8_t nongye_ui_blob[] __attribute__((aligned(4))) = {
+    0x4c, 0x56, 0x55, 0x49, 0x01, 0x00, 0x01, 0x00, 0xb0, 0x08, 0x00, 0x00, 0xed, 0x01, 0x00, 0x00,
+    0xe8, 0x01, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x25, 0x02, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x27, 0x20, 0x0f, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0x20, 0x03, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0xb9, 0x10, 0x00, 0x08, 0x00, 0x01, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+    0x04, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf6, 0xff, 0xff, 0xff,
+    0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x2d, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0xf6, 0xff, 0xff, 0xff, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00,
+    0x3d, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x4e, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0xec, 0xff, 0xff, 0xff,
+    0xf6, 0xff, 0xff, 0xff, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00,
+    0x61, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x75, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0x20, 0x03, 0x00, 0x00,
+    0xae, 0x01, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+    0x0a, 0x00, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x7a, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0xfa, 0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcc, 0x99, 0x33, 0x00, 0x07, 0x00, 0x01, 0x00,
+    0x00, 0x00, 0x10, 0x00, 0x07, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x07, 0x00, 0x01, 0x00,
+    0x00, 0x40, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+    0x04, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00,
+    0x83, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x96, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0xce, 0xff, 0xff, 0xff, 0x3c, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x02, 0x00, 0x9e, 0x00, 0x00, 0x00,
+    0x1c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x0d, 0x00, 0x01, 0x00, 0xa9, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x96, 0x00, 0x00, 0x00,
+    0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfb, 0xff, 0xff, 0xff, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0xb0, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00,
+    0x3c, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x32, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x07, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x0c, 0x00, 0x02, 0x00, 0xb7, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x06, 0x00, 0x02, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00, 0xc1, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x04, 0x00, 0xb0, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xfb, 0xff, 0xff, 0xff, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0xfa, 0x00, 0x00, 0x00,
+    0xc8, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcc, 0x99, 0x33, 0x00,
+    0x07, 0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x04, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+    0x0a, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x0d, 0x00, 0x01, 0x00, 0xd1, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x04, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0xc4, 0xff, 0xff, 0xff, 0x46, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00, 0xde, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x07, 0x00, 0x00, 0x00, 0xe8, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0xc4, 0xff, 0xff, 0xff, 0x64, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x03, 0x00,
+    0xf0, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x04, 0x00, 0x03, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x46, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00, 0xf7, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x07, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00,
+    0x04, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00,
+    0x0e, 0x00, 0x03, 0x00, 0x09, 0x01, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x10, 0x01, 0x00, 0x00,
+    0x03, 0x00, 0x02, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x01, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00,
+    0xfa, 0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xcc, 0x99, 0x33, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+    0x04, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00,
+    0x27, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x3a, 0x01, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x11, 0x00, 0x01, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x12, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x2a, 0x00, 0x00,
+    0x12, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x58, 0x1b, 0x00, 0x00,
+    0x13, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x14, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x02, 0x00, 0x00, 0xff, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x06, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x50, 0xaf, 0x4c, 0x00,
+    0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00,
+    0x44, 0x01, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x3a, 0x01, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x1e, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x06, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x36, 0x43, 0xf4, 0x00, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x0d, 0x00, 0x01, 0x00, 0x4e, 0x01, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x3a, 0x01, 0x00, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00, 0xf1, 0xff, 0xff, 0xff, 0x02, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x01, 0x00, 0x00,
+    0x03, 0x00, 0x02, 0x00, 0xfa, 0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xcc, 0x99, 0x33, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x04, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xf1, 0xff, 0xff, 0xff, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x0d, 0x00, 0x01, 0x00, 0x65, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x72, 0x01, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0xe6, 0x00, 0x00, 0x00,
+    0xa0, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x7b, 0x01, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0xfa, 0x00, 0x00, 0x00,
+    0xc8, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcc, 0x99, 0x33, 0x00,
+    0x07, 0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x04, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+    0x0a, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x0d, 0x00, 0x01, 0x00, 0x84, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x04, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0xce, 0xff, 0xff, 0xff, 0x0a, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00, 0x94, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x07, 0x00, 0x00, 0x00, 0x9b, 0x01, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0xce, 0xff, 0xff, 0xff, 0x28, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x03, 0x00,
+    0xa4, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x04, 0x00, 0x03, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00, 0xaa, 0x01, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x07, 0x00, 0x00, 0x00, 0xb1, 0x01, 0x00, 0x00,
+    0x04, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00,
+    0x0e, 0x00, 0x03, 0x00, 0xba, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xbf, 0x01, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0xfa, 0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcc, 0x99, 0x33, 0x00, 0x01, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x04, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x0a, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00, 0xce, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00, 0xde, 0x01, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00,
+    0xc8, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x11, 0x00, 0x01, 0x00, 0x05, 0x00, 0x00, 0x00, 0x12, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x12, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x90, 0x01, 0x00, 0x00, 0x13, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x14, 0x00, 0x02, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x14, 0x00, 0x02, 0x00, 0x00, 0xff, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x06, 0x00, 0x02, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x36, 0x43, 0xf4, 0x00, 0x06, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00, 0x94, 0x01, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00,
+    0xde, 0x01, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+    0x06, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x50, 0xaf, 0x4c, 0x00, 0x06, 0x00, 0x02, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x01, 0x00, 0xaa, 0x01, 0x00, 0x00,
+    0x05, 0x00, 0x04, 0x00, 0xde, 0x01, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00,
+    0xf1, 0xff, 0xff, 0xff, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x68, 0x65, 0x61, 0x64, 0x65, 0x72, 0x00, 0x63, 0x68, 0x69, 0x6e, 0x65, 0x73, 0x65, 0x5f, 0x7a,
+    0x69, 0x6b, 0x75, 0x00, 0xe6, 0x99, 0xba, 0xe6, 0x85, 0xa7, 0xe5, 0xa4, 0xa7, 0xe6, 0xa3, 0x9a,
+    0xe7, 0x9b, 0x91, 0xe6, 0xb5, 0x8b, 0xe7, 0xb3, 0xbb, 0xe7, 0xbb, 0x9f, 0x00, 0x6c, 0x61, 0x62,
+    0x5f, 0x74, 0x69, 0x6d, 0x65, 0x5f, 0x68, 0x65, 0x61, 0x64, 0x65, 0x72, 0x00, 0x32, 0x30, 0x32,
+    0x35, 0x2d, 0x30, 0x39, 0x2d, 0x31, 0x30, 0x20, 0x31, 0x36, 0x3a, 0x32, 0x30, 0x00, 0x6c, 0x61,
+    0x62, 0x5f, 0x77, 0x65, 0x61, 0x74, 0x68, 0x65, 0x72, 0x5f, 0x68, 0x65, 0x61, 0x64, 0x65, 0x72,
+    0x00, 0xe5, 0xb9, 0xbf, 0xe5, 0xb7, 0x9e, 0x20, 0xe6, 0x99, 0xb4, 0xe5, 0xa4, 0xa9, 0x20, 0x33,
+    0x30, 0xe5, 0xba, 0xa6, 0x00, 0x67, 0x72, 0x69, 0x64, 0x00, 0x63, 0x61, 0x72, 0x64, 0x5f, 0x6c,
+    0x65, 0x64, 0x00, 0xe7, 0x85, 0xa7, 0xe6, 0x98, 0x8e, 0xe6, 0x8a, 0xa5, 0xe8, 0xad, 0xa6, 0xe7,
+    0xb3, 0xbb, 0xe7, 0xbb, 0x9f, 0x00, 0x73, 0x77, 0x5f, 0x6d, 0x61, 0x69, 0x6e, 0x00, 0x73, 0x77,
+    0x5f, 0x6d, 0x61, 0x69, 0x6e, 0x5f, 0x63, 0x62, 0x00, 0xe7, 0x81, 0xaf, 0xe5, 0x85, 0x89, 0x00,
+    0x73, 0x77, 0x5f, 0x61, 0x75, 0x78, 0x00, 0x73, 0x77, 0x5f, 0x61, 0x75, 0x78, 0x5f, 0x63, 0x62,
+    0x00, 0xe6, 0x8a, 0xa5, 0xe8, 0xad, 0xa6, 0x00, 0x63, 0x61, 0x72, 0x64, 0x5f, 0x67, 0x61, 0x73,
+    0x00, 0xe6, 0xb0, 0x94, 0xe4, 0xbd, 0x93, 0xe7, 0x9b, 0x91, 0xe6, 0xb5, 0x8b, 0x00, 0x43, 0x4f,
+    0x32, 0xe6, 0xb5, 0x93, 0xe5, 0xba, 0xa6, 0x00, 0x6c, 0x61, 0x62, 0x5f, 0x63, 0x6f, 0x32, 0x00,
+    0x25, 0x64, 0x20, 0x70, 0x70, 0x6d, 0x00, 0xe5, 0x85, 0x89, 0xe7, 0x85, 0xa7, 0xe5, 0xba, 0xa6,
+    0x00, 0x6c, 0x61, 0x62, 0x5f, 0x6c, 0x75, 0x78, 0x00, 0x25, 0x64, 0x20, 0x6c, 0x75, 0x78, 0x00,
+    0x62, 0x61, 0x72, 0x5f, 0x63, 0x6f, 0x32, 0x00, 0x63, 0x61, 0x72, 0x64, 0x5f, 0x67, 0x61, 0x73,
+    0x5f, 0x63, 0x68, 0x61, 0x72, 0x74, 0x00, 0xe6, 0xb0, 0x94, 0xe4, 0xbd, 0x93, 0xe6, 0xa3, 0x80,
+    0xe6, 0xb5, 0x8b, 0xe8, 0xb6, 0x8b, 0xe5, 0x8a, 0xbf, 0x00, 0x63, 0x68, 0x61, 0x72, 0x74, 0x5f,
+    0x67, 0x61, 0x73, 0x00, 0x43, 0x4f, 0x32, 0x20, 0x28, 0x70, 0x70, 0x6d, 0x29, 0x00, 0xe5, 0x85,
+    0x89, 0xe7, 0x85, 0xa7, 0x20, 0x28, 0x6c, 0x75, 0x78, 0x29, 0x00, 0x63, 0x61, 0x72, 0x64, 0x5f,
+    0x6e, 0x65, 0x77, 0x73, 0x00, 0xe5, 0x86, 0x9c, 0xe4, 0xb8, 0x9a, 0xe8, 0xb5, 0x84, 0xe8, 0xae,
+    0xaf, 0x00, 0x61, 0x75, 0x74, 0x6f, 0x5f, 0x69, 0x6d, 0x67, 0x00, 0x63, 0x61, 0x72, 0x64, 0x5f,
+    0x65, 0x6e, 0x76, 0x00, 0xe6, 0xb8, 0xa9, 0xe6, 0xb9, 0xbf, 0xe5, 0xba, 0xa6, 0xe7, 0x9b, 0x91,
+    0xe6, 0xb5, 0x8b, 0x00, 0xe6, 0xb8, 0xa9, 0xe5, 0xba, 0xa6, 0x00, 0x6c, 0x61, 0x62, 0x5f, 0x74,
+    0x65, 0x6d, 0x70, 0x00, 0x25, 0x64, 0xc2, 0xb0, 0x43, 0x00, 0xe6, 0xb9, 0xbf, 0xe5, 0xba, 0xa6,
+    0x00, 0x6c, 0x61, 0x62, 0x5f, 0x68, 0x75, 0x6d, 0x69, 0x00, 0x25, 0x64, 0x25, 0x25, 0x00, 0x63,
+    0x61, 0x72, 0x64, 0x5f, 0x65, 0x6e, 0x76, 0x5f, 0x63, 0x68, 0x61, 0x72, 0x74, 0x00, 0xe6, 0xb8,
+    0xa9, 0xe6, 0xb9, 0xbf, 0xe5, 0xba, 0xa6, 0xe8, 0xb6, 0x8b, 0xe5, 0x8a, 0xbf, 0x00, 0x63, 0x68,
+    0x61, 0x72, 0x74, 0x5f, 0x65, 0x6e, 0x76, 0x00, 0x6d, 0x61, 0x69, 0x6e, 0x00,
+};
+
+const uint32_t nongye_ui_blob_size = sizeof(nongye_ui_blob);
@@ -0,0 +1,547 @@
+/*********************
+ *      INCLUDES
+ *********************/
+#include "ui_blob.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* 数据格式见 tools/ui_compile.py */
+#define UI_BLOB_VERSION     1
+#define HEADER_SIZE         16
+#define SCREEN_SIZE         12
+#define NO_STR              (-1)
+
+/* 操作码, 与 tools/ui_compile.py 相同 */
+enum {
+    OP_OBJ_BEGIN = 1,
+    OP_OBJ_END,
+    OP_SIZE,
+    OP_ALIGN,
+    OP_ALIGN_TO,
+    OP_STYLE,
+    OP_ADD_FLAG,
+    OP_CLEAR_FLAG,
+    OP_ADD_STATE,
+    OP_FLEX_FLOW,
+    OP_FLEX_ALIGN,
+    OP_EVENT,
+    OP_TEXT,
+    OP_READOUT_FORMAT,
+    OP_BAR_RANGE,
+    OP_CHART_TYPE,
+    OP_CHART_POINT_COUNT,
+    OP_CHART_RANGE,
+    OP_CHART_DIV_LINES,
+    OP_CHART_SERIES,
+    OP_CNT
+};
+
+/* 样式属性, 与 tools/ui_compile.py 中的 STYLE_PROPS 相同 */
+enum {
+    STYLE_BG_COLOR,
+    STYLE_BG_OPA,
+    STYLE_TEXT_COLOR,
+    STYLE_TEXT_FONT,
+    STYLE_TEXT_ALIGN,
+    STYLE_PAD_ALL,
+    STYLE_PAD_ROW,
+    STYLE_PAD_COLUMN,
+    STYLE_RADIUS,
+    STYLE_BORDER_WIDTH,
+    STYLE_BORDER_COLOR,
+};
+
+/* 每个操作码至少需要的参数个数和哪些参数是字符串 (位掩码). 参数更多的指令只使用前面的参数, 未知的指令被跳过 */
+static const struct {
+    uint8_t argc;
+    uint8_t str_args;
+} op_info[OP_CNT] = {
+    [OP_OBJ_BEGIN]          = {2, 0x02},
+    [OP_OBJ_END]            = {0, 0},
+    [OP_SIZE]               = {2, 0},
+    [OP_ALIGN]              = {3, 0},
+    [OP_ALIGN_TO]           = {4, 0x01},
+    [OP_STYLE]              = {2, 0},
+    [OP_ADD_FLAG]           = {1, 0},
+    [OP_CLEAR_FLAG]         = {1, 0},
+    [OP_ADD_STATE]          = {1, 0},
+    [OP_FLEX_FLOW]          = {1, 0},
+    [OP_FLEX_ALIGN]         = {3, 0},
+    [OP_EVENT]              = {2, 0x01},
+    [OP_TEXT]               = {1, 0x01},
+    [OP_READOUT_FORMAT]     = {3, 0x01},
+    [OP_BAR_RANGE]          = {2, 0},
+    [OP_CHART_TYPE]         = {1, 0},
+    [OP_CHART_POINT_COUNT]  = {1, 0},
+    [OP_CHART_RANGE]        = {3, 0},
+    [OP_CHART_DIV_LINES]    = {2, 0},
+    [OP_CHART_SERIES]       = {2, 0},
+};
+
+/* 对象类型, 与 tools/ui_compile.py 中的 TYPES 相同 */
+static lv_obj_t *(*const create_cbs[])(lv_obj_t *parent) = {
+    lv_obj_create,
+    lv_label_create,
+    lv_btn_create,
+    lv_switch_create,
+    lv_bar_create,
+    lv_chart_create,
+    lv_img_create,
+    lv_readout_create,
+};
+
+#define TYPE_CNT    (sizeof(create_cbs) / sizeof(create_cbs[0]))
+
+typedef struct {
+    const char *name;
+    lv_obj_t *obj;
+} named_obj_t;
+
+typedef struct {
+    lv_obj_t *obj;
+    const char *base;
+    int32_t align;
+    int32_t x;
+    int32_t y;
+} align_to_t;
+
+typedef struct {
+    const ui_blob_t *blob;
+    const ui_blob_syms_t *syms;
+    lv_obj_t *stack[UI_BLOB_DEPTH_MAX + 1];
+    uint32_t depth;
+    named_obj_t named[UI_BLOB_NAMED_MAX];
+    uint32_t named_cnt;
+    align_to_t align_to[UI_BLOB_ALIGN_TO_MAX];
+    uint32_t align_to_cnt;
+    int32_t font_str;           // 上一个字体的名字, 大部分标签使用同一个字体
+    const lv_font_t *font;
+} load_t;
+
+/* ---------- 读取数据 ---------- */
+static uint32_t get_u16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return get_u16(p) | (get_u16(p + 2) << 16);
+}
+
+static int32_t get_arg(const uint8_t *args, uint32_t i)
+{
+    return (int32_t)get_u32(args + 4 * i);
+}
+
+static const char *get_str(const ui_blob_t *blob, int32_t ofs)
+{
+    if (ofs == NO_STR) return NULL;
+    return (const char *)blob->data + get_u32(blob->data + 8) + ofs;
+}
+
+/* ---------- 检查数据, 加载时不再检查边界 ---------- */
+static int check_code(const ui_blob_t *blob, const uint8_t *code, uint32_t word_cnt)
+{
+    uint32_t str_size = get_u32(blob->data + 12);
+    uint32_t depth = 0;
+    uint32_t named_cnt = 0;
+    uint32_t align_to_cnt = 0;
+    uint32_t i = 0;
+    while (i < word_cnt) {
+        uint32_t head = get_u32(code + 4 * i);
+        uint32_t op = head & 0xffff;
+        uint32_t argc = head >> 16;
+        const uint8_t *args = code + 4 * (i + 1);
+        if (argc > word_cnt - i - 1) return -1;
+        i += 1 + argc;
+
+        if (op == 0 || op >= OP_CNT) continue;
+        if (argc < op_info[op].argc) return -1;
+
+        uint32_t a;
+        for (a = 0; a < op_info[op].argc; a++) {
+            if (!(op_info[op].str_args & (1 << a))) continue;
+            int32_t ofs = get_arg(args, a);
+            if (ofs != NO_STR && (ofs < 0 || (uint32_t)ofs >= str_size)) return -1;
+        }
+
+        if (op == OP_OBJ_BEGIN) {
+            if ((uint32_t)get_arg(args, 0) >= TYPE_CNT) return -1;
+            if (++depth > UI_BLOB_DEPTH_MAX) return -1;
+            if (get_arg(args, 1) != NO_STR && ++named_cnt > UI_BLOB_NAMED_MAX) return -1;
+        } else if (op == OP_OBJ_END) {
+            if (depth == 0) return -1;
+            depth--;
+        } else if (op == OP_ALIGN_TO) {
+            if (++align_to_cnt > UI_BLOB_ALIGN_TO_MAX) return -1;
+        } else if (op == OP_STYLE && get_arg(args, 0) == STYLE_TEXT_FONT) {
+            int32_t ofs = get_arg(args, 1);
+            if (ofs < 0 || (uint32_t)ofs >= str_size) return -1;
+        }
+    }
+
+    return depth == 0 ? 0 : -1;
+}
+
+static int check_blob(const ui_blob_t *blob)
+{
+    const uint8_t *d = blob->data;
+    if (blob->size < HEADER_SIZE || memcmp(d, "LVUI", 4) != 0) return -1;
+    if (get_u16(d + 4) != UI_BLOB_VERSION) return -1;
+
+    uint32_t screen_cnt = get_u16(d + 6);
+    uint32_t str_ofs = get_u32(d + 8);
+    uint32_t str_size = get_u32(d + 12);
+    if (HEADER_SIZE + screen_cnt * SCREEN_SIZE > blob->size) return -1;
+    if (str_ofs > blob->size || str_size > blob->size - str_ofs) return -1;
+    /* 最后一个字符串以 '\0' 结尾, 所以任何偏移处的字符串都不会越界 */
+    if (str_size == 0 || d[str_ofs + str_size - 1] != '\0') return -1;
+
+    uint32_t s;
+    for (s = 0; s < screen_cnt; s++) {
+        const uint8_t *screen = d + HEADER_SIZE + s * SCREEN_SIZE;
+        uint32_t code_ofs = get_u32(screen + 4);
+        uint32_t word_cnt = get_u32(screen + 8);
+        if (get_u32(screen) >= str_size) return -1;
+        if (code_ofs > blob->size || word_cnt > (blob->size - code_ofs) / 4) return -1;
+        if (check_code(blob, d + code_ofs, word_cnt) < 0) return -1;
+    }
+
+    return 0;
+}
+
+/* ---------- 执行指令 ---------- */
+static const lv_font_t *find_font(load_t *ld, int32_t ofs)
+{
+    if (ofs == ld->font_str) return ld->font;
+
+    const char *name = get_str(ld->blob, ofs);
+    const ui_blob_font_t *f;
+    for (f = ld->syms->fonts; f && f->name; f++) {
+        if (strcmp(f->name, name) == 0) {
+            ld->font_str = ofs;
+            ld->font = f->font;
+            return f->font;
+        }
+    }
+
+    printf("界面数据: 未知的字体 %s\n", name);
+    return NULL;
+}
+
+static lv_event_cb_t find_event_cb(load_t *ld, const char *name)
+{
+    const ui_blob_event_t *e;
+    for (e = ld->syms->events; e && e->name; e++) {
+        if (strcmp(e->name, name) == 0) return e->cb;
+    }
+
+    printf("界面数据: 未知的事件回调 %s\n", name);
+    return NULL;
+}
+
+static lv_obj_t *find_named(load_t *ld, const char *name)
+{
+    uint32_t i;
+    for (i = 0; i < ld->named_cnt; i++) {
+        if (strcmp(ld->named[i].name, name) == 0) return ld->named[i].obj;
+    }
+    return NULL;
+}
+
+static void add_named(load_t *ld, const char *name, lv_obj_t *obj)
+{
+    ld->named[ld->named_cnt].name = name;
+    ld->named[ld->named_cnt].obj = obj;
+    ld->named_cnt++;
+
+    const ui_blob_bind_t *b;
+    for (b = ld->syms->binds; b && b->name; b++) {
+        if (strcmp(b->name, name) == 0) *b->obj = obj;
+    }
+}
+
+static void set_style(load_t *ld, lv_obj_t *obj, int32_t prop, int32_t v)
+{
+    switch (prop) {
+        case STYLE_BG_COLOR:     lv_obj_set_style_bg_color(obj, lv_color_hex(v), 0); break;
+        case STYLE_BG_OPA:       lv_obj_set_style_bg_opa(obj, v, 0); break;
+        case STYLE_TEXT_COLOR:   lv_obj_set_style_text_color(obj, lv_color_hex(v), 0); break;
+        case STYLE_TEXT_ALIGN:   lv_obj_set_style_text_align(obj, v, 0); break;
+        case STYLE_PAD_ALL:      lv_obj_set_style_pad_all(obj, v, 0); break;
+        case STYLE_PAD_ROW:      lv_obj_set_style_pad_row(obj, v, 0); break;
+        case STYLE_PAD_COLUMN:   lv_obj_set_style_pad_column(obj, v, 0); break;
+        case STYLE_RADIUS:       lv_obj_set_style_radius(obj, v, 0); break;
+        case STYLE_BORDER_WIDTH: lv_obj_set_style_border_width(obj, v, 0); break;
+        case STYLE_BORDER_COLOR: lv_obj_set_style_border_color(obj, lv_color_hex(v), 0); break;
+        case STYLE_TEXT_FONT: {
+            const lv_font_t *font = find_font(ld, v);
+            if (font) lv_obj_set_style_text_font(obj, font, 0);
+            break;
+        }
+        default:
+            printf("界面数据: 不支持的样式属性 %d\n", (int)prop);
+            break;
+    }
+}
+
+static bool check_type(lv_obj_t *obj, const lv_obj_class_t *class_p, uint32_t op)
+{
+    if (lv_obj_has_class(obj, class_p)) return true;
+    printf("界面数据: 指令 %u 不能用于这个对象\n", (unsigned)op);
+    return false;
+}
+
+static void exec_op(load_t *ld, uint32_t op, const uint8_t *args)
+{
+    lv_obj_t *obj = ld->stack[ld->depth];
+    const ui_blob_t *blob = ld->blob;
+
+    switch (op) {
+        case OP_OBJ_BEGIN: {
+            obj = create_cbs[get_arg(args, 0)](obj);
+            lv_obj_enable_style_refresh(false);     // 创建对象时会重新打开样式刷新
+            ld->stack[++ld->depth] = obj;
+            const char *name = get_str(blob, get_arg(args, 1));
+            if (name) add_named(ld, name, obj);
+            break;
+        }
+        case OP_OBJ_END:
+            ld->depth--;
+            break;
+        case OP_SIZE:
+            lv_obj_set_size(obj, get_arg(args, 0), get_arg(args, 1));
+            break;
+        case OP_ALIGN:
+            lv_obj_align(obj, get_arg(args, 0), get_arg(args, 1), get_arg(args, 2));
+            break;
+        case OP_ALIGN_TO: {
+            /* 需要参考对象的位置, 布局之后再处理 */
+            align_to_t *a = &ld->align_to[ld->align_to_cnt++];
+            a->obj = obj;
+            a->base = get_str(blob, get_arg(args, 0));
+            a->align = get_arg(args, 1);
+            a->x = get_arg(args, 2);
+            a->y = get_arg(args, 3);
+            break;
+        }
+        case OP_STYLE:
+            set_style(ld, obj, get_arg(args, 0), get_arg(args, 1));
+            break;
+        case OP_ADD_FLAG:
+            lv_obj_add_flag(obj, get_arg(args, 0));
+            break;
+        case OP_CLEAR_FLAG:
+            lv_obj_clear_flag(obj, get_arg(args, 0));
+            break;
+        case OP_ADD_STATE:
+            lv_obj_add_state(obj, get_arg(args, 0));
+            break;
+        case OP_FLEX_FLOW:
+            lv_obj_set_flex_flow(obj, get_arg(args, 0));
+            break;
+        case OP_FLEX_ALIGN:
+            lv_obj_set_flex_align(obj, get_arg(args, 0), get_arg(args, 1), get_arg(args, 2));
+            break;
+        case OP_EVENT: {
+            const char *name = get_str(blob, get_arg(args, 0));
+            lv_event_cb_t cb = name ? find_event_cb(ld, name) : NULL;
+            if (cb) lv_obj_add_event_cb(obj, cb, get_arg(args, 1), NULL);
+            break;
+        }
+        case OP_TEXT: {
+            const char *text = get_str(blob, get_arg(args, 0));
+            if (text && check_type(obj, &lv_label_class, op)) lv_label_set_text_static(obj, text);
+            break;
+        }
+        case OP_READOUT_FORMAT: {
+            const char *fmt = get_str(blob, get_arg(args, 0));
+            if (fmt && check_type(obj, &lv_readout_class, op))
+                lv_readout_set_format(obj, fmt, get_arg(args, 1), get_arg(args, 2));
+            break;
+        }
+        case OP_BAR_RANGE:
+            if (check_type(obj, &lv_bar_class, op)) lv_bar_set_range(obj, get_arg(args, 0), get_arg(args, 1));
+            break;
+        case OP_CHART_TYPE:
+            if (check_type(obj, &lv_chart_class, op)) lv_chart_set_type(obj, get_arg(args, 0));
+            break;
+        case OP_CHART_POINT_COUNT:
+            if (check_type(obj, &lv_chart_class, op)) lv_chart_set_point_count(obj, get_arg(args, 0));
+            break;
+        case OP_CHART_RANGE:
+            if (check_type(obj, &lv_chart_class, op))
+                lv_chart_set_range(obj, get_arg(args, 0), get_arg(args, 1), get_arg(args, 2));
+            break;
+        case OP_CHART_DIV_LINES:
+            if (check_type(obj, &lv_chart_class, op)) lv_chart_set_div_line_count(obj, get_arg(args, 0), get_arg(args, 1));
+            break;
+        case OP_CHART_SERIES:
+            if (check_type(obj, &lv_chart_class, op))
+                lv_chart_add_series(obj, lv_color_hex(get_arg(args, 0)), get_arg(args, 1));
+            break;
+        default:
+            break;
+    }
+}
+
+/* 重新布局 align_to 移动过的对象 [start, end) */
+static void relayout_aligned(load_t *ld, uint32_t start, uint32_t end, lv_obj_t *parent)
+{
+    if (start == end) return;
+
+    uint32_t i;
+    for (i = start; i < end; i++) lv_obj_mark_layout_as_dirty(ld->align_to[i].obj);
+    lv_obj_update_layout(parent);
+}
+
+/* 关闭样式刷新时设置的样式没有更新额外的绘制区域 (如阴影) */
+static void refresh_ext_draw_size(lv_obj_t *obj)
+{
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for (i = 0; i < child_cnt; i++) {
+        lv_obj_t *child = lv_obj_get_child(obj, i);
+        lv_obj_refresh_ext_draw_size(child);
+        refresh_ext_draw_size(child);
+    }
+}
+
+/* ---------- 对外接口 ---------- */
+int ui_blob_open(ui_blob_t *blob, const char *path)
+{
+    memset(blob, 0, sizeof(*blob));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        printf("界面数据无效: %s\n", path);
+        close(fd);
+        return -1;
+    }
+
+    /* 只读共享映射: 多个屏幕、多个进程共用页缓存中的同一份数据 */
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+
+    blob->data = data;
+    blob->size = st.st_size;
+    blob->mapped = true;
+    if (check_blob(blob) < 0) {
+        printf("界面数据无效: %s\n", path);
+        ui_blob_close(blob);
+        return -1;
+    }
+
+    return 0;
+}
+
+int ui_blob_init(ui_blob_t *blob, const void *data, uint32_t size)
+{
+    blob->data = data;
+    blob->size = size;
+    blob->mapped = false;
+    if (check_blob(blob) < 0) {
+        printf("界面数据无效\n");
+        memset(blob, 0, sizeof(*blob));
+        return -1;
+    }
+
+    return 0;
+}
+
+void ui_blob_close(ui_blob_t *blob)
+{
+    if (blob->mapped) munmap((void *)blob->data, blob->size);
+    memset(blob, 0, sizeof(*blob));
+}
+
+int ui_blob_load(const ui_blob_t *blob, const char *screen, lv_obj_t *parent, const ui_blob_syms_t *syms)
+{
+    if (blob->data == NULL) return -1;
+
+    const uint8_t *code = NULL;
+    uint32_t word_cnt = 0;
+    uint32_t screen_cnt = get_u16(blob->data + 6);
+    uint32_t s;
+    for (s = 0; s < screen_cnt; s++) {
+        const uint8_t *p = blob->data + HEADER_SIZE + s * SCREEN_SIZE;
+        if (strcmp(get_str(blob, get_u32(p)), screen) == 0) {
+            code = blob->data + get_u32(p + 4);
+            word_cnt = get_u32(p + 8);
+            break;
+        }
+    }
+    if (code == NULL) {
+        printf("界面数据中没有屏幕 %s\n", screen);
+        return -1;
+    }
+
+    /* 数组较大, 不放在栈上 */
+    static load_t ld;
+    memset(&ld, 0, sizeof(ld));
+    ld.blob = blob;
+    ld.syms = syms;
+    ld.stack[0] = parent;
+    ld.font_str = NO_STR;
+
+    const ui_blob_bind_t *b;
+    for (b = syms->binds; b && b->name; b++) *b->obj = NULL;
+
+    /* 每个对象的样式修改都会发送事件并使布局失效, 创建过程中关闭样式刷新, 最后统一刷新一次 */
+    lv_obj_enable_style_refresh(false);
+    uint32_t i = 0;
+    while (i < word_cnt) {
+        uint32_t head = get_u32(code + 4 * i);
+        exec_op(&ld, head & 0xffff, code + 4 * (i + 1));
+        i += 1 + (head >> 16);
+    }
+    lv_obj_enable_style_refresh(true);
+
+    lv_obj_refresh_style(parent, LV_PART_ANY, LV_STYLE_PROP_ANY);
+    refresh_ext_draw_size(parent);
+    lv_obj_update_layout(parent);
+
+    /* align_to 需要参考对象布局后的位置. 每次 align_to 都会使布局失效, 下一次 align_to 又要重新布局,
+     * 所以关闭样式刷新, 最后只重新布局移动过的对象 */
+    uint32_t laid_out = 0;
+    lv_obj_enable_style_refresh(false);
+    for (i = 0; i < ld.align_to_cnt; i++) {
+        align_to_t *a = &ld.align_to[i];
+        lv_obj_t *base = a->base ? find_named(&ld, a->base) : lv_obj_get_parent(a->obj);
+        if (base == NULL) {
+            printf("界面数据: 未知的对象 %s\n", a->base);
+            continue;
+        }
+
+        /* 参考对象刚被移动过时先更新它的位置 */
+        uint32_t j;
+        for (j = laid_out; j < i; j++) {
+            if (ld.align_to[j].obj == base) break;
+        }
+        if (j < i) {
+            relayout_aligned(&ld, laid_out, i, parent);
+            laid_out = i;
+        }
+
+        lv_obj_align_to(a->obj, base, a->align, a->x, a->y);
+    }
+    relayout_aligned(&ld, laid_out, ld.align_to_cnt, parent);
+    lv_obj_enable_style_refresh(true);
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef __UI_BLOB_H__
+#define __UI_BLOB_H__
+
+#include "lvgl/lvgl.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 界面数据加载
+ *
+ * 界面用 JSON 描述 (如 test/nongye_ui.json), 由 tools/ui_compile.py 在开发机上编译成二进制数据.
+ * 数据中没有指针, 可以直接 mmap 使用, 一份数据可以包含多个屏幕, 多次加载时共用.
+ * 标签的文字直接指向数据, 所以加载出的对象存在时不能关闭数据.
+ */
+
+#define UI_BLOB_DEPTH_MAX       16  // 对象的最大嵌套层数
+#define UI_BLOB_NAMED_MAX       64  // 一个屏幕中有名字的对象的最大个数
+#define UI_BLOB_ALIGN_TO_MAX    32  // 一个屏幕中 align_to 的最大个数
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    bool mapped;
+} ui_blob_t;
+
+/* 以下数组都以 {NULL} 结尾 */
+typedef struct {
+    const char *name;
+    const lv_font_t *font;
+} ui_blob_font_t;
+
+typedef struct {
+    const char *name;
+    lv_event_cb_t cb;
+} ui_blob_event_t;
+
+/* 加载时把有这个名字的对象写入 *obj, 数据中没有时写入 NULL */
+typedef struct {
+    const char *name;
+    lv_obj_t **obj;
+} ui_blob_bind_t;
+
+typedef struct {
+    const ui_blob_font_t *fonts;
+    const ui_blob_event_t *events;
+    const ui_blob_bind_t *binds;
+} ui_blob_syms_t;
+
+/* mmap 一个编译好的界面文件并检查内容, 成功返回 0.
+ * 映射期间不能原地修改这个文件, 更新时要写新文件再 rename 替换 */
+int ui_blob_open(ui_blob_t *blob, const char *path);
+
+/* 使用内存中的界面数据 (如编译进程序的数组, 需一直有效) 并检查内容, 成功返回 0 */
+int ui_blob_init(ui_blob_t *blob, const void *data, uint32_t size);
+
+void ui_blob_close(ui_blob_t *blob);
+
+/*
+ * 在 parent 中创建屏幕 screen 的对象.
+ * 创建过程中关闭样式刷新 (lv_obj_enable_style_refresh), 最后统一刷新一次样式并只布局一次.
+ * 成功返回 0
+ */
+int ui_blob_load(const ui_blob_t *blob, const char *screen, lv_obj_t *parent, const ui_blob_syms_t *syms);
+
+#endif
@@ -0,0 +1,329 @@
+/**
+ * @file fbtap_recv.c
+ * 远程查看屏幕: 连接 lv_drivers/display/fbtap.c 的数据流, 重建屏幕内容并保存为 PPM 图片
+ *
+ * 在开发机上编译 (不依赖 lvgl):
+ *   make fbtap_recv
+ * 板子上的 FBTAP_ADDR 为 Unix socket 时通过 ssh 转发:
+ *   ssh -N -L 5900:/tmp/fbtap.sock root@板子地址 &
+ *   ./fbtap_recv -a :5900 -o screen.ppm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/*数据流格式见 fbtap.c*/
+#define FBTAP_VERSION       1
+#define HELLO_SIZE          12
+#define MSG_HEADER_SIZE     14
+#define MSG_RECT            1
+#define MSG_DELTA           2
+#define MSG_FRAME_END       3
+
+typedef struct {
+    int fd;
+    uint32_t px_size;   /*每个像素的字节数*/
+    uint32_t depth;     /*LV_COLOR_DEPTH*/
+    uint32_t w;
+    uint32_t h;
+    uint8_t * frame;    /*板子上的原始像素*/
+    uint8_t * area_buf;
+    uint8_t * payload;
+} recv_t;
+
+static void usage(const char * name)
+{
+    fprintf(stderr,
+            "用法: %s [-a 地址] [-o 图片.ppm] [-n 帧数] [-q]\n"
+            "  -a  Unix socket 路径或 host:port (默认 /tmp/fbtap.sock, \":port\" 为本机)\n"
+            "  -o  每帧结束后写入的 PPM 图片 (默认 fbtap.ppm)\n"
+            "  -n  收到这么多帧后退出 (默认 0: 一直运行)\n"
+            "  -q  不打印每帧的统计\n", name);
+}
+
+static uint32_t get_u16(const uint8_t * p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t * p)
+{
+    return get_u16(p) | (get_u16(p + 2) << 16);
+}
+
+static int read_all(int fd, void * buf, size_t size)
+{
+    uint8_t * p = buf;
+    while(size > 0) {
+        ssize_t n = read(fd, p, size);
+        if(n <= 0) return -1;
+        p += n;
+        size -= n;
+    }
+    return 0;
+}
+
+static int connect_addr(const char * addr)
+{
+    const char * colon = strrchr(addr, ':');
+    if(colon == NULL) {
+        struct sockaddr_un sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sun_family = AF_UNIX;
+        if(strlen(addr) >= sizeof(sa.sun_path)) {
+            fprintf(stderr, "socket 路径太长: %s\n", addr);
+            return -1;
+        }
+        strcpy(sa.sun_path, addr);
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(fd < 0 || connect(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+            perror(addr);
+            if(fd >= 0) close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    char host[256];
+    size_t host_len = colon - addr;
+    if(host_len >= sizeof(host)) host_len = sizeof(host) - 1;
+    memcpy(host, addr, host_len);
+    host[host_len] = '\0';
+
+    struct addrinfo hints;
+    struct addrinfo * res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    int err = getaddrinfo(host_len ? host : "127.0.0.1", colon + 1, &hints, &res);
+    if(err) {
+        fprintf(stderr, "%s: %s\n", addr, gai_strerror(err));
+        return -1;
+    }
+
+    int fd = -1;
+    struct addrinfo * ai;
+    for(ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if(fd < 0) continue;
+        if(connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+
+    if(fd < 0) perror(addr);
+    return fd;
+}
+
+/*解码游程编码: 控制字节 c < 128 后面是 c + 1 个像素, c >= 128 后面的像素重复 c - 126 次*/
+static int rle_decode(uint8_t * dst, uint32_t px_cnt, const uint8_t * src, uint32_t size, uint32_t px_size)
+{
+    const uint8_t * src_end = src + size;
+    uint8_t * dst_end = dst + px_cnt * px_size;
+    while(src < src_end) {
+        uint32_t c = *src++;
+        if(c < 128) {
+            uint32_t n = (c + 1) * px_size;
+            if(src + n > src_end || dst + n > dst_end) return -1;
+            memcpy(dst, src, n);
+            src += n;
+            dst += n;
+        }
+        else {
+            uint32_t i;
+            if(src + px_size > src_end || dst + (c - 126) * px_size > dst_end) return -1;
+            for(i = 0; i < c - 126; i++) {
+                memcpy(dst, src, px_size);
+                dst += px_size;
+            }
+            src += px_size;
+        }
+    }
+    return dst == dst_end ? 0 : -1;
+}
+
+static void px_to_rgb(const recv_t * r, const uint8_t * px, uint8_t * rgb)
+{
+    if(r->px_size == 4) {
+        /*lv_color32_t: B, G, R, A*/
+        rgb[0] = px[2];
+        rgb[1] = px[1];
+        rgb[2] = px[0];
+    }
+    else if(r->px_size == 2) {
+        /*RGB565*/
+        uint32_t v = px[0] | (px[1] << 8);
+        rgb[0] = ((v >> 11) & 0x1f) * 255 / 31;
+        rgb[1] = ((v >> 5) & 0x3f) * 255 / 63;
+        rgb[2] = (v & 0x1f) * 255 / 31;
+    }
+    else if(r->depth == 8) {
+        /*RGB332*/
+        rgb[0] = (px[0] >> 5) * 255 / 7;
+        rgb[1] = ((px[0] >> 2) & 0x7) * 255 / 7;
+        rgb[2] = (px[0] & 0x3) * 255 / 3;
+    }
+    else {
+        rgb[0] = rgb[1] = rgb[2] = (px[0] & 1) ? 255 : 0;
+    }
+}
+
+/*先写临时文件再改名, 查看图片的程序不会读到一半的内容*/
+static int write_ppm(const recv_t * r, const char * path)
+{
+    char tmp_path[1024];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE * f = fopen(tmp_path, "wb");
+    if(f == NULL) {
+        perror(tmp_path);
+        return -1;
+    }
+
+    fprintf(f, "P6\n%u %u\n255\n", r->w, r->h);
+    uint32_t i;
+    for(i = 0; i < r->w * r->h; i++) {
+        uint8_t rgb[3];
+        px_to_rgb(r, &r->frame[i * r->px_size], rgb);
+        fwrite(rgb, 1, 3, f);
+    }
+
+    if(fclose(f) != 0 || rename(tmp_path, path) != 0) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+static int read_hello(recv_t * r)
+{
+    uint8_t hello[HELLO_SIZE];
+    if(read_all(r->fd, hello, sizeof(hello)) < 0) {
+        fprintf(stderr, "连接已断开\n");
+        return -1;
+    }
+
+    if(memcmp(hello, "LVFB", 4) != 0 || hello[4] != FBTAP_VERSION) {
+        fprintf(stderr, "不支持的数据流 (版本 %u)\n", hello[4]);
+        return -1;
+    }
+
+    r->px_size = hello[5];
+    r->depth = hello[6];
+    r->w = get_u16(&hello[8]);
+    r->h = get_u16(&hello[10]);
+    if(r->px_size < 1 || r->px_size > 4 || r->w == 0 || r->h == 0) {
+        fprintf(stderr, "无效的屏幕参数\n");
+        return -1;
+    }
+
+    size_t frame_size = (size_t)r->w * r->h * r->px_size;
+    r->frame = calloc(1, frame_size);
+    r->area_buf = malloc(frame_size);
+    r->payload = malloc((size_t)r->w * r->h * (r->px_size + 1));
+    if(r->frame == NULL || r->area_buf == NULL || r->payload == NULL) {
+        fprintf(stderr, "内存不足\n");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char * argv[])
+{
+    const char * addr = "/tmp/fbtap.sock";
+    const char * out_path = "fbtap.ppm";
+    uint32_t frame_max = 0;
+    int quiet = 0;
+    int opt;
+    while((opt = getopt(argc, argv, "a:o:n:qh")) != -1) {
+        switch(opt) {
+            case 'a': addr = optarg; break;
+            case 'o': out_path = optarg; break;
+            case 'n': frame_max = atoi(optarg); break;
+            case 'q': quiet = 1; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    recv_t r;
+    memset(&r, 0, sizeof(r));
+    r.fd = connect_addr(addr);
+    if(r.fd < 0) return 1;
+    if(read_hello(&r) < 0) return 1;
+    if(!quiet) printf("屏幕 %ux%u, %u 位色\n", r.w, r.h, r.depth);
+
+    uint32_t frame_cnt = 0;
+    uint32_t area_cnt = 0;
+    uint64_t payload_total = 0;
+    uint64_t raw_total = 0;
+    while(frame_max == 0 || frame_cnt < frame_max) {
+        uint8_t header[MSG_HEADER_SIZE];
+        if(read_all(r.fd, header, sizeof(header)) < 0) {
+            fprintf(stderr, "连接已断开\n");
+            break;
+        }
+
+        uint32_t type = header[0];
+        if(type == MSG_FRAME_END) {
+            if(write_ppm(&r, out_path) < 0) return 1;
+            if(!quiet) {
+                printf("帧 %u: %u 个区域, %llu 字节 (原始 %llu 字节, %.1f%%)\n", frame_cnt, area_cnt,
+                       (unsigned long long)payload_total, (unsigned long long)raw_total,
+                       raw_total ? payload_total * 100.0 / raw_total : 0.0);
+                fflush(stdout);
+            }
+            frame_cnt++;
+            area_cnt = 0;
+            payload_total = 0;
+            raw_total = 0;
+            continue;
+        }
+
+        uint32_t x = get_u16(&header[2]);
+        uint32_t y = get_u16(&header[4]);
+        uint32_t w = get_u16(&header[6]);
+        uint32_t h = get_u16(&header[8]);
+        uint32_t size = get_u32(&header[10]);
+        if((type != MSG_RECT && type != MSG_DELTA) || x + w > r.w || y + h > r.h ||
+           size > r.w * r.h * (r.px_size + 1)) {
+            fprintf(stderr, "无效的消息\n");
+            return 1;
+        }
+
+        if(read_all(r.fd, r.payload, size) < 0 ||
+           rle_decode(r.area_buf, w * h, r.payload, size, r.px_size) < 0) {
+            fprintf(stderr, "无效的区域数据\n");
+            return 1;
+        }
+
+        /*MSG_DELTA: 与上次发送的像素做异或*/
+        uint32_t row_size = w * r.px_size;
+        uint32_t i;
+        uint32_t j;
+        for(i = 0; i < h; i++) {
+            uint8_t * dst = &r.frame[((y + i) * r.w + x) * r.px_size];
+            const uint8_t * src = &r.area_buf[i * row_size];
+            if(type == MSG_RECT) memcpy(dst, src, row_size);
+            else for(j = 0; j < row_size; j++) dst[j] ^= src[j];
+        }
+
+        area_cnt++;
+        payload_total += size;
+        raw_total += w * h * r.px_size;
+    }
+
+    close(r.fd);
+    free(r.frame);
+    free(r.area_buf);
+    free(r.payload);
+    return 0;
+}
@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+#
+# 界面描述编译器: 把 JSON 界面描述编译成 test/ui_blob.c 加载的二进制数据
+#
+# 用法: python3 tools/ui_compile.py test/nongye_ui.json -o nongye_ui.bin [-c test/nongye_ui_blob.c -n nongye_ui_blob]
+#
+# 二进制格式 (小端, 所有偏移都相对于数据开头, 可以直接 mmap 使用):
+#   0   "LVUI"
+#   4   u16 版本, u16 屏幕数
+#   8   u32 字符串表偏移, u32 字符串表大小 (以 '\0' 结尾的 UTF-8 字符串)
+#   16  每个屏幕: u32 名字 (字符串表中的偏移), u32 指令偏移, u32 指令字数
+# 指令由 32 位的字组成: 第一个字为 操作码 | (参数个数 << 16), 后面是参数.
+# 字符串参数是字符串表中的偏移, 加载时不复制.
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+VERSION = 1
+
+# 操作码, 与 test/ui_blob.c 相同
+OP_OBJ_BEGIN = 1        # 类型, 名字
+OP_OBJ_END = 2
+OP_SIZE = 3             # 宽, 高
+OP_ALIGN = 4            # 对齐, x, y
+OP_ALIGN_TO = 5         # 参考对象的名字, 对齐, x, y
+OP_STYLE = 6            # 属性, 值
+OP_ADD_FLAG = 7         # 标志
+OP_CLEAR_FLAG = 8       # 标志
+OP_ADD_STATE = 9        # 状态
+OP_FLEX_FLOW = 10       # 方向
+OP_FLEX_ALIGN = 11      # 主轴, 交叉轴, 轨道
+OP_EVENT = 12           # 回调函数的名字, 事件
+OP_TEXT = 13            # 文字
+OP_READOUT_FORMAT = 14  # 格式, 位数, 小数位数
+OP_BAR_RANGE = 15       # 最小值, 最大值
+OP_CHART_TYPE = 16      # 类型
+OP_CHART_POINT_COUNT = 17   # 点数
+OP_CHART_RANGE = 18     # 坐标轴, 最小值, 最大值
+OP_CHART_DIV_LINES = 19 # 水平分割线数, 垂直分割线数
+OP_CHART_SERIES = 20    # 颜色, 坐标轴
+
+# 对象类型, 与 test/ui_blob.c 中的 create_cbs 相同
+TYPES = ['obj', 'label', 'btn', 'switch', 'bar', 'chart', 'img', 'readout']
+
+# 样式属性: 名字 -> (编号, 值的种类), 与 test/ui_blob.c 中的 style_props 相同
+STYLE_PROPS = {
+    'bg_color':     (0, 'color'),
+    'bg_opa':       (1, 'int'),
+    'text_color':   (2, 'color'),
+    'text_font':    (3, 'font'),
+    'text_align':   (4, 'text_align'),
+    'pad_all':      (5, 'int'),
+    'pad_row':      (6, 'int'),
+    'pad_column':   (7, 'int'),
+    'radius':       (8, 'int'),
+    'border_width': (9, 'int'),
+    'border_color': (10, 'color'),
+}
+
+# 以下枚举的值来自 lvgl 的头文件
+ALIGNS = ['DEFAULT', 'TOP_LEFT', 'TOP_MID', 'TOP_RIGHT', 'BOTTOM_LEFT', 'BOTTOM_MID', 'BOTTOM_RIGHT',
+          'LEFT_MID', 'RIGHT_MID', 'CENTER',
+          'OUT_TOP_LEFT', 'OUT_TOP_MID', 'OUT_TOP_RIGHT', 'OUT_BOTTOM_LEFT', 'OUT_BOTTOM_MID', 'OUT_BOTTOM_RIGHT',
+          'OUT_LEFT_TOP', 'OUT_LEFT_MID', 'OUT_LEFT_BOTTOM', 'OUT_RIGHT_TOP', 'OUT_RIGHT_MID', 'OUT_RIGHT_BOTTOM']  # lv_area.h
+
+FLAGS = {   # lv_obj.h
+    'HIDDEN': 1 << 0, 'CLICKABLE': 1 << 1, 'CLICK_FOCUSABLE': 1 << 2, 'CHECKABLE': 1 << 3,
+    'SCROLLABLE': 1 << 4, 'SCROLL_ELASTIC': 1 << 5, 'SCROLL_MOMENTUM': 1 << 6, 'SCROLL_ONE': 1 << 7,
+    'SCROLL_CHAIN_HOR': 1 << 8, 'SCROLL_CHAIN_VER': 1 << 9, 'SCROLL_CHAIN': 3 << 8, 'SCROLL_ON_FOCUS': 1 << 10,
+    'SCROLL_WITH_ARROW': 1 << 11, 'SNAPPABLE': 1 << 12, 'PRESS_LOCK': 1 << 13, 'EVENT_BUBBLE': 1 << 14,
+    'GESTURE_BUBBLE': 1 << 15, 'ADV_HITTEST': 1 << 16, 'IGNORE_LAYOUT': 1 << 17, 'FLOATING': 1 << 18,
+    'OVERFLOW_VISIBLE': 1 << 19, 'CACHE_LAYER': 1 << 20,
+}
+
+STATES = {'CHECKED': 0x01, 'FOCUSED': 0x02, 'HOVERED': 0x10, 'PRESSED': 0x20, 'DISABLED': 0x80}  # lv_obj.h
+
+FLEX_FLOWS = {'ROW': 0x00, 'COLUMN': 0x01, 'ROW_WRAP': 0x04, 'ROW_REVERSE': 0x08, 'ROW_WRAP_REVERSE': 0x0C,
+              'COLUMN_WRAP': 0x05, 'COLUMN_REVERSE': 0x09, 'COLUMN_WRAP_REVERSE': 0x0D}    # lv_flex.h
+FLEX_ALIGNS = ['START', 'END', 'CENTER', 'SPACE_EVENLY', 'SPACE_AROUND', 'SPACE_BETWEEN']  # lv_flex.h
+
+TEXT_ALIGNS = ['AUTO', 'LEFT', 'CENTER', 'RIGHT']  # lv_txt.h
+
+EVENTS = {'PRESSED': 1, 'CLICKED': 7, 'RELEASED': 8, 'VALUE_CHANGED': 28}   # lv_event.h
+
+CHART_TYPES = ['NONE', 'LINE', 'BAR', 'SCATTER']   # lv_chart.h
+CHART_AXES = {'PRIMARY_Y': 0x00, 'SECONDARY_Y': 0x01, 'PRIMARY_X': 0x02, 'SECONDARY_X': 0x04}   # lv_chart.h
+
+
+class UiError(Exception):
+    pass
+
+
+def lookup(table, name, what, path):
+    if isinstance(table, list):
+        if name in table:
+            return table.index(name)
+    elif name in table:
+        return table[name]
+    raise UiError('%s: 未知的%s "%s"' % (path, what, name))
+
+
+def parse_color(value, path):
+    if not isinstance(value, str) or not value.startswith('#') or len(value) != 7:
+        raise UiError('%s: 颜色应为 "#rrggbb": %r' % (path, value))
+    return int(value[1:], 16)
+
+
+class Compiler:
+    def __init__(self):
+        self.strings = bytearray()
+        self.string_ofs = {}
+        self.code = []
+
+    def string(self, s):
+        if s not in self.string_ofs:
+            self.string_ofs[s] = len(self.strings)
+            self.strings += s.encode('utf-8') + b'\0'
+        return self.string_ofs[s]
+
+    def op(self, code, *args):
+        self.code.append(code | (len(args) << 16))
+        self.code.extend(args)
+
+    def style(self, styles, path):
+        for name, value in styles.items():
+            if name not in STYLE_PROPS:
+                raise UiError('%s: 不支持的样式属性 "%s"' % (path, name))
+            prop, kind = STYLE_PROPS[name]
+            if kind == 'color':
+                value = parse_color(value, path)
+            elif kind == 'font':
+                value = self.string(value)
+            elif kind == 'text_align':
+                value = lookup(TEXT_ALIGNS, value, '文字对齐', path)
+            self.op(OP_STYLE, prop, value)
+
+    def flags(self, node, path):
+        if 'style' in node:
+            self.style(node['style'], path)
+        for name in node.get('flags', []):
+            self.op(OP_ADD_FLAG, lookup(FLAGS, name, '标志', path))
+        for name in node.get('clear_flags', []):
+            self.op(OP_CLEAR_FLAG, lookup(FLAGS, name, '标志', path))
+
+    def obj(self, node, path):
+        type_name = node.get('type', 'obj')
+        path = '%s/%s' % (path, node.get('id', type_name))
+        name = self.string(node['id']) if 'id' in node else -1
+        self.op(OP_OBJ_BEGIN, lookup(TYPES, type_name, '对象类型', path), name)
+
+        if 'size' in node:
+            self.op(OP_SIZE, *node['size'])
+        if 'align' in node:
+            align, x, y = node['align']
+            self.op(OP_ALIGN, lookup(ALIGNS, align, '对齐方式', path), x, y)
+        self.flags(node, path)
+        for name in node.get('state', []):
+            self.op(OP_ADD_STATE, lookup(STATES, name, '状态', path))
+
+        if 'flex' in node:
+            flex = node['flex']
+            self.op(OP_FLEX_FLOW, lookup(FLEX_FLOWS, flex.get('flow', 'ROW'), '布局方向', path))
+            self.op(OP_FLEX_ALIGN, *[lookup(FLEX_ALIGNS, flex.get(k, 'START'), '布局对齐', path)
+                                     for k in ('main', 'cross', 'track')])
+
+        if 'text' in node:
+            self.op(OP_TEXT, self.string(node['text']))
+        if 'format' in node:
+            fmt, digits, decimals = node['format']
+            self.op(OP_READOUT_FORMAT, self.string(fmt), digits, decimals)
+        if 'range' in node:
+            self.op(OP_BAR_RANGE, *node['range'])
+        if 'chart' in node:
+            chart = node['chart']
+            self.op(OP_CHART_TYPE, lookup(CHART_TYPES, chart.get('type', 'LINE'), '图表类型', path))
+            if 'point_count' in chart:
+                self.op(OP_CHART_POINT_COUNT, chart['point_count'])
+            for axis, (vmin, vmax) in chart.get('ranges', {}).items():
+                self.op(OP_CHART_RANGE, lookup(CHART_AXES, axis, '坐标轴', path), vmin, vmax)
+            if 'div_lines' in chart:
+                self.op(OP_CHART_DIV_LINES, *chart['div_lines'])
+            for ser in chart.get('series', []):
+                self.op(OP_CHART_SERIES, parse_color(ser['color'], path),
+                        lookup(CHART_AXES, ser.get('axis', 'PRIMARY_Y'), '坐标轴', path))
+
+        for event in node.get('events', []):
+            self.op(OP_EVENT, self.string(event['cb']), lookup(EVENTS, event['code'], '事件', path))
+
+        # 参考对象需要先完成布局, 加载时在布局之后处理
+        if 'align_to' in node:
+            base, align, x, y = node['align_to']
+            self.op(OP_ALIGN_TO, self.string(base), lookup(ALIGNS, align, '对齐方式', path), x, y)
+
+        for child in node.get('children', []):
+            self.obj(child, path)
+        self.op(OP_OBJ_END)
+
+    def compile(self, desc):
+        screens = []
+        for screen_name, screen in desc['screens'].items():
+            start = len(self.code)
+            # 屏幕本身的样式作用于加载时的父对象
+            self.flags(screen, screen_name)
+            for child in screen.get('children', []):
+                self.obj(child, screen_name)
+            screens.append((self.string(screen_name), start, len(self.code) - start))
+
+        header_size = 16 + 12 * len(screens)
+        code_ofs = header_size
+        str_ofs = code_ofs + 4 * len(self.code)
+
+        out = bytearray(b'LVUI')
+        out += struct.pack('<HHII', VERSION, len(screens), str_ofs, len(self.strings))
+        for name, start, cnt in screens:
+            out += struct.pack('<III', name, code_ofs + 4 * start, cnt)
+        for word in self.code:
+            out += struct.pack('<i', word)
+        out += self.strings
+        return bytes(out)
+
+
+def write_blob(path, data):
+    # 程序 mmap 这个文件, 标签文本直接指向映射, 打开时的检查也只做一次.
+    # 原地覆盖会让正在使用的进程读到一半写入的数据 (SIGBUS 或越界),
+    # 所以先写临时文件再改名替换, 已经映射的进程继续使用旧文件.
+    tmp_path = path + '.tmp'
+    with open(tmp_path, 'wb') as f:
+        f.write(data)
+    os.replace(tmp_path, path)
+
+
+def write_c_array(path, var_name, src_name, data):
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write('/* 由 tools/ui_compile.py 从 %s 生成, 不要手动修改 */\n\n' % src_name)
+        f.write('#include <stdint.h>\n\n')
+        f.write('const uint8_t %s[] __attribute__((aligned(4))) = {\n' % var_name)
+        for i in range(0, len(data), 16):
+            f.write('    ' + ' '.join('0x%02x,' % b for b in data[i:i + 16]) + '\n')
+        f.write('};\n\n')
+        f.write('const uint32_t %s_size = sizeof(%s);\n' % (var_name, var_name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='把 JSON 界面描述编译成二进制数据')
+    parser.add_argument('src', help='JSON 界面描述')
+    parser.add_argument('-o', '--output', help='二进制输出文件')
+    parser.add_argument('-c', '--c-output', help='同时生成 C 数组, 作为程序内置的界面')
+    parser.add_argument('-n', '--name', default='ui_blob', help='C 数组的名字')
+    args = parser.parse_args()
+
+    with open(args.src, encoding='utf-8') as f:
+        desc = json.load(f)
+
+    try:
+        data = Compiler().compile(desc)
+    except (UiError, KeyError, ValueError, TypeError) as e:
+        print('%s: %s' % (args.src, e), file=sys.stderr)
+        return 1
+
+    if args.output:
+        write_blob(args.output, data)
+    if args.c_output:
+        write_c_array(args.c_output, args.name, args.src, data)
+    print('%s: %d 字节' % (args.src, len(data)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())